@@ -160,7 +160,6 @@ args = dict(
             "job_dispatch.py = _ert_job_runner.job_dispatch:main",
         ]
     },
-    scripts=["src/clib/lib/job_queue/qstat_proxy.sh"],
     cmake_args=[
         "-DECL_INCLUDE_DIRS=" + get_ecl_include(),
         # we can safely pass OSX_DEPLOYMENT_TARGET as it's ignored on
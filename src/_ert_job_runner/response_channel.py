@@ -0,0 +1,74 @@
+"""Shared-memory handoff of GEN_DATA responses.
+
+A forward model step which produces a GEN_DATA response normally writes
+it to its RESULT_FILE in the runpath, from where ERT reads it back - two
+filesystem round trips which both cross NFS on a typical cluster. A step
+running on the same machine as ERT (the local queue driver) can instead
+publish the response with::
+
+    from _ert_job_runner.response_channel import publish_gen_data
+
+    publish_gen_data("poly_0.out", values)
+
+which places the values in a shared memory segment that the ERT-side
+load consumes directly, bypassing the runpath filesystem entirely. The
+segment carries the same binary record as the GEN_DATA_BINARY file
+format, and its name is derived from the absolute result path so that
+both sides compute it independently (see gen_common.cpp).
+
+When no shared memory filesystem is available the values are written to
+the result file itself (in the binary format, which the loader
+recognizes regardless of the configured input format), so steps can call
+publish_gen_data unconditionally.
+"""
+
+import os
+import struct
+from array import array
+
+_SHM_DIR = "/dev/shm"
+_GEN_DATA_BINARY_MAGIC = 0x47444231
+_DTYPE_DOUBLE = 2
+
+
+def _channel_name(result_file):
+    """FNV-1a 64 of the absolute result path; must match
+    gen_common_shm_name() on the ERT side."""
+    fnv = 0xCBF29CE484222325
+    for byte in os.path.abspath(result_file).encode("utf-8"):
+        fnv ^= byte
+        fnv = (fnv * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return f"ert_resp_{fnv:016x}"
+
+
+def _pack(values):
+    data = array("d", values)
+    return (
+        struct.pack("=iiq", _GEN_DATA_BINARY_MAGIC, _DTYPE_DOUBLE, len(data))
+        + data.tobytes()
+    )
+
+
+def publish_gen_data(result_file, values):
+    """Publish a GEN_DATA response for result_file.
+
+    Returns True when the response went through shared memory and False
+    when it was written to the result file instead.
+    """
+    payload = _pack(values)
+    if os.path.isdir(_SHM_DIR):
+        name = _channel_name(result_file)
+        tmp_file = os.path.join(_SHM_DIR, f".{name}.{os.getpid()}.tmp")
+        try:
+            with open(tmp_file, "wb") as handle:
+                handle.write(payload)
+            os.replace(tmp_file, os.path.join(_SHM_DIR, name))
+            return True
+        except OSError:
+            try:
+                os.unlink(tmp_file)
+            except OSError:
+                pass
+    with open(result_file, "wb") as handle:
+        handle.write(payload)
+    return False
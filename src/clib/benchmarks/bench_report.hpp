@@ -0,0 +1,50 @@
+#ifndef ERT_BENCH_REPORT_H
+#define ERT_BENCH_REPORT_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fmt/format.h>
+
+/*
+  Shared reporting for the benchmark executables. Every stage is
+  printed as a human readable table row; when the environment variable
+  BENCH_JSON names a file, one JSON line per stage is appended to it so
+  runs can be diffed across releases:
+
+    {"benchmark": "bench_update", "stage": "serialize",
+     "seconds": 1.234567, "mb_per_s": 812.3}
+*/
+
+class Stopwatch {
+public:
+    double elapsed() const {
+        return std::chrono::duration<double>(clock::now() - m_start).count();
+    }
+    void reset() { m_start = clock::now(); }
+
+private:
+    using clock = std::chrono::steady_clock;
+    clock::time_point m_start = clock::now();
+};
+
+inline void report(const char *benchmark, const char *stage, double seconds,
+                   double mega_bytes) {
+    fmt::print("{:<24} {:>10.3f} s {:>12.1f} MB/s\n", stage, seconds,
+               mega_bytes / seconds);
+
+    const char *json_file = getenv("BENCH_JSON");
+    if (json_file == nullptr)
+        return;
+    FILE *stream = fopen(json_file, "a");
+    if (stream == nullptr)
+        return;
+    fmt::print(stream,
+               "{{\"benchmark\": \"{}\", \"stage\": \"{}\", \"seconds\": "
+               "{:.6f}, \"mb_per_s\": {:.1f}}}\n",
+               benchmark, stage, seconds, mega_bytes / seconds);
+    fclose(stream);
+}
+
+#endif
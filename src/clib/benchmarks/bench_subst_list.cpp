@@ -0,0 +1,56 @@
+/*
+  Benchmarks subst_list_update_string: one list with the usual runpath
+  magic strings plus a handful of user defines, applied repeatedly to a
+  template of a few kilobytes. This mirrors what runpath rendering does
+  once per template file per realization.
+
+  Usage: bench_subst_list [iterations]
+*/
+
+#include <cstdlib>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <ert/res_util/subst_list.hpp>
+#include <ert/util/util.h>
+
+#include "bench_report.hpp"
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    subst_list_type *subst_list = subst_list_alloc();
+    subst_list_append_copy(subst_list, "<IENS>", "17");
+    subst_list_append_copy(subst_list, "<ITER>", "3");
+    subst_list_append_copy(subst_list, "<CASE>", "default_smoother");
+    subst_list_append_copy(subst_list, "<DATE>", "2023-01-01");
+    subst_list_append_copy(subst_list, "<RUNPATH>",
+                           "/scratch/ert/bench/real-17/iter-3");
+    for (int index = 0; index < 16; index++)
+        subst_list_append_copy(subst_list,
+                               fmt::format("<FIELD_{}>", index).c_str(),
+                               fmt::format("{:.4f}", 0.01 * index).c_str());
+
+    std::string template_text;
+    for (int line = 0; line < 64; line++)
+        template_text += fmt::format("PARAM_{} <FIELD_{}> -- member <IENS> "
+                                     "iteration <ITER> in <RUNPATH>/<CASE> "
+                                     "some plain filler text on every line\n",
+                                     line, line % 16);
+
+    fmt::print("bench_subst_list: {} iterations over {} bytes\n", iterations,
+               template_text.size());
+
+    double mega_bytes = 1e-6 * template_text.size() * iterations;
+    Stopwatch watch;
+    for (int index = 0; index < iterations; index++) {
+        char *string = util_alloc_string_copy(template_text.c_str());
+        subst_list_update_string(subst_list, &string);
+        free(string);
+    }
+    report("bench_subst_list", "update_string", watch.elapsed(), mega_bytes);
+
+    subst_list_free(subst_list);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  Synthetic end-to-end benchmark for the analysis pipeline hot spots:
+  node serialization into the ensemble matrix, assembly of the S matrix
+  from measurement blocks, the smoother GEMM A' = A * X and row-scaled
+  (localized) multiplication. The data is generated in memory so the
+  numbers track the compute kernels rather than disk speed.
+
+  Usage: bench_update [rows] [ens_size] [obs_size]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <fmt/format.h>
+
+#include <ert/enkf/active_list.hpp>
+#include <ert/enkf/enkf_serialize.hpp>
+#include <ert/enkf/meas_data.hpp>
+#include <ert/enkf/row_scaling.hpp>
+
+#include "bench_report.hpp"
+
+namespace {
+
+void report(const char *stage, double seconds, double mega_bytes) {
+    ::report("bench_update", stage, seconds, mega_bytes);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int ens_size = argc > 2 ? std::atoi(argv[2]) : 100;
+    int obs_size = argc > 3 ? std::atoi(argv[3]) : 100000;
+
+    fmt::print("bench_update: rows={} ens_size={} obs_size={}\n", rows,
+               ens_size, obs_size);
+
+    std::mt19937 rng(2023);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+
+    // Stage 1: serialize/deserialize a field-sized node for every member
+    std::vector<float> node_data(rows);
+    for (auto &value : node_data)
+        value = gauss(rng);
+
+    ActiveList all_active;
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(rows, ens_size);
+    double node_mb = 1e-6 * rows * ens_size * sizeof(double);
+    {
+        Stopwatch watch;
+        for (int iens = 0; iens < ens_size; iens++)
+            enkf_matrix_serialize(node_data.data(), rows, ECL_FLOAT,
+                                  &all_active, A, 0, iens);
+        report("serialize", watch.elapsed(), node_mb);
+    }
+    {
+        Stopwatch watch;
+        for (int iens = 0; iens < ens_size; iens++)
+            enkf_matrix_deserialize(node_data.data(), rows, ECL_FLOAT,
+                                    &all_active, A, 0, iens);
+        report("deserialize", watch.elapsed(), node_mb);
+    }
+
+    // Stage 2: fill a measurement block and assemble S
+    std::vector<bool> ens_mask(ens_size, true);
+    meas_data_type *meas_data = meas_data_alloc(ens_mask);
+    meas_block_type *meas_block =
+        meas_data_add_block(meas_data, "BENCH", 0, obs_size);
+    double obs_mb = 1e-6 * obs_size * ens_size * sizeof(double);
+    {
+        Stopwatch watch;
+        for (int iobs = 0; iobs < obs_size; iobs++)
+            for (int iens = 0; iens < ens_size; iens++)
+                meas_block_iset(meas_block, iens, iobs, gauss(rng));
+        report("meas_block fill", watch.elapsed(), obs_mb);
+    }
+    {
+        Stopwatch watch;
+        for (int iobs = 0; iobs < obs_size; iobs++) {
+            meas_block_iget_ens_mean(meas_block, iobs);
+            meas_block_iget_ens_std(meas_block, iobs);
+        }
+        report("ens stats", watch.elapsed(), obs_mb);
+    }
+    {
+        Stopwatch watch;
+        Eigen::MatrixXd S = meas_data_makeS(meas_data);
+        report("meas_data_makeS", watch.elapsed(), obs_mb);
+    }
+    meas_data_free(meas_data);
+
+    // Stage 3: the smoother update GEMM and its row-scaled variant
+    Eigen::MatrixXd X(ens_size, ens_size);
+    for (int i = 0; i < ens_size; i++)
+        for (int j = 0; j < ens_size; j++)
+            X(i, j) = gauss(rng) / ens_size;
+    {
+        Stopwatch watch;
+        A *= X;
+        report("update GEMM", watch.elapsed(), node_mb);
+    }
+    {
+        RowScaling row_scaling;
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (int row = 0; row < rows; row++)
+            row_scaling.assign(row, uniform(rng));
+        Stopwatch watch;
+        row_scaling.multiply(A, X);
+        report("row_scaling multiply", watch.elapsed(), node_mb);
+    }
+
+    return 0;
+}
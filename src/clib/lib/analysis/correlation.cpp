@@ -0,0 +1,96 @@
+#include <Eigen/Dense>
+#include <cmath>
+
+#include <ert/concurrency.hpp>
+#include <ert/except.hpp>
+#include <ert/python.hpp>
+
+namespace {
+
+/**
+   Standardizes every row of @X for correlation: the row is centered
+   and scaled by the L2 norm of the centered row, so the correlation
+   between two standardized rows is simply their dot product. Rows
+   with zero variance are set to zero and thus correlate with nothing.
+   The result is materialized in @Scalar - float is sufficient for
+   screening correlations and halves the bandwidth of the GEMM.
+*/
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>
+standardize_rows(const Eigen::MatrixXd &X) {
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> standardized(
+        X.rows(), X.cols());
+    ert::global_pool().parallel_for(X.rows(), 64, [&](size_t begin,
+                                                      size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            Eigen::ArrayXd centered = X.row(row).array() - X.row(row).mean();
+            double norm = std::sqrt(centered.square().sum());
+            if (norm > 0)
+                standardized.row(row) =
+                    (centered / norm).matrix().transpose().cast<Scalar>();
+            else
+                standardized.row(row).setZero();
+        }
+    });
+    return standardized;
+}
+
+/**
+   Correlation between every row of @A (parameters) and every row of
+   @S (responses), both stored with one ensemble member per column.
+   After standardizing the rows once, the whole correlation matrix is
+   the product Astd * Sstd^T; the product is computed in blocks of
+   @block_rows parameter rows on the shared pool, so each core owns a
+   slice of the output and the (small) standardized response operand
+   stays in cache while the parameter rows stream through.
+*/
+template <typename Scalar>
+py::array_t<Scalar> correlation_matrix(const Eigen::MatrixXd &A,
+                                       const Eigen::MatrixXd &S,
+                                       int block_rows) {
+    py::array_t<Scalar> array(
+        {(py::ssize_t)A.rows(), (py::ssize_t)S.rows()});
+    Eigen::Map<
+        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+        correlations(array.mutable_data(), A.rows(), S.rows());
+
+    PyThreadState *state = nullptr;
+    if (PyGILState_Check() == 1)
+        state = PyEval_SaveThread();
+
+    auto A_standardized = standardize_rows<Scalar>(A);
+    auto S_standardized = standardize_rows<Scalar>(S);
+    ert::global_pool().parallel_for(
+        A.rows(), block_rows, [&](size_t begin, size_t end) {
+            correlations.middleRows(begin, end - begin).noalias() =
+                A_standardized.middleRows(begin, end - begin) *
+                S_standardized.transpose();
+        });
+
+    if (state)
+        PyEval_RestoreThread(state);
+    return array;
+}
+
+} // namespace
+
+ERT_CLIB_SUBMODULE("correlation", m) {
+    m.def(
+        "parameter_response_correlation",
+        [](const Eigen::MatrixXd &A, const Eigen::MatrixXd &S, int block_rows,
+           bool use_float32) -> py::object {
+            if (A.cols() != S.cols())
+                throw exc::invalid_argument(
+                    "A and S must have one column per ensemble member, "
+                    "got {} and {}",
+                    A.cols(), S.cols());
+            if (block_rows <= 0)
+                throw exc::invalid_argument(
+                    "block_rows must be positive, got {}", block_rows);
+            if (use_float32)
+                return correlation_matrix<float>(A, S, block_rows);
+            return correlation_matrix<double>(A, S, block_rows);
+        },
+        py::arg("A"), py::arg("S"), py::arg("block_rows") = 256,
+        py::arg("use_float32") = false);
+}
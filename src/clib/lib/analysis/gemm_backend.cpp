@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <ert/gemm_backend.hpp>
+#include <ert/logging.hpp>
+
+#ifdef ERT_HAVE_CUBLAS
+#include <cublas_v2.h>
+#include <cuda_runtime.h>
+#include <mutex>
+#endif
+
+static auto logger = ert::get_logger("analysis.gemm");
+
+namespace {
+
+/**
+   Products below this FLOP count (2 m k n) stay on the host: the
+   PCIe transfers of the operands cost more than the GEMM saves.
+   Can be lowered with ERT_GPU_GEMM_THRESHOLD (in MFLOP) when
+   experimenting.
+*/
+long long gemm_gpu_threshold_flops() {
+    static const long long threshold = [] {
+        if (const char *env = getenv("ERT_GPU_GEMM_THRESHOLD")) {
+            long long mflop = strtoll(env, nullptr, 10);
+            if (mflop > 0)
+                return mflop * 1000000LL;
+        }
+        return 1000000000LL;
+    }();
+    return threshold;
+}
+
+#ifdef ERT_HAVE_CUBLAS
+
+/**
+   The handle creation probes the device; a machine without a GPU (or
+   with exhausted devices) leaves the handle null and every product
+   takes the host path. One handle per process - cuBLAS handles are
+   documented thread safe for independent calls, and the streaming
+   loop below serializes its own calls anyway.
+*/
+cublasHandle_t gemm_cublas_handle() {
+    static cublasHandle_t handle = [] {
+        cublasHandle_t h = nullptr;
+        int device_count = 0;
+        if (cudaGetDeviceCount(&device_count) != cudaSuccess ||
+            device_count == 0)
+            return (cublasHandle_t) nullptr;
+        if (cublasCreate(&h) != CUBLAS_STATUS_SUCCESS)
+            return (cublasHandle_t) nullptr;
+        logger->info("cuBLAS backend enabled ({} device(s))", device_count);
+        return h;
+    }();
+    return handle;
+}
+
+std::mutex gemm_device_mutex;
+
+/**
+   C = A * B on the device, streaming row blocks of A (and the
+   corresponding rows of C) so the peak device footprint is
+   B + one block of A + one block of C regardless of how tall A is.
+   Eigen matrices are column major, which is also what cuBLAS expects;
+   a row block is addressed with the full leading dimension. Returns
+   false on any device failure so the caller can redo the product on
+   the host - nothing has been written to C at that point that the
+   host path will not overwrite.
+*/
+bool gemm_device(const double *A, long long m, long long k, const double *B,
+                 long long n, double *C, long long ldc) {
+    cublasHandle_t handle = gemm_cublas_handle();
+    if (!handle)
+        return false;
+
+    std::lock_guard guard(gemm_device_mutex);
+
+    size_t free_bytes = 0, total_bytes = 0;
+    if (cudaMemGetInfo(&free_bytes, &total_bytes) != cudaSuccess)
+        return false;
+
+    // Leave headroom for the allocator and other users of the device.
+    size_t budget = free_bytes / 2;
+    size_t b_bytes = (size_t)k * n * sizeof(double);
+    if (b_bytes >= budget)
+        return false;
+    long long block_rows = std::min<long long>(
+        m, (budget - b_bytes) / ((k + n) * sizeof(double)));
+    if (block_rows <= 0)
+        return false;
+
+    double *d_A = nullptr, *d_B = nullptr, *d_C = nullptr;
+    bool ok = cudaMalloc(&d_B, b_bytes) == cudaSuccess &&
+              cudaMalloc(&d_A, block_rows * k * sizeof(double)) ==
+                  cudaSuccess &&
+              cudaMalloc(&d_C, block_rows * n * sizeof(double)) == cudaSuccess;
+
+    if (ok)
+        ok = cublasSetMatrix(k, n, sizeof(double), B, k, d_B, k) ==
+             CUBLAS_STATUS_SUCCESS;
+
+    const double alpha = 1.0, beta = 0.0;
+    for (long long row = 0; ok && row < m; row += block_rows) {
+        long long rows = std::min(block_rows, m - row);
+        ok = cublasSetMatrix(rows, k, sizeof(double), A + row, m, d_A, rows) ==
+                 CUBLAS_STATUS_SUCCESS &&
+             cublasDgemm(handle, CUBLAS_OP_N, CUBLAS_OP_N, rows, n, k, &alpha,
+                         d_A, rows, d_B, k, &beta, d_C,
+                         rows) == CUBLAS_STATUS_SUCCESS &&
+             cublasGetMatrix(rows, n, sizeof(double), d_C, rows, C + row,
+                             ldc) == CUBLAS_STATUS_SUCCESS;
+    }
+
+    cudaFree(d_A);
+    cudaFree(d_B);
+    cudaFree(d_C);
+    if (!ok)
+        logger->warning(
+            "GPU GEMM failed ({}x{} * {}x{}) - falling back to host", m, k, k,
+            n);
+    return ok;
+}
+
+#endif // ERT_HAVE_CUBLAS
+
+bool gemm_try_device(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B,
+                     double *C, long long ldc) {
+#ifdef ERT_HAVE_CUBLAS
+    long long flops = 2LL * A.rows() * A.cols() * B.cols();
+    if (flops < gemm_gpu_threshold_flops())
+        return false;
+    return gemm_device(A.data(), A.rows(), A.cols(), B.data(), B.cols(), C,
+                       ldc);
+#else
+    (void)A;
+    (void)B;
+    (void)C;
+    (void)ldc;
+    return false;
+#endif
+}
+
+} // namespace
+
+namespace ert {
+
+bool gemm_gpu_available() {
+#ifdef ERT_HAVE_CUBLAS
+    return gemm_cublas_handle() != nullptr;
+#else
+    return false;
+#endif
+}
+
+void gemm_inplace(Eigen::Ref<Eigen::MatrixXd> A, const Eigen::MatrixXd &X) {
+    // The device path reads A through a staging copy of each row block
+    // before the corresponding result rows are written back, so the
+    // in-place aliasing is safe; the host path lets Eigen handle it.
+#ifdef ERT_HAVE_CUBLAS
+    long long flops = 2LL * A.rows() * A.cols() * X.cols();
+    if (flops >= gemm_gpu_threshold_flops() &&
+        A.outerStride() == A.rows() &&
+        gemm_device(A.data(), A.rows(), A.cols(), X.data(), X.cols(), A.data(),
+                    A.rows()))
+        return;
+#endif
+    // Eigen threading is the caller's policy (update.cpp enables it,
+    // RowScaling pins it single threaded inside its own parallelism).
+    A *= X;
+}
+
+Eigen::MatrixXd gemm(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B) {
+    Eigen::MatrixXd C(A.rows(), B.cols());
+    if (gemm_try_device(A, B, C.data(), C.rows()))
+        return C;
+    C.noalias() = A * B;
+    return C;
+}
+
+} // namespace ert
@@ -1,20 +1,30 @@
 #include "ert/enkf/ensemble_config.hpp"
 #include <Eigen/Dense>
 #include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 #include <fmt/format.h>
+#include <future>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <ert/analysis/update.hpp>
+#include <ert/eigen_threads.hpp>
+#include <ert/gemm_backend.hpp>
 #include <ert/enkf/enkf_analysis.hpp>
 #include <ert/enkf/enkf_config_node.hpp>
 #include <ert/enkf/enkf_obs.hpp>
+#include <ert/enkf/gen_data_config.hpp>
 #include <ert/enkf/meas_data.hpp>
 #include <ert/enkf/obs_data.hpp>
 #include <ert/except.hpp>
 #include <ert/python.hpp>
+#include <ert/res_util/arena.hpp>
 #include <ert/res_util/memory.hpp>
 #include <ert/res_util/metric.hpp>
 
@@ -22,28 +32,23 @@ static auto logger = ert::get_logger("analysis.update");
 
 namespace analysis {
 
-namespace {
-std::vector<int>
-bool_vector_to_active_list(const std::vector<bool> &bool_vector) {
-    std::vector<int> active_list;
-    for (int i = 0; i < bool_vector.size(); i++) {
-        if (bool_vector[i])
-            active_list.push_back(i);
-    }
-    return active_list;
-}
-} // namespace
-
 /**
- This is very awkward; the problem is that for the GEN_DATA type the config
- object does not really own the size. Instead the size is pushed (on load time)
- from gen_data instances to the gen_data_config instance. Therefore we have to
- assert that at least one gen_data instance has been loaded (and consequently
- updated the gen_data_config instance) before calling enkf_config_node_get_data_size.
+ For the GEN_DATA type the config object does not really own the size;
+ instead the size is pushed from gen_data instances to the
+ gen_data_config instance. The sizes are persisted as case metadata at
+ write time, so normally reading the "<KEY>_size" file is enough to
+ answer enkf_config_node_get_data_size. Cases written before the sizes
+ were persisted lack the metadata, and for those we fall back to loading
+ one full gen_data instance (which pushes its size into the config).
 */
 void ensure_node_loaded(const enkf_config_node_type *config_node,
                         enkf_fs_type *fs) {
     if (enkf_config_node_get_impl_type(config_node) == GEN_DATA) {
+        auto gen_data_config =
+            (gen_data_config_type *)enkf_config_node_get_ref(config_node);
+        if (gen_data_config_fload_data_size(gen_data_config, fs, 0))
+            return;
+
         enkf_node_type *node = enkf_node_alloc(config_node);
         node_id_type node_id = {.report_step = 0, .iens = 0};
 
@@ -53,23 +58,18 @@ void ensure_node_loaded(const enkf_config_node_type *config_node,
     }
 }
 
-void serialize_node(enkf_fs_type *fs, const enkf_config_node_type *config_node,
-                    int iens, int row_offset, int column,
-                    const ActiveList *active_list, Eigen::MatrixXd &A) {
+void serialize_node(enkf_fs_type *fs, enkf_node_type *node, int iens,
+                    int row_offset, int column, const ActiveList *active_list,
+                    Eigen::MatrixXd &A) {
 
-    enkf_node_type *node = enkf_node_alloc(config_node);
     node_id_type node_id = {.report_step = 0, .iens = iens};
     try {
         enkf_node_serialize(node, fs, node_id, active_list, A, row_offset,
                             column);
     } catch (const std::out_of_range &) {
-        std::string param_name = enkf_node_get_key(node);
-        enkf_node_free(node);
-        throw pybind11::key_error(
-            fmt::format("No parameter: {} in storage", param_name));
+        throw pybind11::key_error(fmt::format("No parameter: {} in storage",
+                                              enkf_node_get_key(node)));
     }
-    enkf_node_serialize(node, fs, node_id, active_list, A, row_offset, column);
-    enkf_node_free(node);
 }
 
 void serialize_parameter(const ensemble_config_type *ens_config,
@@ -86,17 +86,55 @@ void serialize_parameter(const ensemble_config_type *ens_config,
     int active_size = parameter.active_list.active_size(
         enkf_config_node_get_data_size(config_node, 0));
 
+    // The caller is expected to have allocated A with the correct number
+    // of rows up front (see load_parameter); only grow as a fallback.
     if (active_size > A.rows())
         A.conservativeResize(A.rows() + active_size, ens_size);
     if (active_size > 0) {
-        for (int column = 0; column < ens_size; column++) {
-            int iens = iens_active_index[column];
-            serialize_node(target_fs, config_node, iens, 0, column,
-                           &parameter.active_list, A);
+        // Each member is loaded from a separate node in storage and
+        // written to a disjoint column of A, so the members can be
+        // serialized concurrently. The members are split in contiguous
+        // column chunks and each worker allocates a single
+        // enkf_node_type which is reused for every member in its chunk,
+        // instead of one alloc/free per member.
+        int num_workers = std::max(
+            1, std::min(ens_size, (int)std::thread::hardware_concurrency()));
+        int chunk_size = (ens_size + num_workers - 1) / num_workers;
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (int start = 0; start < ens_size; start += chunk_size) {
+            int end = std::min(ens_size, start + chunk_size);
+            futures.push_back(std::async(std::launch::async, [&, start, end] {
+                const char *node_key = enkf_config_node_get_key(config_node);
+                enkf_var_type var_type =
+                    enkf_config_node_get_var_type(config_node);
+                enkf_node_type *node = enkf_node_alloc(config_node);
+                try {
+                    for (int column = start; column < end; column++) {
+                        // Start readahead of the next member's node so
+                        // its pages stream in while this member
+                        // deserializes.
+                        if (column + 1 < end)
+                            enkf_fs_prefetch_node(
+                                target_fs, node_key, var_type, 0,
+                                iens_active_index[column + 1]);
+                        serialize_node(target_fs, node,
+                                       iens_active_index[column], 0, column,
+                                       &parameter.active_list, A);
+                    }
+                } catch (...) {
+                    enkf_node_free(node);
+                    throw;
+                }
+                enkf_node_free(node);
+            }));
         }
+        for (auto &future : futures)
+            future.get();
     }
 
-    A.conservativeResize(active_size, ens_size);
+    if (active_size != A.rows())
+        A.conservativeResize(active_size, ens_size);
 }
 
 void deserialize_node(enkf_fs_type *fs,
@@ -122,6 +160,41 @@ void assert_matrix_size(const Eigen::MatrixXd &m, const char *name, int rows,
             m.cols(), rows, columns);
 }
 
+namespace {
+/**
+With distance-based localization many Parameter entries reference the
+same node with different ActiveList row subsets, and loading each of
+them used to re-serialize the overlapping cells from storage. The full
+member matrix of the most recently loaded node is therefore cached,
+and partly-active loads gather their rows from it in memory: storage
+reads drop from once per ministep per member to once per member. A
+single entry suffices - ministeps referencing the same node arrive
+back to back, and a different node would evict the matrix anyway. The
+cache is dropped whenever a parameter is written back.
+*/
+struct SerializationCacheKey {
+    std::string mount_point;
+    std::string node_key;
+    std::vector<int> iens_active_index;
+
+    bool operator==(const SerializationCacheKey &other) const {
+        return mount_point == other.mount_point &&
+               node_key == other.node_key &&
+               iens_active_index == other.iens_active_index;
+    }
+};
+
+std::mutex serialization_cache_mutex;
+std::optional<SerializationCacheKey> serialization_cache_key;
+Eigen::MatrixXd serialization_cache_matrix;
+} // namespace
+
+void invalidate_serialization_cache() {
+    std::lock_guard guard(serialization_cache_mutex);
+    serialization_cache_key.reset();
+    serialization_cache_matrix.resize(0, 0);
+}
+
 /**
 load a  parameters from a enkf_fs_type storage into a
 matrix.
@@ -130,17 +203,143 @@ Eigen::MatrixXd load_parameter(Cwrap<enkf_fs_type> source_fs,
                                Cwrap<ensemble_config_type> ensemble_config,
                                const std::vector<int> &iens_active_index,
                                const Parameter parameter) {
+    static auto &load_ns =
+        ert::metrics::registry().histogram("update.load_parameter_ns");
+    ert::metrics::ScopedTimer timer(load_ns);
+
+    if (parameter.active_list.getMode() == PARTLY_ACTIVE) {
+        SerializationCacheKey cache_key{enkf_fs_get_mount_point(source_fs),
+                                        parameter.name, iens_active_index};
+        std::unique_lock lock(serialization_cache_mutex);
+        if (!(serialization_cache_key &&
+              *serialization_cache_key == cache_key)) {
+            lock.unlock();
+            Eigen::MatrixXd full =
+                load_parameter(source_fs, ensemble_config, iens_active_index,
+                               Parameter(parameter.name));
+            lock.lock();
+            serialization_cache_key = std::move(cache_key);
+            serialization_cache_matrix = std::move(full);
+        }
+        const std::vector<int> &rows = parameter.active_list.index_list();
+        Eigen::MatrixXd A(rows.size(), iens_active_index.size());
+        for (size_t row = 0; row < rows.size(); row++)
+            A.row(row) = serialization_cache_matrix.row(rows[row]);
+        return A;
+    }
 
     int active_ens_size = iens_active_index.size();
-    int matrix_start_size = 250000;
-    Eigen::MatrixXd A =
-        Eigen::MatrixXd::Zero(matrix_start_size, active_ens_size);
+    const enkf_config_node_type *config_node =
+        ensemble_config_get_node(ensemble_config, parameter.name.c_str());
+    ensure_node_loaded(config_node, source_fs);
+
+    // Size the matrix exactly up front; growing a multi-GB matrix with
+    // conservativeResize reallocates and copies the whole block on every
+    // resize.
+    int active_size = parameter.active_list.active_size(
+        enkf_config_node_get_data_size(config_node, 0));
+    ert::utils::MemoryScope charge(
+        ert::utils::memory_account("update.matrices"),
+        (size_t)active_size * active_ens_size * sizeof(double));
+    Eigen::MatrixXd A(active_size, active_ens_size);
+    ert::utils::advise_huge_pages(A.data(), sizeof(double) * A.size());
+
+    // First-touch the columns with the same contiguous chunking the
+    // serialization workers use, so on NUMA machines the pages fault
+    // in near the threads that will fill and consume them instead of
+    // all on the allocating thread.
+    if (active_size > 0) {
+        int num_workers =
+            std::max(1, std::min(active_ens_size,
+                                 (int)std::thread::hardware_concurrency()));
+        int chunk_size = (active_ens_size + num_workers - 1) / num_workers;
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (int start = 0; start < active_ens_size; start += chunk_size) {
+            int end = std::min(active_ens_size, start + chunk_size);
+            futures.push_back(std::async(std::launch::async, [&, start, end] {
+                A.middleCols(start, end - start).setZero();
+            }));
+        }
+        for (auto &future : futures)
+            future.get();
+    }
 
     serialize_parameter(ensemble_config, parameter, source_fs,
                         iens_active_index, A);
     return A;
 }
 
+/**
+Single precision variant of load_parameter. The node storage layer is
+double based, so each member is staged through a small per-member double
+column and cast into the float matrix. The staging cost is one column at
+a time which keeps peak memory at roughly half of the double pipeline
+for large FIELD parameters.
+*/
+Eigen::MatrixXf load_parameter_fp32(Cwrap<enkf_fs_type> source_fs,
+                                    Cwrap<ensemble_config_type> ensemble_config,
+                                    const std::vector<int> &iens_active_index,
+                                    const Parameter parameter) {
+    static auto &load_ns =
+        ert::metrics::registry().histogram("update.load_parameter_ns");
+    ert::metrics::ScopedTimer timer(load_ns);
+
+    int active_ens_size = iens_active_index.size();
+    const enkf_config_node_type *config_node =
+        ensemble_config_get_node(ensemble_config, parameter.name.c_str());
+    ensure_node_loaded(config_node, source_fs);
+
+    int active_size = parameter.active_list.active_size(
+        enkf_config_node_get_data_size(config_node, 0));
+    ert::utils::MemoryScope charge(
+        ert::utils::memory_account("update.matrices"),
+        (size_t)active_size * active_ens_size * sizeof(float));
+    Eigen::MatrixXf A(active_size, active_ens_size);
+    ert::utils::advise_huge_pages(A.data(), sizeof(float) * A.size());
+
+    if (active_size > 0) {
+        int num_workers =
+            std::max(1, std::min(active_ens_size,
+                                 (int)std::thread::hardware_concurrency()));
+        int chunk_size = (active_ens_size + num_workers - 1) / num_workers;
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (int start = 0; start < active_ens_size; start += chunk_size) {
+            int end = std::min(active_ens_size, start + chunk_size);
+            futures.push_back(std::async(std::launch::async, [&, start, end] {
+                // First-touch: this worker faults in exactly the pages
+                // of the columns it is about to fill.
+                A.middleCols(start, end - start).setZero();
+                const char *node_key = enkf_config_node_get_key(config_node);
+                enkf_var_type var_type =
+                    enkf_config_node_get_var_type(config_node);
+                enkf_node_type *node = enkf_node_alloc(config_node);
+                Eigen::MatrixXd staging = Eigen::MatrixXd::Zero(active_size, 1);
+                try {
+                    for (int column = start; column < end; column++) {
+                        if (column + 1 < end)
+                            enkf_fs_prefetch_node(
+                                source_fs, node_key, var_type, 0,
+                                iens_active_index[column + 1]);
+                        serialize_node(source_fs, node,
+                                       iens_active_index[column], 0, 0,
+                                       &parameter.active_list, staging);
+                        A.col(column) = staging.col(0).cast<float>();
+                    }
+                } catch (...) {
+                    enkf_node_free(node);
+                    throw;
+                }
+                enkf_node_free(node);
+            }));
+        }
+        for (auto &future : futures)
+            future.get();
+    }
+    return A;
+}
+
 /**
 save a paramater matrix to enkf_fs_type storage
 */
@@ -148,7 +347,57 @@ void save_parameter(Cwrap<enkf_fs_type> target_fs,
                     Cwrap<ensemble_config_type> ensemble_config,
                     const std::vector<int> &iens_active_index,
                     const Parameter parameter, const Eigen::MatrixXd &A) {
+    static auto &save_ns =
+        ert::metrics::registry().histogram("update.save_parameter_ns");
+    ert::metrics::ScopedTimer timer(save_ns);
+
+    invalidate_serialization_cache();
+    int ens_size = iens_active_index.size();
+    const enkf_config_node_type *config_node =
+        ensemble_config_get_node(ensemble_config, parameter.name.c_str());
+
+    int active_size = parameter.active_list.active_size(
+        enkf_config_node_get_data_size(config_node, 0));
+    if (active_size > 0) {
+        // The members are independent - each column deserializes into
+        // its own node - so the write-back is spread over column chunks
+        // exactly like the load in serialize_parameter. The storage
+        // writes themselves land in the write-behind queue of the
+        // block_fs driver, which batches them per shard and overlaps
+        // them with whatever the caller does next.
+        int num_workers = std::max(
+            1, std::min(ens_size, (int)std::thread::hardware_concurrency()));
+        int chunk_size = (ens_size + num_workers - 1) / num_workers;
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (int start = 0; start < ens_size; start += chunk_size) {
+            int end = std::min(ens_size, start + chunk_size);
+            futures.push_back(std::async(std::launch::async, [&, start, end] {
+                for (int column = start; column < end; column++)
+                    deserialize_node(target_fs, config_node,
+                                     iens_active_index[column], 0, column,
+                                     &parameter.active_list, A);
+            }));
+        }
+        for (auto &future : futures)
+            future.get();
+    }
+}
+
+/**
+Single precision variant of save_parameter; the float columns are cast
+back through a per-member double staging column before deserializing
+into node storage.
+*/
+void save_parameter_fp32(Cwrap<enkf_fs_type> target_fs,
+                         Cwrap<ensemble_config_type> ensemble_config,
+                         const std::vector<int> &iens_active_index,
+                         const Parameter parameter, const Eigen::MatrixXf &A) {
+    static auto &save_ns =
+        ert::metrics::registry().histogram("update.save_parameter_ns");
+    ert::metrics::ScopedTimer timer(save_ns);
 
+    invalidate_serialization_cache();
     int ens_size = iens_active_index.size();
     const enkf_config_node_type *config_node =
         ensemble_config_get_node(ensemble_config, parameter.name.c_str());
@@ -156,20 +405,345 @@ void save_parameter(Cwrap<enkf_fs_type> target_fs,
     int active_size = parameter.active_list.active_size(
         enkf_config_node_get_data_size(config_node, 0));
     if (active_size > 0) {
-        for (int column = 0; column < ens_size; column++) {
-            int iens = iens_active_index[column];
-            deserialize_node(target_fs, config_node, iens, 0, column,
-                             &parameter.active_list, A);
+        int num_workers = std::max(
+            1, std::min(ens_size, (int)std::thread::hardware_concurrency()));
+        int chunk_size = (ens_size + num_workers - 1) / num_workers;
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_workers);
+        for (int start = 0; start < ens_size; start += chunk_size) {
+            int end = std::min(ens_size, start + chunk_size);
+            futures.push_back(std::async(std::launch::async, [&, start, end] {
+                for (int column = start; column < end; column++) {
+                    Eigen::MatrixXd staging = A.col(column).cast<double>();
+                    deserialize_node(target_fs, config_node,
+                                     iens_active_index[column], 0, 0,
+                                     &parameter.active_list, staging);
+                }
+            }));
         }
+        for (auto &future : futures)
+            future.get();
     }
 }
 
+/**
+  Columnar cross-ensemble storage: in addition to the per-member nodes
+  all realizations of one parameter are stored as a single contiguous
+  node keyed "<name>.column", holding a small header followed by the
+  raw column-major matrix. Loading then becomes one large sequential
+  read straight into Eigen::MatrixXd instead of ens_size per-member
+  reads through the serialize indirection.
+*/
+static const int COLUMN_STORAGE_MAGIC = 0x434F4C31; /* "COL1" */
+
+static std::string column_storage_key(const Parameter &parameter) {
+    return parameter.name + ".column";
+}
+
+/**
+Variant of save_parameter which also writes the columnar node. The
+per-member nodes remain the source of truth - the columnar node is a
+sidecar written by the update and validated on load against the member
+layout, so a mismatching (re-initialized or differently masked) case
+falls back to the per-member path.
+*/
+void save_parameter_columnar(Cwrap<enkf_fs_type> target_fs,
+                             Cwrap<ensemble_config_type> ensemble_config,
+                             const std::vector<int> &iens_active_index,
+                             const Parameter parameter,
+                             const Eigen::MatrixXd &A) {
+
+    save_parameter(target_fs, ensemble_config, iens_active_index, parameter,
+                   A);
+
+    buffer_type *buffer =
+        buffer_alloc(3 * sizeof(int) + iens_active_index.size() * sizeof(int) +
+                     A.size() * sizeof(double));
+    buffer_fwrite_int(buffer, COLUMN_STORAGE_MAGIC);
+    buffer_fwrite_int(buffer, static_cast<int>(A.rows()));
+    buffer_fwrite_int(buffer, static_cast<int>(iens_active_index.size()));
+    buffer_fwrite(buffer, iens_active_index.data(), sizeof(int),
+                  iens_active_index.size());
+    buffer_fwrite(buffer, A.data(), sizeof(double), A.size());
+    enkf_fs_fwrite_node(target_fs, buffer, column_storage_key(parameter).c_str(),
+                        PARAMETER, 0, 0);
+    buffer_free(buffer);
+}
+
+/**
+Variant of load_parameter which first tries the columnar node written
+by save_parameter_columnar. The node is read as a borrowed view and
+copied once into the matrix; if it is missing or its member layout does
+not match iens_active_index the per-member path is used instead.
+*/
+Eigen::MatrixXd
+load_parameter_columnar(Cwrap<enkf_fs_type> source_fs,
+                        Cwrap<ensemble_config_type> ensemble_config,
+                        const std::vector<int> &iens_active_index,
+                        const Parameter parameter) {
+
+    std::string key = column_storage_key(parameter);
+    if (enkf_fs_has_node(source_fs, key.c_str(), PARAMETER, 0, 0)) {
+        ert::utils::ArenaScope scratch;
+        block_fs_view view;
+        enkf_fs_fread_node_view(source_fs, view, key.c_str(), PARAMETER, 0, 0);
+
+        size_t header_size = 3 * sizeof(int);
+        if (view.size >= header_size) {
+            int magic;
+            int active_size;
+            int ens_size;
+            memcpy(&magic, view.data, sizeof magic);
+            memcpy(&active_size, view.data + sizeof(int), sizeof active_size);
+            memcpy(&ens_size, view.data + 2 * sizeof(int), sizeof ens_size);
+
+            size_t expected_size = header_size + ens_size * sizeof(int) +
+                                   static_cast<size_t>(active_size) * ens_size *
+                                       sizeof(double);
+            if (magic == COLUMN_STORAGE_MAGIC && view.size == expected_size &&
+                ens_size == static_cast<int>(iens_active_index.size()) &&
+                memcmp(view.data + header_size, iens_active_index.data(),
+                       ens_size * sizeof(int)) == 0) {
+                Eigen::MatrixXd A(active_size, ens_size);
+                memcpy(A.data(),
+                       view.data + header_size + ens_size * sizeof(int),
+                       static_cast<size_t>(active_size) * ens_size *
+                           sizeof(double));
+                return A;
+            }
+        }
+        logger->warning("columnar node {} does not match the member layout - "
+                        "falling back to per-member loading",
+                        key);
+    }
+
+    return load_parameter(source_fs, ensemble_config, iens_active_index,
+                          parameter);
+}
+
+/**
+Stream the ES update A' = A * X over a parameter in row blocks of at
+most block_rows rows, so that parameters which do not fit in memory as
+a full ensemble matrix can still be updated. For every block the
+members are serialized through a block-local ActiveList, multiplied by
+the (ens_size x ens_size) transition matrix X and deserialized back.
+The write-back loads the prior node before deserializing so that rows
+outside the block are preserved; each member is therefore read and
+written once per block, trading I/O volume for bounded memory.
+*/
+void update_parameter_blocked(Cwrap<enkf_fs_type> source_fs,
+                              Cwrap<enkf_fs_type> target_fs,
+                              Cwrap<ensemble_config_type> ensemble_config,
+                              const std::vector<int> &iens_active_index,
+                              const Parameter parameter,
+                              const Eigen::MatrixXd &X, int block_rows) {
+    static auto &update_ns =
+        ert::metrics::registry().histogram("update.update_parameter_ns");
+    ert::metrics::ScopedTimer timer(update_ns);
+
+    int ens_size = iens_active_index.size();
+    assert_matrix_size(X, "X", ens_size, ens_size);
+    if (block_rows <= 0)
+        throw exc::invalid_argument("block_rows must be positive, got {}",
+                                    block_rows);
+
+    // The A' = A * X below is the dominating GEMM of the streaming
+    // update; let Eigen spread it over the machine (no-op without
+    // OpenMP). gemm_inplace() additionally offloads it to the GPU in
+    // cuBLAS builds.
+    ert::enable_eigen_threads();
+
+    const enkf_config_node_type *config_node =
+        ensemble_config_get_node(ensemble_config, parameter.name.c_str());
+    ensure_node_loaded(config_node, source_fs);
+
+    int data_size = enkf_config_node_get_data_size(config_node, 0);
+    int active_size = parameter.active_list.active_size(data_size);
+    const int *active_index = parameter.active_list.active_list_get_active();
+
+    for (int block_start = 0; block_start < active_size;
+         block_start += block_rows) {
+        int rows = std::min(block_rows, active_size - block_start);
+
+        ActiveList block_list;
+        for (int i = 0; i < rows; i++)
+            block_list.add_index(active_index ? active_index[block_start + i]
+                                              : block_start + i);
+
+        // The members within a block are independent: each column of A
+        // is one member, serialized from / deserialized to its own node
+        // in storage. Both stages are therefore spread over column
+        // chunks the same way serialize_parameter does it, with one
+        // enkf_node reused per worker.
+        int num_workers = std::max(
+            1, std::min(ens_size, (int)std::thread::hardware_concurrency()));
+        int chunk_size = (ens_size + num_workers - 1) / num_workers;
+
+        Eigen::MatrixXd A = Eigen::MatrixXd::Zero(rows, ens_size);
+        {
+            std::vector<std::future<void>> futures;
+            futures.reserve(num_workers);
+            for (int start = 0; start < ens_size; start += chunk_size) {
+                int end = std::min(ens_size, start + chunk_size);
+                futures.push_back(
+                    std::async(std::launch::async, [&, start, end] {
+                        enkf_node_type *node = enkf_node_alloc(config_node);
+                        try {
+                            for (int column = start; column < end; column++)
+                                serialize_node(source_fs, node,
+                                               iens_active_index[column], 0,
+                                               column, &block_list, A);
+                        } catch (...) {
+                            enkf_node_free(node);
+                            throw;
+                        }
+                        enkf_node_free(node);
+                    }));
+            }
+            for (auto &future : futures)
+                future.get();
+        }
+
+        ert::gemm_inplace(A, X);
+
+        // The first block seeds the target from the prior in source_fs;
+        // later blocks must re-load from target_fs so that the updates
+        // already written there are not lost.
+        enkf_fs_type *prior_fs = block_start == 0 ? source_fs : target_fs;
+        {
+            std::vector<std::future<void>> futures;
+            futures.reserve(num_workers);
+            for (int start = 0; start < ens_size; start += chunk_size) {
+                int end = std::min(ens_size, start + chunk_size);
+                futures.push_back(
+                    std::async(std::launch::async, [&, start, end] {
+                        enkf_node_type *node = enkf_node_alloc(config_node);
+                        try {
+                            for (int column = start; column < end; column++) {
+                                int iens = iens_active_index[column];
+                                node_id_type node_id = {.report_step = 0,
+                                                        .iens = iens};
+                                enkf_node_load(node, prior_fs, node_id);
+                                enkf_node_deserialize(node, target_fs, node_id,
+                                                      &block_list, A, 0,
+                                                      column);
+                                enkf_fs_get_state_map(target_fs)
+                                    .update_matching(iens, STATE_UNDEFINED,
+                                                     STATE_INITIALIZED);
+                            }
+                        } catch (...) {
+                            enkf_node_free(node);
+                            throw;
+                        }
+                        enkf_node_free(node);
+                    }));
+            }
+            for (auto &future : futures)
+                future.get();
+        }
+    }
+    // The target case changed under any cached full-member matrix.
+    invalidate_serialization_cache();
+}
+
+namespace {
+/**
+An iterative smoother calls load_observations_and_responses once per
+iteration even though neither the responses nor the observations change
+between the assembly and the solve. Cache the assembled result keyed on
+everything that influences it: the source case, the observation
+selection, the ensemble mask and the deactivation/scaling parameters.
+The cache holds a single entry - iterations hammer the same key and a
+different key means a new update context, at which point the previous
+matrices are stale anyway.
+*/
+struct ObservationCacheKey {
+    std::string mount_point;
+    double alpha;
+    double std_cutoff;
+    double global_std_scaling;
+    std::vector<bool> ens_mask;
+    std::vector<std::pair<std::string, std::vector<int>>>
+        selected_observations;
+
+    bool operator==(const ObservationCacheKey &other) const {
+        return mount_point == other.mount_point && alpha == other.alpha &&
+               std_cutoff == other.std_cutoff &&
+               global_std_scaling == other.global_std_scaling &&
+               ens_mask == other.ens_mask &&
+               selected_observations == other.selected_observations;
+    }
+};
+
+std::mutex observation_cache_mutex;
+std::optional<ObservationCacheKey> observation_cache_key;
+std::optional<std::pair<Eigen::MatrixXd, ObservationHandler>>
+    observation_cache_value;
+
+/*
+One parked obs_data/meas_data pair. Every ministep assembles into
+these structures and used to allocate and free them - including all
+the per-block buffers - once per ministep; resetting a parked pair
+instead keeps the buffers warm across the ministeps of an update and
+stabilizes peak RSS. A concurrent assembly finds the pool empty and
+simply allocates as before.
+*/
+std::mutex assembly_pool_mutex;
+obs_data_type *pooled_obs_data = nullptr;
+meas_data_type *pooled_meas_data = nullptr;
+
+void release_obs_data(obs_data_type *obs_data) {
+    {
+        std::lock_guard guard(assembly_pool_mutex);
+        if (pooled_obs_data == nullptr) {
+            pooled_obs_data = obs_data;
+            return;
+        }
+    }
+    obs_data_free(obs_data);
+}
+
+void release_meas_data(meas_data_type *meas_data) {
+    {
+        std::lock_guard guard(assembly_pool_mutex);
+        if (pooled_meas_data == nullptr) {
+            pooled_meas_data = meas_data;
+            return;
+        }
+    }
+    meas_data_free(meas_data);
+}
+} // namespace
+
+void invalidate_observation_cache() {
+    std::lock_guard guard(observation_cache_mutex);
+    observation_cache_key.reset();
+    observation_cache_value.reset();
+}
+
 std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
     enkf_fs_type *source_fs, enkf_obs_type *obs, double alpha,
     double std_cutoff, double global_std_scaling,
     const std::vector<bool> &ens_mask,
     const std::vector<std::pair<std::string, std::vector<int>>>
         &selected_observations) {
+    static auto &load_obs_ns =
+        ert::metrics::registry().histogram("update.load_observations_ns");
+    ert::metrics::ScopedTimer timer(load_obs_ns);
+    ObservationCacheKey cache_key{enkf_fs_get_mount_point(source_fs),
+                                  alpha,
+                                  std_cutoff,
+                                  global_std_scaling,
+                                  ens_mask,
+                                  selected_observations};
+    {
+        std::lock_guard guard(observation_cache_mutex);
+        if (observation_cache_key && *observation_cache_key == cache_key) {
+            logger->debug("Reusing cached observations and responses for {}",
+                          cache_key.mount_point);
+            return *observation_cache_value;
+        }
+    }
     /*
     Observations and measurements are collected in these temporary
     structures. obs_data is a precursor for the 'd' vector, and
@@ -180,10 +754,27 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
     process.
     */
 
-    obs_data_type *obs_data = obs_data_alloc(global_std_scaling);
-    meas_data_type *meas_data = meas_data_alloc(ens_mask);
+    auto wall_start = std::chrono::steady_clock::now();
+    std::clock_t cpu_start = std::clock();
 
-    std::vector<int> ens_active_list = bool_vector_to_active_list(ens_mask);
+    obs_data_type *obs_data = nullptr;
+    meas_data_type *meas_data = nullptr;
+    {
+        std::lock_guard guard(assembly_pool_mutex);
+        std::swap(obs_data, pooled_obs_data);
+        std::swap(meas_data, pooled_meas_data);
+    }
+    ert::EnsembleMask mask(ens_mask);
+    if (obs_data)
+        obs_data_reset(obs_data, global_std_scaling);
+    else
+        obs_data = obs_data_alloc(global_std_scaling);
+    if (meas_data)
+        meas_data_reset(meas_data, mask);
+    else
+        meas_data = meas_data_alloc(mask);
+
+    std::vector<int> ens_active_list = mask.active_list();
     enkf_obs_get_obs_and_measure_data(obs, source_fs, selected_observations,
                                       ens_active_list, meas_data, obs_data);
     enkf_analysis_deactivate_outliers(obs_data, meas_data, std_cutoff, alpha,
@@ -194,7 +785,7 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
     int active_ens_size = meas_data_get_active_ens_size(meas_data);
     Eigen::MatrixXd S = meas_data_makeS(meas_data);
     assert_matrix_size(S, "S", active_obs_size, active_ens_size);
-    meas_data_free(meas_data);
+    release_meas_data(meas_data);
 
     Eigen::VectorXd observation_values = obs_data_values_as_vector(obs_data);
     // Inflating measurement errors by a factor sqrt(global_std_scaling) as shown
@@ -204,11 +795,26 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
         obs_data_errors_as_vector(obs_data) * sqrt(global_std_scaling);
     std::vector<bool> obs_mask = obs_data_get_active_mask(obs_data);
 
-    obs_data_free(obs_data);
+    release_obs_data(obs_data);
+
+    /* A cache hit returns the snapshot (and hence this timing) from the
+       iteration which actually did the assembly. */
+    update_snapshot.add_timing(
+        "observation/response assembly",
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      wall_start)
+            .count(),
+        double(std::clock() - cpu_start) / CLOCKS_PER_SEC);
 
-    return std::pair<Eigen::MatrixXd, ObservationHandler>(
+    auto result = std::pair<Eigen::MatrixXd, ObservationHandler>(
         S, ObservationHandler(observation_values, observation_errors, obs_mask,
                               update_snapshot));
+    {
+        std::lock_guard guard(observation_cache_mutex);
+        observation_cache_key = std::move(cache_key);
+        observation_cache_value = result;
+    }
+    return result;
 }
 } // namespace analysis
 
@@ -266,7 +872,31 @@ ERT_CLIB_SUBMODULE("update", m) {
         .def_readwrite("update_snapshot",
                        &analysis::ObservationHandler::update_snapshot);
     m.def("load_observations_and_responses",
-          load_observations_and_responses_pybind);
+          load_observations_and_responses_pybind,
+          // Released so that disjoint update steps can assemble their
+          // observation sets concurrently.
+          py::call_guard<py::gil_scoped_release>());
+    m.def("invalidate_observation_cache",
+          analysis::invalidate_observation_cache,
+          "Drop the cached result of load_observations_and_responses; "
+          "required if new responses are internalized into the same case "
+          "within one update context.");
+    m.def("invalidate_serialization_cache",
+          analysis::invalidate_serialization_cache,
+          "Drop the cached full-member matrix used to serve partly "
+          "active load_parameter calls; required if the source case is "
+          "modified outside save_parameter.");
     m.def("save_parameter", analysis::save_parameter);
     m.def("load_parameter", analysis::load_parameter);
+    m.def("save_parameter_fp32", analysis::save_parameter_fp32);
+    m.def("load_parameter_fp32", analysis::load_parameter_fp32);
+    m.def("save_parameter_columnar", analysis::save_parameter_columnar);
+    m.def("load_parameter_columnar", analysis::load_parameter_columnar);
+    m.def("update_parameter_blocked", analysis::update_parameter_blocked,
+          py::arg("source_fs"), py::arg("target_fs"),
+          py::arg("ensemble_config"), py::arg("iens_active_index"),
+          py::arg("parameter"), py::arg("X"),
+          // Default of 2^21 rows bounds the block to 2 GB for a
+          // 125 member ensemble of doubles.
+          py::arg("block_rows") = 1 << 21);
 }
@@ -64,6 +64,20 @@ struct conf_item_spec_struct {
 struct conf_item_struct {
     const conf_item_spec_type *conf_item_spec;
     char *value;
+    /** Typed views of @value, parsed once in conf_item_alloc() when
+     * the data type supports them. The typed getters below serve these
+     * instead of re-running strtod / date parsing on every access -
+     * enkf_obs reads several item values more than once per
+     * observation while building the observation vectors. The *_valid
+     * flags record whether @value parses as the respective type; the
+     * getters abort on access when it does not, like the conf_data
+     * conversions used to. */
+    bool int_valid;
+    int int_value;
+    bool double_valid;
+    double double_value;
+    bool time_t_valid;
+    time_t time_t_value;
 };
 
 struct conf_item_mutex_struct {
@@ -241,6 +255,38 @@ void conf_item_spec_free__(void *conf_item_spec) {
     conf_item_spec_free((conf_item_spec_type *)conf_item_spec);
 }
 
+/** Parse the typed views of the item value supported by its data
+    type; types the value does not parse as are left invalid. */
+static void conf_item_parse_typed(conf_item_type *conf_item) {
+    const dt_enum dt = conf_item->conf_item_spec->dt;
+
+    conf_item->int_valid = false;
+    conf_item->double_valid = false;
+    conf_item->time_t_valid = false;
+
+    switch (dt) {
+    case (DT_INT):
+    case (DT_POSINT):
+        conf_item->int_valid =
+            util_sscanf_int(conf_item->value, &conf_item->int_value);
+        conf_item->double_valid =
+            util_sscanf_double(conf_item->value, &conf_item->double_value);
+        break;
+    case (DT_FLOAT):
+    case (DT_POSFLOAT):
+        conf_item->double_valid =
+            util_sscanf_double(conf_item->value, &conf_item->double_value);
+        break;
+    case (DT_DATE):
+        conf_item->time_t_valid =
+            util_sscanf_isodate(conf_item->value, &conf_item->time_t_value) ||
+            util_sscanf_date_utc(conf_item->value, &conf_item->time_t_value);
+        break;
+    default:
+        break;
+    }
+}
+
 conf_item_type *conf_item_alloc(const conf_item_spec_type *conf_item_spec,
                                 const char *value) {
     conf_item_type *conf_item =
@@ -254,6 +300,7 @@ conf_item_type *conf_item_alloc(const conf_item_spec_type *conf_item_spec,
         conf_item->value = util_alloc_abs_path(value);
     else
         conf_item->value = util_alloc_string_copy(value);
+    conf_item_parse_typed(conf_item);
 
     return conf_item;
 }
@@ -659,9 +706,11 @@ int conf_instance_get_item_value_int(const conf_instance_type *conf_instance,
 
     const conf_item_type *conf_item =
         (const conf_item_type *)hash_get(conf_instance->items, item_name);
-    const conf_item_spec_type *conf_item_spec = conf_item->conf_item_spec;
 
-    return conf_data_get_int_from_string(conf_item_spec->dt, conf_item->value);
+    if (!conf_item->int_valid)
+        util_abort("%s: Can not get an int from \"%s\".\n", __func__,
+                   conf_item->value);
+    return conf_item->int_value;
 }
 
 /** If the dt supports it, this function shall return the item value as a double.
@@ -677,11 +726,11 @@ conf_instance_get_item_value_double(const conf_instance_type *conf_instance,
 
     const conf_item_type *conf_item =
         (const conf_item_type *)hash_get(conf_instance->items, item_name);
-    const conf_item_spec_type *conf_item_spec =
-        (const conf_item_spec_type *)conf_item->conf_item_spec;
 
-    return conf_data_get_double_from_string(conf_item_spec->dt,
-                                            conf_item->value);
+    if (!conf_item->double_valid)
+        util_abort("%s: Can not get a double from \"%s\".\n", __func__,
+                   conf_item->value);
+    return conf_item->double_value;
 }
 
 /** If the dt supports it, this function shall return the item value as a time_t.
@@ -697,10 +746,11 @@ conf_instance_get_item_value_time_t(const conf_instance_type *conf_instance,
 
     const conf_item_type *conf_item =
         (const conf_item_type *)hash_get(conf_instance->items, item_name);
-    const conf_item_spec_type *conf_item_spec = conf_item->conf_item_spec;
 
-    return conf_data_get_time_t_from_string(conf_item_spec->dt,
-                                            conf_item->value);
+    if (!conf_item->time_t_valid)
+        util_abort("%s: Can not get a time_t from \"%s\".\n", __func__,
+                   conf_item->value);
+    return conf_item->time_t_value;
 }
 
 static void
@@ -1203,10 +1253,17 @@ static void conf_instance_parser_skip_unknown_class(char **buffer_pos) {
     }
 }
 
-static void
-conf_instance_add_data_from_token_buffer(conf_instance_type *conf_instance,
-                                         char **buffer_pos,
-                                         bool allow_inclusion, bool is_root) {
+/**
+   When @visitor != NULL the parser runs in streaming mode: every
+   completed top level sub instance is handed to the visitor instead
+   of being inserted into @conf_instance, so the full instance tree is
+   never held in memory for the common flat structure. The visitor
+   takes ownership of each instance it receives; nested sub instances
+   (e.g. SEGMENT) are still collected in their parent as before.
+*/
+static void conf_instance_add_data_from_token_buffer(
+    conf_instance_type *conf_instance, char **buffer_pos, bool allow_inclusion,
+    bool is_root, conf_instance_visitor_ftype *visitor, void *visitor_arg) {
     const conf_class_type *conf_class = conf_instance->conf_class;
     char *token = conf_util_alloc_next_token(buffer_pos);
 
@@ -1226,10 +1283,14 @@ conf_instance_add_data_from_token_buffer(conf_instance_type *conf_instance,
                 conf_instance_type *sub_conf_instance =
                     conf_instance_alloc_default(sub_conf_class, name);
                 free(name);
-                conf_instance_insert_owned_sub_instance(conf_instance,
-                                                        sub_conf_instance);
                 conf_instance_add_data_from_token_buffer(
-                    sub_conf_instance, buffer_pos, allow_inclusion, false);
+                    sub_conf_instance, buffer_pos, allow_inclusion, false,
+                    visitor, visitor_arg);
+                if (is_root && visitor != NULL)
+                    visitor(sub_conf_instance, visitor_arg);
+                else
+                    conf_instance_insert_owned_sub_instance(conf_instance,
+                                                            sub_conf_instance);
             } else
                 printf("WARNING: Unexpected EOF after \"%s\".\n\n", token);
         } else if (strcmp(token, "}") == 0) {
@@ -1274,7 +1335,8 @@ conf_instance_add_data_from_token_buffer(conf_instance_type *conf_instance,
                     char *buffer_pos_new = buffer_new;
 
                     conf_instance_add_data_from_token_buffer(
-                        conf_instance, &buffer_pos_new, false, true);
+                        conf_instance, &buffer_pos_new, false, true, visitor,
+                        visitor_arg);
 
                     free(buffer_new);
                 }
@@ -1330,6 +1392,20 @@ conf_instance_add_data_from_token_buffer(conf_instance_type *conf_instance,
 conf_instance_type *
 conf_instance_alloc_from_file(const conf_class_type *conf_class,
                               const char *name, const char *file_name) {
+    return conf_instance_alloc_from_file_visitor(conf_class, name, file_name,
+                                                 NULL, NULL);
+}
+
+/**
+   Streaming variant of conf_instance_alloc_from_file: top level sub
+   instances are handed to @visitor one at a time as they complete
+   instead of being collected in the returned root instance. The root
+   instance is still returned so root level items and validation can
+   be handled by the caller.
+*/
+conf_instance_type *conf_instance_alloc_from_file_visitor(
+    const conf_class_type *conf_class, const char *name, const char *file_name,
+    conf_instance_visitor_ftype *visitor, void *visitor_arg) {
     conf_instance_type *conf_instance =
         conf_instance_alloc_default(conf_class, name);
     path_stack_type *path_stack = path_stack_alloc();
@@ -1340,8 +1416,8 @@ conf_instance_alloc_from_file(const conf_class_type *conf_class,
         char *buffer = conf_util_fscanf_alloc_token_buffer(file_arg);
         char *buffer_pos = buffer;
 
-        conf_instance_add_data_from_token_buffer(conf_instance, &buffer_pos,
-                                                 true, true);
+        conf_instance_add_data_from_token_buffer(
+            conf_instance, &buffer_pos, true, true, visitor, visitor_arg);
 
         free(buffer);
     }
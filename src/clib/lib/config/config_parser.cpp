@@ -1,14 +1,23 @@
 #include <filesystem>
-
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include <ert/concurrency.hpp>
 #include <ert/logging.hpp>
 #include <ert/res_util/res_env.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/hash.hpp>
-#include <ert/util/parser.hpp>
 #include <ert/util/path_stack.hpp>
 
 #include <ert/config/config_parser.hpp>
@@ -436,6 +445,57 @@ bool config_parser_add_key_values(
     return new_node != NULL;
 }
 
+/**
+   Split one logical line into tokens, in place over the file buffer.
+   Tokens are separated by spaces and tabs, a double quoted section
+   forms one token with the quote marks stripped, and everything from
+   @comment_string to the end of the line is discarded. The returned
+   views point into @line - no strings are allocated here; tokens are
+   only materialized when a line actually carries content and must be
+   handed over to the stringlist based config_content api.
+*/
+static std::vector<std::string_view>
+tokenize_line(std::string_view line, const char *comment_string,
+              size_t comment_length) {
+    std::vector<std::string_view> tokens;
+    size_t pos = 0;
+    while (pos < line.size()) {
+        char c = line[pos];
+        if (c == ' ' || c == '\t' || c == '\r') {
+            pos++;
+            continue;
+        }
+        if (comment_length &&
+            line.compare(pos, comment_length, comment_string) == 0)
+            break;
+
+        if (c == '"') {
+            size_t end = line.find('"', pos + 1);
+            if (end == std::string_view::npos) {
+                tokens.push_back(line.substr(pos + 1));
+                break;
+            }
+            tokens.push_back(line.substr(pos + 1, end - pos - 1));
+            pos = end + 1;
+            continue;
+        }
+
+        size_t end = pos + 1;
+        while (end < line.size()) {
+            char ec = line[end];
+            if (ec == ' ' || ec == '\t' || ec == '\r' || ec == '"')
+                break;
+            if (comment_length &&
+                line.compare(end, comment_length, comment_string) == 0)
+                break;
+            end++;
+        }
+        tokens.push_back(line.substr(pos, end - pos));
+        pos = end;
+    }
+    return tokens;
+}
+
 /**
    This function parses the config file 'filename', and updated the
    internal state of the config object as parsing proceeds. If
@@ -506,97 +566,477 @@ bool config_parser_add_key_values(
    The         key-value pairs internalized during the config parsing are NOT
    returned to the calling scope in any way.
 */
+struct config_include_prefetch;
+
 static void
 config_parse__(config_parser_type *config, config_content_type *content,
-               path_stack_type *path_stack, const char *config_filename,
+               path_stack_type *path_stack,
+               config_include_prefetch *prefetch, const char *config_filename,
                const char *comment_string, const char *include_kw,
                const char *define_kw,
-               config_schema_unrecognized_enum unrecognized, bool validate) {
-    assert_no_circular_includes(content, config_filename);
+               config_schema_unrecognized_enum unrecognized, bool validate,
+               bool is_include);
 
-    // Relocate
-    char *config_path;
-    char *config_file;
-    alloc_config_filename_components(config_filename, &config_path,
-                                     &config_file);
-
-    config_path_elm_type *current_path_elm =
-        config_relocate(config_path, content, path_stack);
-    free(config_path);
+#define CONFIG_PARSE_CACHE_VERSION 1
 
-    // Setup config parsing
-    const char *comment_end = comment_string ? "\n" : NULL;
-    basic_parser_type *parser = basic_parser_alloc(" \t", "\"", NULL, NULL,
-                                                   comment_string, comment_end);
+/**
+   The token cache lives under $XDG_CACHE_HOME/ert (falling back to
+   $HOME/.cache/ert). Returns NULL when no cache location can be
+   resolved - parsing then just proceeds without caching. The (mtime,
+   size) pair is part of the file name, so an edited include file
+   automatically misses and leaves its stale entry behind to be aged
+   out of the cache directory.
+*/
+static char *config_parse_alloc_cache_filename(const char *config_file) {
+    if (!fs::exists(config_file))
+        return NULL;
+
+    std::string cache_dir;
+    const char *xdg_cache = getenv("XDG_CACHE_HOME");
+    if (xdg_cache != NULL)
+        cache_dir = xdg_cache;
+    else {
+        const char *home = getenv("HOME");
+        if (home == NULL)
+            return NULL;
+        cache_dir = std::string(home) + "/.cache";
+    }
+    cache_dir += "/ert/config_cache";
+
+    std::error_code error;
+    fs::create_directories(cache_dir, error);
+    if (error)
+        return NULL;
+
+    char *abs_path = util_alloc_abs_path(config_file);
+    uint64_t path_hash = 0xcbf29ce484222325ULL;
+    for (const char *c = abs_path; *c != '\0'; c++) {
+        path_hash ^= (unsigned char)*c;
+        path_hash *= 0x100000001b3ULL;
+    }
+    free(abs_path);
 
-    FILE *stream = util_fopen(config_file, "r");
-    bool at_eof = false;
+    return (char *)util_alloc_sprintf(
+        "%s/%016llx-%lld-%lld.tokens", cache_dir.c_str(),
+        (unsigned long long)path_hash, (long long)util_file_mtime(config_file),
+        (long long)util_file_size(config_file));
+}
 
-    while (!at_eof) {
-        char *line_buffer = util_fscanf_alloc_line(stream, &at_eof);
-        if (!line_buffer)
-            continue;
+/**
+   Cache format: a version marker followed by one record per tokenized
+   line, each holding the token count and length prefixed token
+   strings, closed with a -1 end marker. The whole file is decoded
+   before anything is handed back, so a truncated cache file is
+   rejected without side effects.
+*/
+static bool
+config_parse_load_cache(const char *cache_file,
+                        std::vector<stringlist_type *> &token_lines) {
+    FILE *stream = fopen(cache_file, "r");
+    if (stream == NULL)
+        return false;
+
+    int32_t version = 0;
+    bool ok = fread(&version, sizeof version, 1, stream) == 1 &&
+              version == CONFIG_PARSE_CACHE_VERSION;
+
+    std::string token;
+    while (ok) {
+        int32_t token_count = 0;
+        if (fread(&token_count, sizeof token_count, 1, stream) != 1) {
+            ok = false;
+            break;
+        }
+        if (token_count < 0)
+            break;
+
+        stringlist_type *token_list = stringlist_alloc_new();
+        token_lines.push_back(token_list);
+        for (int32_t i = 0; ok && i < token_count; i++) {
+            int32_t length = -1;
+            if (fread(&length, sizeof length, 1, stream) != 1 || length < 0) {
+                ok = false;
+                break;
+            }
+            token.resize(length);
+            if (length > 0 &&
+                fread(&token[0], 1, length, stream) != (size_t)length) {
+                ok = false;
+                break;
+            }
+            stringlist_append_copy(token_list, token.c_str());
+        }
+    }
+    fclose(stream);
 
-        stringlist_type *token_list =
-            basic_parser_tokenize_buffer(parser, line_buffer, true);
-        int active_tokens = stringlist_get_size(token_list);
+    if (!ok) {
+        for (stringlist_type *token_list : token_lines)
+            stringlist_free(token_list);
+        token_lines.clear();
+    }
+    return ok;
+}
 
-        if (active_tokens > 0) {
-            const char *kw = stringlist_iget(token_list, 0);
+/**
+   The write is atomic (temp file + rename) so neither concurrent ert
+   invocations nor the prefetch threads of this one ever observe a
+   partial cache file. Failures are silently ignored - the cache is
+   purely an optimization.
+*/
+static void
+config_parse_write_cache(const char *cache_file,
+                         const std::vector<stringlist_type *> &token_lines) {
+    static std::atomic<int> write_counter{0};
+    char *tmp_file =
+        (char *)util_alloc_sprintf("%s.%d.%d", cache_file, (int)getpid(),
+                                   write_counter.fetch_add(1));
+    FILE *stream = fopen(tmp_file, "w");
+    if (stream == NULL) {
+        free(tmp_file);
+        return;
+    }
 
-            // Include config file
-            if (include_kw && (strcmp(include_kw, kw) == 0)) {
-                if (active_tokens != 2)
-                    util_abort(
-                        "%s: keyword:%s must have exactly one argument. \n",
-                        __func__, include_kw);
+    int32_t version = CONFIG_PARSE_CACHE_VERSION;
+    bool ok = fwrite(&version, sizeof version, 1, stream) == 1;
+    for (size_t line = 0; ok && line < token_lines.size(); line++) {
+        const stringlist_type *token_list = token_lines[line];
+        int32_t token_count = stringlist_get_size(token_list);
+        ok = fwrite(&token_count, sizeof token_count, 1, stream) == 1;
+        for (int32_t i = 0; ok && i < token_count; i++) {
+            const char *token = stringlist_iget(token_list, i);
+            int32_t length = strlen(token);
+            ok = fwrite(&length, sizeof length, 1, stream) == 1 &&
+                 fwrite(token, 1, length, stream) == (size_t)length;
+        }
+    }
+    if (ok) {
+        int32_t end_marker = -1;
+        ok = fwrite(&end_marker, sizeof end_marker, 1, stream) == 1;
+    }
+    fclose(stream);
 
-                const char *include_file = stringlist_iget(token_list, 1);
+    if (!ok)
+        remove(tmp_file);
+    else if (rename(tmp_file, cache_file) != 0)
+        remove(tmp_file);
+    free(tmp_file);
+}
 
-                if (!fs::exists(include_file)) {
-                    char *error_message = (char *)util_alloc_sprintf(
-                        "%s file:%s not found", include_kw, include_file);
-                    config_error_add(config_content_get_errors(content),
-                                     error_message);
-                    free(error_message);
+/**
+   Tokenize @config_file into one stringlist per non-empty line, going
+   through the on-disk token cache when @use_cache is set. The file is
+   read in one gulp and tokenized in place with std::string_view;
+   master configs plus includes run to tens of thousands of lines and
+   parse time used to be dominated by the per line / per token
+   allocations of the old line reader. Tokens are only copied out to a
+   stringlist for the lines which actually carry content.
+*/
+static std::vector<stringlist_type *>
+config_parse_alloc_token_lines(const char *config_file,
+                               const char *comment_string, bool use_cache) {
+    std::vector<stringlist_type *> token_lines;
+    char *cache_file =
+        use_cache ? config_parse_alloc_cache_filename(config_file) : NULL;
+
+    if (!(cache_file && config_parse_load_cache(cache_file, token_lines))) {
+        char *file_content = util_fread_alloc_file_content(config_file, NULL);
+        std::string_view buffer(file_content);
+        size_t comment_length = comment_string ? strlen(comment_string) : 0;
+
+        size_t buffer_pos = 0;
+        while (buffer_pos < buffer.size()) {
+            size_t line_end = buffer.find('\n', buffer_pos);
+            if (line_end == std::string_view::npos)
+                line_end = buffer.size();
+            std::string_view line =
+                buffer.substr(buffer_pos, line_end - buffer_pos);
+            buffer_pos = line_end + 1;
+
+            std::vector<std::string_view> tokens =
+                tokenize_line(line, comment_string, comment_length);
+
+            if (!tokens.empty()) {
+                stringlist_type *token_list = stringlist_alloc_new();
+                for (const auto &token : tokens) {
+                    std::string token_string(token);
+                    stringlist_append_copy(token_list, token_string.c_str());
                 }
-
-                config_parse__(config, content, path_stack, include_file,
-                               comment_string, include_kw, define_kw,
-                               unrecognized, false);
+                token_lines.push_back(token_list);
             }
+        }
 
-            // Add define
-            else if (define_kw && (strcmp(define_kw, kw) == 0)) {
-                if (active_tokens < 3)
-                    util_abort("%s: keyword:%s must have exactly one (or more) "
-                               "arguments. \n",
-                               __func__, define_kw);
+        free(file_content);
 
-                char *key = (char *)util_alloc_string_copy(
-                    stringlist_iget(token_list, 1));
-                char *value = stringlist_alloc_joined_substring(
-                    token_list, 2, active_tokens, " ");
+        if (cache_file)
+            config_parse_write_cache(cache_file, token_lines);
+    }
 
-                config_content_add_define(content, key, value);
+    free(cache_file);
+    return token_lines;
+}
 
-                free(key);
-                free(value);
-            }
+/**
+   Include files are independent of the shared config_content until
+   their token lines are actually dispatched, so the expensive part -
+   reading and tokenizing the file, which on a cold cache is dominated
+   by (NFS) I/O latency - is started on the global thread pool as soon
+   as an include directive is seen, while the dispatch itself stays
+   strictly serial in declaration order. That keeps the order dependent
+   machinery (DEFINE substitution, the parser cwd maintained with
+   util_chdir, circular include detection) untouched.
+
+   The parser cwd changes while includes are dispatched, so the
+   background tasks never resolve relative paths themselves: every
+   include path is made absolute on the thread that discovered it,
+   while the cwd is known to be that of the including file, and the
+   entries are keyed by the lexically normalized absolute path so the
+   consuming config_parse__ call finds them regardless of the cwd at
+   that point.
+*/
+struct config_include_prefetch {
+    struct entry_type {
+        std::future<void> done;
+        std::vector<stringlist_type *> token_lines;
+        bool loaded = false;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<entry_type>> entries;
+};
+
+static void config_prefetch_includes(
+    config_include_prefetch *prefetch,
+    const std::vector<stringlist_type *> &token_lines,
+    const std::string &base_dir, const char *comment_string,
+    const char *include_kw);
+
+/** Start a background read+tokenize of @abs_path unless one is
+    already pending. Nested includes discovered by the task are
+    resolved against the directory of @abs_path and submitted in turn,
+    so a chain of includes is prefetched as soon as its parent has been
+    tokenized. */
+static void config_prefetch_submit(config_include_prefetch *prefetch,
+                                   const std::string &abs_path,
+                                   const char *comment_string,
+                                   const char *include_kw) {
+    std::lock_guard guard{prefetch->mutex};
+    if (prefetch->entries.count(abs_path))
+        return;
+
+    auto entry = std::make_shared<config_include_prefetch::entry_type>();
+    std::string comment = comment_string ? comment_string : "";
+    bool has_comment = comment_string != NULL;
+    std::string include = include_kw;
+
+    entry->done = ert::global_pool().submit([prefetch, entry, abs_path,
+                                             comment, has_comment, include] {
+        if (!fs::exists(abs_path))
+            return;
+
+        entry->token_lines = config_parse_alloc_token_lines(
+            abs_path.c_str(), has_comment ? comment.c_str() : NULL, true);
+        entry->loaded = true;
+
+        std::string parent_dir = fs::path(abs_path).parent_path().string();
+        config_prefetch_includes(prefetch, entry->token_lines, parent_dir,
+                                 has_comment ? comment.c_str() : NULL,
+                                 include.c_str());
+    });
+    prefetch->entries[abs_path] = entry;
+}
+
+/** Scan @token_lines for include directives and start a background
+    read+tokenize for each one, with relative paths resolved against
+    @base_dir. */
+static void config_prefetch_includes(
+    config_include_prefetch *prefetch,
+    const std::vector<stringlist_type *> &token_lines,
+    const std::string &base_dir, const char *comment_string,
+    const char *include_kw) {
+    for (const stringlist_type *token_list : token_lines) {
+        if (stringlist_get_size(token_list) != 2)
+            continue;
+        if (strcmp(include_kw, stringlist_iget(token_list, 0)) != 0)
+            continue;
 
-            // Add keyword
-            else
-                config_parser_add_key_values(config, content, kw, token_list,
-                                             current_path_elm, config_file,
-                                             unrecognized);
+        std::string abs_path = (fs::path(base_dir) /
+                                stringlist_iget(token_list, 1))
+                                   .lexically_normal()
+                                   .string();
+        config_prefetch_submit(prefetch, abs_path, comment_string,
+                               include_kw);
+    }
+}
+
+/** Hand over the prefetched token lines for @abs_path, blocking until
+    the background task has finished. Returns false when no prefetch is
+    pending or the task could not read the file; the caller then falls
+    back to reading it synchronously (reproducing the original error
+    handling for missing files). */
+static bool config_prefetch_take(config_include_prefetch *prefetch,
+                                 const std::string &abs_path,
+                                 std::vector<stringlist_type *> &token_lines) {
+    std::shared_ptr<config_include_prefetch::entry_type> entry;
+    {
+        std::lock_guard guard{prefetch->mutex};
+        auto iter = prefetch->entries.find(abs_path);
+        if (iter == prefetch->entries.end())
+            return false;
+        entry = iter->second;
+        prefetch->entries.erase(iter);
+    }
+
+    entry->done.wait();
+    if (!entry->loaded)
+        return false;
+
+    token_lines = std::move(entry->token_lines);
+    return true;
+}
+
+/** Wait for every prefetch task which was never consumed (includes
+    behind an error path, or still in flight when parsing finished) and
+    release its token lines. Tasks keep submitting nested includes
+    while this loop runs, so the map is drained entry by entry under
+    the lock until it stays empty. */
+static void config_prefetch_drain(config_include_prefetch *prefetch) {
+    for (;;) {
+        std::shared_ptr<config_include_prefetch::entry_type> entry;
+        {
+            std::lock_guard guard{prefetch->mutex};
+            if (prefetch->entries.empty())
+                return;
+            auto iter = prefetch->entries.begin();
+            entry = iter->second;
+            prefetch->entries.erase(iter);
         }
+        entry->done.wait();
+        for (stringlist_type *token_list : entry->token_lines)
+            stringlist_free(token_list);
+    }
+}
 
-        stringlist_free(token_list);
-        free(line_buffer);
+/**
+   Dispatch one tokenized line: include files are parsed recursively,
+   defines are added to the content and everything else is handed to
+   the schema validation in config_parser_add_key_values().
+*/
+static void config_parse_token_list(
+    config_parser_type *config, config_content_type *content,
+    path_stack_type *path_stack, config_include_prefetch *prefetch,
+    stringlist_type *token_list, const config_path_elm_type *current_path_elm,
+    const char *config_file, const char *comment_string,
+    const char *include_kw, const char *define_kw,
+    config_schema_unrecognized_enum unrecognized) {
+    int active_tokens = stringlist_get_size(token_list);
+    const char *kw = stringlist_iget(token_list, 0);
+
+    // Include config file
+    if (include_kw && (strcmp(include_kw, kw) == 0)) {
+        if (active_tokens != 2)
+            util_abort("%s: keyword:%s must have exactly one argument. \n",
+                       __func__, include_kw);
+
+        const char *include_file = stringlist_iget(token_list, 1);
+
+        if (!fs::exists(include_file)) {
+            char *error_message = (char *)util_alloc_sprintf(
+                "%s file:%s not found", include_kw, include_file);
+            config_error_add(config_content_get_errors(content), error_message);
+            free(error_message);
+        }
+
+        config_parse__(config, content, path_stack, prefetch, include_file,
+                       comment_string, include_kw, define_kw, unrecognized,
+                       false, true);
     }
 
-    fclose(stream);
-    basic_parser_free(parser);
+    // Add define
+    else if (define_kw && (strcmp(define_kw, kw) == 0)) {
+        if (active_tokens < 3)
+            util_abort("%s: keyword:%s must have exactly one (or more) "
+                       "arguments. \n",
+                       __func__, define_kw);
+
+        char *key =
+            (char *)util_alloc_string_copy(stringlist_iget(token_list, 1));
+        char *value = stringlist_alloc_joined_substring(token_list, 2,
+                                                        active_tokens, " ");
+
+        config_content_add_define(content, key, value);
+
+        free(key);
+        free(value);
+    }
+
+    // Add keyword
+    else
+        config_parser_add_key_values(config, content, kw, token_list,
+                                     current_path_elm, config_file,
+                                     unrecognized);
+}
+
+static void
+config_parse__(config_parser_type *config, config_content_type *content,
+               path_stack_type *path_stack,
+               config_include_prefetch *prefetch, const char *config_filename,
+               const char *comment_string, const char *include_kw,
+               const char *define_kw,
+               config_schema_unrecognized_enum unrecognized, bool validate,
+               bool is_include) {
+    /*
+      The prefetch key must be resolved while the cwd is still that of
+      the including file - config_relocate() below moves it.
+    */
+    std::string abs_filename;
+    if (is_include)
+        abs_filename =
+            (fs::current_path() / config_filename).lexically_normal().string();
+
+    assert_no_circular_includes(content, config_filename);
+
+    // Relocate
+    char *config_path;
+    char *config_file;
+    alloc_config_filename_components(config_filename, &config_path,
+                                     &config_file);
+
+    config_path_elm_type *current_path_elm =
+        config_relocate(config_path, content, path_stack);
+    free(config_path);
+
+    /*
+      Include files (typically the site config and other shared
+      includes) are re-parsed by every ert invocation; their token
+      stream is cached on disk keyed by (path, mtime, size) and
+      replayed through the normal dispatch on a hit. When the file was
+      already read and tokenized by a background prefetch task the
+      result is just taken over from there.
+    */
+    std::vector<stringlist_type *> token_lines;
+    if (!(is_include &&
+          config_prefetch_take(prefetch, abs_filename, token_lines)))
+        token_lines = config_parse_alloc_token_lines(
+            config_file, comment_string, is_include);
+
+    /*
+      Start reading the files included from this one in the background
+      before any line is dispatched - the dispatch below stays serial
+      and in declaration order, but by the time it reaches an include
+      directive the file is typically already tokenized.
+    */
+    if (include_kw != NULL)
+        config_prefetch_includes(prefetch, token_lines,
+                                 fs::current_path().string(), comment_string,
+                                 include_kw);
+
+    for (stringlist_type *token_list : token_lines) {
+        config_parse_token_list(config, content, path_stack, prefetch,
+                                token_list, current_path_elm, config_file,
+                                comment_string, include_kw, define_kw,
+                                unrecognized);
+        stringlist_free(token_list);
+    }
 
     if (validate)
         config_validate(config, content);
@@ -629,8 +1069,11 @@ config_parse(config_parser_type *config, const char *filename,
 
     if (util_file_readable(filename)) {
         path_stack_type *path_stack = path_stack_alloc();
-        config_parse__(config, content, path_stack, filename, comment_string,
-                       include_kw, define_kw, unrecognized_behaviour, validate);
+        config_include_prefetch prefetch;
+        config_parse__(config, content, path_stack, &prefetch, filename,
+                       comment_string, include_kw, define_kw,
+                       unrecognized_behaviour, validate, false);
+        config_prefetch_drain(&prefetch);
         path_stack_free(path_stack);
     } else {
         char *error_message = (char *)util_alloc_sprintf(
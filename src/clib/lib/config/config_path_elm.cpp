@@ -18,7 +18,10 @@ config_path_elm_type *config_path_elm_alloc(const fs::path &root_path,
     } else {
         path_elm->path = root_path / path;
     }
-    path_elm->path = fs::absolute(path_elm->path);
+    /* The root path handed over by config_content_add_path_elm() is
+       already absolute; only consult the process cwd when it is not. */
+    if (!path_elm->path.is_absolute())
+        path_elm->path = fs::absolute(path_elm->path);
     return path_elm;
 }
 
@@ -37,6 +40,12 @@ char *config_path_elm_alloc_path(const config_path_elm_type *path_elm,
                                  const char *input_path) {
     if (input_path[0] == '/')
         return strdup(input_path);
-    auto path = (path_elm->path / input_path).lexically_normal();
-    return strdup(path.c_str());
+
+    auto iter = path_elm->resolved_paths.find(input_path);
+    if (iter == path_elm->resolved_paths.end()) {
+        auto path = (path_elm->path / input_path).lexically_normal();
+        iter = path_elm->resolved_paths.emplace(input_path, path.string())
+                   .first;
+    }
+    return strdup(iter->second.c_str());
 }
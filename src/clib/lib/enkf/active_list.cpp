@@ -1,6 +1,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <iterator>
 #include <stdexcept>
 
 #include "ert/python.hpp"
@@ -40,10 +41,15 @@ a fault object. Then the code will be like:
 */
 
 void ActiveList::add_index(int new_index) {
-    auto iter = std::find(this->m_index_list.begin(), this->m_index_list.end(),
-                          new_index);
-    if (iter == this->m_index_list.end()) {
-        this->m_index_list.push_back(new_index);
+    /* The list is kept sorted: the duplicate check is then a binary
+       search instead of a linear scan (which made building large
+       masks quadratic), and sorted order is what makes the interval
+       extraction below possible. Appending indices in increasing
+       order - the common build pattern - inserts at the end. */
+    auto iter = std::lower_bound(this->m_index_list.begin(),
+                                 this->m_index_list.end(), new_index);
+    if (iter == this->m_index_list.end() || *iter != new_index) {
+        this->m_index_list.insert(iter, new_index);
         this->m_mode = PARTLY_ACTIVE;
     }
 }
@@ -85,6 +91,124 @@ const std::vector<int> &ActiveList::index_list() const {
     return this->m_index_list;
 }
 
+/**
+   If the active set forms a single contiguous run the (start, count)
+   pair of that run is returned, enabling one bulk copy instead of the
+   per-index indirection. ALL_ACTIVE trivially maps to (0, total_size).
+*/
+std::optional<std::pair<int, int>>
+ActiveList::contiguous_range(int total_size) const {
+    if (this->m_mode == ALL_ACTIVE)
+        return std::make_pair(0, total_size);
+
+    if (this->m_index_list.empty())
+        return std::make_pair(0, 0);
+
+    int count = static_cast<int>(this->m_index_list.size());
+    if (this->m_index_list.back() - this->m_index_list.front() + 1 == count)
+        return std::make_pair(this->m_index_list.front(), count);
+
+    return std::nullopt;
+}
+
+/**
+   Extract the active set as a list of (start, count) runs of
+   consecutive indices. Field masks are typically long runs broken by
+   inactive cells, so consumers can iterate a handful of intervals
+   with bulk copies instead of millions of indirect lookups.
+*/
+std::vector<std::pair<int, int>>
+ActiveList::interval_list(int total_size) const {
+    std::vector<std::pair<int, int>> intervals;
+    if (this->m_mode == ALL_ACTIVE) {
+        if (total_size > 0)
+            intervals.emplace_back(0, total_size);
+        return intervals;
+    }
+
+    size_t i = 0;
+    while (i < this->m_index_list.size()) {
+        size_t run_start = i;
+        while (i + 1 < this->m_index_list.size() &&
+               this->m_index_list[i + 1] == this->m_index_list[i] + 1)
+            i++;
+        i++;
+        intervals.emplace_back(this->m_index_list[run_start],
+                               static_cast<int>(i - run_start));
+    }
+    return intervals;
+}
+
+/*
+   Set operations for combining region masks into ministep active
+   lists. The index lists are sorted and unique, so every operation is
+   a single linear merge pass - no per-index inserts and no round trip
+   through Python lists. The merged result keeps the sorted/unique
+   invariant, so interval extraction and the bulk-copy serialization
+   paths work on combined masks exactly as on hand-built ones.
+*/
+ActiveList ActiveList::set_union(const ActiveList &other) const {
+    ActiveList result;
+    if (this->m_mode == ALL_ACTIVE || other.m_mode == ALL_ACTIVE)
+        return result; /* Default constructed == ALL_ACTIVE. */
+
+    result.m_mode = PARTLY_ACTIVE;
+    result.m_index_list.reserve(this->m_index_list.size() +
+                                other.m_index_list.size());
+    std::set_union(this->m_index_list.begin(), this->m_index_list.end(),
+                   other.m_index_list.begin(), other.m_index_list.end(),
+                   std::back_inserter(result.m_index_list));
+    return result;
+}
+
+ActiveList ActiveList::set_intersection(const ActiveList &other) const {
+    if (this->m_mode == ALL_ACTIVE)
+        return other;
+    if (other.m_mode == ALL_ACTIVE)
+        return *this;
+
+    ActiveList result;
+    result.m_mode = PARTLY_ACTIVE;
+    result.m_index_list.reserve(
+        std::min(this->m_index_list.size(), other.m_index_list.size()));
+    std::set_intersection(this->m_index_list.begin(), this->m_index_list.end(),
+                          other.m_index_list.begin(), other.m_index_list.end(),
+                          std::back_inserter(result.m_index_list));
+    return result;
+}
+
+/**
+   total_size is only consulted when this list is ALL_ACTIVE and the
+   universe must be materialized to subtract from it.
+*/
+ActiveList ActiveList::set_difference(const ActiveList &other,
+                                      int total_size) const {
+    ActiveList result;
+    result.m_mode = PARTLY_ACTIVE;
+    if (other.m_mode == ALL_ACTIVE)
+        return result; /* Everything subtracted - empty set. */
+
+    if (this->m_mode == ALL_ACTIVE) {
+        result.m_index_list.reserve(total_size - other.m_index_list.size());
+        size_t j = 0;
+        for (int index = 0; index < total_size; index++) {
+            if (j < other.m_index_list.size() &&
+                other.m_index_list[j] == index) {
+                j++;
+                continue;
+            }
+            result.m_index_list.push_back(index);
+        }
+        return result;
+    }
+
+    result.m_index_list.reserve(this->m_index_list.size());
+    std::set_difference(this->m_index_list.begin(), this->m_index_list.end(),
+                        other.m_index_list.begin(), other.m_index_list.end(),
+                        std::back_inserter(result.m_index_list));
+    return result;
+}
+
 bool ActiveList::operator==(const ActiveList &other) const {
     if (this == &other)
         return true;
@@ -118,6 +242,17 @@ ERT_CLIB_SUBMODULE("local.active_list", m) {
         .def("getMode", &ActiveList::getMode)
         .def("get_active_index_list", &ActiveList::index_list)
         .def("addActiveIndex", &ActiveList::add_index)
+        .def("union_with", &ActiveList::set_union,
+             py::doc{"Return a new ActiveList holding the union of the two "
+                     "active sets."})
+        .def("intersect_with", &ActiveList::set_intersection,
+             py::doc{"Return a new ActiveList holding the intersection of "
+                     "the two active sets."})
+        .def("difference_with", &ActiveList::set_difference,
+             py::doc{"Return a new ActiveList holding this set minus the "
+                     "other; total_size is only used when this list is "
+                     "ALL_ACTIVE."},
+             py::arg("other"), py::arg("total_size"))
         .def("__repr__", &repr)
         .def("getActiveSize", &ActiveList::active_size);
 
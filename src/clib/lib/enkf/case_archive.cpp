@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ert/util/buffer.h>
+#include <ert/util/util.h>
+
+#include <ert/enkf/case_archive.hpp>
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/logging.hpp>
+#include <ert/python.hpp>
+
+namespace fs = std::filesystem;
+
+static auto logger = ert::get_logger("enkf_fs.archive");
+
+/*
+   Archive layout (native byte order, written and read on the same
+   architecture family):
+
+   | magic: int32 | version: int32 | index_offset: int64 |
+
+   followed by the file entries back to back. Each entry is a sequence
+   of chunks:
+
+   | raw_size: int32 | stored_size: int32 | compressed: int32 | bytes |
+
+   so neither side ever holds more than one chunk in memory, and a file
+   of any size streams through a fixed budget. The index sits at
+   index_offset - the header field is patched once the entries are
+   written:
+
+   | entry_count: int32 |
+   | path_len: int32 | path bytes | offset: int64 | raw_size: int64 | ...
+
+   with paths relative to the case directory using '/' separators. The
+   index makes the container seekable: single files can be extracted
+   without touching the preceding entries.
+
+   The chunk payloads reuse the zlib helpers behind the buffer API -
+   the same compression the block_fs nodes use - so no new dependency
+   is introduced. Chunks which do not shrink are stored raw.
+*/
+
+#define CASE_ARCHIVE_MAGIC 0x45434131 /* "ECA1" */
+#define CASE_ARCHIVE_VERSION 1
+#define CASE_ARCHIVE_CHUNK_SIZE (16 * 1024 * 1024)
+
+namespace {
+
+void archive_fwrite(const void *ptr, size_t size, FILE *stream) {
+    if (fwrite(ptr, 1, size, stream) != size)
+        throw std::runtime_error("writing case archive failed");
+}
+
+void archive_fread(void *ptr, size_t size, FILE *stream) {
+    if (fread(ptr, 1, size, stream) != size)
+        throw std::runtime_error("truncated case archive");
+}
+
+void archive_fwrite_int32(std::int32_t value, FILE *stream) {
+    archive_fwrite(&value, sizeof value, stream);
+}
+
+void archive_fwrite_int64(std::int64_t value, FILE *stream) {
+    archive_fwrite(&value, sizeof value, stream);
+}
+
+std::int32_t archive_fread_int32(FILE *stream) {
+    std::int32_t value;
+    archive_fread(&value, sizeof value, stream);
+    return value;
+}
+
+std::int64_t archive_fread_int64(FILE *stream) {
+    std::int64_t value;
+    archive_fread(&value, sizeof value, stream);
+    return value;
+}
+
+struct archive_entry {
+    std::string path;
+    std::int64_t offset;
+    std::int64_t raw_size;
+};
+
+/**
+   Entry paths come straight from the archive, and archives are meant
+   to be transferred between machines - a corrupt or hostile file must
+   not be able to place anything outside the target case directory. An
+   absolute path would replace the case path entirely in the join, and
+   a ".." component would escape it, so both are rejected.
+*/
+bool archive_entry_path_safe(const fs::path &path) {
+    if (path.empty() || path.is_absolute())
+        return false;
+    for (const auto &component : path)
+        if (component == "..")
+            return false;
+    return true;
+}
+
+/**
+   Stream one file into the archive as a sequence of chunks; returns
+   the number of raw bytes consumed.
+*/
+std::int64_t archive_write_file(const fs::path &filename, FILE *archive) {
+    FILE *input = util_fopen(filename.c_str(), "r");
+    std::vector<char> chunk(CASE_ARCHIVE_CHUNK_SIZE);
+    std::int64_t raw_size = 0;
+
+    while (true) {
+        size_t count = fread(chunk.data(), 1, chunk.size(), input);
+        if (count == 0)
+            break;
+        raw_size += count;
+
+        buffer_type *compressed = buffer_alloc(count);
+        buffer_fwrite_compressed(compressed, chunk.data(), count);
+        if (buffer_get_size(compressed) < count) {
+            archive_fwrite_int32(count, archive);
+            archive_fwrite_int32(buffer_get_size(compressed), archive);
+            archive_fwrite_int32(1, archive);
+            archive_fwrite(buffer_get_data(compressed),
+                           buffer_get_size(compressed), archive);
+        } else {
+            archive_fwrite_int32(count, archive);
+            archive_fwrite_int32(count, archive);
+            archive_fwrite_int32(0, archive);
+            archive_fwrite(chunk.data(), count, archive);
+        }
+        buffer_free(compressed);
+
+        if (count < chunk.size())
+            break;
+    }
+    fclose(input);
+    return raw_size;
+}
+
+/**
+   Unpack one entry - the archive stream must be positioned at its
+   first chunk.
+*/
+void archive_read_file(FILE *archive, const fs::path &filename,
+                       std::int64_t raw_size) {
+    fs::create_directories(filename.parent_path());
+    FILE *output = util_fopen(filename.c_str(), "w");
+    std::vector<char> chunk;
+    std::int64_t remaining = raw_size;
+
+    while (remaining > 0) {
+        std::int32_t chunk_raw = archive_fread_int32(archive);
+        std::int32_t chunk_stored = archive_fread_int32(archive);
+        std::int32_t compressed = archive_fread_int32(archive);
+        if (chunk_raw <= 0 || chunk_stored <= 0 || chunk_raw > remaining) {
+            fclose(output);
+            throw std::runtime_error("corrupt chunk in case archive");
+        }
+
+        chunk.resize(chunk_raw);
+        if (compressed) {
+            std::vector<char> stored_bytes(chunk_stored);
+            archive_fread(stored_bytes.data(), chunk_stored, archive);
+            buffer_type *stored = buffer_alloc(chunk_stored);
+            buffer_fwrite(stored, stored_bytes.data(), 1, chunk_stored);
+            buffer_rewind(stored);
+            buffer_fread_compressed(stored, chunk_stored, chunk.data(),
+                                    chunk.size());
+            buffer_free(stored);
+        } else
+            archive_fread(chunk.data(), chunk_raw, archive);
+
+        archive_fwrite(chunk.data(), chunk_raw, output);
+        remaining -= chunk_raw;
+    }
+    fclose(output);
+}
+
+} // namespace
+
+void enkf_fs_export_archive(const fs::path &case_path,
+                            const fs::path &archive_file) {
+    if (!fs::is_directory(case_path))
+        throw std::runtime_error("no such case directory: " +
+                                 case_path.string());
+    /* Make sure a background umount of this case has flushed before
+       the files are read. */
+    enkf_fs_umount_barrier(case_path.c_str());
+
+    /* Sorted for a deterministic archive - the same case always
+       produces the same container. */
+    std::vector<fs::path> files;
+    for (const auto &dir_entry : fs::recursive_directory_iterator(case_path))
+        if (dir_entry.is_regular_file())
+            files.push_back(dir_entry.path());
+    std::sort(files.begin(), files.end());
+
+    FILE *archive = util_fopen(archive_file.c_str(), "w");
+    try {
+        archive_fwrite_int32(CASE_ARCHIVE_MAGIC, archive);
+        archive_fwrite_int32(CASE_ARCHIVE_VERSION, archive);
+        archive_fwrite_int64(0, archive); /* index offset, patched below. */
+
+        std::vector<archive_entry> index;
+        index.reserve(files.size());
+        for (const auto &filename : files) {
+            archive_entry entry;
+            entry.path = fs::relative(filename, case_path).generic_string();
+            entry.offset = util_ftell(archive);
+            entry.raw_size = archive_write_file(filename, archive);
+            index.push_back(std::move(entry));
+        }
+
+        std::int64_t index_offset = util_ftell(archive);
+        archive_fwrite_int32(index.size(), archive);
+        for (const auto &entry : index) {
+            archive_fwrite_int32(entry.path.size(), archive);
+            archive_fwrite(entry.path.data(), entry.path.size(), archive);
+            archive_fwrite_int64(entry.offset, archive);
+            archive_fwrite_int64(entry.raw_size, archive);
+        }
+
+        util_fseek(archive, 2 * sizeof(std::int32_t), SEEK_SET);
+        archive_fwrite_int64(index_offset, archive);
+        logger->info("Exported case {} to {} ({} files)", case_path.string(),
+                     archive_file.string(), index.size());
+    } catch (...) {
+        fclose(archive);
+        throw;
+    }
+    fclose(archive);
+}
+
+void enkf_fs_import_archive(const fs::path &archive_file,
+                            const fs::path &case_path) {
+    FILE *archive = util_fopen(archive_file.c_str(), "r");
+    try {
+        if (archive_fread_int32(archive) != CASE_ARCHIVE_MAGIC)
+            throw std::runtime_error("not a case archive: " +
+                                     archive_file.string());
+        if (archive_fread_int32(archive) != CASE_ARCHIVE_VERSION)
+            throw std::runtime_error("unsupported case archive version in " +
+                                     archive_file.string());
+
+        std::int64_t index_offset = archive_fread_int64(archive);
+        util_fseek(archive, index_offset, SEEK_SET);
+        std::int32_t entry_count = archive_fread_int32(archive);
+        if (entry_count < 0)
+            throw std::runtime_error("corrupt index in case archive: " +
+                                     archive_file.string());
+        std::vector<archive_entry> index;
+        index.reserve(entry_count);
+        for (std::int32_t i = 0; i < entry_count; i++) {
+            archive_entry entry;
+            std::int32_t path_len = archive_fread_int32(archive);
+            if (path_len <= 0 || path_len > PATH_MAX)
+                throw std::runtime_error("corrupt entry path in case "
+                                         "archive: " +
+                                         archive_file.string());
+            entry.path.resize(path_len);
+            archive_fread(entry.path.data(), path_len, archive);
+            if (!archive_entry_path_safe(entry.path))
+                throw std::runtime_error("unsafe entry path '" + entry.path +
+                                         "' in case archive: " +
+                                         archive_file.string());
+            entry.offset = archive_fread_int64(archive);
+            entry.raw_size = archive_fread_int64(archive);
+            index.push_back(std::move(entry));
+        }
+
+        fs::create_directories(case_path);
+        for (const auto &entry : index) {
+            util_fseek(archive, entry.offset, SEEK_SET);
+            archive_read_file(archive, case_path / entry.path, entry.raw_size);
+        }
+        logger->info("Imported case archive {} into {} ({} files)",
+                     archive_file.string(), case_path.string(), entry_count);
+    } catch (...) {
+        fclose(archive);
+        throw;
+    }
+    fclose(archive);
+
+    /* A stale cached mount of the target path must not shadow the
+       freshly unpacked state. */
+    enkf_fs_invalidate_cache(case_path.c_str());
+}
+
+ERT_CLIB_SUBMODULE("case_archive", m) {
+    using namespace py::literals;
+
+    m.def(
+        "export_case",
+        [](const std::string &mount_point, const std::string &archive_file) {
+            py::gil_scoped_release release;
+            enkf_fs_export_archive(mount_point, archive_file);
+        },
+        py::doc{"Stream the whole case directory into one seekable "
+                "compressed archive file."},
+        "mount_point"_a, "archive_file"_a);
+    m.def(
+        "import_case",
+        [](const std::string &archive_file, const std::string &mount_point) {
+            py::gil_scoped_release release;
+            enkf_fs_import_archive(archive_file, mount_point);
+        },
+        py::doc{"Unpack a case archive into the given mount point; the case "
+                "is mounted through the normal path afterwards."},
+        "archive_file"_a, "mount_point"_a);
+}
@@ -1,10 +1,15 @@
 #include <cmath>
+#include <random>
+#include <tuple>
 #include <vector>
 
+#include <Eigen/Dense>
+
 #include <ert/util/util.h>
 
 #include <ert/enkf/enkf_analysis.hpp>
 #include <ert/enkf/meas_data.hpp>
+#include <ert/gemm_backend.hpp>
 #include <ert/enkf/obs_data.hpp>
 #include <ert/except.hpp>
 #include <ert/python.hpp>
@@ -22,6 +27,11 @@ void UpdateSnapshot::add_member(std::string observation_name,
     response_std_.push_back(ensemble_std);
 }
 
+void UpdateSnapshot::add_timing(std::string stage, double wall_seconds,
+                                double cpu_seconds) {
+    timings_.push_back({std::move(stage), wall_seconds, cpu_seconds});
+}
+
 UpdateSnapshot make_update_snapshot(const obs_data_type *obs_data,
                                     const meas_data_type *meas_data) {
     UpdateSnapshot update_snapshot;
@@ -127,8 +137,67 @@ void enkf_analysis_deactivate_outliers(
     }
 }
 
+/**
+   Randomized truncated SVD following Halko, Martinsson & Tropp (2011).
+   A gaussian test matrix is used to find an approximate basis Q for
+   the range of S, after which the SVD is computed on the small
+   projected matrix Q^T S. For an (m x n) matrix and rank k the cost is
+   O(m n k) instead of the full O(m n min(m, n)) decomposition, which
+   matters once the number of observations grows past ~10^5. A couple
+   of power iterations sharpen the basis when the singular spectrum
+   decays slowly.
+*/
+std::tuple<Eigen::MatrixXd, Eigen::VectorXd, Eigen::MatrixXd>
+enkf_analysis_randomized_svd(const Eigen::MatrixXd &S, int rank,
+                             int oversampling, int power_iterations,
+                             unsigned int seed) {
+    const Eigen::Index m = S.rows();
+    const Eigen::Index n = S.cols();
+    if (rank <= 0)
+        throw exc::invalid_argument("rank must be positive, got {}", rank);
+    const Eigen::Index sample_size =
+        std::min<Eigen::Index>(rank + std::max(oversampling, 0),
+                               std::min(m, n));
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    Eigen::MatrixXd Omega(n, sample_size);
+    for (Eigen::Index j = 0; j < sample_size; j++)
+        for (Eigen::Index i = 0; i < n; i++)
+            Omega(i, j) = gauss(rng);
+
+    // The sketch S * Omega is the dominant product of the
+    // decomposition; it offloads to the GPU in cuBLAS builds.
+    Eigen::MatrixXd Y = ert::gemm(S, Omega);
+    for (int it = 0; it < power_iterations; it++) {
+        // Re-orthogonalize between multiplications to avoid the basis
+        // collapsing onto the dominant singular vector.
+        Y = Eigen::HouseholderQR<Eigen::MatrixXd>(Y).householderQ() *
+            Eigen::MatrixXd::Identity(m, sample_size);
+        Y = S * (S.transpose() * Y);
+    }
+    Eigen::MatrixXd Q =
+        Eigen::HouseholderQR<Eigen::MatrixXd>(Y).householderQ() *
+        Eigen::MatrixXd::Identity(m, sample_size);
+
+    Eigen::MatrixXd B = Q.transpose() * S;
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(B, Eigen::ComputeThinU |
+                                              Eigen::ComputeThinV);
+
+    const Eigen::Index k = std::min<Eigen::Index>(rank, sample_size);
+    Eigen::MatrixXd U = (Q * svd.matrixU()).leftCols(k);
+    Eigen::VectorXd sigma = svd.singularValues().head(k);
+    Eigen::MatrixXd V = svd.matrixV().leftCols(k);
+    return {U, sigma, V};
+}
+
 ERT_CLIB_SUBMODULE("enkf_analysis", m) {
     using namespace py::literals;
+    py::class_<UpdateTiming>(m, "UpdateTiming")
+        .def_readonly("stage", &UpdateTiming::stage)
+        .def_readonly("wall_seconds", &UpdateTiming::wall_seconds)
+        .def_readonly("cpu_seconds", &UpdateTiming::cpu_seconds);
+
     py::class_<UpdateSnapshot>(m, "UpdateSnapshot")
         .def(py::init<>())
         .def_property_readonly("obs_name", &UpdateSnapshot::obs_name)
@@ -136,5 +205,12 @@ ERT_CLIB_SUBMODULE("enkf_analysis", m) {
         .def_property_readonly("obs_std", &UpdateSnapshot::obs_error)
         .def_property_readonly("obs_status", &UpdateSnapshot::obs_status)
         .def_property_readonly("response_mean", &UpdateSnapshot::response_mean)
-        .def_property_readonly("response_std", &UpdateSnapshot::response_std);
+        .def_property_readonly("response_std", &UpdateSnapshot::response_std)
+        .def_property_readonly("timings", &UpdateSnapshot::timings)
+        .def("add_timing", &UpdateSnapshot::add_timing, py::arg("stage"),
+             py::arg("wall_seconds"), py::arg("cpu_seconds"));
+
+    m.def("randomized_svd", enkf_analysis_randomized_svd, py::arg("S"),
+          py::arg("rank"), py::arg("oversampling") = 10,
+          py::arg("power_iterations") = 2, py::arg("seed") = 0);
 }
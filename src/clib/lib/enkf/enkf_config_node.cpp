@@ -13,9 +13,11 @@
 #include <ert/enkf/field_config.hpp>
 #include <ert/enkf/gen_kw_config.hpp>
 #include <ert/enkf/gen_obs.hpp>
+#include <ert/enkf/summary_block.hpp>
 #include <ert/enkf/surface_config.hpp>
 #include <ert/python.hpp>
 #include <ert/res_util/path_fmt.hpp>
+#include <ert/res_util/string.hpp>
 #include <ert/util/string_util.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/vector.h>
@@ -36,7 +38,8 @@ struct enkf_config_node_struct {
     bool_vector_type *internalize;
     /** Keys of observations which observe this node. */
     stringlist_type *obs_keys;
-    char *key;
+    /** Interned - owned by the ert::intern() pool, never freed here. */
+    const char *key;
     char *init_file_abs_path;
     /** Format used to create files for initialization. */
     path_fmt_type *init_file_fmt;
@@ -63,8 +66,15 @@ bool enkf_config_node_has_node(const enkf_config_node_type *node,
 
 bool enkf_config_node_has_vector(const enkf_config_node_type *node,
                                  enkf_fs_type *fs, int iens) {
-    bool has_vector = enkf_fs_has_vector(fs, node->key, node->var_type, iens);
-    return has_vector;
+    if (enkf_fs_has_vector(fs, node->key, node->var_type, iens))
+        return true;
+    // Summary vectors stored by current code live in the columnar
+    // block of the realization instead of per-key records.
+    if (node->impl_type == SUMMARY) {
+        auto block = enkf_fs_get_summary_block(fs, iens);
+        return block && block->has_key(node->key);
+    }
+    return false;
 }
 
 static enkf_config_node_type *enkf_config_node_alloc__(enkf_var_type var_type,
@@ -76,7 +86,7 @@ static enkf_config_node_type *enkf_config_node_alloc__(enkf_var_type var_type,
     node->forward_init = forward_init;
     node->var_type = var_type;
     node->impl_type = impl_type;
-    node->key = util_alloc_string_copy(key);
+    node->key = ert::intern(key);
     node->vector_storage = false;
 
     node->init_file_abs_path = NULL, node->init_file_fmt = NULL;
@@ -326,7 +336,6 @@ void enkf_config_node_free(enkf_config_node_type *node) {
     /* Freeing the underlying node object. */
     if (node->freef != NULL)
         node->freef(node->data);
-    free(node->key);
     stringlist_free(node->obs_keys);
 
     free(node->init_file_abs_path);
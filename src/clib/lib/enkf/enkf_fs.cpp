@@ -1,10 +1,18 @@
 #include "ert/python.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <ert/concurrency.hpp>
 #include <filesystem>
 #include <future>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <fcntl.h>
@@ -18,6 +26,8 @@
 
 #include <ert/logging.hpp>
 #include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/memory.hpp>
+#include <ert/res_util/metric.hpp>
 #include <ert/res_util/path_fmt.hpp>
 #include <ert/res_util/string.hpp>
 
@@ -26,6 +36,7 @@
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_state.hpp>
 #include <ert/enkf/misfit_ensemble.hpp>
+#include <ert/enkf/summary_block.hpp>
 
 namespace fs = std::filesystem;
 static auto logger = ert::get_logger("enkf");
@@ -119,11 +130,17 @@ static auto logger = ert::get_logger("enkf");
 #define TIME_MAP_FILE "time-map"
 #define STATE_MAP_FILE "state-map"
 #define MISFIT_ENSEMBLE_FILE "misfit-ensemble"
+#define CASE_CATALOG_FILE "case-catalog"
 #define CASE_CONFIG_FILE "case_config"
+#define COW_PARENT_FILE "cow-parent"
 
 struct enkf_fs_struct {
     std::string case_name;
     char *mount_point;
+    /** The ensemble size the filesystem was mounted with; the
+     * state_map is sized from it, so a cached instance is only reused
+     * for a matching mount. */
+    unsigned ensemble_size;
 
     std::unique_ptr<ert::block_fs_driver> dynamic_forecast;
     std::unique_ptr<ert::block_fs_driver> parameter;
@@ -134,6 +151,15 @@ struct enkf_fs_struct {
     time_map_type *time_map;
     std::shared_ptr<StateMap> state_map;
     summary_key_set_type *summary_key_set;
+    /** Small LRU cache of per-realization summary blocks (nullptr
+     * entries cache the absence of a block), so the batched readers
+     * and the per-key fallback reads load each block once. */
+    std::mutex summary_block_mutex;
+    std::unordered_map<int,
+                       std::pair<std::shared_ptr<const SummaryBlock>,
+                                 std::uint64_t>>
+        summary_block_cache;
+    std::uint64_t summary_block_tick = 0;
     /* The variables below here are for storing arbitrary files within the
      * enkf_fs storage directory, but not as serialized enkf_nodes. */
     misfit_ensemble_type *misfit_ensemble;
@@ -148,6 +174,7 @@ enkf_fs_type *enkf_fs_get_ref(enkf_fs_type *fs) { return fs; }
 enkf_fs_type *enkf_fs_alloc_empty(const char *mount_point,
                                   unsigned ensemble_size, bool read_only) {
     enkf_fs_type *fs = new enkf_fs_type;
+    fs->ensemble_size = ensemble_size;
     fs->time_map = time_map_alloc();
     fs->state_map = std::make_shared<StateMap>(ensemble_size);
     fs->summary_key_set = summary_key_set_alloc();
@@ -233,8 +260,24 @@ enkf_fs_type *enkf_fs_create_fs(const char *mount_point,
 	 * occasionally schedule one std::future for each file, hence
 	 * this is sometimes the number of concurrently executing futures.
 	 * (In other words - don't set it to 100000...)
+	 *
+	 * Nodes are sharded over the files with iens % num_drivers, so
+	 * setting the shard count to at least the ensemble size gives
+	 * every realization a private file and concurrent result loading
+	 * becomes contention free at the file level. The count is only
+	 * used when creating a case - it is recorded in the fstab and
+	 * existing cases keep the layout they were created with.
 	 */
-    const int num_drivers = 32;
+    int num_drivers = 32;
+    const char *num_drivers_env = getenv("ERT_FS_NUM_DRIVERS");
+    if (num_drivers_env != nullptr) {
+        int num_drivers_value = atoi(num_drivers_env);
+        if (num_drivers_value > 0)
+            num_drivers = std::min(num_drivers_value, 1024);
+        else if (ensemble_size > 0)
+            /* ERT_FS_NUM_DRIVERS=0 means one file per realization. */
+            num_drivers = std::min<int>(ensemble_size, 1024);
+    }
 
     FILE *stream = fs_driver_open_fstab(mount_point, true);
     if (stream != NULL) {
@@ -258,6 +301,113 @@ enkf_fs_type *enkf_fs_create_fs(const char *mount_point,
         return NULL;
 }
 
+/**
+  Copy-on-write case branching: a child case records its parent's mount
+  point in the COW_PARENT_FILE and starts out with empty block_fs
+  files. Nodes not written in the child are resolved from the parent's
+  (read-only) drivers, so branching a case for the next iteration costs
+  O(changed data) instead of a physical copy of all node data.
+*/
+static char *enkf_fs_read_cow_parent(const char *mount_point) {
+    fs::path parent_file = fs::path(mount_point) / COW_PARENT_FILE;
+    if (!fs::exists(parent_file))
+        return NULL;
+
+    FILE *stream = util_fopen(parent_file.c_str(), "r");
+    char *parent_point = util_fread_alloc_string(stream);
+    fclose(stream);
+    return parent_point;
+}
+
+/** True when 'ancestor' appears in the copy-on-write parent chain
+    recorded for the case mounted at 'mount_point'. */
+static bool enkf_fs_cow_chain_contains(const char *mount_point,
+                                       const char *ancestor) {
+    char *parent = enkf_fs_read_cow_parent(mount_point);
+    while (parent != NULL) {
+        if (util_string_equal(parent, ancestor)) {
+            free(parent);
+            return true;
+        }
+        char *next = enkf_fs_read_cow_parent(parent);
+        free(parent);
+        parent = next;
+    }
+    return false;
+}
+
+static void enkf_fs_attach_cow_parent(ert::block_fs_driver *parameter,
+                                      ert::block_fs_driver *dynamic_forecast,
+                                      ert::block_fs_driver *index,
+                                      const char *mount_point) {
+    char *parent_point = enkf_fs_read_cow_parent(mount_point);
+    if (parent_point == NULL)
+        return;
+
+    FILE *stream = fs_driver_open_fstab(parent_point, false);
+    if (stream == NULL)
+        util_abort("%s: could not open the parent case:%s of the "
+                   "copy-on-write case:%s \n",
+                   __func__, parent_point, mount_point);
+    fs_driver_assert_magic(stream);
+    fs_driver_assert_version(stream, parent_point);
+    util_fread_int(stream); /* driver_id - only BLOCK_FS cases branch. */
+
+    std::unique_ptr<ert::block_fs_driver> parent_parameter;
+    std::unique_ptr<ert::block_fs_driver> parent_dynamic_forecast;
+    std::unique_ptr<ert::block_fs_driver> parent_index;
+    while (true) {
+        fs_driver_enum driver_type;
+        if (fread(&driver_type, sizeof driver_type, 1, stream) != 1)
+            break;
+        if (!fs_types_valid(driver_type)) {
+            block_fs_driver_fskip(stream);
+            continue;
+        }
+        ert::block_fs_driver *driver =
+            ert::block_fs_driver::open(stream, parent_point, true);
+        switch (driver_type) {
+        case (DRIVER_PARAMETER):
+            parent_parameter.reset(driver);
+            break;
+        case (DRIVER_DYNAMIC_FORECAST):
+            parent_dynamic_forecast.reset(driver);
+            break;
+        case (DRIVER_INDEX):
+            parent_index.reset(driver);
+            break;
+        }
+    }
+    fclose(stream);
+
+    /* The parent may itself be a copy-on-write branch. */
+    enkf_fs_attach_cow_parent(parent_parameter.get(),
+                              parent_dynamic_forecast.get(),
+                              parent_index.get(), parent_point);
+
+    parameter->set_parent(std::move(parent_parameter));
+    dynamic_forecast->set_parent(std::move(parent_dynamic_forecast));
+    index->set_parent(std::move(parent_index));
+    free(parent_point);
+}
+
+enkf_fs_type *enkf_fs_create_cow_fs(const char *mount_point,
+                                    const char *parent_mount_point,
+                                    fs_driver_impl driver_id,
+                                    unsigned ensemble_size, bool mount) {
+    enkf_fs_create_fs(mount_point, driver_id, ensemble_size, false);
+
+    fs::path parent_file = fs::path(mount_point) / COW_PARENT_FILE;
+    FILE *stream = util_fopen(parent_file.c_str(), "w");
+    util_fwrite_string(parent_mount_point, stream);
+    fclose(stream);
+
+    if (mount)
+        return enkf_fs_mount(mount_point, ensemble_size);
+    else
+        return NULL;
+}
+
 static void enkf_fs_fsync_time_map(enkf_fs_type *fs) {
     char *filename = enkf_fs_alloc_case_filename(fs, TIME_MAP_FILE);
     time_map_fwrite(fs->time_map, filename);
@@ -271,6 +421,10 @@ static void enkf_fs_fread_time_map(enkf_fs_type *fs) {
 }
 
 static void enkf_fs_fsync_state_map(enkf_fs_type *fs) {
+    // The changes accumulate in memory and are flushed at the sync
+    // points only when something actually changed.
+    if (!fs->state_map->dirty())
+        return;
     char *filename = enkf_fs_alloc_case_filename(fs, STATE_MAP_FILE);
     try {
         fs->state_map->write(filename);
@@ -281,11 +435,111 @@ static void enkf_fs_fsync_state_map(enkf_fs_type *fs) {
 }
 
 static void enkf_fs_fsync_summary_key_set(enkf_fs_type *fs) {
+    // The full key set is rewritten only when keys were actually
+    // added since the last sync - which for all but the first few
+    // realization loads of a case they were not.
+    if (!summary_key_set_dirty(fs->summary_key_set))
+        return;
     char *filename = enkf_fs_alloc_case_filename(fs, SUMMARY_KEY_SET_FILE);
     summary_key_set_fwrite(fs->summary_key_set, filename);
     free(filename);
 }
 
+/*
+  Case catalog
+  ------------
+
+  Browsing tools (the case picker in particular) want the size, extent
+  and update state of every case in the storage directory, and paying a
+  full enkf_fs_mount() - block_fs index construction included - per
+  case just to render a list is far too expensive. Instead every sync
+  point rewrites a small text catalog next to the other case metadata
+  files, and enkf_fs_read_catalog() answers the picker queries from
+  that file alone, without mounting.
+
+  The format is versioned "key value" lines; unknown keys are ignored
+  on read so the format can grow. The file is advisory: it reflects the
+  case as of the last sync, and a case written by a crashed process may
+  lack it entirely - readers must treat a missing catalog as "mount to
+  find out".
+*/
+static void enkf_fs_fwrite_catalog(enkf_fs_type *fs) {
+    char *filename = enkf_fs_alloc_case_filename(fs, CASE_CATALOG_FILE);
+    std::string tmp_file = std::string(filename) + ".tmp";
+    FILE *stream = mkdir_fopen(fs::path(tmp_file), "w");
+
+    size_t parameter_nodes, parameter_bytes;
+    size_t forecast_nodes, forecast_bytes;
+    size_t index_nodes, index_bytes;
+    fs->parameter->stats(parameter_nodes, parameter_bytes);
+    fs->dynamic_forecast->stats(forecast_nodes, forecast_bytes);
+    fs->index->stats(index_nodes, index_bytes);
+
+    fprintf(stream, "version 1\n");
+    fprintf(stream, "ensemble_size %u\n", fs->ensemble_size);
+    fprintf(stream, "node_count %zu\n",
+            parameter_nodes + forecast_nodes + index_nodes);
+    fprintf(stream, "data_bytes %zu\n",
+            parameter_bytes + forecast_bytes + index_bytes);
+    fprintf(stream, "parameter_nodes %zu\n", parameter_nodes);
+    fprintf(stream, "parameter_bytes %zu\n", parameter_bytes);
+    fprintf(stream, "forecast_nodes %zu\n", forecast_nodes);
+    fprintf(stream, "forecast_bytes %zu\n", forecast_bytes);
+
+    int time_map_size = time_map_get_size(fs->time_map);
+    fprintf(stream, "time_map_size %d\n", time_map_size);
+    fprintf(stream, "time_map_end_time %ld\n",
+            time_map_size > 0 ? (long)time_map_get_end_time(fs->time_map) : 0L);
+
+    int state_initialized = 0;
+    int state_has_data = 0;
+    int state_failure = 0;
+    for (int iens = 0; iens < fs->state_map->size(); iens++) {
+        switch (fs->state_map->get(iens)) {
+        case STATE_INITIALIZED:
+            state_initialized++;
+            break;
+        case STATE_HAS_DATA:
+            state_has_data++;
+            break;
+        case STATE_LOAD_FAILURE:
+        case STATE_PARENT_FAILURE:
+            state_failure++;
+            break;
+        default:
+            break;
+        }
+    }
+    fprintf(stream, "state_initialized %d\n", state_initialized);
+    fprintf(stream, "state_has_data %d\n", state_has_data);
+    fprintf(stream, "state_failure %d\n", state_failure);
+    fclose(stream);
+
+    /* Atomic replace so readers never see a half-written catalog; like
+       the state map, write errors are not fatal - the catalog is
+       advisory. */
+    if (rename(tmp_file.c_str(), filename) != 0)
+        unlink(tmp_file.c_str());
+    free(filename);
+}
+
+std::map<std::string, long long> enkf_fs_read_catalog(const char *mount_point) {
+    std::map<std::string, long long> catalog;
+    char *case_path = util_alloc_sprintf(DEFAULT_CASE_PATH, mount_point);
+    fs::path catalog_file = fs::path(case_path) / CASE_CATALOG_FILE;
+    free(case_path);
+    FILE *stream = fopen(catalog_file.c_str(), "r");
+    if (stream == NULL)
+        return catalog;
+
+    char key[64];
+    long long value;
+    while (fscanf(stream, "%63s %lld", key, &value) == 2)
+        catalog[key] = value;
+    fclose(stream);
+    return catalog;
+}
+
 static void enkf_fs_fread_state_map(enkf_fs_type *fs) {
     char *filename = enkf_fs_alloc_case_filename(fs, STATE_MAP_FILE);
     try {
@@ -320,8 +574,227 @@ void enkf_fs_fwrite_misfit(enkf_fs_type *fs) {
     }
 }
 
+static void enkf_fs_free__(enkf_fs_type *fs);
+
+/*
+  Process wide LRU cache of mounted filesystems. Mounting a case pays
+  for the full block_fs index construction plus the state_map/time_map/
+  summary_key_set loads, and the GUI and CLI tools switch back and
+  forth between the same handful of cases in a session. Instead of
+  tearing the instance down, enkf_fs_umount() parks it here and a later
+  enkf_fs_mount() of the same mount point picks it up again.
+
+  A cached instance is only reused when the mount parameters match and
+  the case metadata files on disk are unchanged since the instance was
+  parked: any process writing the case rewrites the state map at its
+  sync points, so a changed fingerprint means another process has
+  touched the case and the stale instance is dropped. The Python layer
+  can also invalidate explicitly through enkf_fs.invalidate_cache().
+*/
+namespace {
+
+using case_fingerprint =
+    std::vector<std::pair<std::string, std::pair<time_t, off_t>>>;
+
+case_fingerprint enkf_fs_case_fingerprint(const enkf_fs_type *fs) {
+    case_fingerprint fingerprint;
+    for (const char *name :
+         {STATE_MAP_FILE, TIME_MAP_FILE, SUMMARY_KEY_SET_FILE}) {
+        char *filename = enkf_fs_alloc_case_filename(fs, name);
+        struct stat st;
+        if (stat(filename, &st) == 0)
+            fingerprint.push_back({filename, {st.st_mtime, st.st_size}});
+        else
+            fingerprint.push_back({filename, {0, 0}});
+        free(filename);
+    }
+    return fingerprint;
+}
+
+struct fs_cache_entry {
+    std::string mount_point;
+    unsigned ensemble_size;
+    bool read_only;
+    enkf_fs_type *fs;
+    case_fingerprint fingerprint;
+};
+
+struct FsCache {
+    FsCache() {
+        /* The cached filesystems are closed from the destructor, and
+           closing them touches the metrics registry and the memory
+           accounts. Touching them here makes sure they are constructed
+           before the cache - and therefore destroyed after it. */
+        ert::metrics::registry();
+        ert::utils::memory_account("block_fs.mmap");
+        ert::utils::memory_account("block_fs.write_behind");
+
+        if (const char *env = getenv("ERT_FS_CACHE_SIZE"))
+            capacity = std::max(0, atoi(env));
+    }
+
+    ~FsCache() {
+        /* Background umounts park their instance here when done - let
+           them land before tearing the cache down. */
+        enkf_fs_umount_barrier(NULL);
+        for (auto &entry : entries)
+            enkf_fs_free__(entry.fs);
+    }
+
+    std::mutex mutex;
+    /** Most recently used first. */
+    std::list<fs_cache_entry> entries;
+    size_t capacity = 4;
+};
+
+FsCache &fs_cache() {
+    static FsCache cache;
+    return cache;
+}
+
+/** Takes ownership of fs and returns true, or leaves it with the
+    caller when caching is disabled. */
+bool enkf_fs_cache_insert(enkf_fs_type *fs) {
+    auto &cache = fs_cache();
+    std::lock_guard lock(cache.mutex);
+    if (cache.capacity == 0)
+        return false;
+
+    fs_cache_entry entry;
+    entry.mount_point = fs->mount_point;
+    entry.ensemble_size = fs->ensemble_size;
+    entry.read_only = fs->read_only;
+    entry.fs = fs;
+    entry.fingerprint = enkf_fs_case_fingerprint(fs);
+    cache.entries.push_front(std::move(entry));
+
+    while (cache.entries.size() > cache.capacity) {
+        enkf_fs_free__(cache.entries.back().fs);
+        cache.entries.pop_back();
+    }
+    return true;
+}
+
+enkf_fs_type *enkf_fs_cache_pop(const char *mount_point,
+                                unsigned ensemble_size, bool read_only) {
+    auto &cache = fs_cache();
+    std::lock_guard lock(cache.mutex);
+    for (auto iter = cache.entries.begin(); iter != cache.entries.end();
+         ++iter) {
+        if (iter->mount_point != mount_point)
+            continue;
+
+        enkf_fs_type *fs = iter->fs;
+        bool valid = iter->ensemble_size == ensemble_size &&
+                     iter->read_only == read_only &&
+                     enkf_fs_case_fingerprint(fs) == iter->fingerprint;
+        cache.entries.erase(iter);
+        if (valid)
+            return fs;
+
+        /* The case has been written by someone else (or the mount
+           parameters differ) - drop the stale instance and mount
+           fresh. */
+        enkf_fs_free__(fs);
+        return NULL;
+    }
+    return NULL;
+}
+
+/*
+  Asynchronous umount. Closing a case means draining the write-behind
+  queues and flushing every dirty mount, which can stall the caller -
+  in practice the GUI switching cases - for seconds. enkf_fs_umount_async()
+  detaches the instance immediately and performs the sync + umount on a
+  pool thread; enkf_fs_umount_barrier() is the durability barrier for
+  code that must see the flush completed. A mount of the same point
+  waits for any in-flight umount of it first, so a quick switch
+  back to a case never races its own background flush.
+*/
+struct pending_umount {
+    std::string mount_point;
+    std::future<void> done;
+};
+
+struct UmountQueue {
+    std::mutex mutex;
+    std::vector<pending_umount> pending;
+};
+
+UmountQueue &umount_queue() {
+    static UmountQueue queue;
+    return queue;
+}
+
+} // namespace
+
+void enkf_fs_umount_barrier(const char *mount_point) {
+    auto &queue = umount_queue();
+    std::vector<std::future<void>> waiting;
+    {
+        std::lock_guard lock(queue.mutex);
+        for (auto iter = queue.pending.begin();
+             iter != queue.pending.end();) {
+            if (mount_point == NULL || iter->mount_point == mount_point) {
+                waiting.push_back(std::move(iter->done));
+                iter = queue.pending.erase(iter);
+            } else
+                ++iter;
+        }
+    }
+    /* Wait outside the lock - the tasks themselves take the cache
+       mutex when they park the flushed instance. */
+    for (auto &done : waiting)
+        done.wait();
+}
+
+void enkf_fs_umount_async(enkf_fs_type *fs) {
+    auto &queue = umount_queue();
+    std::lock_guard lock(queue.mutex);
+    /* Prune entries whose flush has already completed. */
+    for (auto iter = queue.pending.begin(); iter != queue.pending.end();) {
+        if (iter->done.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready)
+            iter = queue.pending.erase(iter);
+        else
+            ++iter;
+    }
+
+    pending_umount entry;
+    entry.mount_point = fs->mount_point;
+    entry.done = ert::global_pool().submit([fs] {
+        enkf_fs_sync(fs);
+        enkf_fs_umount(fs);
+    });
+    queue.pending.push_back(std::move(entry));
+}
+
+void enkf_fs_invalidate_cache(const char *mount_point) {
+    enkf_fs_umount_barrier(mount_point);
+    auto &cache = fs_cache();
+    std::lock_guard lock(cache.mutex);
+    for (auto iter = cache.entries.begin(); iter != cache.entries.end();) {
+        if (mount_point == NULL || iter->mount_point == mount_point) {
+            enkf_fs_free__(iter->fs);
+            iter = cache.entries.erase(iter);
+        } else
+            ++iter;
+    }
+}
+
 enkf_fs_type *enkf_fs_mount(const char *mount_point, unsigned ensemble_size,
                             bool read_only) {
+    /* An in-flight background umount of this case must finish before
+       we look in the cache (or worse, mount fresh under its feet). */
+    enkf_fs_umount_barrier(mount_point);
+
+    enkf_fs_type *cached =
+        enkf_fs_cache_pop(mount_point, ensemble_size, read_only);
+    if (cached != NULL) {
+        logger->debug("Reusing cached mount point {}.", mount_point);
+        return cached;
+    }
+
     FILE *stream = fs_driver_open_fstab(mount_point, false);
 
     if (!stream)
@@ -337,6 +810,9 @@ enkf_fs_type *enkf_fs_mount(const char *mount_point, unsigned ensemble_size,
     case (BLOCK_FS_DRIVER_ID):
         fs = enkf_fs_mount_block_fs(stream, mount_point, ensemble_size,
                                     read_only);
+        enkf_fs_attach_cow_parent(fs->parameter.get(),
+                                  fs->dynamic_forecast.get(), fs->index.get(),
+                                  mount_point);
         logger->debug("Mounting (block_fs) point {}.", mount_point);
         break;
     default:
@@ -374,6 +850,12 @@ void enkf_fs_sync(enkf_fs_type *fs) {
 }
 
 void enkf_fs_umount(enkf_fs_type *fs) {
+    if (enkf_fs_cache_insert(fs))
+        return;
+    enkf_fs_free__(fs);
+}
+
+static void enkf_fs_free__(enkf_fs_type *fs) {
     free(fs->mount_point);
     path_fmt_free(fs->case_fmt);
     path_fmt_free(fs->case_member_fmt);
@@ -412,6 +894,7 @@ void enkf_fs_fsync(enkf_fs_type *fs) {
     enkf_fs_fsync_time_map(fs);
     enkf_fs_fsync_state_map(fs);
     enkf_fs_fsync_summary_key_set(fs);
+    enkf_fs_fwrite_catalog(fs);
 }
 
 void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
@@ -429,6 +912,74 @@ void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_node(node_key, report_step, iens, buffer);
 }
 
+/**
+   Batched variant of enkf_fs_fread_node: all nodes must live in the
+   driver selected by var_type. The driver groups the requests per
+   storage file and reads each file in one offset-sorted pass, which
+   turns ensemble-matrix loading from thousands of random reads into a
+   few sequential sweeps. buffers must be parallel to nodes.
+*/
+void enkf_fs_fread_nodes(
+    enkf_fs_type *enkf_fs, enkf_var_type var_type,
+    const std::vector<std::tuple<std::string, int, int>> &nodes,
+    std::vector<buffer_type *> &buffers) {
+    if (nodes.empty())
+        return;
+
+    ert::block_fs_driver *driver = (ert::block_fs_driver *)enkf_fs_select_driver(
+        enkf_fs, var_type, std::get<0>(nodes.front()).c_str());
+
+    for (auto *buffer : buffers)
+        buffer_rewind(buffer);
+
+    if (var_type == PARAMETER) {
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        std::vector<std::tuple<std::string, int, int>> parameter_nodes(nodes);
+        for (auto &node : parameter_nodes)
+            std::get<1>(node) = 0;
+        driver->load_nodes(parameter_nodes, buffers);
+    } else
+        driver->load_nodes(nodes, buffers);
+}
+
+/**
+   Zero-copy variant of enkf_fs_fread_node: instead of copying the
+   stored bytes into a buffer_type the node is exposed as a read-only
+   view, normally borrowing straight from the storage mapping. Node
+   implementations can then deserialize with a single copy from
+   storage into their own arrays.
+*/
+void enkf_fs_fread_node_view(enkf_fs_type *enkf_fs, block_fs_view &view,
+                             const char *node_key, enkf_var_type var_type,
+                             int report_step, int iens) {
+    ert::block_fs_driver *driver =
+        (ert::block_fs_driver *)enkf_fs_select_driver(enkf_fs, var_type,
+                                                      node_key);
+    if (var_type == PARAMETER)
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        report_step = 0;
+
+    driver->load_node_view(node_key, report_step, iens, view);
+}
+
+/**
+   Advisory readahead of a stored node: the kernel starts paging in the
+   node's extent in the background while the caller keeps working.
+   Ensemble readers use it to prefetch the next member while the
+   current one deserializes.
+*/
+void enkf_fs_prefetch_node(enkf_fs_type *enkf_fs, const char *node_key,
+                           enkf_var_type var_type, int report_step, int iens) {
+    ert::block_fs_driver *driver =
+        (ert::block_fs_driver *)enkf_fs_select_driver(enkf_fs, var_type,
+                                                      node_key);
+    if (var_type == PARAMETER)
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        report_step = 0;
+
+    driver->prefetch_node(node_key, report_step, iens);
+}
+
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens) {
@@ -441,6 +992,22 @@ void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_vector(node_key, iens, buffer);
 }
 
+/**
+   Ranged variant of enkf_fs_fread_vector: only the byte window
+   [offset, offset + count) of the stored record is read into the
+   buffer. Returns the total record size.
+*/
+size_t enkf_fs_fread_vector_range(enkf_fs_type *enkf_fs, buffer_type *buffer,
+                                  const char *node_key, enkf_var_type var_type,
+                                  int iens, size_t offset, size_t count) {
+
+    ert::block_fs_driver *driver =
+        (ert::block_fs_driver *)enkf_fs_select_driver(enkf_fs, var_type,
+                                                      node_key);
+
+    return driver->load_vector_range(node_key, iens, offset, count, buffer);
+}
+
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens) {
     ert::block_fs_driver *driver =
@@ -448,6 +1015,13 @@ bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
     return driver->has_node(node_key, report_step, iens);
 }
 
+bool enkf_fs_has_local_node(enkf_fs_type *enkf_fs, const char *node_key,
+                            enkf_var_type var_type, int report_step, int iens) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    return driver->has_local_node(node_key, report_step, iens);
+}
+
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens) {
     ert::block_fs_driver *driver =
@@ -455,6 +1029,42 @@ bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
     return driver->has_vector(node_key, iens);
 }
 
+/**
+   Batched existence query over a key x realization grid. The returned
+   bitmap is key-major: bit [i * iens_list.size() + j] answers for
+   (keys[i], iens_list[j]). Keys are grouped per driver and each group
+   is resolved in one index pass, instead of a driver lookup and lock
+   round trip per cell.
+*/
+std::vector<bool>
+enkf_fs_has_nodes(enkf_fs_type *enkf_fs,
+                  const std::vector<std::pair<std::string, enkf_var_type>> &keys,
+                  int report_step, const std::vector<int> &iens_list) {
+    std::vector<bool> result(keys.size() * iens_list.size(), false);
+
+    std::map<ert::block_fs_driver *, std::vector<size_t>> groups;
+    for (size_t i = 0; i < keys.size(); i++)
+        groups[enkf_fs_select_driver(enkf_fs, keys[i].second,
+                                     keys[i].first.c_str())]
+            .push_back(i);
+
+    for (auto &[driver, key_indices] : groups) {
+        std::vector<std::string> node_keys;
+        node_keys.reserve(key_indices.size());
+        for (size_t i : key_indices)
+            node_keys.push_back(keys[i].first);
+
+        std::vector<bool> group_result;
+        driver->has_nodes(node_keys, report_step, iens_list, group_result);
+
+        for (size_t gi = 0; gi < key_indices.size(); gi++)
+            for (size_t j = 0; j < iens_list.size(); j++)
+                result[key_indices[gi] * iens_list.size() + j] =
+                    group_result[gi * iens_list.size() + j];
+    }
+    return result;
+}
+
 void enkf_fs_fwrite_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                          const char *node_key, enkf_var_type var_type,
                          int report_step, int iens) {
@@ -484,6 +1094,69 @@ void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->save_vector(node_key, iens, buffer);
 }
 
+/**
+   The reserved node key holding the columnar summary block of one
+   realization. Summary keys all originate from the simulator and
+   never take this form, so the key cannot collide.
+*/
+#define SUMMARY_BLOCK_NODE_KEY "__SUMMARY_BLOCK__"
+
+/** Bounds the block cache; blocks can run to tens of MB per
+    realization, so caching whole ensembles is not an option. The
+    parallel batched readers touch at most a pool worker's worth of
+    realizations at a time. */
+#define SUMMARY_BLOCK_CACHE_SIZE 64
+
+static void enkf_fs_cache_summary_block(
+    enkf_fs_type *fs, int iens, std::shared_ptr<const SummaryBlock> block) {
+    if (fs->summary_block_cache.size() >= SUMMARY_BLOCK_CACHE_SIZE &&
+        fs->summary_block_cache.count(iens) == 0) {
+        auto oldest = fs->summary_block_cache.begin();
+        for (auto it = fs->summary_block_cache.begin();
+             it != fs->summary_block_cache.end(); ++it)
+            if (it->second.second < oldest->second.second)
+                oldest = it;
+        fs->summary_block_cache.erase(oldest);
+    }
+    fs->summary_block_cache[iens] = {std::move(block),
+                                     ++fs->summary_block_tick};
+}
+
+std::shared_ptr<const SummaryBlock> enkf_fs_get_summary_block(enkf_fs_type *fs,
+                                                              int iens) {
+    std::lock_guard guard(fs->summary_block_mutex);
+    auto it = fs->summary_block_cache.find(iens);
+    if (it != fs->summary_block_cache.end()) {
+        it->second.second = ++fs->summary_block_tick;
+        return it->second.first;
+    }
+
+    std::shared_ptr<const SummaryBlock> block;
+    if (enkf_fs_has_vector(fs, SUMMARY_BLOCK_NODE_KEY, DYNAMIC_RESULT, iens)) {
+        buffer_type *buffer = buffer_alloc(1024);
+        enkf_fs_fread_vector(fs, buffer, SUMMARY_BLOCK_NODE_KEY,
+                             DYNAMIC_RESULT, iens);
+        buffer_fskip_time_t(buffer);
+        block = SummaryBlock::read_from_buffer(buffer);
+        buffer_free(buffer);
+    }
+    enkf_fs_cache_summary_block(fs, iens, block);
+    return block;
+}
+
+void enkf_fs_store_summary_block(enkf_fs_type *fs, int iens,
+                                 std::shared_ptr<const SummaryBlock> block) {
+    buffer_type *buffer = buffer_alloc(1024);
+    buffer_fwrite_time_t(buffer, time(NULL));
+    block->write_to_buffer(buffer);
+    enkf_fs_fwrite_vector(fs, buffer, SUMMARY_BLOCK_NODE_KEY, DYNAMIC_RESULT,
+                          iens);
+    buffer_free(buffer);
+
+    std::lock_guard guard(fs->summary_block_mutex);
+    enkf_fs_cache_summary_block(fs, iens, std::move(block));
+}
+
 const char *enkf_fs_get_mount_point(const enkf_fs_type *fs) {
     return fs->mount_point;
 }
@@ -663,20 +1336,22 @@ ERT_CLIB_SUBMODULE("enkf_fs", m) {
         "is_initialized",
         [](Cwrap<enkf_fs_type> fs, Cwrap<ensemble_config_type> ensemble_config,
            std::vector<std::string> parameter_keys, int ens_size) {
-            bool initialized = true;
-            for (int ikey = 0; (ikey < parameter_keys.size()) && initialized;
-                 ikey++) {
+            std::vector<std::pair<std::string, enkf_var_type>> keys;
+            keys.reserve(parameter_keys.size());
+            for (const auto &parameter_key : parameter_keys) {
                 const enkf_config_node_type *config_node =
                     ensemble_config_get_node(ensemble_config,
-                                             parameter_keys[ikey].c_str());
-                initialized = enkf_config_node_has_node(
-                    config_node, fs, {.report_step = 0, .iens = 0});
-                for (int iens = 0; (iens < ens_size) && initialized; iens++) {
-                    initialized = enkf_config_node_has_node(
-                        config_node, fs, {.report_step = 0, .iens = iens});
-                }
+                                             parameter_key.c_str());
+                keys.emplace_back(parameter_key,
+                                  enkf_config_node_get_var_type(config_node));
             }
-            return initialized;
+            std::vector<int> iens_list(ens_size);
+            for (int iens = 0; iens < ens_size; iens++)
+                iens_list[iens] = iens;
+
+            auto bitmap = enkf_fs_has_nodes(fs, keys, 0, iens_list);
+            return std::all_of(bitmap.begin(), bitmap.end(),
+                               [](bool has) { return has; });
         },
         py::arg("self"), py::arg("ensemble_config"), py::arg("parameter_names"),
         py::arg("ensemble_size"));
@@ -694,6 +1369,33 @@ ERT_CLIB_SUBMODULE("enkf_fs", m) {
           });
 
     m.def("write_parameter", bind_write_parameter);
+    m.def(
+        "read_catalog",
+        [](const std::string &mount_point) {
+            return enkf_fs_read_catalog(mount_point.c_str());
+        },
+        py::doc{"Read the case catalog written at the sync points without "
+                "mounting the case; empty when no catalog exists."},
+        "mount_point"_a);
+    m.def(
+        "invalidate_cache",
+        [](const std::optional<std::string> &mount_point) {
+            enkf_fs_invalidate_cache(mount_point ? mount_point->c_str()
+                                                 : nullptr);
+        },
+        py::doc{"Drop cached mounted filesystems - call when another process "
+                "may have written the case."},
+        "mount_point"_a = py::none());
+    m.def(
+        "umount_barrier",
+        [](const std::optional<std::string> &mount_point) {
+            py::gil_scoped_release release;
+            enkf_fs_umount_barrier(mount_point ? mount_point->c_str()
+                                               : nullptr);
+        },
+        py::doc{"Wait until in-flight background umounts have flushed to "
+                "disk; None waits for all of them."},
+        "mount_point"_a = py::none());
     m.def(
         "copy_from_case",
         [](Cwrap<enkf_fs_type> source_case,
@@ -702,29 +1404,64 @@ ERT_CLIB_SUBMODULE("enkf_fs", m) {
            std::vector<std::string> &node_list, std::vector<bool> &iactive) {
             auto &target_state_map = enkf_fs_get_state_map(target_case);
 
-            for (auto &node : node_list) {
-                enkf_config_node_type *config_node =
-                    ensemble_config_get_node(ensemble_config, node.c_str());
-
-                int src_iens = 0;
-                for (auto mask : iactive) {
-                    if (mask) {
+            std::vector<int> active_iens;
+            for (size_t iens = 0; iens < iactive.size(); iens++)
+                if (iactive[iens])
+                    active_iens.push_back(iens);
+
+            std::vector<enkf_config_node_type *> config_nodes;
+            config_nodes.reserve(node_list.size());
+            for (auto &node : node_list)
+                config_nodes.push_back(
+                    ensemble_config_get_node(ensemble_config, node.c_str()));
+
+            /* A target branched from the source already resolves
+               unwritten nodes from the source through the copy-on-write
+               chain; copying those would only duplicate storage. The
+               derivation matches the target key layout at report step 0
+               only. Nodes the target has overwritten locally shadow the
+               chain and must still be copied. */
+            bool cow_derived =
+                report_step == 0 &&
+                enkf_fs_cow_chain_contains(
+                    enkf_fs_get_mount_point(target_case),
+                    enkf_fs_get_mount_point(source_case));
+
+            /* Each (node, iens) copy is independent - the nodes are
+               deserialized into per-task instances and the writes land
+               in the write-behind queue of the block_fs driver, which
+               batches them per shard. Grain 1 spreads the large field
+               nodes over the workers. */
+            size_t job_count = config_nodes.size() * active_iens.size();
+            ert::global_pool().parallel_for(
+                job_count, 1, [&](size_t begin, size_t end) {
+                    for (size_t job = begin; job < end; job++) {
+                        enkf_config_node_type *config_node =
+                            config_nodes[job / active_iens.size()];
+                        int iens = active_iens[job % active_iens.size()];
                         node_id_type src_id = {.report_step = report_step,
-                                               .iens = src_iens};
+                                               .iens = iens};
                         node_id_type target_id = {.report_step = 0,
-                                                  .iens = src_iens};
+                                                  .iens = iens};
+
+                        if (cow_derived &&
+                            !enkf_fs_has_local_node(
+                                target_case,
+                                enkf_config_node_get_key(config_node),
+                                enkf_config_node_get_var_type(config_node), 0,
+                                iens))
+                            continue;
 
                         /* The copy is careful ... */
                         if (enkf_config_node_has_node(config_node, source_case,
                                                       src_id))
                             enkf_node_copy(config_node, source_case,
                                            target_case, src_id, target_id);
-
-                        target_state_map.set(src_iens, STATE_INITIALIZED);
                     }
-                    src_iens++;
-                }
-            }
+                });
+
+            for (int iens : active_iens)
+                target_state_map.set(iens, STATE_INITIALIZED);
             enkf_fs_fsync(target_case);
         },
         py::arg("self"), py::arg("ensemble_config"), py::arg("target_case"),
@@ -1,17 +1,16 @@
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include <ert/util/buffer.h>
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
 
 #include <ert/enkf/enkf_node.hpp>
-#include <ert/enkf/ext_param.hpp>
-#include <ert/enkf/field.hpp>
-#include <ert/enkf/gen_data.hpp>
-#include <ert/enkf/gen_kw.hpp>
-#include <ert/enkf/summary.hpp>
-#include <ert/enkf/surface.hpp>
+#include <ert/enkf/summary_block.hpp>
+#include <ert/enkf/typed_node.hpp>
 #include <ert/python.hpp>
+#include <ert/res_util/arena.hpp>
 
 /**
    A small illustration (says more than thousand words ...) of how the
@@ -114,17 +113,10 @@
 
 */
 struct enkf_node_struct {
-    alloc_ftype *alloc;
-    has_data_ftype *has_data;
-
-    serialize_ftype *serialize;
-    deserialize_ftype *deserialize;
-    read_from_buffer_ftype *read_from_buffer;
-    write_to_buffer_ftype *write_to_buffer;
-    initialize_ftype *initialize;
-    node_free_ftype *freef;
-    node_copy_ftype *copy;
-
+    /** The implementation type is all the dispatching needs; the
+     * per-type operations are resolved at compile time from
+     * node_ops<> (see typed_node.hpp). */
+    ert_impl_type impl_type;
     bool vector_storage;
 
     /** The (hash)key this node is identified with. */
@@ -142,28 +134,17 @@ const enkf_config_node_type *enkf_node_get_config(const enkf_node_type *node) {
     return node->config;
 }
 
-/*
-  All the function pointers REALLY should be in the config object ...
-*/
-
-#define FUNC_ASSERT(func)                                                      \
-    if (func == NULL)                                                          \
-        util_abort("%s: function handler: %s not registered for node:%s - "    \
-                   "aborting\n",                                               \
-                   __func__, #func, enkf_node->node_key);
-
 void enkf_node_alloc_domain_object(enkf_node_type *enkf_node) {
-    FUNC_ASSERT(enkf_node->alloc);
-    {
+    enkf_node_typed_dispatch(enkf_node->impl_type, [enkf_node](auto ops) {
         if (enkf_node->data != NULL)
-            enkf_node->freef(enkf_node->data);
-        enkf_node->data = enkf_node->alloc(
+            ops.freef(enkf_node->data);
+        enkf_node->data = ops.alloc(
             enkf_config_node_get_ref(enkf_node->config)); // CXX_CAST_ERROR
-    }
+    });
 }
 
 ert_impl_type enkf_node_get_impl_type(const enkf_node_type *enkf_node) {
-    return enkf_config_node_get_impl_type(enkf_node->config);
+    return enkf_node->impl_type;
 }
 
 void *enkf_node_value_ptr(const enkf_node_type *enkf_node) {
@@ -179,6 +160,82 @@ std::vector<double> enkf_node_user_get_vector(enkf_node_type *enkf_node,
         return {};
 }
 
+/**
+   Windowed variant of enkf_node_user_get_vector for vector storage
+   (i.e. summary) nodes: only the report steps [step_offset,
+   step_offset + step_count) are fetched from storage. The record
+   header is read first to learn the stored length and element width,
+   then a single ranged read fetches exactly the requested window - a
+   consumer plotting a narrow window of a long history case no longer
+   reads and copies the entire vector.
+*/
+std::vector<double>
+enkf_node_user_get_vector_window(const enkf_config_node_type *config_node,
+                                 enkf_fs_type *fs, int iens, int step_offset,
+                                 int step_count) {
+    const char *node_key = enkf_config_node_get_key(config_node);
+    enkf_var_type var_type = enkf_config_node_get_var_type(config_node);
+
+    // The columnar block - when the realization has one holding this
+    // key - serves the window directly; the block cache makes this one
+    // storage read per realization regardless of the number of keys.
+    if (enkf_config_node_get_impl_type(config_node) == SUMMARY) {
+        auto block = enkf_fs_get_summary_block(fs, iens);
+        if (block && block->has_key(node_key))
+            return block->get_window(node_key, step_offset, step_count);
+    }
+
+    if (!enkf_fs_has_vector(fs, node_key, var_type, iens))
+        return {};
+
+    /* The timestamp written by enkf_node_store_buffer followed by the
+       SUMMARY tag, the element count and the default value. */
+    const size_t header_size =
+        sizeof(time_t) + 2 * sizeof(int) + sizeof(double);
+    buffer_type *buffer = buffer_alloc(header_size);
+    size_t total_size = enkf_fs_fread_vector_range(
+        fs, buffer, node_key, var_type, iens, 0, header_size);
+    if (buffer_get_size(buffer) < header_size) {
+        buffer_free(buffer);
+        return {};
+    }
+    buffer_fskip_time_t(buffer);
+    enkf_util_assert_buffer_type(buffer, SUMMARY);
+    int size = buffer_fread_int(buffer);
+    buffer_free(buffer);
+
+    if (step_offset < 0) {
+        step_count += step_offset;
+        step_offset = 0;
+    }
+    if (size <= step_offset || step_count <= 0)
+        return {};
+    int window = std::min(step_count, size - step_offset);
+
+    /* The payload is float64 for records stored before the summary
+       dtype change and float32 after; told apart by the record size
+       (see summary_read_from_buffer). */
+    size_t element_size =
+        (total_size - header_size == (size_t)size * sizeof(double))
+            ? sizeof(double)
+            : sizeof(float);
+
+    buffer = buffer_alloc(window * element_size);
+    enkf_fs_fread_vector_range(fs, buffer, node_key, var_type, iens,
+                               header_size + step_offset * element_size,
+                               window * element_size);
+    std::vector<double> values(window);
+    if (element_size == sizeof(double))
+        buffer_fread(buffer, values.data(), sizeof(double), window);
+    else {
+        std::vector<float> narrow(window);
+        buffer_fread(buffer, narrow.data(), sizeof(float), window);
+        std::copy(narrow.begin(), narrow.end(), values.begin());
+    }
+    buffer_free(buffer);
+    return values;
+}
+
 /**
    IFF the enkf_node has registered a filename to load from, that is
    passed to the specific load function, otherwise the run_path is sent
@@ -209,32 +266,46 @@ bool enkf_node_forward_init(enkf_node_type *enkf_node,
                             const std::string &run_path, int iens) {
     char *init_file = enkf_config_node_alloc_initfile(enkf_node->config,
                                                       run_path.c_str(), iens);
-    bool init = enkf_node->initialize(enkf_node->data, iens, init_file);
+    bool init = enkf_node_typed_dispatch(
+        enkf_node->impl_type, [&](auto ops) -> bool {
+            if constexpr (decltype(ops)::initialize != nullptr)
+                return ops.initialize(enkf_node->data, iens, init_file);
+            else {
+                util_abort("%s: function handler: initialize not registered "
+                           "for node:%s - aborting\n",
+                           __func__, enkf_node->node_key);
+                return false;
+            }
+        });
     free(init_file);
     return init;
 }
 
 bool enkf_node_forward_load_vector(enkf_node_type *enkf_node,
                                    const ecl_sum_type *ecl_sum,
-                                   const int_vector_type *time_index) {
+                                   const std::vector<int> &time_index,
+                                   const std::vector<int> &params_time_index) {
     bool loadOK;
     loadOK = summary_forward_load_vector(
-        static_cast<summary_type *>(enkf_node->data), ecl_sum, time_index);
+        static_cast<summary_type *>(enkf_node->data), ecl_sum, time_index,
+        params_time_index);
 
     return loadOK;
 }
 
 static bool enkf_node_store_buffer(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                    int report_step, int iens) {
-    FUNC_ASSERT(enkf_node->write_to_buffer);
     {
         bool data_written;
         buffer_type *buffer = buffer_alloc(100);
         const enkf_config_node_type *config_node =
             enkf_node_get_config(enkf_node);
         buffer_fwrite_time_t(buffer, time(NULL));
-        data_written =
-            enkf_node->write_to_buffer(enkf_node->data, buffer, report_step);
+        data_written = enkf_node_typed_dispatch(
+            enkf_node->impl_type, [&](auto ops) -> bool {
+                return ops.write_to_buffer(enkf_node->data, buffer,
+                                           report_step);
+            });
         if (data_written) {
             const char *node_key = enkf_config_node_get_key(config_node);
             enkf_var_type var_type = enkf_config_node_get_var_type(config_node);
@@ -275,24 +346,53 @@ bool enkf_node_try_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
 
 static void enkf_node_buffer_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                   int report_step, int iens) {
-    FUNC_ASSERT(enkf_node->read_from_buffer);
     {
-        buffer_type *buffer = buffer_alloc(100);
         const enkf_config_node_type *config_node =
             enkf_node_get_config(enkf_node);
         const char *node_key = enkf_config_node_get_key(config_node);
         enkf_var_type var_type = enkf_config_node_get_var_type(config_node);
 
-        if (enkf_node->vector_storage)
+        if (enkf_node->vector_storage) {
+            // Summary vectors written by current code live in the
+            // realization's columnar block; it shadows any stale
+            // per-key record for the keys it holds.
+            if (enkf_node->impl_type == SUMMARY) {
+                auto block = enkf_fs_get_summary_block(fs, iens);
+                if (block && block->has_key(node_key)) {
+                    summary_set_vector(
+                        static_cast<summary_type *>(enkf_node->data),
+                        block->get(node_key), block->default_value());
+                    return;
+                }
+            }
+            buffer_type *buffer = buffer_alloc(100);
             enkf_fs_fread_vector(fs, buffer, node_key, var_type, iens);
-        else
-            enkf_fs_fread_node(fs, buffer, node_key, var_type, report_step,
-                               iens);
-
-        buffer_fskip_time_t(buffer);
-
-        enkf_node->read_from_buffer(enkf_node->data, buffer, fs, report_step);
-        buffer_free(buffer);
+            buffer_fskip_time_t(buffer);
+            enkf_node_typed_dispatch(enkf_node->impl_type, [&](auto ops) {
+                ops.read_from_buffer(enkf_node->data, buffer, fs, report_step);
+            });
+            buffer_free(buffer);
+        } else {
+            /*
+              The stored bytes are borrowed straight from storage and
+              only wrapped in a non-owning buffer for the
+              read_from_buffer call, so the node implementation
+              performs the single copy into its own arrays. The scope
+              keeps any fallback copy alive in the thread arena until
+              the node has consumed it.
+            */
+            ert::utils::ArenaScope scratch;
+            block_fs_view view;
+            enkf_fs_fread_node_view(fs, view, node_key, var_type, report_step,
+                                    iens);
+            buffer_type *buffer = buffer_alloc_private_wrapper(
+                const_cast<char *>(view.data), view.size);
+            buffer_fskip_time_t(buffer);
+            enkf_node_typed_dispatch(enkf_node->impl_type, [&](auto ops) {
+                ops.read_from_buffer(enkf_node->data, buffer, fs, report_step);
+            });
+            buffer_free_container(buffer);
+        }
     }
 }
 
@@ -378,20 +478,27 @@ void enkf_node_copy(const enkf_config_node_type *config_node,
 bool enkf_node_has_data(enkf_node_type *enkf_node, enkf_fs_type *fs,
                         node_id_type node_id) {
     if (enkf_node->vector_storage) {
-        FUNC_ASSERT(enkf_node->has_data);
-        {
-            int report_step = node_id.report_step;
-            int iens = node_id.iens;
-
-            // Try to load the vector.
-            if (enkf_config_node_has_vector(enkf_node->config, fs, iens)) {
-                enkf_node_load_vector(enkf_node, fs, iens);
-
-                // The vector is loaded. Check if we have the report_step/state asked for:
-                return enkf_node->has_data(enkf_node->data, report_step);
-            } else
-                return false;
-        }
+        int report_step = node_id.report_step;
+        int iens = node_id.iens;
+
+        // Try to load the vector.
+        if (enkf_config_node_has_vector(enkf_node->config, fs, iens)) {
+            enkf_node_load_vector(enkf_node, fs, iens);
+
+            // The vector is loaded. Check if we have the report_step/state asked for:
+            return enkf_node_typed_dispatch(
+                enkf_node->impl_type, [&](auto ops) -> bool {
+                    if constexpr (decltype(ops)::has_data != nullptr)
+                        return ops.has_data(enkf_node->data, report_step);
+                    else {
+                        util_abort("%s: function handler: has_data not "
+                                   "registered for node:%s - aborting\n",
+                                   __func__, enkf_node->node_key);
+                        return false;
+                    }
+                });
+        } else
+            return false;
     } else
         return enkf_config_node_has_node(enkf_node->config, fs, node_id);
 }
@@ -400,10 +507,16 @@ void enkf_node_serialize(enkf_node_type *enkf_node, enkf_fs_type *fs,
                          node_id_type node_id, const ActiveList *active_list,
                          Eigen::MatrixXd &A, int row_offset, int column) {
 
-    FUNC_ASSERT(enkf_node->serialize);
     enkf_node_load(enkf_node, fs, node_id);
-    enkf_node->serialize(enkf_node->data, node_id, active_list, A, row_offset,
-                         column);
+    enkf_node_typed_dispatch(enkf_node->impl_type, [&](auto ops) {
+        if constexpr (decltype(ops)::serialize != nullptr)
+            ops.serialize(enkf_node->data, node_id, active_list, A, row_offset,
+                          column);
+        else
+            util_abort("%s: function handler: serialize not registered for "
+                       "node:%s - aborting\n",
+                       __func__, enkf_node->node_key);
+    });
 }
 
 void enkf_node_deserialize(enkf_node_type *enkf_node, enkf_fs_type *fs,
@@ -411,9 +524,15 @@ void enkf_node_deserialize(enkf_node_type *enkf_node, enkf_fs_type *fs,
                            const Eigen::MatrixXd &A, int row_offset,
                            int column) {
 
-    FUNC_ASSERT(enkf_node->deserialize);
-    enkf_node->deserialize(enkf_node->data, node_id, active_list, A, row_offset,
-                           column);
+    enkf_node_typed_dispatch(enkf_node->impl_type, [&](auto ops) {
+        if constexpr (decltype(ops)::deserialize != nullptr)
+            ops.deserialize(enkf_node->data, node_id, active_list, A,
+                            row_offset, column);
+        else
+            util_abort("%s: function handler: deserialize not registered for "
+                       "node:%s - aborting\n",
+                       __func__, enkf_node->node_key);
+    });
     enkf_node_store(enkf_node, fs, node_id);
 }
 
@@ -423,19 +542,24 @@ void enkf_node_deserialize(enkf_node_type *enkf_node, enkf_fs_type *fs,
    necessary to internalize anything.
 */
 bool enkf_node_initialize(enkf_node_type *enkf_node, int iens) {
-    if (enkf_node->initialize != NULL) {
-        char *init_file =
-            enkf_config_node_alloc_initfile(enkf_node->config, NULL, iens);
-        bool init = enkf_node->initialize(enkf_node->data, iens, init_file);
-        free(init_file);
-        return init;
-    } else
-        return false; /* No init performed */
+    return enkf_node_typed_dispatch(
+        enkf_node->impl_type, [&](auto ops) -> bool {
+            if constexpr (decltype(ops)::initialize != nullptr) {
+                char *init_file = enkf_config_node_alloc_initfile(
+                    enkf_node->config, NULL, iens);
+                bool init = ops.initialize(enkf_node->data, iens, init_file);
+                free(init_file);
+                return init;
+            } else
+                return false; /* No init performed */
+        });
 }
 
 extern "C" void enkf_node_free(enkf_node_type *enkf_node) {
-    if (enkf_node->freef != NULL)
-        enkf_node->freef(enkf_node->data);
+    enkf_node_typed_dispatch(enkf_node->impl_type, [enkf_node](auto ops) {
+        if (enkf_node->data != NULL)
+            ops.freef(enkf_node->data);
+    });
     free(enkf_node->node_key);
     free(enkf_node);
 }
@@ -444,83 +568,15 @@ const char *enkf_node_get_key(const enkf_node_type *enkf_node) {
     return enkf_node->node_key;
 }
 
-#undef FUNC_ASSERT
-
 static enkf_node_type *
 enkf_node_alloc_empty(const enkf_config_node_type *config) {
     const char *node_key = enkf_config_node_get_key(config);
-    ert_impl_type impl_type = enkf_config_node_get_impl_type(config);
     enkf_node_type *node = (enkf_node_type *)util_malloc(sizeof *node);
+    node->impl_type = enkf_config_node_get_impl_type(config);
     node->vector_storage = enkf_config_node_vector_storage(config);
     node->config = config;
     node->node_key = util_alloc_string_copy(node_key);
     node->data = NULL;
-
-    node->alloc = NULL;
-    node->initialize = NULL;
-    node->freef = NULL;
-    node->read_from_buffer = NULL;
-    node->write_to_buffer = NULL;
-    node->serialize = NULL;
-    node->deserialize = NULL;
-    node->has_data = NULL;
-
-    switch (impl_type) {
-    case (GEN_KW):
-        node->alloc = gen_kw_alloc__;
-        node->freef = gen_kw_free__;
-        node->write_to_buffer = gen_kw_write_to_buffer__;
-        node->read_from_buffer = gen_kw_read_from_buffer__;
-        node->serialize = gen_kw_serialize__;
-        node->deserialize = gen_kw_deserialize__;
-        break;
-    case (SUMMARY):
-        node->alloc = summary_alloc__;
-        node->freef = summary_free__;
-        node->read_from_buffer = summary_read_from_buffer__;
-        node->write_to_buffer = summary_write_to_buffer__;
-        node->serialize = summary_serialize__;
-        node->deserialize = summary_deserialize__;
-        node->has_data = summary_has_data__;
-        break;
-    case (SURFACE):
-        node->initialize = surface_initialize__;
-        node->alloc = surface_alloc__;
-        node->freef = surface_free__;
-        node->read_from_buffer = surface_read_from_buffer__;
-        node->write_to_buffer = surface_write_to_buffer__;
-        node->serialize = surface_serialize__;
-        node->deserialize = surface_deserialize__;
-        break;
-    case (FIELD):
-        node->alloc = field_alloc__;
-        node->initialize = field_initialize__;
-        node->freef = field_free__;
-        node->read_from_buffer = field_read_from_buffer__;
-        node->write_to_buffer = field_write_to_buffer__;
-        node->serialize = field_serialize__;
-        node->deserialize = field_deserialize__;
-        break;
-    case (GEN_DATA):
-        node->alloc = gen_data_alloc__;
-        node->freef = gen_data_free__;
-        node->read_from_buffer = gen_data_read_from_buffer__;
-        node->write_to_buffer = gen_data_write_to_buffer__;
-        node->serialize = gen_data_serialize__;
-        node->deserialize = gen_data_deserialize__;
-        break;
-    /* EXT_PARAM is used by Everest */
-    case (EXT_PARAM):
-        node->alloc = ext_param_alloc__;
-        node->freef = ext_param_free__;
-        node->write_to_buffer = ext_param_write_to_buffer__;
-        node->read_from_buffer = ext_param_read_from_buffer__;
-        break;
-    default:
-        util_abort("%s: implementation type: %d unknown - all hell is loose - "
-                   "aborting \n",
-                   __func__, impl_type);
-    }
     return node;
 }
 
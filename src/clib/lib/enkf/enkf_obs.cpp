@@ -1,8 +1,26 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <unistd.h>
+#include <future>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <ert/util/buffer.h>
 #include <ert/util/hash.h>
 #include <ert/util/type_vector_functions.h>
 #include <ert/util/vector.h>
 
+#include <ert/concurrency.hpp>
+#include <ert/logging.hpp>
+#include <ert/res_util/crc32c.hpp>
+#include <ert/res_util/memory.hpp>
 #include <ert/res_util/string.hpp>
 
 #include <ert/config/conf.hpp>
@@ -13,9 +31,12 @@
 #include <ert/enkf/enkf_analysis.hpp>
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_obs.hpp>
+#include <ert/enkf/gen_obs.hpp>
 #include <ert/enkf/obs_vector.hpp>
 #include <ert/enkf/summary_obs.hpp>
 
+static auto logger = ert::get_logger("enkf_obs");
+
 /**
 
 The observation system
@@ -435,16 +456,12 @@ static void enkf_obs_update_keys(enkf_obs_type *enkf_obs) {
 }
 
 /** Handle HISTORY_OBSERVATION instances. */
-static void handle_history_observation(enkf_obs_type *enkf_obs,
-                                       conf_instance_type *enkf_conf,
-                                       int last_report, double std_cutoff) {
-    stringlist_type *hist_obs_keys =
-        conf_instance_alloc_list_of_sub_instances_of_class_by_name(
-            enkf_conf, "HISTORY_OBSERVATION");
-    int num_hist_obs = stringlist_get_size(hist_obs_keys);
-
-    for (int i = 0; i < num_hist_obs; i++) {
-        const char *obs_key = stringlist_iget(hist_obs_keys, i);
+static void handle_history_observation(
+    enkf_obs_type *enkf_obs,
+    const std::vector<conf_instance_type *> &hist_obs_confs, int last_report,
+    double std_cutoff) {
+    for (const conf_instance_type *hist_obs_conf : hist_obs_confs) {
+        const char *obs_key = conf_instance_get_name_ref(hist_obs_conf);
 
         if (!enkf_obs->history) {
             fprintf(stderr,
@@ -453,8 +470,6 @@ static void handle_history_observation(enkf_obs_type *enkf_obs,
                     obs_key);
             break;
         }
-        const conf_instance_type *hist_obs_conf =
-            conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
         obs_vector_type *obs_vector;
         enkf_config_node_type *config_node;
         config_node = ensemble_config_add_summary_observation(
@@ -485,22 +500,23 @@ static void handle_history_observation(enkf_obs_type *enkf_obs,
             }
         }
     }
-    stringlist_free(hist_obs_keys);
 }
 
 /** Handle SUMMARY_OBSERVATION instances. */
-static void handle_summary_observation(enkf_obs_type *enkf_obs,
-                                       conf_instance_type *enkf_conf,
-                                       int last_report) {
-    stringlist_type *sum_obs_keys =
-        conf_instance_alloc_list_of_sub_instances_of_class_by_name(
-            enkf_conf, "SUMMARY_OBSERVATION");
-    int num_sum_obs = stringlist_get_size(sum_obs_keys);
-
-    for (int i = 0; i < num_sum_obs; i++) {
-        const char *obs_key = stringlist_iget(sum_obs_keys, i);
-        const conf_instance_type *sum_obs_conf =
-            conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
+static void handle_summary_observation(
+    enkf_obs_type *enkf_obs,
+    const std::vector<conf_instance_type *> &sum_obs_confs, int last_report) {
+    struct summary_obs_entry {
+        const char *obs_key;
+        const conf_instance_type *conf;
+        enkf_config_node_type *config_node;
+    };
+
+    // Resolving the summary config nodes mutates the ensemble config
+    // and must run serially.
+    std::vector<summary_obs_entry> entries;
+    for (const conf_instance_type *sum_obs_conf : sum_obs_confs) {
+        const char *obs_key = conf_instance_get_name_ref(sum_obs_conf);
         const char *sum_key =
             conf_instance_get_item_value_ref(sum_obs_conf, "KEY");
 
@@ -515,42 +531,142 @@ static void handle_summary_observation(enkf_obs_type *enkf_obs,
                     sum_key, obs_key);
             break;
         }
+        entries.push_back(
+            {obs_key, sum_obs_conf,
+             ensemble_config_get_node(enkf_obs->ensemble_config, sum_key)});
+    }
 
-        /* Check if obs_vector is alloc'd */
-        obs_vector_type *obs_vector = obs_vector_alloc(
-            SUMMARY_OBS, obs_key,
-            ensemble_config_get_node(enkf_obs->ensemble_config, sum_key),
-            last_report);
-        if (obs_vector == NULL)
-            break;
+    // Creating and loading the obs vectors only reads the conf
+    // instances and the rwlock protected obs_time map, so the
+    // per-observation work runs in parallel.
+    std::vector<obs_vector_type *> obs_vectors(entries.size(), nullptr);
+    {
+        Semafoor concurrently_executing_threads(
+            std::max(2u, std::thread::hardware_concurrency()));
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i < entries.size(); i++)
+            futures.push_back(std::async(
+                std::launch::async,
+                [&, i](Semafoor &execution_limiter) {
+                    std::scoped_lock lock(execution_limiter);
+                    const auto &entry = entries[i];
+                    obs_vector_type *obs_vector =
+                        obs_vector_alloc(SUMMARY_OBS, entry.obs_key,
+                                         entry.config_node, last_report);
+                    if (obs_vector != NULL)
+                        obs_vector_load_from_SUMMARY_OBSERVATION(
+                            obs_vector, entry.conf, enkf_obs->obs_time,
+                            enkf_obs->ensemble_config);
+                    obs_vectors[i] = obs_vector;
+                },
+                std::ref(concurrently_executing_threads)));
+        for (auto &future : futures)
+            future.get();
+    }
 
-        obs_vector_load_from_SUMMARY_OBSERVATION(obs_vector, sum_obs_conf,
-                                                 enkf_obs->obs_time,
-                                                 enkf_obs->ensemble_config);
-        enkf_obs_add_obs_vector(enkf_obs, obs_vector);
+    // Insert in config order so the obs hash is deterministic.
+    size_t added = 0;
+    while (added < obs_vectors.size() && obs_vectors[added] != NULL) {
+        enkf_obs_add_obs_vector(enkf_obs, obs_vectors[added]);
+        added++;
     }
-    stringlist_free(sum_obs_keys);
+    for (size_t i = added; i < obs_vectors.size(); i++)
+        if (obs_vectors[i] != NULL)
+            obs_vector_free(obs_vectors[i]);
 }
 
 /** Handle GENERAL_OBSERVATION instances. */
-static void handle_general_observation(enkf_obs_type *enkf_obs,
-                                       conf_instance_type *enkf_conf) {
-    stringlist_type *obs_keys =
-        conf_instance_alloc_list_of_sub_instances_of_class_by_name(
-            enkf_conf, "GENERAL_OBSERVATION");
-    int num_obs = stringlist_get_size(obs_keys);
-
-    for (int i = 0; i < num_obs; i++) {
-        const char *obs_key = stringlist_iget(obs_keys, i);
-        const conf_instance_type *gen_obs_conf =
-            conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
-
-        obs_vector_type *obs_vector = obs_vector_alloc_from_GENERAL_OBSERVATION(
-            gen_obs_conf, enkf_obs->obs_time, enkf_obs->ensemble_config);
-        if (obs_vector != NULL)
-            enkf_obs_add_obs_vector(enkf_obs, obs_vector);
+static void handle_general_observation(
+    enkf_obs_type *enkf_obs,
+    const std::vector<conf_instance_type *> &gen_obs_confs) {
+    int num_obs = gen_obs_confs.size();
+
+    // Creation only reads the conf instance, the rwlock protected
+    // obs_time map and (for OBS_FILE) the observation file itself, so
+    // the per-observation work - dominated by file parsing - runs in
+    // parallel. The vectors are inserted in config order afterwards so
+    // the obs hash is deterministic.
+    std::vector<obs_vector_type *> obs_vectors(num_obs, nullptr);
+    {
+        Semafoor concurrently_executing_threads(
+            std::max(2u, std::thread::hardware_concurrency()));
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < num_obs; i++)
+            futures.push_back(std::async(
+                std::launch::async,
+                [&, i](Semafoor &execution_limiter) {
+                    std::scoped_lock lock(execution_limiter);
+                    obs_vectors[i] = obs_vector_alloc_from_GENERAL_OBSERVATION(
+                        gen_obs_confs[i], enkf_obs->obs_time,
+                        enkf_obs->ensemble_config);
+                },
+                std::ref(concurrently_executing_threads)));
+        for (auto &future : futures)
+            future.get();
+    }
+
+    for (int i = 0; i < num_obs; i++)
+        if (obs_vectors[i] != NULL)
+            enkf_obs_add_obs_vector(enkf_obs, obs_vectors[i]);
+}
+
+/**
+  Collects the observation instances streamed out of the conf parser;
+  each instance is validated as it completes instead of after the full
+  file has been internalized, and the parser never builds the full
+  instance tree. The instances are bucketed per class since the three
+  classes are consumed in separate phases below.
+*/
+struct obs_conf_stream {
+    std::vector<conf_instance_type *> history_obs;
+    std::vector<conf_instance_type *> summary_obs;
+    std::vector<conf_instance_type *> general_obs;
+    std::set<std::string> path_errors;
+    bool valid = true;
+};
+
+/** Duplicate observation keys overwrite the earlier definition, with
+    the same warning the instance tree used to emit on insertion. */
+static void obs_conf_append(std::vector<conf_instance_type *> &obs_confs,
+                            conf_instance_type *obs_conf) {
+    const char *name = conf_instance_get_name_ref(obs_conf);
+    for (auto &existing : obs_confs) {
+        if (strcmp(conf_instance_get_name_ref(existing), name) == 0) {
+            printf("WARNING: Overwriting instance \"%s\" of class \"%s\"\n",
+                   name, conf_instance_get_class_name_ref(obs_conf));
+            conf_instance_free(existing);
+            existing = obs_conf;
+            return;
+        }
+    }
+    obs_confs.push_back(obs_conf);
+}
+
+static void obs_conf_visitor(conf_instance_type *obs_conf, void *arg) {
+    auto stream = static_cast<obs_conf_stream *>(arg);
+
+    char *path_error = conf_instance_get_path_error(obs_conf);
+    if (path_error) {
+        stream->path_errors.insert(path_error);
+        free(path_error);
     }
-    stringlist_free(obs_keys);
+    if (!conf_instance_validate(obs_conf))
+        stream->valid = false;
+
+    if (conf_instance_is_of_class(obs_conf, "HISTORY_OBSERVATION"))
+        obs_conf_append(stream->history_obs, obs_conf);
+    else if (conf_instance_is_of_class(obs_conf, "SUMMARY_OBSERVATION"))
+        obs_conf_append(stream->summary_obs, obs_conf);
+    else if (conf_instance_is_of_class(obs_conf, "GENERAL_OBSERVATION"))
+        obs_conf_append(stream->general_obs, obs_conf);
+    else
+        conf_instance_free(obs_conf);
+}
+
+static void obs_conf_free_all(std::vector<conf_instance_type *> &obs_confs) {
+    for (conf_instance_type *obs_conf : obs_confs)
+        conf_instance_free(obs_conf);
+    obs_confs.clear();
 }
 
 static void enkf_obs_reinterpret_DT_FILE(const char *errors) {
@@ -564,6 +680,316 @@ static void enkf_obs_reinterpret_DT_FILE(const char *errors) {
     // clang-format on
 }
 
+/*
+   Binary startup snapshot of the loaded observation tree.
+
+   Building the observation tree - parsing the observation file plus
+   every OBS_FILE/INDEX_FILE it references and resolving dates against
+   the time map - is repeated identically at every invocation against
+   an unchanged config. After a successful load the fully initialized
+   obs vectors are serialized to a versioned binary file under the
+   user cache directory (the same location as the workflow-job
+   directory cache), keyed by the content hashes of all source files
+   plus a hash of the obs_time map, and subsequent startups restore
+   the tree in a single read.
+
+   HISTORY_OBSERVATION values are derived from the refcase data, which
+   the source-file hashes can not see - configs containing them are
+   never snapshotted. Any mismatch or malformed snapshot falls back to
+   the normal parse, which rewrites the snapshot. Set
+   ERT_DISABLE_OBS_SNAPSHOT to bypass the mechanism entirely.
+*/
+
+#define OBS_SNAPSHOT_MAGIC 0x454F5331 /* "EOS1" */
+#define OBS_SNAPSHOT_VERSION 1
+
+namespace {
+
+bool obs_snapshot_hash_file(const std::string &path, std::int64_t &size,
+                            std::uint32_t &hash) {
+    FILE *stream = fopen(path.c_str(), "r");
+    if (stream == nullptr)
+        return false;
+    std::vector<char> chunk(1 << 20);
+    std::uint32_t crc = 0;
+    std::int64_t total = 0;
+    size_t count;
+    while ((count = fread(chunk.data(), 1, chunk.size(), stream)) > 0) {
+        crc = ert::utils::crc32c_extend(crc, chunk.data(), count);
+        total += count;
+    }
+    fclose(stream);
+    size = total;
+    hash = crc;
+    return true;
+}
+
+std::filesystem::path obs_snapshot_filename(const char *config_file) {
+    std::string abs_path = std::filesystem::absolute(config_file).string();
+    std::uint32_t path_hash =
+        ert::utils::crc32c(abs_path.data(), abs_path.size());
+
+    const char *cache_home = getenv("XDG_CACHE_HOME");
+    std::filesystem::path cache_dir;
+    if (cache_home != nullptr && cache_home[0] != '\0')
+        cache_dir = cache_home;
+    else {
+        const char *home = getenv("HOME");
+        cache_dir = std::filesystem::path(home ? home : "/tmp") / ".cache";
+    }
+    return cache_dir / "ert" / "obs_snapshots" /
+           fmt::format("{:08x}.snap", path_hash);
+}
+
+void obs_snapshot_write_string(buffer_type *buffer, const char *string) {
+    int length = strlen(string);
+    buffer_fwrite_int(buffer, length);
+    buffer_fwrite(buffer, string, 1, length);
+}
+
+bool obs_snapshot_read_string(buffer_type *buffer, std::string &target) {
+    if (buffer_get_remaining_size(buffer) < sizeof(int))
+        return false;
+    int length = buffer_fread_int(buffer);
+    if (length < 0 || buffer_get_remaining_size(buffer) < (size_t)length)
+        return false;
+    target.resize(length);
+    buffer_fread(buffer, target.data(), 1, length);
+    return true;
+}
+
+std::uint32_t obs_snapshot_time_hash(time_map_type *obs_time) {
+    int size = time_map_get_size(obs_time);
+    std::vector<time_t> times(size);
+    for (int step = 0; step < size; step++)
+        times[step] = time_map_iget(obs_time, step);
+    return ert::utils::crc32c(times.data(), times.size() * sizeof(time_t));
+}
+
+} // namespace
+
+static void enkf_obs_save_snapshot(enkf_obs_type *enkf_obs,
+                                   const char *config_file,
+                                   const std::set<std::string> &source_files) {
+    buffer_type *buffer = buffer_alloc(4096);
+    buffer_fwrite_int(buffer, OBS_SNAPSHOT_MAGIC);
+    buffer_fwrite_int(buffer, OBS_SNAPSHOT_VERSION);
+    buffer_fwrite_int(buffer, (int)obs_snapshot_time_hash(enkf_obs->obs_time));
+
+    std::vector<std::string> manifest(source_files.begin(),
+                                      source_files.end());
+    manifest.insert(manifest.begin(),
+                    std::filesystem::absolute(config_file).string());
+    buffer_fwrite_int(buffer, manifest.size());
+    for (const std::string &path : manifest) {
+        std::int64_t file_size;
+        std::uint32_t file_hash;
+        if (!obs_snapshot_hash_file(path, file_size, file_hash)) {
+            buffer_free(buffer);
+            return;
+        }
+        obs_snapshot_write_string(buffer, path.c_str());
+        buffer_fwrite(buffer, &file_size, sizeof file_size, 1);
+        buffer_fwrite_int(buffer, (int)file_hash);
+    }
+
+    int num_vectors = vector_get_size(enkf_obs->obs_vector);
+    buffer_fwrite_int(buffer, num_vectors);
+    for (int i = 0; i < num_vectors; i++) {
+        const obs_vector_type *obs_vector =
+            (const obs_vector_type *)vector_iget_const(enkf_obs->obs_vector,
+                                                       i);
+        obs_impl_type impl_type = obs_vector_get_impl_type(obs_vector);
+        obs_snapshot_write_string(buffer, obs_vector_get_obs_key(obs_vector));
+        buffer_fwrite_int(buffer, impl_type);
+        obs_snapshot_write_string(buffer, obs_vector_get_state_kw(obs_vector));
+
+        const std::vector<int> &steps = obs_vector_get_step_list(obs_vector);
+        buffer_fwrite_int(buffer, steps.size());
+        for (int step : steps) {
+            buffer_fwrite_int(buffer, step);
+            void *node = obs_vector_iget_node(obs_vector, step);
+            if (impl_type == SUMMARY_OBS) {
+                auto summary_obs = static_cast<const summary_obs_type *>(node);
+                buffer_fwrite_double(buffer,
+                                     summary_obs_get_value(summary_obs));
+                buffer_fwrite_double(buffer, summary_obs_get_std(summary_obs));
+                buffer_fwrite_double(
+                    buffer, summary_obs_get_std_scaling(summary_obs));
+            } else
+                gen_obs_fwrite(static_cast<const gen_obs_type *>(node),
+                               buffer);
+        }
+    }
+
+    /* tmp + rename so a concurrent startup never sees a half written
+       snapshot. */
+    std::filesystem::path snapshot_file = obs_snapshot_filename(config_file);
+    std::error_code ec;
+    std::filesystem::create_directories(snapshot_file.parent_path(), ec);
+    std::string tmp_file =
+        fmt::format("{}.{}.tmp", snapshot_file.string(), getpid());
+    FILE *stream = fopen(tmp_file.c_str(), "w");
+    if (stream != nullptr) {
+        size_t byte_size = buffer_get_size(buffer);
+        if (fwrite(buffer_get_data(buffer), 1, byte_size, stream) ==
+                byte_size &&
+            fclose(stream) == 0)
+            std::filesystem::rename(tmp_file, snapshot_file, ec);
+        else
+            std::filesystem::remove(tmp_file, ec);
+    }
+    buffer_free(buffer);
+}
+
+static bool enkf_obs_try_load_snapshot(enkf_obs_type *enkf_obs,
+                                       const char *config_file) {
+    std::filesystem::path snapshot_file = obs_snapshot_filename(config_file);
+    FILE *stream = fopen(snapshot_file.c_str(), "r");
+    if (stream == nullptr)
+        return false;
+
+    buffer_type *buffer = buffer_alloc(4096);
+    {
+        std::vector<char> chunk(1 << 20);
+        size_t count;
+        while ((count = fread(chunk.data(), 1, chunk.size(), stream)) > 0)
+            buffer_fwrite(buffer, chunk.data(), 1, count);
+        fclose(stream);
+        buffer_rewind(buffer);
+    }
+
+    bool restored = false;
+    do {
+        if (buffer_get_remaining_size(buffer) < 4 * sizeof(int))
+            break;
+        if (buffer_fread_int(buffer) != OBS_SNAPSHOT_MAGIC)
+            break;
+        if (buffer_fread_int(buffer) != OBS_SNAPSHOT_VERSION)
+            break;
+        if ((std::uint32_t)buffer_fread_int(buffer) !=
+            obs_snapshot_time_hash(enkf_obs->obs_time))
+            break;
+
+        int manifest_size = buffer_fread_int(buffer);
+        bool manifest_ok = manifest_size >= 0;
+        for (int i = 0; manifest_ok && i < manifest_size; i++) {
+            std::string path;
+            std::int64_t stored_size;
+            if (!obs_snapshot_read_string(buffer, path) ||
+                buffer_get_remaining_size(buffer) <
+                    sizeof stored_size + sizeof(int)) {
+                manifest_ok = false;
+                break;
+            }
+            buffer_fread(buffer, &stored_size, sizeof stored_size, 1);
+            std::uint32_t stored_hash = (std::uint32_t)buffer_fread_int(buffer);
+
+            std::int64_t file_size;
+            std::uint32_t file_hash;
+            manifest_ok = obs_snapshot_hash_file(path, file_size, file_hash) &&
+                          file_size == stored_size && file_hash == stored_hash;
+        }
+        if (!manifest_ok)
+            break;
+
+        int num_vectors = buffer_fread_int(buffer);
+        if (num_vectors < 0)
+            break;
+        int last_report = enkf_obs_get_last_restart(enkf_obs);
+        bool vectors_ok = true;
+        for (int i = 0; vectors_ok && i < num_vectors; i++) {
+            std::string obs_key;
+            std::string state_kw;
+            vectors_ok = false;
+            if (!obs_snapshot_read_string(buffer, obs_key))
+                break;
+            if (buffer_get_remaining_size(buffer) < sizeof(int))
+                break;
+            int impl_type = buffer_fread_int(buffer);
+            if (!obs_snapshot_read_string(buffer, state_kw))
+                break;
+
+            enkf_config_node_type *config_node = nullptr;
+            if (impl_type == SUMMARY_OBS) {
+                if (ensemble_config_add_summary_observation(
+                        enkf_obs->ensemble_config, state_kw.c_str(),
+                        LOAD_FAIL_WARN) == NULL)
+                    break;
+                config_node = ensemble_config_get_node(
+                    enkf_obs->ensemble_config, state_kw.c_str());
+            } else if (impl_type == GEN_OBS) {
+                if (!ensemble_config_has_key(enkf_obs->ensemble_config,
+                                             state_kw.c_str()))
+                    break;
+                config_node = ensemble_config_get_node(
+                    enkf_obs->ensemble_config, state_kw.c_str());
+                if (enkf_config_node_get_impl_type(config_node) != GEN_DATA)
+                    break;
+            } else
+                break;
+
+            if (buffer_get_remaining_size(buffer) < sizeof(int))
+                break;
+            int num_steps = buffer_fread_int(buffer);
+            if (num_steps < 0)
+                break;
+
+            obs_vector_type *obs_vector =
+                obs_vector_alloc((obs_impl_type)impl_type, obs_key.c_str(),
+                                 config_node, last_report);
+            bool steps_ok = true;
+            for (int s = 0; steps_ok && s < num_steps; s++) {
+                steps_ok = false;
+                if (buffer_get_remaining_size(buffer) < sizeof(int))
+                    break;
+                int step = buffer_fread_int(buffer);
+                if (step < 0 || step > last_report)
+                    break;
+                if (impl_type == SUMMARY_OBS) {
+                    if (buffer_get_remaining_size(buffer) < 3 * sizeof(double))
+                        break;
+                    double value = buffer_fread_double(buffer);
+                    double std = buffer_fread_double(buffer);
+                    double std_scale = buffer_fread_double(buffer);
+                    summary_obs_type *summary_obs = summary_obs_alloc(
+                        state_kw.c_str(), obs_key.c_str(), value, std);
+                    summary_obs_set_std_scale(summary_obs, std_scale);
+                    obs_vector_install_node(obs_vector, step, summary_obs);
+                } else {
+                    auto data_config =
+                        (const gen_data_config_type *)enkf_config_node_get_ref(
+                            config_node);
+                    gen_obs_type *gen_obs = gen_obs_fread_alloc(
+                        data_config, obs_key.c_str(), buffer);
+                    if (gen_obs == NULL)
+                        break;
+                    obs_vector_install_node(obs_vector, step, gen_obs);
+                }
+                steps_ok = true;
+            }
+            if (!steps_ok) {
+                obs_vector_free(obs_vector);
+                break;
+            }
+            enkf_obs_add_obs_vector(enkf_obs, obs_vector);
+            vectors_ok = true;
+        }
+        restored = vectors_ok;
+    } while (false);
+    buffer_free(buffer);
+
+    if (restored) {
+        enkf_obs_update_keys(enkf_obs);
+        logger->info("Restored observation tree from snapshot {}",
+                     snapshot_file.string());
+    } else
+        /* Stale or malformed - drop partially restored state and let
+           the normal parse rebuild (and re-snapshot) everything. */
+        enkf_obs_clear(enkf_obs);
+    return restored;
+}
+
 /**
  This function will load an observation configuration from the
    observation file @config_file.
@@ -579,28 +1005,73 @@ void enkf_obs_load(enkf_obs_type *enkf_obs, const char *config_file,
                    __func__, config_file);
 
     int last_report = enkf_obs_get_last_restart(enkf_obs);
+    // The observation tree has no cheap size formula, so its share is
+    // accounted as the process growth over the load.
+    std::size_t memory_before = ert::utils::process_memory();
+
+    bool use_snapshot = getenv("ERT_DISABLE_OBS_SNAPSHOT") == nullptr;
+    if (use_snapshot && enkf_obs_try_load_snapshot(enkf_obs, config_file)) {
+        std::size_t memory_restored = ert::utils::process_memory();
+        if (memory_restored > memory_before)
+            ert::utils::memory_account("enkf_obs")
+                .allocate((memory_restored - memory_before) << 20);
+        return;
+    }
+
     conf_class_type *enkf_conf_class = enkf_obs_get_obs_conf_class();
-    conf_instance_type *enkf_conf = conf_instance_alloc_from_file(
-        enkf_conf_class, "enkf_conf", config_file);
 
-    const char *errors = conf_instance_get_path_error(enkf_conf);
-    if (errors) {
-        enkf_obs_reinterpret_DT_FILE(errors);
-        exit(1); // No need to free errors...
+    obs_conf_stream stream;
+    conf_instance_type *enkf_conf = conf_instance_alloc_from_file_visitor(
+        enkf_conf_class, "enkf_conf", config_file, obs_conf_visitor, &stream);
+
+    if (!stream.path_errors.empty()) {
+        std::string errors;
+        for (const std::string &error : stream.path_errors) {
+            errors.append(error);
+            errors.append("\n");
+        }
+        enkf_obs_reinterpret_DT_FILE(errors.c_str());
+        exit(1);
     }
 
-    if (!conf_instance_validate(enkf_conf))
+    if (!stream.valid || !conf_instance_validate(enkf_conf))
         util_abort("%s: Can not proceed with this configuration: %s\n",
                    __func__, config_file);
 
-    handle_history_observation(enkf_obs, enkf_conf, last_report, std_cutoff);
-    handle_summary_observation(enkf_obs, enkf_conf, last_report);
-    handle_general_observation(enkf_obs, enkf_conf);
+    // The instances of each class are released as soon as their phase
+    // is complete, so peak memory is bounded by one class at a time.
+    bool history_present = !stream.history_obs.empty();
+    handle_history_observation(enkf_obs, stream.history_obs, last_report,
+                               std_cutoff);
+    obs_conf_free_all(stream.history_obs);
+
+    handle_summary_observation(enkf_obs, stream.summary_obs, last_report);
+    obs_conf_free_all(stream.summary_obs);
+
+    // The snapshot manifest must cover every file the load read, so
+    // the auxiliary files of the general observations are collected
+    // before the instances are released.
+    std::set<std::string> source_files;
+    for (const conf_instance_type *gen_conf : stream.general_obs)
+        for (const char *item : {"OBS_FILE", "INDEX_FILE"})
+            if (conf_instance_has_item(gen_conf, item))
+                source_files.insert(
+                    conf_instance_get_item_value_ref(gen_conf, item));
+    handle_general_observation(enkf_obs, stream.general_obs);
+    obs_conf_free_all(stream.general_obs);
 
     conf_instance_free(enkf_conf);
     conf_class_free(enkf_conf_class);
 
     enkf_obs_update_keys(enkf_obs);
+
+    if (use_snapshot && !history_present)
+        enkf_obs_save_snapshot(enkf_obs, config_file, source_files);
+
+    std::size_t memory_after = ert::utils::process_memory();
+    if (memory_after > memory_before)
+        ert::utils::memory_account("enkf_obs")
+            .allocate((memory_after - memory_before) << 20);
 }
 
 conf_class_type *enkf_obs_get_obs_conf_class(void) {
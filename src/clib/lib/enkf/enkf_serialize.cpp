@@ -1,7 +1,13 @@
+#include <cstring>
+
 #include <ert/util/util.h>
 
 #include <ert/enkf/enkf_serialize.hpp>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 /*
    This file handles serialization and deserialization of the
    enkf_nodes. This is at the very core of the EnKF update
@@ -155,6 +161,45 @@ vector (marked with X2 above)). Now - that was clear ehhh?
    shape of the A matrix from here.
 */
 
+namespace {
+
+/**
+   Gather target[i] = node_data[active_list[i]]. The target points into
+   a column of the (column-major) A matrix, so it is contiguous and the
+   sparse index indirection is only on the load side - which AVX2 can
+   do with hardware gathers.
+*/
+void gather_active(const double *node_data, const int *active_list,
+                   int active_size, double *target) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 4 <= active_size; i += 4) {
+        __m128i index = _mm_loadu_si128((const __m128i *)&active_list[i]);
+        _mm256_storeu_pd(&target[i],
+                         _mm256_i32gather_pd(node_data, index, 8));
+    }
+#endif
+    for (; i < active_size; i++)
+        target[i] = node_data[active_list[i]];
+}
+
+void gather_active(const float *node_data, const int *active_list,
+                   int active_size, double *target) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i + 4 <= active_size; i += 4) {
+        __m128i index = _mm_loadu_si128((const __m128i *)&active_list[i]);
+        _mm256_storeu_pd(
+            &target[i],
+            _mm256_cvtps_pd(_mm_i32gather_ps(node_data, index, 4)));
+    }
+#endif
+    for (; i < active_size; i++)
+        target[i] = node_data[active_list[i]];
+}
+
+} // namespace
+
 void enkf_matrix_serialize(const void *__node_data, int node_size,
                            ecl_data_type node_type,
                            const ActiveList *__active_list, Eigen::MatrixXd &A,
@@ -165,29 +210,41 @@ void enkf_matrix_serialize(const void *__node_data, int node_size,
     if (ecl_type_is_double(node_type)) {
         const double *node_data = (const double *)__node_data;
         if (active_size == node_size) { /* All elements active */
-            if ((row_offset + node_size) <= A.rows()) {
-                for (int i = 0; i < node_size; i++)
-                    A(row_offset + i, column) = node_data[i];
-            } else
+            if ((row_offset + node_size) <= A.rows())
+                memcpy(&A(row_offset, column), node_data,
+                       node_size * sizeof(double));
+            else
                 throw std::out_of_range("range violation");
         } else {
-            for (int row_index = 0; row_index < active_size; row_index++) {
-                int node_index = active_list[row_index];
-                A(row_index + row_offset, column) = node_data[node_index];
-            }
+            /* Partly active masks are often one contiguous run - then
+               a single bulk copy beats the index indirection. */
+            auto run = __active_list->contiguous_range(node_size);
+            if (run)
+                memcpy(&A(row_offset, column), &node_data[run->first],
+                       run->second * sizeof(double));
+            else
+                gather_active(node_data, active_list, active_size,
+                              &A(row_offset, column));
         }
     } else if (ecl_type_is_float(node_type)) {
         const float *node_data = (const float *)__node_data;
-        int row_index;
         if (active_size == node_size) { /* All elements active */
-            for (row_index = 0; row_index < node_size; row_index++)
-                /* Must have float -> double conversion; can not use memcpy() based approach */
-                A(row_index + row_offset, column) = node_data[row_index];
+            /* Must have float -> double conversion; can not use a
+               memcpy() based approach - the cast assignment compiles
+               to a packed convert. */
+            A.col(column).segment(row_offset, node_size) =
+                Eigen::Map<const Eigen::VectorXf>(node_data, node_size)
+                    .cast<double>();
         } else {
-            for (int row_index = 0; row_index < active_size; row_index++) {
-                int node_index = active_list[row_index];
-                A(row_index + row_offset, column) = node_data[node_index];
-            }
+            auto run = __active_list->contiguous_range(node_size);
+            if (run)
+                A.col(column).segment(row_offset, run->second) =
+                    Eigen::Map<const Eigen::VectorXf>(&node_data[run->first],
+                                                      run->second)
+                        .cast<double>();
+            else
+                gather_active(node_data, active_list, active_size,
+                              &A(row_offset, column));
         }
     } else
         util_abort(
@@ -207,12 +264,19 @@ void enkf_matrix_deserialize(void *__node_data, int node_size,
         double *node_data = (double *)__node_data;
 
         if (active_size == node_size) { /* All elements active */
-            for (int row_index = 0; row_index < active_size; row_index++)
-                node_data[row_index] = A(row_index + row_offset, column);
+            memcpy(node_data, &A(row_offset, column),
+                   node_size * sizeof(double));
         } else {
-            for (int row_index = 0; row_index < active_size; row_index++) {
-                int node_index = active_list[row_index];
-                node_data[node_index] = A(row_index + row_offset, column);
+            auto run = __active_list->contiguous_range(node_size);
+            if (run)
+                memcpy(&node_data[run->first], &A(row_offset, column),
+                       run->second * sizeof(double));
+            else {
+                /* AVX2 has gathers but no scatter instruction, so the
+                   sparse write-back stays scalar. */
+                const double *source = &A(row_offset, column);
+                for (int row_index = 0; row_index < active_size; row_index++)
+                    node_data[active_list[row_index]] = source[row_index];
             }
         }
 
@@ -220,13 +284,19 @@ void enkf_matrix_deserialize(void *__node_data, int node_size,
         float *node_data = (float *)__node_data;
 
         if (active_size == node_size) { /* All elements active */
-            int row_index;
-            for (row_index = 0; row_index < active_size; row_index++)
-                node_data[row_index] = A(row_index + row_offset, column);
+            Eigen::Map<Eigen::VectorXf>(node_data, node_size) =
+                A.col(column).segment(row_offset, node_size).cast<float>();
         } else {
-            for (int row_index = 0; row_index < active_size; row_index++) {
-                int node_index = active_list[row_index];
-                node_data[node_index] = A(row_index + row_offset, column);
+            auto run = __active_list->contiguous_range(node_size);
+            if (run)
+                Eigen::Map<Eigen::VectorXf>(&node_data[run->first],
+                                            run->second) =
+                    A.col(column).segment(row_offset, run->second)
+                        .cast<float>();
+            else {
+                const double *source = &A(row_offset, column);
+                for (int row_index = 0; row_index < active_size; row_index++)
+                    node_data[active_list[row_index]] = source[row_index];
             }
         }
     } else
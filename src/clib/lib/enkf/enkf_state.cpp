@@ -1,10 +1,22 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <ert/concurrency.hpp>
+
 #include <ert/python.hpp>
+#include <ert/res_util/crc32c.hpp>
+#include <ert/res_util/file_utils.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/hash.h>
+#include <ert/util/util.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_sum.h>
@@ -16,6 +28,8 @@
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/enkf_state.hpp>
 #include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/summary_block.hpp>
 #include <ert/logging.hpp>
 #include <ert/res_util/memory.hpp>
 
@@ -28,6 +42,39 @@ void enkf_state_initialize(enkf_fs_type *fs, enkf_node_type *param_node,
         enkf_node_store(param_node, fs, node_id);
 }
 
+/**
+   Initialize one parameter for a set of realizations on the thread
+   pool. Each task owns a private node instance, so the per-member
+   file read/convert/transform work runs concurrently and overlaps the
+   storage writes (block_fs serializes those internally). FIELD
+   parameters initialized from 500 per-realization import files are
+   then bounded by I/O, not by processing the members one at a time.
+*/
+void enkf_state_initialize_ensemble(enkf_fs_type *fs,
+                                    const enkf_config_node_type *config_node,
+                                    const std::vector<int> &iens_list) {
+    // Each task holds one member's parameter vector; admitting the
+    // tasks through the memory governor keeps a wide fan-out inside
+    // the configured budget instead of pushing the node into swap.
+    std::size_t node_bytes =
+        (std::size_t)std::max(0,
+                              enkf_config_node_get_data_size(config_node, 0)) *
+        sizeof(double);
+    std::vector<std::future<void>> futures;
+    futures.reserve(iens_list.size());
+    for (int iens : iens_list)
+        futures.push_back(
+            ert::global_pool().submit([fs, config_node, iens, node_bytes] {
+                ert::utils::MemoryReservation reservation(
+                    ert::utils::memory_governor(), node_bytes);
+                enkf_node_type *param_node = enkf_node_alloc(config_node);
+                enkf_state_initialize(fs, param_node, iens);
+                enkf_node_free(param_node);
+            }));
+    for (auto &future : futures)
+        future.wait();
+}
+
 ecl_sum_type *load_ecl_sum(const std::string run_path,
                            const std::string eclbase) {
     ecl_sum_type *summary = NULL;
@@ -142,42 +189,67 @@ enkf_state_internalize_dynamic_eclipse_results(
         // Something has gone wrong in checking time map, fail
         return {TIME_MAP_FAILURE, status};
     }
-    int_vector_type *time_index = time_map_alloc_index_map(time_map, summary);
+    std::vector<int> time_index = time_map_index_map(time_map, summary);
 
     // The actual loading internalizing - from ecl_sum -> enkf_node.
     // step2 is just taken from the number of steps found in the
     // summary file.
     const int step2 = ecl_sum_get_last_report_step(summary);
 
-    int_vector_iset_block(time_index, 0, load_start, -1);
-    int_vector_resize(time_index, step2 + 1, -1);
+    std::fill_n(time_index.begin(),
+                std::min((size_t)load_start, time_index.size()), -1);
+    time_index.resize(step2 + 1, -1);
 
     const ecl_smspec_type *smspec = ecl_sum_get_smspec(summary);
 
+    std::vector<std::string> matched_keys;
     for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
         const ecl::smspec_node &smspec_node =
             ecl_smspec_iget_node_w_node_index(smspec, i);
         const char *key = smspec_node.get_gen_key1();
+        if (summary_key_matcher_match_summary_key(matcher, key))
+            matched_keys.emplace_back(key);
+    }
+    // One key set update per realization instead of one per key.
+    summary_key_set_add_summary_keys(enkf_fs_get_summary_key_set(sim_fs),
+                                     matched_keys);
+
+    // The report-step resolution against the summary handle is the
+    // same for every key; resolve it once per realization so each of
+    // the (potentially thousands of) keys only performs an indexed
+    // gather from the parsed summary data.
+    std::vector<int> params_time_index =
+        summary_params_time_index(summary, time_index);
+
+    // All keys of the realization are collected into one columnar
+    // block and stored with a single write, instead of one vector node
+    // per key. Starting from the stored block (when there is one)
+    // keeps keys internalized by earlier loads but not matched this
+    // time.
+    auto prior_block = enkf_fs_get_summary_block(sim_fs, iens);
+    auto block = prior_block ? std::make_shared<SummaryBlock>(*prior_block)
+                             : std::make_shared<SummaryBlock>();
+    block->set_default_value(summary_undefined_value());
+
+    for (const auto &matched_key : matched_keys) {
+        enkf_config_node_type *config_node =
+            ensemble_config_get_or_create_summary_node(ens_config,
+                                                       matched_key.c_str());
+        enkf_node_type *node = enkf_node_alloc(config_node);
 
-        if (summary_key_matcher_match_summary_key(matcher, key)) {
-            summary_key_set_type *key_set = enkf_fs_get_summary_key_set(sim_fs);
-            summary_key_set_add_summary_key(key_set, key);
-
-            enkf_config_node_type *config_node =
-                ensemble_config_get_or_create_summary_node(ens_config, key);
-            enkf_node_type *node = enkf_node_alloc(config_node);
-
-            // Ensure that what is currently on file is loaded
-            // before we update.
-            enkf_node_try_load_vector(node, sim_fs, iens);
+        // Ensure that what is currently on file is loaded
+        // before we update.
+        enkf_node_try_load_vector(node, sim_fs, iens);
 
-            enkf_node_forward_load_vector(node, summary, time_index);
-            enkf_node_store_vector(node, sim_fs, iens);
-            enkf_node_free(node);
-        }
+        enkf_node_forward_load_vector(node, summary, time_index,
+                                      params_time_index);
+        std::vector<double> values = summary_user_get_vector(
+            static_cast<summary_type *>(enkf_node_value_ptr(node)));
+        block->set(matched_key, values.data(), values.size());
+        enkf_node_free(node);
     }
-    int_vector_free(time_index);
-
+    if (!matched_keys.empty())
+        enkf_fs_store_summary_block(sim_fs, iens, std::move(block));
     // Check if some of the specified keys are missing from the Eclipse
     // data, and if there are observations for them. That is a problem.
     return enkf_state_check_for_missing_eclipse_summary_data(
@@ -253,6 +325,207 @@ enkf_state_internalize_GEN_DATA(const ensemble_config_type *ens_config,
     return result;
 }
 
+/**
+   Re-running "load results" over an ensemble is routine after a
+   partial failure, and it re-reads and re-stores every realization
+   even when the runpath outputs have not changed since the last load.
+   To skip that work, every successful internalization records the
+   run path it loaded from and a fingerprint - size, mtime and a
+   CRC32C of the contents - of each result file it read, stored per
+   realization in the case metadata directory. The next load of the
+   same realization is skipped only when it uses the same run path,
+   every recorded file is unchanged on disk and no new result file has
+   appeared since the record was written. The record is purely
+   advisory: a missing, stale or unparseable record just means the
+   realization is loaded normally.
+*/
+#define LOAD_FINGERPRINT_FILE "load-fingerprint"
+#define LOAD_FINGERPRINT_VERSION 2
+
+static std::string enkf_state_fingerprint_filename(const enkf_fs_type *sim_fs,
+                                                   int iens) {
+    char *case_path = util_alloc_sprintf(DEFAULT_CASE_PATH,
+                                         enkf_fs_get_mount_point(sim_fs));
+    std::string filename =
+        fmt::format("{}/{}.{}", case_path, LOAD_FINGERPRINT_FILE, iens);
+    free(case_path);
+    return filename;
+}
+
+/** Checksum the file through a fixed-size buffer; false when the file
+    cannot be stat'ed or read. */
+static bool enkf_state_checksum_file(const std::string &path, long long &size,
+                                     long long &mtime, unsigned int &crc) {
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) != 0)
+        return false;
+
+    FILE *stream = fopen(path.c_str(), "rb");
+    if (!stream)
+        return false;
+
+    std::vector<char> buffer(1024 * 1024);
+    unsigned int running = 0;
+    size_t bytes_read;
+    while ((bytes_read = fread(buffer.data(), 1, buffer.size(), stream)) > 0)
+        running = ert::utils::crc32c_extend(running, buffer.data(), bytes_read);
+    fclose(stream);
+
+    size = file_stat.st_size;
+    mtime = file_stat.st_mtime;
+    crc = running;
+    return true;
+}
+
+/**
+   The runpath files the internalization reads for one realization:
+   the summary header/unified pair when summary data is expected, and
+   the GEN_DATA input files for every internalized report step.
+*/
+static std::vector<std::string>
+enkf_state_result_files(ensemble_config_type *ens_config,
+                        const std::string &job_name,
+                        const std::string &run_path, int last_report) {
+    std::vector<std::string> files;
+
+    const summary_key_matcher_type *matcher =
+        ensemble_config_get_summary_key_matcher(ens_config);
+    if (summary_key_matcher_get_size(matcher) > 0 ||
+        ensemble_config_require_summary(ens_config)) {
+        char *header_file = ecl_util_alloc_exfilename(
+            run_path.c_str(), job_name.c_str(), ECL_SUMMARY_HEADER_FILE,
+            DEFAULT_FORMATTED, -1);
+        char *unified_file = ecl_util_alloc_exfilename(
+            run_path.c_str(), job_name.c_str(), ECL_UNIFIED_SUMMARY_FILE,
+            DEFAULT_FORMATTED, -1);
+        if (header_file != NULL) {
+            files.emplace_back(header_file);
+            free(header_file);
+        }
+        if (unified_file != NULL) {
+            files.emplace_back(unified_file);
+            free(unified_file);
+        }
+    }
+
+    stringlist_type *keylist_GEN_DATA =
+        ensemble_config_alloc_keylist_from_impl_type(ens_config, GEN_DATA);
+    for (int ikey = 0; ikey < stringlist_get_size(keylist_GEN_DATA); ikey++) {
+        const enkf_config_node_type *config_node = ensemble_config_get_node(
+            ens_config, stringlist_iget(keylist_GEN_DATA, ikey));
+        for (int report_step = 0; report_step <= util_int_max(0, last_report);
+             report_step++) {
+            if (!enkf_config_node_internalize(config_node, report_step))
+                continue;
+            char *infile =
+                enkf_config_node_alloc_infile(config_node, report_step);
+            if (infile != NULL) {
+                char *file =
+                    util_alloc_filename(run_path.c_str(), infile, NULL);
+                if (fs::exists(file))
+                    files.emplace_back(file);
+                free(file);
+            }
+            free(infile);
+        }
+    }
+    stringlist_free(keylist_GEN_DATA);
+    return files;
+}
+
+/** Rough working-set estimate for internalizing one realization: the
+    parsed in-memory representation of the result files is of the same
+    order as the bytes on disk, so twice the on-disk size is used. */
+static std::size_t
+enkf_state_estimate_load_bytes(const std::vector<std::string> &result_files) {
+    std::size_t bytes = 0;
+    for (const auto &path : result_files) {
+        std::error_code ec;
+        auto size = fs::file_size(path, ec);
+        if (!ec)
+            bytes += size;
+    }
+    return 2 * bytes;
+}
+
+static void
+enkf_state_fwrite_fingerprint(const enkf_fs_type *sim_fs, int iens,
+                              const std::string &run_path,
+                              const std::vector<std::string> &result_files) {
+    std::string filename = enkf_state_fingerprint_filename(sim_fs, iens);
+    std::string tmp_file = filename + ".tmp";
+
+    FILE *stream = mkdir_fopen(fs::path(tmp_file), "w");
+    fprintf(stream, "version %d\n", LOAD_FINGERPRINT_VERSION);
+    fprintf(stream, "runpath %s\n", run_path.c_str());
+    for (const auto &path : result_files) {
+        long long size, mtime;
+        unsigned int crc;
+        if (enkf_state_checksum_file(path, size, mtime, crc))
+            fprintf(stream, "file %lld %lld %u %s\n", size, mtime, crc,
+                    path.c_str());
+    }
+    fclose(stream);
+    // The rename makes the record visible atomically; if it fails the
+    // realization will simply be loaded again next time.
+    if (rename(tmp_file.c_str(), filename.c_str()) != 0)
+        unlink(tmp_file.c_str());
+}
+
+/** True when the realization has a fingerprint record written from
+    the same run path, every file in it is unchanged on disk and every
+    currently expected result file is covered by the record. The run
+    path check matters: a record from a previous RUNPATH only proves
+    that the *old* result files are unchanged, while the fresh results
+    live somewhere else entirely; likewise a result file which has
+    appeared since the record was written must trigger a new load. */
+static bool
+enkf_state_results_unchanged(const enkf_fs_type *sim_fs, int iens,
+                             const std::string &run_path,
+                             const std::vector<std::string> &expected_files) {
+    std::string filename = enkf_state_fingerprint_filename(sim_fs, iens);
+    FILE *stream = fopen(filename.c_str(), "r");
+    if (!stream)
+        return false;
+
+    int version;
+    char recorded_run_path[4096];
+    bool unchanged = (fscanf(stream, "version %d", &version) == 1 &&
+                      version == LOAD_FINGERPRINT_VERSION &&
+                      fscanf(stream, " runpath %4095[^\n]",
+                             recorded_run_path) == 1 &&
+                      run_path == recorded_run_path);
+    std::set<std::string> recorded_files;
+    while (unchanged) {
+        long long size, mtime;
+        unsigned int crc;
+        char path[4096];
+        int fields = fscanf(stream, " file %lld %lld %u %4095[^\n]", &size,
+                            &mtime, &crc, path);
+        if (fields == EOF)
+            break;
+        if (fields != 4) {
+            unchanged = false;
+            break;
+        }
+        recorded_files.insert(path);
+
+        long long current_size, current_mtime;
+        unsigned int current_crc;
+        if (!enkf_state_checksum_file(path, current_size, current_mtime,
+                                      current_crc) ||
+            current_size != size || current_mtime != mtime ||
+            current_crc != crc)
+            unchanged = false;
+    }
+    fclose(stream);
+
+    for (const auto &path : expected_files)
+        if (!recorded_files.count(path))
+            unchanged = false;
+    return unchanged && !recorded_files.empty();
+}
+
 /**
    This function loads the results from a forward simulations from report_step1
    to report_step2. The details of what to load are in model_config and the
@@ -265,6 +538,15 @@ static std::pair<fw_load_status, std::string> enkf_state_internalize_results(
     ensemble_config_type *ens_config, model_config_type *model_config,
     const std::string &job_name, const int iens, const std::string &run_path,
     enkf_fs_type *sim_fs) {
+    // Hundreds of realizations internalize concurrently; admission by
+    // estimated working set keeps the whole fan-out inside the
+    // configured memory budget.
+    ert::utils::MemoryReservation reservation(
+        ert::utils::memory_governor(),
+        enkf_state_estimate_load_bytes(enkf_state_result_files(
+            ens_config, job_name, run_path,
+            model_config_get_last_history_restart(model_config))));
+
     const summary_key_matcher_type *matcher =
         ensemble_config_get_summary_key_matcher(ens_config);
 
@@ -297,6 +579,10 @@ static std::pair<fw_load_status, std::string> enkf_state_internalize_results(
                                                   run_path, last_report);
     if (result == LOAD_FAILURE)
         return {LOAD_FAILURE, "Failed to internalize GEN_DATA"};
+
+    enkf_state_fwrite_fingerprint(
+        sim_fs, iens, run_path,
+        enkf_state_result_files(ens_config, job_name, run_path, last_report));
     return {LOAD_SUCCESSFUL, "Results loaded successfully."};
 }
 
@@ -304,6 +590,23 @@ std::pair<fw_load_status, std::string> enkf_state_load_from_forward_model(
     ensemble_config_type *ens_config, model_config_type *model_config,
     const int iens, const std::string &run_path, const std::string &job_name,
     enkf_fs_type *sim_fs) {
+    // Only realizations which already hold data can be skipped - the
+    // fingerprint record alone proves nothing if the previous load
+    // (including any forward init) did not complete.
+    int last_report = time_map_get_last_step(enkf_fs_get_time_map(sim_fs));
+    if (last_report < 0)
+        last_report = model_config_get_last_history_restart(model_config);
+    if (enkf_fs_get_state_map(sim_fs).get(iens) == STATE_HAS_DATA &&
+        enkf_state_results_unchanged(sim_fs, iens, run_path,
+                                     enkf_state_result_files(
+                                         ens_config, job_name, run_path,
+                                         last_report))) {
+        logger->info("[{:03d}:----] Results unchanged since last load - "
+                     "skipping internalization.",
+                     iens);
+        return {LOAD_SUCCESSFUL, "Results unchanged since last load."};
+    }
+
     std::pair<fw_load_status, std::string> result;
     if (ensemble_config_have_forward_init(ens_config))
         result =
@@ -326,12 +629,26 @@ ERT_CLIB_SUBMODULE("enkf_state", m) {
           [](Cwrap<enkf_node_type> param_node, Cwrap<enkf_fs_type> fs,
              int iens) { return enkf_state_initialize(fs, param_node, iens); });
 
-    m.def("internalize_results", [](Cwrap<ensemble_config_type> ens_config,
-                                    Cwrap<model_config_type> model_config,
-                                    const std::string &job_name, const int iens,
-                                    const std::string &run_path,
-                                    Cwrap<enkf_fs_type> sim_fs) {
-        return enkf_state_internalize_results(ens_config, model_config,
-                                              job_name, iens, run_path, sim_fs);
-    });
+    m.def("state_initialize_ensemble",
+          [](Cwrap<enkf_config_node_type> config_node, Cwrap<enkf_fs_type> fs,
+             const std::vector<int> &iens_list) {
+              py::gil_scoped_release release;
+              enkf_state_initialize_ensemble(fs, config_node, iens_list);
+          });
+
+    // The queue runs one done-callback thread per finished realization
+    // (bounded by CONCURRENT_INTERNALIZATION); releasing the GIL here
+    // lets those threads internalize results in parallel instead of
+    // serializing on the interpreter lock. The C++ load path does not
+    // touch Python, and the logger re-acquires the GIL on its own.
+    m.def(
+        "internalize_results",
+        [](Cwrap<ensemble_config_type> ens_config,
+           Cwrap<model_config_type> model_config, const std::string &job_name,
+           const int iens, const std::string &run_path,
+           Cwrap<enkf_fs_type> sim_fs) {
+            return enkf_state_internalize_results(
+                ens_config, model_config, job_name, iens, run_path, sim_fs);
+        },
+        py::call_guard<py::gil_scoped_release>());
 }
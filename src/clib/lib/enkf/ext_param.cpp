@@ -1,9 +1,14 @@
 #include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/util.h>
@@ -20,20 +25,37 @@ GET_DATA_SIZE_HEADER(ext_param);
 
 struct ext_param_struct {
     const ext_param_config_type *config;
-    std::vector<std::vector<double>> data;
+    /** All values for all keys in one contiguous block; the values of
+     * key i live at [offset[i], offset[i+1]). Keeping the block flat
+     * means storing and loading the node is a single bulk copy. */
+    std::vector<double> values;
+    std::vector<int> offset;
 };
 
+static int ext_param_data_size(const ext_param_type *param) {
+    return param->offset.size() - 1;
+}
+
+static int ext_param_value_count(const ext_param_type *param, int ikey) {
+    return param->offset[ikey + 1] - param->offset[ikey];
+}
+
 void ext_param_free(ext_param_type *ext_param) { delete ext_param; }
 
 ext_param_type *ext_param_alloc(const ext_param_config_type *config) {
     ext_param_type *ext_param = new ext_param_type();
     ext_param->config = config;
-    ext_param->data.resize(ext_param_config_get_data_size(config));
-    for (int i = 0; i < ext_param->data.size(); i++) {
+    int data_size = ext_param_config_get_data_size(config);
+    ext_param->offset.resize(data_size + 1);
+    int total_size = 0;
+    for (int i = 0; i < data_size; i++) {
+        ext_param->offset[i] = total_size;
         auto const suffix_count =
-            ext_param_config_ikey_get_suffix_count(ext_param->config, i);
-        ext_param->data[i].resize(std::max(suffix_count, 1));
+            ext_param_config_ikey_get_suffix_count(config, i);
+        total_size += std::max(suffix_count, 1);
     }
+    ext_param->offset[data_size] = total_size;
+    ext_param->values.resize(total_size);
     return ext_param;
 }
 
@@ -42,7 +64,7 @@ bool ext_param_key_set(ext_param_type *param, const char *key, double value) {
     if (index < 0)
         return false;
 
-    param->data[index][0] = value;
+    param->values[param->offset[index]] = value;
     return true;
 }
 
@@ -57,7 +79,7 @@ bool ext_param_key_suffix_set(ext_param_type *param, const char *key,
     if (suffix_index < 0)
         return false;
 
-    param->data[index][suffix_index] = value;
+    param->values[param->offset[index] + suffix_index] = value;
     return true;
 }
 
@@ -66,7 +88,7 @@ double ext_param_key_get(const ext_param_type *param, const char *key) {
     if (index < 0)
         util_abort("%s: invalid key:%s \n", __func__, key);
 
-    return param->data[index].front();
+    return param->values[param->offset[index]];
 }
 
 double ext_param_key_suffix_get(const ext_param_type *param, const char *key,
@@ -80,101 +102,153 @@ double ext_param_key_suffix_get(const ext_param_type *param, const char *key,
     if (isuffix < 0)
         util_abort("%s: invalid suffix:%s \n", __func__, suffix);
 
-    return param->data[ikey][isuffix];
+    return param->values[param->offset[ikey] + isuffix];
 }
 
 bool ext_param_iset(ext_param_type *param, int index, double value) {
-    if (index >= param->data.size())
+    if (index >= ext_param_data_size(param))
         return false;
 
     if (index < 0)
         return false;
 
-    param->data[index].front() = value;
+    param->values[param->offset[index]] = value;
     return true;
 }
 
 bool ext_param_iiset(ext_param_type *param, int ikey, int isuffix,
                      double value) {
-    if (ikey >= param->data.size())
+    if (ikey >= ext_param_data_size(param))
         return false;
 
     if (ikey < 0)
         return false;
 
-    if (isuffix >= param->data[ikey].size())
+    if (isuffix >= ext_param_value_count(param, ikey))
         return false;
 
     if (isuffix < 0)
         return false;
 
-    param->data[ikey][isuffix] = value;
+    param->values[param->offset[ikey] + isuffix] = value;
     return true;
 }
 
 double ext_param_iget(const ext_param_type *param, int index) {
-    if (index >= param->data.size())
+    if (index >= ext_param_data_size(param))
         util_abort("%s: invalid index:%d - range: [0,%d) \n", __func__, index,
-                   param->data.size());
+                   ext_param_data_size(param));
 
     if (index < 0)
         util_abort("%s: invalid index:%d - range: [0,%d) \n", __func__, index,
-                   param->data.size());
+                   ext_param_data_size(param));
 
-    return param->data[index].front();
+    return param->values[param->offset[index]];
 }
 
 double ext_param_iiget(const ext_param_type *param, int ikey, int isuffix) {
-    if (ikey >= param->data.size())
+    if (ikey >= ext_param_data_size(param))
         util_abort("%s: invalid key index:%d - range: [0,%d) \n", __func__,
-                   ikey, param->data.size());
+                   ikey, ext_param_data_size(param));
 
     if (ikey < 0)
         util_abort("%s: invalid key index:%d - range: [0,%d) \n", __func__,
-                   ikey, param->data.size());
+                   ikey, ext_param_data_size(param));
 
-    if (isuffix >= param->data[ikey].size())
+    if (isuffix >= ext_param_value_count(param, ikey))
         util_abort("%s: invalid suffix index:%d - range: [0,%d) \n", __func__,
-                   isuffix, param->data[ikey].size());
+                   isuffix, ext_param_value_count(param, ikey));
 
     if (isuffix < 0)
         util_abort("%s: invalid suffix index:%d - range: [0,%d) \n", __func__,
-                   isuffix, param->data[ikey].size());
+                   isuffix, ext_param_value_count(param, ikey));
 
-    return param->data[ikey][isuffix];
+    return param->values[param->offset[ikey] + isuffix];
 }
 
-void ext_param_json_export(const ext_param_type *ext_param,
-                           const char *json_file) {
-    auto stream = mkdir_fopen(fs::path(json_file), "w");
-    fprintf(stream, "{\n");
-    for (int ikey = 0; ikey < ext_param->data.size(); ikey++) {
-        auto const key = ext_param_config_iget_key(ext_param->config, ikey);
+namespace {
+/**
+   Precomputed JSON skeleton for one ext_param configuration: the
+   static text - keys, suffixes and punctuation - split at every value
+   position. The key structure is identical for all realizations of a
+   parameter, so the skeleton is built once per configuration and a
+   realization export is reduced to interleaving its values with the
+   prebuilt chunks.
+*/
+struct ext_param_skeleton {
+    /** chunks.size() == number of values + 1 */
+    std::vector<std::string> chunks;
+};
+
+ext_param_skeleton
+ext_param_skeleton_build(const ext_param_config_type *config) {
+    ext_param_skeleton skeleton;
+    std::string chunk = "{\n";
+    int data_size = ext_param_config_get_data_size(config);
+    for (int ikey = 0; ikey < data_size; ikey++) {
+        auto const key = ext_param_config_iget_key(config, ikey);
         auto const suffix_count =
-            ext_param_config_ikey_get_suffix_count(ext_param->config, ikey);
-
-        fprintf(stream, "\"%s\" : ", key); // print the key
-        if (suffix_count == 0) {           // no suffixes, just print the value
-            auto const value = ext_param->data[ikey].front();
-            fprintf(stream, "%g", value);
-        } else { // print suffixes and corresponding values
-            fprintf(stream, "{\n");
+            ext_param_config_ikey_get_suffix_count(config, ikey);
+
+        chunk += fmt::format("\"{}\" : ", key);
+        if (suffix_count == 0) {
+            skeleton.chunks.push_back(std::move(chunk));
+            chunk.clear();
+        } else {
+            chunk += "{\n";
             for (int isuffix = 0; isuffix < suffix_count; ++isuffix) {
-                auto const suffix = ext_param_config_ikey_iget_suffix(
-                    ext_param->config, ikey, isuffix);
-                auto const value = ext_param->data[ikey][isuffix];
-                fprintf(stream, "    \"%s\" : %g", suffix, value);
-                fprintf(stream, isuffix == suffix_count - 1 ? "\n" : ",\n");
+                auto const suffix =
+                    ext_param_config_ikey_iget_suffix(config, ikey, isuffix);
+                chunk += fmt::format("    \"{}\" : ", suffix);
+                skeleton.chunks.push_back(std::move(chunk));
+                chunk = isuffix == suffix_count - 1 ? "\n" : ",\n";
             }
-            fprintf(stream, "}");
+            chunk += "}";
         }
+        chunk += ikey < data_size - 1 ? ",\n" : "\n";
+    }
+    chunk += "}\n";
+    skeleton.chunks.push_back(std::move(chunk));
+    return skeleton;
+}
+} // namespace
+
+void ext_param_json_export(const ext_param_type *ext_param,
+                           const char *json_file) {
+    // One skeleton per configuration, shared by all realizations of
+    // the parameter for the lifetime of the process.
+    static std::mutex skeleton_mutex;
+    static std::unordered_map<const ext_param_config_type *,
+                              ext_param_skeleton>
+        skeletons;
+    const ext_param_skeleton *skeleton;
+    {
+        std::lock_guard lock{skeleton_mutex};
+        auto iter = skeletons.find(ext_param->config);
+        if (iter == skeletons.end())
+            iter = skeletons
+                       .emplace(ext_param->config,
+                                ext_param_skeleton_build(ext_param->config))
+                       .first;
+        skeleton = &iter->second;
+    }
 
-        if (ikey < (ext_param->data.size() - 1))
-            fprintf(stream, ",\n");
-        else
-            fprintf(stream, "\n");
+    // Render the whole document into one preallocated buffer and flush
+    // it with a single write call instead of one fprintf per token.
+    // The flat value block is laid out in exactly the skeleton slot
+    // order, so the export is a plain interleaving of the two.
+    fmt::memory_buffer buffer;
+    for (size_t slot = 0; slot < ext_param->values.size(); ++slot) {
+        const std::string &chunk = skeleton->chunks[slot];
+        buffer.append(chunk.data(), chunk.data() + chunk.size());
+        fmt::format_to(std::back_inserter(buffer), "{:g}",
+                       ext_param->values[slot]);
     }
-    fprintf(stream, "}\n");
+    const std::string &chunk = skeleton->chunks[ext_param->values.size()];
+    buffer.append(chunk.data(), chunk.data() + chunk.size());
+
+    auto stream = mkdir_fopen(fs::path(json_file), "w");
+    fwrite(buffer.data(), 1, buffer.size(), stream);
     fclose(stream);
 }
 
@@ -194,18 +268,18 @@ void ext_param_ecl_write(const ext_param_type *ext_param, const char *run_path,
 bool ext_param_write_to_buffer(const ext_param_type *ext_param,
                                buffer_type *buffer, int report_step) {
     buffer_fwrite_int(buffer, EXT_PARAM);
-    for (auto const &d : ext_param->data) {
-        buffer_fwrite(buffer, d.data(), sizeof *(d.data()), d.size());
-    }
+    /* The values are contiguous, so the whole node is one write. The
+       stored bytes are identical to the previous per-key writes. */
+    buffer_fwrite(buffer, ext_param->values.data(),
+                  sizeof *ext_param->values.data(), ext_param->values.size());
     return true;
 }
 
 void ext_param_read_from_buffer(ext_param_type *ext_param, buffer_type *buffer,
                                 enkf_fs_type *fs, int report_step) {
     enkf_util_assert_buffer_type(buffer, EXT_PARAM);
-    for (auto &d : ext_param->data) {
-        buffer_fread(buffer, d.data(), sizeof *(d.data()), d.size());
-    }
+    buffer_fread(buffer, ext_param->values.data(),
+                 sizeof *ext_param->values.data(), ext_param->values.size());
 }
 
 ext_param_config_type const *ext_param_get_config(const ext_param_type *param) {
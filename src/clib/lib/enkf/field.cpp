@@ -1,12 +1,20 @@
+#include <algorithm>
 #include <filesystem>
+#include <future>
+#include <thread>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <stdlib.h>
 #include <string.h>
 
+#include <ert/concurrency.hpp>
+
 #include <ert/enkf/enkf_node.hpp>
+#include <ert/res_util/arena.hpp>
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/buffer.h>
 #include <ert/util/util.h>
@@ -59,31 +67,29 @@ struct field_struct {
     {                                                                          \
         int nx, ny, nz;                                                        \
         field_config_get_dims(field->config, &nx, &ny, &nz);                   \
+        const int *global_to_active =                                          \
+            field_config_get_global_to_active(config);                         \
         int i, j, k;                                                           \
         for (k = 0; k < nz; k++) {                                             \
             for (j = 0; j < ny; j++) {                                         \
                 for (i = 0; i < nx; i++) {                                     \
-                    bool active_cell =                                         \
-                        field_config_active_cell(config, i, j, k);             \
+                    int global_index = i + j * nx + k * nx * ny;               \
+                    int active_index = global_to_active[global_index];         \
+                    bool active_cell = active_index >= 0;                      \
                     bool use_initial_value = false;                            \
                                                                                \
                     if (init_file && !active_cell)                             \
                         use_initial_value = true;                              \
                                                                                \
-                    int source_index = 0;                                      \
-                    if (use_initial_value)                                     \
-                        source_index =                                         \
-                            field_config_global_index(config, i, j, k);        \
-                    else                                                       \
-                        source_index =                                         \
-                            field_config_active_index(config, i, j, k);        \
+                    int source_index =                                         \
+                        use_initial_value ? global_index : active_index;       \
                                                                                \
                     int target_index;                                          \
                     if (rms_index_order)                                       \
                         target_index = rms_util_global_index_from_eclipse_ijk( \
                             nx, ny, nz, i, j, k);                              \
                     else                                                       \
-                        target_index = i + j * nx + k * nx * ny;               \
+                        target_index = global_index;                           \
                                                                                \
                     if (use_initial_value)                                     \
                         target_data[target_index] =                            \
@@ -143,13 +149,16 @@ void field_export3D(const field_type *field, void *_target_data,
         int i, j, k;                                                           \
         int nx, ny, nz;                                                        \
         field_config_get_dims(field->config, &nx, &ny, &nz);                   \
+        const int *global_to_active =                                          \
+            field_config_get_global_to_active(config);                         \
         for (k = 0; k < nz; k++) {                                             \
             for (j = 0; j < ny; j++) {                                         \
                 for (i = 0; i < nx; i++) {                                     \
+                    int global_index = i + j * nx + k * nx * ny;               \
                     int target_index =                                         \
                         keep_inactive_cells                                    \
-                            ? field_config_global_index(config, i, j, k)       \
-                            : field_config_active_index(config, i, j, k);      \
+                            ? global_index                                     \
+                            : global_to_active[global_index];                  \
                                                                                \
                     if (target_index >= 0) {                                   \
                         int source_index;                                      \
@@ -158,7 +167,7 @@ void field_export3D(const field_type *field, void *_target_data,
                                 rms_util_global_index_from_eclipse_ijk(        \
                                     nx, ny, nz, i, j, k);                      \
                         else                                                   \
-                            source_index = i + j * nx + k * nx * ny;           \
+                            source_index = global_index;                       \
                                                                                \
                         target_data[target_index] = src_data[source_index];    \
                     }                                                          \
@@ -263,13 +272,19 @@ void field_read_from_buffer(field_type *field, buffer_type *buffer,
                             field->data, byte_size);
 }
 
+/**
+   The returned full-grid scratch array lives in the thread arena; the
+   caller must hold an ert::utils::ArenaScope across the export.
+*/
 static void *__field_alloc_3D_data(const field_type *field, int data_size,
                                    bool rms_index_order,
                                    ecl_data_type data_type,
                                    ecl_data_type target_data_type,
                                    const char *init_file) {
-    void *data = (void *)util_calloc(
-        data_size, ecl_type_get_sizeof_ctype(target_data_type));
+    size_t byte_size =
+        (size_t)data_size * ecl_type_get_sizeof_ctype(target_data_type);
+    void *data = ert::utils::thread_arena().allocate(byte_size);
+    memset(data, 0, byte_size);
     if (ecl_type_is_double(data_type)) {
         double fill;
         if (rms_index_order)
@@ -346,6 +361,7 @@ static void field_ROFF_export__(const field_type *field,
                                 const char *init_file) {
     const int data_size = field_config_get_volume(field->config);
 
+    ert::utils::ArenaScope scratch;
     void *data = __field_alloc_3D_data(field, data_size, true, ECL_FLOAT,
                                        ECL_FLOAT, init_file);
     rms_tagkey_type *data_key = rms_tagkey_alloc_complete(
@@ -353,13 +369,20 @@ static void field_ROFF_export__(const field_type *field,
     rms_tag_fwrite_parameter(field_config_get_ecl_kw_name(field->config),
                              data_key, rms_file_get_FILE(rms_file));
     rms_tagkey_free(data_key);
-    free(data);
+    /* Hand the serialized parameter to the background write; the next
+       parameter (or the eof tag) is then produced while this one goes
+       to disk. */
+    rms_file_fwrite_flush(rms_file);
 }
 
 static rms_file_type *field_init_ROFF_export(const field_type *field,
                                              const char *filename) {
     rms_file_type *rms_file = rms_file_alloc(filename, false);
-    rms_file_fopen_w(rms_file);
+    /* Dominated by the data tagkey; the slack covers headers and tag
+       structure. */
+    size_t size_hint =
+        (size_t)field_config_get_volume(field->config) * sizeof(float) + 1024;
+    rms_file_fopen_w_async(rms_file, size_hint);
     rms_file_init_fwrite(rms_file, "parameter"); /* Version / byteswap ++ */
     {
         int nx, ny, nz;
@@ -411,13 +434,13 @@ bool field_write_to_buffer(const field_type *field, buffer_type *buffer,
 void field_ecl_write3D_fortio(const field_type *field, fortio_type *fortio,
                               const char *init_file) {
     const int data_size = field_config_get_volume(field->config);
+    ert::utils::ArenaScope scratch;
     void *data = __field_alloc_3D_data(field, data_size, false, ECL_FLOAT,
                                        ECL_FLOAT, init_file);
 
     ecl_kw_fwrite_param_fortio(fortio,
                                field_config_get_ecl_kw_name(field->config),
                                ECL_FLOAT, data_size, data);
-    free(data);
 }
 
 static ecl_kw_type *field_alloc_ecl_kw_wrapper__(const field_type *field,
@@ -434,12 +457,12 @@ static ecl_kw_type *field_alloc_ecl_kw_wrapper__(const field_type *field,
 void field_ecl_grdecl_export(const field_type *field, FILE *stream,
                              const char *init_file) {
     const int data_size = field_config_get_volume(field->config);
+    ert::utils::ArenaScope scratch;
     void *data = __field_alloc_3D_data(field, data_size, false, ECL_FLOAT,
                                        ECL_FLOAT, init_file);
     ecl_kw_type *ecl_kw = field_alloc_ecl_kw_wrapper__(field, data);
     ecl_kw_fprintf_grdecl(ecl_kw, stream);
     ecl_kw_free(ecl_kw);
-    free(data);
 }
 
 static void field_apply(field_type *field, field_func_type *func) {
@@ -464,31 +487,46 @@ static bool field_check_finite(const field_type *field) {
 }
 
 void field_inplace_output_transform(field_type *field) {
+    /* Prefer the array-level implementation - one vectorizable pass
+       over the buffer instead of an indirect call per cell. */
+    field_batch_func_type *batch_transform =
+        field_config_get_output_transform_batch(field->config);
+    if (batch_transform != NULL) {
+        batch_transform((float *)field->data,
+                        field_config_get_data_size(field->config));
+        return;
+    }
+
     field_func_type *output_transform =
         field_config_get_output_transform(field->config);
     if (output_transform != NULL)
         field_apply(field, output_transform);
 }
 
-#define TRUNCATE_MACRO(s, d, t, min, max)                                      \
-    for (int i = 0; i < s; i++) {                                              \
-        if (t & TRUNCATE_MIN)                                                  \
-            if (d[i] < min)                                                    \
-                d[i] = min;                                                    \
-        if (t & TRUNCATE_MAX)                                                  \
-            if (d[i] > max)                                                    \
-                d[i] = max;                                                    \
-    }
-
 static void field_apply_truncation(field_type *field) {
     int truncation = field_config_get_truncation_mode(field->config);
-    if (truncation != TRUNCATE_NONE) {
-        double min_value = field_config_get_truncation_min(field->config);
-        double max_value = field_config_get_truncation_max(field->config);
+    if (truncation == TRUNCATE_NONE)
+        return;
+
+    /* Resolve the configured mode to a plain [lo, hi] clamp before the
+       sweep; the loop body is then a branch free compare/select pair
+       the compiler turns into vector min/max instructions. NaN values
+       fail both comparisons and pass through unchanged, as they did
+       with the old per-cell branches. */
+    float lo = (truncation & TRUNCATE_MIN)
+                   ? (float)field_config_get_truncation_min(field->config)
+                   : -std::numeric_limits<float>::infinity();
+    float hi = (truncation & TRUNCATE_MAX)
+                   ? (float)field_config_get_truncation_max(field->config)
+                   : std::numeric_limits<float>::infinity();
 
-        const int data_size = field_config_get_data_size(field->config);
-        float *data = (float *)field->data;
-        TRUNCATE_MACRO(data_size, data, truncation, min_value, max_value);
+    const int data_size = field_config_get_data_size(field->config);
+    float *data = (float *)field->data;
+    for (int i = 0; i < data_size; i++) {
+        float value = data[i];
+        value = value < lo ? lo : value;
+        value = value > hi ? hi : value;
+        data[i] = value;
     }
 }
 
@@ -598,13 +636,20 @@ bool field_initialize(field_type *field, int iens, const char *init_file) {
         if (field_fload(field, init_file)) {
             field_func_type *init_transform =
                 field_config_get_init_transform(field->config);
+            field_batch_func_type *init_transform_batch =
+                field_config_get_init_transform_batch(field->config);
             /*
          Doing the input transform - observe that this is done inplace on
          the data, not as the output transform which is done on a copy of
          prior to export.
       */
             if (init_transform) {
-                field_apply(field, init_transform);
+                if (init_transform_batch != NULL)
+                    init_transform_batch(
+                        (float *)field->data,
+                        field_config_get_data_size(field->config));
+                else
+                    field_apply(field, init_transform);
                 if (!field_check_finite(field))
                     util_exit(
                         "Sorry: after applying the init transform field:%s "
@@ -874,4 +919,53 @@ ERT_CLIB_SUBMODULE("field", m) {
                   static_cast<field_type *>(enkf_node_value_ptr(enkf_node)),
                   run_path.c_str(), file);
           });
+
+    m.def("generate_parameter_files",
+          [](Cwrap<enkf_config_node_type> config_node, Cwrap<enkf_fs_type> fs,
+             const std::vector<std::string> &run_paths,
+             const std::vector<int> &iens_list,
+             const std::optional<std::string> &opt_file) {
+              if (enkf_config_node_get_impl_type(config_node) != FIELD)
+                  throw py::value_error{"Config node must be of type FIELD"};
+              if (run_paths.size() != iens_list.size())
+                  throw py::value_error{
+                      "run_paths and iens_list must have the same length"};
+
+              auto file = opt_file ? opt_file->c_str() : nullptr;
+              bool forward_init =
+                  enkf_config_node_use_forward_init(config_node);
+
+              // The exports are independent - each realization reads its
+              // own stored node and writes to its own runpath - and the
+              // work is mainly IO bound. Cap the number of concurrently
+              // executing exports so we do not hold one field buffer and
+              // one open file per realization at the same time.
+              Semafoor concurrently_executing_threads(
+                  std::max(2u, std::thread::hardware_concurrency()));
+              std::vector<std::future<void>> futures;
+
+              for (size_t job = 0; job < run_paths.size(); job++)
+                  futures.push_back(std::async(
+                      std::launch::async,
+                      [&, job](Semafoor &execution_limiter) {
+                          std::scoped_lock lock(execution_limiter);
+                          node_id_type node_id = {.report_step = 0,
+                                                  .iens = iens_list[job]};
+                          // Each worker allocates a private enkf_node so
+                          // no field buffer is shared between threads.
+                          enkf_node_type *node = enkf_node_alloc(config_node);
+                          if (!forward_init ||
+                              enkf_node_has_data(node, fs, node_id)) {
+                              enkf_node_load(node, fs, node_id);
+                              field_ecl_write(static_cast<field_type *>(
+                                                  enkf_node_value_ptr(node)),
+                                              run_paths[job].c_str(), file);
+                          }
+                          enkf_node_free(node);
+                      },
+                      std::ref(concurrently_executing_threads)));
+
+              for (auto &future : futures)
+                  future.get();
+          });
 }
@@ -1,3 +1,7 @@
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include <stdlib.h>
 #include <string.h>
 
@@ -89,6 +93,65 @@ Observe the following convention:
     global_index:  [0 , nx*ny*nz)
     active_index:  [0 , nactive)
 */
+/**
+   Precomputed lookup tables between global grid indices and
+   active-cell indices for one grid. Built once when a grid is first
+   attached to a field_config and shared - through a refcounted,
+   process wide cache keyed by the grid - between all field keys
+   defined on that grid. The per-cell index functions below then read
+   a table entry instead of querying the grid, which matters in the
+   cell loops of field serialization and export.
+*/
+struct field_grid_index_map {
+    const ecl_grid_type *grid;
+    int refcount;
+    /** nx*ny*nz entries; -1 for inactive cells. */
+    std::vector<int> global_to_active;
+    /** nactive entries. */
+    std::vector<int> active_to_global;
+};
+
+static auto &field_grid_index_cache() {
+    static std::map<const ecl_grid_type *, field_grid_index_map *> cache;
+    return cache;
+}
+
+static std::mutex field_grid_index_mutex;
+
+static const field_grid_index_map *
+field_grid_index_map_acquire(const ecl_grid_type *grid) {
+    std::lock_guard guard{field_grid_index_mutex};
+    auto &cache = field_grid_index_cache();
+    auto iter = cache.find(grid);
+    if (iter == cache.end()) {
+        auto *map = new field_grid_index_map;
+        map->grid = grid;
+        map->refcount = 0;
+        map->global_to_active.resize(ecl_grid_get_global_size(grid));
+        map->active_to_global.resize(ecl_grid_get_active_size(grid));
+        for (size_t g = 0; g < map->global_to_active.size(); g++) {
+            int active_index = ecl_grid_get_active_index1(grid, g);
+            map->global_to_active[g] = active_index;
+            if (active_index >= 0)
+                map->active_to_global[active_index] = g;
+        }
+        iter = cache.emplace(grid, map).first;
+    }
+    iter->second->refcount++;
+    return iter->second;
+}
+
+static void field_grid_index_map_release(const field_grid_index_map *map) {
+    if (map == NULL)
+        return;
+    std::lock_guard guard{field_grid_index_mutex};
+    auto *mutable_map = const_cast<field_grid_index_map *>(map);
+    if (--mutable_map->refcount == 0) {
+        field_grid_index_cache().erase(mutable_map->grid);
+        delete mutable_map;
+    }
+}
+
 struct field_config_struct {
     /** Name/key ... */
     char *ecl_kw_name;
@@ -100,6 +163,8 @@ struct field_config_struct {
     /** A shared reference to the grid this field is defined on. */
     ecl_grid_type *grid;
     bool private_grid;
+    /** Shared global<->active index tables for the grid above. */
+    const field_grid_index_map *index_map;
 
     /** How the field should be trunacted before exporting for simulation, and
      * for the inital import. OR'd combination of truncation_type from enkf_types.h*/
@@ -127,6 +192,12 @@ struct field_config_struct {
      * model - i.e. for dynamic data. */
     field_func_type *input_transform;
 
+    /** Array-level variants of the transforms above; NULL when the
+        transform only has a per-cell implementation. */
+    field_batch_func_type *output_transform_batch;
+    field_batch_func_type *init_transform_batch;
+    field_batch_func_type *input_transform_batch;
+
     char *output_transform_name;
     char *init_transform_name;
     char *input_transform_name;
@@ -263,6 +334,9 @@ void field_config_set_grid(field_config_type *config, ecl_grid_type *grid,
     config->grid = grid;
     config->private_grid = private_grid;
 
+    field_grid_index_map_release(config->index_map);
+    config->index_map = field_grid_index_map_acquire(grid);
+
     ecl_grid_get_dims(grid, &config->nx, &config->ny, &config->nz, NULL);
     config->data_size = field_config_get_data_size_from_grid(config);
 }
@@ -273,6 +347,16 @@ const char *field_config_get_grid_name(const field_config_type *config) {
 
 /*
   The return value from this function is hardly usable.
+
+  keep_inactive_cells selects between global-grid storage and the
+  compact active-cell-only mode: with keep_inactive_cells == false
+  (the default for all FIELD nodes, see enkf_config_node_alloc_field)
+  data_size is the number of *active* cells, so both the in-memory
+  buffer and the node stored in block_fs hold only active cells, and
+  the serialization feeding the update works on the compact vector.
+  Expansion to the global grid happens lazily on export through
+  field_export3D. Only temporary helper configs (e.g. reading inactive
+  values from an INIT_FILE during export) use global-size storage.
 */
 field_config_type *field_config_alloc_empty(const char *ecl_kw_name,
                                             ecl_grid_type *ecl_grid,
@@ -287,12 +371,16 @@ field_config_type *field_config_alloc_empty(const char *ecl_kw_name,
     config->private_grid = false;
     config->__enkf_mode = true;
     config->grid = NULL;
+    config->index_map = NULL;
     config->write_compressed = true;
     config->type = UNKNOWN_FIELD_TYPE;
 
     config->output_transform = NULL;
     config->input_transform = NULL;
     config->init_transform = NULL;
+    config->output_transform_batch = NULL;
+    config->input_transform_batch = NULL;
+    config->init_transform_batch = NULL;
     config->output_transform_name = NULL;
     config->input_transform_name = NULL;
     config->init_transform_name = NULL;
@@ -322,11 +410,15 @@ static void field_config_set_init_transform(field_config_type *config,
 
     config->init_transform_name = util_realloc_string_copy(
         config->init_transform_name, init_transform_name);
-    if (init_transform_name != NULL)
+    if (init_transform_name != NULL) {
         config->init_transform =
             field_trans_table_lookup(config->trans_table, init_transform_name);
-    else
+        config->init_transform_batch = field_trans_table_lookup_batch(
+            config->trans_table, init_transform_name);
+    } else {
         config->init_transform = NULL;
+        config->init_transform_batch = NULL;
+    }
 }
 
 static void
@@ -346,11 +438,15 @@ field_config_set_output_transform(field_config_type *config,
 
     config->output_transform_name = util_realloc_string_copy(
         config->output_transform_name, output_transform_name);
-    if (output_transform_name != NULL)
+    if (output_transform_name != NULL) {
         config->output_transform = field_trans_table_lookup(
             config->trans_table, output_transform_name);
-    else
+        config->output_transform_batch = field_trans_table_lookup_batch(
+            config->trans_table, output_transform_name);
+    } else {
         config->output_transform = NULL;
+        config->output_transform_batch = NULL;
+    }
 }
 
 static void
@@ -370,11 +466,15 @@ field_config_set_input_transform(field_config_type *config,
 
     config->input_transform_name = util_realloc_string_copy(
         config->input_transform_name, input_transform_name);
-    if (input_transform_name != NULL)
+    if (input_transform_name != NULL) {
         config->input_transform =
             field_trans_table_lookup(config->trans_table, input_transform_name);
-    else
+        config->input_transform_batch = field_trans_table_lookup_batch(
+            config->trans_table, input_transform_name);
+    } else {
         config->input_transform = NULL;
+        config->input_transform_batch = NULL;
+    }
 }
 
 void field_config_update_parameter_field(
@@ -458,12 +558,27 @@ field_type_enum field_config_get_type(const field_config_type *config) {
 */
 int field_config_active_index(const field_config_type *config, int i, int j,
                               int k) {
-    return ecl_grid_get_active_index3(config->grid, i, j, k);
+    return config->index_map
+        ->global_to_active[field_config_global_index(config, i, j, k)];
 }
 
 int field_config_global_index(const field_config_type *config, int i, int j,
                               int k) {
-    return ecl_grid_get_global_index3(config->grid, i, j, k);
+    return i + j * config->nx + k * config->nx * config->ny;
+}
+
+/**
+   Direct access to the precomputed index tables, for kernels which
+   iterate over all cells. The global_to_active table has
+   nx*ny*nz entries in (i fastest) global order, with -1 for inactive
+   cells; active_to_global has nactive entries.
+*/
+const int *field_config_get_global_to_active(const field_config_type *config) {
+    return config->index_map->global_to_active.data();
+}
+
+const int *field_config_get_active_to_global(const field_config_type *config) {
+    return config->index_map->active_to_global.data();
 }
 
 /**
@@ -486,7 +601,7 @@ bool field_config_ijk_valid(const field_config_type *config, int i, int j,
 bool field_config_ijk_active(const field_config_type *config, int i, int j,
                              int k) {
     if (ecl_grid_ijk_valid(config->grid, i, j, k)) {
-        int active_index = ecl_grid_get_active_index3(config->grid, i, j, k);
+        int active_index = field_config_active_index(config, i, j, k);
 
         if (active_index >= 0)
             return true;
@@ -516,6 +631,7 @@ double field_config_get_truncation_max(const field_config_type *config) {
 }
 
 void field_config_free(field_config_type *config) {
+    field_grid_index_map_release(config->index_map);
     free(config->ecl_kw_name);
     free(config->input_transform_name);
     free(config->output_transform_name);
@@ -626,6 +742,16 @@ field_config_get_init_transform(const field_config_type *config) {
     return config->init_transform;
 }
 
+field_batch_func_type *
+field_config_get_output_transform_batch(const field_config_type *config) {
+    return config->output_transform_batch;
+}
+
+field_batch_func_type *
+field_config_get_init_transform_batch(const field_config_type *config) {
+    return config->init_transform_batch;
+}
+
 /**
    Asserts that two fields can be combined in a binary operation.
 */
@@ -26,17 +26,22 @@ typedef struct {
     char *key;
     char *description;
     field_func_type *func;
+    /** Array-level implementation; may be NULL, in which case the
+        caller falls back to the per-cell function. */
+    field_batch_func_type *batch_func;
 } field_func_node_type;
 
-static field_func_node_type *field_func_node_alloc(const char *key,
-                                                   const char *description,
-                                                   field_func_type *func) {
+static field_func_node_type *
+field_func_node_alloc(const char *key, const char *description,
+                      field_func_type *func,
+                      field_batch_func_type *batch_func) {
     field_func_node_type *node =
         (field_func_node_type *)util_malloc(sizeof *node);
 
     node->key = util_alloc_string_copy(key);
     node->description = util_alloc_string_copy(description);
     node->func = func;
+    node->batch_func = batch_func;
 
     return node;
 }
@@ -60,7 +65,8 @@ static void field_func_node_fprintf(const field_func_node_type *node,
 }
 
 void field_trans_table_add(field_trans_table_type *table, const char *_key,
-                           const char *description, field_func_type *func) {
+                           const char *description, field_func_type *func,
+                           field_batch_func_type *batch_func) {
     char *key;
 
     if (table->case_sensitive)
@@ -70,7 +76,7 @@ void field_trans_table_add(field_trans_table_type *table, const char *_key,
 
     {
         field_func_node_type *node =
-            field_func_node_alloc(key, description, func);
+            field_func_node_alloc(key, description, func, batch_func);
         hash_insert_hash_owned_ref(table->function_table, key, node,
                                    field_func_node_free__);
     }
@@ -127,6 +133,30 @@ field_func_type *field_trans_table_lookup(field_trans_table_type *table,
     return func;
 }
 
+/**
+   Returns the array-level implementation of the transform, or NULL if
+   the transform only has a per-cell function. The key must exist.
+*/
+field_batch_func_type *
+field_trans_table_lookup_batch(field_trans_table_type *table,
+                               const char *_key) {
+    field_batch_func_type *batch_func = NULL;
+    char *key;
+
+    if (table->case_sensitive)
+        key = util_alloc_string_copy(_key);
+    else
+        key = util_alloc_strupr_copy(_key);
+
+    if (hash_has_key(table->function_table, key)) {
+        field_func_node_type *func_node =
+            (field_func_node_type *)hash_get(table->function_table, key);
+        batch_func = func_node->batch_func;
+    }
+    free(key);
+    return batch_func;
+}
+
 /**
    Will return false if _key == NULL
 */
@@ -194,6 +224,39 @@ static float normalize_poro(float x) {
 static float denormalize_poro(float x) {
     return denormalize(x, PORO_MEAN, PORO_STD);
 }
+static void normalize_batch(float *data, int size, float mean, float std) {
+    for (int i = 0; i < size; i++)
+        data[i] = (data[i] - mean) / std;
+}
+
+static void denormalize_batch(float *data, int size, float mean, float std) {
+    for (int i = 0; i < size; i++)
+        data[i] = (data[i] * std) + mean;
+}
+
+static void normalize_permx_batch(float *data, int size) {
+    normalize_batch(data, size, PERMX_MEAN, PERMX_STD);
+}
+
+static void denormalize_permx_batch(float *data, int size) {
+    denormalize_batch(data, size, PERMX_MEAN, PERMX_STD);
+}
+
+static void normalize_permz_batch(float *data, int size) {
+    normalize_batch(data, size, PERMZ_MEAN, PERMZ_STD);
+}
+
+static void denormalize_permz_batch(float *data, int size) {
+    denormalize_batch(data, size, PERMZ_MEAN, PERMZ_STD);
+}
+
+static void normalize_poro_batch(float *data, int size) {
+    normalize_batch(data, size, PORO_MEAN, PORO_STD);
+}
+
+static void denormalize_poro_batch(float *data, int size) {
+    denormalize_batch(data, size, PORO_MEAN, PORO_STD);
+}
 /* Rubakumar specials: end  */
 
 static float field_trans_pow10(float x) { return powf(10.0, x); }
@@ -206,6 +269,45 @@ static float trunc_pow10f(float x) {
 static float field_trans_ln0(float x) { return logf(x + LN_SHIFT); }
 
 static float field_trans_exp0(float x) { return expf(x) - LN_SHIFT; }
+
+/*
+  The batch variants transform the whole buffer in one simple loop the
+  compiler can vectorize, instead of one indirect call per cell.
+*/
+static void field_trans_pow10_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = powf(10.0, data[i]);
+}
+
+static void trunc_pow10f_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = util_float_max(powf(10.0, data[i]), 0.001);
+}
+
+static void field_trans_log_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = logf(data[i]);
+}
+
+static void field_trans_log10_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = log10f(data[i]);
+}
+
+static void field_trans_exp_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = expf(data[i]);
+}
+
+static void field_trans_ln0_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = logf(data[i] + LN_SHIFT);
+}
+
+static void field_trans_exp0_batch(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = expf(data[i]) - LN_SHIFT;
+}
 #undef LN_SHIFT
 
 field_trans_table_type *field_trans_table_alloc() {
@@ -215,39 +317,48 @@ field_trans_table_type *field_trans_table_alloc() {
     field_trans_table_add(
         table, "POW10",
         "This function will raise x to the power of 10: y = 10^x.",
-        field_trans_pow10);
+        field_trans_pow10, field_trans_pow10_batch);
     field_trans_table_add(table, "TRUNC_POW10",
                           "This function will raise x to the power of 10 - and "
                           "truncate lower values at 0.001.",
-                          trunc_pow10f);
+                          trunc_pow10f, trunc_pow10f_batch);
     field_trans_table_add(
         table, "LOG",
-        "This function will take the NATURAL logarithm of x: y = ln(x)", logf);
+        "This function will take the NATURAL logarithm of x: y = ln(x)", logf,
+        field_trans_log_batch);
     field_trans_table_add(
         table, "LN",
-        "This function will take the NATURAL logarithm of x: y = ln(x)", logf);
+        "This function will take the NATURAL logarithm of x: y = ln(x)", logf,
+        field_trans_log_batch);
     field_trans_table_add(
         table, "LOG10",
         "This function will take the log10 logarithm of x: y = log10(x)",
-        log10f);
+        log10f, field_trans_log10_batch);
     field_trans_table_add(table, "EXP",
-                          "This function will calculate y = exp(x) ", expf);
+                          "This function will calculate y = exp(x) ", expf,
+                          field_trans_exp_batch);
     field_trans_table_add(table, "LN0",
                           "This function will calculate y = ln(x + 0.000001)",
-                          field_trans_ln0);
+                          field_trans_ln0, field_trans_ln0_batch);
     field_trans_table_add(table, "EXP0",
                           "This function will calculate y = exp(x) - 0.000001",
-                          field_trans_exp0);
+                          field_trans_exp0, field_trans_exp0_batch);
 
     // Rubakumar specials:
-    field_trans_table_add(table, "NORMALIZE_PERMX", "...", normalize_permx);
-    field_trans_table_add(table, "DENORMALIZE_PERMX", "...", denormalize_permx);
-
-    field_trans_table_add(table, "NORMALIZE_PERMZ", "...", normalize_permz);
-    field_trans_table_add(table, "DENORMALIZE_PERMZ", "...", denormalize_permz);
-
-    field_trans_table_add(table, "NORMALIZE_PORO", "...", normalize_poro);
-    field_trans_table_add(table, "DENORMALIZE_PORO", "...", denormalize_poro);
+    field_trans_table_add(table, "NORMALIZE_PERMX", "...", normalize_permx,
+                          normalize_permx_batch);
+    field_trans_table_add(table, "DENORMALIZE_PERMX", "...", denormalize_permx,
+                          denormalize_permx_batch);
+
+    field_trans_table_add(table, "NORMALIZE_PERMZ", "...", normalize_permz,
+                          normalize_permz_batch);
+    field_trans_table_add(table, "DENORMALIZE_PERMZ", "...", denormalize_permz,
+                          denormalize_permz_batch);
+
+    field_trans_table_add(table, "NORMALIZE_PORO", "...", normalize_poro,
+                          normalize_poro_batch);
+    field_trans_table_add(table, "DENORMALIZE_PORO", "...", denormalize_poro,
+                          denormalize_poro_batch);
 
     table->case_sensitive = false;
     return table;
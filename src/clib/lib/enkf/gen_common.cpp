@@ -1,12 +1,119 @@
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <ert/enkf/gen_common.hpp>
 #include <ert/except.hpp>
+#include <ert/logging.hpp>
 
 namespace fs = std::filesystem;
 
+static auto logger = ert::get_logger("enkf");
+
 namespace {
+
+/**
+   Binary GEN_DATA result format - all fields native (little endian)
+   byte order, no padding:
+
+     int32   magic    GEN_DATA_BINARY_MAGIC ("GDB1")
+     int32   dtype    1 = 32 bit float, 2 = 64 bit double
+     int64   count    number of values
+     raw array of count values of dtype
+
+   The file size must be exactly header + count * sizeof(dtype); a
+   truncated or padded file is rejected. Like the ASCII format there
+   is no size information beyond the file itself - the loaded size is
+   verified against the other realizations by
+   gen_data_config_assert_size() in the calling scope.
+*/
+const int32_t GEN_DATA_BINARY_MAGIC = 0x47444231;
+const size_t GEN_DATA_BINARY_HEADER_SIZE =
+    2 * sizeof(int32_t) + sizeof(int64_t);
+
+/**
+   Validate and unpack a binary GEN_DATA record already sitting in
+   memory (a file mapping or a shared memory segment). On a malformed
+   record the returned vector is empty and error describes the
+   problem.
+*/
+std::vector<double> parse_binary_mapping(const char *data, size_t size,
+                                         std::string &error) {
+    int32_t dtype;
+    int64_t count;
+    std::memcpy(&dtype, data + sizeof(int32_t), sizeof dtype);
+    std::memcpy(&count, data + 2 * sizeof(int32_t), sizeof count);
+
+    std::vector<double> result;
+    size_t element_size = (dtype == 1) ? sizeof(float) : sizeof(double);
+    if (dtype != 1 && dtype != 2)
+        error = fmt::format("invalid dtype:{} - expected 1 (float) or 2 "
+                            "(double)",
+                            dtype);
+    else if (count < 0 ||
+             size != GEN_DATA_BINARY_HEADER_SIZE + count * element_size)
+        error = fmt::format("size {} does not match count:{} of dtype:{}",
+                            size, count, dtype);
+    else {
+        result.resize(count);
+        const char *values = data + GEN_DATA_BINARY_HEADER_SIZE;
+        if (dtype == 2)
+            std::memcpy(result.data(), values, count * sizeof(double));
+        else {
+            const float *float_values =
+                reinterpret_cast<const float *>(values);
+            std::copy(float_values, &float_values[count], result.begin());
+        }
+    }
+    return result;
+}
+
+bool has_binary_magic(const fs::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    int32_t magic = 0;
+    stream.read(reinterpret_cast<char *>(&magic), sizeof magic);
+    return stream.gcount() == sizeof magic && magic == GEN_DATA_BINARY_MAGIC;
+}
+
+std::vector<double> parse_binary(const fs::path &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw exc::runtime_error{"Could not open {} for reading", path};
+
+    struct stat st;
+    fstat(fd, &st);
+    size_t file_size = st.st_size;
+    if (file_size < GEN_DATA_BINARY_HEADER_SIZE) {
+        close(fd);
+        throw exc::runtime_error{"{} is too small to hold a binary GEN_DATA "
+                                 "header",
+                                 path};
+    }
+
+    /* The values are parsed straight out of the page cache instead of
+       going through stream IO - for the multi-million value vectors
+       this format is meant for, the load is then a single bulk copy. */
+    void *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw exc::runtime_error{"Could not memory map {}", path};
+
+    const char *data = static_cast<const char *>(mapping);
+    std::string error;
+    std::vector<double> result = parse_binary_mapping(data, file_size, error);
+    munmap(mapping, file_size);
+
+    if (!error.empty())
+        throw exc::runtime_error{"Could not load binary GEN_DATA from {}: {}",
+                                 path, error};
+    return result;
+}
+
 std::vector<double> parse_text(const fs::path &path) {
     std::ifstream stream{path};
     stream.imbue(std::locale::classic());
@@ -30,9 +137,106 @@ std::vector<double> parse_text(const fs::path &path) {
 std::vector<double>
 gen_common_fload_alloc(const fs::path &path,
                        gen_data_file_format_type load_format) {
+    if (load_format == GEN_DATA_BINARY)
+        return parse_binary(path);
     if (load_format == ASCII) {
+        /* Forward models can emit the binary format without any config
+           change - it is recognized by the leading magic bytes, which
+           no well formed ASCII number file starts with. */
+        if (has_binary_magic(path))
+            return parse_binary(path);
         return parse_text(path);
-    } else {
-        throw exc::runtime_error{"Invalid GEN data format: {}", load_format};
     }
+    throw exc::runtime_error{"Invalid GEN data format: {}", load_format};
+}
+
+/*
+  Shared-memory response handoff
+  ------------------------------
+
+  A forward model step running on the same machine can hand a GEN_DATA
+  response over through a named shared memory segment instead of the
+  runpath filesystem (see _ert_job_runner/response_channel.py for the
+  publishing side). The segment carries the same binary record as the
+  GEN_DATA_BINARY file format and is named from the result file the
+  response would otherwise have been written to:
+
+      /ert_resp_<FNV-1a 64 of the absolute result path, 16 hex digits>
+
+  Both sides compute the name independently, so no coordination beyond
+  the result filename (which the step already knows) is needed. The
+  segment is consumed - unlinked - by the load, also when its content
+  turns out to be malformed; a realization which is never loaded (e.g.
+  a failed one) leaves its segments behind until the machine reboots,
+  which is the same lifetime its runpath files would have had.
+
+  The name is predictable from the runpath alone, so on a shared
+  machine any user could plant a segment under it. A segment is
+  therefore only accepted when it is owned by the effective uid of
+  this process, and only when it is not older than the result file on
+  disk - a stale leftover segment from an earlier run must not shadow
+  a newer on-disk result.
+*/
+
+static std::string gen_common_shm_name(const fs::path &result_path) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char byte : fs::absolute(result_path).string()) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return fmt::format("/ert_resp_{:016x}", hash);
+}
+
+std::optional<std::vector<double>>
+gen_common_shm_fload(const fs::path &result_path) {
+    std::string name = gen_common_shm_name(result_path);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return std::nullopt;
+
+    struct stat st;
+    fstat(fd, &st);
+    size_t size = st.st_size;
+
+    if (st.st_uid != geteuid()) {
+        // Not our segment - leave it alone; unlinking it would
+        // fail anyway, and consuming it would let another user
+        // inject a response.
+        logger->warning("Ignoring shared memory segment {} owned by uid {}",
+                        name, st.st_uid);
+        close(fd);
+        return std::nullopt;
+    }
+
+    struct stat result_stat;
+    if (stat(result_path.c_str(), &result_stat) == 0 &&
+        (result_stat.st_mtim.tv_sec > st.st_mtim.tv_sec ||
+         (result_stat.st_mtim.tv_sec == st.st_mtim.tv_sec &&
+          result_stat.st_mtim.tv_nsec > st.st_mtim.tv_nsec))) {
+        // The on-disk result is newer than the segment; the segment is
+        // a stale leftover and is discarded in favor of the file.
+        close(fd);
+        shm_unlink(name.c_str());
+        return std::nullopt;
+    }
+
+    std::optional<std::vector<double>> result;
+    if (size >= GEN_DATA_BINARY_HEADER_SIZE) {
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const char *data = static_cast<const char *>(mapping);
+            int32_t magic;
+            std::memcpy(&magic, data, sizeof magic);
+            if (magic == GEN_DATA_BINARY_MAGIC) {
+                std::string error;
+                auto values = parse_binary_mapping(data, size, error);
+                if (error.empty())
+                    result = std::move(values);
+            }
+            munmap(mapping, size);
+        }
+    }
+    close(fd);
+    shm_unlink(name.c_str());
+    return result;
 }
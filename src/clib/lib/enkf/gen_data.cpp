@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <stdio.h>
@@ -99,6 +101,52 @@ void gen_data_free(gen_data_type *gen_data) {
     free(gen_data);
 }
 
+/**
+   Sparse storage of partially active vectors
+   ------------------------------------------
+
+   Dynamic gen_data vectors where the forward model has deactivated
+   most of the elements (sparse seismic QC responses are typically
+   5-10% active) are stored sparse: a run length encoding of the
+   active mask followed by a compressed blob holding only the active
+   values. The encoding is selected per node from the active density
+   at write time; vectors at or above GEN_DATA_SPARSE_THRESHOLD keep
+   the legacy dense layout.
+
+   The legacy layout stored the (unused) report step after the size
+   field; the sparse layout marks itself by storing the bitwise
+   complement ~report_step - always negative - in that slot, so dense
+   nodes written by older versions load unchanged.
+*/
+#define GEN_DATA_SPARSE_THRESHOLD 0.50
+
+/**
+   The run length encoding of the active mask: runs alternate between
+   active and inactive elements, starting with an active run (which
+   has length zero when the vector starts inactive).
+*/
+static std::vector<int> gen_data_alloc_active_runs(
+    const bool_vector_type *active_mask, int size, int *active_count) {
+    std::vector<int> runs;
+    bool run_active = true;
+    int run_length = 0;
+    *active_count = 0;
+    for (int index = 0; index < size; index++) {
+        bool active = bool_vector_safe_iget(active_mask, index);
+        if (active)
+            (*active_count)++;
+        if (active == run_active)
+            run_length++;
+        else {
+            runs.push_back(run_length);
+            run_active = active;
+            run_length = 1;
+        }
+    }
+    runs.push_back(run_length);
+    return runs;
+}
+
 /**
    Observe that this function writes parameter size to disk, that is
    special. The reason is that the config object does not know the
@@ -120,20 +168,47 @@ C_USED bool gen_data_write_to_buffer(const gen_data_type *gen_data,
         if (size > 0)
             write = true;
 
-        if (write) {
-            size_t byte_size =
-                gen_data_config_get_data_size(gen_data->config, report_step) *
-                sizeof(double);
-            buffer_fwrite_int(buffer, GEN_DATA);
-            buffer_fwrite_int(buffer, size);
+        if (!write)
+            return false; /* When false is returned - the (empty) file will be removed */
+
+        /* The active mask is only trusted when it belongs to this
+           node and report step, i.e. right after a forward load; a
+           node which has merely passed through storage has an empty
+           (all true) mask and takes the dense path. */
+        int active_count = size;
+        std::vector<int> runs;
+        if (gen_data_config_is_dynamic(gen_data->config) && size > 0 &&
+            report_step == gen_data->current_report_step &&
+            bool_vector_size(gen_data->active_mask) == size)
+            runs = gen_data_alloc_active_runs(gen_data->active_mask, size,
+                                              &active_count);
+
+        buffer_fwrite_int(buffer, GEN_DATA);
+        buffer_fwrite_int(buffer, size);
+        if (active_count >= size * GEN_DATA_SPARSE_THRESHOLD) {
             buffer_fwrite_int(
                 buffer,
                 report_step); /* Why the heck do I need to store this ????  It was a mistake ...*/
-
-            buffer_fwrite_compressed(buffer, gen_data->data, byte_size);
-            return true;
-        } else
-            return false; /* When false is returned - the (empty) file will be removed */
+            buffer_fwrite_compressed(buffer, gen_data->data,
+                                     size * sizeof(double));
+        } else {
+            buffer_fwrite_int(buffer, ~report_step);
+            buffer_fwrite_int(buffer, active_count);
+            buffer_fwrite_int(buffer, (int)runs.size());
+            buffer_fwrite(buffer, runs.data(), sizeof(int), runs.size());
+
+            const double *data = (const double *)gen_data->data;
+            /* Sized one extra so the data() pointer stays valid for
+               the (legal) fully inactive vector. */
+            std::vector<double> packed(active_count + 1);
+            int target = 0;
+            for (int index = 0; index < size; index++)
+                if (bool_vector_iget(gen_data->active_mask, index))
+                    packed[target++] = data[index];
+            buffer_fwrite_compressed(buffer, packed.data(),
+                                     active_count * sizeof(double));
+        }
+        return true;
     }
 }
 
@@ -143,14 +218,59 @@ C_USED void gen_data_read_from_buffer(gen_data_type *gen_data,
     int size;
     enkf_util_assert_buffer_type(buffer, GEN_DATA);
     size = buffer_fread_int(buffer);
-    buffer_fskip_int(
-        buffer); /* Skipping report_step from the buffer - was a mistake to store it - I think ... */
+    /* The legacy dense layout stored the (unused) report step here; a
+       negative value marks the sparse encoding - see the doc comment
+       above gen_data_write_to_buffer(). */
+    int step_field = buffer_fread_int(buffer);
     {
         size_t byte_size = size * sizeof(double);
-        size_t compressed_size = buffer_get_remaining_size(buffer);
         gen_data->data = (char *)util_realloc(gen_data->data, byte_size);
-        buffer_fread_compressed(buffer, compressed_size, gen_data->data,
-                                byte_size);
+        if (step_field >= 0) {
+            size_t compressed_size = buffer_get_remaining_size(buffer);
+            buffer_fread_compressed(buffer, compressed_size, gen_data->data,
+                                    byte_size);
+        } else {
+            int active_count = buffer_fread_int(buffer);
+            int run_count = buffer_fread_int(buffer);
+            if (active_count < 0 || active_count > size || run_count < 1 ||
+                run_count > size + 1)
+                util_abort("%s: invalid sparse gen_data node for:%s - "
+                           "active:%d runs:%d size:%d \n",
+                           __func__, gen_data_get_key(gen_data), active_count,
+                           run_count, size);
+
+            std::vector<int> runs(run_count);
+            buffer_fread(buffer, runs.data(), sizeof(int), run_count);
+
+            std::vector<double> packed(active_count + 1);
+            buffer_fread_compressed(buffer, buffer_get_remaining_size(buffer),
+                                    packed.data(),
+                                    active_count * sizeof(double));
+
+            /* Scatter the active values directly into the dense
+               layout; inactive elements are zero filled. */
+            double *data = (double *)gen_data->data;
+            bool run_active = true;
+            int index = 0;
+            int source = 0;
+            for (int run = 0; run < run_count; run++) {
+                int run_length = runs[run];
+                if (run_length < 0 || index + run_length > size)
+                    break;
+                if (run_active) {
+                    memcpy(&data[index], &packed[source],
+                           run_length * sizeof(double));
+                    source += run_length;
+                } else
+                    std::fill(&data[index], &data[index + run_length], 0.0);
+                index += run_length;
+                run_active = !run_active;
+            }
+            if (index != size || source != active_count)
+                util_abort("%s: corrupt sparse gen_data node for:%s - "
+                           "covered %d of %d elements \n",
+                           __func__, gen_data_get_key(gen_data), index, size);
+        }
     }
     gen_data_assert_size(gen_data, size, report_step);
 
@@ -193,6 +313,7 @@ static void gen_data_set_data__(gen_data_type *gen_data, int size,
     if (gen_data_config_is_dynamic(gen_data->config))
         gen_data_config_update_active(gen_data->config, report_step,
                                       gen_data->active_mask, sim_fs);
+    gen_data_config_fwrite_data_size(gen_data->config, sim_fs, report_step);
 
     gen_data_realloc_data(gen_data);
 
@@ -273,6 +394,23 @@ static bool gen_data_fload_active__(gen_data_type *gen_data,
 */
 bool gen_data_forward_load(gen_data_type *gen_data, const char *filename,
                            int report_step, enkf_fs_type *fs) {
+    // A locally run forward model may have handed the response over
+    // through a shared memory segment instead of the runpath
+    // filesystem; the segment is consumed first and the file is only
+    // consulted when nothing was published.
+    if (auto shm = gen_common_shm_fload(filename)) {
+        logger->info("GEN_DATA({}): loading from shared memory channel "
+                     "for: {}   size:{}",
+                     gen_data_get_key(gen_data), filename, shm->size());
+        if (shm->size() > 0)
+            gen_data_fload_active__(gen_data, filename, shm->size());
+        else
+            bool_vector_reset(gen_data->active_mask);
+        gen_data_set_data__(gen_data, shm->size(), report_step, shm->data(),
+                            fs);
+        return true;
+    }
+
     bool file_exists = fs::exists(filename);
     if (file_exists) {
         gen_data_file_format_type input_format =
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #include <ert/ecl/ecl_util.h>
 #include <ert/logging.hpp>
@@ -15,6 +16,7 @@
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/gen_data_config.hpp>
+#include <ert/res_util/string.hpp>
 
 static auto logger = ert::get_logger("enkf");
 
@@ -30,13 +32,19 @@ static auto logger = ert::get_logger("enkf");
 */
 
 struct gen_data_config_struct {
-    /** The key this gen_data instance is known under - needed for debugging. */
-    char *key;
+    /** The key this gen_data instance is known under - needed for debugging.
+        Interned - owned by the ert::intern() pool, never freed here. */
+    const char *key;
     /** The format used for loading gen_data instances when the forward model
      * has completed *AND* for loading the initial files.*/
     gen_data_file_format_type input_format;
     /** Data size, i.e. number of elements , indexed with report_step */
     int_vector_type *data_size_vector;
+    /** Report steps whose data size has been persisted as case
+        metadata ("<KEY>_size" tstep files), so the update pipeline can
+        learn the dimensions without loading a data node. */
+    int_vector_type *size_persisted;
+    enkf_fs_type *last_size_fs;
     /** The report steps where we expect to load data for this instance. */
     int_vector_type *active_report_steps;
     pthread_mutex_t update_lock;
@@ -90,11 +98,13 @@ static gen_data_config_type *gen_data_config_alloc(const char *key,
     gen_data_config_type *config =
         (gen_data_config_type *)util_malloc(sizeof *config);
 
-    config->key = util_alloc_string_copy(key);
+    config->key = ert::intern(key);
 
     config->input_format = GEN_DATA_UNDEFINED;
     config->data_size_vector = int_vector_alloc(
         0, -1); /* The default value: -1 - indicates "NOT SET" */
+    config->size_persisted = int_vector_alloc(0, 0);
+    config->last_size_fs = NULL;
     config->active_report_steps = int_vector_alloc(0, 0);
     config->active_mask = bool_vector_alloc(
         0,
@@ -160,6 +170,8 @@ gen_data_config_check_format(const char *format_string) {
             type = ASCII;
         else if (strcmp(format_string, "ASCII_TEMPLATE") == 0)
             type = ASCII_TEMPLATE;
+        else if (strcmp(format_string, "BINARY") == 0)
+            type = GEN_DATA_BINARY;
     }
 
     return type;
@@ -174,9 +186,9 @@ gen_data_config_check_format(const char *format_string) {
 */
 void gen_data_config_free(gen_data_config_type *config) {
     int_vector_free(config->data_size_vector);
+    int_vector_free(config->size_persisted);
     int_vector_free(config->active_report_steps);
 
-    free(config->key);
     bool_vector_free(config->active_mask);
 
     free(config);
@@ -215,6 +227,140 @@ void gen_data_config_assert_size(gen_data_config_type *config, int data_size,
     pthread_mutex_unlock(&config->update_lock);
 }
 
+/**
+   Persist the data size of @report_step as case metadata (a
+   "<KEY>_size" tstep file alongside the "<KEY>_active" mask), so a
+   later mount can learn the dimension without loading a data node.
+   Writes once per (fs, report_step).
+*/
+void gen_data_config_fwrite_data_size(gen_data_config_type *config,
+                                      enkf_fs_type *fs, int report_step) {
+    pthread_mutex_lock(&config->update_lock);
+    {
+        if (fs != config->last_size_fs) {
+            config->last_size_fs = fs;
+            int_vector_reset(config->size_persisted);
+        }
+
+        int data_size =
+            int_vector_safe_iget(config->data_size_vector, report_step);
+        if (data_size >= 0 &&
+            int_vector_safe_iget(config->size_persisted, report_step) == 0) {
+            char *filename = util_alloc_sprintf("%s_size", config->key);
+            FILE *stream =
+                enkf_fs_open_case_tstep_file(fs, filename, report_step, "w");
+            free(filename);
+
+            util_fwrite_int(data_size, stream);
+            fclose(stream);
+            int_vector_iset(config->size_persisted, report_step, 1);
+        }
+    }
+    pthread_mutex_unlock(&config->update_lock);
+}
+
+/**
+   Storage backed fast path for the data size: if the size of
+   @report_step is not already known, try to read it from the case
+   metadata written by gen_data_config_fwrite_data_size(). Returns
+   true if the size is known after the call. Cases written before the
+   sizes were persisted return false, and the caller must fall back to
+   loading a data node.
+*/
+bool gen_data_config_fload_data_size(gen_data_config_type *config,
+                                     enkf_fs_type *fs, int report_step) {
+    if (int_vector_safe_iget(config->data_size_vector, report_step) >= 0)
+        return true;
+
+    char *filename = util_alloc_sprintf("%s_size", config->key);
+    FILE *stream = enkf_fs_open_excase_tstep_file(fs, filename, report_step);
+    free(filename);
+    if (stream == NULL)
+        return false;
+
+    int data_size = util_fread_int(stream);
+    fclose(stream);
+    gen_data_config_assert_size(config, data_size, report_step);
+    return true;
+}
+
+/**
+   The "<KEY>_active" tstep files are written run length encoded when
+   that is smaller than the dense bool_vector_fwrite() layout, which
+   it is for the sparse masks the forward model creates for e.g.
+   seismic QC responses. The RLE layout is marked by a leading
+   negative magic int; the dense layout starts with the (non
+   negative) size field, so masks written by older versions load
+   unchanged. Runs alternate between active and inactive elements,
+   starting with an active run of length zero when the mask starts
+   inactive.
+*/
+#define GEN_DATA_ACTIVE_RLE_MAGIC (-0x524C4531)
+
+static void gen_data_config_fwrite_active_mask(const bool_vector_type *mask,
+                                               FILE *stream) {
+    int size = bool_vector_size(mask);
+    std::vector<int> runs;
+    bool run_active = true;
+    int run_length = 0;
+    for (int index = 0; index < size; index++) {
+        bool active = bool_vector_iget(mask, index);
+        if (active == run_active)
+            run_length++;
+        else {
+            runs.push_back(run_length);
+            run_active = active;
+            run_length = 1;
+        }
+    }
+    runs.push_back(run_length);
+
+    /* The dense layout costs ~ one byte per element plus a small
+       header; RLE costs three ints plus one int per run. */
+    if ((3 + runs.size()) * sizeof(int) < (size_t)size) {
+        util_fwrite_int(GEN_DATA_ACTIVE_RLE_MAGIC, stream);
+        util_fwrite_int(size, stream);
+        util_fwrite_int((int)runs.size(), stream);
+        util_fwrite(runs.data(), sizeof(int), runs.size(), stream, __func__);
+    } else
+        bool_vector_fwrite(mask, stream);
+}
+
+static void gen_data_config_fread_active_mask(bool_vector_type *mask,
+                                              FILE *stream) {
+    long start_pos = util_ftell(stream);
+    int first = util_fread_int(stream);
+    if (first != GEN_DATA_ACTIVE_RLE_MAGIC) {
+        util_fseek(stream, start_pos, SEEK_SET);
+        bool_vector_fread(mask, stream);
+        return;
+    }
+
+    int size = util_fread_int(stream);
+    int run_count = util_fread_int(stream);
+    if (size < 0 || run_count < 1 || run_count > size + 1)
+        util_abort("%s: corrupt RLE active mask - size:%d runs:%d \n", __func__,
+                   size, run_count);
+
+    std::vector<int> runs(run_count);
+    util_fread(runs.data(), sizeof(int), run_count, stream, __func__);
+
+    bool_vector_reset(mask);
+    bool run_active = true;
+    int index = 0;
+    for (int run = 0; run < run_count; run++) {
+        int run_length = runs[run];
+        if (run_length < 0 || index + run_length > size)
+            break;
+        for (int i = 0; i < run_length; i++)
+            bool_vector_iset(mask, index++, run_active);
+        run_active = !run_active;
+    }
+    if (index != size)
+        util_abort("%s: corrupt RLE active mask - covered %d of %d elements \n",
+                   __func__, index, size);
+}
+
 static void update_config_to_datamask(gen_data_config_type *config,
                                       const bool_vector_type *data_mask,
                                       int report_step, enkf_fs_type *sim_fs) {
@@ -245,7 +391,7 @@ static void update_config_to_datamask(gen_data_config_type *config,
         enkf_fs_open_case_tstep_file(sim_fs, filename, report_step, "w");
     free(filename);
 
-    bool_vector_fwrite(config->active_mask, stream);
+    gen_data_config_fwrite_active_mask(config->active_mask, stream);
     fclose(stream);
     config->mask_modified = false;
 }
@@ -309,7 +455,7 @@ void gen_data_config_load_active(gen_data_config_type *config, enkf_fs_type *fs,
                 enkf_fs_open_excase_tstep_file(fs, filename, report_step);
 
             if (stream != NULL) {
-                bool_vector_fread(config->active_mask, stream);
+                gen_data_config_fread_active_mask(config->active_mask, stream);
                 fclose(stream);
             } else {
                 int gen_data_size =
@@ -425,6 +571,8 @@ gen_data_config_format_name(gen_data_file_format_type format_type) {
         return "ASCII";
     case ASCII_TEMPLATE:
         return "ASCII_TEMPLATE";
+    case GEN_DATA_BINARY:
+        return "BINARY";
     default:
         util_abort("%s: What the f.. \n", __func__);
         return NULL;
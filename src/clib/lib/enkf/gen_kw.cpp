@@ -4,9 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #include <ert/enkf/enkf_node.hpp>
-#include <ert/res_util/subst_list.hpp>
 #include <ert/util/buffer.h>
 #include <ert/util/util.h>
 
@@ -23,19 +23,16 @@ GET_DATA_SIZE_HEADER(gen_kw);
 struct gen_kw_struct {
     const gen_kw_config_type *config;
     double *data;
-    subst_list_type *subst_list;
 };
 
 void gen_kw_free(gen_kw_type *gen_kw) {
     free(gen_kw->data);
-    subst_list_free(gen_kw->subst_list);
     free(gen_kw);
 }
 
 extern "C" PY_USED gen_kw_type *gen_kw_alloc(const gen_kw_config_type *config) {
     gen_kw_type *gen_kw = (gen_kw_type *)util_malloc(sizeof *gen_kw);
     gen_kw->config = config;
-    gen_kw->subst_list = subst_list_alloc();
     gen_kw->data = (double *)util_calloc(gen_kw_config_get_data_size(config),
                                          sizeof *gen_kw->data);
     return gen_kw;
@@ -160,32 +157,23 @@ void gen_kw_deserialize(gen_kw_type *gen_kw, node_id_type node_id,
 }
 
 void gen_kw_filter_file(const gen_kw_type *gen_kw, const char *target_file) {
-    const char *template_file = gen_kw_config_get_template_file(gen_kw->config);
-    if (template_file != NULL) {
-        const int size = gen_kw_config_get_data_size(gen_kw->config);
-        int ikw;
-
-        for (ikw = 0; ikw < size; ikw++) {
-            const char *key =
-                gen_kw_config_get_tagged_name(gen_kw->config, ikw);
-            subst_list_append_owned_ref(
-                gen_kw->subst_list, key,
-                util_alloc_sprintf("%g",
-                                   gen_kw_config_transform(gen_kw->config, ikw,
-                                                           gen_kw->data[ikw])));
-        }
+    const int size = gen_kw_config_get_data_size(gen_kw->config);
+    std::vector<double> transformed(size);
+
+    gen_kw_config_transform_vector(gen_kw->config, gen_kw->data,
+                                   transformed.data(), size);
 
-        /*
+    /*
       If the target_file already exists as a symbolic link the
       symbolic link is removed before creating the target file. The is
       to ensure against existing symlinks pointing to a common file
       outside the realization root.
     */
-        if (util_is_link(target_file))
-            remove(target_file);
+    if (util_is_link(target_file))
+        remove(target_file);
 
-        subst_list_filter_file(gen_kw->subst_list, template_file, target_file);
-    } else
+    if (!gen_kw_config_render_template(gen_kw->config, transformed.data(),
+                                       target_file))
         util_abort("%s: internal error - tried to filter gen_kw instance "
                    "without template file.\n",
                    __func__);
@@ -206,13 +194,15 @@ VOID_CLEAR(gen_kw)
 namespace {
 void gen_kw_export_values(const gen_kw_type *gen_kw, py::dict exports) {
     auto size = gen_kw_config_get_data_size(gen_kw->config);
+    std::vector<double> transformed(size);
+    gen_kw_config_transform_vector(gen_kw->config, gen_kw->data,
+                                   transformed.data(), size);
 
     for (int ikw{}; ikw < size; ++ikw) {
         auto key = gen_kw_config_get_key(gen_kw->config);
         auto parameter = gen_kw_config_iget_name(gen_kw->config, ikw);
 
-        auto value =
-            gen_kw_config_transform(gen_kw->config, ikw, gen_kw->data[ikw]);
+        auto value = transformed[ikw];
 
         if (!exports.contains(key))
             exports[key] = py::dict{};
@@ -1,5 +1,8 @@
 #include <filesystem>
+#include <string>
+#include <vector>
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -15,23 +18,51 @@
 #include <ert/enkf/gen_kw_common.hpp>
 #include <ert/enkf/gen_kw_config.hpp>
 #include <ert/enkf/trans_func.hpp>
+#include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/string.hpp>
 
 namespace fs = std::filesystem;
 
 typedef struct {
-    char *name;
+    /** Interned - owned by the ert::intern() pool, never freed here. */
+    const char *name;
     char *tagged_name;
     trans_func_type *trans_func;
 } gen_kw_parameter_type;
 
+/**
+   The template file compiled to a sequence of segments: each segment
+   is a literal span followed (when param_index >= 0) by a slot for
+   one parameter value. Rendering a realization streams the literals
+   and formats the member's values into the slots - the template is
+   parsed once per key instead of once per (key, realization) pair.
+*/
+struct gen_kw_compiled_template {
+    struct segment_type {
+        std::string literal;
+        int param_index;
+    };
+    std::vector<segment_type> segments;
+};
+
 struct gen_kw_config_struct {
-    char *key;
-    /** Vector of gen_kw_parameter_type instances. */
+    /** Interned - owned by the ert::intern() pool, never freed here. */
+    const char *key;
+    /** Vector of gen_kw_parameter_type instances. Parsed lazily from
+     * parameter_file on first access - configuration load only
+     * validates that the file exists, so CLI operations touching a
+     * handful of keys do not pay for parsing every parameter file. */
     vector_type *parameters;
+    bool parameters_parsed;
+    pthread_mutex_t parse_mutex;
     char *template_file;
     char *parameter_file;
     /** Pointer to the tag_format owned by the ensemble config object. */
     const char *tag_fmt;
+    /** Compiled lazily from template_file on the first render, under
+        parse_mutex; dropped whenever the template, the parameter file
+        or the tag format changes. */
+    gen_kw_compiled_template *compiled_template;
 };
 
 static void
@@ -46,7 +77,7 @@ static gen_kw_parameter_type *gen_kw_parameter_alloc(const char *parameter_name,
                                                      const char *tag_fmt) {
     gen_kw_parameter_type *parameter =
         (gen_kw_parameter_type *)util_malloc(sizeof *parameter);
-    parameter->name = util_alloc_string_copy(parameter_name);
+    parameter->name = ert::intern(parameter_name);
     parameter->tagged_name = NULL;
     parameter->trans_func = NULL;
     gen_kw_parameter_update_tagged_name(parameter, tag_fmt);
@@ -54,7 +85,6 @@ static gen_kw_parameter_type *gen_kw_parameter_alloc(const char *parameter_name,
 }
 
 static void gen_kw_parameter_free(gen_kw_parameter_type *parameter) {
-    free(parameter->name);
     free(parameter->tagged_name);
     if (parameter->trans_func != NULL)
         trans_func_free(parameter->trans_func);
@@ -73,10 +103,104 @@ static void gen_kw_parameter_set_trans_func(gen_kw_parameter_type *parameter,
     parameter->trans_func = trans_func;
 }
 
+static void gen_kw_config_assert_parameters(const gen_kw_config_type *config);
+
 const char *gen_kw_config_get_template_file(const gen_kw_config_type *config) {
     return config->template_file;
 }
 
+static void gen_kw_config_drop_template(gen_kw_config_type *config) {
+    delete config->compiled_template;
+    config->compiled_template = NULL;
+}
+
+/**
+   Split the template content into literal/slot segments. The scan
+   mirrors the one-pass substitution semantics of
+   subst_list_filter_file(): the earliest tagged name wins, with ties
+   broken towards the lowest parameter index, and the scan continues
+   after the consumed tag.
+*/
+static void gen_kw_config_compile_template(gen_kw_config_type *config) {
+    int content_size;
+    char *content_buffer =
+        util_fread_alloc_file_content(config->template_file, &content_size);
+    std::string content(content_buffer, content_size);
+    free(content_buffer);
+
+    const int size = vector_get_size(config->parameters);
+    auto *compiled = new gen_kw_compiled_template;
+
+    size_t cursor = 0;
+    while (cursor < content.size()) {
+        size_t match_pos = std::string::npos;
+        size_t match_length = 0;
+        int match_index = -1;
+        for (int i = 0; i < size; i++) {
+            const gen_kw_parameter_type *parameter =
+                (const gen_kw_parameter_type *)vector_iget_const(
+                    config->parameters, i);
+            if (parameter->tagged_name == NULL)
+                continue;
+            size_t pos = content.find(parameter->tagged_name, cursor);
+            if (pos < match_pos) {
+                match_pos = pos;
+                match_length = strlen(parameter->tagged_name);
+                match_index = i;
+            }
+        }
+        if (match_index < 0)
+            break;
+
+        compiled->segments.push_back(
+            {content.substr(cursor, match_pos - cursor), match_index});
+        cursor = match_pos + match_length;
+    }
+    compiled->segments.push_back({content.substr(cursor), -1});
+
+    config->compiled_template = compiled;
+}
+
+/** Compile the template on first render; safe to call from
+    concurrent readers. */
+static void
+gen_kw_config_assert_template(const gen_kw_config_type *config) {
+    if (config->compiled_template != NULL)
+        return;
+
+    auto mutable_config = const_cast<gen_kw_config_type *>(config);
+    pthread_mutex_lock(&mutable_config->parse_mutex);
+    if (mutable_config->compiled_template == NULL)
+        gen_kw_config_compile_template(mutable_config);
+    pthread_mutex_unlock(&mutable_config->parse_mutex);
+}
+
+/**
+   Write one realization's parameter file by streaming the compiled
+   template with @values (already transformed, data_size of them)
+   formatted into the slots. Returns false when the config has no
+   template file.
+*/
+bool gen_kw_config_render_template(const gen_kw_config_type *config,
+                                   const double *values,
+                                   const char *target_file) {
+    if (config->template_file == NULL)
+        return false;
+
+    gen_kw_config_assert_parameters(config);
+    gen_kw_config_assert_template(config);
+
+    auto stream = mkdir_fopen(fs::path(target_file), "w");
+    for (const auto &segment : config->compiled_template->segments) {
+        if (!segment.literal.empty())
+            fwrite(segment.literal.data(), 1, segment.literal.size(), stream);
+        if (segment.param_index >= 0)
+            fprintf(stream, "%g", values[segment.param_index]);
+    }
+    fclose(stream);
+    return true;
+}
+
 /**
   The input template file must point to an existing file.
 */
@@ -90,39 +214,66 @@ void gen_kw_config_set_template_file(gen_kw_config_type *config,
 
     config->template_file =
         util_realloc_string_copy(config->template_file, template_file);
+    gen_kw_config_drop_template(config);
 }
 
+/** The input parameter file must point to an existing file; it is
+    only parsed on first access to the parameters. */
 void gen_kw_config_set_parameter_file(gen_kw_config_type *config,
                                       const char *parameter_file) {
+    if (parameter_file != NULL) {
+        if (!fs::exists(parameter_file))
+            util_abort("%s: the parameter_file:%s does not exist - aborting.\n",
+                       __func__, parameter_file);
+    }
+
     config->parameter_file =
         util_realloc_string_copy(config->parameter_file, parameter_file);
     vector_clear(config->parameters);
-    if (parameter_file != NULL) {
-        config_parser_type *parser = config_alloc();
-        config_content_type *content =
-            config_parse(parser, parameter_file, "--", NULL, NULL, NULL,
-                         CONFIG_UNRECOGNIZED_ADD, false);
-        for (int item_index = 0; item_index < config_content_get_size(content);
-             item_index++) {
-            const config_content_node_type *node =
-                config_content_iget_node(content, item_index);
-            const char *parameter_name = config_content_node_get_kw(node);
-            gen_kw_parameter_type *parameter =
-                gen_kw_parameter_alloc(parameter_name, config->tag_fmt);
-            trans_func_type *trans_func =
-                trans_func_alloc(config_content_node_get_stringlist(node));
-            if (trans_func) {
-                gen_kw_parameter_set_trans_func(parameter, trans_func);
-                vector_append_owned_ref(config->parameters, parameter,
-                                        gen_kw_parameter_free__);
-            } else
-                util_abort(
-                    "%s: failed to create tranformation function for %s\n",
-                    __func__, parameter_name);
-        }
-        config_content_free(content);
-        config_free(parser);
+    config->parameters_parsed = (parameter_file == NULL);
+    /* The slots map to parameter indices - recompile for the new set. */
+    gen_kw_config_drop_template(config);
+}
+
+static void gen_kw_config_parse_parameter_file(gen_kw_config_type *config) {
+    config_parser_type *parser = config_alloc();
+    config_content_type *content =
+        config_parse(parser, config->parameter_file, "--", NULL, NULL, NULL,
+                     CONFIG_UNRECOGNIZED_ADD, false);
+    for (int item_index = 0; item_index < config_content_get_size(content);
+         item_index++) {
+        const config_content_node_type *node =
+            config_content_iget_node(content, item_index);
+        const char *parameter_name = config_content_node_get_kw(node);
+        gen_kw_parameter_type *parameter =
+            gen_kw_parameter_alloc(parameter_name, config->tag_fmt);
+        trans_func_type *trans_func =
+            trans_func_alloc(config_content_node_get_stringlist(node));
+        if (trans_func) {
+            gen_kw_parameter_set_trans_func(parameter, trans_func);
+            vector_append_owned_ref(config->parameters, parameter,
+                                    gen_kw_parameter_free__);
+        } else
+            util_abort("%s: failed to create tranformation function for %s\n",
+                       __func__, parameter_name);
     }
+    config_content_free(content);
+    config_free(parser);
+}
+
+/** Parse the parameter file on first access to the parameters; safe
+    to call from concurrent readers. */
+static void gen_kw_config_assert_parameters(const gen_kw_config_type *config) {
+    if (config->parameters_parsed)
+        return;
+
+    auto mutable_config = const_cast<gen_kw_config_type *>(config);
+    pthread_mutex_lock(&mutable_config->parse_mutex);
+    if (!mutable_config->parameters_parsed) {
+        gen_kw_config_parse_parameter_file(mutable_config);
+        mutable_config->parameters_parsed = true;
+    }
+    pthread_mutex_unlock(&mutable_config->parse_mutex);
 }
 
 const char *gen_kw_config_get_parameter_file(const gen_kw_config_type *config) {
@@ -160,8 +311,11 @@ gen_kw_config_type *gen_kw_config_alloc_empty(const char *key,
     gen_kw_config->template_file = NULL;
     gen_kw_config->parameter_file = NULL;
     gen_kw_config->parameters = vector_alloc_new();
+    gen_kw_config->parameters_parsed = true;
+    pthread_mutex_init(&gen_kw_config->parse_mutex, NULL);
+    gen_kw_config->compiled_template = NULL;
     gen_kw_config->tag_fmt = tag_fmt;
-    gen_kw_config->key = util_alloc_string_copy(key);
+    gen_kw_config->key = ert::intern(key);
 
     return gen_kw_config;
 }
@@ -174,14 +328,43 @@ void gen_kw_config_update(gen_kw_config_type *config, const char *template_file,
 
 double gen_kw_config_transform(const gen_kw_config_type *config, int index,
                                double x) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
                                                          index);
     return trans_func_eval(parameter->trans_func, x);
 }
 
+/**
+   Transform a full parameter vector in one call. Maximal runs of
+   parameters sharing a trans_func instance are handed to one
+   trans_func_apply_batch() call, which unpacks the distribution
+   parameters once and runs a vectorizable loop over the values.
+*/
+void gen_kw_config_transform_vector(const gen_kw_config_type *config,
+                                    const double *in, double *out, int size) {
+    gen_kw_config_assert_parameters(config);
+    int index = 0;
+    while (index < size) {
+        const gen_kw_parameter_type *parameter =
+            (const gen_kw_parameter_type *)vector_iget_const(
+                config->parameters, index);
+        int run_end = index + 1;
+        while (run_end < size &&
+               ((const gen_kw_parameter_type *)vector_iget_const(
+                    config->parameters, run_end))
+                       ->trans_func == parameter->trans_func)
+            run_end++;
+
+        trans_func_apply_batch(parameter->trans_func, &in[index], &out[index],
+                               run_end - index);
+        index = run_end;
+    }
+}
+
 bool gen_kw_config_should_use_log_scale(const gen_kw_config_type *config,
                                         int index) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
                                                          index);
@@ -189,15 +372,17 @@ bool gen_kw_config_should_use_log_scale(const gen_kw_config_type *config,
 }
 
 void gen_kw_config_free(gen_kw_config_type *gen_kw_config) {
-    free(gen_kw_config->key);
+    gen_kw_config_drop_template(gen_kw_config);
     free(gen_kw_config->template_file);
     free(gen_kw_config->parameter_file);
 
     vector_free(gen_kw_config->parameters);
+    pthread_mutex_destroy(&gen_kw_config->parse_mutex);
     free(gen_kw_config);
 }
 
 int gen_kw_config_get_data_size(const gen_kw_config_type *gen_kw_config) {
+    gen_kw_config_assert_parameters(gen_kw_config);
     return vector_get_size(gen_kw_config->parameters);
 }
 
@@ -211,6 +396,7 @@ const char *gen_kw_config_get_tag_fmt(const gen_kw_config_type *config) {
 
 const char *gen_kw_config_iget_name(const gen_kw_config_type *config,
                                     int kw_nr) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget(config->parameters, kw_nr);
     return parameter->name;
@@ -218,6 +404,7 @@ const char *gen_kw_config_iget_name(const gen_kw_config_type *config,
 
 const char *gen_kw_config_get_tagged_name(const gen_kw_config_type *config,
                                           int kw_nr) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget(config->parameters, kw_nr);
     return parameter->tagged_name;
@@ -228,6 +415,11 @@ void gen_kw_config_update_tag_format(gen_kw_config_type *config,
     int i;
 
     config->tag_fmt = tag_format;
+    gen_kw_config_drop_template(config);
+    /* A deferred parse picks up the new tag format by itself - do not
+       force the parse just to retag. */
+    if (!config->parameters_parsed)
+        return;
     for (i = 0; i < vector_get_size(config->parameters); i++)
         gen_kw_parameter_update_tagged_name(
             (gen_kw_parameter_type *)vector_iget(config->parameters, i),
@@ -237,6 +429,7 @@ void gen_kw_config_update_tag_format(gen_kw_config_type *config,
 stringlist_type *
 gen_kw_config_alloc_name_list(const gen_kw_config_type *config) {
 
+    gen_kw_config_assert_parameters(config);
     stringlist_type *name_list = stringlist_alloc_new();
     int i;
     for (i = 0; i < vector_get_size(config->parameters); i++) {
@@ -285,6 +478,7 @@ void gen_kw_config_fprintf_config(const gen_kw_config_type *config,
 
 const char *gen_kw_config_iget_function_type(const gen_kw_config_type *config,
                                              int index) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
                                                          index);
@@ -294,6 +488,7 @@ const char *gen_kw_config_iget_function_type(const gen_kw_config_type *config,
 stringlist_type *
 gen_kw_config_iget_function_parameter_names(const gen_kw_config_type *config,
                                             int index) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
                                                          index);
@@ -303,6 +498,7 @@ gen_kw_config_iget_function_parameter_names(const gen_kw_config_type *config,
 double_vector_type *
 gen_kw_config_iget_function_parameter_values(const gen_kw_config_type *config,
                                              int index) {
+    gen_kw_config_assert_parameters(config);
     const gen_kw_parameter_type *parameter =
         (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
                                                          index);
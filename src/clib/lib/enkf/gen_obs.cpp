@@ -3,9 +3,11 @@
    enkf_obs.c
 */
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
+#include <ert/util/buffer.h>
 #include <ert/util/string_util.h>
 #include <ert/util/util.h>
 
@@ -162,7 +164,9 @@ gen_obs_type *gen_obs_alloc__(const gen_data_config_type *data_config,
     obs->obs_data = NULL;
     obs->obs_std = NULL;
     obs->std_scaling = NULL;
-    obs->obs_format = ASCII; /* Hardcoded for now. */
+    /* Binary observation files are still accepted - gen_common
+       recognizes the GEN_DATA binary format from the magic bytes. */
+    obs->obs_format = ASCII;
     obs->obs_key = util_alloc_string_copy(obs_key);
     obs->data_config =
         (gen_data_config_type *)data_config; // casting away the const ...
@@ -170,6 +174,60 @@ gen_obs_type *gen_obs_alloc__(const gen_data_config_type *data_config,
     return obs;
 }
 
+/**
+   Serialization used by the observation snapshot: the loaded and
+   parsed state of the observation, so restoring skips the OBS_FILE /
+   INDEX_FILE parsing entirely.
+*/
+void gen_obs_fwrite(const gen_obs_type *gen_obs, buffer_type *buffer) {
+    buffer_fwrite_int(buffer, gen_obs->obs_size);
+    buffer_fwrite_int(buffer, gen_obs->observe_all_data ? 1 : 0);
+    buffer_fwrite(buffer, gen_obs->obs_data, sizeof *gen_obs->obs_data,
+                  gen_obs->obs_size);
+    buffer_fwrite(buffer, gen_obs->obs_std, sizeof *gen_obs->obs_std,
+                  gen_obs->obs_size);
+    buffer_fwrite(buffer, gen_obs->std_scaling, sizeof *gen_obs->std_scaling,
+                  gen_obs->obs_size);
+    buffer_fwrite_int(buffer, gen_obs->data_index_list.size());
+    buffer_fwrite(buffer, gen_obs->data_index_list.data(),
+                  sizeof(int), gen_obs->data_index_list.size());
+}
+
+/** Counterpart of gen_obs_fwrite(); returns NULL if the buffer does
+    not hold a well formed observation. */
+gen_obs_type *gen_obs_fread_alloc(const gen_data_config_type *data_config,
+                                  const char *obs_key, buffer_type *buffer) {
+    if (buffer_get_remaining_size(buffer) < 2 * sizeof(int))
+        return NULL;
+    int obs_size = buffer_fread_int(buffer);
+    int observe_all_data = buffer_fread_int(buffer);
+    if (obs_size < 0 ||
+        buffer_get_remaining_size(buffer) <
+            3 * (size_t)obs_size * sizeof(double) + sizeof(int))
+        return NULL;
+
+    gen_obs_type *gen_obs = gen_obs_alloc__(data_config, obs_key);
+    gen_obs->obs_size = obs_size;
+    gen_obs->observe_all_data = observe_all_data != 0;
+    gen_obs->obs_data = (double *)util_calloc(obs_size, sizeof(double));
+    gen_obs->obs_std = (double *)util_calloc(obs_size, sizeof(double));
+    gen_obs->std_scaling = (double *)util_calloc(obs_size, sizeof(double));
+    buffer_fread(buffer, gen_obs->obs_data, sizeof(double), obs_size);
+    buffer_fread(buffer, gen_obs->obs_std, sizeof(double), obs_size);
+    buffer_fread(buffer, gen_obs->std_scaling, sizeof(double), obs_size);
+
+    int index_size = buffer_fread_int(buffer);
+    if (index_size < 0 ||
+        buffer_get_remaining_size(buffer) < (size_t)index_size * sizeof(int)) {
+        gen_obs_free(gen_obs);
+        return NULL;
+    }
+    gen_obs->data_index_list.resize(index_size);
+    buffer_fread(buffer, gen_obs->data_index_list.data(), sizeof(int),
+                 index_size);
+    return gen_obs;
+}
+
 /**
    data_index_file is the name of a file with indices which should be
    observed, data_inde_string is the same, in the form of a
@@ -247,17 +305,34 @@ void gen_obs_measure(const gen_obs_type *gen_obs, const gen_data_type *gen_data,
                                 node_id.report_step, gen_obs->obs_size);
         const bool_vector_type *forward_model_active =
             gen_data_config_get_active_mask(gen_obs->data_config);
+        /* The response values are read straight from the gen_data
+           buffer - going through gen_data_iget_double() costs a
+           range-checking function call per point, which adds up for
+           the large observation sets this loop is hot for. The range
+           check is kept, but as one inlined compare per point. */
+        const double *data = gen_data_get_double_vector(gen_data);
+        int data_size = gen_data_get_size(gen_data);
+
+        if (forward_model_active == NULL && gen_obs->observe_all_data) {
+            /* Everything is observed and active - the whole response
+               vector is handed over in one call. */
+            meas_block_set_column(meas_block, node_id.iens, data,
+                                  gen_obs->obs_size);
+            return;
+        }
 
         for (int iobs = 0; iobs < gen_obs->obs_size; iobs++) {
             int data_index = gen_obs->data_index_list[iobs];
+            if ((data_index < 0) || (data_index >= data_size))
+                util_abort("%s: index:%d invalid. Valid range: [0,%d) \n",
+                           __func__, data_index, data_size);
 
             if (forward_model_active != NULL) {
                 if (!bool_vector_iget(forward_model_active, data_index))
                     continue; /* Forward model has deactivated this index - just continue. */
             }
 
-            meas_block_iset(meas_block, node_id.iens, iobs,
-                            gen_data_iget_double(gen_data, data_index));
+            meas_block_iset(meas_block, node_id.iens, iobs, data[data_index]);
         }
     }
 }
@@ -278,9 +353,14 @@ C_USED void gen_obs_get_observations(gen_obs_type *gen_obs,
         obs_block_type *obs_block =
             obs_data_add_block(obs_data, gen_obs->obs_key, gen_obs->obs_size);
 
+        /* The values and (scaled) standard deviations are handed over
+           as whole arrays instead of one obs_block_iset() call per
+           point. */
+        std::vector<double> scaled_std(gen_obs->obs_size);
         for (int iobs = 0; iobs < gen_obs->obs_size; iobs++)
-            obs_block_iset(obs_block, iobs, gen_obs->obs_data[iobs],
-                           IGET_SCALED_STD(gen_obs, iobs));
+            scaled_std[iobs] = IGET_SCALED_STD(gen_obs, iobs);
+        obs_block_fill(obs_block, gen_obs->obs_data, scaled_std.data(),
+                       gen_obs->obs_size);
 
         /* Setting some of the elements as missing, i.e. deactivated by the forward model. */
         if (forward_model_active != NULL) {
@@ -410,15 +490,11 @@ double gen_obs_iget_value(const gen_obs_type *gen_obs, int index) {
 }
 
 void gen_obs_load_values(const gen_obs_type *gen_obs, int size, double *data) {
-    for (int i = 0; i < size; i++) {
-        data[i] = gen_obs->obs_data[i];
-    }
+    memcpy(data, gen_obs->obs_data, size * sizeof *data);
 }
 
 void gen_obs_load_std(const gen_obs_type *gen_obs, int size, double *data) {
-    for (int i = 0; i < size; i++) {
-        data[i] = gen_obs->obs_std[i];
-    }
+    memcpy(data, gen_obs->obs_std, size * sizeof *data);
 }
 
 int gen_obs_get_obs_index(const gen_obs_type *gen_obs, int index) {
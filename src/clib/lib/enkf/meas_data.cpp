@@ -4,6 +4,7 @@
 */
 
 #include <cmath>
+#include <cstring>
 #include <pthread.h>
 #include <stdlib.h>
 
@@ -19,10 +20,16 @@
 
 struct meas_data_struct {
     int active_ens_size;
+    /** Owns every block ever allocated - including blocks retired by
+        meas_data_reset() which are kept for recycling. */
     vector_type *data;
     pthread_mutex_t data_mutex;
     hash_type *blocks;
-    std::vector<bool> ens_mask;
+    /** The blocks of the current fill round, in the order they were
+        added; all iteration (S assembly, sizes) goes through this
+        list so retired blocks are invisible. */
+    std::vector<meas_block_type *> live;
+    ert::EnsembleMask ens_mask;
 };
 
 struct meas_block_struct {
@@ -32,10 +39,22 @@ struct meas_block_struct {
     int obs_stride;
     int data_size;
     char *obs_key;
+    /** The (obs_size x active_ens_size) response matrix, column-major
+        with the observations contiguous within each member column -
+        i.e. exactly the layout of the rows this block contributes to
+        S, so the assembly copies whole active row ranges instead of
+        scalars. */
     double *data;
+    /** Per-observation ensemble statistics, kept out of the data block
+        so the matrix stays Eigen-contiguous. */
+    double *ens_mean;
+    double *ens_std;
     bool *active;
     bool stat_calculated;
-    std::vector<bool> ens_mask;
+    /** False for blocks retired by meas_data_reset() and waiting to be
+        recycled by a later meas_data_add_block() with the same key. */
+    bool in_use;
+    ert::EnsembleMask ens_mask;
     int_vector_type *index_map;
 };
 
@@ -52,49 +71,67 @@ struct meas_block_struct {
 
 namespace {
 int_vector_type *
-bool_vector_to_active_index_list(const std::vector<bool> &bool_vector) {
-    int_vector_type *index_list = int_vector_alloc(bool_vector.size(), -1);
+mask_to_active_index_list(const ert::EnsembleMask &ens_mask) {
+    int_vector_type *index_list = int_vector_alloc(ens_mask.size(), -1);
     int active_index = 0;
-    for (int i = 0; i < bool_vector.size(); i++) {
-        if (bool_vector[i]) {
-            int_vector_iset(index_list, i, active_index);
-            active_index++;
-        }
-    }
+    ens_mask.for_each_active([index_list, &active_index](int iens) {
+        int_vector_iset(index_list, iens, active_index);
+        active_index++;
+    });
     return index_list;
 }
 } // namespace
 
 meas_block_type *meas_block_alloc(const char *obs_key,
-                                  const std::vector<bool> &ens_mask,
+                                  const ert::EnsembleMask &ens_mask,
                                   int obs_size) {
     auto meas_block = new meas_block_type;
-    meas_block->active_ens_size =
-        std::count(ens_mask.begin(), ens_mask.end(), true);
+    meas_block->active_ens_size = ens_mask.count();
     meas_block->ens_mask = ens_mask;
     meas_block->obs_size = obs_size;
     meas_block->obs_key = util_alloc_string_copy(obs_key);
     meas_block->data = (double *)util_calloc(
-        (meas_block->active_ens_size + 2) * obs_size, sizeof *meas_block->data);
+        meas_block->active_ens_size * obs_size, sizeof *meas_block->data);
+    meas_block->ens_mean =
+        (double *)util_calloc(obs_size, sizeof *meas_block->ens_mean);
+    meas_block->ens_std =
+        (double *)util_calloc(obs_size, sizeof *meas_block->ens_std);
     meas_block->active =
         (bool *)util_calloc(obs_size, sizeof *meas_block->active);
-    meas_block->ens_stride = 1;
-    meas_block->obs_stride = meas_block->active_ens_size + 2;
-    meas_block->data_size = (meas_block->active_ens_size + 2) * obs_size;
-    meas_block->index_map =
-        bool_vector_to_active_index_list(meas_block->ens_mask);
+    meas_block->ens_stride = obs_size;
+    meas_block->obs_stride = 1;
+    meas_block->data_size = meas_block->active_ens_size * obs_size;
+    meas_block->index_map = mask_to_active_index_list(meas_block->ens_mask);
     {
         int i;
         for (i = 0; i < obs_size; i++)
             meas_block->active[i] = false;
     }
     meas_block->stat_calculated = false;
+    meas_block->in_use = true;
     return meas_block;
 }
 
+/**
+   Return a retired block to the freshly allocated state without
+   touching its allocations - the clear half of the reset-and-reuse
+   lifecycle of meas_data.
+*/
+static void meas_block_recycle(meas_block_type *meas_block) {
+    memset(meas_block->data, 0, meas_block->data_size * sizeof(double));
+    memset(meas_block->ens_mean, 0, meas_block->obs_size * sizeof(double));
+    memset(meas_block->ens_std, 0, meas_block->obs_size * sizeof(double));
+    std::fill(meas_block->active, &meas_block->active[meas_block->obs_size],
+              false);
+    meas_block->stat_calculated = false;
+    meas_block->in_use = true;
+}
+
 void meas_block_free(meas_block_type *meas_block) {
     free(meas_block->obs_key);
     free(meas_block->data);
+    free(meas_block->ens_mean);
+    free(meas_block->ens_std);
     free(meas_block->active);
     int_vector_free(meas_block->index_map);
     delete meas_block;
@@ -105,46 +142,61 @@ static void meas_block_free__(void *arg) {
     meas_block_free(meas_block);
 }
 
+/**
+   Eigen view of the block data: one column per ensemble member with
+   the observations contiguous within the column - the same
+   orientation as the S matrix rows this block contributes. The view
+   borrows the block data and is only valid while the block is alive.
+*/
+Eigen::Map<const Eigen::MatrixXd, Eigen::Unaligned, Eigen::OuterStride<>>
+meas_block_get_matrix_view(const meas_block_type *meas_block) {
+    return {meas_block->data, meas_block->obs_size,
+            meas_block->active_ens_size,
+            Eigen::OuterStride<>(meas_block->ens_stride)};
+}
+
+/**
+   Copy the active observation rows of the block into S starting at
+   *__obs_offset. The block shares the orientation of S, so every
+   maximal run of active observations is copied as one (run x ens)
+   sub-matrix - per member a single contiguous copy - instead of
+   element by element.
+*/
 static void meas_block_initS(const meas_block_type *meas_block,
                              Eigen::MatrixXd &S, int *__obs_offset) {
     int obs_offset = *__obs_offset;
-    for (int iobs = 0; iobs < meas_block->obs_size; iobs++) {
-        if (meas_block->active[iobs]) {
-            for (int iens = 0; iens < meas_block->active_ens_size; iens++) {
-                int obs_index = iens * meas_block->ens_stride +
-                                iobs * meas_block->obs_stride;
-
-                S(obs_offset, iens) = meas_block->data[obs_index];
-            }
-            obs_offset++;
+    auto block = meas_block_get_matrix_view(meas_block);
+    int iobs = 0;
+    while (iobs < meas_block->obs_size) {
+        if (!meas_block->active[iobs]) {
+            iobs++;
+            continue;
         }
+        int run_start = iobs;
+        while (iobs < meas_block->obs_size && meas_block->active[iobs])
+            iobs++;
+        int run_length = iobs - run_start;
+        S.middleRows(obs_offset, run_length) =
+            block.middleRows(run_start, run_length);
+        obs_offset += run_length;
     }
     *__obs_offset = obs_offset;
 }
 
 void meas_block_calculate_ens_stats(meas_block_type *meas_block) {
-    for (int iobs = 0; iobs < meas_block->obs_size; iobs++) {
-        if (meas_block->active[iobs]) {
-            double M1 = 0;
-            double M2 = 0;
-            for (int iens = 0; iens < meas_block->active_ens_size; iens++) {
-                int index = iens * meas_block->ens_stride +
-                            iobs * meas_block->obs_stride;
-                M1 += meas_block->data[index];
-                M2 += meas_block->data[index] * meas_block->data[index];
-            }
-            int mean_index =
-                (meas_block->active_ens_size + 0) * meas_block->ens_stride +
-                iobs * meas_block->obs_stride;
-            int std_index =
-                (meas_block->active_ens_size + 1) * meas_block->ens_stride +
-                iobs * meas_block->obs_stride;
-            double mean = M1 / meas_block->active_ens_size;
-            double var = M2 / meas_block->active_ens_size - mean * mean;
-            meas_block->data[mean_index] = mean;
-            meas_block->data[std_index] = sqrt(std::max(0.0, var));
-        }
-    }
+    // With the observations contiguous within each member column the
+    // whole block maps as one matrix, and the per-observation
+    // statistics are row-wise reductions over it - vectorized by
+    // Eigen, no index computation per element.
+    auto block = meas_block_get_matrix_view(meas_block);
+    Eigen::Map<Eigen::ArrayXd> mean(meas_block->ens_mean,
+                                    meas_block->obs_size);
+    Eigen::Map<Eigen::ArrayXd> std_dev(meas_block->ens_std,
+                                       meas_block->obs_size);
+    mean = block.array().rowwise().mean();
+    std_dev = (block.array().square().rowwise().mean() - mean.square())
+                  .max(0.0)
+                  .sqrt();
     meas_block->stat_calculated = true;
 }
 
@@ -155,7 +207,7 @@ static void meas_block_assert_ens_stat(meas_block_type *meas_block) {
 
 static void meas_block_assert_iens_active(const meas_block_type *meas_block,
                                           int iens) {
-    if (!meas_block->ens_mask[iens])
+    if (!meas_block->ens_mask.get(iens))
         util_abort(
             "%s: fatal error - trying to access inactive ensemble member:%d \n",
             __func__, iens);
@@ -176,6 +228,62 @@ void meas_block_iset(meas_block_type *meas_block, int iens, int iobs,
     }
 }
 
+/**
+   Set the whole response column of one ensemble member - the values
+   of observations [0, n) - with a single call instead of n
+   meas_block_iset() calls, and mark those observations active. The
+   observation direction is the contiguous one in the block, so this
+   is one memcpy straight into the member's column.
+*/
+/**
+   Fused chi2 kernel for a whole block: for every masked ensemble
+   member the residual against the observation is subtracted, scaled
+   by 1/std and squared in one pass over the member's contiguous
+   column. The activation mask - the block's own active flags combined
+   with the optional observation-side mask - is folded into a
+   per-observation scale of 0.0, so the member loop is branch-free and
+   autovectorizes; full-ensemble misfit evaluation pushes ~10^8
+   residuals through this loop. chi2 is indexed by global iens and
+   only written for members in the ensemble mask.
+*/
+void meas_block_chi2(const meas_block_type *meas_block, const double *obs_value,
+                     const double *obs_std, const bool *obs_active,
+                     double *chi2) {
+    int obs_size = meas_block->obs_size;
+    std::vector<double> shift(obs_size);
+    std::vector<double> scale(obs_size);
+    for (int iobs = 0; iobs < obs_size; iobs++) {
+        bool active =
+            meas_block->active[iobs] && (obs_active == NULL || obs_active[iobs]);
+        shift[iobs] = active ? obs_value[iobs] : 0.0;
+        scale[iobs] = active ? 1.0 / obs_std[iobs] : 0.0;
+    }
+
+    meas_block->ens_mask.for_each_active([&](int iens) {
+        const double *column =
+            &meas_block->data[int_vector_iget(meas_block->index_map, iens) *
+                              meas_block->ens_stride];
+        double sum = 0;
+        for (int iobs = 0; iobs < obs_size; iobs++) {
+            double x = (column[iobs] - shift[iobs]) * scale[iobs];
+            sum += x * x;
+        }
+        chi2[iens] = sum;
+    });
+}
+
+void meas_block_set_column(meas_block_type *meas_block, int iens,
+                           const double *values, int n) {
+    meas_block_assert_iens_active(meas_block, iens);
+    {
+        int active_iens = int_vector_iget(meas_block->index_map, iens);
+        memcpy(&meas_block->data[active_iens * meas_block->ens_stride], values,
+               n * sizeof(double));
+        std::fill(meas_block->active, &meas_block->active[n], true);
+        meas_block->stat_calculated = false;
+    }
+}
+
 double meas_block_iget(const meas_block_type *meas_block, int iens, int iobs) {
     meas_block_assert_iens_active(meas_block, iens);
     {
@@ -199,21 +307,12 @@ static int meas_block_get_active_obs_size(const meas_block_type *meas_block) {
 
 double meas_block_iget_ens_std(meas_block_type *meas_block, int iobs) {
     meas_block_assert_ens_stat(meas_block);
-    {
-        int std_index =
-            (meas_block->active_ens_size + 1) * meas_block->ens_stride +
-            iobs * meas_block->obs_stride;
-        return meas_block->data[std_index];
-    }
+    return meas_block->ens_std[iobs];
 }
 
 double meas_block_iget_ens_mean(meas_block_type *meas_block, int iobs) {
     meas_block_assert_ens_stat(meas_block);
-    {
-        int mean_index = meas_block->active_ens_size * meas_block->ens_stride +
-                         iobs * meas_block->obs_stride;
-        return meas_block->data[mean_index];
-    }
+    return meas_block->ens_mean[iobs];
 }
 
 bool meas_block_iget_active(const meas_block_type *meas_block, int iobs) {
@@ -221,9 +320,14 @@ bool meas_block_iget_active(const meas_block_type *meas_block, int iobs) {
 }
 
 void meas_block_deactivate(meas_block_type *meas_block, int iobs) {
+    // The per-observation statistics only depend on the data values,
+    // not on which observations are active, so deactivating one
+    // observation does not invalidate the cached statistics. Earlier
+    // this reset stat_calculated, which made outlier deactivation
+    // recompute the statistics of the whole block for every
+    // deactivated observation.
     if (meas_block->active[iobs])
         meas_block->active[iobs] = false;
-    meas_block->stat_calculated = false;
 }
 
 int meas_block_get_total_obs_size(const meas_block_type *meas_block) {
@@ -238,13 +342,13 @@ int meas_block_get_total_ens_size(const meas_block_type *meas_block) {
     return meas_block->ens_mask.size();
 }
 
-meas_data_type *meas_data_alloc(const std::vector<bool> &ens_mask) {
+meas_data_type *meas_data_alloc(const ert::EnsembleMask &ens_mask) {
     auto meas = new meas_data_type;
 
     meas->data = vector_alloc_new();
     meas->blocks = hash_alloc();
     meas->ens_mask = ens_mask;
-    meas->active_ens_size = std::count(ens_mask.begin(), ens_mask.end(), true);
+    meas->active_ens_size = ens_mask.count();
     pthread_mutex_init(&meas->data_mutex, NULL);
 
     return meas;
@@ -256,11 +360,38 @@ void meas_data_free(meas_data_type *matrix) {
     delete matrix;
 }
 
+/**
+   Clear semantics preserving capacity: the blocks of the previous fill
+   round are retired but keep their buffers, and a subsequent
+   meas_data_add_block() with the same key recycles the retired block
+   instead of allocating. A sequence of ministeps touching the same
+   observations thus reuses one set of buffers. Changing the ensemble
+   mask drops the pool - the block geometry is no longer valid.
+*/
+void meas_data_reset(meas_data_type *matrix,
+                     const ert::EnsembleMask &ens_mask) {
+    pthread_mutex_lock(&matrix->data_mutex);
+    if (ens_mask == matrix->ens_mask) {
+        for (auto *block : matrix->live)
+            block->in_use = false;
+    } else {
+        vector_clear(matrix->data);
+        hash_clear(matrix->blocks);
+        matrix->ens_mask = ens_mask;
+        matrix->active_ens_size = ens_mask.count();
+    }
+    matrix->live.clear();
+    pthread_mutex_unlock(&matrix->data_mutex);
+}
+
 /*
-   The obs_key is not alone unique over different report steps.
+   The obs_key is not alone unique over different report steps. The
+   size is part of the key so a recycled block always has the right
+   capacity.
 */
-static char *meas_data_alloc_key(const char *obs_key, int report_step) {
-    return util_alloc_sprintf("%s-%d", obs_key, report_step);
+static char *meas_data_alloc_key(const char *obs_key, int report_step,
+                                 int obs_size) {
+    return util_alloc_sprintf("%s-%d-%d", obs_key, report_step, obs_size);
 }
 
 /*
@@ -270,35 +401,38 @@ static char *meas_data_alloc_key(const char *obs_key, int report_step) {
 meas_block_type *meas_data_add_block(meas_data_type *matrix,
                                      const char *obs_key, int report_step,
                                      int obs_size) {
-    char *lookup_key = meas_data_alloc_key(obs_key, report_step);
+    char *lookup_key = meas_data_alloc_key(obs_key, report_step, obs_size);
+    meas_block_type *block;
     pthread_mutex_lock(&matrix->data_mutex);
     {
-        if (!hash_has_key(matrix->blocks, lookup_key)) {
-            meas_block_type *new_block =
-                meas_block_alloc(obs_key, matrix->ens_mask, obs_size);
-            vector_append_owned_ref(matrix->data, new_block, meas_block_free__);
-            hash_insert_ref(matrix->blocks, lookup_key, new_block);
+        if (hash_has_key(matrix->blocks, lookup_key)) {
+            block = (meas_block_type *)hash_get(matrix->blocks, lookup_key);
+            if (!block->in_use) {
+                meas_block_recycle(block);
+                matrix->live.push_back(block);
+            }
+        } else {
+            block = meas_block_alloc(obs_key, matrix->ens_mask, obs_size);
+            vector_append_owned_ref(matrix->data, block, meas_block_free__);
+            hash_insert_ref(matrix->blocks, lookup_key, block);
+            matrix->live.push_back(block);
         }
     }
     pthread_mutex_unlock(&matrix->data_mutex);
     free(lookup_key);
-    return (meas_block_type *)vector_get_last(matrix->data);
+    return block;
 }
 
 meas_block_type *meas_data_iget_block(const meas_data_type *matrix,
                                       int block_nr) {
-    return (meas_block_type *)vector_iget(matrix->data, block_nr);
+    return matrix->live[block_nr];
 }
 
 int meas_data_get_active_obs_size(const meas_data_type *matrix) {
     int obs_size = 0;
 
-    for (int block_nr = 0; block_nr < vector_get_size(matrix->data);
-         block_nr++) {
-        const meas_block_type *meas_block =
-            (const meas_block_type *)vector_iget_const(matrix->data, block_nr);
+    for (const meas_block_type *meas_block : matrix->live)
         obs_size += meas_block_get_active_obs_size(meas_block);
-    }
 
     return obs_size;
 }
@@ -308,13 +442,8 @@ Eigen::MatrixXd meas_data_makeS(const meas_data_type *matrix) {
     Eigen::MatrixXd S = Eigen::MatrixXd::Zero(
         meas_data_get_active_obs_size(matrix), matrix->active_ens_size);
     if (S.rows() > 0 && S.cols() > 0) {
-        for (int block_nr = 0; block_nr < vector_get_size(matrix->data);
-             block_nr++) {
-            const meas_block_type *meas_block =
-                (const meas_block_type *)vector_iget_const(matrix->data,
-                                                           block_nr);
+        for (const meas_block_type *meas_block : matrix->live)
             meas_block_initS(meas_block, S, &obs_offset);
-        }
     }
     return S;
 }
@@ -1,12 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <vector>
+
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
 
 #include <ert/enkf/enkf_obs.hpp>
 #include <ert/enkf/misfit_ensemble.hpp>
+#include <ert/enkf/state_map.hpp>
+
+/**
+   Sentinel written instead of history_length to mark the misfit file
+   format which appends the per-member evaluation states. The old
+   format starts with the (non-negative) history length, so the two
+   can be told apart when reading.
+*/
+#define MISFIT_ENSEMBLE_FORMAT_V2 -2
 
 /**
    The misfit_ensemble_struct is used to rank the different realization
@@ -17,6 +28,11 @@ struct misfit_ensemble_struct {
     int history_length;
     /** Vector of misfit_member_type instances - one for each ensemble member. */
     vector_type *ensemble;
+    /** The state_map entry of each member when its misfit was last
+        evaluated; members whose current state differs are stale and
+        get recomputed, the rest are served from the internalized
+        (and case-persisted) chi2 values. */
+    std::vector<int> eval_state;
 };
 
 static double **__2d_malloc(int rows, int columns) {
@@ -38,34 +54,69 @@ void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
                                 int ens_size, int history_length,
                                 bool force_init) {
 
-    if (force_init || !misfit_ensemble->initialized) {
+    StateMap &state_map = enkf_fs_get_state_map(fs);
+    bool full_init =
+        force_init || !misfit_ensemble->initialized ||
+        misfit_ensemble->history_length != history_length ||
+        misfit_ensemble_get_ens_size(misfit_ensemble) != ens_size;
+
+    // Only members whose state_map entry changed since their misfit
+    // was last evaluated are recomputed; the others already have
+    // their per-(obs key, step) chi2 internalized (and persisted with
+    // the case through enkf_fs_fwrite_misfit).
+    std::vector<bool> stale(ens_size, true);
+    if (full_init) {
         misfit_ensemble_clear(misfit_ensemble);
+        misfit_ensemble->history_length = history_length;
+        misfit_ensemble_set_ens_size(misfit_ensemble, ens_size);
+    } else {
+        misfit_ensemble->eval_state.resize(ens_size, STATE_UNDEFINED);
+        bool any_stale = false;
+        for (int iens = 0; iens < ens_size; iens++) {
+            stale[iens] = state_map.get(iens) !=
+                          misfit_ensemble->eval_state[iens];
+            any_stale = any_stale || stale[iens];
+        }
+        if (!any_stale)
+            return;
+    }
 
+    {
         double **chi2_work = __2d_malloc(history_length + 1, ens_size);
         bool_vector_type *iens_valid = bool_vector_alloc(ens_size, true);
 
         hash_iter_type *obs_iter = enkf_obs_alloc_iter(enkf_obs);
         const char *obs_key = hash_iter_get_next_key(obs_iter);
 
-        misfit_ensemble->history_length = history_length;
-        misfit_ensemble_set_ens_size(misfit_ensemble, ens_size);
-
         while (obs_key != NULL) {
             obs_vector_type *obs_vector =
                 enkf_obs_get_vector(enkf_obs, obs_key);
 
             bool_vector_reset(iens_valid);
             bool_vector_iset(iens_valid, ens_size - 1, true);
-            obs_vector_ensemble_chi2(obs_vector, fs, iens_valid, 0,
-                                     misfit_ensemble->history_length, 0,
-                                     ens_size, chi2_work);
+
+            // Evaluate the contiguous ranges of stale members.
+            int iens1 = 0;
+            while (iens1 < ens_size) {
+                if (!stale[iens1]) {
+                    iens1++;
+                    continue;
+                }
+                int iens2 = iens1;
+                while (iens2 < ens_size && stale[iens2])
+                    iens2++;
+                obs_vector_ensemble_chi2(obs_vector, fs, iens_valid, 0,
+                                         misfit_ensemble->history_length, iens1,
+                                         iens2, chi2_work);
+                iens1 = iens2;
+            }
 
             // Internalizing the results from the chi2_work table into the
             // misfit structure.
             for (int iens = 0; iens < ens_size; iens++) {
                 misfit_member_type *node =
                     misfit_ensemble_iget_member(misfit_ensemble, iens);
-                if (bool_vector_iget(iens_valid, iens))
+                if (stale[iens] && bool_vector_iget(iens_valid, iens))
                     misfit_member_update(node, obs_key,
                                          misfit_ensemble->history_length, iens,
                                          (const double **)chi2_work);
@@ -77,13 +128,19 @@ void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
         hash_iter_free(obs_iter);
 
         __2d_free(chi2_work, misfit_ensemble->history_length + 1);
-        misfit_ensemble->initialized = true;
     }
+
+    misfit_ensemble->eval_state.resize(ens_size, STATE_UNDEFINED);
+    for (int iens = 0; iens < ens_size; iens++)
+        if (stale[iens])
+            misfit_ensemble->eval_state[iens] = state_map.get(iens);
+    misfit_ensemble->initialized = true;
 }
 
 void misfit_ensemble_fwrite(const misfit_ensemble_type *misfit_ensemble,
                             FILE *stream) {
     int ens_size = vector_get_size(misfit_ensemble->ensemble);
+    util_fwrite_int(MISFIT_ENSEMBLE_FORMAT_V2, stream);
     util_fwrite_int(misfit_ensemble->history_length, stream);
     util_fwrite_int(vector_get_size(misfit_ensemble->ensemble), stream);
 
@@ -95,6 +152,13 @@ void misfit_ensemble_fwrite(const misfit_ensemble_type *misfit_ensemble,
                                      misfit_ensemble->ensemble, iens),
                                  stream);
     }
+
+    /* The state_map entry of each member at evaluation time. */
+    for (int iens = 0; iens < ens_size; iens++)
+        util_fwrite_int(iens < (int)misfit_ensemble->eval_state.size()
+                            ? misfit_ensemble->eval_state[iens]
+                            : STATE_UNDEFINED,
+                        stream);
 }
 
 /**
@@ -127,8 +191,11 @@ void misfit_ensemble_fread(misfit_ensemble_type *misfit_ensemble,
     misfit_ensemble_clear(misfit_ensemble);
     {
         int ens_size;
+        int first_int = util_fread_int(stream);
+        bool versioned = (first_int == MISFIT_ENSEMBLE_FORMAT_V2);
 
-        misfit_ensemble->history_length = util_fread_int(stream);
+        misfit_ensemble->history_length =
+            versioned ? util_fread_int(stream) : first_int;
         ens_size = util_fread_int(stream);
         misfit_ensemble_set_ens_size(misfit_ensemble, ens_size);
         {
@@ -138,6 +205,14 @@ void misfit_ensemble_fread(misfit_ensemble_type *misfit_ensemble,
                                       misfit_member_free__);
             }
         }
+
+        // Old format files have no evaluation states; those members
+        // are treated as stale and recomputed once.
+        misfit_ensemble->eval_state.assign(ens_size, STATE_UNDEFINED);
+        if (versioned)
+            for (int iens = 0; iens < ens_size; iens++)
+                misfit_ensemble->eval_state[iens] = util_fread_int(stream);
+        misfit_ensemble->initialized = true;
     }
 }
 
@@ -157,6 +232,7 @@ misfit_ensemble_iget_member(const misfit_ensemble_type *table, int iens) {
 
 void misfit_ensemble_clear(misfit_ensemble_type *table) {
     vector_clear(table->ensemble);
+    table->eval_state.clear();
     table->initialized = false;
 }
 
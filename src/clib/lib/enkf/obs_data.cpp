@@ -44,7 +44,10 @@ Matrices: S, D, E and various internal variables.
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <vector>
 
 #include <ert/util/util.h>
@@ -56,21 +59,38 @@ Matrices: S, D, E and various internal variables.
 
 static auto logger = ert::get_logger("analysis.update");
 
+/**
+   The observations are stored structure-of-arrays: value, std and
+   scale are three contiguous arrays of length @size. The scale array
+   holds the std multiplier for each observation - initialized to the
+   global std scaling and available for per-observation scaling - so
+   the scaled errors can be formed as one vectorized product when the
+   E and D matrices are assembled.
+*/
 struct obs_block_struct {
     char *obs_key;
     int size;
     double *value;
     double *std;
+    double *scale;
 
     active_type *active_mode;
     int active_size;
-    double global_std_scaling;
+    /** False for blocks retired by obs_data_reset() and waiting to be
+        recycled by a later obs_data_add_block() with the same key. */
+    bool in_use;
 };
 
 struct obs_data_struct {
-    /** vector with obs_block instances. */
+    /** Owns every block ever allocated - including blocks retired by
+        obs_data_reset() which are kept for recycling. */
     vector_type *data;
-    bool_vector_type *mask;
+    /** Retired/live blocks keyed by "<obs_key>-<size>" for recycling. */
+    hash_type *blocks;
+    /** The blocks of the current fill round, in the order they were
+        added; all iteration goes through this list so retired blocks
+        are invisible. */
+    std::vector<obs_block_type *> live;
     double global_std_scaling;
 };
 
@@ -84,21 +104,41 @@ obs_block_type *obs_block_alloc(const char *obs_key, int obs_size,
     obs_block->value =
         (double *)util_calloc(obs_size, sizeof *obs_block->value);
     obs_block->std = (double *)util_calloc(obs_size, sizeof *obs_block->std);
+    obs_block->scale =
+        (double *)util_calloc(obs_size, sizeof *obs_block->scale);
     obs_block->active_mode =
         (active_type *)util_calloc(obs_size, sizeof *obs_block->active_mode);
-    obs_block->global_std_scaling = global_std_scaling;
+    std::fill_n(obs_block->scale, obs_size, global_std_scaling);
     {
         for (int iobs = 0; iobs < obs_size; iobs++)
             obs_block->active_mode[iobs] = LOCAL_INACTIVE;
     }
     obs_block->active_size = 0;
+    obs_block->in_use = true;
     return obs_block;
 }
 
+/**
+   Return a retired block to the freshly allocated state without
+   touching its allocations - the clear half of the reset-and-reuse
+   lifecycle of obs_data.
+*/
+static void obs_block_recycle(obs_block_type *obs_block,
+                              double global_std_scaling) {
+    memset(obs_block->value, 0, obs_block->size * sizeof *obs_block->value);
+    memset(obs_block->std, 0, obs_block->size * sizeof *obs_block->std);
+    std::fill_n(obs_block->scale, obs_block->size, global_std_scaling);
+    for (int iobs = 0; iobs < obs_block->size; iobs++)
+        obs_block->active_mode[iobs] = LOCAL_INACTIVE;
+    obs_block->active_size = 0;
+    obs_block->in_use = true;
+}
+
 void obs_block_free(obs_block_type *obs_block) {
     free(obs_block->obs_key);
     free(obs_block->value);
     free(obs_block->std);
+    free(obs_block->scale);
     free(obs_block->active_mode);
     free(obs_block);
 }
@@ -132,6 +172,24 @@ void obs_block_iset(obs_block_type *obs_block, int iobs, double value,
     }
 }
 
+/**
+   Bulk variant of obs_block_iset() setting the first @size
+   observations with two contiguous copies and activating them all;
+   large observation blocks (e.g. GEN_OBS) are filled with this
+   instead of one call per point.
+*/
+void obs_block_fill(obs_block_type *obs_block, const double *values,
+                    const double *stds, int size) {
+    memcpy(obs_block->value, values, size * sizeof *obs_block->value);
+    memcpy(obs_block->std, stds, size * sizeof *obs_block->std);
+    for (int iobs = 0; iobs < size; iobs++) {
+        if (obs_block->active_mode[iobs] != ACTIVE) {
+            obs_block->active_mode[iobs] = ACTIVE;
+            obs_block->active_size++;
+        }
+    }
+}
+
 void obs_block_iset_missing(obs_block_type *obs_block, int iobs) {
     if (obs_block->active_mode[iobs] == ACTIVE)
         obs_block->active_size--;
@@ -139,7 +197,7 @@ void obs_block_iset_missing(obs_block_type *obs_block, int iobs) {
 }
 
 double obs_block_iget_std(const obs_block_type *obs_block, int iobs) {
-    return obs_block->std[iobs] * obs_block->global_std_scaling;
+    return obs_block->std[iobs] * obs_block->scale[iobs];
 }
 
 double obs_block_iget_value(const obs_block_type *obs_block, int iobs) {
@@ -159,65 +217,125 @@ int obs_block_get_size(const obs_block_type *obs_block) {
     return obs_block->size;
 }
 
-static void obs_block_set_active_mask(const obs_block_type *obs_block,
-                                      bool_vector_type *mask, int *offset) {
-    for (int i = 0; i < obs_block->size; i++) {
-        if (obs_block->active_mode[i] == ACTIVE)
-            bool_vector_iset(mask, *offset, true);
-        else
-            bool_vector_iset(mask, *offset, false);
-        (*offset)++;
+/**
+   Chi2 of a whole meas_block against this observation block, one
+   value per masked ensemble member. Deactivated observations are
+   masked out together with the block's own activation flags; the
+   heavy lifting is the fused array kernel in meas_block_chi2().
+*/
+void obs_block_chi2(const obs_block_type *obs_block,
+                    const meas_block_type *meas_block, double *chi2) {
+    if (obs_block->size != meas_block_get_total_obs_size(meas_block))
+        util_abort("%s: size mismatch between obs_block:%d and meas_block:%d "
+                   "for observation:%s \n",
+                   __func__, obs_block->size,
+                   meas_block_get_total_obs_size(meas_block),
+                   obs_block->obs_key);
+
+    std::unique_ptr<bool[]> obs_active(new bool[obs_block->size]);
+    for (int iobs = 0; iobs < obs_block->size; iobs++)
+        obs_active[iobs] = obs_block->active_mode[iobs] == ACTIVE;
+
+    meas_block_chi2(meas_block, obs_block->value, obs_block->std,
+                    obs_active.get(), chi2);
+}
+
+/**
+   Copies the entries of @src corresponding to ACTIVE observations
+   into @target, starting at *offset. Maximal runs of consecutive
+   active observations are copied with one segment assignment instead
+   of one element at a time; the same pass serves both the value and
+   the error extraction feeding the E and D matrix construction.
+*/
+static void obs_block_copy_active(const obs_block_type *obs_block,
+                                  const double *src, Eigen::VectorXd &target,
+                                  int *offset) {
+    int iobs = 0;
+    while (iobs < obs_block->size) {
+        if (obs_block->active_mode[iobs] != ACTIVE) {
+            iobs++;
+            continue;
+        }
+        int run_start = iobs;
+        while (iobs < obs_block->size &&
+               obs_block->active_mode[iobs] == ACTIVE)
+            iobs++;
+        int run_length = iobs - run_start;
+        target.segment(*offset, run_length) =
+            Eigen::Map<const Eigen::VectorXd>(src + run_start, run_length);
+        *offset += run_length;
     }
 }
 
 obs_data_type *obs_data_alloc(double global_std_scaling) {
-    obs_data_type *obs_data = (obs_data_type *)util_malloc(sizeof *obs_data);
+    auto obs_data = new obs_data_type;
     obs_data->data = vector_alloc_new();
-    obs_data->mask = bool_vector_alloc(0, false);
+    obs_data->blocks = hash_alloc();
     obs_data->global_std_scaling = global_std_scaling;
     return obs_data;
 }
 
+/**
+   Clear semantics preserving capacity: the blocks of the previous fill
+   round are retired but keep their buffers, and a subsequent
+   obs_data_add_block() with the same key recycles the retired block
+   instead of allocating. A sequence of ministeps touching the same
+   observations thus reuses one set of buffers.
+*/
+void obs_data_reset(obs_data_type *obs_data, double global_std_scaling) {
+    for (auto *obs_block : obs_data->live)
+        obs_block->in_use = false;
+    obs_data->live.clear();
+    obs_data->global_std_scaling = global_std_scaling;
+}
+
 obs_block_type *obs_data_add_block(obs_data_type *obs_data, const char *obs_key,
                                    int obs_size) {
-    obs_block_type *new_block =
-        obs_block_alloc(obs_key, obs_size, obs_data->global_std_scaling);
-    vector_append_owned_ref(obs_data->data, new_block, obs_block_free__);
-    return new_block;
+    char *lookup_key = util_alloc_sprintf("%s-%d", obs_key, obs_size);
+    obs_block_type *block = nullptr;
+    if (hash_has_key(obs_data->blocks, lookup_key)) {
+        block = (obs_block_type *)hash_get(obs_data->blocks, lookup_key);
+        // The same obs_key can legally occur once per report step; a
+        // block which is already live this round can not be recycled,
+        // so a fresh one is allocated alongside it.
+        if (block->in_use)
+            block = nullptr;
+        else
+            obs_block_recycle(block, obs_data->global_std_scaling);
+    }
+    if (block == nullptr) {
+        block = obs_block_alloc(obs_key, obs_size,
+                                obs_data->global_std_scaling);
+        vector_append_owned_ref(obs_data->data, block, obs_block_free__);
+        hash_insert_ref(obs_data->blocks, lookup_key, block);
+    }
+    free(lookup_key);
+    obs_data->live.push_back(block);
+    return block;
 }
 
 obs_block_type *obs_data_iget_block(obs_data_type *obs_data, int index) {
-    return (obs_block_type *)vector_iget(obs_data->data,
-                                         index); // CXX_CAST_ERROR
+    return obs_data->live[index];
 }
 
 const obs_block_type *obs_data_iget_block_const(const obs_data_type *obs_data,
                                                 int index) {
-    return (const obs_block_type *)vector_iget_const(obs_data->data,
-                                                     index); // CXX_CAST_ERROR
+    return obs_data->live[index];
 }
 
 void obs_data_free(obs_data_type *obs_data) {
     vector_free(obs_data->data);
-    bool_vector_free(obs_data->mask);
-    free(obs_data);
+    hash_free(obs_data->blocks);
+    delete obs_data;
 }
 
 Eigen::VectorXd obs_data_values_as_vector(const obs_data_type *obs_data) {
     int active_obs_size = obs_data_get_active_size(obs_data);
     Eigen::VectorXd obs_values = Eigen::VectorXd::Zero(active_obs_size);
     int obs_offset = 0;
-    for (int block_nr = 0; block_nr < vector_get_size(obs_data->data);
-         block_nr++) {
-        const obs_block_type *obs_block =
-            (const obs_block_type *)vector_iget_const(obs_data->data, block_nr);
-        for (int iobs = 0; iobs < obs_block->size; iobs++) {
-            if (obs_block->active_mode[iobs] == ACTIVE) {
-                obs_values(obs_offset) = obs_block->value[iobs];
-                obs_offset++;
-            }
-        }
-    }
+    for (const obs_block_type *obs_block : obs_data->live)
+        obs_block_copy_active(obs_block, obs_block->value, obs_values,
+                              &obs_offset);
     return obs_values;
 }
 
@@ -225,44 +343,28 @@ Eigen::VectorXd obs_data_errors_as_vector(const obs_data_type *obs_data) {
     int active_obs_size = obs_data_get_active_size(obs_data);
     Eigen::VectorXd obs_errors = Eigen::VectorXd::Zero(active_obs_size);
     int obs_offset = 0;
-    for (int block_nr = 0; block_nr < vector_get_size(obs_data->data);
-         block_nr++) {
-        const obs_block_type *obs_block =
-            (const obs_block_type *)vector_iget_const(obs_data->data, block_nr);
-        for (int iobs = 0; iobs < obs_block->size; iobs++) {
-            if (obs_block->active_mode[iobs] == ACTIVE) {
-                obs_errors(obs_offset) = obs_block->std[iobs];
-                obs_offset++;
-            }
-        }
-    }
+    for (const obs_block_type *obs_block : obs_data->live)
+        obs_block_copy_active(obs_block, obs_block->std, obs_errors,
+                              &obs_offset);
     return obs_errors;
 }
 
 int obs_data_get_active_size(const obs_data_type *obs_data) {
     int active_size = 0;
-    for (int block_nr = 0; block_nr < vector_get_size(obs_data->data);
-         block_nr++) {
-        const obs_block_type *obs_block =
-            (const obs_block_type *)vector_iget_const(obs_data->data, block_nr);
+    for (const obs_block_type *obs_block : obs_data->live)
         active_size += obs_block->active_size;
-    }
 
     return active_size;
 }
 
 int obs_data_get_num_blocks(const obs_data_type *obs_data) {
-    return vector_get_size(obs_data->data);
+    return obs_data->live.size();
 }
 
 int obs_data_get_total_size(const obs_data_type *obs_data) {
     int total_size = 0;
-    for (int block_nr = 0; block_nr < vector_get_size(obs_data->data);
-         block_nr++) {
-        const obs_block_type *obs_block =
-            (const obs_block_type *)vector_iget_const(obs_data->data, block_nr);
+    for (const obs_block_type *obs_block : obs_data->live)
         total_size += obs_block->size;
-    }
     return total_size;
 }
 
@@ -276,8 +378,7 @@ obs_data_lookup_block(const obs_data_type *obs_data, int total_index,
         int block_size;
 
         while (true) {
-            obs_block = (const obs_block_type *)vector_iget_const(
-                obs_data->data, block_index);
+            obs_block = obs_data->live[block_index];
             block_size = obs_block->size;
             if ((block_size + total_offset) > total_index)
                 break;
@@ -294,20 +395,10 @@ obs_data_lookup_block(const obs_data_type *obs_data, int total_index,
 }
 
 std::vector<bool> obs_data_get_active_mask(const obs_data_type *obs_data) {
-    int total_size = obs_data_get_total_size(obs_data);
-    bool_vector_resize(obs_data->mask, total_size,
-                       false); //too account for extra data blocks added/removed
-
-    int offset = 0;
-    for (int block_nr = 0; block_nr < vector_get_size(obs_data->data);
-         block_nr++) {
-        const obs_block_type *obs_block =
-            (const obs_block_type *)vector_iget_const(obs_data->data, block_nr);
-        obs_block_set_active_mask(obs_block, obs_data->mask, &offset);
-    }
-    std::vector<bool> stl_mask{};
-    for (int i = 0; i < bool_vector_size(obs_data->mask); i++) {
-        stl_mask.push_back(bool_vector_iget(obs_data->mask, i));
-    }
-    return stl_mask;
+    std::vector<bool> mask;
+    mask.reserve(obs_data_get_total_size(obs_data));
+    for (const obs_block_type *obs_block : obs_data->live)
+        for (int i = 0; i < obs_block->size; i++)
+            mask.push_back(obs_block->active_mode[i] == ACTIVE);
+    return mask;
 }
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <optional>
 #include <stdlib.h>
 #include <string.h>
@@ -48,6 +49,14 @@ struct obs_vector_struct {
      * nodes[ ] != NULL) */
     int num_active;
     std::vector<int> step_list;
+    /** Bitmap over report steps, bit set where nodes[step] != NULL.
+     * The update-time step scans walk histories which are mostly
+     * empty per vector, so the next-step lookup skips whole 64-step
+     * words instead of testing node pointers one by one. */
+    std::vector<uint64_t> active_mask;
+    /** Pool owning the summary_obs nodes of this vector; the nodes are
+     * installed as shared references. NULL for other node types. */
+    summary_obs_pool_type *summary_pool;
 };
 
 static int
@@ -101,6 +110,40 @@ __conf_instance_get_restart_nr(const conf_instance_type *conf_instance,
     return obs_restart_nr;
 }
 
+static void obs_vector_mask_set(std::vector<uint64_t> &mask, int index) {
+    size_t word = index / 64;
+    if (word >= mask.size())
+        mask.resize(word + 1, 0);
+    mask[word] |= UINT64_C(1) << (index % 64);
+}
+
+static bool obs_vector_mask_get(const std::vector<uint64_t> &mask, int index) {
+    size_t word = index / 64;
+    if (word >= mask.size())
+        return false;
+    return (mask[word] >> (index % 64)) & 1;
+}
+
+/** The first set bit at position >= start, or -1. Empty words are
+    skipped wholesale and the bit within a word is found with a ctz. */
+static int obs_vector_mask_next(const std::vector<uint64_t> &mask, int start) {
+    if (start < 0)
+        start = 0;
+    size_t word = start / 64;
+    if (word >= mask.size())
+        return -1;
+
+    uint64_t bits = mask[word] & (~UINT64_C(0) << (start % 64));
+    while (true) {
+        if (bits != 0)
+            return (int)(word * 64) + __builtin_ctzll(bits);
+        word++;
+        if (word >= mask.size())
+            return -1;
+        bits = mask[word];
+    }
+}
+
 static void obs_vector_resize(obs_vector_type *vector, int new_size) {
     int current_size = vector_get_size(vector->nodes);
     int i;
@@ -148,6 +191,7 @@ obs_vector_type *obs_vector_alloc(obs_impl_type obs_type, const char *obs_key,
     vector->obs_key = util_alloc_string_copy(obs_key);
     vector->num_active = 0;
     vector->nodes = vector_alloc_new();
+    vector->summary_pool = NULL;
     obs_vector_resize(
         vector, num_reports + 1); /* +1 here ?? Ohh  - these +/- problems. */
 
@@ -178,23 +222,35 @@ obs_vector_get_config_node(const obs_vector_type *obs_vector) {
 
 void obs_vector_free(obs_vector_type *obs_vector) {
     vector_free(obs_vector->nodes);
+    if (obs_vector->summary_pool != NULL)
+        summary_obs_pool_free(obs_vector->summary_pool);
     free(obs_vector->obs_key);
     delete obs_vector;
 }
 
+static void obs_vector_activate_node(obs_vector_type *obs_vector, int index) {
+    if (vector_iget_const(obs_vector->nodes, index) == NULL) {
+        obs_vector->num_active++;
+        obs_vector->step_list.insert(
+            std::lower_bound(obs_vector->step_list.begin(),
+                             obs_vector->step_list.end(), index),
+            index);
+        obs_vector_mask_set(obs_vector->active_mask, index);
+    }
+}
+
 void obs_vector_install_node(obs_vector_type *obs_vector, int index,
                              void *node) {
-    {
-        if (vector_iget_const(obs_vector->nodes, index) == NULL) {
-            obs_vector->num_active++;
-            obs_vector->step_list.push_back(index);
-            std::sort(obs_vector->step_list.begin(),
-                      obs_vector->step_list.end());
-        }
+    obs_vector_activate_node(obs_vector, index);
+    vector_iset_owned_ref(obs_vector->nodes, index, node, obs_vector->freef);
+}
 
-        vector_iset_owned_ref(obs_vector->nodes, index, node,
-                              obs_vector->freef);
-    }
+/** For nodes owned elsewhere (i.e. the summary_pool) - the per node
+    freef is not invoked for these. */
+static void obs_vector_install_node_shared(obs_vector_type *obs_vector,
+                                           int index, void *node) {
+    obs_vector_activate_node(obs_vector, index);
+    vector_iset_ref(obs_vector->nodes, index, node);
 }
 
 /**
@@ -206,9 +262,11 @@ static void obs_vector_add_summary_obs(obs_vector_type *obs_vector,
                                        int obs_index, const char *summary_key,
                                        const char *obs_key, double value,
                                        double std) {
-    summary_obs_type *summary_obs =
-        summary_obs_alloc(summary_key, obs_key, value, std);
-    obs_vector_install_node(obs_vector, obs_index, summary_obs);
+    if (obs_vector->summary_pool == NULL)
+        obs_vector->summary_pool = summary_obs_pool_alloc();
+    summary_obs_type *summary_obs = summary_obs_alloc_pooled(
+        obs_vector->summary_pool, summary_key, obs_key, value, std);
+    obs_vector_install_node_shared(obs_vector, obs_index, summary_obs);
 }
 
 int obs_vector_get_num_active(const obs_vector_type *vector) {
@@ -225,13 +283,7 @@ bool obs_vector_iget_active(const obs_vector_type *vector, int index) {
     if (index >= vector_get_size(vector->nodes))
         return false;
 
-    {
-        void *obs_data = (void *)vector_iget(vector->nodes, index);
-        if (obs_data != NULL)
-            return true;
-        else
-            return false;
-    }
+    return obs_vector_mask_get(vector->active_mask, index);
 }
 
 /**
@@ -257,18 +309,11 @@ int obs_vector_get_next_active_step(const obs_vector_type *obs_vector,
                                     int prev_step) {
     if (prev_step >= (vector_get_size(obs_vector->nodes) - 1))
         return -1;
-    else {
-        int size = vector_get_size(obs_vector->nodes);
-        int next_step = prev_step + 1;
-        while ((next_step < size) &&
-               (obs_vector_iget_node(obs_vector, next_step) == NULL))
-            next_step++;
-
-        if (next_step == size)
-            return -1; /* No more active steps. */
-        else
-            return next_step;
-    }
+
+    int next_step = obs_vector_mask_next(obs_vector->active_mask, prev_step + 1);
+    if (next_step >= vector_get_size(obs_vector->nodes))
+        return -1;
+    return next_step;
 }
 
 /**
@@ -429,15 +474,9 @@ obs_vector_type *obs_vector_alloc_from_GENERAL_OBSERVATION(
  */
 static bool read_history_from_ecl_summary(const history_source_type history,
                                           const char *summary_key,
-                                          double_vector_type *value,
-                                          bool_vector_type *valid,
+                                          std::vector<double> &value,
+                                          std::vector<bool> &valid,
                                           const ecl_sum_type *refcase) {
-    bool initOK = false;
-
-    double_vector_reset(value);
-    bool_vector_reset(valid);
-    bool_vector_set_default(valid, false);
-
     std::optional<std::string> local_key = std::nullopt;
     if (history == REFCASE_HISTORY) {
         /* Must create a new key with 'H' for historical values. */
@@ -457,25 +496,28 @@ static bool read_history_from_ecl_summary(const history_source_type history,
     } else
         local_key = std::string(summary_key);
 
-    if (local_key.has_value()) {
-        if (ecl_sum_has_general_var(refcase, local_key.value().c_str())) {
-            for (int tstep = 0; tstep <= ecl_sum_get_last_report_step(refcase);
-                 tstep++) {
-                if (ecl_sum_has_report_step(refcase, tstep)) {
-                    int time_index = ecl_sum_iget_report_end(refcase, tstep);
-                    double_vector_iset(
-                        value, tstep,
-                        ecl_sum_get_general_var(refcase, time_index,
-                                                local_key.value().c_str()));
-                    bool_vector_iset(valid, tstep, true);
-                } else
-                    bool_vector_iset(valid, tstep,
-                                     false); /* Did not have this report step */
-            }
-            initOK = true;
+    if (!local_key.has_value() ||
+        !ecl_sum_has_general_var(refcase, local_key.value().c_str()))
+        return false;
+
+    int last_report = ecl_sum_get_last_report_step(refcase);
+    value.assign(last_report + 1, 0.0);
+    valid.assign(last_report + 1, false);
+
+    /* The key is resolved to its params index once; the whole history
+       vector is then pulled with plain indexed reads instead of one
+       string hash lookup per report step - this loop runs once per
+       observed key, i.e. wells x steps times per case open. */
+    int params_index =
+        ecl_sum_get_general_var_params_index(refcase, local_key.value().c_str());
+    for (int tstep = 0; tstep <= last_report; tstep++) {
+        if (ecl_sum_has_report_step(refcase, tstep)) {
+            int time_index = ecl_sum_iget_report_end(refcase, tstep);
+            value[tstep] = ecl_sum_iget(refcase, time_index, params_index);
+            valid[tstep] = true;
         }
     }
-    return initOK;
+    return true;
 }
 
 // Should check the refcase for key - if it is != NULL.
@@ -493,9 +535,8 @@ bool obs_vector_load_from_HISTORY_OBSERVATION(
     {
         bool initOK = false;
         int size, restart_nr;
-        double_vector_type *value = double_vector_alloc(0, 0);
-        double_vector_type *std = double_vector_alloc(0, 0);
-        bool_vector_type *valid = bool_vector_alloc(0, false);
+        std::vector<double> value;
+        std::vector<bool> valid;
 
         double error =
             conf_instance_get_item_value_double(conf_instance, "ERROR");
@@ -509,22 +550,25 @@ bool obs_vector_load_from_HISTORY_OBSERVATION(
         size = time_map_get_last_step(obs_time) + 1;
         if (read_history_from_ecl_summary(history, sum_key, value, valid,
                                           refcase)) {
+            // The refcase history may be shorter than the observation
+            // time map; the missing tail stays invalid.
+            if ((int)value.size() < size) {
+                value.resize(size, 0.0);
+                valid.resize(size, false);
+            }
+            std::vector<double> std(value.size(), 0.0);
+
             // Create  the standard deviation vector
             if (strcmp(error_mode, "ABS") == 0) {
                 for (restart_nr = 0; restart_nr < size; restart_nr++)
-                    double_vector_iset(std, restart_nr, error);
+                    std[restart_nr] = error;
             } else if (strcmp(error_mode, "REL") == 0) {
                 for (restart_nr = 0; restart_nr < size; restart_nr++)
-                    double_vector_iset(std, restart_nr,
-                                       error * std::abs(double_vector_iget(
-                                                   value, restart_nr)));
+                    std[restart_nr] = error * std::abs(value[restart_nr]);
             } else if (strcmp(error_mode, "RELMIN") == 0) {
-                for (restart_nr = 0; restart_nr < size; restart_nr++) {
-                    double tmp_std = util_double_max(
-                        error_min, error * std::abs(double_vector_iget(
-                                               value, restart_nr)));
-                    double_vector_iset(std, restart_nr, tmp_std);
-                }
+                for (restart_nr = 0; restart_nr < size; restart_nr++)
+                    std[restart_nr] = util_double_max(
+                        error_min, error * std::abs(value[restart_nr]));
             } else
                 util_abort("%s: Internal error. Unknown error mode \"%s\"\n",
                            __func__, error_mode);
@@ -584,23 +628,18 @@ bool obs_vector_load_from_HISTORY_OBSERVATION(
                     if (strcmp(error_mode_segment, "ABS") == 0) {
                         for (restart_nr = start; restart_nr <= stop;
                              restart_nr++)
-                            double_vector_iset(std, restart_nr, error_segment);
+                            std[restart_nr] = error_segment;
                     } else if (strcmp(error_mode_segment, "REL") == 0) {
                         for (restart_nr = start; restart_nr <= stop;
                              restart_nr++)
-                            double_vector_iset(std, restart_nr,
-                                               error_segment *
-                                                   std::abs(double_vector_iget(
-                                                       value, restart_nr)));
+                            std[restart_nr] =
+                                error_segment * std::abs(value[restart_nr]);
                     } else if (strcmp(error_mode_segment, "RELMIN") == 0) {
                         for (restart_nr = start; restart_nr <= stop;
-                             restart_nr++) {
-                            double tmp_std = util_double_max(
+                             restart_nr++)
+                            std[restart_nr] = util_double_max(
                                 error_min_segment,
-                                error_segment * std::abs(double_vector_iget(
-                                                    value, restart_nr)));
-                            double_vector_iset(std, restart_nr, tmp_std);
-                        }
+                                error_segment * std::abs(value[restart_nr]));
                     } else
                         util_abort(
                             "%s: Internal error. Unknown error mode \"%s\"\n",
@@ -613,12 +652,12 @@ bool obs_vector_load_from_HISTORY_OBSERVATION(
         This is where the summary observations are finally added.
       */
             for (restart_nr = 0; restart_nr < size; restart_nr++) {
-                if (bool_vector_safe_iget(valid, restart_nr)) {
-                    if (double_vector_iget(std, restart_nr) > std_cutoff) {
-                        obs_vector_add_summary_obs(
-                            obs_vector, restart_nr, sum_key, sum_key,
-                            double_vector_iget(value, restart_nr),
-                            double_vector_iget(std, restart_nr));
+                if (valid[restart_nr]) {
+                    if (std[restart_nr] > std_cutoff) {
+                        obs_vector_add_summary_obs(obs_vector, restart_nr,
+                                                   sum_key, sum_key,
+                                                   value[restart_nr],
+                                                   std[restart_nr]);
                     } else
                         fprintf(stderr,
                                 "** Warning: to small observation error in "
@@ -628,9 +667,6 @@ bool obs_vector_load_from_HISTORY_OBSERVATION(
             }
             initOK = true;
         }
-        double_vector_free(std);
-        double_vector_free(value);
-        bool_vector_free(valid);
         return initOK;
     }
 }
@@ -782,6 +818,11 @@ static double obs_vector_chi2__(const obs_vector_type *obs_vector,
    complete ensemble, altough this function only operates on part of
    it.
 
+   Per step the members are measured into a meas_block through the
+   normal measure machinery and the whole block is evaluated against
+   its observation block with the fused obs_block_chi2() kernel,
+   instead of one scalar chi2 call per (member, observation).
+
    This will not work for container observations .....
 */
 void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
@@ -789,32 +830,54 @@ void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
                               int step1, int step2, int iens1, int iens2,
                               double **chi2) {
 
-    int step;
+    int ens_size = bool_vector_size(valid);
+    std::vector<bool> ens_mask(ens_size, false);
+    for (int iens = iens1; iens < iens2; iens++)
+        ens_mask[iens] = true;
+
     enkf_node_type *enkf_node = enkf_node_alloc(obs_vector->config_node);
+    std::vector<double> member_chi2(ens_size);
+    std::vector<bool> loaded(ens_size);
     node_id_type node_id;
-    for (step = step1; step <= step2; step++) {
-        int iens;
+
+    for (int step = step1; step <= step2; step++) {
         node_id.report_step = step;
-        {
-            void *obs_node = (void *)vector_iget(obs_vector->nodes, step);
+        void *obs_node = (void *)vector_iget(obs_vector->nodes, step);
 
-            if (obs_node == NULL) {
-                for (iens = iens1; iens < iens2; iens++)
-                    chi2[step][iens] = 0;
-            } else {
-                for (iens = iens1; iens < iens2; iens++) {
-                    node_id.iens = iens;
-                    if (enkf_node_try_load(enkf_node, fs, node_id))
-                        chi2[step][iens] = obs_vector_chi2__(
-                            obs_vector, step, enkf_node, node_id);
-                    else {
-                        chi2[step][iens] = 0;
-                        // Missing data - this member will be marked as invalid in the misfit calculations.
-                        bool_vector_iset(valid, iens, false);
-                    }
-                }
-            }
+        if (obs_node == NULL) {
+            for (int iens = iens1; iens < iens2; iens++)
+                chi2[step][iens] = 0;
+            continue;
         }
+
+        obs_data_type *obs_data = obs_data_alloc(1.0);
+        meas_data_type *meas_data = meas_data_alloc(ens_mask);
+        obs_vector->get_obs(obs_node, obs_data, fs, step);
+
+        std::fill(loaded.begin(), loaded.end(), false);
+        bool any_loaded = false;
+        for (int iens = iens1; iens < iens2; iens++) {
+            node_id.iens = iens;
+            if (enkf_node_try_load(enkf_node, fs, node_id)) {
+                obs_vector->measure(obs_node, enkf_node_value_ptr(enkf_node),
+                                    node_id, meas_data);
+                loaded[iens] = true;
+                any_loaded = true;
+            } else
+                // Missing data - this member will be marked as invalid in the misfit calculations.
+                bool_vector_iset(valid, iens, false);
+        }
+
+        if (any_loaded)
+            obs_block_chi2(obs_data_iget_block(obs_data, 0),
+                           meas_data_iget_block(meas_data, 0),
+                           member_chi2.data());
+
+        for (int iens = iens1; iens < iens2; iens++)
+            chi2[step][iens] = loaded[iens] ? member_chi2[iens] : 0;
+
+        meas_data_free(meas_data);
+        obs_data_free(obs_data);
     }
     enkf_node_free(enkf_node);
 }
@@ -1,10 +1,15 @@
 #include <Eigen/Dense>
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
+#include <ert/concurrency.hpp>
+#include <ert/eigen_threads.hpp>
+#include <ert/gemm_backend.hpp>
 #include <ert/enkf/row_scaling.hpp>
 #include <ert/python.hpp>
 #include <ert/util/util.hpp>
@@ -91,8 +96,6 @@ void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
     if (X0.cols() != X0.rows())
         throw std::invalid_argument("X0 matrix is not quadratic");
 
-    Eigen::MatrixXd X = Eigen::MatrixXd::Zero(X0.rows(), X0.cols());
-
     // The sort_index vector is an index permutation corresponding to sorted
     // row_scaling data.
     std::vector<int> sort_index(this->size());
@@ -102,58 +105,62 @@ void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
                   return this->operator[](index1) > this->operator[](index2);
               });
 
-    // This is a double while loop where we eventually go through all the rows
-    // in the A matrix / row_scaling vector. In the inner loop we identify a
-    // list of rows which have the same row_scaling value, then we scale the X
-    // matrix according to this shared alpha value and calculate the update.
+    // 1: Group rows with the same alpha value. The values are sorted in
+    //    descending order, so once alpha reaches 0.0 the remaining rows
+    //    need no update at all.
+    std::vector<std::pair<double, std::vector<int>>> row_groups;
     std::size_t index_offset = 0;
-    while (true) {
-        if (index_offset == m_data.size())
-            break;
-
+    while (index_offset < m_data.size()) {
         auto end_index = index_offset;
         auto current_alpha = m_data[sort_index[end_index]];
-        std::vector<int> row_list;
-
-        // 1: Identify rows with the same alpha value
-        while (true) {
-            if (end_index == m_data.size())
-                break;
-
-            if (m_data[sort_index[end_index]] != current_alpha)
-                break;
+        if (current_alpha == 0.0)
+            break;
 
+        std::vector<int> row_list;
+        while (end_index < m_data.size() &&
+               m_data[sort_index[end_index]] == current_alpha) {
             row_list.push_back(sort_index[end_index]);
             end_index += 1;
         }
-        if (row_list.empty())
-            break;
-
-        double alpha = m_data[row_list[0]];
-        if (alpha == 0.0)
-            break;
-
-        // 2: Calculate the scaled X matrix
-        scaleX(X, X0, alpha);
-
-        // 3: Calculate A' = A * X for the rows with the same alpha
-        for (const auto &row : row_list) {
-            std::vector<double> target_row(A.cols());
-            Eigen::VectorXd src_row = A.row(row);
-
-            for (int j = 0; j < A.cols(); j++) {
-                target_row[j] = src_row.cwiseProduct(X.col(j)).sum();
-            }
-
-            if (row < 0 || row >= A.rows())
-                throw std::invalid_argument("Invalid row index");
-
-            for (int j = 0; j < A.cols(); j++)
-                A(row, j) = target_row.data()[j];
-        }
-
+        row_groups.emplace_back(current_alpha, std::move(row_list));
         index_offset = end_index;
     }
+
+    // 2: For each group, gather the rows into a contiguous block, apply
+    //    the scaled X matrix with a single GEMM, and scatter the result
+    //    back. The groups touch disjoint rows of A and use their own
+    //    scaled copy of X, so they can be processed concurrently.
+    // The groups are already processed concurrently - pin Eigen single
+    // threaded for the per-group GEMMs to avoid oversubscription.
+    ert::EigenSingleThreadScope single_threaded_gemms;
+    Semafoor concurrently_executing_threads(
+        std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> futures;
+    futures.reserve(row_groups.size());
+    for (const auto &group : row_groups) {
+        futures.push_back(std::async(
+            std::launch::async,
+            [&A, &X0](const std::pair<double, std::vector<int>> &group,
+                      Semafoor &execution_limiter) {
+                std::scoped_lock lock(execution_limiter);
+                const auto &row_list = group.second;
+
+                Eigen::MatrixXd X(X0.rows(), X0.cols());
+                scaleX(X, X0, group.first);
+
+                Eigen::MatrixXd block(row_list.size(), A.cols());
+                for (std::size_t i = 0; i < row_list.size(); i++)
+                    block.row(i) = A.row(row_list[i]);
+                // Large groups offload to the GPU in cuBLAS builds;
+                // small ones are plain (single threaded) Eigen.
+                ert::gemm_inplace(block, X);
+                for (std::size_t i = 0; i < row_list.size(); i++)
+                    A.row(row_list[i]) = block.row(i);
+            },
+            std::cref(group), std::ref(concurrently_executing_threads)));
+    }
+    for (auto &future : futures)
+        future.get();
 }
 
 void RowScaling::assign_vector(const float *data, size_t size) {
@@ -1,15 +1,17 @@
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 
-#include <fstream>
+#include <cstring>
 #include <mutex>
-#include <pthread.h>
 #include <stdexcept>
 #include <stdlib.h>
 
-#include <ert/util/bool_vector.h>
-#include <ert/util/int_vector.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <ert/util/util.h>
 
 #include <ert/enkf/enkf_types.hpp>
@@ -21,47 +23,82 @@
 namespace fs = std::filesystem;
 
 namespace {
-void read_libecl_vector(std::istream &s, std::vector<int> &v) {
-    std::int32_t length{};
-    s.read(reinterpret_cast<char *>(&length), sizeof(length));
-
-    /* default_value is used by libecl's auto-resizeable vector_type to fill in
-     * the gaps. We don't do that here, but we still have to read the value. */
-    std::int32_t default_value{};
-    s.read(reinterpret_cast<char *>(&default_value), sizeof(default_value));
+/**
+   Flat binary layout for the state-map file: a {magic, version, size}
+   header followed by the per-realisation states as int32, written and
+   read back with one syscall each. The file is touched at every case
+   sync and mount; files written by older versions (libecl vector
+   format, which never starts with the magic) are still parsed from
+   the same single read.
+*/
+constexpr std::uint32_t STATE_MAP_MAGIC = 0x534d4131; /* "SMA1" */
+constexpr std::uint32_t STATE_MAP_VERSION = 1;
 
-    v.resize(length);
-    s.read(reinterpret_cast<char *>(&v[0]), sizeof(v[0]) * v.size());
-}
+struct state_map_header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+};
 
-void write_libecl_vector(std::ostream &s, const std::vector<int> &v) {
-    std::int32_t length = v.size();
-    s.write(reinterpret_cast<const char *>(&length), sizeof(length));
+bool parse_state_map_buffer(const std::vector<char> &buffer,
+                            std::vector<int> &values) {
+    state_map_header header;
+    if (buffer.size() >= sizeof(header) &&
+        (memcpy(&header, buffer.data(), sizeof(header)),
+         header.magic == STATE_MAP_MAGIC)) {
+        if (buffer.size() < sizeof(header) + header.size * sizeof(std::int32_t))
+            return false;
+        values.resize(header.size);
+        memcpy(values.data(), buffer.data() + sizeof(header),
+               header.size * sizeof(std::int32_t));
+        return true;
+    }
 
-    /* default_value is used by libecl's auto-resizeable vector_type to fill in
-     * the gaps. We don't do that here, but we still have to write the value. */
-    std::int32_t default_value{};
-    s.write(reinterpret_cast<const char *>(&default_value),
-            sizeof(default_value));
+    // Legacy libecl vector format: int32 length, int32 default value,
+    // then the data.
+    std::int32_t length;
+    if (buffer.size() < 2 * sizeof(std::int32_t))
+        return false;
+    memcpy(&length, buffer.data(), sizeof(length));
+    if (length < 0 || buffer.size() < (2 + (size_t)length) * sizeof(std::int32_t))
+        return false;
+    values.resize(length);
+    memcpy(values.data(), buffer.data() + 2 * sizeof(std::int32_t),
+           length * sizeof(std::int32_t));
+    return true;
+}
 
-    s.write(reinterpret_cast<const char *>(&v[0]), sizeof(v[0]) * v.size());
+std::shared_ptr<std::vector<std::atomic<int>>>
+alloc_state_block(const std::vector<int> &values) {
+    auto block = std::make_shared<std::vector<std::atomic<int>>>(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        (*block)[i].store(values[i], std::memory_order_relaxed);
+    return block;
 }
 } // namespace
 
-int StateMap::size() const {
-    std::lock_guard guard{m_mutex};
-    return m_state.size();
+StateMap::StateMap(unsigned ensemble_size) {
+    m_state =
+        alloc_state_block(std::vector<int>(ensemble_size, STATE_UNDEFINED));
 }
 
+int StateMap::size() const { return std::atomic_load(&m_state)->size(); }
+
 bool StateMap::operator==(const StateMap &other) const {
-    std::scoped_lock lock{m_mutex, other.m_mutex};
-    return m_state == other.m_state;
+    auto lhs = std::atomic_load(&m_state);
+    auto rhs = std::atomic_load(&other.m_state);
+    if (lhs->size() != rhs->size())
+        return false;
+    for (size_t i = 0; i < lhs->size(); ++i)
+        if ((*lhs)[i].load() != (*rhs)[i].load())
+            return false;
+    return true;
 }
 
 realisation_state_enum StateMap::get(int index) const {
-    std::lock_guard guard{m_mutex};
-    if (index < m_state.size())
-        return static_cast<realisation_state_enum>(m_state.at(index));
+    auto state = std::atomic_load(&m_state);
+    if (index >= 0 && index < (int)state->size())
+        return static_cast<realisation_state_enum>((*state)[index].load());
     return realisation_state_enum::STATE_UNDEFINED;
 }
 
@@ -89,23 +126,52 @@ bool StateMap::is_legal_transition(realisation_state_enum state1,
 }
 
 void StateMap::set(int index, realisation_state_enum new_state) {
-    std::lock_guard lock{m_mutex};
-
-    auto current_state = static_cast<realisation_state_enum>(m_state.at(index));
+    auto state = std::atomic_load(&m_state);
+    if (index < 0 || index >= (int)state->size())
+        throw std::out_of_range("StateMap::set");
 
-    if (is_legal_transition(current_state, new_state))
-        m_state[index] = new_state;
-    else
-        util_abort(
-            "%s: illegal state transition for realisation:%d %d -> %d \n",
-            __func__, index, current_state, new_state);
+    auto &slot = (*state)[index];
+    int current = slot.load();
+    // CAS loop - the transition check and the store are one atomic
+    // step, so the queue and monitoring threads never serialize on a
+    // lock here.
+    while (true) {
+        if (!is_legal_transition(static_cast<realisation_state_enum>(current),
+                                 new_state))
+            util_abort(
+                "%s: illegal state transition for realisation:%d %d -> %d \n",
+                __func__, index, current, new_state);
+        if (slot.compare_exchange_weak(current, new_state))
+            break;
+    }
+    m_version.fetch_add(1);
+    notify_change();
 }
 
 void StateMap::update_matching(size_t index, int state_mask,
                                realisation_state_enum new_state) {
-    realisation_state_enum current_state = get(index);
-    if (current_state & state_mask)
-        set(index, new_state);
+    auto state = std::atomic_load(&m_state);
+    if (index >= state->size())
+        return;
+
+    auto &slot = (*state)[index];
+    int current = slot.load();
+    while (current & state_mask) {
+        if (!is_legal_transition(static_cast<realisation_state_enum>(current),
+                                 new_state))
+            util_abort(
+                "%s: illegal state transition for realisation:%zu %d -> %d \n",
+                __func__, index, current, new_state);
+        if (slot.compare_exchange_weak(current, new_state)) {
+            m_version.fetch_add(1);
+            notify_change();
+            break;
+        }
+    }
+}
+
+bool StateMap::dirty() const {
+    return m_version.load() != m_synced_version.load();
 }
 
 void StateMap::write(const fs::path &path) const {
@@ -113,34 +179,97 @@ void StateMap::write(const fs::path &path) const {
 
     std::error_code ec;
     fs::create_directories(path.parent_path(), ec /* Error-code is ignored */);
-    std::ofstream stream{path};
 
-    if (!stream.is_open())
+    // Mutations racing with the snapshot keep the map dirty and are
+    // picked up by the next flush.
+    std::uint64_t version = m_version.load();
+    auto state = std::atomic_load(&m_state);
+
+    std::vector<char> buffer(sizeof(state_map_header) +
+                             state->size() * sizeof(std::int32_t));
+    state_map_header header = {STATE_MAP_MAGIC, STATE_MAP_VERSION,
+                               (std::uint32_t)state->size()};
+    memcpy(buffer.data(), &header, sizeof(header));
+    for (size_t i = 0; i < state->size(); ++i) {
+        std::int32_t value = (*state)[i].load();
+        memcpy(buffer.data() + sizeof(header) + i * sizeof(std::int32_t),
+               &value, sizeof(value));
+    }
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
         util_abort("%s: failed to open:%s for writing \n", __func__,
                    path.c_str());
+    if (::write(fd, buffer.data(), buffer.size()) != (ssize_t)buffer.size())
+        util_abort("%s: failed to write:%s \n", __func__, path.c_str());
+    ::close(fd);
 
-    stream.exceptions(stream.failbit);
-    write_libecl_vector(stream, m_state);
+    m_synced_version.store(version);
 }
 
 bool StateMap::read(const fs::path &filename) {
     std::lock_guard lock{m_mutex};
-    std::ifstream stream{filename};
-    try {
-        stream.exceptions(stream.failbit);
-        read_libecl_vector(stream, m_state);
-        return true;
-    } catch (std::ios_base::failure &) {
-        std::fill(m_state.begin(), m_state.end(), STATE_UNDEFINED);
-        return false;
+    std::vector<int> values(std::atomic_load(&m_state)->size(),
+                            STATE_UNDEFINED);
+    bool read_ok = false;
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            std::vector<char> buffer(st.st_size);
+            if (::read(fd, buffer.data(), buffer.size()) ==
+                (ssize_t)buffer.size())
+                read_ok = parse_state_map_buffer(buffer, values);
+        }
+        ::close(fd);
+    }
+    if (!read_ok) {
+        values.assign(std::atomic_load(&m_state)->size(), STATE_UNDEFINED);
     }
+    std::atomic_store(&m_state, alloc_state_block(values));
+    m_version.fetch_add(1);
+    notify_change();
+    // A successful read leaves the map identical to the file.
+    if (read_ok)
+        m_synced_version.store(m_version.load());
+    return read_ok;
+}
+
+void StateMap::notify_change() {
+    /* The empty critical section pairs with the wait in
+       wait_for_change(): a version bump cannot slip between a waiter's
+       predicate check and its sleep. */
+    { std::lock_guard lock{m_version_mutex}; }
+    m_version_cv.notify_all();
+}
+
+StateMap::Snapshot StateMap::snapshot() const {
+    Snapshot snapshot;
+    snapshot.version = m_version.load();
+    auto state = std::atomic_load(&m_state);
+    snapshot.states.resize(state->size());
+    for (size_t i = 0; i < state->size(); ++i) {
+        int value = (*state)[i].load();
+        snapshot.states[i] = value;
+        snapshot.counts[value]++;
+    }
+    return snapshot;
+}
+
+std::uint64_t StateMap::wait_for_change(std::uint64_t last_version,
+                                        double timeout_seconds) const {
+    std::unique_lock lock{m_version_mutex};
+    m_version_cv.wait_for(
+        lock, std::chrono::duration<double>(timeout_seconds),
+        [&] { return m_version.load() != last_version; });
+    return m_version.load();
 }
 
 std::vector<bool> StateMap::select_matching(int select_mask) const {
-    std::lock_guard lock{m_mutex};
-    std::vector<bool> select_target(m_state.size(), false);
-    for (size_t i{}; i < m_state.size(); ++i) {
-        auto state_value = m_state[i];
+    auto state = std::atomic_load(&m_state);
+    std::vector<bool> select_target(state->size(), false);
+    for (size_t i{}; i < state->size(); ++i) {
+        auto state_value = (*state)[i].load();
         if (state_value & select_mask)
             select_target[i] = true;
     }
@@ -165,7 +294,28 @@ ERT_CLIB_SUBMODULE("state_map", m) {
         .def("__len__", &StateMap::size)
         .def("_get", &StateMap::get, "index"_a)
         .def("__setitem__", &StateMap::set, "index"_a, "value"_a)
-        .def("selectMatching", [](const StateMap &x, int mask) {
-            return x.select_matching(mask);
-        });
+        .def("selectMatching",
+             [](const StateMap &x, int mask) {
+                 return x.select_matching(mask);
+             })
+        .def(
+            "snapshot",
+            [](const StateMap &x) {
+                auto snapshot = x.snapshot();
+                return py::make_tuple(snapshot.version, snapshot.states,
+                                      snapshot.counts);
+            },
+            py::doc{"One consistent pass over the map: returns (version, "
+                    "state vector, {state: count})."})
+        .def(
+            "wait_for_change",
+            [](const StateMap &x, std::uint64_t last_version, double timeout) {
+                py::gil_scoped_release release;
+                return x.wait_for_change(last_version, timeout);
+            },
+            py::doc{"Block until the version differs from last_version or "
+                    "the timeout (seconds) expires; returns the current "
+                    "version. Use with snapshot() to wake on transitions "
+                    "instead of polling."},
+            "last_version"_a, "timeout"_a);
 }
@@ -1,5 +1,7 @@
 #include <stdlib.h>
 
+#include <vector>
+
 #include <ert/util/double_vector.h>
 #include <ert/util/util.h>
 
@@ -39,20 +41,39 @@ void summary_read_from_buffer(summary_type *summary, buffer_type *buffer,
 
         double_vector_set_default(summary->data_vector, default_value);
         double_vector_resize(summary->data_vector, size, default_value);
-        buffer_fread(buffer, double_vector_get_ptr(summary->data_vector),
-                     double_vector_element_size(summary->data_vector), size);
+
+        // The payload is float32 for vectors stored by current code
+        // and float64 for vectors stored before the dtype change; the
+        // two are told apart by the remaining byte count. float32 data
+        // is widened transparently - the analysis always sees doubles.
+        if (buffer_get_remaining_size(buffer) ==
+            (size_t)size * sizeof(double))
+            buffer_fread(buffer, double_vector_get_ptr(summary->data_vector),
+                         double_vector_element_size(summary->data_vector),
+                         size);
+        else {
+            std::vector<float> values(size);
+            buffer_fread(buffer, values.data(), sizeof(float), size);
+            for (int index = 0; index < size; index++)
+                double_vector_iset(summary->data_vector, index, values[index]);
+        }
     }
 }
 
 bool summary_write_to_buffer(const summary_type *summary, buffer_type *buffer,
                              int report_step) {
+    int size = double_vector_size(summary->data_vector);
     buffer_fwrite_int(buffer, SUMMARY);
-    buffer_fwrite_int(buffer, double_vector_size(summary->data_vector));
+    buffer_fwrite_int(buffer, size);
     buffer_fwrite_double(buffer,
                          double_vector_get_default(summary->data_vector));
-    buffer_fwrite(buffer, double_vector_get_ptr(summary->data_vector),
-                  double_vector_element_size(summary->data_vector),
-                  double_vector_size(summary->data_vector));
+
+    // Summary data is single precision at origin - the simulator
+    // writes float32 - so storing float32 halves the storage footprint
+    // and read bandwidth with no information loss.
+    const double *data = double_vector_get_ptr(summary->data_vector);
+    std::vector<float> values(data, data + size);
+    buffer_fwrite(buffer, values.data(), sizeof(float), size);
     return true;
 }
 
@@ -96,6 +117,23 @@ void summary_set(summary_type *summary, int report_step, double value) {
 
 double summary_undefined_value() { return SUMMARY_UNDEF; }
 
+double summary_get_default_value(const summary_type *summary) {
+    return double_vector_get_default(summary->data_vector);
+}
+
+/** Replace the node content with values - the deserialization
+    counterpart of summary_user_get_vector(), used when the node is
+    populated from a columnar summary block. */
+void summary_set_vector(summary_type *summary,
+                        const std::vector<double> &values,
+                        double default_value) {
+    double_vector_reset(summary->data_vector);
+    double_vector_set_default(summary->data_vector, default_value);
+    double_vector_resize(summary->data_vector, values.size(), default_value);
+    for (size_t step = 0; step < values.size(); step++)
+        double_vector_iset(summary->data_vector, step, values[step]);
+}
+
 std::vector<double> summary_user_get_vector(const summary_type *summary) {
     std::vector<double> values(double_vector_size(summary->data_vector));
     for (int step = 0; step < double_vector_size(summary->data_vector); step++)
@@ -103,9 +141,18 @@ std::vector<double> summary_user_get_vector(const summary_type *summary) {
     return values;
 }
 
+/**
+   @param params_time_index maps every store index to the row in the
+   ecl_sum params matrix holding the value for that report step, or -1
+   when the step has no data. The map only depends on the summary
+   handle, so the caller resolves it once per realization and shares
+   it between all keys - the per-key work is then a plain indexed
+   gather from the already parsed summary data.
+*/
 bool summary_forward_load_vector(summary_type *summary,
                                  const ecl_sum_type *ecl_sum,
-                                 const int_vector_type *time_index) {
+                                 const std::vector<int> &time_index,
+                                 const std::vector<int> &params_time_index) {
     bool loadOK = false;
 
     if (ecl_sum == NULL)
@@ -121,11 +168,9 @@ bool summary_forward_load_vector(summary_type *summary,
         // will fill the vector with zeros.
 
         if (!ecl_sum_has_general_var(ecl_sum, var_key)) {
-            for (int step = 0; step < int_vector_size(time_index); step++) {
-                int summary_step = int_vector_iget(time_index, step);
+            for (int summary_step : time_index)
                 if (summary_step >= 0)
                     double_vector_iset(summary->data_vector, summary_step, 0);
-            }
             loadOK = true;
 
             if (load_fail_action == LOAD_FAIL_WARN)
@@ -141,23 +186,31 @@ bool summary_forward_load_vector(summary_type *summary,
         return loadOK;
 
     int key_index = ecl_sum_get_general_var_params_index(ecl_sum, var_key);
-    for (int store_index = 0; store_index < int_vector_size(time_index);
+    for (size_t store_index = 0; store_index < params_time_index.size();
          store_index++) {
-        int summary_index = int_vector_iget(time_index, store_index);
-
-        if (summary_index >= 0) {
-            if (ecl_sum_has_report_step(ecl_sum, summary_index)) {
-                int last_update_step_index =
-                    ecl_sum_iget_report_end(ecl_sum, summary_index);
-                double_vector_iset(
-                    summary->data_vector, store_index,
-                    ecl_sum_iget(ecl_sum, last_update_step_index, key_index));
-            }
-        }
+        int params_index = params_time_index[store_index];
+        if (params_index >= 0)
+            double_vector_iset(summary->data_vector, store_index,
+                               ecl_sum_iget(ecl_sum, params_index, key_index));
     }
     return true;
 }
 
+std::vector<int>
+summary_params_time_index(const ecl_sum_type *ecl_sum,
+                          const std::vector<int> &time_index) {
+    std::vector<int> params_time_index(time_index.size(), -1);
+    for (size_t store_index = 0; store_index < time_index.size();
+         store_index++) {
+        int summary_index = time_index[store_index];
+        if (summary_index >= 0 &&
+            ecl_sum_has_report_step(ecl_sum, summary_index))
+            params_time_index[store_index] =
+                ecl_sum_iget_report_end(ecl_sum, summary_index);
+    }
+    return params_time_index;
+}
+
 VOID_ALLOC(summary)
 VOID_FREE(summary)
 VOID_WRITE_TO_BUFFER(summary)
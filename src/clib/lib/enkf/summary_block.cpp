@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstdint>
+
+#include <ert/enkf/summary_block.hpp>
+
+namespace {
+
+/**
+   On-disk record layout, following the buffer timestamp written by the
+   storage layer:
+
+     int32   magic     SUMMARY_BLOCK_MAGIC ("SBK1")
+     int32   version   1
+     int32   num_keys
+     int32   num_steps
+     double  default_value
+     per key: int32 length, raw key bytes
+     float   matrix[num_keys * num_steps], one row per key in key order
+
+   Rows shorter than num_steps at write time are padded with the
+   default value, so every row deserializes to the same length. The
+   payload is float32 for the same reason the per-key vectors are:
+   summary data is single precision at origin.
+*/
+const std::int32_t SUMMARY_BLOCK_MAGIC = 0x53424b31;
+const std::int32_t SUMMARY_BLOCK_VERSION = 1;
+
+} // namespace
+
+std::vector<double> SummaryBlock::get(const std::string &key) const {
+    return get_window(key, 0, m_num_steps);
+}
+
+std::vector<double> SummaryBlock::get_window(const std::string &key,
+                                             int step_offset,
+                                             int step_count) const {
+    auto it = m_rows.find(key);
+    if (it == m_rows.end())
+        return {};
+    if (step_offset < 0) {
+        step_count += step_offset;
+        step_offset = 0;
+    }
+    if (step_offset >= m_num_steps || step_count <= 0)
+        return {};
+    int window = std::min(step_count, m_num_steps - step_offset);
+
+    const std::vector<float> &row = it->second;
+    std::vector<double> values(window, m_default_value);
+    for (int step = step_offset;
+         step < std::min(step_offset + window, (int)row.size()); step++)
+        values[step - step_offset] = row[step];
+    return values;
+}
+
+void SummaryBlock::set(const std::string &key, const double *values,
+                       int size) {
+    auto [it, inserted] = m_rows.try_emplace(key);
+    if (inserted)
+        m_keys.push_back(key);
+    it->second.assign(values, values + size);
+    m_num_steps = std::max(m_num_steps, size);
+}
+
+void SummaryBlock::write_to_buffer(buffer_type *buffer) const {
+    buffer_fwrite_int(buffer, SUMMARY_BLOCK_MAGIC);
+    buffer_fwrite_int(buffer, SUMMARY_BLOCK_VERSION);
+    buffer_fwrite_int(buffer, m_keys.size());
+    buffer_fwrite_int(buffer, m_num_steps);
+    buffer_fwrite_double(buffer, m_default_value);
+
+    for (const auto &key : m_keys) {
+        buffer_fwrite_int(buffer, key.size());
+        buffer_fwrite(buffer, key.data(), 1, key.size());
+    }
+
+    std::vector<float> row(m_num_steps);
+    for (const auto &key : m_keys) {
+        const std::vector<float> &values = m_rows.at(key);
+        std::fill(row.begin(), row.end(), (float)m_default_value);
+        std::copy(values.begin(), values.end(), row.begin());
+        buffer_fwrite(buffer, row.data(), sizeof(float), m_num_steps);
+    }
+}
+
+std::shared_ptr<SummaryBlock>
+SummaryBlock::read_from_buffer(buffer_type *buffer) {
+    if (buffer_get_remaining_size(buffer) < 4 * sizeof(std::int32_t))
+        return nullptr;
+    if (buffer_fread_int(buffer) != SUMMARY_BLOCK_MAGIC)
+        return nullptr;
+    if (buffer_fread_int(buffer) != SUMMARY_BLOCK_VERSION)
+        return nullptr;
+
+    int num_keys = buffer_fread_int(buffer);
+    int num_steps = buffer_fread_int(buffer);
+    double default_value = buffer_fread_double(buffer);
+    if (num_keys < 0 || num_steps < 0)
+        return nullptr;
+
+    auto block = std::make_shared<SummaryBlock>();
+    block->m_num_steps = num_steps;
+    block->m_default_value = default_value;
+    block->m_keys.reserve(num_keys);
+
+    for (int i = 0; i < num_keys; i++) {
+        int length = buffer_fread_int(buffer);
+        if (length < 0 ||
+            buffer_get_remaining_size(buffer) < (size_t)length)
+            return nullptr;
+        std::string key(length, '\0');
+        buffer_fread(buffer, key.data(), 1, length);
+        block->m_keys.push_back(std::move(key));
+    }
+
+    if (buffer_get_remaining_size(buffer) <
+        (size_t)num_keys * num_steps * sizeof(float))
+        return nullptr;
+    for (const auto &key : block->m_keys) {
+        std::vector<float> row(num_steps);
+        buffer_fread(buffer, row.data(), sizeof(float), num_steps);
+        block->m_rows.emplace(key, std::move(row));
+    }
+    return block;
+}
@@ -8,13 +8,15 @@
 #include <ert/ecl/ecl_sum.h>
 
 #include <ert/enkf/summary_config.hpp>
+#include <ert/res_util/string.hpp>
 
 struct summary_config_struct {
     load_fail_type load_fail;
     /** The type of the variable - according to ecl_summary nomenclature. */
     ecl_smspec_var_type var_type;
-    /** This is ONE variable of summary.x format - i.e. WOPR:OP_2, RPR:4, ... */
-    char *var;
+    /** This is ONE variable of summary.x format - i.e. WOPR:OP_2, RPR:4, ...
+        Interned - owned by the ert::intern() pool, never freed here. */
+    const char *var;
     /** Set of keys (which fit in enkf_obs) which are observations of this node. */
     std::set<std::string> obs_set;
 };
@@ -58,17 +60,14 @@ summary_config_type *summary_config_alloc(const char *var,
                                           load_fail_type load_fail) {
     summary_config_type *config = new summary_config_type();
 
-    config->var = util_alloc_string_copy(var);
+    config->var = ert::intern(var);
     config->var_type = ecl_smspec_identify_var_type(var);
     summary_config_set_load_fail_mode(config, load_fail);
 
     return config;
 }
 
-void summary_config_free(summary_config_type *config) {
-    free(config->var);
-    delete config;
-}
+void summary_config_free(summary_config_type *config) { delete config; }
 
 int summary_config_get_data_size(const summary_config_type *config) {
     return 1;
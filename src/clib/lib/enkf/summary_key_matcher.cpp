@@ -1,21 +1,41 @@
 #include <ert/enkf/summary_key_matcher.hpp>
 
-#include <stdlib.h>
+#include <cctype>
+#include <cstring>
+#include <optional>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <ert/util/hash.h>
 
 #define SUMMARY_KEY_MATCHER_TYPE_ID 700672137
 
+/**
+   The matcher holds a compiled index of the configured keys in
+   addition to the key_set hash which backs the public key/required
+   queries. Literal keys (no wildcard) live in a hash set and are
+   matched with one lookup; wildcard patterns are translated to a
+   single regex alternation which is compiled lazily and matches all
+   patterns in one automaton pass. Patterns using fnmatch character
+   classes ('[...]') are rare and keep the util_fnmatch() semantics
+   through a fallback list.
+*/
 struct summary_key_matcher_struct {
     UTIL_TYPE_ID_DECLARATION;
     hash_type *key_set;
+    std::unordered_set<std::string> literal_keys;
+    std::vector<std::string> wildcard_patterns;
+    std::vector<std::string> fnmatch_patterns;
+    mutable std::optional<std::regex> compiled_patterns;
+    mutable bool compiled_valid = true;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(summary_key_matcher, SUMMARY_KEY_MATCHER_TYPE_ID)
 
 summary_key_matcher_type *summary_key_matcher_alloc() {
-    summary_key_matcher_type *matcher =
-        (summary_key_matcher_type *)util_malloc(sizeof *matcher);
+    auto matcher = new summary_key_matcher_type;
     UTIL_TYPE_ID_INIT(matcher, SUMMARY_KEY_MATCHER_TYPE_ID);
     matcher->key_set = hash_alloc();
     return matcher;
@@ -23,38 +43,87 @@ summary_key_matcher_type *summary_key_matcher_alloc() {
 
 void summary_key_matcher_free(summary_key_matcher_type *matcher) {
     hash_free(matcher->key_set);
-    free(matcher);
+    delete matcher;
 }
 
 int summary_key_matcher_get_size(const summary_key_matcher_type *matcher) {
     return hash_get_size(matcher->key_set);
 }
 
+/** Translate one fnmatch pattern to a regex fragment ('*' -> ".*",
+    '?' -> ".", everything else matched literally). */
+static void append_pattern_as_regex(std::string &regex,
+                                    const std::string &pattern) {
+    for (char c : pattern) {
+        switch (c) {
+        case '*':
+            regex += ".*";
+            break;
+        case '?':
+            regex += '.';
+            break;
+        default:
+            if (isalnum((unsigned char)c) || c == '_' || c == ':' || c == ',' ||
+                c == '-')
+                regex += c;
+            else {
+                regex += '\\';
+                regex += c;
+            }
+        }
+    }
+}
+
 void summary_key_matcher_add_summary_key(summary_key_matcher_type *matcher,
                                          const char *summary_key) {
     if (!hash_has_key(matcher->key_set, summary_key)) {
-        hash_insert_int(matcher->key_set, summary_key,
-                        !util_string_has_wildcard(summary_key));
+        bool is_literal = !util_string_has_wildcard(summary_key);
+        hash_insert_int(matcher->key_set, summary_key, is_literal);
+        if (is_literal)
+            matcher->literal_keys.insert(summary_key);
+        else if (strchr(summary_key, '['))
+            matcher->fnmatch_patterns.push_back(summary_key);
+        else {
+            matcher->wildcard_patterns.push_back(summary_key);
+            matcher->compiled_valid = false;
+        }
     }
 }
 
+static void
+summary_key_matcher_assert_compiled(const summary_key_matcher_type *matcher) {
+    if (matcher->compiled_valid)
+        return;
+
+    std::string regex;
+    for (const auto &pattern : matcher->wildcard_patterns) {
+        if (!regex.empty())
+            regex += '|';
+        append_pattern_as_regex(regex, pattern);
+    }
+    matcher->compiled_patterns.emplace(regex, std::regex::optimize);
+    matcher->compiled_valid = true;
+}
+
 bool summary_key_matcher_match_summary_key(
     const summary_key_matcher_type *matcher, const char *summary_key) {
-    stringlist_type *keys = hash_alloc_stringlist(matcher->key_set);
-    bool has_key = false;
-
-    for (int i = 0; i < stringlist_get_size(keys); i++) {
-        const char *pattern = stringlist_iget(keys, i);
-        if (summary_key)
-            if (util_fnmatch(pattern, summary_key) == 0) {
-                has_key = true;
-                break;
-            }
+    if (!summary_key)
+        return false;
+
+    if (matcher->literal_keys.count(summary_key))
+        return true;
+
+    if (!matcher->wildcard_patterns.empty()) {
+        summary_key_matcher_assert_compiled(matcher);
+        if (std::regex_match(summary_key, *matcher->compiled_patterns))
+            return true;
     }
 
-    stringlist_free(keys);
+    for (const auto &pattern : matcher->fnmatch_patterns)
+        if (util_fnmatch(pattern.c_str(), summary_key) == 0)
+            return true;
 
-    return has_key;
+    return false;
 }
 
 stringlist_type *
@@ -1,28 +1,56 @@
 #include <filesystem>
 
-#include <pthread.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <stdlib.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <ert/res_util/file_utils.hpp>
-#include <ert/util/hash.h>
 #include <ert/util/util.h>
 
 #include <ert/enkf/summary_key_set.hpp>
 
 namespace fs = std::filesystem;
 
+using summary_key_snapshot_type = std::unordered_set<std::string>;
+
+/**
+   The key set is kept as an immutable snapshot behind an atomically
+   swapped shared_ptr: readers load the current snapshot and query it
+   without any synchronization, writers build a new snapshot under the
+   write mutex and swap it in (RCU style). This matters because the
+   result loading threads call summary_key_set_has_summary_key() once
+   per key per realization, while writes only happen a handful of
+   times per realization load.
+*/
 struct summary_key_set_struct {
-    hash_type *key_set;
-    pthread_rwlock_t rw_lock;
+    std::shared_ptr<const summary_key_snapshot_type> snapshot;
+    std::mutex write_lock;
     bool read_only;
+    /* Keys only ever accumulate, and across a whole ensemble nearly
+       every realization reports the same set - so after the first few
+       loads the set stops changing and the sync points would keep
+       rewriting an identical file. The version pair makes those syncs
+       no-ops. */
+    std::atomic<std::uint64_t> version;
+    std::atomic<std::uint64_t> synced_version;
 };
 
+static std::shared_ptr<const summary_key_snapshot_type>
+summary_key_set_load_snapshot(const summary_key_set_type *set) {
+    return std::atomic_load(&set->snapshot);
+}
+
 summary_key_set_type *summary_key_set_alloc() {
-    summary_key_set_type *set =
-        (summary_key_set_type *)util_malloc(sizeof *set);
-    set->key_set = hash_alloc();
-    pthread_rwlock_init(&set->rw_lock, NULL);
+    auto set = new summary_key_set_type;
+    set->snapshot = std::make_shared<const summary_key_snapshot_type>();
     set->read_only = false;
+    set->version = 0;
+    set->synced_version = 0;
     return set;
 }
 
@@ -34,61 +62,68 @@ summary_key_set_type *summary_key_set_alloc_from_file(const char *filename,
     return set;
 }
 
-void summary_key_set_free(summary_key_set_type *set) {
-    hash_free(set->key_set);
-    free(set);
-}
+void summary_key_set_free(summary_key_set_type *set) { delete set; }
 
 int summary_key_set_get_size(summary_key_set_type *set) {
-    int size;
-    pthread_rwlock_rdlock(&set->rw_lock);
-    { size = hash_get_size(set->key_set); }
-    pthread_rwlock_unlock(&set->rw_lock);
-    return size;
+    return summary_key_set_load_snapshot(set)->size();
 }
 
 bool summary_key_set_add_summary_key(summary_key_set_type *set,
                                      const char *summary_key) {
-    bool writable_and_non_existent = true;
-
-    pthread_rwlock_wrlock(&set->rw_lock);
-    {
-
-        if (hash_has_key(set->key_set, summary_key)) {
-            writable_and_non_existent = false;
-        }
-
-        if (set->read_only) {
-            writable_and_non_existent = false;
-        }
+    std::lock_guard guard(set->write_lock);
+    if (set->read_only)
+        return false;
+    if (set->snapshot->count(summary_key))
+        return false;
+
+    auto new_snapshot =
+        std::make_shared<summary_key_snapshot_type>(*set->snapshot);
+    new_snapshot->insert(summary_key);
+    std::atomic_store(&set->snapshot,
+                      std::shared_ptr<const summary_key_snapshot_type>(
+                          std::move(new_snapshot)));
+    set->version.fetch_add(1);
+    return true;
+}
 
-        if (writable_and_non_existent) {
-            hash_insert_int(set->key_set, summary_key, 1);
-        }
-    }
-    pthread_rwlock_unlock(&set->rw_lock);
+/**
+   Add a batch of keys with one snapshot copy and one swap, instead of
+   one per key. Returns true if at least one key was added.
+*/
+bool summary_key_set_add_summary_keys(summary_key_set_type *set,
+                                      const std::vector<std::string> &keys) {
+    std::lock_guard guard(set->write_lock);
+    if (set->read_only || keys.empty())
+        return false;
+
+    auto new_snapshot =
+        std::make_shared<summary_key_snapshot_type>(*set->snapshot);
+    size_t old_size = new_snapshot->size();
+    new_snapshot->insert(keys.begin(), keys.end());
+    if (new_snapshot->size() == old_size)
+        return false;
+
+    std::atomic_store(&set->snapshot,
+                      std::shared_ptr<const summary_key_snapshot_type>(
+                          std::move(new_snapshot)));
+    set->version.fetch_add(1);
+    return true;
+}
 
-    return writable_and_non_existent;
+bool summary_key_set_dirty(const summary_key_set_type *set) {
+    return set->version.load() != set->synced_version.load();
 }
 
 bool summary_key_set_has_summary_key(summary_key_set_type *set,
                                      const char *summary_key) {
-    bool has_key = false;
-
-    pthread_rwlock_rdlock(&set->rw_lock);
-    { has_key = hash_has_key(set->key_set, summary_key); }
-    pthread_rwlock_unlock(&set->rw_lock);
-
-    return has_key;
+    return summary_key_set_load_snapshot(set)->count(summary_key) > 0;
 }
 
 stringlist_type *summary_key_set_alloc_keys(summary_key_set_type *set) {
-    stringlist_type *keys;
-
-    pthread_rwlock_rdlock(&set->rw_lock);
-    { keys = hash_alloc_stringlist(set->key_set); }
-    pthread_rwlock_unlock(&set->rw_lock);
-
+    auto snapshot = summary_key_set_load_snapshot(set);
+    stringlist_type *keys = stringlist_alloc_new();
+    for (const auto &key : *snapshot)
+        stringlist_append_copy(keys, key.c_str());
     return keys;
 }
 
@@ -97,46 +132,49 @@ bool summary_key_set_is_read_only(const summary_key_set_type *set) {
 }
 
 void summary_key_set_fwrite(summary_key_set_type *set, const char *filename) {
-    pthread_rwlock_rdlock(&set->rw_lock);
-    {
-        auto stream = mkdir_fopen(fs::path(filename), "w");
-        if (stream) {
-            stringlist_type *keys = hash_alloc_stringlist(set->key_set);
-            stringlist_fwrite(keys, stream);
-            stringlist_free(keys);
-            fclose(stream);
-        } else {
-            util_abort("%s: failed to open: %s for writing \n", __func__,
-                       filename);
-        }
+    // Keys added after the snapshot keep the set dirty and are picked
+    // up by the next sync.
+    std::uint64_t version = set->version.load();
+    auto snapshot = summary_key_set_load_snapshot(set);
+    auto stream = mkdir_fopen(fs::path(filename), "w");
+    if (stream) {
+        stringlist_type *keys = stringlist_alloc_new();
+        for (const auto &key : *snapshot)
+            stringlist_append_copy(keys, key.c_str());
+        stringlist_fwrite(keys, stream);
+        stringlist_free(keys);
+        fclose(stream);
+        set->synced_version.store(version);
+    } else {
+        util_abort("%s: failed to open: %s for writing \n", __func__, filename);
     }
-    pthread_rwlock_unlock(&set->rw_lock);
 }
 
 bool summary_key_set_fread(summary_key_set_type *set, const char *filename) {
     bool file_exists = false;
-    pthread_rwlock_wrlock(&set->rw_lock);
-    {
-        hash_clear(set->key_set);
-
-        if (fs::exists(filename)) {
-            FILE *stream = util_fopen(filename, "r");
-            if (stream) {
-                stringlist_type *key_set = stringlist_fread_alloc(stream);
-
-                for (int i = 0; i < stringlist_get_size(key_set); i++) {
-                    hash_insert_int(set->key_set, stringlist_iget(key_set, i),
-                                    1);
-                }
-                stringlist_free(key_set);
-                fclose(stream);
-            } else {
-                util_abort("%s: failed to open: %s for reading \n", __func__,
-                           filename);
-            }
-            file_exists = true;
+    std::lock_guard guard(set->write_lock);
+
+    auto new_snapshot = std::make_shared<summary_key_snapshot_type>();
+    if (fs::exists(filename)) {
+        FILE *stream = util_fopen(filename, "r");
+        if (stream) {
+            stringlist_type *key_set = stringlist_fread_alloc(stream);
+
+            for (int i = 0; i < stringlist_get_size(key_set); i++)
+                new_snapshot->insert(stringlist_iget(key_set, i));
+            stringlist_free(key_set);
+            fclose(stream);
+        } else {
+            util_abort("%s: failed to open: %s for reading \n", __func__,
+                       filename);
         }
+        file_exists = true;
     }
-    pthread_rwlock_unlock(&set->rw_lock);
+    std::atomic_store(&set->snapshot,
+                      std::shared_ptr<const summary_key_snapshot_type>(
+                          std::move(new_snapshot)));
+    // A successful read leaves the set identical to the file.
+    set->version.fetch_add(1);
+    set->synced_version.store(set->version.load());
     return file_exists;
 }
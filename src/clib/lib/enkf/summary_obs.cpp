@@ -1,7 +1,10 @@
 /*
    See the overview documentation of the observation system in enkf_obs.c
 */
+#include <deque>
 #include <stdlib.h>
+#include <string>
+#include <unordered_set>
 
 #include <ert/util/util.h>
 
@@ -55,6 +58,48 @@ void summary_obs_free(summary_obs_type *summary_obs) {
     free(summary_obs);
 }
 
+/**
+   A history matching case allocates one summary_obs instance per
+   (vector, report step) - easily hundreds of thousands of tiny,
+   pointer-chased heap objects. The pool below slab-allocates the
+   nodes with stable addresses and interns the key strings, which for
+   a typical observation vector are identical across all its report
+   steps. Nodes allocated from a pool are owned by the pool and must
+   never be passed to summary_obs_free().
+*/
+struct summary_obs_pool_struct {
+    /** Slab storage for the nodes; deque keeps the addresses stable. */
+    std::deque<summary_obs_type> nodes;
+    /** Interned key strings, borrowed by the pooled nodes. */
+    std::unordered_set<std::string> keys;
+};
+
+summary_obs_pool_type *summary_obs_pool_alloc() {
+    return new summary_obs_pool_type;
+}
+
+void summary_obs_pool_free(summary_obs_pool_type *pool) { delete pool; }
+
+static char *summary_obs_pool_intern(summary_obs_pool_type *pool,
+                                     const char *key) {
+    /* The stored nodes only read the key through the char * members of
+       summary_obs_struct - the const_cast is contained here. */
+    return const_cast<char *>(pool->keys.insert(key).first->c_str());
+}
+
+summary_obs_type *summary_obs_alloc_pooled(summary_obs_pool_type *pool,
+                                           const char *summary_key,
+                                           const char *obs_key, double value,
+                                           double std) {
+    summary_obs_type *obs = &pool->nodes.emplace_back();
+    obs->summary_key = summary_obs_pool_intern(pool, summary_key);
+    obs->obs_key = summary_obs_pool_intern(pool, obs_key);
+    obs->value = value;
+    obs->std = std;
+    obs->std_scaling = 1.0;
+    return obs;
+}
+
 const char *summary_obs_get_summary_key(const summary_obs_type *summary_obs) {
     return summary_obs->summary_key;
 }
@@ -1,3 +1,5 @@
+#include <pthread.h>
+
 #include <ert/util/util.h>
 
 #include <ert/geometry/geo_surface.h>
@@ -5,13 +7,20 @@
 #include <ert/enkf/surface_config.hpp>
 
 struct surface_config_struct {
+    /** Loaded lazily from base_surface_file on first access -
+     * configuration load only records the file name, so sessions which
+     * never touch this surface do not pay for reading the geometry. */
     geo_surface_type *base_surface;
+    char *base_surface_file;
+    pthread_mutex_t load_mutex;
 };
 
 surface_config_type *surface_config_alloc_empty() {
     surface_config_type *config =
         (surface_config_type *)util_malloc(sizeof *config);
     config->base_surface = NULL;
+    config->base_surface_file = NULL;
+    pthread_mutex_init(&config->load_mutex, NULL);
     return config;
 }
 
@@ -19,27 +28,55 @@ void surface_config_free(surface_config_type *config) {
     if (config->base_surface != NULL)
         geo_surface_free(config->base_surface);
 
+    free(config->base_surface_file);
+    pthread_mutex_destroy(&config->load_mutex);
     free(config);
 }
 
+/** The input file must point to an existing file; the surface
+    geometry is only read on first access. */
 void surface_config_set_base_surface(surface_config_type *config,
                                      const char *base_surface) {
-    if (config->base_surface != NULL)
+    if (!util_file_exists(base_surface))
+        util_abort("%s: the base surface file:%s does not exist - aborting.\n",
+                   __func__, base_surface);
+
+    if (config->base_surface != NULL) {
         geo_surface_free(config->base_surface);
-    config->base_surface = geo_surface_fload_alloc_irap(base_surface, false);
+        config->base_surface = NULL;
+    }
+    config->base_surface_file =
+        util_realloc_string_copy(config->base_surface_file, base_surface);
+}
+
+/** Load the base surface on first access; safe to call from
+    concurrent readers. */
+static void surface_config_assert_base_surface(const surface_config_type *config) {
+    if (config->base_surface != NULL || config->base_surface_file == NULL)
+        return;
+
+    auto mutable_config = const_cast<surface_config_type *>(config);
+    pthread_mutex_lock(&mutable_config->load_mutex);
+    if (mutable_config->base_surface == NULL)
+        mutable_config->base_surface = geo_surface_fload_alloc_irap(
+            mutable_config->base_surface_file, false);
+    pthread_mutex_unlock(&mutable_config->load_mutex);
 }
 
 const geo_surface_type *
 surface_config_get_base_surface(const surface_config_type *config) {
+    surface_config_assert_base_surface(config);
     return config->base_surface;
 }
 
 int surface_config_get_data_size(const surface_config_type *config) {
+    surface_config_assert_base_surface(config);
     return geo_surface_get_size(config->base_surface);
 }
 
 void surface_config_ecl_write(const surface_config_type *config,
                               const char *filename, const double *zcoord) {
+    surface_config_assert_base_surface(config);
     geo_surface_fprintf_irap_external_zcoord(config->base_surface, filename,
                                              zcoord);
 }
@@ -1,11 +1,19 @@
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fmt/format.h>
 #include <iomanip>
+#include <mutex>
+#include <vector>
 
+#include <fcntl.h>
 #include <pthread.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/time_t_vector.h>
@@ -32,10 +40,26 @@ struct time_map_struct {
     bool modified;
     bool read_only;
     const ecl_sum_type *refcase;
+    /** Lazily computed lookup property: -1 unknown, 0 unsorted, 1
+        strictly increasing with no DEFAULT_TIME holes (in which case
+        the lookup functions binary search). Reset on update. */
+    mutable std::atomic<int> sorted_state{-1};
+    /** Memoized result of time_map_index_map() together with a
+        signature of the summary it was derived from; reset on update.
+        Guarded by cache_mutex, which is only taken while holding
+        rw_lock. */
+    std::mutex cache_mutex;
+    bool cached_index_valid = false;
+    std::vector<int> cached_index_map;
+    int cached_first_step = 0;
+    int cached_last_step = 0;
+    time_t cached_start_time = 0;
+    time_t cached_mid_time = 0;
+    time_t cached_end_time = 0;
 };
 
 time_map_type *time_map_alloc() {
-    time_map_type *map = (time_map_type *)util_malloc(sizeof *map);
+    auto map = new time_map_type;
 
     map->map = time_t_vector_alloc(0, DEFAULT_TIME);
     map->modified = false;
@@ -171,7 +195,15 @@ bool time_map_equal(const time_map_type *map1, const time_map_type *map2) {
 
 void time_map_free(time_map_type *map) {
     time_t_vector_free(map->map);
-    free(map);
+    delete map;
+}
+
+/** Must hold the write lock. */
+static void time_map_invalidate_caches__(time_map_type *map) {
+    map->sorted_state = -1;
+    std::lock_guard guard(map->cache_mutex);
+    map->cached_index_valid = false;
+    map->cached_index_map.clear();
 }
 
 bool time_map_is_readonly(const time_map_type *tm) { return tm->read_only; }
@@ -217,8 +249,11 @@ static std::string time_map_update__(time_map_type *map, int step,
         }
     }
     // No mismatch found, ok to update time map
-    map->modified = true;
-    time_t_vector_iset(map->map, step, update_time);
+    if (current_time != update_time) {
+        map->modified = true;
+        time_t_vector_iset(map->map, step, update_time);
+        time_map_invalidate_caches__(map);
+    }
 
     return error;
 }
@@ -260,6 +295,25 @@ static void time_map_assert_writable(const time_map_type *map) {
         util_abort("%s: attempt to modify read-only time-map. \n", __func__);
 }
 
+/**
+   Flat binary layout: a {magic, version, size} header followed by the
+   report-step times as int64. The whole file is assembled in memory
+   and written - and read back - with a single syscall; the time map
+   is touched at every case sync and mount, so record-at-a-time
+   buffered I/O on these small files showed up in aggregate on filer
+   stats. Files written by older versions (libecl vector format, which
+   never starts with the magic) are still read through the legacy
+   path.
+*/
+#define TIME_MAP_MAGIC 0x544d4131 /* "TMA1" */
+#define TIME_MAP_VERSION 1
+
+struct time_map_header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;
+};
+
 /**
    Observe that the locking is opposite of the function name; i.e.
    the time_map_fwrite() function reads the time_map and takes the
@@ -270,9 +324,30 @@ void time_map_fwrite(time_map_type *map, const char *filename) {
     pthread_rwlock_rdlock(&map->rw_lock);
     {
         if (map->modified) {
-            auto stream = mkdir_fopen(fs::path(filename), "w");
-            time_t_vector_fwrite(map->map, stream);
-            fclose(stream);
+            int size = time_t_vector_size(map->map);
+            std::vector<char> buffer(sizeof(time_map_header) +
+                                     size * sizeof(std::int64_t));
+            time_map_header header = {TIME_MAP_MAGIC, TIME_MAP_VERSION,
+                                      (std::uint32_t)size};
+            memcpy(buffer.data(), &header, sizeof(header));
+            for (int step = 0; step < size; step++) {
+                std::int64_t time = time_t_vector_iget(map->map, step);
+                memcpy(buffer.data() + sizeof(header) +
+                           step * sizeof(std::int64_t),
+                       &time, sizeof(time));
+            }
+
+            std::error_code ec;
+            fs::create_directories(fs::path(filename).parent_path(),
+                                   ec /* Error-code is ignored */);
+            int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                util_abort("%s: failed to open:%s for writing \n", __func__,
+                           filename);
+            if (write(fd, buffer.data(), buffer.size()) !=
+                (ssize_t)buffer.size())
+                util_abort("%s: failed to write:%s \n", __func__, filename);
+            close(fd);
         }
         map->modified = false;
     }
@@ -283,7 +358,35 @@ void time_map_fread(time_map_type *map, const char *filename) {
     time_map_assert_writable(map);
     pthread_rwlock_wrlock(&map->rw_lock);
     {
-        if (fs::exists(filename)) {
+        std::vector<char> buffer;
+        int fd = open(filename, O_RDONLY);
+        if (fd >= 0) {
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+                buffer.resize(file_stat.st_size);
+                if (read(fd, buffer.data(), buffer.size()) !=
+                    (ssize_t)buffer.size())
+                    buffer.clear();
+            }
+            close(fd);
+        }
+
+        time_map_header header;
+        if (buffer.size() >= sizeof(header) &&
+            (memcpy(&header, buffer.data(), sizeof(header)),
+             header.magic == TIME_MAP_MAGIC)) {
+            if (buffer.size() >=
+                sizeof(header) + header.size * sizeof(std::int64_t))
+                for (std::uint32_t step = 0; step < header.size; step++) {
+                    std::int64_t time;
+                    memcpy(&time,
+                           buffer.data() + sizeof(header) +
+                               step * sizeof(std::int64_t),
+                           sizeof(time));
+                    time_map_update__(map, step, time);
+                }
+        } else if (!buffer.empty()) {
+            // Legacy libecl vector format.
             FILE *stream = util_fopen(filename, "r");
             time_t_vector_type *file_map = time_t_vector_fread_alloc(stream);
 
@@ -389,21 +492,43 @@ std::string time_map_summary_update(time_map_type *map,
     return error_msg;
 }
 
+/**
+   Must hold (at least) the read lock. Determines - lazily - whether
+   the map is strictly increasing with no DEFAULT_TIME holes, so the
+   lookups can binary search. Concurrent readers may race to compute
+   the flag, but they all compute the same value.
+*/
+static bool time_map_sorted__(const time_map_type *map) {
+    int state = map->sorted_state.load();
+    if (state < 0) {
+        int size = time_t_vector_size(map->map);
+        state = 1;
+        if (size > 0 && time_map_iget__(map, 0) == DEFAULT_TIME)
+            state = 0;
+        for (int i = 1; state == 1 && i < size; i++)
+            if (time_map_iget__(map, i) <= time_map_iget__(map, i - 1))
+                state = 0;
+        map->sorted_state.store(state);
+    }
+    return state == 1;
+}
+
 int time_map_lookup_time(time_map_type *map, time_t time) {
     int index = -1;
     pthread_rwlock_rdlock(&map->rw_lock);
     {
-        int current_index = 0;
-        while (true) {
-            if (current_index >= time_t_vector_size(map->map))
-                break;
-
-            if (time_map_iget__(map, current_index) == time) {
-                index = current_index;
-                break;
-            }
-
-            current_index++;
+        int size = time_t_vector_size(map->map);
+        if (time_map_sorted__(map)) {
+            const time_t *data = time_t_vector_get_const_ptr(map->map);
+            const time_t *it = std::lower_bound(data, data + size, time);
+            if (it != data + size && *it == time)
+                index = it - data;
+        } else {
+            for (int current_index = 0; current_index < size; current_index++)
+                if (time_map_iget__(map, current_index) == time) {
+                    index = current_index;
+                    break;
+                }
         }
     }
     pthread_rwlock_unlock(&map->rw_lock);
@@ -421,13 +546,47 @@ static bool time_map_valid_time__(const time_map_type *map, time_t time) {
         return false;
 }
 
+/** The tolerance window check from the linear scan below. */
+static bool time_map_diff_inside_tolerance__(time_t diff,
+                                             int seconds_before_tolerance,
+                                             int seconds_after_tolerance) {
+    if (seconds_after_tolerance >= 0 && diff >= seconds_after_tolerance)
+        return false;
+    if (seconds_before_tolerance >= 0 && diff <= -seconds_before_tolerance)
+        return false;
+    return true;
+}
+
 int time_map_lookup_time_with_tolerance(time_map_type *map, time_t time,
                                         int seconds_before_tolerance,
                                         int seconds_after_tolerance) {
     int nearest_index = -1;
     pthread_rwlock_rdlock(&map->rw_lock);
     {
-        if (time_map_valid_time__(map, time)) {
+        if (time_map_valid_time__(map, time) && time_map_sorted__(map)) {
+            // The nearest entries are the first one >= time and its
+            // predecessor.
+            int size = time_t_vector_size(map->map);
+            const time_t *data = time_t_vector_get_const_ptr(map->map);
+            const time_t *it = std::lower_bound(data, data + size, time);
+            time_t nearest_diff = 999999999999;
+            for (int index : {(int)(it - data) - 1, (int)(it - data)}) {
+                if (index < 0 || index >= size)
+                    continue;
+                time_t diff = time - data[index];
+                if (diff == 0) {
+                    nearest_index = index;
+                    break;
+                }
+                if (std::fabs(diff) < nearest_diff &&
+                    time_map_diff_inside_tolerance__(diff,
+                                                     seconds_before_tolerance,
+                                                     seconds_after_tolerance)) {
+                    nearest_diff = diff;
+                    nearest_index = index;
+                }
+            }
+        } else if (time_map_valid_time__(map, time)) {
             time_t nearest_diff = 999999999999;
             int current_index = 0;
             while (true) {
@@ -486,6 +645,7 @@ void time_map_clear(time_map_type *map) {
     {
         time_t_vector_reset(map->map);
         map->modified = true;
+        time_map_invalidate_caches__(map);
     }
     pthread_rwlock_unlock(&map->rw_lock);
 }
@@ -544,11 +704,42 @@ static void time_map_update_abort(time_map_type *map, int step, time_t time) {
      3: 2000-04-01   <-------      2: 2000-04-01
 
 */
-int_vector_type *time_map_alloc_index_map(time_map_type *map,
-                                          const ecl_sum_type *ecl_sum) {
-    int_vector_type *index_map = int_vector_alloc(0, -1);
+std::vector<int> time_map_index_map(time_map_type *map,
+                                    const ecl_sum_type *ecl_sum) {
+    // The mapping only depends on the report times of the summary and
+    // on the time map itself, and the realizations of an ensemble
+    // share their report schedule. Memoize the last computed map on
+    // the time_map instance, keyed by a signature of the summary
+    // (first/last report step and the start/middle/end report times),
+    // so the per-realization load loops recompute it once instead of
+    // once per realization. The cache is dropped whenever the time
+    // map itself is updated.
+    int first_step = ecl_sum_get_first_report_step(ecl_sum);
+    int last_step = ecl_sum_get_last_report_step(ecl_sum);
+    bool use_cache = first_step <= last_step;
+    time_t start_time = use_cache ? ecl_sum_get_start_time(ecl_sum) : 0;
+    time_t mid_time =
+        use_cache
+            ? ecl_sum_get_report_time(ecl_sum, (first_step + last_step) / 2)
+            : 0;
+    time_t end_time =
+        use_cache ? ecl_sum_get_report_time(ecl_sum, last_step) : 0;
+
     pthread_rwlock_rdlock(&map->rw_lock);
+    if (use_cache) {
+        std::lock_guard guard(map->cache_mutex);
+        if (map->cached_index_valid && map->cached_first_step == first_step &&
+            map->cached_last_step == last_step &&
+            map->cached_start_time == start_time &&
+            map->cached_mid_time == mid_time &&
+            map->cached_end_time == end_time) {
+            std::vector<int> copy = map->cached_index_map;
+            pthread_rwlock_unlock(&map->rw_lock);
+            return copy;
+        }
+    }
 
+    std::vector<int> index_map;
     int sum_index = ecl_sum_get_first_report_step(ecl_sum);
     int time_map_index = ecl_sum_get_first_report_step(ecl_sum);
     for (; time_map_index < time_map_get_size(map); ++time_map_index) {
@@ -576,13 +767,37 @@ int_vector_type *time_map_alloc_index_map(time_map_type *map,
             break;
         }
 
-        int_vector_iset(index_map, time_map_index, sum_index);
+        if ((int)index_map.size() <= time_map_index)
+            index_map.resize(time_map_index + 1, -1);
+        index_map[time_map_index] = sum_index;
+    }
+
+    if (use_cache) {
+        std::lock_guard guard(map->cache_mutex);
+        map->cached_index_map = index_map;
+        map->cached_index_valid = true;
+        map->cached_first_step = first_step;
+        map->cached_last_step = last_step;
+        map->cached_start_time = start_time;
+        map->cached_mid_time = mid_time;
+        map->cached_end_time = end_time;
     }
 
     pthread_rwlock_unlock(&map->rw_lock);
     return index_map;
 }
 
+/** Compatibility wrapper around time_map_index_map for callers still
+    on the libecl int_vector API. */
+int_vector_type *time_map_alloc_index_map(time_map_type *map,
+                                          const ecl_sum_type *ecl_sum) {
+    std::vector<int> index_map = time_map_index_map(map, ecl_sum);
+    int_vector_type *result = int_vector_alloc(index_map.size(), -1);
+    for (size_t index = 0; index < index_map.size(); index++)
+        int_vector_iset(result, index, index_map[index]);
+    return result;
+}
+
 #include <ert/python.hpp>
 
 ERT_CLIB_SUBMODULE("time_map", m) {
@@ -1,8 +1,18 @@
 #ifndef ERT_CONCURRENCY_HPP
 #define ERT_CONCURRENCY_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 // Standard support for semaphores arrived in C++20, so make our own for now
 // Idea and most of code is from
@@ -28,4 +38,208 @@ private:
     size_t count;
 };
 
+namespace ert {
+
+/**
+   Work-stealing thread pool: every worker owns a deque and pops from
+   it LIFO, idle workers steal FIFO from the others. Tasks submitted
+   from a worker thread go to that worker's own deque, so nested
+   submissions stay cache-local; tasks submitted from outside are
+   distributed round-robin.
+
+   parallel_for is the bulk primitive: the index range is handed out in
+   grain-sized chunks through a shared atomic cursor and the calling
+   thread processes chunks itself while it waits, so calling it from
+   inside a pool task cannot deadlock the pool.
+
+   Parallel stages should share the process-wide pool from
+   global_pool() instead of spawning their own threads - concurrent
+   stages then compete for the same workers rather than oversubscribing
+   the machine.
+*/
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t thread_count) {
+        for (size_t index = 0; index < thread_count; index++)
+            m_queues.push_back(std::make_unique<Queue>());
+        for (size_t index = 0; index < thread_count; index++)
+            m_workers.emplace_back([this, index] { this->worker(index); });
+    }
+
+    ~ThreadPool() {
+        m_stop.store(true);
+        m_wakeup_cv.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+    }
+
+    size_t size() const { return m_workers.size(); }
+
+    /** Schedule a task for execution; the future reports completion
+        and rethrows anything the task threw. */
+    template <typename F> std::future<void> submit(F &&function) {
+        auto task = std::make_shared<std::packaged_task<void()>>(
+            std::forward<F>(function));
+        std::future<void> future = task->get_future();
+        push([task] { (*task)(); });
+        return future;
+    }
+
+    /**
+       Apply 'function(begin, end)' over [0, count) in chunks of at
+       most 'grain' indices. Blocks until every chunk has run; the
+       first exception thrown by a chunk is rethrown here.
+    */
+    template <typename F>
+    void parallel_for(size_t count, size_t grain, F &&function) {
+        if (count == 0)
+            return;
+        if (grain == 0)
+            grain = 1;
+
+        auto state = std::make_shared<ForState>();
+        state->count = count;
+        state->grain = grain;
+        state->total_chunks = (count + grain - 1) / grain;
+
+        // The chunk loop: grab chunks from the shared cursor until the
+        // range is exhausted. The caller runs it too, so completion
+        // never depends on the helpers being scheduled.
+        auto run_chunks = [state, &function] {
+            for (;;) {
+                size_t begin = state->next.fetch_add(state->grain);
+                if (begin >= state->count)
+                    return;
+                size_t end = std::min(begin + state->grain, state->count);
+                try {
+                    function(begin, end);
+                } catch (...) {
+                    std::lock_guard guard{state->mutex};
+                    if (!state->error)
+                        state->error = std::current_exception();
+                }
+                if (state->done.fetch_add(1) + 1 == state->total_chunks) {
+                    std::lock_guard guard{state->mutex};
+                    state->cv.notify_all();
+                }
+            }
+        };
+
+        size_t helpers = std::min(size(), state->total_chunks);
+        for (size_t index = 1; index < helpers; index++)
+            push(run_chunks);
+        run_chunks();
+
+        std::unique_lock lock{state->mutex};
+        state->cv.wait(lock, [&state] {
+            return state->done.load() == state->total_chunks;
+        });
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    struct ForState {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count{};
+        size_t grain{};
+        size_t total_chunks{};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+    };
+
+    void push(std::function<void()> task) {
+        size_t index;
+        if (current_pool == this)
+            index = current_index;
+        else
+            index = m_next_queue.fetch_add(1) % m_queues.size();
+        {
+            std::lock_guard guard{m_queues[index]->mutex};
+            m_queues[index]->tasks.push_back(std::move(task));
+        }
+        m_wakeup_cv.notify_one();
+    }
+
+    bool try_pop(size_t index, std::function<void()> &task) {
+        // Own queue from the back (LIFO - most recently submitted,
+        // cache-warm work first) ...
+        {
+            Queue &queue = *m_queues[index];
+            std::lock_guard guard{queue.mutex};
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                return true;
+            }
+        }
+        // ... then steal from the front of the others (FIFO - the
+        // oldest, least cache-warm work).
+        for (size_t offset = 1; offset < m_queues.size(); offset++) {
+            Queue &queue = *m_queues[(index + offset) % m_queues.size()];
+            std::lock_guard guard{queue.mutex};
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(size_t index) {
+        current_pool = this;
+        current_index = index;
+        std::function<void()> task;
+        for (;;) {
+            if (try_pop(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock lock{m_wakeup_mutex};
+            if (m_stop.load())
+                return;
+            m_wakeup_cv.wait_for(lock, std::chrono::milliseconds(10));
+            if (m_stop.load())
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_wakeup_mutex;
+    std::condition_variable m_wakeup_cv;
+    std::atomic<bool> m_stop{false};
+    std::atomic<size_t> m_next_queue{0};
+
+    inline static thread_local ThreadPool *current_pool = nullptr;
+    inline static thread_local size_t current_index = 0;
+};
+
+/**
+   The process-wide pool, sized from ERT_NUM_THREADS when set and the
+   hardware concurrency otherwise (at least 2 threads).
+*/
+inline ThreadPool &global_pool() {
+    static ThreadPool pool{[] {
+        if (const char *env = getenv("ERT_NUM_THREADS")) {
+            size_t threads = strtoul(env, nullptr, 10);
+            if (threads > 0)
+                return threads;
+        }
+        return (size_t)std::max(2u, std::thread::hardware_concurrency());
+    }()};
+    return pool;
+}
+
+} // namespace ert
+
 #endif
@@ -237,4 +237,14 @@ conf_instance_type *
 conf_instance_alloc_from_file(const conf_class_type *conf_class,
                               const char *name, const char *file_name);
 
+/** Called once for every completed top level sub instance when
+    parsing in streaming mode. Ownership of the instance is
+    transferred to the callback. */
+typedef void(conf_instance_visitor_ftype)(conf_instance_type *conf_instance,
+                                          void *visitor_arg);
+
+conf_instance_type *conf_instance_alloc_from_file_visitor(
+    const conf_class_type *conf_class, const char *name, const char *file_name,
+    conf_instance_visitor_ftype *visitor, void *visitor_arg);
+
 #endif
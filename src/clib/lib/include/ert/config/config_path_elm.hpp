@@ -2,9 +2,20 @@
 #define ERT_CONFIG_PATH_ELM_H
 
 #include <filesystem>
+#include <map>
+#include <string>
 
 struct config_path_elm_type {
     std::filesystem::path path;
+    /** Memoized results of config_path_elm_alloc_path(). The elm is
+     * the parser cwd, so together with the input path this is a
+     * (cwd, input) keyed cache; the elms are owned by the path stack
+     * storage of the config_content, so the cache lives for the
+     * duration of the parse session. Validation and the *_iget_as_path
+     * accessors resolve the same handful of paths once per keyword
+     * occurrence, which adds up over the thousands of keywords in a
+     * full site + user configuration. */
+    mutable std::map<std::string, std::string> resolved_paths;
 };
 
 extern "C" void config_path_elm_free(config_path_elm_type *path_elm);
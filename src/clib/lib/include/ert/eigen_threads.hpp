@@ -0,0 +1,57 @@
+#ifndef ERT_EIGEN_THREADS_HPP
+#define ERT_EIGEN_THREADS_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+#include <Eigen/Core>
+
+/*
+  Control of Eigen's internal (OpenMP backed) parallelization. Eigen
+  only parallelizes its large GEMMs when built with OpenMP enabled;
+  without OpenMP the calls below are cheap no-ops, so they can be used
+  unconditionally around the big matrix products of the update.
+*/
+
+namespace ert {
+
+/**
+   Sizes Eigen's internal threading from ERT_NUM_THREADS, falling back
+   to the hardware concurrency - the same policy as global_pool(). Safe
+   to call repeatedly; only the first call computes the thread count.
+*/
+inline void enable_eigen_threads() {
+    static const int num_threads = [] {
+        if (const char *env = getenv("ERT_NUM_THREADS")) {
+            int threads = (int)strtol(env, nullptr, 10);
+            if (threads > 0)
+                return threads;
+        }
+        return std::max(2, (int)std::thread::hardware_concurrency());
+    }();
+    Eigen::setNbThreads(num_threads);
+}
+
+/**
+   RAII guard pinning Eigen single threaded within a scope. Used by
+   code which is already parallel at a coarser level (per member, per
+   row group) so that the GEMMs of the individual tasks do not
+   oversubscribe the machine.
+*/
+class EigenSingleThreadScope {
+public:
+    EigenSingleThreadScope() : m_previous(Eigen::nbThreads()) {
+        Eigen::setNbThreads(1);
+    }
+    ~EigenSingleThreadScope() { Eigen::setNbThreads(m_previous); }
+    EigenSingleThreadScope(const EigenSingleThreadScope &) = delete;
+    EigenSingleThreadScope &operator=(const EigenSingleThreadScope &) = delete;
+
+private:
+    int m_previous;
+};
+
+} // namespace ert
+
+#endif
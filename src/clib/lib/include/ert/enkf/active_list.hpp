@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include <ert/enkf/enkf_types.hpp>
@@ -30,9 +32,19 @@ public:
     active_mode_type getMode() const;
     int active_size(int default_size) const;
     void add_index(int index);
+    std::optional<std::pair<int, int>> contiguous_range(int total_size) const;
+    std::vector<std::pair<int, int>> interval_list(int total_size) const;
+    /** Single-pass merges over the sorted index lists; the result
+        keeps the sorted/unique invariant. */
+    ActiveList set_union(const ActiveList &other) const;
+    ActiveList set_intersection(const ActiveList &other) const;
+    /** total_size is only used when this list is ALL_ACTIVE. */
+    ActiveList set_difference(const ActiveList &other, int total_size) const;
     bool operator==(const ActiveList &other) const;
 
 private:
+    /** Kept sorted and unique, so consumers can detect and bulk-copy
+        contiguous index runs. */
     std::vector<int> m_index_list;
     active_mode_type m_mode = ALL_ACTIVE;
 };
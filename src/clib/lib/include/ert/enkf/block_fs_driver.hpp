@@ -4,7 +4,18 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
 #include <ert/enkf/fs_types.hpp>
+#include <ert/res_util/block_fs.hpp>
 
 typedef struct buffer_struct buffer_type;
 typedef struct bfs_config_struct bfs_config_type;
@@ -17,6 +28,54 @@ class block_fs_driver {
     bfs_config_type *config{};
     bfs_type **fs_list;
 
+    /** Write-behind state: save_node/save_vector enqueue the node and
+        return, a background thread performs the actual block_fs write
+        and fsync() acts as the durability barrier. The pending map
+        gives read-your-writes semantics for nodes that have not hit
+        disk yet. With ERT_BLOCK_FS_GROUP_COMMIT set the writer thread
+        also owns durability cadence: per-write fsync is disabled and
+        the touched mounts are fsynced once per drained batch. */
+    struct PendingWrite {
+        std::string key;
+        int iens;
+        std::shared_ptr<std::vector<char>> data;
+    };
+    static constexpr size_t MAX_PENDING_BYTES = 256 * 1024 * 1024;
+    std::mutex m_write_mutex;
+    std::condition_variable m_write_cv;
+    std::condition_variable m_write_done_cv;
+    std::deque<PendingWrite> m_write_queue;
+    std::unordered_map<std::string, std::shared_ptr<std::vector<char>>>
+        m_pending;
+    size_t m_pending_bytes = 0;
+    bool m_write_in_progress = false;
+    bool m_stop_writer = false;
+    std::thread m_writer;
+
+    void writer_loop();
+    void enqueue_write(std::string key, int iens, const void *ptr,
+                       size_t data_size);
+    void enqueue_write_dedup(std::string key, int iens, const void *ptr,
+                             size_t data_size);
+    bool load_cas(const std::string &cas_key, buffer_type *buffer);
+    void resolve_dedup(buffer_type *buffer);
+    void resolve_dedup_view(block_fs_view &view);
+    bool encode_delta(const char *node_key, int report_step, int iens,
+                      const void *ptr, size_t data_size,
+                      std::vector<char> &record);
+    void resolve_delta(const char *node_key, int report_step, int iens,
+                       buffer_type *buffer);
+    void resolve_delta_view(const char *node_key, int report_step, int iens,
+                            block_fs_view &view);
+    bool read_pending(const std::string &key, buffer_type *buffer);
+    bool has_pending(const std::string &key);
+    void drain_writes();
+
+    /** Copy-on-write support: nodes not found locally are resolved
+        from the (read-only) parent case's driver, while writes always
+        land in this driver. */
+    std::unique_ptr<block_fs_driver> m_parent;
+
 public:
     block_fs_driver(int num_fs);
     ~block_fs_driver();
@@ -27,17 +86,38 @@ public:
                                  bool read_only);
 
     bool has_node(const char *node_key, int report_step, int iens);
+    void has_nodes(const std::vector<std::string> &node_keys, int report_step,
+                   const std::vector<int> &iens_list,
+                   std::vector<bool> &result);
+    bool has_local_node(const char *node_key, int report_step, int iens);
     void load_node(const char *node_key, int report_step, int iens,
                    buffer_type *buffer);
+    void load_nodes(
+        const std::vector<std::tuple<std::string, int, int>> &nodes,
+        std::vector<buffer_type *> &buffers);
+    void load_node_view(const char *node_key, int report_step, int iens,
+                        block_fs_view &view);
+    void prefetch_node(const char *node_key, int report_step, int iens);
     void save_node(const char *node_key, int report_step, int iens,
                    buffer_type *buffer);
     void save_node(const char *node_key, int iens, const void *ptr,
                    size_t data_size);
 
     bool has_vector(const char *node_key, int iens);
+    void has_vectors(const std::vector<std::string> &node_keys,
+                     const std::vector<int> &iens_list,
+                     std::vector<bool> &result);
     void load_vector(const char *node_key, int iens, buffer_type *buffer);
+    size_t load_vector_range(const char *node_key, int iens, size_t offset,
+                             size_t count, buffer_type *buffer);
     void save_vector(const char *node_key, int iens, buffer_type *buffer);
 
+    void set_parent(std::unique_ptr<block_fs_driver> parent);
+
+    /** Number of locally stored nodes and data file bytes, summed over
+        the shard files; the copy-on-write parent is not included. */
+    void stats(size_t &num_nodes, size_t &data_bytes);
+
     void fsync();
 
 private:
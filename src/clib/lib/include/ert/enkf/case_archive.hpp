@@ -0,0 +1,21 @@
+#ifndef ERT_CASE_ARCHIVE_H
+#define ERT_CASE_ARCHIVE_H
+
+#include <filesystem>
+
+/**
+   Single-file case archive: the whole on-disk state of a case - the
+   block_fs driver files, mount maps and metadata - streamed into one
+   seekable compressed container with an internal index, and unpacked
+   again on the receiving side. Moving a case between clusters becomes
+   one sequential stream instead of a directory tree of small-file
+   operations.
+*/
+
+void enkf_fs_export_archive(const std::filesystem::path &case_path,
+                            const std::filesystem::path &archive_file);
+
+void enkf_fs_import_archive(const std::filesystem::path &archive_file,
+                            const std::filesystem::path &case_path);
+
+#endif
@@ -7,6 +7,17 @@
 
 #include <ert/enkf/obs_data.hpp>
 
+/** Wall/CPU time spent in one stage of an update step; collected in
+    the UpdateSnapshot so the run report can show where the update time
+    went. The stages measured in C++ (observation/response assembly)
+    and in Python (parameter load, solve, write-back) all land in the
+    same table. */
+struct UpdateTiming {
+    std::string stage;
+    double wall_seconds;
+    double cpu_seconds;
+};
+
 class UpdateSnapshot {
 
 private:
@@ -16,6 +27,7 @@ private:
     std::vector<std::string> obs_status_;
     std::vector<double> response_mean_;
     std::vector<double> response_std_;
+    std::vector<UpdateTiming> timings_;
 
 public:
     const std::vector<std::string> &obs_name() const { return obs_name_; }
@@ -24,10 +36,13 @@ public:
     const std::vector<std::string> &obs_status() const { return obs_status_; }
     const std::vector<double> &response_mean() const { return response_mean_; }
     const std::vector<double> &response_std() const { return response_std_; }
+    const std::vector<UpdateTiming> &timings() const { return timings_; }
 
     void add_member(std::string observation_name, double observation_value,
                     double observation_error, std::string observation_status,
                     double ensemble_mean, double ensemble_std);
+    void add_timing(std::string stage, double wall_seconds,
+                    double cpu_seconds);
 };
 
 UpdateSnapshot make_update_snapshot(const obs_data_type *obs_data,
@@ -2,6 +2,13 @@
 #define ERT_ENKF_FS_H
 #include <stdbool.h>
 
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include <ert/util/buffer.h>
 #include <ert/util/stringlist.h>
 
@@ -11,6 +18,7 @@
 #include <ert/enkf/fs_types.hpp>
 #include <ert/enkf/misfit_ensemble_typedef.hpp>
 #include <ert/enkf/state_map.hpp>
+#include <ert/res_util/block_fs.hpp>
 #include <ert/enkf/summary_key_set.hpp>
 #include <ert/enkf/time_map.hpp>
 
@@ -29,7 +37,20 @@ void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                            const char *node_key, enkf_var_type var_type,
                            int iens);
 
+class SummaryBlock;
+/** The columnar summary block of one realization, loaded through a
+    small per-filesystem LRU cache; nullptr when the realization has no
+    block (e.g. a case written before the block format). */
+std::shared_ptr<const SummaryBlock> enkf_fs_get_summary_block(enkf_fs_type *fs,
+                                                              int iens);
+void enkf_fs_store_summary_block(enkf_fs_type *fs, int iens,
+                                 std::shared_ptr<const SummaryBlock> block);
+
 bool enkf_fs_exists(const char *mount_point);
+/** Parse the case catalog written at the sync points - node counts,
+    byte sizes, time map extent and state summary - without mounting
+    the case. Returns an empty map when no catalog has been written. */
+std::map<std::string, long long> enkf_fs_read_catalog(const char *mount_point);
 
 extern "C" void enkf_fs_sync(enkf_fs_type *fs);
 
@@ -37,20 +58,60 @@ void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                         const char *node_key, enkf_var_type var_type,
                         int report_step, int iens);
 
+void enkf_fs_fread_nodes(
+    enkf_fs_type *enkf_fs, enkf_var_type var_type,
+    const std::vector<std::tuple<std::string, int, int>> &nodes,
+    std::vector<buffer_type *> &buffers);
+
+void enkf_fs_fread_node_view(enkf_fs_type *enkf_fs, block_fs_view &view,
+                             const char *node_key, enkf_var_type var_type,
+                             int report_step, int iens);
+
+void enkf_fs_prefetch_node(enkf_fs_type *enkf_fs, const char *node_key,
+                           enkf_var_type var_type, int report_step, int iens);
+
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens);
 
+size_t enkf_fs_fread_vector_range(enkf_fs_type *enkf_fs, buffer_type *buffer,
+                                  const char *node_key, enkf_var_type var_type,
+                                  int iens, size_t offset, size_t count);
+
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens);
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens);
+/** Batched existence query; the key-major bitmap answers for
+    (keys[i], iens_list[j]) at bit [i * iens_list.size() + j]. */
+std::vector<bool> enkf_fs_has_nodes(
+    enkf_fs_type *enkf_fs,
+    const std::vector<std::pair<std::string, enkf_var_type>> &keys,
+    int report_step, const std::vector<int> &iens_list);
+/** Like enkf_fs_has_node, but ignores the copy-on-write parent chain. */
+bool enkf_fs_has_local_node(enkf_fs_type *enkf_fs, const char *node_key,
+                            enkf_var_type var_type, int report_step, int iens);
 
 extern "C" enkf_fs_type *enkf_fs_create_fs(const char *mount_point,
                                            fs_driver_impl driver_id,
                                            unsigned ensemble_size, bool mount);
 
+extern "C" enkf_fs_type *enkf_fs_create_cow_fs(const char *mount_point,
+                                               const char *parent_mount_point,
+                                               fs_driver_impl driver_id,
+                                               unsigned ensemble_size,
+                                               bool mount);
+
 extern "C" void enkf_fs_umount(enkf_fs_type *fs);
+/** Detach the instance immediately and sync + umount it on a pool
+    thread; the caller must not touch fs afterwards. */
+extern "C" void enkf_fs_umount_async(enkf_fs_type *fs);
+/** Durability barrier: wait for in-flight background umounts of
+    mount_point (NULL waits for all of them). */
+void enkf_fs_umount_barrier(const char *mount_point);
+/** Drop cached (unmounted) filesystem instances; mount_point == NULL
+    drops the whole cache. */
+void enkf_fs_invalidate_cache(const char *mount_point);
 
 char *enkf_fs_alloc_case_filename(const enkf_fs_type *fs,
                                   const char *input_name);
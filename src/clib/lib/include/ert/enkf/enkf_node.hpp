@@ -51,6 +51,10 @@ typedef void(enkf_node_ftype1)(enkf_node_type *);
 
 std::vector<double> enkf_node_user_get_vector(enkf_node_type *enkf_node,
                                               enkf_fs_type *fs, int iens);
+std::vector<double>
+enkf_node_user_get_vector_window(const enkf_config_node_type *config_node,
+                                 enkf_fs_type *fs, int iens, int step_offset,
+                                 int step_count);
 enkf_node_type *enkf_node_deep_alloc(const enkf_config_node_type *config);
 extern "C" enkf_node_type *enkf_node_alloc(const enkf_config_node_type *);
 
@@ -63,7 +67,8 @@ extern "C" ert_impl_type enkf_node_get_impl_type(const enkf_node_type *);
 
 bool enkf_node_forward_load_vector(enkf_node_type *enkf_node,
                                    const ecl_sum_type *ecl_sum,
-                                   const int_vector_type *time_index);
+                                   const std::vector<int> &time_index,
+                                   const std::vector<int> &params_time_index);
 bool enkf_node_forward_load(enkf_node_type *enkf_node, int report_step,
                             const std::string &run_path, enkf_fs_type *fs);
 bool enkf_node_initialize(enkf_node_type *enkf_node, int);
@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 
+#include <vector>
+
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/hash.h>
 #include <ert/util/stringlist.h>
@@ -23,6 +25,10 @@
 void enkf_state_initialize(enkf_fs_type *fs, enkf_node_type *param_node,
                            int iens);
 
+void enkf_state_initialize_ensemble(enkf_fs_type *fs,
+                                    const enkf_config_node_type *config_node,
+                                    const std::vector<int> &iens_list);
+
 std::pair<fw_load_status, std::string> enkf_state_load_from_forward_model(
     ensemble_config_type *ens_config, model_config_type *model_config,
     const int iens, const std::string &run_path, const std::string &job_name,
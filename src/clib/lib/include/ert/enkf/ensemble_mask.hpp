@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ert {
+
+/**
+   Fixed-size bitmask over the ensemble members, backed by uint64_t
+   words: counting the active members is one popcount per word,
+   enumeration skips zero words wholesale and walks the set bits with
+   ctz, and masks combine with word-wise boolean operations. The type
+   is implicitly convertible from std::vector<bool> so the layers of
+   the pipeline can adopt it one signature at a time.
+*/
+class EnsembleMask {
+public:
+    EnsembleMask() = default;
+
+    explicit EnsembleMask(size_t size, bool value = false)
+        : m_size(size),
+          m_words((size + 63) / 64, value ? ~std::uint64_t{0} : 0) {
+        trim();
+    }
+
+    EnsembleMask(const std::vector<bool> &mask) : EnsembleMask(mask.size()) {
+        for (size_t index = 0; index < mask.size(); index++)
+            if (mask[index])
+                m_words[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool get(size_t index) const {
+        return (m_words[index / 64] >> (index % 64)) & 1;
+    }
+
+    void set(size_t index, bool value) {
+        std::uint64_t bit = std::uint64_t{1} << (index % 64);
+        if (value)
+            m_words[index / 64] |= bit;
+        else
+            m_words[index / 64] &= ~bit;
+    }
+
+    /** Number of active members. */
+    size_t count() const {
+        size_t sum = 0;
+        for (auto word : m_words)
+            sum += __builtin_popcountll(word);
+        return sum;
+    }
+
+    /** Visit the active indices in increasing order. */
+    template <typename F> void for_each_active(F &&func) const {
+        for (size_t word_nr = 0; word_nr < m_words.size(); word_nr++) {
+            std::uint64_t word = m_words[word_nr];
+            while (word) {
+                int bit = __builtin_ctzll(word);
+                func(static_cast<int>(word_nr * 64 + bit));
+                word &= word - 1;
+            }
+        }
+    }
+
+    std::vector<int> active_list() const {
+        std::vector<int> active;
+        active.reserve(count());
+        for_each_active([&active](int index) { active.push_back(index); });
+        return active;
+    }
+
+    std::vector<bool> to_vector() const {
+        std::vector<bool> mask(m_size, false);
+        for_each_active([&mask](int index) { mask[index] = true; });
+        return mask;
+    }
+
+    /** Word-wise combinations; both masks must cover the same ensemble. */
+    EnsembleMask operator&(const EnsembleMask &other) const {
+        return combine(other,
+                       [](std::uint64_t a, std::uint64_t b) { return a & b; });
+    }
+
+    EnsembleMask operator|(const EnsembleMask &other) const {
+        return combine(other,
+                       [](std::uint64_t a, std::uint64_t b) { return a | b; });
+    }
+
+    /** This mask minus the members active in other. */
+    EnsembleMask operator-(const EnsembleMask &other) const {
+        return combine(other,
+                       [](std::uint64_t a, std::uint64_t b) { return a & ~b; });
+    }
+
+    bool operator==(const EnsembleMask &other) const {
+        return m_size == other.m_size && m_words == other.m_words;
+    }
+
+private:
+    template <typename Op>
+    EnsembleMask combine(const EnsembleMask &other, Op op) const {
+        EnsembleMask result(m_size);
+        size_t words = std::min(m_words.size(), other.m_words.size());
+        for (size_t word_nr = 0; word_nr < words; word_nr++)
+            result.m_words[word_nr] = op(m_words[word_nr], other.m_words[word_nr]);
+        result.trim();
+        return result;
+    }
+
+    /** Clear the bits beyond m_size in the last word so count() and
+        word-wise comparisons never see them. */
+    void trim() {
+        if (m_size % 64 != 0 && !m_words.empty())
+            m_words.back() &= (std::uint64_t{1} << (m_size % 64)) - 1;
+    }
+
+    size_t m_size = 0;
+    std::vector<std::uint64_t> m_words;
+};
+
+} // namespace ert
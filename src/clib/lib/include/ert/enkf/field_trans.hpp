@@ -4,15 +4,20 @@
 #include <stdio.h>
 
 typedef float(field_func_type)(float);
+/** Array-level variant of field_func_type: transforms the whole buffer
+    in one auto-vectorizable loop instead of one call per cell. */
+typedef void(field_batch_func_type)(float *, int);
 typedef struct field_trans_table_struct field_trans_table_type;
 
 void field_trans_table_fprintf(const field_trans_table_type *, FILE *);
 void field_trans_table_free(field_trans_table_type *);
 void field_trans_table_add(field_trans_table_type *, const char *, const char *,
-                           field_func_type *);
+                           field_func_type *, field_batch_func_type *);
 field_trans_table_type *field_trans_table_alloc();
 bool field_trans_table_has_key(field_trans_table_type *, const char *);
 field_func_type *field_trans_table_lookup(field_trans_table_type *,
                                           const char *);
+field_batch_func_type *field_trans_table_lookup_batch(field_trans_table_type *,
+                                                      const char *);
 
 #endif
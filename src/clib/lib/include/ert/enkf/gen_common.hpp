@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 #include <vector>
 
 #include <ert/enkf/gen_data_config.hpp>
@@ -8,3 +9,6 @@
 std::vector<double>
 gen_common_fload_alloc(const std::filesystem::path &path,
                        gen_data_file_format_type load_format);
+
+std::optional<std::vector<double>>
+gen_common_shm_fload(const std::filesystem::path &result_path);
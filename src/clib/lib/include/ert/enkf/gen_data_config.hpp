@@ -17,8 +17,10 @@ typedef enum {
     ASCII = 1,
     /** The data is inserted into a user defined template file. */
     ASCII_TEMPLATE = 2,
-} /*   The data is in a binary file with floats. */
-gen_data_file_format_type;
+    /** Binary file: int32 magic + int32 dtype + int64 count + raw array;
+        see gen_common.cpp for the full format description. */
+    GEN_DATA_BINARY = 3,
+} gen_data_file_format_type;
 
 bool gen_data_config_is_dynamic(const gen_data_config_type *config);
 void gen_data_config_load_active(gen_data_config_type *config, enkf_fs_type *fs,
@@ -27,6 +29,10 @@ bool gen_data_config_valid_result_format(const char *result_file_fmt);
 
 bool gen_data_config_has_active_mask(const gen_data_config_type *config,
                                      enkf_fs_type *fs, int report_step);
+void gen_data_config_fwrite_data_size(gen_data_config_type *config,
+                                      enkf_fs_type *fs, int report_step);
+bool gen_data_config_fload_data_size(gen_data_config_type *config,
+                                     enkf_fs_type *fs, int report_step);
 
 extern "C" gen_data_config_type *
 gen_data_config_alloc_GEN_DATA_result(const char *key,
@@ -25,11 +25,16 @@ extern "C" const char *
 gen_kw_config_get_template_file(const gen_kw_config_type *);
 extern "C" void gen_kw_config_free(gen_kw_config_type *);
 double gen_kw_config_transform(const gen_kw_config_type *, int index, double x);
+void gen_kw_config_transform_vector(const gen_kw_config_type *config,
+                                    const double *in, double *out, int size);
 extern "C" bool
 gen_kw_config_should_use_log_scale(const gen_kw_config_type *config, int index);
 extern "C" int gen_kw_config_get_data_size(const gen_kw_config_type *);
 extern "C" const char *gen_kw_config_iget_name(const gen_kw_config_type *, int);
 const char *gen_kw_config_get_tagged_name(const gen_kw_config_type *, int);
+bool gen_kw_config_render_template(const gen_kw_config_type *config,
+                                   const double *values,
+                                   const char *target_file);
 extern "C" stringlist_type *
 gen_kw_config_alloc_name_list(const gen_kw_config_type *config);
 int gen_kw_config_get_index(const gen_kw_config_type *, const char *);
@@ -1,6 +1,8 @@
 #ifndef ERT_GEN_OBS_H
 #define ERT_GEN_OBS_H
 
+#include <ert/util/buffer.h>
+
 #include <ert/enkf/active_list.hpp>
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/gen_data_config.hpp>
@@ -40,6 +42,11 @@ extern "C" void gen_obs_attach_data_index(gen_obs_type *gen_obs,
 extern "C" void gen_obs_load_data_index(gen_obs_type *obs,
                                         const char *data_index_file);
 void gen_obs_parse_data_index(gen_obs_type *obs, const char *data_index_string);
+/** Serialize the loaded observation for the startup snapshot; the
+    fread variant returns NULL on a malformed buffer. */
+void gen_obs_fwrite(const gen_obs_type *gen_obs, buffer_type *buffer);
+gen_obs_type *gen_obs_fread_alloc(const gen_data_config_type *data_config,
+                                  const char *obs_key, buffer_type *buffer);
 extern "C" void gen_obs_free(gen_obs_type *gen_obs);
 
 VOID_CHI2_HEADER(gen_obs);
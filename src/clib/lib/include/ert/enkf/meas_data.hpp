@@ -8,25 +8,40 @@
 #include <ert/util/bool_vector.h>
 #include <ert/util/hash.h>
 
+#include <ert/enkf/ensemble_mask.hpp>
 #include <ert/tooling.hpp>
 
 typedef struct meas_data_struct meas_data_type;
 typedef struct meas_block_struct meas_block_type;
 
 meas_block_type *meas_block_alloc(const char *obs_key,
-                                  const std::vector<bool> &ens_mask,
+                                  const ert::EnsembleMask &ens_mask,
                                   int obs_size);
 void meas_block_iset(meas_block_type *meas_block, int iens, int iobs,
                      double value);
+void meas_block_set_column(meas_block_type *meas_block, int iens,
+                           const double *values, int n);
+Eigen::Map<const Eigen::MatrixXd, Eigen::Unaligned, Eigen::OuterStride<>>
+meas_block_get_matrix_view(const meas_block_type *meas_block);
 double meas_block_iget(const meas_block_type *meas_block, int iens, int iobs);
 double meas_block_iget_ens_mean(meas_block_type *meas_block, int iobs);
 double meas_block_iget_ens_std(meas_block_type *meas_block, int iobs);
+/** Fused (value - obs)^2 / var evaluation for the whole block; chi2 is
+    indexed by global iens and only written for masked members.
+    obs_active may be NULL when every observation is active. */
+void meas_block_chi2(const meas_block_type *meas_block, const double *obs_value,
+                     const double *obs_std, const bool *obs_active,
+                     double *chi2);
 void meas_block_deactivate(meas_block_type *meas_block, int iobs);
 bool meas_block_iget_active(const meas_block_type *meas_block, int iobs);
 void meas_block_free(meas_block_type *meas_block);
 
-meas_data_type *meas_data_alloc(const std::vector<bool> &ens_mask);
+meas_data_type *meas_data_alloc(const ert::EnsembleMask &ens_mask);
 
+/** Clear preserving capacity: retires the current blocks so that
+    meas_data_add_block() recycles their buffers instead of
+    allocating. A changed ensemble mask drops the retired blocks. */
+void meas_data_reset(meas_data_type *matrix, const ert::EnsembleMask &ens_mask);
 void meas_data_free(meas_data_type *);
 Eigen::MatrixXd meas_data_makeS(const meas_data_type *matrix);
 int meas_data_get_active_ens_size(const meas_data_type *meas_data);
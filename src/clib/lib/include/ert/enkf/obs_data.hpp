@@ -22,8 +22,14 @@ void obs_block_deactivate(obs_block_type *obs_block, int iobs, const char *msg);
 int obs_block_get_size(const obs_block_type *obs_block);
 void obs_block_iset(obs_block_type *obs_block, int iobs, double value,
                     double std);
+void obs_block_fill(obs_block_type *obs_block, const double *values,
+                    const double *stds, int size);
 void obs_block_iset_missing(obs_block_type *obs_block, int iobs);
 
+/** Chi2 of a whole meas_block against this observation block; chi2 is
+    indexed by global iens and only written for masked members. */
+void obs_block_chi2(const obs_block_type *obs_block,
+                    const meas_block_type *meas_block, double *chi2);
 double obs_block_iget_std(const obs_block_type *obs_block, int iobs);
 double obs_block_iget_value(const obs_block_type *obs_block, int iobs);
 
@@ -34,6 +40,10 @@ obs_block_type *obs_data_add_block(obs_data_type *obs_data, const char *obs_key,
                                    int obs_size);
 
 obs_data_type *obs_data_alloc(double global_std_scaling);
+/** Clear preserving capacity: retires the current blocks so that
+    obs_data_add_block() recycles their buffers instead of
+    allocating. */
+void obs_data_reset(obs_data_type *obs_data, double global_std_scaling);
 void obs_data_free(obs_data_type *);
 
 Eigen::VectorXd obs_data_values_as_vector(const obs_data_type *obs_data);
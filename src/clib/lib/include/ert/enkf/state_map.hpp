@@ -1,20 +1,38 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include <ert/enkf/enkf_types.hpp>
 
 class StateMap {
-    std::vector<int> m_state;
+    /** The states live in a fixed-length block of atomics which is
+        swapped out wholesale on structural changes (read()); element
+        transitions are CAS updates in place. Readers therefore never
+        take a lock - they load the current block and read atomically. */
+    std::shared_ptr<std::vector<std::atomic<int>>> m_state;
+    /** Serializes structural changes and file I/O. */
     mutable std::mutex m_mutex;
+    /** Bumped on every mutation; compared against m_synced_version to
+        skip flushing an unchanged map. */
+    std::atomic<std::uint64_t> m_version{0};
+    mutable std::atomic<std::uint64_t> m_synced_version{0};
+    /** Wakes wait_for_change() subscribers; signalled by notify_change()
+        after every version bump. */
+    mutable std::mutex m_version_mutex;
+    mutable std::condition_variable m_version_cv;
+
+    void notify_change();
 
 public:
     StateMap() = delete;
-    StateMap(unsigned ensemble_size) {
-        m_state.resize(ensemble_size, STATE_UNDEFINED);
-    };
+    StateMap(unsigned ensemble_size);
 
     int size() const;
 
@@ -27,7 +45,6 @@ public:
 
     /**
      * Assign a new state at the given index, overriding previously set flags.
-     * Resize internal array to contain index if index is out of bounds
      *
      * @param index Index in the internal array
      */
@@ -43,8 +60,7 @@ public:
 
     /**
      * Change the value at index to new_state iff. the value is currently
-     * state_mask. Resizes internal array to contain index if the index is out
-     * of bounds
+     * state_mask. The check-and-set is one atomic transition.
      *
      * @param index Index in the internal state array
      * @param state_mask Flags that we expect the value at position index to be set
@@ -53,6 +69,11 @@ public:
     void update_matching(size_t index, int state_mask,
                          realisation_state_enum new_state);
 
+    /**
+     * True if the map has been mutated since the last write()
+     */
+    bool dirty() const;
+
     /**
      * Write data to disk, creating directories as needed
      *
@@ -73,6 +94,25 @@ public:
      */
     std::vector<bool> select_matching(int select_mask) const;
 
+    /** One-pass snapshot of the map: the full state vector, the number
+        of realizations per state and the version it was taken at. The
+        vector and the counts are computed from the same pass, so they
+        always agree - unlike a monitor calling get() per realization. */
+    struct Snapshot {
+        std::uint64_t version;
+        std::vector<int> states;
+        /** state value -> number of realizations in that state. */
+        std::map<int, int> counts;
+    };
+    Snapshot snapshot() const;
+
+    /** Block until the version differs from last_version (i.e. some
+        realization changed state) or timeout_seconds elapsed, and
+        return the current version. Monitors poll with last_version
+        from the previous snapshot instead of rescanning the map. */
+    std::uint64_t wait_for_change(std::uint64_t last_version,
+                                  double timeout_seconds) const;
+
     /**
      * Determine whether it is possible to change from state1 to state2.
      *
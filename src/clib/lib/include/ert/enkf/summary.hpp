@@ -18,9 +18,17 @@ extern "C" void summary_set(summary_type *summary, int report_step,
 extern "C" int summary_length(const summary_type *summary);
 extern "C" double summary_undefined_value();
 std::vector<double> summary_user_get_vector(const summary_type *summary);
+void summary_set_vector(summary_type *summary,
+                        const std::vector<double> &values,
+                        double default_value);
+double summary_get_default_value(const summary_type *summary);
 bool summary_forward_load_vector(summary_type *summary,
                                  const ecl_sum_type *ecl_sum,
-                                 const int_vector_type *time_index);
+                                 const std::vector<int> &time_index,
+                                 const std::vector<int> &params_time_index);
+std::vector<int>
+summary_params_time_index(const ecl_sum_type *ecl_sum,
+                          const std::vector<int> &time_index);
 
 VOID_HAS_DATA_HEADER(summary);
 VOID_ALLOC_HEADER(summary);
@@ -0,0 +1,58 @@
+#ifndef ERT_SUMMARY_BLOCK_H
+#define ERT_SUMMARY_BLOCK_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+/**
+   Columnar storage of all summary vectors of one realization.
+
+   Summary data used to be stored as one vector node per (key, iens),
+   so internalizing a realization with tens of thousands of keys issued
+   as many storage writes, and reading it back as many reads. The
+   SummaryBlock collapses the keys of one realization into a single
+   record: a key index followed by a contiguous float32 matrix with one
+   row of num_steps() values per key.
+
+   The block is the preferred representation - internalization writes
+   it instead of the per-key nodes, and the read paths in enkf_node /
+   enkf_config_node consult it before falling back to per-key vectors,
+   so cases written before the block format keep loading. A mixed case
+   (old per-key records plus a block) reads consistently because the
+   first internalization by current code merges the per-key data into
+   the block, which then shadows it.
+*/
+class SummaryBlock {
+public:
+    bool has_key(const std::string &key) const {
+        return m_rows.count(key) > 0;
+    }
+    int num_steps() const { return m_num_steps; }
+    double default_value() const { return m_default_value; }
+    const std::vector<std::string> &keys() const { return m_keys; }
+
+    std::vector<double> get(const std::string &key) const;
+    std::vector<double> get_window(const std::string &key, int step_offset,
+                                   int step_count) const;
+    void set(const std::string &key, const double *values, int size);
+    void set_default_value(double default_value) {
+        m_default_value = default_value;
+    }
+
+    void write_to_buffer(buffer_type *buffer) const;
+    /** nullptr when the buffer does not hold a summary block record. */
+    static std::shared_ptr<SummaryBlock> read_from_buffer(buffer_type *buffer);
+
+private:
+    /** Insertion order - this is also the row order on disk. */
+    std::vector<std::string> m_keys;
+    std::unordered_map<std::string, std::vector<float>> m_rows;
+    int m_num_steps = 0;
+    double m_default_value = 0.0;
+};
+
+#endif
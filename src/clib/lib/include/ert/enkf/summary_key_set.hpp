@@ -1,6 +1,9 @@
 #ifndef ERT_SUMMARY_KEY_SET_H
 #define ERT_SUMMARY_KEY_SET_H
 
+#include <string>
+#include <vector>
+
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/util/stringlist.hpp>
 
@@ -13,12 +16,15 @@ extern "C" void summary_key_set_free(summary_key_set_type *set);
 extern "C" int summary_key_set_get_size(summary_key_set_type *set);
 extern "C" bool summary_key_set_add_summary_key(summary_key_set_type *set,
                                                 const char *summary_key);
+bool summary_key_set_add_summary_keys(summary_key_set_type *set,
+                                      const std::vector<std::string> &keys);
 extern "C" PY_USED bool
 summary_key_set_has_summary_key(summary_key_set_type *set,
                                 const char *summary_key);
 extern "C" stringlist_type *
 summary_key_set_alloc_keys(summary_key_set_type *set);
 extern "C" bool summary_key_set_is_read_only(const summary_key_set_type *set);
+bool summary_key_set_dirty(const summary_key_set_type *set);
 
 extern "C" void summary_key_set_fwrite(summary_key_set_type *set,
                                        const char *filename);
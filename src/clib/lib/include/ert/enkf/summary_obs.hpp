@@ -13,6 +13,7 @@
 #include <ert/enkf/summary_config.hpp>
 
 typedef struct summary_obs_struct summary_obs_type;
+typedef struct summary_obs_pool_struct summary_obs_pool_type;
 
 extern "C" void summary_obs_free(summary_obs_type *summary_obs);
 
@@ -20,6 +21,13 @@ extern "C" summary_obs_type *summary_obs_alloc(const char *summary_key,
                                                const char *obs_key,
                                                double value, double std);
 
+summary_obs_pool_type *summary_obs_pool_alloc();
+void summary_obs_pool_free(summary_obs_pool_type *pool);
+summary_obs_type *summary_obs_alloc_pooled(summary_obs_pool_type *pool,
+                                           const char *summary_key,
+                                           const char *obs_key, double value,
+                                           double std);
+
 extern "C" double summary_obs_get_value(const summary_obs_type *summary_obs);
 extern "C" double summary_obs_get_std(const summary_obs_type *summary_obs);
 extern "C" double
@@ -3,6 +3,8 @@
 
 #include <time.h>
 
+#include <vector>
+
 #include <ert/ecl/ecl_sum.h>
 #include <ert/tooling.hpp>
 #include <ert/util/int_vector.h>
@@ -33,6 +35,11 @@ time_t time_map_get_start_time(time_map_type *map);
 time_t time_map_get_end_time(time_map_type *map);
 double time_map_get_end_days(time_map_type *map);
 bool time_map_is_readonly(const time_map_type *tm);
+/** Bulk variant of time_map_alloc_index_map: one contiguous
+    std::vector<int> instead of an int_vector read element by element
+    through function calls. */
+std::vector<int> time_map_index_map(time_map_type *map,
+                                    const ecl_sum_type *ecl_sum);
 int_vector_type *time_map_alloc_index_map(time_map_type *map,
                                           const ecl_sum_type *ecl_sum);
 extern "C" int time_map_lookup_time(time_map_type *map, time_t time);
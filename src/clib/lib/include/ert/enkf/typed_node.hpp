@@ -0,0 +1,139 @@
+#ifndef ERT_TYPED_NODE_H
+#define ERT_TYPED_NODE_H
+
+#include <stdlib.h>
+
+#include <ert/util/util.h>
+
+#include <ert/enkf/enkf_node.hpp>
+#include <ert/enkf/ext_param.hpp>
+#include <ert/enkf/field.hpp>
+#include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/gen_kw.hpp>
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/surface.hpp>
+
+/*
+  Compile time description of the per-type node operations. Historically
+  every enkf_node instance carried its own table of function pointers,
+  filled in by a runtime switch when the node was allocated; every
+  load/store/serialize then went through an indirect call and a runtime
+  NULL check. The node_ops<> specializations below express the same
+  tables as compile time constants instead: dispatching code branches on
+  the impl type ONCE and each branch resolves to direct calls, with the
+  "operation not supported" checks evaluated by the compiler. Operations
+  a type does not implement are nullptr, mirroring the pointers the old
+  runtime tables left unset.
+*/
+
+template <ert_impl_type impl> struct node_ops;
+
+template <> struct node_ops<GEN_KW> {
+    static constexpr alloc_ftype *alloc = gen_kw_alloc__;
+    static constexpr node_free_ftype *freef = gen_kw_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        gen_kw_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        gen_kw_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = gen_kw_serialize__;
+    static constexpr deserialize_ftype *deserialize = gen_kw_deserialize__;
+    static constexpr initialize_ftype *initialize = nullptr;
+    static constexpr has_data_ftype *has_data = nullptr;
+};
+
+template <> struct node_ops<SUMMARY> {
+    static constexpr alloc_ftype *alloc = summary_alloc__;
+    static constexpr node_free_ftype *freef = summary_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        summary_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        summary_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = summary_serialize__;
+    static constexpr deserialize_ftype *deserialize = summary_deserialize__;
+    static constexpr initialize_ftype *initialize = nullptr;
+    static constexpr has_data_ftype *has_data = summary_has_data__;
+};
+
+template <> struct node_ops<SURFACE> {
+    static constexpr alloc_ftype *alloc = surface_alloc__;
+    static constexpr node_free_ftype *freef = surface_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        surface_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        surface_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = surface_serialize__;
+    static constexpr deserialize_ftype *deserialize = surface_deserialize__;
+    static constexpr initialize_ftype *initialize = surface_initialize__;
+    static constexpr has_data_ftype *has_data = nullptr;
+};
+
+template <> struct node_ops<FIELD> {
+    static constexpr alloc_ftype *alloc = field_alloc__;
+    static constexpr node_free_ftype *freef = field_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        field_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        field_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = field_serialize__;
+    static constexpr deserialize_ftype *deserialize = field_deserialize__;
+    static constexpr initialize_ftype *initialize = field_initialize__;
+    static constexpr has_data_ftype *has_data = nullptr;
+};
+
+template <> struct node_ops<GEN_DATA> {
+    static constexpr alloc_ftype *alloc = gen_data_alloc__;
+    static constexpr node_free_ftype *freef = gen_data_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        gen_data_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        gen_data_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = gen_data_serialize__;
+    static constexpr deserialize_ftype *deserialize = gen_data_deserialize__;
+    static constexpr initialize_ftype *initialize = nullptr;
+    static constexpr has_data_ftype *has_data = nullptr;
+};
+
+/* EXT_PARAM is used by Everest; it only moves through storage and is
+   never part of the update. */
+template <> struct node_ops<EXT_PARAM> {
+    static constexpr alloc_ftype *alloc = ext_param_alloc__;
+    static constexpr node_free_ftype *freef = ext_param_free__;
+    static constexpr write_to_buffer_ftype *write_to_buffer =
+        ext_param_write_to_buffer__;
+    static constexpr read_from_buffer_ftype *read_from_buffer =
+        ext_param_read_from_buffer__;
+    static constexpr serialize_ftype *serialize = nullptr;
+    static constexpr deserialize_ftype *deserialize = nullptr;
+    static constexpr initialize_ftype *initialize = nullptr;
+    static constexpr has_data_ftype *has_data = nullptr;
+};
+
+/**
+   Invoke @visitor with the node_ops<> specialization matching
+   @impl_type. The visitor is instantiated once per implementation type,
+   so inside the visitor body the operations are compile time constants.
+*/
+template <typename F>
+decltype(auto) enkf_node_typed_dispatch(ert_impl_type impl_type, F &&visitor) {
+    switch (impl_type) {
+    case GEN_KW:
+        return visitor(node_ops<GEN_KW>{});
+    case SUMMARY:
+        return visitor(node_ops<SUMMARY>{});
+    case SURFACE:
+        return visitor(node_ops<SURFACE>{});
+    case FIELD:
+        return visitor(node_ops<FIELD>{});
+    case GEN_DATA:
+        return visitor(node_ops<GEN_DATA>{});
+    case EXT_PARAM:
+        return visitor(node_ops<EXT_PARAM>{});
+    default:
+        util_abort("%s: implementation type: %d unknown - all hell is loose - "
+                   "aborting \n",
+                   __func__, impl_type);
+    }
+    abort();
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef ERT_GEMM_BACKEND_HPP
+#define ERT_GEMM_BACKEND_HPP
+
+#include <Eigen/Dense>
+
+/*
+  Optional GPU backend for the dense matrix products which dominate the
+  large updates: the A' = A * X application, the scaled per-group
+  products of RowScaling::multiply() and the sketching products of the
+  randomized SVD.
+
+  The backend is compiled in with -DERT_USE_CUBLAS=ON (cuBLAS); without
+  the flag, or when no device is available, or when the product is too
+  small to amortize the transfers, the calls below are plain Eigen
+  products. Any device-side failure (allocation, launch, transfer)
+  falls back to the host path as well, so callers never have to handle
+  GPU errors. Row blocks of the left operand are streamed through
+  device memory, so parameters larger than VRAM still offload.
+*/
+
+namespace ert {
+
+/** A = A * X, with X square (the ensemble transition matrix). */
+void gemm_inplace(Eigen::Ref<Eigen::MatrixXd> A, const Eigen::MatrixXd &X);
+
+/** Plain product C = A * B. */
+Eigen::MatrixXd gemm(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B);
+
+/** True when a usable GPU backend was compiled in and a device is
+    present; informational only, the entry points fall back by
+    themselves. */
+bool gemm_gpu_available();
+
+} // namespace ert
+
+#endif
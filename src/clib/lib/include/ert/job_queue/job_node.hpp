@@ -60,6 +60,8 @@ bool job_queue_node_kill(job_queue_node_type *node,
                          queue_driver_type *driver);
 extern "C" PY_USED bool job_queue_node_kill_simple(job_queue_node_type *node,
                                                    queue_driver_type *driver);
+void *job_queue_node_detach_for_kill(job_queue_node_type *node,
+                                     job_queue_status_type *status);
 extern "C" void job_queue_node_free(job_queue_node_type *node);
 extern "C" job_status_type
 job_queue_node_get_status(const job_queue_node_type *node);
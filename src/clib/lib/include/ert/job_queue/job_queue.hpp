@@ -35,6 +35,7 @@ int job_queue_iget_status_summary(const job_queue_type *queue,
 extern "C" PY_USED void
 job_queue_set_max_job_duration(job_queue_type *queue, int max_duration_seconds);
 extern "C" bool job_queue_kill_job(job_queue_type *queue, int job_index);
+extern "C" PY_USED int job_queue_kill_all_jobs(job_queue_type *queue);
 extern "C" PY_USED bool job_queue_is_running(const job_queue_type *queue);
 void job_queue_set_max_submit(job_queue_type *job_queue, int max_submit);
 extern "C" int job_queue_get_max_submit(const job_queue_type *job_queue);
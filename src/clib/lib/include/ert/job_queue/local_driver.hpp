@@ -3,6 +3,15 @@
 
 #include <ert/job_queue/queue_driver.hpp>
 
+/**
+  Comma separated list of CPU ids - possibly with a-b ranges - which the
+  driver will hand out to the spawned jobs in round-robin order. Each job
+  gets num_cpu consecutive entries from the list pinned with
+  sched_setaffinity(); when the option is not set the jobs inherit the
+  affinity mask of the parent process as before.
+*/
+#define LOCAL_CPU_LIST "CPU_LIST"
+
 typedef struct local_driver_struct local_driver_type;
 
 void *local_driver_alloc();
@@ -15,6 +24,10 @@ void local_driver_kill_job(void *__driver, void *__job);
 void local_driver_free__(void *__driver);
 job_status_type local_driver_get_job_status(void *__driver, void *__job);
 void local_driver_free_job(void *__job);
+bool local_driver_set_option(void *__driver, const char *option_key,
+                             const void *value);
+const void *local_driver_get_option(const void *__driver,
+                                    const char *option_key);
 void local_driver_init_option_list(stringlist_type *option_list);
 
 #endif
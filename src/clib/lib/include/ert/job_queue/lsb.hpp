@@ -13,10 +13,11 @@ lsb_type *lsb_alloc();
 void lsb_free(lsb_type *lsb);
 bool lsb_ready(const lsb_type *lsb);
 
-int lsb_initialize(const lsb_type *lsb);
+int lsb_initialize(lsb_type *lsb);
 int lsb_submitjob(const lsb_type *lsb, struct submit *, struct submitReply *);
 int lsb_killjob(const lsb_type *lsb, int lsf_jobnr);
 int lsb_openjob(const lsb_type *lsb, int lsf_jobnr);
+int lsb_openjobs(const lsb_type *lsb);
 struct jobInfoEnt *lsb_readjob(const lsb_type *lsb);
 int lsb_closejob(const lsb_type *lsb);
 char *lsb_sys_msg(const lsb_type *lsb);
@@ -19,6 +19,7 @@
 #define LSF_BJOBS_TIMEOUT "BJOBS_TIMEOUT"
 #define LSF_DEBUG_OUTPUT "DEBUG_OUTPUT"
 #define LSF_SUBMIT_SLEEP "SUBMIT_SLEEP"
+#define LSF_SUBMIT_WINDOW "SUBMIT_WINDOW"
 #define LSF_EXCLUDE_HOST "EXCLUDE_HOST"
 #define LSF_PROJECT_CODE "PROJECT_CODE"
 
@@ -49,9 +50,14 @@ stringlist_type *lsf_driver_alloc_cmd(lsf_driver_type *driver,
 void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
                             const char *run_path, const char *job_name,
                             int argc, const char **argv);
+int lsf_driver_submit_job_array(void *__driver, const char *submit_cmd,
+                                int num_cpu, const char *job_name,
+                                int num_jobs, const char **run_paths,
+                                void **jobs);
 job_status_type lsf_driver_convert_status(int lsf_status);
 void lsf_driver_blacklist_node(void *__driver, void *__job);
 void lsf_driver_kill_job(void *__driver, void *__job);
+void lsf_driver_kill_jobs(void *__driver, int num_jobs, void **jobs);
 void lsf_driver_free__(void *__driver);
 void lsf_driver_free(lsf_driver_type *driver);
 job_status_type lsf_driver_get_job_status(void *__driver, void *__job);
@@ -0,0 +1,51 @@
+#ifndef ERT_PBS_SESSION_H
+#define ERT_PBS_SESSION_H
+
+#include <string>
+
+#include <ert/util/stringlist.hpp>
+
+/*
+  Minimal declarations of the PBS IFL structs used through the
+  dlopen()ed client library. Declaring them here - with the same layout
+  as the attrl / attropl / batch_status structs from pbs_ifl.h - means
+  the job_queue library builds without the PBS development headers
+  installed; the library itself is only loaded at runtime.
+*/
+struct pbs_attrl {
+    struct pbs_attrl *next;
+    char *name;
+    char *resource;
+    char *value;
+};
+
+struct pbs_attropl {
+    struct pbs_attropl *next;
+    char *name;
+    char *resource;
+    char *value;
+    int op;
+};
+
+struct pbs_batch_status {
+    struct pbs_batch_status *next;
+    char *name;
+    struct pbs_attrl *attribs;
+    char *text;
+};
+
+typedef struct pbs_session_struct pbs_session_type;
+
+pbs_session_type *pbs_session_alloc(const char *server);
+void pbs_session_free(pbs_session_type *session);
+bool pbs_session_ready(const pbs_session_type *session);
+stringlist_type *pbs_session_get_error_list(const pbs_session_type *session);
+
+char *pbs_session_submit_job(pbs_session_type *session, const char *script,
+                             const char *destination, const char *job_name,
+                             const char *resource_nodes, bool keep_output);
+bool pbs_session_job_state(pbs_session_type *session, const char *job_id,
+                           std::string &job_state, int &exit_status);
+bool pbs_session_deljob(pbs_session_type *session, const char *job_id);
+
+#endif
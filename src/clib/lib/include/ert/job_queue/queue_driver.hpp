@@ -25,6 +25,7 @@ typedef void *(submit_job_ftype)(void *data, const char *cmd, int num_cpu,
                                  int argc, const char **argv);
 typedef void(blacklist_node_ftype)(void *, void *);
 typedef void(kill_job_ftype)(void *, void *);
+typedef void(kill_jobs_ftype)(void *, int, void **);
 typedef job_status_type(get_status_ftype)(void *, void *);
 typedef void(free_job_ftype)(void *);
 typedef void(free_queue_driver_ftype)(void *);
@@ -34,6 +35,19 @@ typedef void(init_option_list_ftype)(stringlist_type *);
 
 extern "C" queue_driver_type *queue_driver_alloc(job_driver_type type);
 
+/**
+   Allocates a driver which dispatches to the caller supplied callbacks
+   instead of a real queue system. This is meant for tests and
+   benchmarks which need a synthetic in-process driver; the data pointer
+   is passed as the first argument to the callbacks and remains owned by
+   the caller.
+*/
+queue_driver_type *queue_driver_alloc_mock(submit_job_ftype *submit,
+                                           get_status_ftype *get_status,
+                                           kill_job_ftype *kill_job,
+                                           free_job_ftype *free_job,
+                                           void *data);
+
 void *queue_driver_submit_job(queue_driver_type *driver, const char *run_cmd,
                               int num_cpu, const char *run_path,
                               const char *job_name, int argc,
@@ -43,6 +57,8 @@ extern "C" void queue_driver_free_job(queue_driver_type *driver,
 void queue_driver_blacklist_node(queue_driver_type *driver, void *job_data);
 extern "C" void queue_driver_kill_job(queue_driver_type *driver,
                                       void *job_data);
+void queue_driver_kill_jobs(queue_driver_type *driver, int num_jobs,
+                            void **jobs);
 extern "C" job_status_type queue_driver_get_status(queue_driver_type *driver,
                                                    void *job_data);
 
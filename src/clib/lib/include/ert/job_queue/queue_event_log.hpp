@@ -0,0 +1,20 @@
+#ifndef ERT_QUEUE_EVENT_LOG_H
+#define ERT_QUEUE_EVENT_LOG_H
+
+#include <ert/job_queue/job_status.hpp>
+
+/*
+  Process wide timeline of job status transitions, recorded into a
+  lock free ring buffer from the transition choke point in
+  job_queue_node_set_status(). Set the environment variable
+  ERT_QUEUE_EVENT_LOG to a filename to get the timeline dumped in the
+  Chrome trace JSON format (load with chrome://tracing or Perfetto)
+  when the queue is freed.
+*/
+
+void queue_event_log_record(int queue_index, job_status_type old_status,
+                            job_status_type new_status);
+void queue_event_log_fwrite_chrome_trace(const char *filename);
+void queue_event_log_clear();
+
+#endif
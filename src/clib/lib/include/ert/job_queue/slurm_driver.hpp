@@ -28,6 +28,7 @@ void *slurm_driver_submit_job(void *__driver, const char *cmd, int num_cpu,
                               int argc, const char **argv);
 job_status_type slurm_driver_get_job_status(void *__driver, void *__job);
 void slurm_driver_kill_job(void *__driver, void *__job);
+void slurm_driver_kill_jobs(void *__driver, int num_jobs, void **jobs);
 void slurm_driver_free_job(void *__job);
 
 #endif
@@ -20,12 +20,18 @@
 #define TORQUE_JOB_PREFIX_KEY "JOB_PREFIX"
 #define TORQUE_SUBMIT_SLEEP "SUBMIT_SLEEP"
 #define TORQUE_DEBUG_OUTPUT "DEBUG_OUTPUT"
+/** Multiplex qsub/qstat/qdel over one persistent PBS server connection
+ *  (default TRUE); the per-command spawning remains as fallback. */
+#define TORQUE_SESSION "SESSION"
 
 #define TORQUE_DEFAULT_QSUB_CMD "qsub"
-#define TORQUE_DEFAULT_QSTAT_CMD "qstat_proxy.sh"
+#define TORQUE_DEFAULT_QSTAT_CMD "qstat"
 #define TORQUE_DEFAULT_QSTAT_OPTIONS "-x"
 #define TORQUE_DEFAULT_QDEL_CMD "qdel"
 #define TORQUE_DEFAULT_SUBMIT_SLEEP "0"
+/** Seconds one batched "qstat -f" result is served from memory before the
+ * table is refreshed; matches the cache timeout the qstat proxy script had. */
+#define TORQUE_DEFAULT_QSTAT_REFRESH_INTERVAL 2
 
 typedef struct torque_driver_struct torque_driver_type;
 typedef struct torque_job_struct torque_job_type;
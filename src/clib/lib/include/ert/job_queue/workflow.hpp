@@ -8,6 +8,15 @@
 #include <ert/job_queue/workflow_job.hpp>
 #include <ert/job_queue/workflow_joblist.hpp>
 
+/**
+   Markers in the workflow language delimiting groups of mutually
+   independent jobs: jobs between PARALLEL and the next SERIAL (or the
+   end of the file) form one group and run concurrently, everything
+   else runs in file order as before.
+*/
+#define WORKFLOW_PARALLEL_KW "PARALLEL"
+#define WORKFLOW_SERIAL_KW "SERIAL"
+
 typedef struct workflow_struct workflow_type;
 
 extern "C" const config_error_type *
@@ -28,6 +37,10 @@ extern "C" const workflow_job_type *
 workflow_iget_job(const workflow_type *workflow, int index);
 extern "C" stringlist_type *
 workflow_iget_arguments(const workflow_type *workflow, int index);
+/** The PARALLEL group the job at 'index' belongs to, or -1 for the
+    default serial execution. */
+extern "C" int workflow_iget_parallel_group(const workflow_type *workflow,
+                                            int index);
 extern "C" bool workflow_try_compile(workflow_type *script,
                                      const subst_list_type *context);
 
@@ -20,6 +20,15 @@ void workflow_job_set_executable(workflow_job_type *workflow_job,
 extern "C" workflow_job_type *
 workflow_job_config_alloc(const char *name, config_parser_type *config,
                           const char *config_file);
+/** Reconstruct a job definition from previously parsed fields stored
+    in the on-disk workflow-job cache; arg_types is a space separated
+    list of config_item_types values. The job is revalidated, and NULL
+    is returned when it no longer validates. */
+extern "C" workflow_job_type *
+workflow_job_alloc_cached(const char *name, bool internal, int min_arg,
+                          int max_arg, const char *arg_types,
+                          const char *executable, const char *internal_script,
+                          const char *function);
 
 void workflow_job_update_config_compiler(const workflow_job_type *workflow_job,
                                          config_parser_type *config_compiler);
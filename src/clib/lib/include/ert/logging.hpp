@@ -4,10 +4,36 @@
 #ifndef RES_LOGGING_HPP
 #define RES_LOGGING_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
 namespace ert {
+
+/**
+ * Per call-site state for the rate limited / sampled logging helpers
+ * on ILogger. Declare one static instance next to the log statement:
+ *
+ *     static ert::LogSite site;
+ *     logger->debug_limited(site, 10, "job {} changed state", job);
+ *
+ * The counters are atomics, so a site shared between threads needs no
+ * further locking.
+ */
+struct LogSite {
+    /** Second (steady clock) the current rate window started. */
+    std::atomic<int64_t> window_start{0};
+    /** Messages admitted in the current window. */
+    std::atomic<uint32_t> window_count{0};
+    /** Messages dropped since the last admitted one. */
+    std::atomic<uint32_t> suppressed{0};
+    /** Total calls, used by the sampling helpers. */
+    std::atomic<uint64_t> hits{0};
+};
+
 /**
  * The ILogger is primarily used to log from C++ to Python via <ert/python.hpp>
  * but is kept separate in case we want other implementations, like
@@ -18,36 +44,121 @@ public:
     enum struct Level { debug, info, warning, error, critical };
     virtual ~ILogger() = default;
 
+    /**
+     * Whether a message of @level would actually be emitted. The
+     * formatting helpers below check this before touching their
+     * arguments, so instrumentation below the active level costs a
+     * virtual call and nothing else.
+     */
+    virtual bool enabled(Level level) { return true; }
+
     template <typename... Args> void debug(fmt::string_view f, Args &&...args) {
+        if (!this->enabled(Level::debug))
+            return;
         this->log(Level::debug, f,
                   fmt::make_format_args(std::forward<Args>(args)...));
     }
 
     template <typename... Args> void info(fmt::string_view f, Args &&...args) {
+        if (!this->enabled(Level::info))
+            return;
         this->log(Level::info, f,
                   fmt::make_format_args(std::forward<Args>(args)...));
     }
 
     template <typename... Args>
     void warning(fmt::string_view f, Args &&...args) {
+        if (!this->enabled(Level::warning))
+            return;
         this->log(Level::warning, f,
                   fmt::make_format_args(std::forward<Args>(args)...));
     }
 
     template <typename... Args> void error(fmt::string_view f, Args &&...args) {
+        if (!this->enabled(Level::error))
+            return;
         this->log(Level::error, f,
                   fmt::make_format_args(std::forward<Args>(args)...));
     }
 
     template <typename... Args>
     void critical(fmt::string_view f, Args &&...args) {
+        if (!this->enabled(Level::critical))
+            return;
         this->log(Level::critical, f,
                   fmt::make_format_args(std::forward<Args>(args)...));
     }
 
+    /**
+     * Rate limited logging: at most @max_per_second messages from
+     * @site are emitted per second, the rest are counted and reported
+     * as a suppression count on the next admitted message. Bursts of
+     * per-realization messages during mass state transitions then
+     * leave a handful of lines plus a count instead of flooding the
+     * log.
+     */
+    template <typename... Args>
+    void debug_limited(LogSite &site, uint32_t max_per_second,
+                       fmt::string_view f, Args &&...args) {
+        this->log_limited(Level::debug, site, max_per_second, f,
+                          std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    void info_limited(LogSite &site, uint32_t max_per_second,
+                      fmt::string_view f, Args &&...args) {
+        this->log_limited(Level::info, site, max_per_second, f,
+                          std::forward<Args>(args)...);
+    }
+
+    /** Sampled logging: every @sample_interval'th call from @site is
+        emitted, starting with the first. */
+    template <typename... Args>
+    void debug_sampled(LogSite &site, uint64_t sample_interval,
+                       fmt::string_view f, Args &&...args) {
+        if (sample_interval > 1 &&
+            site.hits.fetch_add(1, std::memory_order_relaxed) %
+                    sample_interval !=
+                0)
+            return;
+        this->debug(f, std::forward<Args>(args)...);
+    }
+
 protected:
     virtual void log(Level level, fmt::string_view f,
                      fmt::format_args args) = 0;
+
+private:
+    template <typename... Args>
+    void log_limited(Level level, LogSite &site, uint32_t max_per_second,
+                     fmt::string_view f, Args &&...args) {
+        if (!this->enabled(level))
+            return;
+
+        auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+        if (site.window_start.load(std::memory_order_relaxed) != now) {
+            site.window_start.store(now, std::memory_order_relaxed);
+            site.window_count.store(0, std::memory_order_relaxed);
+        }
+        if (site.window_count.fetch_add(1, std::memory_order_relaxed) >=
+            max_per_second) {
+            site.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        uint32_t dropped = site.suppressed.exchange(0, std::memory_order_relaxed);
+        if (dropped == 0) {
+            this->log(level, f,
+                      fmt::make_format_args(std::forward<Args>(args)...));
+        } else {
+            auto payload = fmt::vformat(
+                f, fmt::make_format_args(std::forward<Args>(args)...));
+            this->log(level, "{} [{} similar messages suppressed]",
+                      fmt::make_format_args(payload, dropped));
+        }
+    }
 };
 /**
 * Creates a logger that logs only to Python's logger of the same
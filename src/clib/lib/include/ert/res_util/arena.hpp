@@ -0,0 +1,131 @@
+#ifndef ERT_ARENA_H
+#define ERT_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ert {
+namespace utils {
+
+/**
+   Bump allocator for short-lived scratch buffers.
+
+   The hot loops - loading an ensemble of nodes from storage, rendering
+   the runpath templates per realization - allocate and free the same
+   transient buffers over and over, and the malloc/free pair dominates
+   the per-iteration cost. An Arena hands out memory by bumping an
+   offset into a chunk and never frees individual allocations; instead
+   the caller brackets one iteration with an ArenaScope, which rewinds
+   the arena to where it was when the scope was entered. The chunks
+   themselves are retained, so after the first iteration the memory is
+   warm and allocation is a pointer increment.
+
+   The arena is not thread safe - use thread_arena() to get the arena
+   belonging to the calling thread.
+*/
+class Arena {
+public:
+    explicit Arena(std::size_t chunk_size = 1 << 20)
+        : m_chunk_size(chunk_size) {}
+
+    void *allocate(std::size_t bytes,
+                   std::size_t alignment = alignof(std::max_align_t)) {
+        while (m_active < m_chunks.size()) {
+            Chunk &chunk = m_chunks[m_active];
+            std::size_t offset = align_up(chunk.used, alignment);
+            if (offset + bytes <= chunk.size) {
+                chunk.used = offset + bytes;
+                return chunk.data.get() + offset;
+            }
+            m_active++;
+        }
+        std::size_t size = std::max(m_chunk_size, bytes + alignment);
+        m_chunks.push_back(
+            Chunk{std::unique_ptr<char[]>(new char[size]), size, 0});
+        m_active = m_chunks.size() - 1;
+        return allocate(bytes, alignment);
+    }
+
+    template <typename T> T *allocate_array(std::size_t count) {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /** Current position; handed back to rewind() to release everything
+        allocated after the marker was taken. */
+    struct Marker {
+        std::size_t chunk;
+        std::size_t used;
+    };
+
+    Marker mark() const {
+        if (m_chunks.empty())
+            return {0, 0};
+        return {m_active, m_chunks[m_active].used};
+    }
+
+    void rewind(Marker marker) {
+        for (std::size_t index = marker.chunk + 1; index < m_chunks.size();
+             index++)
+            m_chunks[index].used = 0;
+        if (marker.chunk < m_chunks.size())
+            m_chunks[marker.chunk].used = marker.used;
+        m_active = marker.chunk;
+    }
+
+    /** Total bytes held by the arena, live or not. */
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const Chunk &chunk : m_chunks)
+            total += chunk.size;
+        return total;
+    }
+
+private:
+    static std::size_t align_up(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    std::vector<Chunk> m_chunks;
+    std::size_t m_active = 0;
+    std::size_t m_chunk_size;
+};
+
+/** The scratch arena of the calling thread. */
+inline Arena &thread_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+/**
+   Rewinds the arena on scope exit to where it was on scope entry.
+   Scopes nest; memory allocated from the arena must not be used past
+   the end of the scope it was allocated under.
+*/
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena &arena = thread_arena())
+        : m_arena(arena), m_marker(arena.mark()) {}
+    ~ArenaScope() { m_arena.rewind(m_marker); }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+    Arena &arena() { return m_arena; }
+
+private:
+    Arena &m_arena;
+    Arena::Marker m_marker;
+};
+
+} // namespace utils
+} // namespace ert
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef ERT_BLOCK_FS
 #define ERT_BLOCK_FS
 #include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <ert/util/buffer.hpp>
 #include <ert/util/vector.hpp>
@@ -8,10 +11,25 @@
 typedef struct block_fs_struct block_fs_type;
 typedef struct user_file_node_struct user_file_node_type;
 
+/**
+   Read-only view of a stored node. When the node can be served
+   straight from the shared mapping of the data file 'data' borrows
+   the mapped bytes; the borrowed pointer is valid until
+   block_fs_close(). Compressed nodes and unmappable data files fall
+   back to a copy placed in the scratch arena of the reading thread,
+   so the caller must hold an ert::utils::ArenaScope across the read
+   and every use of the view.
+*/
+struct block_fs_view {
+    const char *data = nullptr;
+    size_t size = 0;
+};
+
 void block_fs_fsync(block_fs_type *block_fs);
 static bool block_fs_is_readonly(const block_fs_type *block_fs);
 block_fs_type *block_fs_mount(const std::filesystem::path &mount_file,
-                              int fsync_interval, bool read_only);
+                              int fsync_interval, bool read_only,
+                              bool compression = false, bool checksum = false);
 void block_fs_close(block_fs_type *block_fs);
 void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
                           const void *ptr, size_t byte_size);
@@ -19,5 +37,16 @@ void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                             const buffer_type *buffer);
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer);
+void block_fs_fread_view(block_fs_type *block_fs, const char *filename,
+                         block_fs_view &view);
+void block_fs_prefetch(block_fs_type *block_fs, const char *filename);
+size_t block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                            size_t offset, size_t count, buffer_type *buffer);
+void block_fs_fread_files(
+    block_fs_type *block_fs,
+    std::vector<std::pair<std::string, buffer_type *>> &requests);
 bool block_fs_has_file(block_fs_type *block_fs, const char *filename);
+/** Number of stored nodes and the byte size of the data file. */
+void block_fs_stats(block_fs_type *block_fs, size_t *num_files,
+                    size_t *data_bytes);
 #endif
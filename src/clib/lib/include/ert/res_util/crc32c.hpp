@@ -0,0 +1,29 @@
+#ifndef ERT_CRC32C_H
+#define ERT_CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ert {
+namespace utils {
+
+/**
+   CRC32C (Castagnoli) checksum of 'size' bytes. Uses the SSE4.2 crc32
+   instruction when the CPU has it (detected once at runtime) with a
+   table-driven fallback, so checksumming runs far above the disk
+   bandwidth it protects.
+*/
+uint32_t crc32c(const void *data, std::size_t size);
+
+/**
+   Extend a running checksum with another chunk of data. Start from 0
+   and feed the bytes in any chunking; the final value equals crc32c()
+   over the concatenated input, so large files can be checksummed
+   through a fixed-size buffer.
+*/
+uint32_t crc32c_extend(uint32_t crc, const void *data, std::size_t size);
+
+} // namespace utils
+} // namespace ert
+
+#endif
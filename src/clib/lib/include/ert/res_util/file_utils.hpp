@@ -2,6 +2,8 @@
 #define ERT_FILE_UTILS_H
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -11,4 +13,10 @@ namespace fs = std::filesystem;
 */
 FILE *mkdir_fopen(fs::path, const char *);
 
+/**
+   Create every directory in @paths; the common parent is created once
+   and the per-path subtrees are created in parallel.
+*/
+void create_runpath_directories(const std::vector<std::string> &paths);
+
 #endif
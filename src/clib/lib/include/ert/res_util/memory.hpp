@@ -1,7 +1,12 @@
 #ifndef ERT_MEMORY_H
 #define ERT_MEMORY_H
 
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <mutex>
+#include <string>
+
 #include <ert/logging.hpp>
 
 namespace ert {
@@ -12,6 +17,114 @@ std::size_t process_memory(void);
 std::size_t process_max_memory(void);
 std::size_t process_max_rss(void);
 
+/**
+   Tagged allocation accounting: the major memory consumers charge
+   their allocations to a named account, so an OOM report can say how
+   much of the footprint sits in storage buffers, update matrices or
+   the observation tree instead of only reporting total RSS.
+
+   Accounts are registered once by name through memory_account() and
+   charging is two relaxed atomic adds. When the environment variable
+   ERT_MEMORY_LOG_THRESHOLD_MB is set, a per-account report is logged
+   every time the total tracked footprint grows past another multiple
+   of the threshold.
+*/
+class MemoryAccount {
+public:
+    void allocate(std::size_t bytes) noexcept;
+    void release(std::size_t bytes) noexcept;
+
+    std::size_t current() const noexcept {
+        return m_current.load(std::memory_order_relaxed);
+    }
+    std::size_t peak() const noexcept {
+        return m_peak.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t> m_current{};
+    std::atomic<std::size_t> m_peak{};
+};
+
+/** The account registered under 'tag'; the reference stays valid for
+    the lifetime of the process. */
+MemoryAccount &memory_account(const std::string &tag);
+
+/**
+   Advise the kernel to back [data, data + size) with transparent huge
+   pages - worthwhile for the multi-GB update matrices where 4k TLB
+   misses are measurable. The range is rounded inward to page
+   boundaries; best effort, a no-op when THP is unavailable.
+*/
+void advise_huge_pages(void *data, std::size_t size);
+
+/** One "tag: current Mb (peak Mb)" line per registered account. */
+std::string memory_report();
+
+/** The process memory peaks plus the per-account current/peak bytes
+    as a JSON document, for the end-of-run performance report. */
+std::string memory_report_json();
+
+/**
+   Admission control for memory-hungry parallel work. Subsystems which
+   fan out over the ensemble - result loading, parameter
+   initialization - request admission with an estimated working-set
+   size before starting a unit of work, and requests block while the
+   sum of admitted estimates would exceed the budget. Landing at the
+   budget with a few workers is far faster than pushing the node into
+   swap with all of them. A budget of zero admits everything
+   immediately, and an estimate larger than the whole budget is
+   admitted once it runs alone rather than blocking forever.
+*/
+class MemoryGovernor {
+public:
+    explicit MemoryGovernor(std::size_t budget_bytes)
+        : m_budget(budget_bytes) {}
+
+    void acquire(std::size_t bytes);
+    void release(std::size_t bytes);
+
+private:
+    std::size_t m_budget;
+    std::size_t m_admitted = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+/** The process-wide governor, with its budget read from the
+    environment variable ERT_MEMORY_BUDGET_MB; unset or zero means no
+    throttling. */
+MemoryGovernor &memory_governor();
+
+/** Holds an admission for the scope of a unit of work. */
+class MemoryReservation {
+public:
+    MemoryReservation(MemoryGovernor &governor, std::size_t bytes)
+        : m_governor(governor), m_bytes(bytes) {
+        m_governor.acquire(m_bytes);
+    }
+    ~MemoryReservation() { m_governor.release(m_bytes); }
+
+private:
+    MemoryGovernor &m_governor;
+    std::size_t m_bytes;
+};
+
+/** Charges an account for the scope of an allocation whose size is
+    known up front. */
+class MemoryScope {
+public:
+    MemoryScope(MemoryAccount &account, std::size_t bytes)
+        : m_account(account), m_bytes(bytes) {
+        m_account.allocate(m_bytes);
+    }
+    ~MemoryScope() { m_account.release(m_bytes); }
+
+private:
+    MemoryAccount &m_account;
+    std::size_t m_bytes;
+};
+
 class scoped_memory_logger {
 public:
     scoped_memory_logger(std::shared_ptr<ert::ILogger> logger,
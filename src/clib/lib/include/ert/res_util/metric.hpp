@@ -1,5 +1,12 @@
+#ifndef ERT_METRIC_HPP
+#define ERT_METRIC_HPP
+
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
 
 #include <ert/logging.hpp>
 
@@ -24,4 +31,121 @@ private:
 };
 
 } // namespace utils
+
+/**
+   Low-overhead metrics: named atomic counters and latency histograms
+   collected in a process-wide registry. The sample path is a relaxed
+   atomic increment or two - cheap enough to stay enabled in production
+   runs - while registration (the name lookup) takes a mutex and is
+   meant to be done once, typically through a function-local static:
+
+       static auto &reads = ert::metrics::registry().counter("fs.reads");
+       reads.add();
+
+   When the environment variable ERT_METRICS_FILE is set a JSON dump of
+   all registered metrics is written to that path at process exit.
+*/
+namespace metrics {
+
+class Counter {
+public:
+    void add(uint64_t count = 1) noexcept {
+        m_value.fetch_add(count, std::memory_order_relaxed);
+    }
+    uint64_t value() const noexcept {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> m_value{};
+};
+
+/**
+   Latency histogram with power-of-two buckets: a sample lands in the
+   bucket holding its bit width, so bucket i counts samples in
+   [2^i, 2^(i+1)) (bucket 0 also holds 0). Recording is three relaxed
+   atomic adds and the bucket layout needs no configuration regardless
+   of the sampled time scale.
+*/
+class Histogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 64;
+
+    void record(uint64_t value) noexcept {
+        m_buckets[bucket_index(value)].fetch_add(1,
+                                                 std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const noexcept {
+        return m_count.load(std::memory_order_relaxed);
+    }
+    uint64_t sum() const noexcept {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+    uint64_t bucket(size_t index) const noexcept {
+        return m_buckets[index].load(std::memory_order_relaxed);
+    }
+    /** Inclusive upper bound of bucket 'index'. */
+    static uint64_t bucket_bound(size_t index) noexcept {
+        return index + 1 >= BUCKET_COUNT ? UINT64_MAX
+                                         : (uint64_t(1) << (index + 1)) - 1;
+    }
+
+private:
+    static size_t bucket_index(uint64_t value) noexcept {
+        size_t width = 0;
+        while (value >>= 1)
+            width++;
+        return width;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint64_t> m_sum{};
+    std::atomic<uint64_t> m_count{};
+};
+
+/** Records the scope's wall time, in nanoseconds, into a histogram. */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram &histogram) : m_histogram(histogram) {}
+    ~ScopedTimer() {
+        m_histogram.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_start)
+                .count());
+    }
+
+private:
+    Histogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start =
+        std::chrono::steady_clock::now();
+};
+
+class Registry {
+public:
+    /** Returns the counter/histogram registered under 'name',
+        registering it first if needed. The returned reference stays
+        valid for the lifetime of the registry. */
+    Counter &counter(const std::string &name);
+    Histogram &histogram(const std::string &name);
+
+    std::string dump_json() const;
+
+private:
+    struct State;
+    Registry();
+    std::unique_ptr<State> m_state;
+
+    friend Registry &registry();
+};
+
+/** The process-wide registry; never destroyed, so metrics can be
+    recorded and dumped safely during static destruction. */
+Registry &registry();
+
+} // namespace metrics
 } // namespace ert
+
+#endif
@@ -6,6 +6,18 @@
 
 namespace ert {
 
+/**
+ * Return a stable pointer to a canonical, immutable copy of @p str
+ *
+ * Repeated calls with equal content return the same pointer, so keys
+ * which have been interned can be compared with plain pointer equality
+ * and the many duplicated copies of parameter/summary/config keys
+ * collapse into a single allocation. Interned strings live for the
+ * remainder of the process - do not free() the returned pointer.
+ * Thread safe.
+ */
+const char *intern(std::string_view str);
+
 /**
  * Non memory allocating string splitting function
  *
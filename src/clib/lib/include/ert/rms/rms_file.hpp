@@ -12,6 +12,8 @@ typedef struct rms_file_struct rms_file_type;
 void rms_file_fclose(rms_file_type *);
 FILE *rms_file_fopen_r(rms_file_type *rms_file);
 FILE *rms_file_fopen_w(rms_file_type *rms_file);
+FILE *rms_file_fopen_w_async(rms_file_type *rms_file, size_t size_hint);
+void rms_file_fwrite_flush(rms_file_type *rms_file);
 void rms_file_set_filename(rms_file_type *, const char *, bool);
 rms_file_type *rms_file_alloc(const char *, bool);
 void rms_file_free(rms_file_type *);
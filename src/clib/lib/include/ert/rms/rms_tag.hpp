@@ -12,6 +12,8 @@ typedef struct rms_tag_struct rms_tag_type;
 
 const char *rms_tag_get_namekey_name(const rms_tag_type *);
 const char *rms_tag_get_name(const rms_tag_type *);
+rms_tag_type *rms_tag_alloc(const char *);
+void rms_tag_add_tagkey_owned(rms_tag_type *, rms_tagkey_type *);
 void rms_tag_free(rms_tag_type *);
 void rms_tag_free__(void *arg);
 rms_tag_type *rms_tag_fread_alloc(FILE *, hash_type *, bool, bool *);
@@ -16,6 +16,8 @@ void rms_tagkey_free(rms_tagkey_type *);
 rms_tagkey_type *rms_tagkey_alloc_empty(bool);
 rms_tagkey_type *rms_tagkey_alloc_complete(const char *, int, rms_type_enum,
                                            const void *, bool);
+rms_tagkey_type *rms_tagkey_alloc_from_data(const char *, int, int,
+                                            rms_type_enum, const void *, bool);
 const char *rms_tagkey_get_name(const rms_tagkey_type *);
 rms_type_enum rms_tagkey_get_rms_type(const rms_tagkey_type *);
 ecl_data_type rms_tagkey_get_ecl_data_type(const rms_tagkey_type *);
@@ -5,11 +5,17 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
 
 #include <ert/logging.hpp>
 #include <ert/util/util.hpp>
 
 #include <ert/job_queue/job_node.hpp>
+#include <ert/job_queue/queue_event_log.hpp>
 
 namespace fs = std::filesystem;
 static auto logger = ert::get_logger("job_queue");
@@ -74,6 +80,15 @@ struct job_queue_node_struct {
     time_t max_confirm_wait;
     /** Timestamp of the status update update file. */
     time_t progress_timestamp;
+    /** inotify descriptor watching the runpath directory for the status
+     * file; -1 means directory events are unavailable (non-Linux, NFS
+     * mounted runpath, watch limit reached) and the stat() based checks
+     * are used as fallback. */
+    int inotify_fd;
+    /** Set when a directory event for the status file has been seen. */
+    bool status_file_event;
+    /** Timestamp of the last directory event for the status file. */
+    time_t status_file_event_time;
 };
 
 void job_queue_node_free_error_info(job_queue_node_type *node) {
@@ -195,10 +210,85 @@ void job_queue_node_free(job_queue_node_type *node) {
     // the calling scope.
     job_queue_node_free_data(node);
     job_queue_node_free_error_info(node);
+    if (node->inotify_fd >= 0)
+        close(node->inotify_fd);
     free(node->run_path);
     free(node);
 }
 
+/**
+   Watch the runpath directory for the creation of the status file, so
+   that the "confirmed running" and progress checks below can be served
+   from in-memory event flags instead of stat()ing the file on every
+   update round. inotify only reports local filesystem activity, so on
+   e.g. an NFS mounted runpath the watch is not established and the
+   stat() fallback remains in use.
+*/
+static void job_queue_node_init_inotify(job_queue_node_type *node) {
+    node->inotify_fd = -1;
+    node->status_file_event = false;
+    node->status_file_event_time = 0;
+#ifdef __linux__
+    if (!node->status_file)
+        return;
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    if (inotify_add_watch(fd, node->run_path,
+                          IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(fd);
+        return;
+    }
+    node->inotify_fd = fd;
+
+    // A status file left behind by an earlier attempt would never
+    // generate an event; seed the flags from the current state.
+    if (fs::exists(node->status_file)) {
+        node->status_file_event = true;
+        node->status_file_event_time = util_file_mtime(node->status_file);
+    }
+#endif
+}
+
+#ifdef __linux__
+static bool basename_matches(const char *path, const char *name) {
+    if (!path)
+        return false;
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    return strcmp(base, name) == 0;
+}
+
+/**
+   Drain all pending directory events and flag events touching the
+   status file. Returns true when the watcher is active, i.e. the
+   caller can trust the event flags and skip the stat() calls.
+*/
+static bool job_queue_node_drain_inotify(job_queue_node_type *node) {
+    if (node->inotify_fd < 0)
+        return false;
+
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t len;
+    while ((len = read(node->inotify_fd, buffer, sizeof buffer)) > 0) {
+        ssize_t offset = 0;
+        while (offset < len) {
+            auto event =
+                reinterpret_cast<const struct inotify_event *>(&buffer[offset]);
+            if (event->len > 0 &&
+                basename_matches(node->status_file, event->name)) {
+                node->status_file_event = true;
+                node->status_file_event_time = time(NULL);
+            }
+            offset += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return true;
+}
+#endif
+
 job_status_type job_queue_node_get_status(const job_queue_node_type *node) {
     return node->job_status;
 }
@@ -299,6 +389,7 @@ job_queue_node_alloc(const char *job_name, const char *run_path,
     node->submit_time = time(NULL);
     node->max_confirm_wait = 60 * 2; // 2 minutes before we consider job dead.
 
+    job_queue_node_init_inotify(node);
     pthread_mutex_init(&node->data_mutex, NULL);
     return node;
 }
@@ -349,8 +440,14 @@ void job_queue_node_set_status(job_queue_node_type *node,
     if (new_status == node->job_status)
         return;
 
-    logger->debug("Set {}({}) to {}", node->job_name, node->queue_index,
-                  job_status_get_name(new_status));
+    /* Every realization passes through here on each state change, so a
+       mass transition logs a burst of these; cap them and report the
+       rest as a suppression count. */
+    static ert::LogSite status_log_site;
+    logger->debug_limited(status_log_site, 25, "Set {}({}) to {}",
+                          node->job_name, node->queue_index,
+                          job_status_get_name(new_status));
+    queue_event_log_record(node->queue_index, node->job_status, new_status);
     node->job_status = new_status;
 
     // We record sim start when the node is in state JOB_QUEUE_WAITING to be
@@ -467,6 +564,13 @@ job_queue_node_status_update_confirmed_running__(job_queue_node_type *node) {
         return true;
     }
 
+#ifdef __linux__
+    if (job_queue_node_drain_inotify(node)) {
+        node->confirmed_running = node->status_file_event;
+        return node->confirmed_running;
+    }
+#endif
+
     if (fs::exists(node->status_file))
         node->confirmed_running = true;
     return node->confirmed_running;
@@ -479,6 +583,14 @@ static void job_queue_node_update_timestamp(job_queue_node_type *node) {
     if (!node->status_file)
         return;
 
+#ifdef __linux__
+    if (job_queue_node_drain_inotify(node)) {
+        if (node->status_file_event_time > 0)
+            node->progress_timestamp = node->status_file_event_time;
+        return;
+    }
+#endif
+
     time_t mtime = util_file_mtime(node->status_file);
     if (mtime > 0)
         node->progress_timestamp = mtime;
@@ -642,6 +754,31 @@ bool job_queue_node_kill_simple(job_queue_node_type *node,
     return result;
 }
 
+/**
+   If the node is in a killable state it is marked IS_KILLED and the
+   driver specific job data - if any - is returned with ownership
+   transferred to the caller, so that many jobs can be cancelled with
+   one batched driver call before the data is freed. Returns NULL for
+   nodes which either cannot be killed or have no driver data (e.g.
+   jobs still WAITING).
+*/
+void *job_queue_node_detach_for_kill(job_queue_node_type *node,
+                                     job_queue_status_type *status) {
+    void *job_data = NULL;
+    pthread_mutex_lock(&node->data_mutex);
+    job_status_type current_status = job_queue_node_get_status(node);
+    if (current_status & JOB_QUEUE_CAN_KILL) {
+        job_data = node->job_data;
+        node->job_data = NULL;
+        job_queue_status_transition(status, current_status,
+                                    JOB_QUEUE_IS_KILLED);
+        job_queue_node_set_status(node, JOB_QUEUE_IS_KILLED);
+        logger->info("job {} set to killed", node->job_name);
+    }
+    pthread_mutex_unlock(&node->data_mutex);
+    return job_data;
+}
+
 /**
    This frees the storage allocated by the driver - the storage
    allocated by the queue layer is retained.
@@ -1,8 +1,4 @@
-#include <algorithm>
-#include <chrono>
 #include <filesystem>
-#include <future>
-#include <thread>
 #include <vector>
 
 #include <stdio.h>
@@ -15,6 +11,7 @@
 
 #include <ert/job_queue/job_list.hpp>
 #include <ert/job_queue/job_queue.hpp>
+#include <ert/job_queue/queue_event_log.hpp>
 
 namespace fs = std::filesystem;
 static auto logger = ert::get_logger("job_queue");
@@ -213,11 +210,6 @@ struct job_queue_struct {
     time_t progress_timestamp;
     /** The sleep time before checking for updates. */
     unsigned long usleep_time;
-    /** This mutex is used to ensure that ONLY one thread is executing the job_queue_run_jobs(). */
-    std::mutex run_mutex;
-
-    /** This holds future results of currently running callbacks */
-    std::vector<std::future<void>> active_callbacks;
 };
 
 /*
@@ -327,6 +319,36 @@ bool job_queue_kill_job(job_queue_type *queue, int job_index) {
     return result;
 }
 
+/**
+   Kills every killable job in the queue with one batched driver call
+   instead of one scheduler command per job; aborting a large batch
+   then costs a single bkill/scancel round trip. Jobs without driver
+   data (e.g. still WAITING) are just transitioned to IS_KILLED.
+   Returns the number of jobs passed to the driver.
+*/
+int job_queue_kill_all_jobs(job_queue_type *queue) {
+    std::vector<void *> killed_jobs;
+    {
+        JobListReadLock rl(queue->job_list);
+        int queue_size = job_list_get_size(queue->job_list);
+        for (int job_index = 0; job_index < queue_size; job_index++) {
+            job_queue_node_type *node =
+                job_list_iget_job(queue->job_list, job_index);
+            void *job_data =
+                job_queue_node_detach_for_kill(node, queue->status);
+            if (job_data != NULL)
+                killed_jobs.push_back(job_data);
+        }
+    }
+    if (!killed_jobs.empty()) {
+        queue_driver_kill_jobs(queue->driver, killed_jobs.size(),
+                               killed_jobs.data());
+        for (auto job_data : killed_jobs)
+            queue_driver_free_job(queue->driver, job_data);
+    }
+    return killed_jobs.size();
+}
+
 /**
   This returns a pointer to a very internal datastructure; used by the
   Job class in Python which interacts directly with the driver
@@ -452,6 +474,10 @@ int job_queue_get_max_submit(const job_queue_type *job_queue) {
 }
 
 void job_queue_free(job_queue_type *queue) {
+    const char *trace_file = getenv("ERT_QUEUE_EVENT_LOG");
+    if (trace_file != NULL)
+        queue_event_log_fwrite_chrome_trace(trace_file);
+
     free(queue->ok_file);
     free(queue->exit_file);
     free(queue->status_file);
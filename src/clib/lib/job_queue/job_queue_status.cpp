@@ -1,13 +1,18 @@
-#include <pthread.h>
+#include <atomic>
 
 #include <ert/job_queue/job_queue_status.hpp>
 #include <ert/job_queue/queue_driver.hpp>
 
+/**
+   The counters are plain atomics and all the accessor functions are
+   lock free; the monitoring queries coming from the GUI can therefor
+   never block the dispatch thread which is performing the state
+   transitions.
+*/
 struct job_queue_status_struct {
-    int status_list[JOB_QUEUE_MAX_STATE];
-    pthread_rwlock_t rw_lock;
+    std::atomic<int> status_list[JOB_QUEUE_MAX_STATE];
     int status_index[JOB_QUEUE_MAX_STATE];
-    time_t timestamp;
+    std::atomic<time_t> timestamp;
 };
 
 static int STATUS_INDEX(const job_queue_status_type *status_count,
@@ -27,9 +32,7 @@ static int STATUS_INDEX(const job_queue_status_type *status_count,
 }
 
 job_queue_status_type *job_queue_status_alloc() {
-    job_queue_status_type *status =
-        (job_queue_status_type *)util_malloc(sizeof *status);
-    pthread_rwlock_init(&status->rw_lock, NULL);
+    job_queue_status_type *status = new job_queue_status_type;
     job_queue_status_clear(status);
     status->timestamp = time(NULL);
 
@@ -69,7 +72,7 @@ job_queue_status_type *job_queue_status_alloc() {
     return status;
 }
 
-void job_queue_status_free(job_queue_status_type *status) { free(status); }
+void job_queue_status_free(job_queue_status_type *status) { delete status; }
 
 void job_queue_status_clear(job_queue_status_type *status) {
     int index;
@@ -80,55 +83,40 @@ void job_queue_status_clear(job_queue_status_type *status) {
 int job_queue_status_get_count(job_queue_status_type *status_count,
                                int job_status_mask) {
     int count = 0;
-    pthread_rwlock_rdlock(&status_count->rw_lock);
-    {
-        int index = 0;
-        int status = 1;
-
-        while (true) {
-            if ((status & job_status_mask) == status) {
-                job_status_mask -= status;
-                count += status_count->status_list[index];
-            }
-
-            if (job_status_mask == 0)
-                break;
-
-            index++;
-            status <<= 1;
-            if (index == JOB_QUEUE_MAX_STATE)
-                util_abort("%s: internal error: remaining unrecognized status "
-                           "value:%d \n",
-                           __func__, job_status_mask);
+    int index = 0;
+    int status = 1;
+
+    while (true) {
+        if ((status & job_status_mask) == status) {
+            job_status_mask -= status;
+            count += status_count->status_list[index].load(
+                std::memory_order_relaxed);
         }
+
+        if (job_status_mask == 0)
+            break;
+
+        index++;
+        status <<= 1;
+        if (index == JOB_QUEUE_MAX_STATE)
+            util_abort("%s: internal error: remaining unrecognized status "
+                       "value:%d \n",
+                       __func__, job_status_mask);
     }
-    pthread_rwlock_unlock(&status_count->rw_lock);
     return count;
 }
 
 void job_queue_status_inc(job_queue_status_type *status_count,
                           job_status_type status_type) {
     int index = STATUS_INDEX(status_count, status_type);
-
-    pthread_rwlock_wrlock(&status_count->rw_lock);
-    {
-        int count = status_count->status_list[index];
-        status_count->status_list[index] = count + 1;
-    }
+    status_count->status_list[index].fetch_add(1, std::memory_order_relaxed);
     status_count->timestamp = time(NULL);
-    pthread_rwlock_unlock(&status_count->rw_lock);
 }
 
 static void job_queue_status_dec(job_queue_status_type *status_count,
                                  job_status_type status_type) {
     int index = STATUS_INDEX(status_count, status_type);
-
-    pthread_rwlock_wrlock(&status_count->rw_lock);
-    {
-        int count = status_count->status_list[index];
-        status_count->status_list[index] = count - 1;
-    }
-    pthread_rwlock_unlock(&status_count->rw_lock);
+    status_count->status_list[index].fetch_sub(1, std::memory_order_relaxed);
 }
 
 /*
@@ -155,6 +143,7 @@ bool job_queue_status_transition(job_queue_status_type *status_count,
 int job_queue_status_get_total_count(const job_queue_status_type *status) {
     int total_count = 0;
     for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
-        total_count += status->status_list[index];
+        total_count +=
+            status->status_list[index].load(std::memory_order_relaxed);
     return total_count;
 }
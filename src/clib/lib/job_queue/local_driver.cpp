@@ -1,33 +1,68 @@
+#include <algorithm>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include <poll.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include <ert/util/util.hpp>
 
 #include <ert/job_queue/local_driver.hpp>
 #include <ert/job_queue/queue_driver.hpp>
 
+extern char **environ;
+
 typedef struct local_job_struct local_job_type;
 
 struct local_job_struct {
     bool active;
     job_status_type status;
-    std::optional<std::thread> run_thread;
     pid_t child_process;
+    /** pidfd of the child when available (Linux); -1 means the reaper
+     * falls back to low frequency WNOHANG polling for this child. */
+    int pidfd;
 };
 
 struct local_driver_struct {
-    std::mutex submit_lock;
+    std::mutex job_lock;
+    /** Jobs whose child processes have not been reaped yet. */
+    std::vector<local_job_type *> active_jobs;
+    /** Writing a byte to this pipe wakes the reaper thread, either
+     * because a job was submitted or because the driver is freed. */
+    int wake_pipe[2];
+    bool shutting_down;
+    std::optional<std::thread> reaper_thread;
+    /** CPU ids from the LOCAL_CPU_LIST option; empty means the jobs
+     * inherit the affinity mask of the parent process. */
+    std::vector<int> cpu_slots;
+    std::string cpu_list_string;
+    /** Index into cpu_slots of the next slot to hand out - protected
+     * by job_lock. */
+    std::size_t next_cpu_slot = 0;
 };
 
 static local_job_type *local_job_alloc() {
     local_job_type *job = new local_job_type;
     job->active = false;
     job->status = JOB_QUEUE_WAITING;
+    job->child_process = 0;
+    job->pidfd = -1;
     return job;
 }
 
@@ -44,7 +79,7 @@ job_status_type local_driver_get_job_status(void *__driver, void *__job) {
 void local_driver_free_job(void *__job) {
     local_job_type *job = reinterpret_cast<local_job_type *>(__job);
     if (!job->active)
-        free(job);
+        delete job;
 }
 
 void local_driver_kill_job(void *__driver, void *__job) {
@@ -54,56 +89,233 @@ void local_driver_kill_job(void *__driver, void *__job) {
 }
 
 /**
-  This function needs to dereference the job pointer after the waitpid() call is
-  complete, it is therefore essential that no other threads have called free(job)
-  while the external process is running.
+  All the jobs of the driver are completed by this single reaper
+  thread. The children are spawned with posix_spawn() and their pidfds
+  are poll()ed, so there is neither a fork() duplicating the page
+  tables of the (potentially very large) parent process, nor one
+  blocked waitpid() thread per running realization. On systems without
+  pidfd support the reaper falls back to waking up at a low frequency
+  and checking the children with waitpid(WNOHANG).
 */
-void submit_job_thread(const char *executable, int argc, char **argv,
-                       local_job_type *job) {
-    int wait_status;
-    job->child_process =
-        util_spawn(executable, argc, (const char **)argv, NULL, NULL);
-    util_free_stringlist(argv, argc);
-    waitpid(job->child_process, &wait_status, 0);
+static void local_driver_reaper(local_driver_type *driver) {
+    while (true) {
+        std::vector<local_job_type *> jobs;
+        {
+            std::lock_guard guard{driver->job_lock};
+            if (driver->shutting_down)
+                return;
+            jobs = driver->active_jobs;
+        }
 
-    job->active = false;
-    job->status = JOB_QUEUE_EXIT;
-    if (WIFEXITED(wait_status))
-        if (WEXITSTATUS(wait_status) == 0)
-            job->status = JOB_QUEUE_DONE;
+        std::vector<struct pollfd> pollfds;
+        pollfds.push_back({driver->wake_pipe[0], POLLIN, 0});
+        bool plain_pid = false;
+        for (auto job : jobs) {
+            if (job->pidfd >= 0)
+                pollfds.push_back({job->pidfd, POLLIN, 0});
+            else
+                plain_pid = true;
+        }
+
+        poll(pollfds.data(), pollfds.size(), plain_pid ? 100 : -1);
+
+        if (pollfds[0].revents & POLLIN) {
+            char buffer[16];
+            ssize_t bytes_read =
+                read(driver->wake_pipe[0], buffer, sizeof buffer);
+            (void)bytes_read;
+        }
+
+        for (auto job : jobs) {
+            int wait_status;
+            if (waitpid(job->child_process, &wait_status, WNOHANG) !=
+                job->child_process)
+                continue;
+
+            if (job->pidfd >= 0) {
+                close(job->pidfd);
+                job->pidfd = -1;
+            }
+
+            job->status = JOB_QUEUE_EXIT;
+            if (WIFEXITED(wait_status))
+                if (WEXITSTATUS(wait_status) == 0)
+                    job->status = JOB_QUEUE_DONE;
+            job->active = false;
+
+            std::lock_guard guard{driver->job_lock};
+            driver->active_jobs.erase(std::remove(driver->active_jobs.begin(),
+                                                  driver->active_jobs.end(),
+                                                  job),
+                                      driver->active_jobs.end());
+        }
+    }
+}
+
+static void local_driver_wake_reaper(local_driver_type *driver) {
+    ssize_t bytes_written = write(driver->wake_pipe[1], "x", 1);
+    (void)bytes_written;
+}
+
+static pid_t local_driver_spawn(const char *executable, int argc,
+                                const char **argv) {
+    std::vector<char *> spawn_argv;
+    spawn_argv.push_back(const_cast<char *>(executable));
+    for (int iarg = 0; iarg < argc; iarg++)
+        spawn_argv.push_back(const_cast<char *>(argv[iarg]));
+    spawn_argv.push_back(nullptr);
+
+    pid_t pid = 0;
+    if (posix_spawn(&pid, executable, nullptr, nullptr, spawn_argv.data(),
+                    environ) != 0)
+        return -1;
+    return pid;
+}
+
+/**
+  Parses a comma separated list of CPU ids, where each item is either a
+  single id like "3" or an inclusive range like "8-11". Returns an empty
+  vector if the string does not parse.
+*/
+static std::vector<int> local_driver_parse_cpu_list(const char *cpu_list) {
+    std::vector<int> slots;
+    const char *pos = cpu_list;
+    while (*pos != '\0') {
+        char *end;
+        long start = strtol(pos, &end, 10);
+        if (end == pos || start < 0)
+            return {};
+        long stop = start;
+        if (*end == '-') {
+            pos = end + 1;
+            stop = strtol(pos, &end, 10);
+            if (end == pos || stop < start)
+                return {};
+        }
+        for (long cpu = start; cpu <= stop; cpu++)
+            slots.push_back(cpu);
+        if (*end == ',')
+            end++;
+        else if (*end != '\0')
+            return {};
+        pos = end;
+    }
+    return slots;
+}
+
+/**
+  Pins the child to the next num_cpu entries of the configured CPU list,
+  wrapping round-robin, so the realizations of a local ensemble get
+  stable, non-overlapping core sets. A no-op when no CPU list has been
+  configured, and on platforms without sched_setaffinity().
+*/
+static void local_driver_assign_cpu_slots(local_driver_type *driver, pid_t pid,
+                                          int num_cpu) {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    {
+        std::lock_guard guard{driver->job_lock};
+        if (driver->cpu_slots.empty())
+            return;
+        for (int i = 0; i < std::max(num_cpu, 1); i++) {
+            CPU_SET(driver->cpu_slots[driver->next_cpu_slot], &cpu_set);
+            driver->next_cpu_slot =
+                (driver->next_cpu_slot + 1) % driver->cpu_slots.size();
+        }
+    }
+    sched_setaffinity(pid, sizeof cpu_set, &cpu_set);
+#endif
 }
 
 void *local_driver_submit_job(void *__driver, const char *submit_cmd,
-                              int num_cpu, /* Ignored */
-                              const char *run_path, const char *job_name,
-                              int argc, const char **argv) {
+                              int num_cpu, const char *run_path,
+                              const char *job_name, int argc,
+                              const char **argv) {
     local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
     {
         local_job_type *job = local_job_alloc();
 
-        auto argv_copy = util_alloc_stringlist_copy(argv, argc);
+        job->child_process = local_driver_spawn(submit_cmd, argc, argv);
+        if (job->child_process < 0) {
+            // The submit failed - the queue system shall handle
+            // NULL return values.
+            delete job;
+            return NULL;
+        }
+        local_driver_assign_cpu_slots(driver, job->child_process, num_cpu);
 
-        std::lock_guard guard{driver->submit_lock};
+#ifdef SYS_pidfd_open
+        job->pidfd = syscall(SYS_pidfd_open, job->child_process, 0);
+#endif
         job->active = true;
         job->status = JOB_QUEUE_RUNNING;
 
-        job->run_thread = std::thread{
-            [=] { submit_job_thread(submit_cmd, argc, argv_copy, job); }};
-        job->run_thread->detach();
+        {
+            std::lock_guard guard{driver->job_lock};
+            driver->active_jobs.push_back(job);
+        }
+        local_driver_wake_reaper(driver);
 
         return job;
     }
 }
 
-void local_driver_free(local_driver_type *driver) { delete driver; }
+void local_driver_free(local_driver_type *driver) {
+    {
+        std::lock_guard guard{driver->job_lock};
+        driver->shutting_down = true;
+    }
+    local_driver_wake_reaper(driver);
+    driver->reaper_thread->join();
+
+    close(driver->wake_pipe[0]);
+    close(driver->wake_pipe[1]);
+    delete driver;
+}
 
 void local_driver_free__(void *__driver) {
     local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
     local_driver_free(driver);
 }
 
-void *local_driver_alloc() { return new local_driver_type; }
+void *local_driver_alloc() {
+    local_driver_type *driver = new local_driver_type;
+    driver->shutting_down = false;
+    if (pipe(driver->wake_pipe) != 0)
+        util_abort("%s: failed to create reaper wake pipe \n", __func__);
+
+    driver->reaper_thread =
+        std::thread{[driver] { local_driver_reaper(driver); }};
+    return driver;
+}
+
+bool local_driver_set_option(void *__driver, const char *option_key,
+                             const void *value) {
+    auto driver = reinterpret_cast<local_driver_type *>(__driver);
+    if (strcmp(option_key, LOCAL_CPU_LIST) == 0) {
+        auto slots =
+            local_driver_parse_cpu_list(static_cast<const char *>(value));
+        if (slots.empty())
+            return false;
+        std::lock_guard guard{driver->job_lock};
+        driver->cpu_slots = slots;
+        driver->cpu_list_string = static_cast<const char *>(value);
+        driver->next_cpu_slot = 0;
+        return true;
+    }
+    return false;
+}
+
+const void *local_driver_get_option(const void *__driver,
+                                    const char *option_key) {
+    const auto driver =
+        reinterpret_cast<const local_driver_type *>(__driver);
+    if (strcmp(option_key, LOCAL_CPU_LIST) == 0)
+        return driver->cpu_list_string.c_str();
+    return nullptr;
+}
 
 void local_driver_init_option_list(stringlist_type *option_list) {
-    //No options specific for local driver; do nothing
+    stringlist_append_copy(option_list, LOCAL_CPU_LIST);
 }
@@ -137,20 +137,21 @@ stringlist_type *lsb_get_error_list(const lsb_type *lsb) {
     return lsb->error_list;
 }
 
-int lsb_initialize(const lsb_type *lsb) {
-    // The environment variable LSF_ENVDIR must be set to point the directory
-    // containing LSF configuration information, the whole thing will crash and
-    // burn if this is not properly set.
+int lsb_initialize(lsb_type *lsb) {
+    // The environment variable LSF_ENVDIR must be set to point the
+    // directory containing LSF configuration information. If the
+    // initialization fails the lsb instance is marked not ready and
+    // the lsf_driver falls back to the shell commands, instead of
+    // taking the whole application down.
     if (lsb->lsb_init(NULL) != 0) {
-
-        fprintf(stderr, "LSF_ENVDIR: ");
-        if (getenv("LSF_ENVDIR") != NULL)
-            fprintf(stderr, "%s\n", getenv("LSF_ENVDIR"));
-        else
-            fprintf(stderr, "not set\n");
-
-        util_abort("%s failed to initialize LSF environment : %s  \n", __func__,
-                   lsb->sys_msg());
+        const char *lsf_env_dir = getenv("LSF_ENVDIR");
+        lsb->ready = false;
+        stringlist_append_owned_ref(
+            lsb->error_list,
+            util_alloc_sprintf(
+                "lsb_init() failed: %s  (LSF_ENVDIR: %s)", lsb->sys_msg(),
+                lsf_env_dir != NULL ? lsf_env_dir : "not set"));
+        return -1;
     }
     return 0;
 }
@@ -168,6 +169,17 @@ int lsb_openjob(const lsb_type *lsb, int lsf_jobnr) {
     return lsb->open_job(lsf_jobnr, NULL, NULL, NULL, NULL, ALL_JOB);
 }
 
+/*
+  Opens a job information connection covering every job of the current
+  user, in all states; the individual records are then drained with
+  lsb_readjob() and the connection released with lsb_closejob(). The
+  return value is the number of records, or a negative value if the
+  batch daemon could not be queried.
+*/
+int lsb_openjobs(const lsb_type *lsb) {
+    return lsb->open_job(0, NULL, NULL, NULL, NULL, ALL_JOB);
+}
+
 int lsb_closejob(const lsb_type *lsb) { return lsb->close_job(); }
 
 char *lsb_sys_msg(const lsb_type *lsb) { return lsb->sys_msg(); }
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <ert/concurrency.hpp>
 #include <ert/logging.hpp>
 #include <ert/res_util/res_env.hpp>
 #include <ert/res_util/string.hpp>
@@ -89,6 +90,7 @@ static auto logger = ert::get_logger("job_queue.lsf_driver");
 #define MAX_ERROR_COUNT 100
 #define SUBMIT_ERROR_SLEEP 2
 #define BJOBS_REFRESH_TIME "10"
+#define DEFAULT_SUBMIT_WINDOW "8"
 #define DEFAULT_RSH_CMD "/usr/bin/ssh"
 #define DEFAULT_BSUB_CMD "bsub"
 #define DEFAULT_BJOBS_CMD "bjobs"
@@ -114,6 +116,12 @@ struct lsf_driver_struct {
 
     lsf_submit_method_enum submit_method;
     int submit_sleep;
+    /** Bounds the number of concurrent in-flight bsub round trips for the
+     * shell based submit methods; each job thread submits on its own, so
+     * without a bound a large ensemble would fire off one bsub process per
+     * realization at once. */
+    Semafoor *submit_window;
+    int submit_window_size;
 
     int error_count;
     int max_error_count;
@@ -507,19 +515,12 @@ static int lsf_driver_submit_internal_job(lsf_driver_type *driver,
 #endif
 }
 
-static int lsf_driver_submit_shell_job(lsf_driver_type *driver,
-                                       const char *lsf_stdout,
-                                       const char *job_name,
-                                       const char *submit_cmd, int num_cpu,
-                                       int job_argc, const char **job_argv) {
+static int lsf_driver_spawn_bsub(lsf_driver_type *driver,
+                                 const stringlist_type *remote_argv) {
     int job_id;
     char *tmp_file = (char *)util_alloc_tmp_file("/tmp", "enkf-submit", true);
 
     {
-        stringlist_type *remote_argv =
-            lsf_driver_alloc_cmd(driver, lsf_stdout, job_name, submit_cmd,
-                                 num_cpu, job_argc, job_argv);
-
         if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL) {
             char **argv = (char **)util_calloc(2, sizeof *argv);
             argv[0] = driver->remote_lsf_server;
@@ -549,8 +550,6 @@ static int lsf_driver_submit_shell_job(lsf_driver_type *driver,
                                 (const char **)argv, tmp_file, tmp_file);
             free(argv);
         }
-
-        stringlist_free(remote_argv);
     }
 
     job_id = lsf_job_parse_bsub_stdout(driver->bsub_cmd, tmp_file);
@@ -559,6 +558,20 @@ static int lsf_driver_submit_shell_job(lsf_driver_type *driver,
     return job_id;
 }
 
+static int lsf_driver_submit_shell_job(lsf_driver_type *driver,
+                                       const char *lsf_stdout,
+                                       const char *job_name,
+                                       const char *submit_cmd, int num_cpu,
+                                       int job_argc, const char **job_argv) {
+    int job_id;
+    stringlist_type *remote_argv =
+        lsf_driver_alloc_cmd(driver, lsf_stdout, job_name, submit_cmd, num_cpu,
+                             job_argc, job_argv);
+    job_id = lsf_driver_spawn_bsub(driver, remote_argv);
+    stringlist_free(remote_argv);
+    return job_id;
+}
+
 static int lsf_driver_get_status__(lsf_driver_type *driver, const char *status,
                                    const char *job_id) {
     if (hash_has_key(driver->status_map, status))
@@ -574,18 +587,25 @@ static int lsf_driver_get_status__(lsf_driver_type *driver, const char *status,
 static void lsf_driver_update_bjobs_table(lsf_driver_type *driver) {
     char *tmp_file = (char *)util_alloc_tmp_file("/tmp", "enkf-bjobs", true);
 
+    /* The jobid/jobindex fields are requested explicitly so that job array
+       elements can be told apart; in the default bjobs output every element
+       repeats the base job id in the first column. */
     if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL) {
         char **argv = (char **)util_calloc(2, sizeof *argv);
         argv[0] = driver->remote_lsf_server;
-        argv[1] = util_alloc_sprintf("%s -a", driver->bjobs_cmd);
+        argv[1] = util_alloc_sprintf(
+            "%s -a -noheader -o 'jobid jobindex user stat'", driver->bjobs_cmd);
         util_spawn_blocking(driver->rsh_cmd, 2, (const char **)argv, tmp_file,
                             NULL);
         free(argv[1]);
         free(argv);
     } else if (driver->submit_method == LSF_SUBMIT_LOCAL_SHELL) {
-        const char **argv = (const char **)util_calloc(1, sizeof *argv);
+        const char **argv = (const char **)util_calloc(4, sizeof *argv);
         argv[0] = "-a";
-        util_spawn_blocking(driver->bjobs_cmd, 1, (const char **)argv, tmp_file,
+        argv[1] = "-noheader";
+        argv[2] = "-o";
+        argv[3] = "jobid jobindex user stat";
+        util_spawn_blocking(driver->bjobs_cmd, 4, (const char **)argv, tmp_file,
                             NULL);
         free(argv);
     }
@@ -596,14 +616,21 @@ static void lsf_driver_update_bjobs_table(lsf_driver_type *driver) {
         FILE *stream = util_fopen(tmp_file, "r");
         bool at_eof = false;
         hash_clear(driver->bjobs_cache);
-        util_fskip_lines(stream, 1);
         while (!at_eof) {
             char *line = util_fscanf_alloc_line(stream, &at_eof);
             if (line != NULL) {
                 int job_id_int;
-
-                if (sscanf(line, "%d %s %s", &job_id_int, user, status) == 3) {
-                    char *job_id = (char *)util_alloc_sprintf("%d", job_id_int);
+                int job_index;
+
+                if (sscanf(line, "%d %d %s %s", &job_id_int, &job_index, user,
+                           status) == 4) {
+                    char *job_id;
+                    if (job_index > 0)
+                        job_id = (char *)util_alloc_sprintf("%d[%d]",
+                                                            job_id_int,
+                                                            job_index);
+                    else
+                        job_id = (char *)util_alloc_sprintf("%d", job_id_int);
                     // Consider only jobs submitted by this ERT instance - not
                     // old jobs lying around from the same user.
                     if (hash_has_key(driver->my_jobs, job_id))
@@ -622,6 +649,45 @@ static void lsf_driver_update_bjobs_table(lsf_driver_type *driver) {
     free(tmp_file);
 }
 
+#ifdef HAVE_LSF_LIBRARY
+/**
+  Refreshes the bjobs_cache with one batched lsb_openjobinfo() sweep
+  covering every job of the current user, instead of one daemon round
+  trip per job per poll. The cache is keyed and filtered exactly like
+  the shell variant: only jobs found in my_jobs are kept. If the
+  daemon can not be queried the cache is left untouched, so the
+  per-job fallback in lsf_driver_get_job_status_libary() decides.
+*/
+static void lsf_driver_update_bjobs_table_internal(lsf_driver_type *driver) {
+    int num_jobs = lsb_openjobs(driver->lsb);
+    if (num_jobs < 0) {
+        logger->warning("lsb_openjobinfo() failed: {} - could not refresh "
+                        "the job status cache.",
+                        lsb_sys_msg(driver->lsb));
+        return;
+    }
+    hash_clear(driver->bjobs_cache);
+    for (int i = 0; i < num_jobs; i++) {
+        struct jobInfoEnt *job_info = lsb_readjob(driver->lsb);
+        if (job_info == NULL)
+            break;
+        long array_index = LSB_ARRAY_IDX(job_info->jobId);
+        char *job_id;
+        if (array_index > 0)
+            job_id = (char *)util_alloc_sprintf(
+                "%ld[%ld]", (long)LSB_ARRAY_JOBID(job_info->jobId),
+                array_index);
+        else
+            job_id = (char *)util_alloc_sprintf(
+                "%ld", (long)LSB_ARRAY_JOBID(job_info->jobId));
+        if (hash_has_key(driver->my_jobs, job_id))
+            hash_insert_int(driver->bjobs_cache, job_id, job_info->status);
+        free(job_id);
+    }
+    lsb_closejob(driver->lsb);
+}
+#endif
+
 static int lsf_driver_get_job_status_libary(void *__driver, void *__job) {
     if (__job == NULL)
         /* the job has not been registered at all ... */
@@ -631,6 +697,27 @@ static int lsf_driver_get_job_status_libary(void *__driver, void *__job) {
         auto driver = static_cast<lsf_driver_type *>(__driver);
 #ifdef HAVE_LSF_LIBRARY
         auto job = static_cast<lsf_job_type *>(__job);
+
+        // The cache is refreshed with one batched sweep shared by all
+        // jobs, under the same mutex/interval policy as the shell
+        // variant; a job missing from the sweep falls through to the
+        // per-job query below.
+        pthread_mutex_lock(&driver->bjobs_mutex);
+        {
+            bool update_cache =
+                ((difftime(time(NULL), driver->last_bjobs_update) >
+                  driver->bjobs_refresh_interval) ||
+                 (!hash_has_key(driver->bjobs_cache, job->lsf_jobnr_char)));
+            if (update_cache) {
+                lsf_driver_update_bjobs_table_internal(driver);
+                driver->last_bjobs_update = time(NULL);
+            }
+        }
+        pthread_mutex_unlock(&driver->bjobs_mutex);
+
+        if (hash_has_key(driver->bjobs_cache, job->lsf_jobnr_char))
+            return hash_get_int(driver->bjobs_cache, job->lsf_jobnr_char);
+
         if (lsb_openjob(driver->lsb, job->lsf_jobnr) != 1) {
             // Failed to get information about the job - we boldly assume the
             // following situation has occured:
@@ -960,6 +1047,54 @@ void lsf_driver_kill_job(void *__driver, void *__job) {
     }
 }
 
+/**
+   Cancels all the jobs with a single bkill invocation instead of
+   spawning one bkill process per job; aborting a large batch then
+   costs one scheduler round trip. With the LSF library the calls are
+   in-process and are simply looped.
+*/
+void lsf_driver_kill_jobs(void *__driver, int num_jobs, void **jobs) {
+    auto driver = static_cast<lsf_driver_type *>(__driver);
+    if (num_jobs == 0)
+        return;
+
+    if (driver->submit_method == LSF_SUBMIT_INTERNAL) {
+#ifdef HAVE_LSF_LIBRARY
+        for (int i = 0; i < num_jobs; i++)
+            lsb_killjob(driver->lsb,
+                        static_cast<lsf_job_type *>(jobs[i])->lsf_jobnr);
+#else
+        lsf_driver_internal_error(driver);
+#endif
+        return;
+    }
+
+    if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL) {
+        std::string job_list;
+        for (int i = 0; i < num_jobs; i++) {
+            job_list += " ";
+            job_list += static_cast<lsf_job_type *>(jobs[i])->lsf_jobnr_char;
+        }
+        char **argv = (char **)util_calloc(2, sizeof *argv);
+        argv[0] = driver->remote_lsf_server;
+        argv[1] = util_alloc_sprintf("%s%s", driver->bkill_cmd,
+                                     job_list.c_str());
+
+        util_spawn_blocking(driver->rsh_cmd, 2, (const char **)argv, NULL,
+                            NULL);
+
+        free(argv[1]);
+        free(argv);
+    } else if (driver->submit_method == LSF_SUBMIT_LOCAL_SHELL) {
+        const char **argv =
+            (const char **)util_calloc(num_jobs, sizeof *argv);
+        for (int i = 0; i < num_jobs; i++)
+            argv[i] = static_cast<lsf_job_type *>(jobs[i])->lsf_jobnr_char;
+        util_spawn_blocking(driver->bkill_cmd, num_jobs, argv, NULL, NULL);
+        free(argv);
+    }
+}
+
 void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
                             const char *run_path, const char *job_name,
                             int argc, const char **argv) {
@@ -973,12 +1108,14 @@ void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
             char *lsf_stdout =
                 (char *)util_alloc_filename(run_path, job_name, "LSF-stdout");
             lsf_submit_method_enum submit_method = driver->submit_method;
-            pthread_mutex_lock(&driver->submit_lock);
 
             logger->info("LSF DRIVER submitting using method:{} \n",
                          submit_method);
 
             if (submit_method == LSF_SUBMIT_INTERNAL) {
+                // The lsb library calls share the request/reply structs in
+                // the driver and must be fully serialized.
+                pthread_mutex_lock(&driver->submit_lock);
                 if (driver->exclude_hosts.size() > 0) {
                     logger->warning("EXCLUDE_HOST is not supported with submit "
                                     "method LSF_SUBMIT_INTERNAL");
@@ -986,15 +1123,27 @@ void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
                 job->lsf_jobnr = lsf_driver_submit_internal_job(
                     driver, lsf_stdout, job_name, submit_cmd, num_cpu, argc,
                     argv);
+                pthread_mutex_unlock(&driver->submit_lock);
             } else {
-                job->lsf_jobnr = lsf_driver_submit_shell_job(
-                    driver, lsf_stdout, job_name, submit_cmd, num_cpu, argc,
-                    argv);
-                job->lsf_jobnr_char = util_alloc_sprintf("%ld", job->lsf_jobnr);
-                hash_insert_ref(driver->my_jobs, job->lsf_jobnr_char, NULL);
+                // The shell based round trip takes seconds on a loaded
+                // cluster; overlap the submissions from the job threads up
+                // to the configured window instead of serializing them, and
+                // take the lock only for the shared jobs table.
+                {
+                    std::scoped_lock window(*driver->submit_window);
+                    job->lsf_jobnr = lsf_driver_submit_shell_job(
+                        driver, lsf_stdout, job_name, submit_cmd, num_cpu,
+                        argc, argv);
+                }
             }
-
+            // The job id bookkeeping is shared by all submit methods:
+            // the batched status sweeps only consider jobs registered
+            // in my_jobs, and look them up with lsf_jobnr_char.
+            job->lsf_jobnr_char = util_alloc_sprintf("%ld", job->lsf_jobnr);
+            pthread_mutex_lock(&driver->submit_lock);
+            hash_insert_ref(driver->my_jobs, job->lsf_jobnr_char, NULL);
             pthread_mutex_unlock(&driver->submit_lock);
+
             free(lsf_stdout);
         }
 
@@ -1030,6 +1179,127 @@ void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
     }
 }
 
+/**
+   Submit @num_jobs homogeneous ensemble members as one LSF job array,
+   i.e. a single bsub invocation with the job name "<name>[1-num_jobs]"
+   instead of one fork+bsub per member. The members must only differ in
+   their run path argument: the run paths are written to a list file
+   next to the first run path (which must be on a filesystem shared
+   with the compute nodes), and each array element picks out its own
+   line with its LSB_JOBINDEX when it starts.
+
+   Returns the number of jobs submitted. On success jobs[i] holds the
+   lsf_job_type handle for array element i+1 - the caller maps these
+   back onto its job_queue_node instances - and status lookups and
+   bkill work per element through the "jobid[index]" job ids.
+
+   The LSF_SUBMIT_INTERNAL method has no shell in play to expand
+   LSB_JOBINDEX on the compute node; for that method we fall back to
+   one submission per member.
+*/
+int lsf_driver_submit_job_array(void *__driver, const char *submit_cmd,
+                                int num_cpu, const char *job_name,
+                                int num_jobs, const char **run_paths,
+                                void **jobs) {
+    auto driver = static_cast<lsf_driver_type *>(__driver);
+    lsf_driver_assert_submit_method(driver);
+
+    if (num_jobs <= 0)
+        return 0;
+
+    if (driver->submit_method == LSF_SUBMIT_INTERNAL) {
+        int submitted = 0;
+        for (int i = 0; i < num_jobs; i++) {
+            jobs[i] = lsf_driver_submit_job(driver, submit_cmd, num_cpu,
+                                            run_paths[i], job_name, 1,
+                                            &run_paths[i]);
+            if (jobs[i] != NULL)
+                submitted++;
+        }
+        return submitted;
+    }
+
+    long array_jobnr;
+    char *runpath_file =
+        (char *)util_alloc_filename(run_paths[0], job_name, "LSF-array");
+    char *array_name = util_alloc_sprintf("%s[1-%d]", job_name, num_jobs);
+    char *lsf_stdout = util_alloc_sprintf("%s/%s.LSF-stdout.%%I", run_paths[0],
+                                          job_name);
+
+    {
+        FILE *stream = util_fopen(runpath_file, "w");
+        for (int i = 0; i < num_jobs; i++)
+            fprintf(stream, "%s\n", run_paths[i]);
+        fclose(stream);
+    }
+
+    {
+        /* Each element selects its run path with its own LSB_JOBINDEX
+           when it starts on the compute node. For the remote method the
+           command substitution must be quoted, otherwise the submission
+           shell on the LSF server expands it at submit time. */
+        char *index_arg;
+        if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL)
+            index_arg = util_alloc_sprintf(
+                "'$(sed -n \"${LSB_JOBINDEX}p\" %s)'", runpath_file);
+        else
+            index_arg = util_alloc_sprintf("$(sed -n \"${LSB_JOBINDEX}p\" %s)",
+                                           runpath_file);
+
+        const char *job_argv[1] = {index_arg};
+        pthread_mutex_lock(&driver->submit_lock);
+        {
+            stringlist_type *remote_argv =
+                lsf_driver_alloc_cmd(driver, lsf_stdout, array_name, submit_cmd,
+                                     num_cpu, 1, job_argv);
+            logger->info("LSF DRIVER submitting job array [1-{}] using "
+                         "method:{} \n",
+                         num_jobs, driver->submit_method);
+            array_jobnr = lsf_driver_spawn_bsub(driver, remote_argv);
+            stringlist_free(remote_argv);
+        }
+        pthread_mutex_unlock(&driver->submit_lock);
+        free(index_arg);
+    }
+
+    int submitted = 0;
+    if (array_jobnr > 0) {
+        for (int i = 0; i < num_jobs; i++) {
+            lsf_job_type *job = lsf_job_alloc(job_name);
+            job->lsf_jobnr = array_jobnr;
+            job->lsf_jobnr_char =
+                util_alloc_sprintf("%ld[%d]", array_jobnr, i + 1);
+            hash_insert_ref(driver->my_jobs, job->lsf_jobnr_char, NULL);
+
+            char *json_file =
+                (char *)util_alloc_filename(run_paths[i], LSF_JSON, NULL);
+            FILE *stream = util_fopen(json_file, "w");
+            fprintf(stream, "{\"job_id\" : %ld, \"array_index\" : %d}\n",
+                    array_jobnr, i + 1);
+            fclose(stream);
+            free(json_file);
+
+            jobs[i] = job;
+        }
+        submitted = num_jobs;
+    } else {
+        driver->error_count++;
+
+        if (driver->error_count >= driver->max_error_count)
+            util_exit("Maximum number of submit errors exceeded - giving up\n");
+
+        logger->error("** ERROR ** Failed when submitting job array to LSF - "
+                      "will try again.");
+        for (int i = 0; i < num_jobs; i++)
+            jobs[i] = NULL;
+    }
+
+    free(lsf_stdout);
+    free(array_name);
+    free(runpath_file);
+    return submitted;
+}
+
 void lsf_driver_free(lsf_driver_type *driver) {
     free(driver->login_shell);
     free(driver->queue_name);
@@ -1045,6 +1315,7 @@ void lsf_driver_free(lsf_driver_type *driver) {
     hash_free(driver->status_map);
     hash_free(driver->bjobs_cache);
     hash_free(driver->my_jobs);
+    delete driver->submit_window;
 
 #ifdef HAVE_LSF_LIBRARY
     if (driver->lsb != NULL)
@@ -1191,6 +1462,21 @@ void lsf_driver_set_bjobs_refresh_interval_option(lsf_driver_type *driver,
         lsf_driver_set_bjobs_refresh_interval(driver, refresh_interval);
 }
 
+/**
+   Observe that the window is resized by replacing the semaphore; that
+   is only safe as long as no submissions are in flight, i.e. during
+   the configuration phase - which is when options are set.
+*/
+static void lsf_driver_set_submit_window(lsf_driver_type *driver,
+                                         const char *option_value) {
+    int window;
+    if (util_sscanf_int(option_value, &window) && window > 0) {
+        delete driver->submit_window;
+        driver->submit_window = new Semafoor(window);
+        driver->submit_window_size = window;
+    }
+}
+
 bool lsf_driver_set_option(void *__driver, const char *option_key,
                            const void *value_) {
     const char *value = (const char *)value_;
@@ -1220,6 +1506,8 @@ bool lsf_driver_set_option(void *__driver, const char *option_key,
             lsf_driver_set_debug_output(driver, value);
         else if (strcmp(LSF_SUBMIT_SLEEP, option_key) == 0)
             lsf_driver_set_submit_sleep(driver, value);
+        else if (strcmp(LSF_SUBMIT_WINDOW, option_key) == 0)
+            lsf_driver_set_submit_window(driver, value);
         else if (strcmp(LSF_EXCLUDE_HOST, option_key) == 0)
             lsf_driver_add_exclude_hosts(driver, value);
         else if (strcmp(LSF_BJOBS_TIMEOUT, option_key) == 0)
@@ -1262,6 +1550,11 @@ const void *lsf_driver_get_option(const void *__driver,
             char *timeout_string = (char *)util_alloc_sprintf(
                 "%d", driver->bjobs_refresh_interval);
             return timeout_string;
+        } else if (strcmp(LSF_SUBMIT_WINDOW, option_key) == 0) {
+            /* This will leak. */
+            char *window_string =
+                (char *)util_alloc_sprintf("%d", driver->submit_window_size);
+            return window_string;
         } else {
             util_abort("%s: option_id:%s not recognized for LSF driver \n",
                        __func__, option_key);
@@ -1281,6 +1574,7 @@ void lsf_driver_init_option_list(stringlist_type *option_list) {
     stringlist_append_copy(option_list, LSF_BKILL_CMD);
     stringlist_append_copy(option_list, LSF_BHIST_CMD);
     stringlist_append_copy(option_list, LSF_BJOBS_TIMEOUT);
+    stringlist_append_copy(option_list, LSF_SUBMIT_WINDOW);
 }
 
 /**
@@ -1308,9 +1602,14 @@ static void lsf_driver_lib_init(lsf_driver_type *lsf_driver) {
     lsf_driver->lsf_request.options2 = 0;
 
     lsf_driver->lsb = lsb_alloc();
-    if (lsb_ready(lsf_driver->lsb))
-        lsb_initialize(lsf_driver->lsb);
-    else {
+    if (!lsb_ready(lsf_driver->lsb) ||
+        lsb_initialize(lsf_driver->lsb) != 0) {
+        // Either the libraries could not be loaded or lsb_init()
+        // failed against the batch daemon; discard the lsb instance
+        // and the driver falls back to the shell commands.
+        stringlist_type *error_list = lsb_get_error_list(lsf_driver->lsb);
+        for (int i = 0; i < stringlist_get_size(error_list); i++)
+            logger->warning("lsb: {}", stringlist_iget(error_list, i));
         lsb_free(lsf_driver->lsb);
         lsf_driver->lsb = NULL;
     }
@@ -1380,6 +1679,8 @@ void *lsf_driver_alloc() {
     lsf_driver->error_count = 0;
     lsf_driver->max_error_count = MAX_ERROR_COUNT;
     lsf_driver->submit_error_sleep = SUBMIT_ERROR_SLEEP * 1000000;
+    lsf_driver->submit_window = NULL;
+    lsf_driver->submit_window_size = 0;
     pthread_mutex_init(&lsf_driver->submit_lock, NULL);
 
     lsf_driver_lib_init(lsf_driver);
@@ -1395,5 +1696,6 @@ void *lsf_driver_alloc() {
     lsf_driver_set_option(lsf_driver, LSF_DEBUG_OUTPUT, "FALSE");
     lsf_driver_set_option(lsf_driver, LSF_SUBMIT_SLEEP, DEFAULT_SUBMIT_SLEEP);
     lsf_driver_set_option(lsf_driver, LSF_BJOBS_TIMEOUT, BJOBS_REFRESH_TIME);
+    lsf_driver_set_option(lsf_driver, LSF_SUBMIT_WINDOW, DEFAULT_SUBMIT_WINDOW);
     return lsf_driver;
 }
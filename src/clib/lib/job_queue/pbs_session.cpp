@@ -0,0 +1,235 @@
+/*
+  This file implements a small wrapper around the PBS/Torque IFL client
+  library (pbs_connect() and friends), mirroring the lsb wrapper for
+  LSF. The library is loaded with dlopen() in pbs_session_alloc(), so
+  the job_queue library can be built and loaded without the PBS
+  packages installed; when the library or the server connection is
+  unavailable the torque driver falls back to spawning one
+  qsub/qstat/qdel process per command.
+
+  The whole point of the session is that pbs_connect() is called once
+  per driver instance and every subsequent operation is multiplexed
+  over that one connection, instead of every spawned command paying the
+  connection setup to the PBS server.
+*/
+
+#include <mutex>
+#include <string>
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ert/util/stringlist.hpp>
+#include <ert/util/util.hpp>
+
+#include <ert/job_queue/pbs_session.hpp>
+
+typedef int(pbs_connect_ftype)(char *);
+typedef int(pbs_disconnect_ftype)(int);
+typedef char *(pbs_submit_ftype)(int, struct pbs_attropl *, char *, char *,
+                                 char *);
+typedef struct pbs_batch_status *(pbs_statjob_ftype)(int, char *,
+                                                     struct pbs_attrl *,
+                                                     char *);
+typedef void(pbs_statfree_ftype)(struct pbs_batch_status *);
+typedef int(pbs_deljob_ftype)(int, char *, char *);
+
+struct pbs_session_struct {
+    pbs_connect_ftype *connect;
+    pbs_disconnect_ftype *disconnect;
+    pbs_submit_ftype *submit;
+    pbs_statjob_ftype *statjob;
+    pbs_statfree_ftype *statfree;
+    pbs_deljob_ftype *deljob;
+
+    void *lib_handle;
+    /** Connection handle from pbs_connect(); negative when not connected. */
+    int connection;
+    /** Server passed to pbs_connect(); NULL means the default server. */
+    char *server;
+    /** The IFL connection is one socket - all use of it is serialized. */
+    std::mutex session_mutex;
+    stringlist_type *error_list;
+    bool ready;
+};
+
+static void *pbs_session_dlsym(pbs_session_type *session,
+                               const char *function_name) {
+    void *function = dlsym(session->lib_handle, function_name);
+    if (!function) {
+        session->ready = false;
+        stringlist_append_owned_ref(
+            session->error_list,
+            util_alloc_sprintf("Failed to locate symbol:%s  dlerror:%s",
+                               function_name, dlerror()));
+    }
+    return function;
+}
+
+pbs_session_type *pbs_session_alloc(const char *server) {
+    pbs_session_type *session = new pbs_session_type();
+    session->ready = true;
+    session->connection = -1;
+    session->server = util_alloc_string_copy(server);
+    session->error_list = stringlist_alloc_new();
+
+    const char *lib_names[] = {"libtorque.so", "libtorque.so.2", "libpbs.so"};
+    session->lib_handle = NULL;
+    for (const char *lib_name : lib_names) {
+        session->lib_handle = dlopen(lib_name, RTLD_NOW | RTLD_LOCAL);
+        if (session->lib_handle)
+            break;
+        stringlist_append_owned_ref(
+            session->error_list,
+            util_alloc_sprintf("dlopen(%s) - failed:%s", lib_name, dlerror()));
+    }
+
+    if (session->lib_handle) {
+        session->connect =
+            (pbs_connect_ftype *)pbs_session_dlsym(session, "pbs_connect");
+        session->disconnect = (pbs_disconnect_ftype *)pbs_session_dlsym(
+            session, "pbs_disconnect");
+        session->submit =
+            (pbs_submit_ftype *)pbs_session_dlsym(session, "pbs_submit");
+        session->statjob =
+            (pbs_statjob_ftype *)pbs_session_dlsym(session, "pbs_statjob");
+        session->statfree =
+            (pbs_statfree_ftype *)pbs_session_dlsym(session, "pbs_statfree");
+        session->deljob =
+            (pbs_deljob_ftype *)pbs_session_dlsym(session, "pbs_deljob");
+    } else
+        session->ready = false;
+
+    if (session->ready) {
+        session->connection = session->connect(session->server);
+        if (session->connection < 0) {
+            session->ready = false;
+            stringlist_append_owned_ref(
+                session->error_list,
+                util_alloc_sprintf("pbs_connect(%s) failed",
+                                   session->server ? session->server
+                                                   : "<default server>"));
+        }
+    }
+    return session;
+}
+
+void pbs_session_free(pbs_session_type *session) {
+    if (session->connection >= 0)
+        session->disconnect(session->connection);
+    if (session->lib_handle)
+        dlclose(session->lib_handle);
+    stringlist_free(session->error_list);
+    free(session->server);
+    delete session;
+}
+
+bool pbs_session_ready(const pbs_session_type *session) {
+    return session->ready;
+}
+
+stringlist_type *pbs_session_get_error_list(const pbs_session_type *session) {
+    return session->error_list;
+}
+
+/** PBS servers drop idle connections; reconnect on demand. */
+static bool pbs_session_ensure_connected(pbs_session_type *session) {
+    if (session->connection < 0)
+        session->connection = session->connect(session->server);
+    return session->connection >= 0;
+}
+
+static void pbs_session_drop_connection(pbs_session_type *session) {
+    if (session->connection >= 0)
+        session->disconnect(session->connection);
+    session->connection = -1;
+}
+
+/**
+   Submits the script over the persistent connection. Returns the job
+   id allocated by the library (caller frees), or NULL on failure - in
+   which case the caller should fall back to spawning qsub.
+*/
+char *pbs_session_submit_job(pbs_session_type *session, const char *script,
+                             const char *destination, const char *job_name,
+                             const char *resource_nodes, bool keep_output) {
+    std::lock_guard guard{session->session_mutex};
+
+    struct pbs_attropl attribs[3];
+    int num_attribs = 0;
+    if (job_name) {
+        attribs[num_attribs] = {NULL, (char *)"Job_Name", NULL,
+                                (char *)job_name, 0};
+        num_attribs++;
+    }
+    if (resource_nodes) {
+        attribs[num_attribs] = {NULL, (char *)"Resource_List",
+                                (char *)"nodes", (char *)resource_nodes, 0};
+        num_attribs++;
+    }
+    if (keep_output) {
+        attribs[num_attribs] = {NULL, (char *)"Keep_Files", NULL,
+                                (char *)"oe", 0};
+        num_attribs++;
+    }
+    for (int i = 0; i + 1 < num_attribs; i++)
+        attribs[i].next = &attribs[i + 1];
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!pbs_session_ensure_connected(session))
+            return NULL;
+        char *job_id = session->submit(
+            session->connection, num_attribs > 0 ? attribs : NULL,
+            (char *)script, (char *)destination, NULL);
+        if (job_id)
+            return job_id;
+        pbs_session_drop_connection(session);
+    }
+    return NULL;
+}
+
+/**
+   Reads the job_state / Exit_status attributes of the job over the
+   persistent connection. Returns false when the lookup fails, in which
+   case the caller should fall back to qstat.
+*/
+bool pbs_session_job_state(pbs_session_type *session, const char *job_id,
+                           std::string &job_state, int &exit_status) {
+    std::lock_guard guard{session->session_mutex};
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!pbs_session_ensure_connected(session))
+            return false;
+        struct pbs_batch_status *status =
+            session->statjob(session->connection, (char *)job_id, NULL, NULL);
+        if (status) {
+            job_state = "_void_";
+            exit_status = 0;
+            for (struct pbs_attrl *attr = status->attribs; attr;
+                 attr = attr->next) {
+                if (strcmp(attr->name, "job_state") == 0)
+                    job_state = attr->value;
+                else if (strcmp(attr->name, "Exit_status") == 0)
+                    exit_status = atoi(attr->value);
+            }
+            session->statfree(status);
+            return true;
+        }
+        pbs_session_drop_connection(session);
+    }
+    return false;
+}
+
+bool pbs_session_deljob(pbs_session_type *session, const char *job_id) {
+    std::lock_guard guard{session->session_mutex};
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!pbs_session_ensure_connected(session))
+            return false;
+        if (session->deljob(session->connection, (char *)job_id, NULL) == 0)
+            return true;
+        pbs_session_drop_connection(session);
+    }
+    return false;
+}
@@ -40,6 +40,10 @@ struct queue_driver_struct {
     submit_job_ftype *submit;
     free_job_ftype *free_job;
     kill_job_ftype *kill_job;
+    /** Optional batched kill - drivers which can cancel many jobs with
+     * a single scheduler command set this; when NULL the queue layer
+     * falls back to calling kill_job once per job. */
+    kill_jobs_ftype *kill_jobs;
     blacklist_node_ftype *blacklist_node;
     get_status_ftype *get_status;
     free_queue_driver_ftype *free_driver;
@@ -179,6 +183,7 @@ static queue_driver_type *queue_driver_alloc_empty() {
     driver->submit = NULL;
     driver->get_status = NULL;
     driver->kill_job = NULL;
+    driver->kill_jobs = NULL;
     driver->free_job = NULL;
     driver->free_driver = NULL;
     driver->get_option = NULL;
@@ -207,6 +212,7 @@ queue_driver_type *queue_driver_alloc(job_driver_type type) {
         driver->get_status = lsf_driver_get_job_status;
         driver->blacklist_node = lsf_driver_blacklist_node;
         driver->kill_job = lsf_driver_kill_job;
+        driver->kill_jobs = lsf_driver_kill_jobs;
         driver->free_job = lsf_driver_free_job;
         driver->free_driver = lsf_driver_free__;
         driver->set_option = lsf_driver_set_option;
@@ -221,6 +227,8 @@ queue_driver_type *queue_driver_alloc(job_driver_type type) {
         driver->kill_job = local_driver_kill_job;
         driver->free_job = local_driver_free_job;
         driver->free_driver = local_driver_free__;
+        driver->set_option = local_driver_set_option;
+        driver->get_option = local_driver_get_option;
         driver->name = util_alloc_string_copy("local");
         driver->init_options = local_driver_init_option_list;
         driver->data = local_driver_alloc();
@@ -244,6 +252,7 @@ queue_driver_type *queue_driver_alloc(job_driver_type type) {
         driver->init_options = slurm_driver_init_option_list;
         driver->free_driver = slurm_driver_free__;
         driver->kill_job = slurm_driver_kill_job;
+        driver->kill_jobs = slurm_driver_kill_jobs;
         driver->free_job = slurm_driver_free_job;
         driver->submit = slurm_driver_submit_job;
         driver->get_status = slurm_driver_get_job_status;
@@ -257,6 +266,25 @@ queue_driver_type *queue_driver_alloc(job_driver_type type) {
     return driver;
 }
 
+/** The mock driver data is owned by the caller - nothing to free. */
+static void queue_driver_mock_free_driver(void *data) {}
+
+queue_driver_type *queue_driver_alloc_mock(submit_job_ftype *submit,
+                                           get_status_ftype *get_status,
+                                           kill_job_ftype *kill_job,
+                                           free_job_ftype *free_job,
+                                           void *data) {
+    queue_driver_type *driver = queue_driver_alloc_empty();
+    driver->free_driver = queue_driver_mock_free_driver;
+    driver->submit = submit;
+    driver->get_status = get_status;
+    driver->kill_job = kill_job;
+    driver->free_job = free_job;
+    driver->data = data;
+    driver->name = util_alloc_string_copy("mock");
+    return driver;
+}
+
 const void *queue_driver_get_option(queue_driver_type *driver,
                                     const char *option_key) {
     if (queue_driver_has_generic_option__(driver, option_key)) {
@@ -310,6 +338,15 @@ void queue_driver_kill_job(queue_driver_type *driver, void *job_data) {
     driver->kill_job(driver->data, job_data);
 }
 
+void queue_driver_kill_jobs(queue_driver_type *driver, int num_jobs,
+                            void **jobs) {
+    if (driver->kill_jobs != NULL)
+        driver->kill_jobs(driver->data, num_jobs, jobs);
+    else
+        for (int i = 0; i < num_jobs; i++)
+            driver->kill_job(driver->data, jobs[i]);
+}
+
 job_status_type queue_driver_get_status(queue_driver_type *driver,
                                         void *job_data) {
     job_status_type status = driver->get_status(driver->data, job_data);
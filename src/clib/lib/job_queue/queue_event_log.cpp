@@ -0,0 +1,91 @@
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+
+#include <ert/util/util.hpp>
+
+#include <ert/job_queue/queue_event_log.hpp>
+
+/*
+  When a large batch runs slowly the aggregate status counts can not
+  tell where the time went - submit latency, pending time, run time
+  and callback time are all mixed together. This module keeps a
+  process wide timeline of every job status transition so a slow run
+  can be analyzed offline.
+
+  Recording is a single relaxed fetch_add on the write cursor plus a
+  plain slot write - no locks are taken, so instrumenting the
+  transition choke point does not add contention between the job
+  threads. The buffer is a ring: when it wraps the oldest events are
+  overwritten, and an event can only be torn in the dump if recording
+  outruns the dump by a full buffer length.
+*/
+
+namespace {
+
+struct queue_event {
+    /** Microseconds since the first recorded event. */
+    int64_t time_us;
+    int queue_index;
+    job_status_type old_status;
+    job_status_type new_status;
+};
+
+constexpr size_t EVENT_CAPACITY = 1 << 16;
+queue_event event_buffer[EVENT_CAPACITY];
+std::atomic<size_t> event_count{0};
+std::atomic<int64_t> first_event_us{0};
+
+int64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+void queue_event_log_record(int queue_index, job_status_type old_status,
+                            job_status_type new_status) {
+    int64_t now = now_us();
+    int64_t expected = 0;
+    first_event_us.compare_exchange_strong(expected, now);
+
+    size_t index = event_count.fetch_add(1, std::memory_order_relaxed);
+    queue_event &event = event_buffer[index % EVENT_CAPACITY];
+    event.time_us = now - first_event_us.load(std::memory_order_relaxed);
+    event.queue_index = queue_index;
+    event.old_status = old_status;
+    event.new_status = new_status;
+}
+
+void queue_event_log_clear() {
+    event_count.store(0);
+    first_event_us.store(0);
+}
+
+/**
+   Write the recorded timeline in the Chrome trace JSON format; each
+   transition becomes an instant event on the track of its queue
+   index, so the per job submit/pending/run/callback phases can be
+   read directly off the timeline.
+*/
+void queue_event_log_fwrite_chrome_trace(const char *filename) {
+    size_t total = event_count.load();
+    size_t count = total < EVENT_CAPACITY ? total : EVENT_CAPACITY;
+    size_t start = total - count;
+
+    FILE *stream = util_fopen(filename, "w");
+    fprintf(stream, "{\"traceEvents\": [\n");
+    for (size_t i = start; i < total; i++) {
+        const queue_event &event = event_buffer[i % EVENT_CAPACITY];
+        fprintf(stream,
+                "%s{\"name\": \"%s -> %s\", \"ph\": \"i\", \"s\": \"t\", "
+                "\"ts\": %lld, \"pid\": 0, \"tid\": %d}",
+                i == start ? "" : ",\n",
+                job_status_get_name(event.old_status),
+                job_status_get_name(event.new_status),
+                (long long)event.time_us, event.queue_index);
+    }
+    fprintf(stream, "\n]}\n");
+    fclose(stream);
+}
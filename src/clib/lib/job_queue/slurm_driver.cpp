@@ -98,6 +98,20 @@ public:
         return status;
     }
 
+    /** The ids of the jobs currently registered in an active state,
+        i.e. the jobs squeue can still be expected to report. */
+    std::vector<int> active_job_ids() const {
+        std::vector<int> job_ids;
+
+        pthread_rwlock_rdlock(&this->lock);
+        for (const auto &job_pair : this->jobs)
+            if (this->active_status(job_pair.second))
+                job_ids.push_back(job_pair.first);
+        pthread_rwlock_unlock(&this->lock);
+
+        return job_ids;
+    }
+
 private:
     std::unordered_map<int, job_status_type> jobs;
     mutable pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
@@ -133,6 +147,9 @@ struct slurm_driver_struct {
     mutable std::time_t status_timestamp;
     double status_timeout = DEFAULT_SQUEUE_TIMEOUT;
     std::string status_timeout_string;
+    /** Only one thread should refresh the status cache; the other job
+        threads read the cached statuses. */
+    mutable pthread_mutex_t status_update_mutex = PTHREAD_MUTEX_INITIALIZER;
 };
 
 static std::string load_file(const char *fname) {
@@ -523,10 +540,23 @@ slurm_driver_get_job_status_scontrol(const slurm_driver_type *driver,
 
 static void slurm_driver_update_status_cache(const slurm_driver_type *driver) {
     driver->status_timestamp = time(nullptr);
+
+    // Query only the jobs submitted by this driver instance; squeueing
+    // the full queue of the user scales with everything the user has
+    // running, not with this ensemble.
+    auto active_ids = driver->status.active_job_ids();
+    if (active_ids.empty())
+        return;
+
+    std::vector<std::string> id_strings;
+    for (const auto &job_id : active_ids)
+        id_strings.push_back(std::to_string(job_id));
+
     const std::string space = " \n";
     auto squeue_output =
         load_stdout(driver->squeue_cmd.c_str(),
-                    {"-h", "--user=" + driver->username, "--format=%i %T"});
+                    {"-h", "--user=" + driver->username,
+                     "--jobs=" + join_string(id_strings), "--format=%i %T"});
     auto offset = squeue_output.find_first_not_of(space);
 
     std::unordered_map<int, job_status_type> squeue_jobs;
@@ -571,8 +601,15 @@ job_status_type slurm_driver_get_job_status(void *__driver, void *__job) {
     const auto *job = static_cast<const SlurmJob *>(__job);
     auto update_cache = difftime(time(nullptr), driver->status_timestamp) >
                         driver->status_timeout;
-    if (update_cache)
-        slurm_driver_update_status_cache(driver);
+    if (update_cache) {
+        pthread_mutex_lock(&driver->status_update_mutex);
+        // Another job thread might have refreshed the cache while we
+        // waited for the mutex; recheck before spawning squeue again.
+        if (difftime(time(nullptr), driver->status_timestamp) >
+            driver->status_timeout)
+            slurm_driver_update_status_cache(driver);
+        pthread_mutex_unlock(&driver->status_update_mutex);
+    }
 
     return driver->status.get(job->job_id);
 }
@@ -588,6 +625,24 @@ void slurm_driver_kill_job(void *__driver, void *__job) {
     free(argv);
 }
 
+/**
+   Cancels all the jobs with one scancel invocation - scancel accepts a
+   list of job ids - instead of spawning one process per job.
+*/
+void slurm_driver_kill_jobs(void *__driver, int num_jobs, void **jobs) {
+    auto driver = static_cast<slurm_driver_type *>(__driver);
+    if (num_jobs == 0)
+        return;
+
+    const char **argv =
+        static_cast<const char **>(util_calloc(num_jobs, sizeof *argv));
+    for (int i = 0; i < num_jobs; i++)
+        argv[i] = static_cast<const SlurmJob *>(jobs[i])->string_id.c_str();
+    util_spawn_blocking(driver->scancel_cmd.c_str(), num_jobs, argv, nullptr,
+                        nullptr);
+    free(argv);
+}
+
 void slurm_driver_free_job(void *__job) {
     SlurmJob *job = static_cast<SlurmJob *>(__job);
     delete job;
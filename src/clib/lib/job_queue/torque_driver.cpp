@@ -1,17 +1,21 @@
 #include <filesystem>
 
 #include <array>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <unordered_map>
 #include <unistd.h>
 
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/util.hpp>
 
+#include <ert/job_queue/pbs_session.hpp>
 #include <ert/job_queue/torque_driver.hpp>
 
 namespace fs = std::filesystem;
@@ -31,6 +35,23 @@ struct torque_driver_struct {
     char *cluster_label;
     int submit_sleep;
     FILE *debug_stream;
+
+    /** The output of one batched "qstat -f" invocation is parsed into this
+     * table; per-job status lookups are served from it between refreshes. */
+    std::unordered_map<std::string, job_status_type> status_cache;
+    /** Only one thread should refresh the status cache. */
+    std::mutex status_cache_mutex;
+    time_t status_cache_timestamp;
+    int qstat_refresh_interval;
+
+    /** Persistent connection to the PBS server; every qsub/qstat/qdel
+     * is multiplexed over it instead of each paying the connection
+     * setup. NULL when the client library or the server is unavailable
+     * and the per-command spawning below is used instead. */
+    pbs_session_type *session;
+    std::once_flag session_once;
+    /** The SESSION option - set to false to force the spawn path. */
+    bool use_session;
 };
 
 struct torque_job_struct {
@@ -39,8 +60,7 @@ struct torque_job_struct {
 };
 
 void *torque_driver_alloc() {
-    torque_driver_type *torque_driver =
-        (torque_driver_type *)util_malloc(sizeof *torque_driver);
+    torque_driver_type *torque_driver = new torque_driver_type();
 
     torque_driver->queue_name = NULL;
     torque_driver->qsub_cmd = NULL;
@@ -55,6 +75,11 @@ void *torque_driver_alloc() {
     torque_driver->cluster_label = NULL;
     torque_driver->job_prefix = NULL;
     torque_driver->debug_stream = NULL;
+    torque_driver->status_cache_timestamp = 0;
+    torque_driver->qstat_refresh_interval =
+        TORQUE_DEFAULT_QSTAT_REFRESH_INTERVAL;
+    torque_driver->session = NULL;
+    torque_driver->use_session = true;
 
     torque_driver_set_option(torque_driver, TORQUE_QSUB_CMD,
                              TORQUE_DEFAULT_QSUB_CMD);
@@ -146,6 +171,18 @@ torque_driver_set_keep_qsub_output(torque_driver_type *driver,
     }
 }
 
+static bool torque_driver_set_session(torque_driver_type *driver,
+                                      const char *session_bool_as_char) {
+    bool use_session_parsed;
+
+    if (util_sscanf_bool(session_bool_as_char, &use_session_parsed)) {
+        driver->use_session = use_session_parsed;
+        return true;
+    } else {
+        return false;
+    }
+}
+
 static void torque_driver_set_job_prefix(torque_driver_type *driver,
                                          const char *job_prefix) {
     driver->job_prefix =
@@ -202,6 +239,8 @@ bool torque_driver_set_option(void *__driver, const char *option_key,
             torque_driver_set_debug_output(driver, value);
         else if (strcmp(TORQUE_SUBMIT_SLEEP, option_key) == 0)
             option_set = torque_driver_set_submit_sleep(driver, value);
+        else if (strcmp(TORQUE_SESSION, option_key) == 0)
+            option_set = torque_driver_set_session(driver, value);
         else
             option_set = false;
     }
@@ -228,6 +267,8 @@ const void *torque_driver_get_option(const void *__driver,
             return driver->num_nodes_char;
         else if (strcmp(TORQUE_KEEP_QSUB_OUTPUT, option_key) == 0)
             return driver->keep_qsub_output ? "1" : "0";
+        else if (strcmp(TORQUE_SESSION, option_key) == 0)
+            return driver->use_session ? "1" : "0";
         else if (strcmp(TORQUE_CLUSTER_LABEL, option_key) == 0)
             return driver->cluster_label;
         else if (strcmp(TORQUE_JOB_PREFIX_KEY, option_key) == 0)
@@ -251,6 +292,7 @@ void torque_driver_init_option_list(stringlist_type *option_list) {
     stringlist_append_copy(option_list, TORQUE_KEEP_QSUB_OUTPUT);
     stringlist_append_copy(option_list, TORQUE_CLUSTER_LABEL);
     stringlist_append_copy(option_list, TORQUE_JOB_PREFIX_KEY);
+    stringlist_append_copy(option_list, TORQUE_SESSION);
 }
 
 torque_job_type *torque_job_alloc() {
@@ -319,6 +361,33 @@ static void torque_debug(const torque_driver_type *driver, const char *fmt,
     }
 }
 
+/**
+   Lazily establishes the persistent PBS server session the first time
+   it is needed. When the client library cannot be loaded or the server
+   connection fails - or the SESSION option is set to FALSE - the
+   driver keeps spawning one qsub/qstat/qdel process per command as
+   before.
+*/
+static pbs_session_type *
+torque_driver_get_session(torque_driver_type *driver) {
+    if (!driver->use_session)
+        return NULL;
+    std::call_once(driver->session_once, [driver] {
+        pbs_session_type *session = pbs_session_alloc(NULL);
+        if (pbs_session_ready(session))
+            driver->session = session;
+        else {
+            const stringlist_type *errors =
+                pbs_session_get_error_list(session);
+            for (int i = 0; i < stringlist_get_size(errors); i++)
+                torque_debug(driver, "pbs session unavailable: %s",
+                             stringlist_iget(errors, i));
+            pbs_session_free(session);
+        }
+    });
+    return driver->session;
+}
+
 static int torque_job_parse_qsub_stdout(const torque_driver_type *driver,
                                         const char *stdout_file) {
     int jobid;
@@ -393,6 +462,63 @@ static void torque_debug_spawn_status_info(torque_driver_type *driver,
     }
 }
 
+/**
+   Submits over the persistent PBS session - one round trip on the
+   standing connection instead of a qsub process paying connection
+   setup. Returns 0 when the submission fails, in which case the
+   caller falls back to the shell path.
+*/
+static int torque_driver_submit_session_job(
+    torque_driver_type *driver, pbs_session_type *session,
+    const char *run_path, const char *job_name, const char *submit_cmd,
+    int num_cpu, int job_argc, const char **job_argv) {
+
+    usleep(driver->submit_sleep);
+
+    int p_units_from_driver = driver->num_cpus_per_node * driver->num_nodes;
+    if (num_cpu > p_units_from_driver) {
+        util_abort("%s: Error in config, job's config requires %d "
+                   "processing units, but config says %s: %d, and %s: "
+                   "%d, which multiplied becomes: %d \n",
+                   __func__, num_cpu, TORQUE_NUM_CPUS_PER_NODE,
+                   driver->num_cpus_per_node, TORQUE_NUM_NODES,
+                   driver->num_nodes, p_units_from_driver);
+    }
+
+    char *script_filename =
+        (char *)util_alloc_filename(run_path, "qsub_script", "sh");
+    torque_job_create_submit_script(script_filename, submit_cmd, job_argc,
+                                    job_argv);
+
+    char *resource_string;
+    if (driver->cluster_label)
+        resource_string =
+            util_alloc_sprintf("%d:%s:ppn=%d", driver->num_nodes,
+                               driver->cluster_label,
+                               driver->num_cpus_per_node);
+    else
+        resource_string = util_alloc_sprintf("%d:ppn=%d", driver->num_nodes,
+                                             driver->num_cpus_per_node);
+
+    int job_id = 0;
+    char *job_id_string = pbs_session_submit_job(
+        session, script_filename, driver->queue_name, job_name,
+        resource_string, driver->keep_qsub_output);
+    if (job_id_string) {
+        job_id = atoi(job_id_string);
+        torque_debug(driver, "Session submit of %s gave id:%s", job_name,
+                     job_id_string);
+        free(job_id_string);
+    } else
+        torque_debug(driver,
+                     "Session submit of %s failed - falling back to %s",
+                     job_name, driver->qsub_cmd);
+
+    free(resource_string);
+    free(script_filename);
+    return job_id;
+}
+
 static int torque_driver_submit_shell_job(torque_driver_type *driver,
                                           const char *run_path,
                                           const char *job_name,
@@ -498,8 +624,15 @@ void *torque_driver_submit_job(void *__driver, const char *submit_cmd,
         else
             local_job_name = util_alloc_string_copy(job_name);
 
-        job->torque_jobnr = torque_driver_submit_shell_job(
-            driver, run_path, local_job_name, submit_cmd, num_cpu, argc, argv);
+        pbs_session_type *session = torque_driver_get_session(driver);
+        if (session)
+            job->torque_jobnr = torque_driver_submit_session_job(
+                driver, session, run_path, local_job_name, submit_cmd,
+                num_cpu, argc, argv);
+        if (job->torque_jobnr <= 0)
+            job->torque_jobnr = torque_driver_submit_shell_job(
+                driver, run_path, local_job_name, submit_cmd, num_cpu, argc,
+                argv);
         job->torque_jobnr_char = util_alloc_sprintf("%ld", job->torque_jobnr);
 
         torque_debug(driver, "Job:%s Id:%d", run_path, job->torque_jobnr);
@@ -579,6 +712,48 @@ torque_driver_get_qstat_status(torque_driver_type *driver,
     return status;
 }
 
+static job_status_type
+torque_driver_convert_state(const std::string &job_state, int exit_status) {
+    job_status_type status = JOB_QUEUE_STATUS_FAILURE;
+
+    switch (job_state[0]) {
+    case 'R':
+        /* Job is running */
+        status = JOB_QUEUE_RUNNING;
+        break;
+    case 'E':
+        /* Job is exiting after having run */
+        status = JOB_QUEUE_DONE;
+        break;
+    case 'F':
+        /* PBS specific value: Job is finished */
+        /* This is only returned in the alternative qstat format
+               triggered with '-x' or '-H' option to qstat */
+        status = JOB_QUEUE_DONE;
+        break;
+    case 'C':
+        /* Job is completed after having run */
+        status = JOB_QUEUE_DONE;
+        break;
+    case 'H':
+        /* Job is held */
+        status = JOB_QUEUE_PENDING;
+        break;
+    case 'Q':
+        /* Job is queued, eligible to run or routed */
+        status = JOB_QUEUE_PENDING;
+        break;
+    default:
+        break;
+    }
+
+    if (exit_status != 0) {
+        status = JOB_QUEUE_EXIT;
+    }
+
+    return status;
+}
+
 job_status_type torque_driver_parse_status(const char *qstat_file,
                                            const char *jobnr_char) {
     job_status_type status = JOB_QUEUE_STATUS_FAILURE;
@@ -660,40 +835,7 @@ job_status_type torque_driver_parse_status(const char *qstat_file,
     } catch (const std::ios::failure &) {
         // end-of-file
     }
-    switch (job_state[0]) {
-    case 'R':
-        /* Job is running */
-        status = JOB_QUEUE_RUNNING;
-        break;
-    case 'E':
-        /* Job is exiting after having run */
-        status = JOB_QUEUE_DONE;
-        break;
-    case 'F':
-        /* PBS specific value: Job is finished */
-        /* This is only returned in the alternative qstat format
-               triggered with '-x' or '-H' option to qstat */
-        status = JOB_QUEUE_DONE;
-        break;
-    case 'C':
-        /* Job is completed after having run */
-        status = JOB_QUEUE_DONE;
-        break;
-    case 'H':
-        /* Job is held */
-        status = JOB_QUEUE_PENDING;
-        break;
-    case 'Q':
-        /* Job is queued, eligible to run or routed */
-        status = JOB_QUEUE_PENDING;
-        break;
-    default:
-        break;
-    }
-
-    if (exit_status != 0) {
-        status = JOB_QUEUE_EXIT;
-    }
+    status = torque_driver_convert_state(job_state, exit_status);
 
     if (status == JOB_QUEUE_STATUS_FAILURE)
         fprintf(
@@ -704,9 +846,136 @@ job_status_type torque_driver_parse_status(const char *qstat_file,
     return status;
 }
 
+/**
+   Parse the output of one batched "qstat -f" invocation (no job id
+   argument, i.e. every job visible to qstat) into a jobnr -> status
+   table. The job ids are stored without the server namespace, matching
+   the ids recorded at submit time.
+*/
+static std::unordered_map<std::string, job_status_type>
+torque_driver_parse_status_all(const char *qstat_file) {
+    std::unordered_map<std::string, job_status_type> status_table;
+
+    const std::string job_id_label("Job Id: ");
+    std::string job_id;
+    std::string job_state("_void_");
+    int exit_status = 0;
+
+    std::ifstream qstatoutput(qstat_file);
+    qstatoutput.imbue(std::locale::classic());
+
+    std::string line;
+    while (std::getline(qstatoutput, line)) {
+        auto pos = line.find(job_id_label);
+        if (pos != std::string::npos) {
+            if (!job_id.empty())
+                status_table[job_id] =
+                    torque_driver_convert_state(job_state, exit_status);
+
+            line.replace(0, job_id_label.length() + pos, "");
+            auto dot_position = line.find(".");
+            if (dot_position != std::string::npos)
+                line = line.substr(0, dot_position);
+            job_id = line;
+            job_state = "_void_";
+            exit_status = 0;
+        }
+
+        if (line.find("job_state") != std::string::npos) {
+            std::string key, equalsign;
+            std::stringstream(line) >> key >> equalsign >> job_state;
+        }
+
+        if (line.find("Exit_status") != std::string::npos) {
+            std::string key, equalsign;
+            std::stringstream(line) >> key >> equalsign >> exit_status;
+        }
+    }
+    if (!job_id.empty())
+        status_table[job_id] =
+            torque_driver_convert_state(job_state, exit_status);
+
+    return status_table;
+}
+
+/**
+   Refresh the status cache with one "qstat -f" invocation covering all
+   jobs, instead of one qstat process per job per poll.
+*/
+static void torque_driver_update_status_cache(torque_driver_type *driver) {
+    char *tmp_std_file =
+        (char *)util_alloc_tmp_file("/tmp", "ert-qstat-std", true);
+    char *tmp_err_file =
+        (char *)util_alloc_tmp_file("/tmp", "ert-qstat-err", true);
+
+    {
+        char const *hard_coded_qstat_option = "-f";
+        std::array argv{hard_coded_qstat_option,
+                        (const char *)driver->qstat_opts};
+
+        /* The qstat command might fail intermittently for acceptable reasons,
+           retry a couple of times with exponential sleep. */
+        int return_value = -1;
+        int sleep_time = 2;                 /* seconds */
+        int max_sleep_time = 2 * 2 * 2 * 2; /* max 4 attempts */
+        while ((return_value != 0) && (sleep_time < max_sleep_time)) {
+            return_value =
+                util_spawn_blocking(driver->qstat_cmd, argv.size(), argv.data(),
+                                    tmp_std_file, tmp_err_file);
+            if (return_value != 0) {
+                torque_debug(driver, "qstat failed, retrying in %d seconds",
+                             sleep_time);
+                sleep(sleep_time);
+                sleep_time *= 2;
+            }
+        }
+    }
+
+    if (fs::exists(tmp_std_file)) {
+        driver->status_cache = torque_driver_parse_status_all(tmp_std_file);
+        driver->status_cache_timestamp = time(NULL);
+        unlink(tmp_std_file);
+        unlink(tmp_err_file);
+    } else
+        fprintf(stderr,
+                "No such file: %s - reading qstat status failed\n"
+                "stderr: %s\n",
+                tmp_std_file, tmp_err_file);
+    free(tmp_std_file);
+    free(tmp_err_file);
+}
+
+void torque_driver_set_qstat_refresh_interval(torque_driver_type *driver,
+                                              int refresh_interval) {
+    driver->qstat_refresh_interval = refresh_interval;
+}
+
 job_status_type torque_driver_get_job_status(void *__driver, void *__job) {
     auto driver = static_cast<torque_driver_type *>(__driver);
     auto job = static_cast<torque_job_type *>(__job);
+
+    pbs_session_type *session = torque_driver_get_session(driver);
+    if (session) {
+        std::string job_state;
+        int exit_status;
+        if (pbs_session_job_state(session, job->torque_jobnr_char, job_state,
+                                  exit_status))
+            return torque_driver_convert_state(job_state, exit_status);
+    }
+
+    std::lock_guard lock(driver->status_cache_mutex);
+    if (difftime(time(NULL), driver->status_cache_timestamp) >
+        driver->qstat_refresh_interval)
+        torque_driver_update_status_cache(driver);
+
+    auto status_iter = driver->status_cache.find(job->torque_jobnr_char);
+    if (status_iter != driver->status_cache.end())
+        return status_iter->second;
+
+    /* The job is not in the batched listing - it may have fallen out of
+       the qstat history. Fall back to querying it directly; with the
+       default "-x" option qstat keeps reporting historic jobs for a
+       while. */
     return torque_driver_get_qstat_status(driver, job->torque_jobnr_char);
 }
 
@@ -714,12 +983,19 @@ void torque_driver_kill_job(void *__driver, void *__job) {
 
     auto driver = static_cast<torque_driver_type *>(__driver);
     auto job = static_cast<torque_job_type *>(__job);
+
+    pbs_session_type *session = torque_driver_get_session(driver);
+    if (session && pbs_session_deljob(session, job->torque_jobnr_char))
+        return;
+
     util_spawn_blocking(driver->qdel_cmd, 1,
                         (const char **)&job->torque_jobnr_char, NULL, NULL);
 }
 
 void torque_driver_free(torque_driver_type *driver) {
     torque_driver_set_debug_output(driver, NULL);
+    if (driver->session)
+        pbs_session_free(driver->session);
     free(driver->queue_name);
     free(driver->qdel_cmd);
     free(driver->qstat_cmd);
@@ -730,7 +1006,7 @@ void torque_driver_free(torque_driver_type *driver) {
     if (driver->job_prefix)
         free(driver->job_prefix);
 
-    free(driver);
+    delete driver;
 }
 
 void torque_driver_free__(void *__driver) {
@@ -1,6 +1,12 @@
 #include <filesystem>
+#include <future>
+#include <vector>
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <ert/concurrency.hpp>
 
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/int_vector.hpp>
@@ -21,10 +27,17 @@ typedef struct cmd_struct cmd_type;
 struct cmd_struct {
     const workflow_job_type *workflow_job;
     stringlist_type *arglist;
+    /** Jobs sharing a non-negative group number were listed between a
+        PARALLEL and the following SERIAL marker and may run
+        concurrently; -1 is the default serial execution. */
+    int parallel_group;
 };
 
 struct workflow_struct {
-    time_t compile_time;
+    /** FNV-1a hash of the source text which was last compiled
+        successfully - after any context substitution. Only meaningful
+        when compiled is true. */
+    uint64_t src_hash;
     bool compiled;
     char *src_file;
     vector_type *cmd_list;
@@ -34,10 +47,12 @@ struct workflow_struct {
 };
 
 static cmd_type *cmd_alloc(const workflow_job_type *workflow_job,
-                           const stringlist_type *arglist) {
+                           const stringlist_type *arglist,
+                           int parallel_group) {
     cmd_type *cmd = (cmd_type *)util_malloc(sizeof *cmd);
     cmd->workflow_job = workflow_job;
     cmd->arglist = stringlist_alloc_deep_copy(arglist);
+    cmd->parallel_group = parallel_group;
     return cmd;
 }
 
@@ -70,36 +85,46 @@ static void workflow_store_error(workflow_type *workflow,
         workflow->last_error = NULL;
 }
 
+static uint64_t workflow_source_hash(const char *src_file) {
+    int content_size;
+    char *content = util_fread_alloc_file_content(src_file, &content_size);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < content_size; i++) {
+        hash ^= (unsigned char)content[i];
+        hash *= 0x100000001b3ULL;
+    }
+    free(content);
+    return hash;
+}
+
 bool workflow_try_compile(workflow_type *script,
                           const subst_list_type *context) {
     if (fs::exists(script->src_file)) {
         const char *src_file = script->src_file;
         char *tmp_file = NULL;
-        bool update = false;
         if (context != NULL) {
             tmp_file = util_alloc_tmp_file("/tmp", "ert-workflow", false);
-            update =
+            bool update =
                 subst_list_filter_file(context, script->src_file, tmp_file);
-            if (update) {
-                script->compiled = false;
+            if (update)
                 src_file = tmp_file;
-            } else {
+            else {
                 remove(tmp_file);
                 free(tmp_file);
                 tmp_file = NULL;
             }
         }
 
-        {
-            time_t src_mtime = util_file_mtime(script->src_file);
-            if (script->compiled) {
-                if (util_difftime_seconds(src_mtime, script->compile_time) > 0)
-                    return true;
-                else {
-                    // Script has been compiled succesfully, but then changed afterwards.
-                    // We try to recompile; if that fails we are left with 'nothing'.
-                }
+        uint64_t src_hash = workflow_source_hash(src_file);
+        if (script->compiled && src_hash == script->src_hash) {
+            // The source text - after applying the current context - is
+            // identical to what was compiled last time; reuse the
+            // compiled cmd list instead of reparsing the file.
+            if (tmp_file != NULL) {
+                remove(tmp_file);
+                free(tmp_file);
             }
+            return true;
         }
 
         {
@@ -116,20 +141,33 @@ bool workflow_try_compile(workflow_type *script,
 
                 if (config_content_is_valid(content)) {
                     int cmd_line;
+                    int parallel_group = -1;
+                    int next_group = 0;
                     for (cmd_line = 0;
                          cmd_line < config_content_get_size(content);
                          cmd_line++) {
                         const config_content_node_type *node =
                             config_content_iget_node(content, cmd_line);
                         const char *jobname = config_content_node_get_kw(node);
+                        if (strcmp(jobname, WORKFLOW_PARALLEL_KW) == 0) {
+                            parallel_group = next_group++;
+                            continue;
+                        }
+                        if (strcmp(jobname, WORKFLOW_SERIAL_KW) == 0) {
+                            parallel_group = -1;
+                            continue;
+                        }
                         const workflow_job_type *job =
                             workflow_joblist_get_job(script->joblist, jobname);
-                        cmd_type *cmd = cmd_alloc(
-                            job, config_content_node_get_stringlist(node));
+                        cmd_type *cmd =
+                            cmd_alloc(job,
+                                      config_content_node_get_stringlist(node),
+                                      parallel_group);
 
                         workflow_add_cmd(script, cmd);
                     }
                     script->compiled = true;
+                    script->src_hash = src_hash;
                 } else
                     workflow_store_error(script,
                                          config_content_get_errors(content));
@@ -155,18 +193,51 @@ bool workflow_run(workflow_type *workflow, void *self, bool verbose,
     vector_clear(workflow->stack);
     workflow_try_compile(workflow, context);
 
-    if (workflow->compiled) {
-        int icmd;
-        for (icmd = 0; icmd < vector_get_size(workflow->cmd_list); icmd++) {
-            const cmd_type *cmd =
-                (const cmd_type *)vector_iget_const(workflow->cmd_list, icmd);
+    if (!workflow->compiled)
+        return false;
+
+    int size = vector_get_size(workflow->cmd_list);
+    int icmd = 0;
+    while (icmd < size) {
+        const cmd_type *cmd =
+            (const cmd_type *)vector_iget_const(workflow->cmd_list, icmd);
+        int group_end = icmd + 1;
+        if (cmd->parallel_group >= 0)
+            while (group_end < size &&
+                   ((const cmd_type *)vector_iget_const(workflow->cmd_list,
+                                                        group_end))
+                           ->parallel_group == cmd->parallel_group)
+                group_end++;
+
+        if (group_end - icmd == 1) {
             void *return_value = workflow_job_run(cmd->workflow_job, self,
                                                   verbose, cmd->arglist);
             vector_push_front_ref(workflow->stack, return_value);
+        } else {
+            // The jobs of a PARALLEL group were declared mutually
+            // independent by the workflow author; run them on the
+            // shared pool and push their return values in file order,
+            // so the stack layout matches serial execution.
+            std::vector<void *> results(group_end - icmd);
+            std::vector<std::future<void>> futures;
+            for (int i = icmd; i < group_end; i++) {
+                const cmd_type *group_cmd =
+                    (const cmd_type *)vector_iget_const(workflow->cmd_list, i);
+                futures.push_back(ert::global_pool().submit(
+                    [&results, i, icmd, group_cmd, self, verbose] {
+                        results[i - icmd] =
+                            workflow_job_run(group_cmd->workflow_job, self,
+                                             verbose, group_cmd->arglist);
+                    }));
+            }
+            for (auto &future : futures)
+                future.get();
+            for (void *return_value : results)
+                vector_push_front_ref(workflow->stack, return_value);
         }
-        return true;
-    } else
-        return false;
+        icmd = group_end;
+    }
+    return true;
 }
 
 int workflow_get_stack_size(const workflow_type *workflow) {
@@ -189,6 +260,7 @@ workflow_type *workflow_alloc(const char *src_file,
     script->joblist = joblist;
     script->cmd_list = vector_alloc_new();
     script->compiled = false;
+    script->src_hash = 0;
     script->last_error = NULL;
     script->stack = vector_alloc_new();
 
@@ -235,6 +307,12 @@ stringlist_type *workflow_iget_arguments(const workflow_type *workflow,
     return cmd->arglist;
 }
 
+int workflow_iget_parallel_group(const workflow_type *workflow, int index) {
+    const cmd_type *cmd =
+        (const cmd_type *)vector_iget_const(workflow->cmd_list, index);
+    return cmd->parallel_group;
+}
+
 extern "C" PY_USED const char *
 worflow_get_src_file(const workflow_type *workflow) {
     return workflow->src_file;
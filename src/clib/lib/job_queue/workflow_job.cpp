@@ -6,6 +6,7 @@
 
 #include <ert/job_queue/job_kw_definitions.hpp>
 #include <ert/job_queue/workflow_job.hpp>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -230,9 +231,80 @@ static void workflow_job_validate(workflow_job_type *workflow_job) {
         workflow_job_validate_external(workflow_job);
 }
 
+static workflow_job_type *
+workflow_job_alloc_copy(const workflow_job_type *src) {
+    workflow_job_type *copy = workflow_job_alloc(src->name, src->internal);
+    copy->min_arg = src->min_arg;
+    copy->max_arg = src->max_arg;
+    int_vector_free(copy->arg_types);
+    copy->arg_types = int_vector_alloc_copy(src->arg_types);
+    copy->executable = util_alloc_string_copy(src->executable);
+    copy->internal_script_path =
+        util_alloc_string_copy(src->internal_script_path);
+    copy->function = util_alloc_string_copy(src->function);
+    copy->dl_func = src->dl_func;
+    copy->valid = src->valid;
+    return copy;
+}
+
+/**
+   Parsed job definitions are cached for the session, keyed on the
+   definition file and job name and invalidated when the file mtime
+   changes. A site installation has 100+ job definition files which
+   would otherwise be reparsed every time a joblist is built. The
+   cached instance is a prototype; the caller always gets a private
+   copy since joblists take ownership of the jobs they are given.
+*/
+struct workflow_job_cache_entry {
+    time_t mtime;
+    workflow_job_type *job;
+};
+
+static std::mutex workflow_job_cache_mutex;
+static std::unordered_map<std::string, workflow_job_cache_entry>
+    workflow_job_cache;
+
+static workflow_job_type *workflow_job_config_parse(const char *name,
+                                                    config_parser_type *config,
+                                                    const char *config_file);
+
 workflow_job_type *workflow_job_config_alloc(const char *name,
                                              config_parser_type *config,
                                              const char *config_file) {
+    char *abs_file = util_alloc_abs_path(config_file);
+    std::string cache_key = abs_file + "\n"s + name;
+    free(abs_file);
+    time_t mtime = util_file_mtime(config_file);
+
+    {
+        std::lock_guard guard{workflow_job_cache_mutex};
+        auto iter = workflow_job_cache.find(cache_key);
+        if (iter != workflow_job_cache.end()) {
+            if (iter->second.mtime == mtime)
+                return workflow_job_alloc_copy(iter->second.job);
+
+            workflow_job_free(iter->second.job);
+            workflow_job_cache.erase(iter);
+        }
+    }
+
+    workflow_job_type *workflow_job =
+        workflow_job_config_parse(name, config, config_file);
+    if (workflow_job != NULL) {
+        workflow_job_type *prototype = workflow_job_alloc_copy(workflow_job);
+        std::lock_guard guard{workflow_job_cache_mutex};
+        auto [iter, inserted] = workflow_job_cache.try_emplace(
+            cache_key, workflow_job_cache_entry{mtime, prototype});
+        if (!inserted)
+            // Another thread cached the same definition in the meantime.
+            workflow_job_free(prototype);
+    }
+    return workflow_job;
+}
+
+static workflow_job_type *workflow_job_config_parse(const char *name,
+                                                    config_parser_type *config,
+                                                    const char *config_file) {
     workflow_job_type *workflow_job = NULL;
     config_content_type *content =
         config_parse(config, config_file, "--", NULL, NULL, NULL,
@@ -298,6 +370,45 @@ workflow_job_type *workflow_job_config_alloc(const char *name,
     return workflow_job;
 }
 
+workflow_job_type *
+workflow_job_alloc_cached(const char *name, bool internal, int min_arg,
+                          int max_arg, const char *arg_types,
+                          const char *executable, const char *internal_script,
+                          const char *function) {
+    workflow_job_type *workflow_job = workflow_job_alloc(name, internal);
+    workflow_job_set_min_arg(workflow_job, min_arg);
+    workflow_job_set_max_arg(workflow_job, max_arg);
+
+    if (arg_types != NULL) {
+        int iarg = 0;
+        const char *cursor = arg_types;
+        char *end;
+        long type = strtol(cursor, &end, 10);
+        while (end != cursor) {
+            workflow_job_iset_argtype(workflow_job, iarg++,
+                                      (config_item_types)type);
+            cursor = end;
+            type = strtol(cursor, &end, 10);
+        }
+    }
+
+    if (function != NULL)
+        workflow_job_set_function(workflow_job, function);
+    if (executable != NULL)
+        workflow_job_set_executable(workflow_job, executable);
+    if (internal_script != NULL)
+        workflow_job_set_internal_script(workflow_job, internal_script);
+
+    // Revalidate against the current filesystem - the executable may
+    // have disappeared since the definition was cached.
+    workflow_job_validate(workflow_job);
+    if (!workflow_job->valid) {
+        workflow_job_free(workflow_job);
+        return NULL;
+    }
+    return workflow_job;
+}
+
 void workflow_job_free(workflow_job_type *workflow_job) {
     free(workflow_job->function);
     free(workflow_job->executable);
@@ -4,6 +4,7 @@
 
 #include <ert/config/config_parser.hpp>
 
+#include <ert/job_queue/workflow.hpp>
 #include <ert/job_queue/workflow_job.hpp>
 #include <ert/job_queue/workflow_joblist.hpp>
 
@@ -22,6 +23,19 @@ workflow_joblist_type *workflow_joblist_alloc() {
     joblist->workflow_compiler = config_alloc();
     joblist->joblist = hash_alloc();
 
+    // The PARALLEL / SERIAL group markers are part of the workflow
+    // language itself, not jobs; register them in the compiler schema
+    // so workflow files using them still parse.
+    {
+        config_schema_item_type *parallel = config_add_schema_item(
+            joblist->workflow_compiler, WORKFLOW_PARALLEL_KW, false);
+        config_schema_item_set_argc_minmax(parallel, 0, 0);
+
+        config_schema_item_type *serial = config_add_schema_item(
+            joblist->workflow_compiler, WORKFLOW_SERIAL_KW, false);
+        config_schema_item_set_argc_minmax(serial, 0, 0);
+    }
+
     return joblist;
 }
 
@@ -1,25 +1,13 @@
+#include <atomic>
+#include <vector>
+
+#include <ert/concurrency.hpp>
+
 #include <ert/enkf/enkf_config_node.hpp>
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/gen_data.hpp>
 #include <ert/python.hpp>
 
-namespace {
-std::vector<double> load_gen_data(enkf_config_node_type *config_node, int iens,
-                                  int report_step, enkf_fs_type *fs) {
-    enkf_node_type *work_node = enkf_node_alloc(config_node);
-    node_id_type node_id = {.report_step = report_step, .iens = iens};
-    enkf_node_load(work_node, fs, node_id);
-    const gen_data_type *node =
-        (const gen_data_type *)enkf_node_value_ptr(work_node);
-    std::vector<double> vector;
-    vector.resize(gen_data_get_size(node));
-    std::copy_n(gen_data_get_double_vector(node), gen_data_get_size(node),
-                vector.data());
-    enkf_node_free(work_node);
-    return vector;
-}
-} // namespace
-
 ERT_CLIB_SUBMODULE("enkf_fs_general_data", m) {
     m.def(
         "gendata_get_realizations",
@@ -28,26 +16,75 @@ ERT_CLIB_SUBMODULE("enkf_fs_general_data", m) {
             if (realizations.empty())
                 return py::array_t<double, 2>();
 
-            auto gen_data_data = load_gen_data(
-                config_node, realizations.front(), report_step, fs);
-            auto data_size = gen_data_data.size();
-            py::array_t<double, 2> array({data_size, realizations.size()});
+            // The first realization is loaded up front to establish
+            // the vector size and allocate the destination array; the
+            // remaining members are then loaded in parallel, each one
+            // written straight from the gen_data buffer into its
+            // column - no intermediate std::vector, so peak memory is
+            // the result array plus one realization per worker.
+            py::array_t<double, 2> array;
+            size_t data_size = 0;
+
+            {
+                enkf_node_type *work_node = enkf_node_alloc(config_node);
+                node_id_type node_id = {.report_step = report_step,
+                                        .iens = realizations[0]};
+                enkf_node_load(work_node, fs, node_id);
+                const gen_data_type *node =
+                    (const gen_data_type *)enkf_node_value_ptr(work_node);
+                data_size = gen_data_get_size(node);
+                array =
+                    py::array_t<double, 2>({data_size, realizations.size()});
+
+                auto data = array.mutable_unchecked();
+                const double *vector = gen_data_get_double_vector(node);
+                for (size_t data_index{}; data_index < data_size; ++data_index)
+                    data(data_index, 0) = vector[data_index];
+                enkf_node_free(work_node);
+            }
+
             auto data = array.mutable_unchecked();
 
-            for (size_t iens_index{}; iens_index < realizations.size();
-                 ++iens_index) {
-                if (iens_index > 0) {
-                    gen_data_data = load_gen_data(
-                        config_node, realizations[iens_index], report_step, fs);
-                    if (gen_data_data.size() != data_size) {
-                        throw py::value_error("GEN_DATA vector size mismatch");
+            // The workers only touch storage and the raw numpy buffer,
+            // so the GIL is released for the whole parallel section.
+            PyThreadState *state = nullptr;
+            if (PyGILState_Check() == 1)
+                state = PyEval_SaveThread();
+
+            std::atomic<bool> size_mismatch{false};
+            ert::global_pool().parallel_for(
+                realizations.size() - 1, 1, [&](size_t begin, size_t end) {
+                    for (size_t iens_index = begin + 1; iens_index < end + 1;
+                         ++iens_index) {
+                        enkf_node_type *work_node =
+                            enkf_node_alloc(config_node);
+                        node_id_type node_id = {
+                            .report_step = report_step,
+                            .iens = realizations[iens_index]};
+                        enkf_node_load(work_node, fs, node_id);
+                        const gen_data_type *node =
+                            (const gen_data_type *)enkf_node_value_ptr(
+                                work_node);
+                        if ((size_t)gen_data_get_size(node) != data_size)
+                            size_mismatch = true;
+                        else {
+                            const double *vector =
+                                gen_data_get_double_vector(node);
+                            for (size_t data_index{}; data_index < data_size;
+                                 ++data_index)
+                                data(data_index, iens_index) =
+                                    vector[data_index];
+                        }
+                        enkf_node_free(work_node);
                     }
-                }
+                });
+
+            if (state)
+                PyEval_RestoreThread(state);
+
+            if (size_mismatch)
+                throw py::value_error("GEN_DATA vector size mismatch");
 
-                for (size_t data_index{}; data_index < gen_data_data.size();
-                     ++data_index)
-                    data(data_index, iens_index) = gen_data_data[data_index];
-            }
             return array;
         },
         py::arg("config_node"), py::arg("realizations"), py::arg("storage"),
@@ -1,3 +1,8 @@
+#include <string>
+#include <vector>
+
+#include <ert/concurrency.hpp>
+
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/ensemble_config.hpp>
 #include <ert/enkf/gen_kw.hpp>
@@ -26,6 +31,16 @@ int get_keyword_index(const enkf_config_node_type *config_node,
     return result;
 }
 
+namespace {
+/** One requested dataframe column, resolved against the config up
+    front so the load workers only touch storage and the numpy buffer. */
+struct keyword_column {
+    const enkf_config_node_type *config_node;
+    int keyword_index;
+    bool use_log_scale;
+};
+} // namespace
+
 ERT_CLIB_SUBMODULE("enkf_fs_keyword_data", m) {
     m.def(
         "keyword_data_get_realizations",
@@ -35,9 +50,9 @@ ERT_CLIB_SUBMODULE("enkf_fs_keyword_data", m) {
             py::array_t<double, 2> array({realizations.size(), keys.size()});
             auto data = array.mutable_unchecked();
 
-            for (int key_index = 0; key_index < keys.size(); key_index++) {
-
-                auto key = keys.at(key_index);
+            std::vector<keyword_column> columns;
+            for (const auto &raw_key : keys) {
+                auto key = raw_key;
                 std::string keyword = "";
                 auto split = key.find(":");
                 if (split != std::string::npos) {
@@ -51,30 +66,56 @@ ERT_CLIB_SUBMODULE("enkf_fs_keyword_data", m) {
                     use_log_scale = true;
                 }
 
-                auto ensemble_config_node =
+                auto config_node =
                     ensemble_config_get_node(ensemble_config, key.c_str());
-                for (int realization_index = 0;
-                     realization_index < realizations.size();
-                     realization_index++) {
-                    int realization = realizations.at(realization_index);
-                    node_id_type node_id = {.report_step = 0,
-                                            .iens = realization};
-                    enkf_node_type *data_node =
-                        enkf_node_alloc(ensemble_config_node);
-                    double value = NAN;
-                    if (enkf_node_try_load(data_node, enkf_fs, node_id)) {
-                        const gen_kw_type *gen_kw =
-                            (const gen_kw_type *)enkf_node_value_ptr(data_node);
-                        auto index =
-                            get_keyword_index(ensemble_config_node, keyword);
-                        value = gen_kw_data_iget(gen_kw, index, true);
-                        if (use_log_scale)
-                            value = log10(value);
-                    }
-                    data(realization_index, key_index) = value;
-                    enkf_node_free(data_node);
-                }
+                columns.push_back({config_node,
+                                   get_keyword_index(config_node, keyword),
+                                   use_log_scale});
             }
+
+            // The reads are grouped per realization - all gen_kw keys
+            // of one realization live in the same storage file - and
+            // the realizations are loaded in parallel on the shared
+            // pool. The workers only touch the raw numpy buffer, so
+            // the GIL is released for the whole C++ section.
+            PyThreadState *state = nullptr;
+            if (PyGILState_Check() == 1)
+                state = PyEval_SaveThread();
+
+            ert::global_pool().parallel_for(
+                realizations.size(), 1, [&](size_t begin, size_t end) {
+                    for (size_t iens_index = begin; iens_index < end;
+                         ++iens_index) {
+                        node_id_type node_id = {
+                            .report_step = 0,
+                            .iens = realizations[iens_index]};
+                        for (size_t key_index = 0; key_index < columns.size();
+                             ++key_index) {
+                            const auto &column = columns[key_index];
+                            // Private node per load - the node buffer
+                            // can not be shared between threads.
+                            enkf_node_type *data_node =
+                                enkf_node_alloc(column.config_node);
+                            double value = NAN;
+                            if (enkf_node_try_load(data_node, enkf_fs,
+                                                   node_id)) {
+                                const gen_kw_type *gen_kw =
+                                    (const gen_kw_type *)enkf_node_value_ptr(
+                                        data_node);
+                                value = gen_kw_data_iget(
+                                    gen_kw, column.keyword_index, true);
+                                if (column.use_log_scale)
+                                    value = log10(value);
+                            }
+                            data(iens_index, key_index) = value;
+                            enkf_node_free(data_node);
+                        }
+                    }
+                });
+
+            if (state)
+                PyEval_RestoreThread(state);
+
             return array;
         },
         py::arg("config"), py::arg("fs"), py::arg("key"),
@@ -1,3 +1,7 @@
+#include <vector>
+
+#include <ert/concurrency.hpp>
+
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/ensemble_config.hpp>
 
@@ -12,25 +16,47 @@ ERT_CLIB_SUBMODULE("enkf_fs_summary_data", m) {
             py::array_t<double, 2> array(
                 {time_map_size * realizations.size(), summary_keys.size()});
             auto data = array.mutable_unchecked();
-            int summary_key_index = 0;
-            for (const auto &key : summary_keys) {
-                enkf_node_type *work_node = enkf_node_alloc(
+
+            std::vector<const enkf_config_node_type *> config_nodes;
+            for (const auto &key : summary_keys)
+                config_nodes.push_back(
                     ensemble_config_get_node(ensemble_config, key.c_str()));
 
-                for (size_t iens_index{}; iens_index < realizations.size();
-                     ++iens_index) {
-                    auto iens = realizations[iens_index];
-                    auto summary_vector =
-                        enkf_node_user_get_vector(work_node, fs, iens);
-                    for (int index = 1; index < summary_vector.size();
-                         ++index) {
-                        data(iens_index * time_map_size + (index - 1),
-                             summary_key_index) = summary_vector[index];
+            // The reads are grouped per realization - all keys of one
+            // realization live in the same storage file - and the
+            // realizations are loaded in parallel on the shared pool.
+            // The workers only touch the raw numpy buffer, so the GIL
+            // is released for the whole C++ section.
+            PyThreadState *state = nullptr;
+            if (PyGILState_Check() == 1)
+                state = PyEval_SaveThread();
+
+            ert::global_pool().parallel_for(
+                realizations.size(), 1, [&](size_t begin, size_t end) {
+                    for (size_t iens_index = begin; iens_index < end;
+                         ++iens_index) {
+                        auto iens = realizations[iens_index];
+                        for (size_t key_index = 0;
+                             key_index < config_nodes.size(); ++key_index) {
+                            // Step 0 is the initial state and is not
+                            // part of the time map; the windowed read
+                            // fetches exactly the steps that fit the
+                            // output rows.
+                            auto summary_vector =
+                                enkf_node_user_get_vector_window(
+                                    config_nodes[key_index], fs, iens, 1,
+                                    time_map_size);
+                            for (size_t index = 0;
+                                 index < summary_vector.size(); ++index)
+                                data(iens_index * time_map_size + index,
+                                     key_index) = summary_vector[index];
+                        }
                     }
-                }
-                summary_key_index++;
-                enkf_node_free(work_node);
-            }
+                });
+
+            if (state)
+                PyEval_RestoreThread(state);
+
             return array;
         },
         py::arg("ens_cfg"), py::arg("fs"), py::arg("summary_keys"),
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <ert/concurrency.hpp>
+
+#include <ert/enkf/enkf_node.hpp>
+#include <ert/enkf/ensemble_config.hpp>
+
+#include <ert/python.hpp>
+
+namespace {
+
+/**
+   Quantile with the same linear interpolation as pandas/numpy default:
+   the quantile sits at position q * (n - 1) in the sorted sample and
+   is interpolated between the two neighbouring order statistics. The
+   order statistics are found with nth_element, so the sample is only
+   partially sorted.
+*/
+double sample_quantile(std::vector<double> &sample, double fractile) {
+    size_t n = sample.size();
+    if (n == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    double position = fractile * (n - 1);
+    size_t below = static_cast<size_t>(position);
+    double weight = position - below;
+
+    std::nth_element(sample.begin(), sample.begin() + below, sample.end());
+    double value = sample[below];
+    if (weight > 0 && below + 1 < n) {
+        // nth_element left everything above 'below' greater-or-equal,
+        // so the next order statistic is the minimum of that tail.
+        double next =
+            *std::min_element(sample.begin() + below + 1, sample.end());
+        value += weight * (next - value);
+    }
+    return value;
+}
+
+} // namespace
+
+ERT_CLIB_SUBMODULE("enkf_fs_summary_statistics", m) {
+    m.def(
+        "get_summary_statistics",
+        [](Cwrap<ensemble_config_type> ensemble_config, Cwrap<enkf_fs_type> fs,
+           const std::vector<std::string> &summary_keys,
+           const std::vector<int> &realizations, const int time_map_size,
+           const std::vector<double> &fractiles) {
+            // Per key: min, max, mean followed by the requested
+            // fractiles, one value per time step.
+            size_t stat_count = 3 + fractiles.size();
+            py::array_t<double, 3> array(
+                {summary_keys.size(), stat_count, (size_t)time_map_size});
+            auto stats = array.mutable_unchecked();
+
+            std::vector<const enkf_config_node_type *> config_nodes;
+            for (const auto &key : summary_keys)
+                config_nodes.push_back(
+                    ensemble_config_get_node(ensemble_config, key.c_str()));
+
+            PyThreadState *state = nullptr;
+            if (PyGILState_Check() == 1)
+                state = PyEval_SaveThread();
+
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            // ensemble[key][step * realizations.size() + iens_index]
+            std::vector<std::vector<double>> ensemble(
+                summary_keys.size(),
+                std::vector<double>(time_map_size * realizations.size(), nan));
+
+            // Load phase: as in get_summary_data the reads are grouped
+            // per realization - all keys of one realization live in
+            // the same storage file - and run in parallel on the
+            // shared pool.
+            ert::global_pool().parallel_for(
+                realizations.size(), 1, [&](size_t begin, size_t end) {
+                    for (size_t iens_index = begin; iens_index < end;
+                         ++iens_index) {
+                        auto iens = realizations[iens_index];
+                        for (size_t key_index = 0;
+                             key_index < config_nodes.size(); ++key_index) {
+                            auto summary_vector =
+                                enkf_node_user_get_vector_window(
+                                    config_nodes[key_index], fs, iens, 1,
+                                    time_map_size);
+                            for (size_t step = 0;
+                                 step < summary_vector.size(); ++step)
+                                ensemble[key_index]
+                                        [step * realizations.size() +
+                                         iens_index] = summary_vector[step];
+                        }
+                    }
+                });
+
+            // Reduce phase: parallel across keys; each time step is a
+            // single pass for min/max/mean plus a partial sort per
+            // requested fractile. Members with no stored value (NaN)
+            // are skipped, matching DataFrame.quantile.
+            ert::global_pool().parallel_for(
+                summary_keys.size(), 1, [&](size_t begin, size_t end) {
+                    std::vector<double> sample;
+                    sample.reserve(realizations.size());
+                    for (size_t key_index = begin; key_index < end;
+                         ++key_index) {
+                        for (int step = 0; step < time_map_size; ++step) {
+                            sample.clear();
+                            double minimum = nan;
+                            double maximum = nan;
+                            double sum = 0;
+                            for (size_t iens_index = 0;
+                                 iens_index < realizations.size();
+                                 ++iens_index) {
+                                double value =
+                                    ensemble[key_index]
+                                            [step * realizations.size() +
+                                             iens_index];
+                                if (std::isnan(value))
+                                    continue;
+                                if (sample.empty()) {
+                                    minimum = value;
+                                    maximum = value;
+                                } else {
+                                    minimum = std::min(minimum, value);
+                                    maximum = std::max(maximum, value);
+                                }
+                                sum += value;
+                                sample.push_back(value);
+                            }
+                            stats(key_index, 0, step) = minimum;
+                            stats(key_index, 1, step) = maximum;
+                            stats(key_index, 2, step) =
+                                sample.empty() ? nan : sum / sample.size();
+                            for (size_t fractile_index = 0;
+                                 fractile_index < fractiles.size();
+                                 ++fractile_index)
+                                stats(key_index, 3 + fractile_index, step) =
+                                    sample_quantile(sample,
+                                                    fractiles[fractile_index]);
+                        }
+                    }
+                });
+
+            if (state)
+                PyEval_RestoreThread(state);
+
+            return array;
+        },
+        py::arg("ens_cfg"), py::arg("fs"), py::arg("summary_keys"),
+        py::arg("realizations"), py::arg("time_map_size"),
+        py::arg("fractiles"));
+}
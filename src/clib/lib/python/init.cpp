@@ -1,3 +1,5 @@
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <pybind11/pybind11.h>
@@ -14,6 +16,19 @@ auto &submodules() {
     static std::vector<ert::detail::Submodule *> submodules;
     return submodules;
 }
+
+/** Submodules whose bindings have not been defined yet, keyed on the
+    submodule path. The module objects themselves are created eagerly -
+    they must exist in sys.modules for 'from ert._clib.x import y' to
+    resolve - but the bindings are only defined on first attribute
+    access, so short CLI commands do not pay for binding code they
+    never touch. */
+auto &pending_submodules() {
+    static std::unordered_map<std::string,
+                              std::vector<ert::detail::Submodule *>>
+        pending;
+    return pending;
+}
 } // namespace
 
 ert::detail::Submodule::Submodule(const char *path, init_type &init)
@@ -34,7 +49,8 @@ PYBIND11_MODULE(_clib, m) {
         }
     });
 
-    /* Initialise submodules */
+    /* Create the submodule objects, deferring the binding definitions
+       to the first attribute access on each submodule. */
     for (auto submodule : submodules()) {
         py::module_ node = m;
         ert::split(submodule->path, '.', [&node](auto name) {
@@ -46,7 +62,27 @@ PYBIND11_MODULE(_clib, m) {
             }
         });
 
-        submodule->init(node);
+        std::string path{submodule->path};
+        pending_submodules()[path].push_back(submodule);
+        if (!node.attr("__dict__").contains("__getattr__"))
+            node.def("__getattr__",
+                     [path, node](const std::string &name) -> py::object {
+                         auto &pending = pending_submodules();
+                         auto iter = pending.find(path);
+                         if (iter != pending.end()) {
+                             auto to_init = std::move(iter->second);
+                             pending.erase(iter);
+                             for (auto pending_submodule : to_init)
+                                 pending_submodule->init(node);
+                             /* A missing name falls through to a second
+                                __getattr__ call, which now raises. */
+                             if (py::hasattr(node, name.c_str()))
+                                 return node.attr(name.c_str());
+                         }
+                         throw py::attribute_error(
+                             "module '" + path + "' has no attribute '" +
+                             name + "'");
+                     });
     }
 
     m.def(
@@ -1,3 +1,10 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
 #include <pybind11/pybind11.h>
@@ -20,22 +27,180 @@ class Logger : public ert::ILogger {
         py::object warning;
         py::object error;
         py::object critical;
+        py::object get_effective_level;
 
         interface(py::object logger);
     };
 
     std::unique_ptr<interface> m_interface;
 
+    /**
+     * Cached effective level of the Python logger (the numeric
+     * logging.DEBUG/INFO/... value), refreshed at most once per second
+     * from enabled(). Level checks in hot loops then cost two atomic
+     * loads instead of a GIL acquisition per message; a runtime level
+     * change (e.g. pytest's caplog) takes effect within a second.
+     */
+    std::atomic<int> m_effective_level{0};
+    std::atomic<int64_t> m_level_refresh{-1};
+
+    void refresh_effective_level();
+
 public:
     void init(const std::string &name);
 
     /** Called on Python shutdown to release the py::objects */
     void shutdown() { m_interface = nullptr; }
 
+    bool enabled(Level level) final;
+
+    /** Hand a formatted record to the Python logger; the caller must
+        hold the GIL. */
+    void emit(Level level, const std::string &payload);
+
 protected:
     void log(Level level, fmt::string_view f, fmt::format_args args) final;
 };
 
+/**
+ * Bridge between C++ producer threads and the Python logging module.
+ * Producers format their record (no GIL needed) and push it onto a
+ * bounded queue; a dedicated worker thread drains the queue in batches
+ * and forwards the records under the GIL. Logging from the parallel
+ * load/update paths is then a mutex-protected queue push instead of a
+ * stall behind whatever Python is doing.
+ *
+ * Threads that already hold the GIL bypass the queue and emit
+ * directly (see Logger::log) - forwarding is free for them, and the
+ * Python test suite keeps observing records synchronously. Records
+ * from GIL-holding and worker threads may therefore interleave, but
+ * each thread's own records stay ordered.
+ */
+class LogBridge {
+    struct record {
+        Logger *logger;
+        ert::ILogger::Level level;
+        std::string payload;
+    };
+
+    /** Bound on queued records; producers drop (and count) beyond
+        this rather than block. */
+    static constexpr size_t max_queue_size = 8192;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<record> m_queue;
+    bool m_running = false;
+    std::atomic<uint64_t> m_dropped{0};
+    std::thread m_worker;
+
+    void drain() {
+        std::unique_lock lock{m_mutex};
+        while (true) {
+            m_cv.wait(lock,
+                      [this] { return !m_queue.empty() || !m_running; });
+            if (m_queue.empty() && !m_running)
+                return;
+
+            std::deque<record> batch;
+            batch.swap(m_queue);
+            lock.unlock();
+
+            uint64_t dropped = m_dropped.exchange(0);
+            {
+                py::gil_scoped_acquire gil;
+                for (auto &rec : batch)
+                    rec.logger->emit(rec.level, rec.payload);
+                if (dropped > 0)
+                    batch.back().logger->emit(
+                        ert::ILogger::Level::warning,
+                        fmt::format("logging bridge dropped {} records "
+                                    "(queue full)",
+                                    dropped));
+            }
+            lock.lock();
+        }
+    }
+
+public:
+    static LogBridge &instance() {
+        static LogBridge bridge;
+        return bridge;
+    }
+
+    /** Normally the module cleanup has already joined the worker via
+        stop(); if the interpreter went away without running it, detach
+        rather than terminate on a joinable thread. */
+    ~LogBridge() {
+        if (m_worker.joinable()) {
+            {
+                std::lock_guard guard{m_mutex};
+                m_running = false;
+            }
+            m_cv.notify_all();
+            m_worker.detach();
+        }
+    }
+
+    void start() {
+        std::lock_guard guard{m_mutex};
+        if (m_running)
+            return;
+        m_running = true;
+        m_worker = std::thread([this] { this->drain(); });
+    }
+
+    /** Flush the queue and join the worker. Called with the GIL held
+        during module cleanup; the GIL is released while joining since
+        the worker needs it to forward the remaining records. */
+    void stop() {
+        {
+            std::lock_guard guard{m_mutex};
+            if (!m_running)
+                return;
+            m_running = false;
+        }
+        m_cv.notify_all();
+        py::gil_scoped_release release;
+        m_worker.join();
+    }
+
+    /** Queue one record; returns false when the bridge is not
+        running, in which case the caller forwards synchronously. */
+    bool enqueue(Logger *logger, ert::ILogger::Level level,
+                 const std::string &payload) {
+        {
+            std::lock_guard guard{m_mutex};
+            if (!m_running)
+                return false;
+            if (m_queue.size() >= max_queue_size) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            m_queue.push_back({logger, level, payload});
+        }
+        m_cv.notify_one();
+        return true;
+    }
+};
+
+/** The numeric value Python's logging module assigns to this level. */
+int python_level(ert::ILogger::Level level) {
+    switch (level) {
+    case ert::ILogger::Level::debug:
+        return 10;
+    case ert::ILogger::Level::info:
+        return 20;
+    case ert::ILogger::Level::warning:
+        return 30;
+    case ert::ILogger::Level::error:
+        return 40;
+    case ert::ILogger::Level::critical:
+        return 50;
+    }
+    return 0;
+}
+
 bool has_init_logging{};
 
 /*
@@ -59,7 +224,8 @@ auto &loggers() {
 Logger::interface::interface(py::object logger)
     : debug(logger.attr("debug")), info(logger.attr("info")),
       warning(logger.attr("warning")), error(logger.attr("error")),
-      critical(logger.attr("critical")) {}
+      critical(logger.attr("critical")),
+      get_effective_level(logger.attr("getEffectiveLevel")) {}
 
 void Logger::init(const std::string &name) {
     // Calling via cwrap does not acquire GIL, so do it now
@@ -72,19 +238,38 @@ void Logger::init(const std::string &name) {
         name.empty() ? LOGGER_NAMESPACE : LOGGER_NAMESPACE "."s + name;
     auto logger = get_logger(full_name);
     m_interface = std::make_unique<interface>(logger);
+    m_effective_level = m_interface->get_effective_level().cast<int>();
 }
 
-void Logger::log(Logger::Level level, fmt::string_view f,
-                 fmt::format_args args) {
+void Logger::refresh_effective_level() {
+    // Calling via cwrap does not acquire GIL, so do it now
+    py::gil_scoped_acquire gil;
+
+    if (m_interface)
+        m_effective_level = m_interface->get_effective_level().cast<int>();
+}
+
+bool Logger::enabled(Logger::Level level) {
     if (!m_interface) {
-        // Python has either not initalised us yet or has shut down. Drop logs.
-        return;
+        // Python has either not initalised us yet or has shut down -
+        // log() would drop the message anyway.
+        return false;
     }
 
-    // Calling via cwrap does not acquire GIL, so do it now
-    py::gil_scoped_acquire gil;
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+    if (m_level_refresh.exchange(now, std::memory_order_relaxed) != now)
+        this->refresh_effective_level();
+
+    return python_level(level) >=
+           m_effective_level.load(std::memory_order_relaxed);
+}
+
+void Logger::emit(Logger::Level level, const std::string &payload) {
+    if (!m_interface)
+        return;
 
-    auto payload = fmt::vformat(f, args);
     switch (level) {
     case Level::debug:
         m_interface->debug(payload);
@@ -104,6 +289,27 @@ void Logger::log(Logger::Level level, fmt::string_view f,
     }
 }
 
+void Logger::log(Logger::Level level, fmt::string_view f,
+                 fmt::format_args args) {
+    if (!m_interface) {
+        // Python has either not initalised us yet or has shut down. Drop logs.
+        return;
+    }
+
+    // Format on the producer - no GIL needed for this part.
+    auto payload = fmt::vformat(f, args);
+
+    // Threads without the GIL hand the record to the bridge; threads
+    // which already hold it forward directly for free.
+    if (!PyGILState_Check() &&
+        LogBridge::instance().enqueue(this, level, payload))
+        return;
+
+    // Calling via cwrap does not acquire GIL, so do it now
+    py::gil_scoped_acquire gil;
+    this->emit(level, payload);
+}
+
 /* Declare weak so it's possible to override in tests */
 [[gnu::weak]] std::shared_ptr<ert::ILogger>
 ert::get_logger(const std::string &name) {
@@ -128,6 +334,8 @@ ERT_CLIB_SUBMODULE("", m) {
         logger->init(name);
     }
 
+    LogBridge::instance().start();
+
     // For testing purposes, add a function which will log to all levels
     m.def("_test_logger", [](const std::string &str) {
         auto logger = ert::get_logger("_test_logger");
@@ -140,8 +348,10 @@ ERT_CLIB_SUBMODULE("", m) {
     });
 
     // Add a cleanup routine for when Python attemps to release the module
-    // during shutdown. Release the py::objects held by Logger.
+    // during shutdown. Flush the bridge while the Python loggers are
+    // still alive, then release the py::objects held by Logger.
     auto cleanup = [] {
+        LogBridge::instance().stop();
         has_init_logging = false;
         for (auto &[name, logger] : loggers()) {
             logger->shutdown();
@@ -0,0 +1,19 @@
+#include <ert/python.hpp>
+#include <ert/res_util/memory.hpp>
+#include <ert/res_util/metric.hpp>
+
+ERT_CLIB_SUBMODULE("metrics", m) {
+    m.def(
+        "dump_json", [] { return ert::metrics::registry().dump_json(); },
+        R"(All registered counters and histograms as a JSON string.
+
+Includes the per-mount block_fs I/O statistics
+("block_fs.<dir>.<mount>.{reads,writes,read_bytes,write_bytes,mmap_hits}"
+plus latency histograms), so a production run can report how many bytes
+a case read and wrote and at what latency.)");
+    m.def(
+        "memory_report_json", [] { return ert::utils::memory_report_json(); },
+        R"(The process memory peaks (max RSS / VmPeak) and the tagged
+allocation accounts as a JSON string, for the end-of-run performance
+report.)");
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <mutex>
@@ -7,20 +8,48 @@
 #include <vector>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <ert/except.hpp>
 #include <ert/python.hpp>
 
+#include <ert/res_util/arena.hpp>
 #include <ert/res_util/block_fs.hpp>
+#include <ert/res_util/crc32c.hpp>
+#include <ert/res_util/memory.hpp>
+#include <ert/res_util/metric.hpp>
 
 namespace fs = std::filesystem;
 
 #define MOUNT_MAP_MAGIC_INT 8861290
+#define INDEX_MAGIC_INT 8861291
+/* Version 2 added the node status to each entry so checksummed nodes
+   survive an index round-trip; version 1 indexes are rejected and the
+   mount falls back to a one-time scan. */
+static const int INDEX_VERSION = 2;
+
+/*
+   Nodes written with compression enabled carry this header in front of
+   the zlib stream inside the node data area:
+
+   |<COMPRESSED_MAGIC: Int><~COMPRESSED_MAGIC: Int><uncompressed_size: Int>|
+
+   Nodes without the header are returned as-is, so cases written before
+   compression was introduced (or with compression disabled) remain
+   readable, and a mixed file is fine.
+*/
+static const int COMPRESSED_MAGIC = 0x7A5F4C31;
+static const size_t COMPRESSED_HEADER_SIZE = 3 * sizeof(int);
+/** Nodes smaller than this are stored raw - the zlib overhead is not
+    worth it and tiny nodes are often already-compressed streams. */
+static const size_t COMPRESSION_MIN_SIZE = 512;
 
 /*
    These should be bitwise "smart" - so it is possible
@@ -38,12 +67,21 @@ static const int NODE_WRITE_ACTIVE_END = 776512;
 typedef enum {
     /** NODE_IN_USE_BYTE * ( 1 + 256 + 256**2 + 256**3) => Binary 01010101010101010101010101010101 */
     NODE_IN_USE = 1431655765,
+    /** A node carrying a CRC32C of its payload in the four bytes just
+        before the end tag. The first (little-endian) byte is
+        NODE_IN_USE_BYTE so the recovery scan finds these nodes with
+        the same byte-level search as plain NODE_IN_USE nodes. */
+    NODE_IN_USE_CSUM = 0x5A5A5A55,
     NODE_WRITE_ACTIVE = WRITE_START__,
     /** NODE_INVALID is no longer written to the file, but its kept for
      * backwards compatability */
     NODE_INVALID = 13
 } node_status_type;
 
+static bool node_status_in_use(int32_t status) {
+    return status == NODE_IN_USE || status == NODE_IN_USE_CSUM;
+}
+
 static inline void fseek__(FILE *stream, long int offset, int whence) {
     if (fseek(stream, offset, whence) != 0) {
         fprintf(stderr, "** Warning - seek:%ld failed %s(%d) \n", offset,
@@ -98,8 +136,12 @@ public:
         node_size = sizeof(Block::status) + sizeof(Block::node_size) +
                     sizeof(Block::data_size) + sizeof(NODE_END_TAG) +
                     sizeof(int) + filename_size + data_size;
+        if (has_checksum())
+            node_size += sizeof(uint32_t);
     }
 
+    bool has_checksum() const { return status == NODE_IN_USE_CSUM; }
+
     Block &operator=(const Block &) = default;
     Block &operator=(Block &&) = default;
 
@@ -120,7 +162,7 @@ public:
         node_status_type status;
         long int node_offset = ftell(stream);
         if (fread(&status, sizeof status, 1, stream) == 1) {
-            if (status == NODE_IN_USE) {
+            if (node_status_in_use(status)) {
                 int node_size;
                 *key = util_fread_realloc_string(*key, stream);
 
@@ -146,13 +188,25 @@ public:
             at_node.value().node_offset != node_offset)
             throw std::runtime_error("Block in file does not match index.");
         buffer_stream_fread(buffer, data_size, stream);
+        if (has_checksum()) {
+            uint32_t stored_crc;
+            if (fread(&stored_crc, sizeof stored_crc, 1, stream) != 1 ||
+                ert::utils::crc32c(buffer_get_data(buffer), data_size) !=
+                    stored_crc)
+                throw std::runtime_error(
+                    "Block checksum mismatch - stored node is corrupt.");
+        }
     }
 
     void write(const char *filename, FILE *data_stream, const void *ptr) {
         write_active_markers(data_stream);
         long data_offset = write_header(filename, data_stream);
-        if (status == NODE_IN_USE) {
+        if (node_status_in_use(status)) {
             write_data(data_stream, ptr, data_offset);
+            if (has_checksum()) {
+                uint32_t crc = ert::utils::crc32c(ptr, data_size);
+                util_fwrite(&crc, sizeof crc, 1, data_stream, __func__);
+            }
         }
         write_end_tag(data_stream);
     }
@@ -183,7 +237,7 @@ private:
             util_abort("%s: trying to write node with zero size \n", __func__);
         fseek__(stream, node_offset, SEEK_SET);
         util_fwrite_int(status, stream);
-        if (status == NODE_IN_USE)
+        if (node_status_in_use(status))
             util_fwrite_string(key, stream);
         util_fwrite_int(node_size, stream);
         util_fwrite_int(data_size, stream);
@@ -205,12 +259,45 @@ private:
           int32_t data_size)
         : node_offset(offset), node_size(node_size), data_size(data_size),
           status(status) {}
+
+    friend bool block_fs_load_index(block_fs_type *,
+                                    const std::filesystem::path &, int64_t);
+};
+
+/**
+   Per-mount I/O statistics, registered in the process-wide metrics
+   registry under "block_fs.<directory>.<mount name>". The counters are
+   attached once at mount time; sampling is a relaxed atomic add so the
+   instrumentation stays enabled in production runs.
+*/
+struct block_fs_io_stats {
+    ert::metrics::Counter *reads = nullptr;
+    ert::metrics::Counter *writes = nullptr;
+    ert::metrics::Counter *read_bytes = nullptr;
+    ert::metrics::Counter *write_bytes = nullptr;
+    /** Reads served straight from the shared mmap of the data file. */
+    ert::metrics::Counter *mmap_hits = nullptr;
+    ert::metrics::Histogram *read_ns = nullptr;
+    ert::metrics::Histogram *write_ns = nullptr;
+
+    void attach(const std::string &prefix) {
+        auto &registry = ert::metrics::registry();
+        reads = &registry.counter(prefix + ".reads");
+        writes = &registry.counter(prefix + ".writes");
+        read_bytes = &registry.counter(prefix + ".read_bytes");
+        write_bytes = &registry.counter(prefix + ".write_bytes");
+        mmap_hits = &registry.counter(prefix + ".mmap_hits");
+        read_ns = &registry.histogram(prefix + ".read_ns");
+        write_ns = &registry.histogram(prefix + ".write_ns");
+    }
 };
 
 struct block_fs_struct {
     int data_fd;
     FILE *data_stream;
 
+    block_fs_io_stats stats;
+
     std::mutex mutex;
 
     std::unordered_map<std::string, Block> index;
@@ -219,17 +306,47 @@ struct block_fs_struct {
     bool data_owner;
     /** 0: never  n: every nth iteration. */
     int fsync_interval;
+    /** Compress node data (when it shrinks) before writing. */
+    bool compression;
+    /** Write nodes with a trailing CRC32C of the payload; nodes of
+        both formats are always accepted on read. */
+    bool checksum;
+
+    /** Sidecar file holding the persisted index; written on close and
+        validated against the data file length on mount. */
+    fs::path index_file;
+    /** Path of the data file; needed to rewrite it during compaction. */
+    fs::path data_file;
+
+    /** Read-only mappings of the data file; the last entry is the most
+        recent (and largest) one. Nodes are only ever appended, so a
+        block which is fully covered by a mapping is immutable and can
+        be read without holding the mutex. Older, shorter mappings are
+        kept alive until close so readers never race a munmap(). */
+    std::vector<std::pair<const char *, size_t>> mappings;
 };
 
 static inline void block_fs_fseek(block_fs_type *block_fs, long offset) {
     fseek__(block_fs->data_stream, offset, SEEK_SET);
 }
 
+static std::string block_fs_stats_prefix(const fs::path &mount_file) {
+    std::string dir = mount_file.parent_path().filename().string();
+    std::string name = mount_file.stem().string();
+    if (dir.empty())
+        return "block_fs." + name;
+    return "block_fs." + dir + "." + name;
+}
+
 static block_fs_type *block_fs_alloc_empty(const fs::path &mount_file,
-                                           int fsync_interval, bool read_only) {
+                                           int fsync_interval, bool read_only,
+                                           bool compression, bool checksum) {
     block_fs_type *block_fs = new block_fs_type;
 
     block_fs->fsync_interval = fsync_interval;
+    block_fs->compression = compression;
+    block_fs->checksum = checksum;
+    block_fs->stats.attach(block_fs_stats_prefix(mount_file));
 
     FILE *stream = util_fopen(mount_file.c_str(), "r");
     int id = util_fread_int(stream);
@@ -287,7 +404,7 @@ static bool block_fs_fseek_valid_node(block_fs_type *block_fs) {
                 fseek__(block_fs->data_stream, -1, SEEK_CUR);
                 if (fread(&status, sizeof status, 1, block_fs->data_stream) ==
                     1) {
-                    if (status == NODE_IN_USE) {
+                    if (node_status_in_use(status)) {
                         // OK - we have found a valid identifier. We reposition
                         // to the start of this valid status id and return
                         // true.
@@ -339,6 +456,102 @@ static void block_fs_open_data(block_fs_type *block_fs,
         block_fs->data_fd = fileno(block_fs->data_stream);
 }
 
+/**
+   Load the index from the sidecar file written by a previous clean
+   close. The stored data-file length acts as the staleness check: if
+   the data file was written (or truncated) after the index was
+   persisted the lengths differ and the caller falls back to scanning.
+*/
+bool block_fs_load_index(block_fs_type *block_fs, const fs::path &index_file,
+                         int64_t data_size) {
+    if (!fs::exists(index_file))
+        return false;
+
+    FILE *stream = fopen(index_file.c_str(), "r");
+    if (stream == nullptr)
+        return false;
+
+    bool valid = false;
+    int magic = 0;
+    int version = 0;
+    int64_t stored_data_size = 0;
+    int num_entries = 0;
+    if (fread(&magic, sizeof magic, 1, stream) == 1 &&
+        fread(&version, sizeof version, 1, stream) == 1 &&
+        fread(&stored_data_size, sizeof stored_data_size, 1, stream) == 1 &&
+        fread(&num_entries, sizeof num_entries, 1, stream) == 1 &&
+        magic == INDEX_MAGIC_INT && version == INDEX_VERSION &&
+        stored_data_size == data_size && num_entries >= 0) {
+        valid = true;
+        for (int i = 0; i < num_entries; i++) {
+            char *key = util_fread_alloc_string(stream);
+            int32_t status;
+            int64_t node_offset;
+            int32_t node_size;
+            int32_t block_data_size;
+            if (key == nullptr ||
+                fread(&status, sizeof status, 1, stream) != 1 ||
+                fread(&node_offset, sizeof node_offset, 1, stream) != 1 ||
+                fread(&node_size, sizeof node_size, 1, stream) != 1 ||
+                fread(&block_data_size, sizeof block_data_size, 1, stream) !=
+                    1 ||
+                !node_status_in_use(status)) {
+                free(key);
+                valid = false;
+                break;
+            }
+            block_fs->index[key] =
+                Block{static_cast<node_status_type>(status), node_offset,
+                      node_size, block_data_size};
+            free(key);
+        }
+    }
+    fclose(stream);
+
+    if (!valid)
+        block_fs->index.clear();
+    return valid;
+}
+
+/**
+   Persist the index to the sidecar file; written via a temporary file
+   and rename() so readers never observe a half-written index.
+*/
+static void block_fs_fwrite_index(block_fs_type *block_fs) {
+    if (block_fs->index_file.empty() || block_fs->data_fd < 0)
+        return;
+
+    struct stat file_stat;
+    if (fstat(block_fs->data_fd, &file_stat) != 0)
+        return;
+
+    fs::path tmp_file = block_fs->index_file;
+    tmp_file += ".tmp";
+    FILE *stream = fopen(tmp_file.c_str(), "w");
+    if (stream == nullptr)
+        return;
+
+    int64_t data_size = file_stat.st_size;
+    int num_entries = block_fs->index.size();
+    util_fwrite_int(INDEX_MAGIC_INT, stream);
+    util_fwrite_int(INDEX_VERSION, stream);
+    fwrite(&data_size, sizeof data_size, 1, stream);
+    fwrite(&num_entries, sizeof num_entries, 1, stream);
+    for (const auto &[key, block] : block_fs->index) {
+        util_fwrite_string(key.c_str(), stream);
+        fwrite(&block.status, sizeof block.status, 1, stream);
+        fwrite(&block.node_offset, sizeof block.node_offset, 1, stream);
+        fwrite(&block.node_size, sizeof block.node_size, 1, stream);
+        fwrite(&block.data_size, sizeof block.data_size, 1, stream);
+    }
+    fclose(stream);
+
+    std::error_code ec;
+    fs::rename(tmp_file, block_fs->index_file, ec);
+    if (ec)
+        fs::remove(tmp_file, ec);
+}
+
 static void block_fs_build_index(block_fs_type *block_fs,
                                  const fs::path &data_file) {
     char *filename = NULL;
@@ -367,7 +580,7 @@ static void block_fs_build_index(block_fs_type *block_fs,
         } else {
             if (block->verify_end_tag(block_fs->data_stream)) {
                 block_fs_fseek_node_end(block_fs, *block);
-                if (block->status == NODE_IN_USE) {
+                if (node_status_in_use(block->status)) {
                     block_fs->index[filename] = *block;
                 } else {
                     util_abort("%s: node status flag:%d not recognized - "
@@ -397,8 +610,12 @@ static bool block_fs_is_readonly(const block_fs_type *bfs) {
         return true;
 }
 
+static std::pair<const char *, size_t>
+block_fs_get_mapping(block_fs_type *block_fs, size_t required_size);
+
 block_fs_type *block_fs_mount(const fs::path &mount_file, int fsync_interval,
-                              bool read_only) {
+                              bool read_only, bool compression,
+                              bool checksum) {
     fs::path path = mount_file.parent_path();
     std::string base_name = mount_file.stem();
     auto data_file = path / (base_name + ".data_0");
@@ -409,22 +626,59 @@ block_fs_type *block_fs_mount(const fs::path &mount_file, int fsync_interval,
         /* This is a brand new filesystem - create the mount map first. */
         block_fs_fwrite_mount_info(mount_file);
 
-    block_fs = block_fs_alloc_empty(mount_file, fsync_interval, read_only);
+    block_fs = block_fs_alloc_empty(mount_file, fsync_interval, read_only,
+                                    compression, checksum);
 
+    block_fs->index_file = index_file;
+    block_fs->data_file = data_file;
     block_fs_open_data(block_fs, data_file);
     if (block_fs->data_stream != nullptr) {
-        std::error_code ec;
-        fs::remove(index_file, ec /* error code is ignored */);
-        block_fs_build_index(block_fs, data_file);
+        struct stat file_stat;
+        int64_t data_size = 0;
+        if (fstat(block_fs->data_fd, &file_stat) == 0)
+            data_size = file_stat.st_size;
+
+        if (!block_fs_load_index(block_fs, index_file, data_size)) {
+            /* Stale or missing sidecar index - fall back to scanning
+               the data file and drop the stale file. */
+            std::error_code ec;
+            fs::remove(index_file, ec /* error code is ignored */);
+            block_fs_build_index(block_fs, data_file);
+        }
+
+        /* A read-only mount never grows: map the whole data file up
+           front so the index and the mapping are both immutable and
+           the read path runs without touching the mutex at all. */
+        if (block_fs_is_readonly(block_fs))
+            block_fs_get_mapping(block_fs, data_size);
     }
     return block_fs;
 }
 
 bool block_fs_has_file(block_fs_type *block_fs, const char *filename) {
+    /* The index of a read-only mount is immutable after mounting. */
+    if (block_fs_is_readonly(block_fs))
+        return block_fs->index.count(filename) > 0;
+
     std::lock_guard guard{block_fs->mutex};
     return block_fs->index.count(filename) > 0;
 }
 
+void block_fs_stats(block_fs_type *block_fs, size_t *num_files,
+                    size_t *data_bytes) {
+    struct stat st;
+    if (block_fs_is_readonly(block_fs)) {
+        *num_files = block_fs->index.size();
+    } else {
+        std::lock_guard guard{block_fs->mutex};
+        *num_files = block_fs->index.size();
+    }
+    if (fstat(block_fs->data_fd, &st) == 0)
+        *data_bytes = st.st_size;
+    else
+        *data_bytes = 0;
+}
+
 void block_fs_fsync(block_fs_type *block_fs) {
     if (!block_fs_is_readonly(block_fs)) {
         fsync(block_fs->data_fd);
@@ -437,14 +691,14 @@ static int64_t block_fs_get_end(block_fs_type *block_fs) {
     return ftell(block_fs->data_stream);
 }
 
-void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
-                          const void *ptr, size_t data_size) {
-    if (block_fs_is_readonly(block_fs))
-        throw std::runtime_error("tried to write to read only filesystem");
+static void block_fs_fwrite_file__(block_fs_type *block_fs,
+                                   const char *filename, const void *ptr,
+                                   size_t data_size) {
     std::lock_guard guard{block_fs->mutex};
 
-    Block block{NODE_IN_USE, block_fs_get_end(block_fs),
-                static_cast<int32_t>(data_size), filename};
+    Block block{block_fs->checksum ? NODE_IN_USE_CSUM : NODE_IN_USE,
+                block_fs_get_end(block_fs), static_cast<int32_t>(data_size),
+                filename};
     block.write(filename, block_fs->data_stream, ptr);
 
     block_fs->write_count++;
@@ -455,25 +709,497 @@ void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
     block_fs->index[filename] = block;
 }
 
+void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
+                          const void *ptr, size_t data_size) {
+    if (block_fs_is_readonly(block_fs))
+        throw std::runtime_error("tried to write to read only filesystem");
+
+    /* Logical bytes, i.e. before any compression. */
+    block_fs->stats.writes->add();
+    block_fs->stats.write_bytes->add(data_size);
+    ert::metrics::ScopedTimer timer(*block_fs->stats.write_ns);
+
+    if (block_fs->compression && data_size >= COMPRESSION_MIN_SIZE) {
+        buffer_type *compressed = buffer_alloc(COMPRESSED_HEADER_SIZE);
+        buffer_fwrite_int(compressed, COMPRESSED_MAGIC);
+        buffer_fwrite_int(compressed, ~COMPRESSED_MAGIC);
+        buffer_fwrite_int(compressed, static_cast<int>(data_size));
+        buffer_fwrite_compressed(compressed, ptr, data_size);
+        /* Only store compressed when it actually shrinks the node. */
+        if (buffer_get_size(compressed) < data_size) {
+            block_fs_fwrite_file__(block_fs, filename,
+                                   buffer_get_data(compressed),
+                                   buffer_get_size(compressed));
+            buffer_free(compressed);
+            return;
+        }
+        buffer_free(compressed);
+    }
+    block_fs_fwrite_file__(block_fs, filename, ptr, data_size);
+}
+
 void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                             const buffer_type *buffer) {
     block_fs_fwrite_file(block_fs, filename, buffer_get_data(buffer),
                          buffer_get_size(buffer));
 }
 
+/**
+   Return a read-only mapping of the data file which covers at least
+   [0, required_size). Must be called with the mutex held. Buffered
+   writes are flushed before growing the mapping so appended nodes are
+   visible; returns {nullptr, 0} if the file can not be mapped.
+*/
+static std::pair<const char *, size_t>
+block_fs_get_mapping(block_fs_type *block_fs, size_t required_size) {
+    if (!block_fs->mappings.empty() &&
+        block_fs->mappings.back().second >= required_size)
+        return block_fs->mappings.back();
+
+    if (block_fs->data_fd < 0)
+        return {nullptr, 0};
+
+    if (block_fs->data_stream != nullptr)
+        fflush(block_fs->data_stream);
+
+    struct stat file_stat;
+    if (fstat(block_fs->data_fd, &file_stat) != 0 ||
+        static_cast<size_t>(file_stat.st_size) < required_size)
+        return {nullptr, 0};
+
+    void *addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED,
+                      block_fs->data_fd, 0);
+    if (addr == MAP_FAILED)
+        return {nullptr, 0};
+
+    block_fs->mappings.emplace_back(static_cast<const char *>(addr),
+                                    static_cast<size_t>(file_stat.st_size));
+    ert::utils::memory_account("block_fs.mmap").allocate(file_stat.st_size);
+    return block_fs->mappings.back();
+}
+
+/** True if the node data starts with the compressed-node header. */
+static bool block_fs_node_is_compressed(const char *data, size_t size) {
+    if (size < COMPRESSED_HEADER_SIZE)
+        return false;
+    int magic;
+    int check;
+    memcpy(&magic, data, sizeof magic);
+    memcpy(&check, data + sizeof magic, sizeof check);
+    return magic == COMPRESSED_MAGIC && check == ~COMPRESSED_MAGIC;
+}
+
+/**
+   If the buffer starts with the compressed-node header the zlib stream
+   is expanded in place; nodes without the header are left untouched.
+*/
+static void block_fs_maybe_uncompress(buffer_type *buffer) {
+    const char *data = static_cast<const char *>(buffer_get_data(buffer));
+    if (!block_fs_node_is_compressed(data, buffer_get_size(buffer)))
+        return;
+
+    int uncompressed_size;
+    memcpy(&uncompressed_size, data + 2 * sizeof(int),
+           sizeof uncompressed_size);
+
+    std::vector<char> uncompressed(uncompressed_size);
+    buffer_fskip(buffer, COMPRESSED_HEADER_SIZE);
+    buffer_fread_compressed(buffer, buffer_get_remaining_size(buffer),
+                            uncompressed.data(), uncompressed.size());
+    buffer_clear(buffer);
+    buffer_fwrite(buffer, uncompressed.data(), 1, uncompressed.size());
+    buffer_rewind(buffer);
+}
+
+/**
+   Copy a block from the mapping into the buffer; returns false if the
+   node fails the in-use/end-tag verification (or there is no mapping)
+   and the caller should fall back to the FILE* path.
+*/
+static bool block_fs_read_from_mapping(const Block &block,
+                                       std::pair<const char *, size_t> mapping,
+                                       buffer_type *buffer) {
+    if (mapping.first == nullptr ||
+        static_cast<size_t>(block.node_offset) + block.node_size >
+            mapping.second)
+        return false;
+
+    const char *node = mapping.first + block.node_offset;
+    int32_t status;
+    int32_t end_tag;
+    memcpy(&status, node, sizeof status);
+    memcpy(&end_tag, node + block.node_size - sizeof NODE_END_TAG,
+           sizeof end_tag);
+    if (!node_status_in_use(status) || end_tag != NODE_END_TAG)
+        return false;
+
+    size_t checksum_size = block.has_checksum() ? sizeof(uint32_t) : 0;
+    const char *data = node + block.node_size - sizeof NODE_END_TAG -
+                       checksum_size - block.data_size;
+    if (block.has_checksum()) {
+        uint32_t stored_crc;
+        memcpy(&stored_crc, data + block.data_size, sizeof stored_crc);
+        if (ert::utils::crc32c(data, block.data_size) != stored_crc)
+            return false;
+    }
+    buffer_clear(buffer);
+    buffer_fwrite(buffer, data, 1, block.data_size);
+    buffer_rewind(buffer); /* Setting: pos = 0; */
+    block_fs_maybe_uncompress(buffer);
+    return true;
+}
+
 /**
    Reads the full content of 'filename' into the buffer.
+
+   The fast path copies the node straight out of a shared read-only
+   mapping of the data file: the mutex is only held while looking up
+   the block and (rarely) growing the mapping, so concurrent readers do
+   not serialize on each other and there is no seek/read syscall per
+   node. The FILE* based path is kept as fallback for unmappable files
+   and nodes which fail verification.
 */
-void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
-                                   const char *filename, buffer_type *buffer) {
+/**
+   Look up the block for @filename together with a mapping that covers
+   it. On a read-only mount the index and the (whole file) mapping are
+   both immutable after mounting, so the lookup runs without locking;
+   writable mounts take the mutex and may have to grow the mapping.
+*/
+static std::pair<Block, std::pair<const char *, size_t>>
+block_fs_lookup_block(block_fs_type *block_fs, const char *filename) {
+    if (block_fs_is_readonly(block_fs)) {
+        std::pair<const char *, size_t> mapping{nullptr, 0};
+        if (!block_fs->mappings.empty())
+            mapping = block_fs->mappings.back();
+        return {block_fs->index.at(filename), mapping};
+    }
+
     std::lock_guard guard{block_fs->mutex};
-    Block &block = block_fs->index.at(filename);
+    Block block = block_fs->index.at(filename);
+    return {block,
+            block_fs_get_mapping(block_fs, static_cast<size_t>(
+                                               block.node_offset) +
+                                               block.node_size)};
+}
 
-    buffer_clear(buffer); /* Setting: content_size = 0; pos = 0;  */
+static void block_fs_fread_realloc_buffer__(block_fs_type *block_fs,
+                                            const char *filename,
+                                            buffer_type *buffer) {
+    auto [block, mapping] = block_fs_lookup_block(block_fs, filename);
 
-    block.read_data(block_fs->data_stream, buffer);
+    if (block_fs_read_from_mapping(block, mapping, buffer)) {
+        block_fs->stats.mmap_hits->add();
+        return;
+    }
 
+    buffer_clear(buffer); /* Setting: content_size = 0; pos = 0;  */
+    {
+        std::lock_guard guard{block_fs->mutex};
+        block_fs->index.at(filename).read_data(block_fs->data_stream, buffer);
+    }
     buffer_rewind(buffer); /* Setting: pos = 0; */
+    block_fs_maybe_uncompress(buffer);
+}
+
+/**
+   Hint the kernel that 'filename' is about to be read: the extent of
+   the node in the data file is handed to posix_fadvise(WILLNEED),
+   which starts readahead in the background and returns immediately.
+   Unknown files are silently ignored - prefetching is purely advisory.
+*/
+void block_fs_prefetch(block_fs_type *block_fs, const char *filename) {
+#ifdef POSIX_FADV_WILLNEED
+    Block block;
+    if (block_fs_is_readonly(block_fs)) {
+        auto iter = block_fs->index.find(filename);
+        if (iter == block_fs->index.end())
+            return;
+        block = iter->second;
+    } else {
+        std::lock_guard guard{block_fs->mutex};
+        auto iter = block_fs->index.find(filename);
+        if (iter == block_fs->index.end())
+            return;
+        block = iter->second;
+    }
+    posix_fadvise(block_fs->data_fd, block.node_offset, block.node_size,
+                  POSIX_FADV_WILLNEED);
+#endif
+}
+
+void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
+                                   const char *filename, buffer_type *buffer) {
+    block_fs->stats.reads->add();
+    ert::metrics::ScopedTimer timer(*block_fs->stats.read_ns);
+    block_fs_fread_realloc_buffer__(block_fs, filename, buffer);
+    block_fs->stats.read_bytes->add(buffer_get_size(buffer));
+}
+
+/**
+   Zero-copy variant of block_fs_fread_realloc_buffer: when the node is
+   stored uncompressed and the data file can be mapped, the view simply
+   borrows the bytes from the shared read-only mapping. The data file
+   is append-only and mappings are kept alive until block_fs_close(),
+   so the borrowed pointer stays valid even if the node is overwritten
+   later. Compressed nodes and unmappable files are copied (and
+   expanded) into the scratch arena of the calling thread instead.
+*/
+void block_fs_fread_view(block_fs_type *block_fs, const char *filename,
+                         block_fs_view &view) {
+    block_fs->stats.reads->add();
+    ert::metrics::ScopedTimer timer(*block_fs->stats.read_ns);
+
+    auto [block, mapping] = block_fs_lookup_block(block_fs, filename);
+
+    if (mapping.first != nullptr &&
+        static_cast<size_t>(block.node_offset) + block.node_size <=
+            mapping.second) {
+        const char *node = mapping.first + block.node_offset;
+        int32_t status;
+        int32_t end_tag;
+        memcpy(&status, node, sizeof status);
+        memcpy(&end_tag, node + block.node_size - sizeof NODE_END_TAG,
+               sizeof end_tag);
+        if (node_status_in_use(status) && end_tag == NODE_END_TAG) {
+            size_t checksum_size =
+                block.has_checksum() ? sizeof(uint32_t) : 0;
+            const char *data = node + block.node_size - sizeof NODE_END_TAG -
+                               checksum_size - block.data_size;
+            uint32_t stored_crc = 0;
+            if (block.has_checksum())
+                memcpy(&stored_crc, data + block.data_size, sizeof stored_crc);
+            if (!block_fs_node_is_compressed(data, block.data_size) &&
+                (!block.has_checksum() ||
+                 ert::utils::crc32c(data, block.data_size) == stored_crc)) {
+                view.data = data;
+                view.size = block.data_size;
+                block_fs->stats.mmap_hits->add();
+                block_fs->stats.read_bytes->add(view.size);
+                return;
+            }
+        }
+    }
+
+    buffer_type *buffer = buffer_alloc(block.data_size);
+    block_fs_fread_realloc_buffer__(block_fs, filename, buffer);
+    size_t size = buffer_get_size(buffer);
+    char *copy = ert::utils::thread_arena().allocate_array<char>(size);
+    memcpy(copy, buffer_get_data(buffer), size);
+    view.data = copy;
+    view.size = size;
+    block_fs->stats.read_bytes->add(size);
+    buffer_free(buffer);
+}
+
+/**
+   Ranged read: copies the byte window [offset, offset + count) of the
+   stored node into the buffer - clamped to the node - and returns the
+   total node size so the caller can tell how much was skipped. On the
+   mapped fast path only the requested window is touched, so reading a
+   small slice of a large node never faults in the rest of it.
+   Compressed nodes and unmappable data files fall back to reading the
+   whole node and slicing the window out afterwards.
+*/
+size_t block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                            size_t offset, size_t count, buffer_type *buffer) {
+    block_fs->stats.reads->add();
+    ert::metrics::ScopedTimer timer(*block_fs->stats.read_ns);
+
+    auto [block, mapping] = block_fs_lookup_block(block_fs, filename);
+
+    if (mapping.first != nullptr &&
+        static_cast<size_t>(block.node_offset) + block.node_size <=
+            mapping.second) {
+        const char *node = mapping.first + block.node_offset;
+        int32_t status;
+        int32_t end_tag;
+        memcpy(&status, node, sizeof status);
+        memcpy(&end_tag, node + block.node_size - sizeof NODE_END_TAG,
+               sizeof end_tag);
+        if (node_status_in_use(status) && end_tag == NODE_END_TAG) {
+            /* The point of the windowed read is touching only the
+               requested slice, so the checksum - which would fault in
+               the whole node - is not verified here; the end tag check
+               above still catches torn writes. */
+            size_t checksum_size =
+                block.has_checksum() ? sizeof(uint32_t) : 0;
+            const char *data = node + block.node_size - sizeof NODE_END_TAG -
+                               checksum_size - block.data_size;
+            if (!block_fs_node_is_compressed(data, block.data_size)) {
+                size_t total_size = block.data_size;
+                buffer_clear(buffer);
+                if (offset < total_size)
+                    buffer_fwrite(buffer, data + offset, 1,
+                                  std::min(count, total_size - offset));
+                buffer_rewind(buffer);
+                block_fs->stats.mmap_hits->add();
+                block_fs->stats.read_bytes->add(buffer_get_size(buffer));
+                return total_size;
+            }
+        }
+    }
+
+    buffer_type *full = buffer_alloc(block.data_size);
+    block_fs_fread_realloc_buffer__(block_fs, filename, full);
+    size_t total_size = buffer_get_size(full);
+    buffer_clear(buffer);
+    if (offset < total_size)
+        buffer_fwrite(buffer,
+                      static_cast<const char *>(buffer_get_data(full)) + offset,
+                      1, std::min(count, total_size - offset));
+    buffer_rewind(buffer);
+    block_fs->stats.read_bytes->add(buffer_get_size(buffer));
+    buffer_free(full);
+    return total_size;
+}
+
+/**
+   Batched variant of block_fs_fread_realloc_buffer: all blocks are
+   resolved under a single lock acquisition and then read in increasing
+   file-offset order, turning a pile of random per-node reads into one
+   sequential sweep over the data file.
+*/
+void block_fs_fread_files(
+    block_fs_type *block_fs,
+    std::vector<std::pair<std::string, buffer_type *>> &requests) {
+    /* One latency sample covers the whole sweep; the counters still
+       count individual nodes. */
+    block_fs->stats.reads->add(requests.size());
+    ert::metrics::ScopedTimer timer(*block_fs->stats.read_ns);
+
+    struct Resolved {
+        Block block;
+        buffer_type *buffer;
+    };
+    std::vector<Resolved> resolved;
+    resolved.reserve(requests.size());
+
+    std::pair<const char *, size_t> mapping{nullptr, 0};
+    if (block_fs_is_readonly(block_fs)) {
+        for (auto &[filename, buffer] : requests)
+            resolved.push_back({block_fs->index.at(filename), buffer});
+        if (!block_fs->mappings.empty())
+            mapping = block_fs->mappings.back();
+    } else {
+        std::lock_guard guard{block_fs->mutex};
+        size_t required_size = 0;
+        for (auto &[filename, buffer] : requests) {
+            const Block &block = block_fs->index.at(filename);
+            resolved.push_back({block, buffer});
+            required_size = std::max(
+                required_size,
+                static_cast<size_t>(block.node_offset) + block.node_size);
+        }
+        mapping = block_fs_get_mapping(block_fs, required_size);
+    }
+
+    std::sort(resolved.begin(), resolved.end(),
+              [](const Resolved &a, const Resolved &b) {
+                  return a.block.node_offset < b.block.node_offset;
+              });
+
+    for (auto &request : resolved) {
+        if (block_fs_read_from_mapping(request.block, mapping,
+                                       request.buffer)) {
+            block_fs->stats.mmap_hits->add();
+            block_fs->stats.read_bytes->add(buffer_get_size(request.buffer));
+            continue;
+        }
+
+        buffer_clear(request.buffer);
+        {
+            std::lock_guard guard{block_fs->mutex};
+            request.block.read_data(block_fs->data_stream, request.buffer);
+        }
+        buffer_rewind(request.buffer);
+        block_fs_maybe_uncompress(request.buffer);
+        block_fs->stats.read_bytes->add(buffer_get_size(request.buffer));
+    }
+}
+
+/** Only data files beyond this size are considered for compaction. */
+static const int64_t COMPACTION_MIN_FILE_SIZE = 1024 * 1024;
+
+/**
+   Every overwrite of a node key appends a fresh block and leaves the
+   old one dead in the file, so data files grow monotonically - one
+   smoother iteration per parameter per member. When more than half of
+   the file is dead weight, rewrite it with only the live blocks packed
+   back to back. The raw data bytes are copied as-is (compressed nodes
+   stay compressed) and the rewrite goes through a temporary file +
+   rename, so a crash mid-compaction leaves the original file intact.
+*/
+static void block_fs_try_compact(block_fs_type *block_fs) {
+    if (block_fs->data_stream == nullptr || block_fs->data_file.empty())
+        return;
+
+    struct stat file_stat;
+    if (fstat(block_fs->data_fd, &file_stat) != 0)
+        return;
+    int64_t file_size = file_stat.st_size;
+    if (file_size < COMPACTION_MIN_FILE_SIZE)
+        return;
+
+    int64_t live_size = 0;
+    for (const auto &[key, block] : block_fs->index)
+        live_size += block.node_size;
+    if (2 * (file_size - live_size) <= file_size)
+        return;
+
+    std::vector<std::pair<std::string, Block>> blocks(block_fs->index.begin(),
+                                                      block_fs->index.end());
+    std::sort(blocks.begin(), blocks.end(),
+              [](const auto &a, const auto &b) {
+                  return a.second.node_offset < b.second.node_offset;
+              });
+
+    fs::path tmp_file = block_fs->data_file;
+    tmp_file += ".compact";
+    FILE *target = fopen(tmp_file.c_str(), "w+");
+    if (target == nullptr)
+        return;
+
+    std::unordered_map<std::string, Block> new_index;
+    int64_t offset = 0;
+    std::vector<char> data;
+    for (const auto &[key, block] : blocks) {
+        data.resize(block.data_size);
+        size_t checksum_size =
+            block.has_checksum() ? sizeof(uint32_t) : 0;
+        fseek__(block_fs->data_stream,
+                block.node_offset + block.node_size - sizeof NODE_END_TAG -
+                    checksum_size - block.data_size,
+                SEEK_SET);
+        if (fread(data.data(), 1, block.data_size, block_fs->data_stream) !=
+            static_cast<size_t>(block.data_size)) {
+            fclose(target);
+            std::error_code ec;
+            fs::remove(tmp_file, ec);
+            return;
+        }
+
+        Block new_block{block.status, offset,
+                        static_cast<int32_t>(block.data_size), key.c_str()};
+        new_block.write(key.c_str(), target, data.data());
+        new_index[key] = new_block;
+        offset += new_block.node_size;
+    }
+    fflush(target);
+    fsync(fileno(target));
+
+    std::error_code ec;
+    fs::rename(tmp_file, block_fs->data_file, ec);
+    if (ec) {
+        fclose(target);
+        fs::remove(tmp_file, ec);
+        return;
+    }
+
+    fclose(block_fs->data_stream);
+    block_fs->data_stream = target;
+    block_fs->data_fd = fileno(target);
+    block_fs->index = std::move(new_index);
+    fseek__(block_fs->data_stream, 0, SEEK_END);
 }
 
 /**
@@ -484,6 +1210,16 @@ void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
 void block_fs_close(block_fs_type *block_fs) {
     block_fs_fsync(block_fs);
 
+    if (!block_fs_is_readonly(block_fs)) {
+        block_fs_try_compact(block_fs);
+        block_fs_fwrite_index(block_fs);
+    }
+
+    for (auto &[addr, size] : block_fs->mappings) {
+        munmap(const_cast<char *>(addr), size);
+        ert::utils::memory_account("block_fs.mmap").release(size);
+    }
+
     if (block_fs->data_stream != NULL)
         fclose(block_fs->data_stream);
 
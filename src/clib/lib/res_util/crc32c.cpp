@@ -0,0 +1,70 @@
+#include <array>
+#include <cstring>
+
+#include <ert/res_util/crc32c.hpp>
+
+namespace {
+
+/** The Castagnoli polynomial, reflected. */
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;
+
+uint32_t crc32c_software(uint32_t crc, const unsigned char *data,
+                         std::size_t size) {
+    static const auto table = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t index = 0; index < 256; index++) {
+            uint32_t entry = index;
+            for (int bit = 0; bit < 8; bit++)
+                entry = (entry >> 1) ^ ((entry & 1) ? CRC32C_POLY : 0);
+            table[index] = entry;
+        }
+        return table;
+    }();
+    for (std::size_t index = 0; index < size; index++)
+        crc = table[(crc ^ data[index]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+#if defined(__x86_64__)
+[[gnu::target("sse4.2")]] uint32_t
+crc32c_hardware(uint32_t crc, const unsigned char *data, std::size_t size) {
+    uint64_t wide = crc;
+    while (size >= 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, data, sizeof chunk);
+        wide = __builtin_ia32_crc32di(wide, chunk);
+        data += 8;
+        size -= 8;
+    }
+    crc = static_cast<uint32_t>(wide);
+    while (size--)
+        crc = __builtin_ia32_crc32qi(crc, *data++);
+    return crc;
+}
+
+bool have_sse42() {
+    static const bool have = __builtin_cpu_supports("sse4.2");
+    return have;
+}
+#endif
+
+} // namespace
+
+namespace ert {
+namespace utils {
+
+uint32_t crc32c_extend(uint32_t crc, const void *data, std::size_t size) {
+    auto bytes = static_cast<const unsigned char *>(data);
+#if defined(__x86_64__)
+    if (have_sse42())
+        return ~crc32c_hardware(~crc, bytes, size);
+#endif
+    return ~crc32c_software(~crc, bytes, size);
+}
+
+uint32_t crc32c(const void *data, std::size_t size) {
+    return crc32c_extend(0, data, size);
+}
+
+} // namespace utils
+} // namespace ert
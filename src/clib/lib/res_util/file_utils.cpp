@@ -1,5 +1,9 @@
 #include <filesystem>
+#include <string>
+#include <vector>
 
+#include <ert/concurrency.hpp>
+#include <ert/python.hpp>
 #include <ert/res_util/file_utils.hpp>
 
 namespace fs = std::filesystem;
@@ -13,3 +17,55 @@ FILE *mkdir_fopen(fs::path file_path, const char *mode) {
     FILE *stream = fopen(full_path.c_str(), mode);
     return stream;
 }
+
+/** Longest common leading component sequence of the parent directories. */
+static fs::path common_parent(const std::vector<std::string> &paths) {
+    fs::path prefix = fs::path(paths[0]).parent_path();
+    for (const auto &path_string : paths) {
+        fs::path parent = fs::path(path_string).parent_path();
+        fs::path common;
+        auto prefix_iter = prefix.begin();
+        auto parent_iter = parent.begin();
+        while (prefix_iter != prefix.end() && parent_iter != parent.end() &&
+               *prefix_iter == *parent_iter) {
+            common /= *prefix_iter;
+            ++prefix_iter;
+            ++parent_iter;
+        }
+        prefix = common;
+    }
+    return prefix;
+}
+
+/**
+   Create all the runpath directories in @paths in one operation. The
+   common parent is created once up front, and the per-member subtrees
+   are then created in parallel; with a 1000 member ensemble on an NFS
+   mounted scratch area the serial mkdir -p per realization - each one
+   stat'ing every leading component again - dominates the runpath
+   preparation time.
+*/
+void create_runpath_directories(const std::vector<std::string> &paths) {
+    if (paths.empty())
+        return;
+
+    fs::path prefix = common_parent(paths);
+    if (!prefix.empty())
+        fs::create_directories(prefix);
+
+    ert::global_pool().parallel_for(
+        paths.size(), 1, [&](size_t begin, size_t end) {
+            // The common parent already exists; create_directories
+            // only touches the member specific tail components.
+            for (size_t i = begin; i < end; i++)
+                fs::create_directories(paths[i]);
+        });
+}
+
+ERT_CLIB_SUBMODULE("file_utils", m) {
+    m.def("create_runpath_directories",
+          [](const std::vector<std::string> &paths) {
+              create_runpath_directories(paths);
+          },
+          py::arg("paths"));
+}
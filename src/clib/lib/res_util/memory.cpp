@@ -1,7 +1,18 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sys/mman.h>
 #include <sys/resource.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <ert/res_util/memory.hpp>
 
 namespace ert {
 namespace utils {
@@ -96,3 +107,136 @@ std::size_t process_max_rss(void) {
 }
 } // namespace utils
 } // namespace ert
+
+namespace ert {
+namespace utils {
+
+static auto memory_logger = ert::get_logger("memory");
+
+/** Node-based map so the references handed out by memory_account()
+    stay valid as accounts are added. */
+static std::mutex account_mutex;
+static std::map<std::string, MemoryAccount> accounts;
+
+static std::atomic<std::size_t> tracked_total{};
+
+static std::size_t log_threshold_bytes() {
+    static std::size_t threshold = [] {
+        const char *env = getenv("ERT_MEMORY_LOG_THRESHOLD_MB");
+        if (env == nullptr)
+            return std::size_t(0);
+        return std::size_t(strtoul(env, nullptr, 10)) << 20;
+    }();
+    return threshold;
+}
+
+MemoryAccount &memory_account(const std::string &tag) {
+    std::lock_guard guard{account_mutex};
+    return accounts[tag];
+}
+
+std::string memory_report() {
+    std::lock_guard guard{account_mutex};
+    std::string report;
+    for (const auto &[tag, account] : accounts)
+        report += fmt::format("{}{}: {} Mb ({} Mb peak)",
+                              report.empty() ? "" : ", ", tag,
+                              account.current() >> 20, account.peak() >> 20);
+    return report;
+}
+
+std::string memory_report_json() {
+    fmt::memory_buffer buffer;
+    auto out = std::back_inserter(buffer);
+
+    fmt::format_to(out,
+                   "{{\n  \"max_rss_mb\": {},\n  \"max_memory_mb\": {},\n"
+                   "  \"accounts\": {{",
+                   process_max_rss(), process_max_memory());
+    std::lock_guard guard{account_mutex};
+    bool first = true;
+    for (const auto &[tag, account] : accounts) {
+        fmt::format_to(out,
+                       "{}\n    \"{}\": {{\"current\": {}, \"peak\": {}}}",
+                       first ? "" : ",", tag, account.current(),
+                       account.peak());
+        first = false;
+    }
+    fmt::format_to(out, "{}}}\n}}\n", first ? "" : "\n  ");
+    return std::string(buffer.data(), buffer.size());
+}
+
+void MemoryAccount::allocate(std::size_t bytes) noexcept {
+    m_current.fetch_add(bytes, std::memory_order_relaxed);
+    std::size_t current = m_current.load(std::memory_order_relaxed);
+    std::size_t peak = m_peak.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !m_peak.compare_exchange_weak(peak, current,
+                                         std::memory_order_relaxed))
+        ;
+
+    std::size_t total =
+        tracked_total.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t threshold = log_threshold_bytes();
+    if (threshold == 0)
+        return;
+    // One report per threshold multiple the tracked total grows past.
+    static std::atomic<std::size_t> next_report{0};
+    std::size_t next = next_report.load(std::memory_order_relaxed);
+    if (next == 0)
+        next_report.compare_exchange_strong(next, threshold);
+    next = next_report.load(std::memory_order_relaxed);
+    if (total >= next &&
+        next_report.compare_exchange_strong(next, next + threshold))
+        memory_logger->info("tracked memory passed {} Mb - {}", next >> 20,
+                            memory_report());
+}
+
+void MemoryAccount::release(std::size_t bytes) noexcept {
+    m_current.fetch_sub(bytes, std::memory_order_relaxed);
+    tracked_total.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryGovernor::acquire(std::size_t bytes) {
+    if (m_budget == 0)
+        return;
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [&] {
+        return m_admitted == 0 || m_admitted + bytes <= m_budget;
+    });
+    m_admitted += bytes;
+}
+
+void MemoryGovernor::release(std::size_t bytes) {
+    if (m_budget == 0)
+        return;
+    {
+        std::lock_guard lock{m_mutex};
+        m_admitted -= bytes;
+    }
+    m_cv.notify_all();
+}
+
+MemoryGovernor &memory_governor() {
+    static MemoryGovernor governor([]() -> std::size_t {
+        const char *env = getenv("ERT_MEMORY_BUDGET_MB");
+        if (env == nullptr)
+            return std::size_t(0);
+        return std::size_t(strtoul(env, nullptr, 10)) << 20;
+    }());
+    return governor;
+}
+
+void advise_huge_pages(void *data, std::size_t size) {
+#ifdef MADV_HUGEPAGE
+    const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+    auto address = reinterpret_cast<std::uintptr_t>(data);
+    std::uintptr_t begin = (address + page - 1) & ~(page - 1);
+    std::uintptr_t end = (address + size) & ~(page - 1);
+    if (end > begin)
+        madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#endif
+}
+
+} // namespace utils
+} // namespace ert
@@ -0,0 +1,92 @@
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+#include <fmt/format.h>
+
+#include <ert/res_util/metric.hpp>
+
+namespace ert {
+namespace metrics {
+
+/** Node-based maps so the references handed out by counter() and
+    histogram() stay valid as the registry grows. */
+struct Registry::State {
+    mutable std::mutex mutex;
+    std::map<std::string, Counter> counters;
+    std::map<std::string, Histogram> histograms;
+};
+
+Registry::Registry() : m_state(std::make_unique<State>()) {}
+
+Counter &Registry::counter(const std::string &name) {
+    std::lock_guard guard{m_state->mutex};
+    return m_state->counters[name];
+}
+
+Histogram &Registry::histogram(const std::string &name) {
+    std::lock_guard guard{m_state->mutex};
+    return m_state->histograms[name];
+}
+
+std::string Registry::dump_json() const {
+    std::lock_guard guard{m_state->mutex};
+    fmt::memory_buffer buffer;
+    auto out = std::back_inserter(buffer);
+
+    fmt::format_to(out, "{{\n  \"counters\": {{");
+    bool first = true;
+    for (const auto &[name, counter] : m_state->counters) {
+        fmt::format_to(out, "{}\n    \"{}\": {}", first ? "" : ",", name,
+                       counter.value());
+        first = false;
+    }
+    fmt::format_to(out, "{}}},\n  \"histograms\": {{", first ? "" : "\n  ");
+
+    first = true;
+    for (const auto &[name, histogram] : m_state->histograms) {
+        fmt::format_to(out,
+                       "{}\n    \"{}\": {{\"count\": {}, \"sum\": {}, "
+                       "\"buckets\": [",
+                       first ? "" : ",", name, histogram.count(),
+                       histogram.sum());
+        bool first_bucket = true;
+        for (size_t index = 0; index < Histogram::BUCKET_COUNT; index++) {
+            uint64_t count = histogram.bucket(index);
+            if (count == 0)
+                continue;
+            fmt::format_to(out, "{}[{}, {}]", first_bucket ? "" : ", ",
+                           Histogram::bucket_bound(index), count);
+            first_bucket = false;
+        }
+        fmt::format_to(out, "]}}");
+        first = false;
+    }
+    fmt::format_to(out, "{}}}\n}}\n", first ? "" : "\n  ");
+    return std::string(buffer.data(), buffer.size());
+}
+
+static void dump_at_exit() {
+    const char *path = getenv("ERT_METRICS_FILE");
+    if (path == nullptr)
+        return;
+    FILE *stream = fopen(path, "w");
+    if (stream == nullptr)
+        return;
+    std::string json = registry().dump_json();
+    fwrite(json.data(), 1, json.size(), stream);
+    fclose(stream);
+}
+
+Registry &registry() {
+    // Deliberately leaked - see the declaration.
+    static Registry *instance = [] {
+        atexit(dump_at_exit);
+        return new Registry();
+    }();
+    return *instance;
+}
+
+} // namespace metrics
+} // namespace ert
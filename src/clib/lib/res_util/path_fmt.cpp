@@ -1,3 +1,7 @@
+#include <mutex>
+#include <set>
+#include <string>
+
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,8 +40,25 @@ struct path_fmt_struct {
     char *fmt;
     char *file_fmt;
     bool is_directory;
+    /** Directories this instance has already created (or found
+        existing). Runpath formats are expanded once per (iens, iter)
+        combination - often repeatedly for the same combination - and
+        the memo saves the stat()/mkdir chain on every repeat. */
+    mutable std::set<std::string> created_paths;
+    mutable std::mutex memo_mutex;
 };
 
+static void path_fmt_ensure_directory(const path_fmt_type *path,
+                                      const char *directory) {
+    std::lock_guard guard{path->memo_mutex};
+    if (path->created_paths.count(directory) > 0)
+        return;
+
+    if (!util_is_directory(directory))
+        util_make_path(directory);
+    path->created_paths.emplace(directory);
+}
+
 void path_fmt_reset_fmt(path_fmt_type *path, const char *fmt) {
     path->fmt = util_realloc_string_copy(path->fmt, fmt);
     if (path->is_directory)
@@ -45,7 +66,7 @@ void path_fmt_reset_fmt(path_fmt_type *path, const char *fmt) {
 }
 
 static path_fmt_type *path_fmt_alloc__(const char *fmt, bool is_directory) {
-    path_fmt_type *path = (path_fmt_type *)util_malloc(sizeof *path);
+    path_fmt_type *path = new path_fmt_type();
     path->fmt = NULL;
     path->file_fmt = NULL;
     path->is_directory = is_directory;
@@ -97,8 +118,7 @@ char *path_fmt_alloc_path_va(const path_fmt_type *path, bool auto_mkdir,
                              va_list ap) {
     char *new_path = util_alloc_sprintf_va(path->fmt, ap);
     if (auto_mkdir)
-        if (!util_is_directory(new_path))
-            util_make_path(new_path);
+        path_fmt_ensure_directory(path, new_path);
     return new_path;
 }
 
@@ -152,8 +172,7 @@ char *path_fmt_alloc_file(const path_fmt_type *path, bool auto_mkdir, ...) {
         filename = util_alloc_sprintf_va(path->file_fmt, tmp_va);
         if (auto_mkdir) {
             const char *__path = util_alloc_sprintf_va(path->fmt, tmp_va);
-            if (!util_is_directory(__path))
-                util_make_path(__path);
+            path_fmt_ensure_directory(path, __path);
             free((char *)__path);
         }
         va_end(ap);
@@ -168,7 +187,8 @@ char *path_fmt_alloc_file(const path_fmt_type *path, bool auto_mkdir, ...) {
         if (auto_mkdir) {
             char *__path;
             util_alloc_file_components(filename, &__path, NULL, NULL);
-            util_make_path(__path);
+            if (__path != NULL)
+                path_fmt_ensure_directory(path, __path);
             free(__path);
         }
         va_end(ap);
@@ -216,7 +236,7 @@ void path_fmt_free(path_fmt_type *path) {
     free(path->fmt);
     if (path->is_directory)
         free(path->file_fmt);
-    free(path);
+    delete path;
 }
 
 void path_fmt_free__(void *arg) {
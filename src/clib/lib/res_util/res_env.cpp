@@ -1,3 +1,5 @@
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -61,9 +63,30 @@ char *res_env_alloc_PATH_executable(const char *executable) {
 
         return path;
     } else {
+        /* Scanning PATH costs one stat() per candidate directory, and
+           the same handful of executables are resolved every time a
+           job or workflow is configured. Resolutions are therefore
+           memoized - an empty string records a failed lookup - and the
+           whole memo is dropped whenever the PATH value changes. */
+        static std::mutex cache_mutex;
+        static std::string cache_path_env;
+        static std::map<std::string, std::string> cache;
+
+        std::lock_guard guard{cache_mutex};
+        const char *path_env = getenv("PATH");
+        if (cache_path_env != (path_env ? path_env : "")) {
+            cache_path_env = path_env ? path_env : "";
+            cache.clear();
+        }
+
+        auto cache_iter = cache.find(executable);
+        if (cache_iter != cache.end())
+            return cache_iter->second.empty()
+                       ? NULL
+                       : util_alloc_string_copy(cache_iter->second.c_str());
+
         char *full_path = NULL;
         auto path_list = res_env_alloc_PATH_list();
-        int ipath = 0;
 
         for (auto path : path_list) {
             char *current_attempt =
@@ -73,12 +96,11 @@ char *res_env_alloc_PATH_executable(const char *executable) {
                 util_is_executable(current_attempt)) {
                 full_path = current_attempt;
                 break;
-            } else {
+            } else
                 free(current_attempt);
-                ipath++;
-            }
         }
 
+        cache[executable] = full_path ? full_path : "";
         return full_path;
     }
 }
@@ -0,0 +1,24 @@
+#include <mutex>
+#include <unordered_set>
+
+#include <ert/res_util/string.hpp>
+
+namespace ert {
+
+/**
+ * The pool is an unordered_set of std::string: the container is node
+ * based, so the strings - and thereby the c_str() pointers handed out -
+ * stay put when the set rehashes. Entries are never removed; the keys
+ * going through here (parameter names, summary keys, config keywords)
+ * are small and few distinct, so the pool stays bounded even though the
+ * number of intern() calls is large.
+ */
+const char *intern(std::string_view str) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> pool;
+
+    std::lock_guard guard{mutex};
+    return pool.emplace(str).first->c_str();
+}
+
+} // namespace ert
@@ -1,9 +1,18 @@
+#include <algorithm>
 #include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <ctype.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include <ert/res_util/arena.hpp>
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/buffer.hpp>
 #include <ert/util/hash.hpp>
@@ -238,12 +247,119 @@ void subst_list_free(subst_list_type *subst_list) {
   another function for pure string substitutions.
 */
 
+namespace {
+
+/**
+   Aho-Corasick automaton over the substitution keys: one scan of a
+   buffer locates the occurrences of every key, instead of restarting
+   a full buffer search once per key. With the typical ~60 defined
+   keys and the thousands of templated files filtered during runpath
+   generation this removes nearly all of the scanning work.
+*/
+class multi_matcher {
+    struct node {
+        std::map<char, int> next;
+        int fail = 0;
+        /** Index of the key terminating in this node, or -1. */
+        int key = -1;
+        /** Nearest proper suffix node terminating a key, or -1. */
+        int output = -1;
+    };
+    std::vector<node> nodes;
+    std::vector<size_t> key_length;
+
+    int step(int state, char c) const {
+        while (true) {
+            auto iter = nodes[state].next.find(c);
+            if (iter != nodes[state].next.end())
+                return iter->second;
+            if (state == 0)
+                return 0;
+            state = nodes[state].fail;
+        }
+    }
+
+public:
+    struct match {
+        size_t start;
+        size_t end;
+        /** Index into the key list handed to the constructor. */
+        int key;
+    };
+
+    explicit multi_matcher(const std::vector<const char *> &keys) {
+        nodes.emplace_back();
+        for (size_t key_index = 0; key_index < keys.size(); key_index++) {
+            int current = 0;
+            key_length.push_back(strlen(keys[key_index]));
+            for (const char *c = keys[key_index]; *c != '\0'; c++) {
+                auto iter = nodes[current].next.find(*c);
+                if (iter == nodes[current].next.end()) {
+                    int new_node = nodes.size();
+                    nodes.emplace_back();
+                    nodes[current].next[*c] = new_node;
+                    current = new_node;
+                } else
+                    current = iter->second;
+            }
+            if (nodes[current].key < 0)
+                nodes[current].key = key_index;
+        }
+
+        /* Breadth first construction of the failure links. */
+        std::vector<int> queue;
+        for (const auto &[c, child] : nodes[0].next)
+            queue.push_back(child);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int current = queue[head];
+            for (const auto &[c, child] : nodes[current].next) {
+                nodes[child].fail = step(nodes[current].fail, c);
+                nodes[child].output = nodes[nodes[child].fail].key >= 0
+                                          ? nodes[child].fail
+                                          : nodes[nodes[child].fail].output;
+                queue.push_back(child);
+            }
+        }
+    }
+
+    /** Collect every key occurrence in one pass over the text. */
+    void scan(const char *data, size_t length,
+              std::vector<match> &matches) const {
+        int state = 0;
+        for (size_t pos = 0; pos < length; pos++) {
+            state = step(state, data[pos]);
+            for (int hit = nodes[state].key >= 0 ? state : nodes[state].output;
+                 hit >= 0; hit = nodes[hit].output) {
+                size_t length_hit = key_length[nodes[hit].key];
+                matches.push_back(
+                    {pos + 1 - length_hit, pos + 1, nodes[hit].key});
+            }
+        }
+    }
+
+    bool contains_any(const char *data) const {
+        int state = 0;
+        for (const char *c = data; *c != '\0'; c++) {
+            state = step(state, *c);
+            if (nodes[state].key >= 0 || nodes[state].output >= 0)
+                return true;
+        }
+        return false;
+    }
+};
+
+} // namespace
+
 /**
    Updates the buffer inplace with all the string substitutions in the
-   subst_list.
+   subst_list, one key at a time: key 0 is applied over the whole
+   buffer before key 1 sees it, so substitution values introduced by
+   one key are rescanned by the later keys (the cascade documented at
+   the top of this file).
 */
-static bool subst_list_replace_strings(const subst_list_type *subst_list,
-                                       buffer_type *buffer) {
+static bool
+subst_list_replace_strings_sequential(const subst_list_type *subst_list,
+                                      buffer_type *buffer) {
     int index;
     bool global_match = false;
     for (index = 0; index < vector_get_size(subst_list->string_data); index++) {
@@ -263,58 +379,262 @@ static bool subst_list_replace_strings(const subst_list_type *subst_list,
     return global_match;
 }
 
+/** The active nodes are the entries which actually carry a value -
+    entries with a NULL value are skipped by every replacement path. */
+static std::vector<const subst_list_string_type *>
+subst_list_active_nodes(const subst_list_type *subst_list) {
+    std::vector<const subst_list_string_type *> active;
+    for (int index = 0; index < vector_get_size(subst_list->string_data);
+         index++) {
+        const subst_list_string_type *node =
+            (const subst_list_string_type *)vector_iget_const(
+                subst_list->string_data, index);
+        if (node->value != NULL)
+            active.push_back(node);
+    }
+    return active;
+}
+
+/**
+   Resolve overlapping matches the way the sequential per key loop
+   would: key 0 is applied everywhere before key 1 sees the text, so
+   when two matches overlap the one with the lowest key index wins -
+   not the leftmost. The scan emits matches in position order, so the
+   stable sort keeps left to right order within each key. The accepted
+   matches are returned sorted by position.
+*/
+static std::vector<multi_matcher::match>
+subst_list_select_matches(std::vector<multi_matcher::match> &matches) {
+    std::stable_sort(
+        matches.begin(), matches.end(),
+        [](const multi_matcher::match &a, const multi_matcher::match &b) {
+            return a.key < b.key;
+        });
+
+    std::vector<multi_matcher::match> accepted;
+    std::map<size_t, size_t> consumed;
+    for (const auto &match : matches) {
+        auto after = consumed.lower_bound(match.start);
+        if (after != consumed.end() && after->first < match.end)
+            continue;
+        if (after != consumed.begin() &&
+            std::prev(after)->second > match.start)
+            continue;
+        consumed.emplace(match.start, match.end);
+        accepted.push_back(match);
+    }
+
+    std::sort(accepted.begin(), accepted.end(),
+              [](const multi_matcher::match &a, const multi_matcher::match &b) {
+                  return a.start < b.start;
+              });
+    return accepted;
+}
+
+/**
+   Updates the buffer inplace with all the string substitutions in the
+   subst_list. The common case - no substitution value contains
+   another key - is handled with a single multi pattern scan of the
+   buffer; when a value does contain a key the sequential per key loop
+   is used so the documented cascade semantics are preserved.
+*/
+static bool subst_list_replace_strings(const subst_list_type *subst_list,
+                                       buffer_type *buffer) {
+    std::vector<const subst_list_string_type *> active =
+        subst_list_active_nodes(subst_list);
+    if (active.empty())
+        return false;
+
+    std::vector<const char *> keys;
+    for (const subst_list_string_type *node : active)
+        keys.push_back(node->key);
+    multi_matcher matcher(keys);
+
+    for (const subst_list_string_type *node : active)
+        if (matcher.contains_any(node->value))
+            return subst_list_replace_strings_sequential(subst_list, buffer);
+
+    const char *data = (const char *)buffer_get_data(buffer);
+    size_t data_length = strlen(data);
+    std::vector<multi_matcher::match> matches;
+    matcher.scan(data, data_length, matches);
+    if (matches.empty())
+        return false;
+
+    std::vector<multi_matcher::match> accepted =
+        subst_list_select_matches(matches);
+
+    /* Splice the replacements into a scratch string in one pass. The
+       final length is known up front, so the scratch lands in the
+       thread arena instead of a freshly grown heap string - this runs
+       once per template per realization when rendering runpaths. */
+    ert::utils::ArenaScope scratch;
+    size_t length = data_length;
+    for (const auto &match : accepted)
+        length +=
+            strlen(active[match.key]->value) - (match.end - match.start);
+    char *result = scratch.arena().allocate_array<char>(length + 1);
+    char *out = result;
+    size_t pos = 0;
+    for (const auto &match : accepted) {
+        memcpy(out, data + pos, match.start - pos);
+        out += match.start - pos;
+        size_t value_length = strlen(active[match.key]->value);
+        memcpy(out, active[match.key]->value, value_length);
+        out += value_length;
+        pos = match.end;
+    }
+    memcpy(out, data + pos, data_length - pos);
+    out += data_length - pos;
+    *out = '\0';
+
+    buffer_clear(buffer);
+    /* Keep the trailing \0 as part of the content, like the callers set
+       the buffer up. */
+    buffer_fwrite(buffer, result, 1, length + 1);
+    return true;
+}
+
+/**
+   The original filter implementation: the whole file is loaded into a
+   buffer, updated in memory and written back. Kept as the fallback for
+   the cascading case, where a substitution value contains another key
+   and the sequential per key loop must see the complete text.
+*/
+static bool subst_list_filter_file_buffer(const subst_list_type *subst_list,
+                                          const char *src_file,
+                                          const char *target_file) {
+    buffer_type *buffer = buffer_fread_alloc(src_file);
+    // Ensure that the buffer is a \0 terminated string:
+    buffer_fseek(buffer, 0, SEEK_END);
+    buffer_fwrite_char(buffer, '\0');
+
+    bool match = subst_list_replace_strings(subst_list, buffer);
+
+    auto stream = mkdir_fopen(fs::path(target_file), "w");
+    buffer_stream_fwrite_n(buffer, 0, -1,
+                           stream); /* -1: Do not write the trailing \0. */
+    fclose(stream);
+
+    buffer_free(buffer);
+    return match;
+}
+
+/**
+   Streaming filter: the source file is mapped read only, scanned in
+   one pass with the multi pattern matcher and the output is spliced
+   directly to the target stream - the unmatched stretches straight
+   from the mapping, the matches from the substitution values. Memory
+   use is the match list plus the stdio write buffer, independent of
+   the file size; large templated schedule files (100+ MB per
+   realization) no longer cost a transient copy of themselves during
+   runpath creation.
+
+   Returns false when the source cannot be mapped - the caller then
+   falls back to the buffered path and its error handling.
+*/
+static bool subst_list_filter_file_stream(
+    const std::vector<const subst_list_string_type *> &active,
+    const multi_matcher &matcher, const char *src_file,
+    const char *target_file, bool *match) {
+    int fd = open(src_file, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = file_stat.st_size;
+
+    const char *data = NULL;
+    if (size > 0) {
+        void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        data = (const char *)mapping;
+    }
+
+    std::vector<multi_matcher::match> matches;
+    if (size > 0)
+        matcher.scan(data, size, matches);
+    std::vector<multi_matcher::match> accepted =
+        subst_list_select_matches(matches);
+
+    auto stream = mkdir_fopen(fs::path(target_file), "w");
+    size_t pos = 0;
+    for (const auto &accepted_match : accepted) {
+        fwrite(data + pos, 1, accepted_match.start - pos, stream);
+        const char *value = active[accepted_match.key]->value;
+        fwrite(value, 1, strlen(value), stream);
+        pos = accepted_match.end;
+    }
+    if (size > pos)
+        fwrite(data + pos, 1, size - pos, stream);
+    fclose(stream);
+
+    if (data != NULL)
+        munmap((void *)data, size);
+    close(fd);
+
+    *match = !accepted.empty();
+    return true;
+}
+
 /**
    This function reads the content of a file, and writes a new file
    where all substitutions in subst_list have been performed. Observe
    that target_file and src_file *CAN* point to the same file, in
    which case this will amount to an inplace update. In that case a
    backup file is written, and held, during the execution of the
-   function.
+   function - the streaming path also reads from the backup, since the
+   source mapping must not be live when the target truncates the same
+   file.
 
    Observe that @target_file can contain a path component, that
    component will be created if it does not exist.
 */
 bool subst_list_filter_file(const subst_list_type *subst_list,
                             const char *src_file, const char *target_file) {
-    bool match;
     char *backup_file = NULL;
-    buffer_type *buffer = buffer_fread_alloc(src_file);
-    // Ensure that the buffer is a \0 terminated string:
-    buffer_fseek(buffer, 0, SEEK_END);
-    buffer_fwrite_char(buffer, '\0');
-
     if (util_same_file(src_file, target_file)) {
         char *backup_prefix = util_alloc_sprintf("%s-%s", src_file, __func__);
         backup_file = util_alloc_tmp_file("/tmp", backup_prefix, false);
         free(backup_prefix);
+        util_copy_file(src_file, backup_file);
     }
-
-    /* Writing backup file */
-    if (backup_file != NULL) {
-        FILE *stream = util_fopen(backup_file, "w");
-        buffer_stream_fwrite_n(buffer, 0, -1,
-                               stream); /* -1: Do not write the trailing \0. */
-        fclose(stream);
-    }
-
-    /* Doing the actual update */
-    match = subst_list_replace_strings(subst_list, buffer);
-
-    /* Writing updated file */
-    {
-        auto stream = mkdir_fopen(fs::path(target_file), "w");
-
-        buffer_stream_fwrite_n(buffer, 0, -1,
-                               stream); /* -1: Do not write the trailing \0. */
-        fclose(stream);
-    }
+    const char *read_file = backup_file != NULL ? backup_file : src_file;
+
+    bool match = false;
+    bool streamed = false;
+
+    std::vector<const subst_list_string_type *> active =
+        subst_list_active_nodes(subst_list);
+    std::vector<const char *> keys;
+    for (const subst_list_string_type *node : active)
+        keys.push_back(node->key);
+    multi_matcher matcher(keys);
+
+    bool cascade = false;
+    for (const subst_list_string_type *node : active)
+        if (matcher.contains_any(node->value))
+            cascade = true;
+
+    if (!cascade)
+        streamed = subst_list_filter_file_stream(active, matcher, read_file,
+                                                 target_file, &match);
+    if (!streamed)
+        match = subst_list_filter_file_buffer(subst_list, read_file,
+                                              target_file);
 
     /* OK - all went hunka dory - unlink the backup file and leave the building. */
     if (backup_file != NULL) {
         remove(backup_file);
         free(backup_file);
     }
-    buffer_free(buffer);
     return match;
 }
 
@@ -1,11 +1,24 @@
 #include <filesystem>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <stdint.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ert/concurrency.hpp>
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/hash.hpp>
+#include <ert/util/util.hpp>
 #include <ert/util/vector.hpp>
 
 #include <ert/rms/rms_file.hpp>
@@ -22,6 +35,60 @@ static const char *rms_comment1 = "ROFF file";
 static const char *rms_comment2 =
     "Creator: RMS - Reservoir Modelling System, version 8.1";
 
+static const char *rms_eof_tag = "eof";
+static const char *rms_starttag_string = "tag";
+static const char *rms_endtag_string = "endtag";
+
+/** One tag recorded in the file index. */
+struct rms_indexed_tag {
+    std::string name;
+    /** Cursor position of the first tagkey header, right after the
+        tag name string. */
+    uint64_t offset;
+    /** Values of the char typed keys, used to answer the
+        (keyname, keyvalue) part of a tag lookup. */
+    std::vector<std::pair<std::string, std::string>> char_keys;
+};
+
+/**
+   Tag->offset index over a ROFF file, built (or loaded from the
+   sidecar index file) on the first tag lookup and kept on the file
+   handle together with the live mapping. Reading N properties from
+   one file is then one full scan plus N direct seeks instead of N
+   full scans.
+*/
+struct rms_file_index {
+    void *mapping = nullptr;
+    size_t file_size = 0;
+    bool endian_convert = false;
+    std::vector<rms_indexed_tag> tags;
+};
+
+/**
+   Double buffered write state for a file opened with
+   rms_file_fopen_w_async(). The exporter serializes into a memstream
+   (the front buffer) while a pool task writes the previously filled
+   buffer to the target file; rms_file_fwrite_flush() swaps the two.
+   The exporter therefore only blocks on the disk when it produces
+   buffers faster than they can be written out.
+*/
+struct rms_file_writer {
+    FILE *target = nullptr;
+    int fd = -1;
+    /** memstream the exporter currently serializes into. */
+    FILE *front = nullptr;
+    char *front_data = nullptr;
+    size_t front_size = 0;
+    /** Buffer owned by the in-flight background write. */
+    char *back_data = nullptr;
+    size_t back_size = 0;
+    std::future<void> back_done;
+    /** Bytes landed in the target file; only touched by the (one at a
+        time) background write, read after joining it. */
+    size_t written = 0;
+    bool failed = false;
+};
+
 struct rms_file_struct {
     char *filename;
     bool endian_convert;
@@ -29,23 +96,14 @@ struct rms_file_struct {
     hash_type *type_map;
     vector_type *tag_list;
     FILE *stream;
+    /** Lazily built by rms_file_fread_alloc_tag(); invalidated when
+        the filename changes. */
+    rms_file_index *index;
+    /** Non-NULL between rms_file_fopen_w_async() and
+        rms_file_fclose(). */
+    rms_file_writer *writer;
 };
 
-static bool rms_fmt_file(const rms_file_type *rms_file) {
-    char filetype[9];
-    rms_util_fread_string(filetype, 9, rms_file->stream);
-
-    if (strncmp(filetype, rms_binary_header, 8) == 0)
-        return false;
-    if (strncmp(filetype, rms_ascii_header, 8) == 0)
-        return true;
-
-    fprintf(stderr, "%s: header : %8s not recognized in file: %s - aborting \n",
-            __func__, filetype, rms_file->filename);
-    abort();
-    return false; // will not happen
-}
-
 rms_tag_type *rms_file_get_tag_ref(const rms_file_type *rms_file,
                                    const char *tagname, const char *keyname,
                                    const char *keyvalue, bool abort_on_error) {
@@ -105,12 +163,24 @@ rms_file_type *rms_file_alloc(const char *filename, bool fmt_file) {
 
     rms_file->filename = NULL;
     rms_file->stream = NULL;
+    rms_file->index = NULL;
+    rms_file->writer = NULL;
     rms_file_set_filename(rms_file, filename, fmt_file);
     return rms_file;
 }
 
+static void rms_file_drop_index(rms_file_type *rms_file) {
+    if (rms_file->index == NULL)
+        return;
+    if (rms_file->index->mapping != NULL)
+        munmap(rms_file->index->mapping, rms_file->index->file_size);
+    delete rms_file->index;
+    rms_file->index = NULL;
+}
+
 void rms_file_set_filename(rms_file_type *rms_file, const char *filename,
                            bool fmt_file) {
+    rms_file_drop_index(rms_file);
     rms_file->filename = util_realloc_string_copy(rms_file->filename, filename);
     rms_file->fmt_file = fmt_file;
 }
@@ -121,6 +191,7 @@ void rms_file_free_data(rms_file_type *rms_file) {
 
 void rms_file_free(rms_file_type *rms_file) {
     rms_file_free_data(rms_file);
+    rms_file_drop_index(rms_file);
     vector_free(rms_file->tag_list);
     hash_free(rms_file->type_map);
     free(rms_file->filename);
@@ -152,70 +223,367 @@ FILE *rms_file_get_FILE(const rms_file_type *rms_file) {
     return rms_file->stream;
 }
 
-static void rms_file_init_fread(rms_file_type *rms_file) {
+/*
+   The read path does not go through the FILE * based parsing used for
+   writing; instead the whole file is memory mapped and scanned forward
+   once. Tags which do not match are skipped by just advancing the
+   cursor past their data - nothing is allocated or copied for them -
+   and a matching tag is internalized with one bulk copy + endian
+   conversion per tagkey.
+*/
+struct rms_scan_cursor {
+    const char *data;
+    size_t size;
+    size_t pos;
+    const char *filename;
+};
 
-    rms_file->fmt_file = rms_fmt_file(rms_file);
-    if (rms_file->fmt_file) {
-        fprintf(stderr, "%s only binary files implemented - aborting \n",
-                __func__);
-        abort();
+/** A tagkey header scanned from the mapping; the data pointer refers
+    into the mapping and is only valid while it is alive. */
+struct rms_scan_tagkey {
+    const char *name;
+    rms_type_enum rms_type;
+    int sizeof_ctype;
+    int size;
+    int data_size;
+    const char *data;
+};
+
+static const char *rms_scan_string(rms_scan_cursor *cursor) {
+    const char *string = &cursor->data[cursor->pos];
+    const void *end = memchr(string, 0, cursor->size - cursor->pos);
+    if (end == NULL)
+        util_abort("%s: premature end of file when scanning:%s - aborting \n",
+                   __func__, cursor->filename);
+    cursor->pos += (const char *)end - string + 1;
+    return string;
+}
+
+static void rms_scan_skip_data(rms_scan_cursor *cursor, size_t data_size) {
+    if (cursor->pos + data_size > cursor->size)
+        util_abort("%s: premature end of file when scanning:%s - aborting \n",
+                   __func__, cursor->filename);
+    cursor->pos += data_size;
+}
+
+static int rms_scan_int(rms_scan_cursor *cursor, bool endian_convert) {
+    int value;
+    if (cursor->pos + sizeof value > cursor->size)
+        util_abort("%s: premature end of file when scanning:%s - aborting \n",
+                   __func__, cursor->filename);
+    memcpy(&value, &cursor->data[cursor->pos], sizeof value);
+    cursor->pos += sizeof value;
+    if (endian_convert)
+        util_endian_flip_vector(&value, sizeof value, 1);
+    return value;
+}
+
+/** The first header string ("array" or a type name) has already been
+    scanned by the caller - to detect the endtag marker - and is passed
+    in as @header_string. */
+static rms_scan_tagkey rms_scan_tagkey_header(rms_scan_cursor *cursor,
+                                              const char *header_string,
+                                              hash_type *type_map,
+                                              bool endian_convert) {
+    rms_scan_tagkey key;
+    bool is_array = false;
+    const char *type_string = header_string;
+    if (strcmp(type_string, "array") == 0) {
+        is_array = true;
+        type_string = rms_scan_string(cursor);
     }
-    /* Skipping two comment lines ... */
-    rms_util_fskip_string(rms_file->stream);
-    rms_util_fskip_string(rms_file->stream);
+
+    if (!hash_has_key(type_map, type_string))
+        util_abort("%s: unrecognized type:%s in file:%s - aborting \n",
+                   __func__, type_string, cursor->filename);
     {
-        bool eof_tag;
-        rms_tag_type *filedata_tag =
-            rms_tag_fread_alloc(rms_file->stream, rms_file->type_map,
-                                rms_file->endian_convert, &eof_tag);
-        rms_tagkey_type *byteswap_key =
-            rms_tag_get_key(filedata_tag, "byteswaptest");
-        if (byteswap_key == NULL) {
-            fprintf(stderr,
-                    "%s: failed to find filedata/byteswaptest - aborting \n",
+        __rms_type *rms_t = (__rms_type *)hash_get(type_map, type_string);
+        key.rms_type = rms_t->rms_type;
+        key.sizeof_ctype = rms_t->sizeof_ctype;
+    }
+
+    key.name = rms_scan_string(cursor);
+    key.size = is_array ? rms_scan_int(cursor, endian_convert) : 1;
+    key.data = &cursor->data[cursor->pos];
+    if (key.rms_type == rms_char_type) {
+        /* Char data is a sequence of NUL terminated strings - the only
+           way to find the data size is to scan past them. */
+        size_t start_pos = cursor->pos;
+        for (int i = 0; i < key.size; i++)
+            rms_scan_string(cursor);
+        key.data_size = cursor->pos - start_pos;
+    } else {
+        key.data_size = key.size * key.sizeof_ctype;
+        rms_scan_skip_data(cursor, key.data_size);
+    }
+    return key;
+}
+
+/** Scan the whole mapping once, recording every tag with its offset
+    and char keys in the index. Also settles the endianness of the
+    file from the byteswaptest key of the leading filedata tag. */
+static void rms_file_scan_index(rms_file_type *rms_file,
+                                rms_file_index *index) {
+    rms_scan_cursor cursor = {(const char *)index->mapping, index->file_size,
+                              0, rms_file->filename};
+
+    const char *filetype = rms_scan_string(&cursor);
+    if (strcmp(filetype, rms_binary_header) != 0) {
+        if (strcmp(filetype, rms_ascii_header) == 0)
+            fprintf(stderr, "%s only binary files implemented - aborting \n",
                     __func__);
-            abort();
-        }
-        int byteswap_value = *(int *)rms_tagkey_get_data_ref(byteswap_key);
-        if (byteswap_value == 1)
-            rms_file->endian_convert = false;
         else
-            rms_file->endian_convert = true;
-        rms_tag_free(filedata_tag);
+            fprintf(stderr,
+                    "%s: header : %8s not recognized in file: %s - aborting \n",
+                    __func__, filetype, rms_file->filename);
+        abort();
+    }
+    /* Skipping two comment lines ... */
+    rms_scan_string(&cursor);
+    rms_scan_string(&cursor);
+
+    bool first_tag = true;
+    for (;;) {
+        if (strcmp(rms_scan_string(&cursor), rms_starttag_string) != 0)
+            util_abort("%s: not at tag - header aborting \n", __func__);
+        const char *tag_name = rms_scan_string(&cursor);
+
+        rms_indexed_tag entry;
+        entry.name = tag_name;
+        entry.offset = cursor.pos;
+
+        std::vector<rms_scan_tagkey> keys;
+        for (;;) {
+            const char *header_string = rms_scan_string(&cursor);
+            if (strcmp(header_string, rms_endtag_string) == 0)
+                break;
+            keys.push_back(rms_scan_tagkey_header(&cursor, header_string,
+                                                  rms_file->type_map,
+                                                  index->endian_convert));
+        }
+
+        if (first_tag) {
+            /* The filedata tag comes first and carries the
+               byteswaptest key which settles the endianness of the
+               rest of the file. */
+            for (const auto &key : keys)
+                if (strcmp(key.name, "byteswaptest") == 0) {
+                    int byteswap_value;
+                    memcpy(&byteswap_value, key.data, sizeof byteswap_value);
+                    index->endian_convert = (byteswap_value != 1);
+                }
+            first_tag = false;
+        }
+
+        if (strcmp(tag_name, rms_eof_tag) == 0)
+            return;
+
+        for (const auto &key : keys)
+            if (key.rms_type == rms_char_type)
+                entry.char_keys.emplace_back(key.name, key.data);
+        index->tags.push_back(std::move(entry));
+    }
+}
+
+#define RMS_INDEX_VERSION 1
+
+static char *rms_file_alloc_index_filename(const rms_file_type *rms_file) {
+    return (char *)util_alloc_sprintf("%s.tagidx", rms_file->filename);
+}
+
+static bool rms_index_fread_string(FILE *stream, std::string &string) {
+    int32_t length;
+    if (fread(&length, sizeof length, 1, stream) != 1 || length < 0)
+        return false;
+    string.resize(length);
+    return length == 0 ||
+           fread(&string[0], 1, length, stream) == (size_t)length;
+}
+
+static bool rms_index_fwrite_string(FILE *stream, const std::string &string) {
+    int32_t length = string.size();
+    return fwrite(&length, sizeof length, 1, stream) == 1 &&
+           fwrite(string.data(), 1, length, stream) == (size_t)length;
+}
+
+/**
+   The sidecar index is validated against the (mtime, size) of the
+   data file recorded when it was written; properties are typically
+   rewritten every iteration and the index is then just rebuilt.
+*/
+static bool rms_file_load_index(const char *index_file,
+                                const char *data_file,
+                                rms_file_index *index) {
+    FILE *stream = fopen(index_file, "r");
+    if (stream == NULL)
+        return false;
+
+    int32_t version = 0;
+    int64_t mtime = 0, size = 0;
+    int8_t endian_convert = 0;
+    int32_t tag_count = -1;
+    bool ok = fread(&version, sizeof version, 1, stream) == 1 &&
+              version == RMS_INDEX_VERSION &&
+              fread(&mtime, sizeof mtime, 1, stream) == 1 &&
+              mtime == (int64_t)util_file_mtime(data_file) &&
+              fread(&size, sizeof size, 1, stream) == 1 &&
+              size == (int64_t)util_file_size(data_file) &&
+              fread(&endian_convert, sizeof endian_convert, 1, stream) == 1 &&
+              fread(&tag_count, sizeof tag_count, 1, stream) == 1 &&
+              tag_count >= 0;
+
+    for (int32_t i = 0; ok && i < tag_count; i++) {
+        rms_indexed_tag entry;
+        int32_t key_count = -1;
+        ok = rms_index_fread_string(stream, entry.name) &&
+             fread(&entry.offset, sizeof entry.offset, 1, stream) == 1 &&
+             entry.offset <= index->file_size &&
+             fread(&key_count, sizeof key_count, 1, stream) == 1 &&
+             key_count >= 0;
+        for (int32_t key = 0; ok && key < key_count; key++) {
+            std::string name, value;
+            ok = rms_index_fread_string(stream, name) &&
+                 rms_index_fread_string(stream, value);
+            if (ok)
+                entry.char_keys.emplace_back(std::move(name),
+                                             std::move(value));
+        }
+        if (ok)
+            index->tags.push_back(std::move(entry));
+    }
+    fclose(stream);
+
+    if (!ok)
+        index->tags.clear();
+    else
+        index->endian_convert = endian_convert;
+    return ok;
+}
+
+/** Best effort, atomic via temp file + rename; a failed write just
+    means the next open rebuilds the index from the file. */
+static void rms_file_write_index(const char *index_file,
+                                 const char *data_file,
+                                 const rms_file_index *index) {
+    char *tmp_file =
+        (char *)util_alloc_sprintf("%s.%d", index_file, (int)getpid());
+    FILE *stream = fopen(tmp_file, "w");
+    if (stream == NULL) {
+        free(tmp_file);
+        return;
+    }
+
+    int32_t version = RMS_INDEX_VERSION;
+    int64_t mtime = util_file_mtime(data_file);
+    int64_t size = util_file_size(data_file);
+    int8_t endian_convert = index->endian_convert;
+    int32_t tag_count = index->tags.size();
+    bool ok = fwrite(&version, sizeof version, 1, stream) == 1 &&
+              fwrite(&mtime, sizeof mtime, 1, stream) == 1 &&
+              fwrite(&size, sizeof size, 1, stream) == 1 &&
+              fwrite(&endian_convert, sizeof endian_convert, 1, stream) == 1 &&
+              fwrite(&tag_count, sizeof tag_count, 1, stream) == 1;
+
+    for (const auto &entry : index->tags) {
+        if (!ok)
+            break;
+        int32_t key_count = entry.char_keys.size();
+        ok = rms_index_fwrite_string(stream, entry.name) &&
+             fwrite(&entry.offset, sizeof entry.offset, 1, stream) == 1 &&
+             fwrite(&key_count, sizeof key_count, 1, stream) == 1;
+        for (const auto &[name, value] : entry.char_keys) {
+            if (!ok)
+                break;
+            ok = rms_index_fwrite_string(stream, name) &&
+                 rms_index_fwrite_string(stream, value);
+        }
+    }
+    fclose(stream);
+
+    if (!ok || rename(tmp_file, index_file) != 0)
+        remove(tmp_file);
+    free(tmp_file);
+}
+
+/** Map the file and build (or load) its tag index; subsequent tag
+    lookups reuse both until the handle is freed or renamed. */
+static rms_file_index *rms_file_ensure_index(rms_file_type *rms_file) {
+    if (rms_file->index != NULL)
+        return rms_file->index;
+
+    int fd = open(rms_file->filename, O_RDONLY);
+    if (fd < 0)
+        util_abort("%s: failed to open:%s - aborting \n", __func__,
+                   rms_file->filename);
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+    size_t file_size = file_stat.st_size;
+    void *mapping = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        util_abort("%s: failed to memory map:%s - aborting \n", __func__,
+                   rms_file->filename);
+
+    auto index = new rms_file_index;
+    index->mapping = mapping;
+    index->file_size = file_size;
+
+    char *index_file = rms_file_alloc_index_filename(rms_file);
+    if (!rms_file_load_index(index_file, rms_file->filename, index)) {
+        rms_file_scan_index(rms_file, index);
+        rms_file_write_index(index_file, rms_file->filename, index);
     }
+    free(index_file);
+
+    rms_file->fmt_file = false;
+    rms_file->endian_convert = index->endian_convert;
+    rms_file->index = index;
+    return index;
 }
 
 rms_tag_type *rms_file_fread_alloc_tag(rms_file_type *rms_file,
                                        const char *tagname, const char *keyname,
                                        const char *keyvalue) {
-    rms_tag_type *tag = NULL;
-    rms_file_fopen_r(rms_file);
-
-    long int start_pos = util_ftell(rms_file->stream);
-    fseek(rms_file->stream, 0, SEEK_SET);
-    rms_file_init_fread(rms_file);
-    while (true) {
-        bool eof_tag = false; // will be set by rms_tag
-        rms_tag_type *tmp_tag =
-            rms_tag_fread_alloc(rms_file->stream, rms_file->type_map,
-                                rms_file->endian_convert, &eof_tag);
-
-        if (!rms_tag_name_eq(tmp_tag, tagname, keyname, keyvalue)) {
-            rms_tag_free(tmp_tag);
+    rms_file_index *index = rms_file_ensure_index(rms_file);
+
+    const rms_indexed_tag *entry = NULL;
+    for (const auto &candidate : index->tags) {
+        if (candidate.name != tagname)
             continue;
+        if (keyname != NULL && keyvalue != NULL) {
+            bool key_match = false;
+            for (const auto &[name, value] : candidate.char_keys)
+                if (name == keyname) {
+                    key_match = value == keyvalue;
+                    break;
+                }
+            if (!key_match)
+                continue;
         }
-        tag = tmp_tag;
+        entry = &candidate;
         break;
     }
 
-    if (tag == NULL) {
-        fseek(rms_file->stream, start_pos, SEEK_SET);
+    if (entry == NULL)
         util_abort("%s: could not find tag: \"%s\" (with %s=%s) in file:%s - "
                    "aborting.\n",
                    __func__, tagname, keyname, keyvalue, rms_file->filename);
-    }
 
-    rms_file_fclose(rms_file);
+    rms_scan_cursor cursor = {(const char *)index->mapping, index->file_size,
+                              (size_t)entry->offset, rms_file->filename};
+    rms_tag_type *tag = rms_tag_alloc(entry->name.c_str());
+    for (;;) {
+        const char *header_string = rms_scan_string(&cursor);
+        if (strcmp(header_string, rms_endtag_string) == 0)
+            break;
+        rms_scan_tagkey key = rms_scan_tagkey_header(
+            &cursor, header_string, rms_file->type_map,
+            rms_file->endian_convert);
+        rms_tag_add_tagkey_owned(
+            tag, rms_tagkey_alloc_from_data(key.name, key.size, key.data_size,
+                                            key.rms_type, key.data,
+                                            rms_file->endian_convert));
+    }
     return tag;
 }
 
@@ -230,7 +598,110 @@ FILE *rms_file_fopen_w(rms_file_type *rms_file) {
     return rms_file->stream;
 }
 
+/** Join the in-flight background write and release its buffer. */
+static void rms_file_writer_wait(rms_file_writer *writer) {
+    if (writer->back_done.valid())
+        writer->back_done.wait();
+    free(writer->back_data);
+    writer->back_data = NULL;
+    writer->back_size = 0;
+}
+
+static void rms_file_writer_open_front(rms_file_writer *writer) {
+    writer->front = open_memstream(&writer->front_data, &writer->front_size);
+    if (writer->front == NULL)
+        util_abort("%s: failed to open write buffer \n", __func__);
+}
+
+/**
+   Hand the filled front buffer to a background write and open a fresh
+   front buffer. The previous background write (if any) is joined
+   first, so at most one buffer is in flight.
+*/
+static void rms_file_writer_swap(rms_file_writer *writer) {
+    fclose(writer->front);
+    writer->front = NULL;
+
+    rms_file_writer_wait(writer);
+    writer->back_data = writer->front_data;
+    writer->back_size = writer->front_size;
+    writer->front_data = NULL;
+    writer->front_size = 0;
+
+    if (writer->back_size > 0 && !writer->failed)
+        writer->back_done = ert::global_pool().submit([writer] {
+            const char *data = writer->back_data;
+            size_t left = writer->back_size;
+            while (left > 0) {
+                ssize_t count = write(writer->fd, data, left);
+                if (count < 0) {
+                    writer->failed = true;
+                    return;
+                }
+                data += count;
+                left -= count;
+                writer->written += count;
+            }
+        });
+
+    rms_file_writer_open_front(writer);
+}
+
+/**
+   Open @rms_file for writing with double buffering: the returned
+   stream is an in-memory front buffer, and rms_file_fwrite_flush()
+   hands completed buffers to a background write. @size_hint is the
+   expected final file size, used to preallocate the output so the
+   background writes do not fight the filesystem over extents; the
+   file is trimmed back to the actual size on close.
+*/
+FILE *rms_file_fopen_w_async(rms_file_type *rms_file, size_t size_hint) {
+    rms_file_writer *writer = new rms_file_writer;
+    writer->target = mkdir_fopen(fs::path(rms_file->filename), "w");
+    writer->fd = fileno(writer->target);
+    if (size_hint > 0)
+        /* Best effort - not all filesystems support preallocation. */
+        posix_fallocate(writer->fd, 0, size_hint);
+    rms_file_writer_open_front(writer);
+
+    rms_file->writer = writer;
+    rms_file->stream = writer->front;
+    return rms_file->stream;
+}
+
+/**
+   Start a background write of everything serialized since the
+   previous flush. Call between parameters; note that the stream
+   returned by rms_file_get_FILE() changes across the call.
+*/
+void rms_file_fwrite_flush(rms_file_type *rms_file) {
+    if (rms_file->writer == NULL)
+        return;
+    rms_file_writer_swap(rms_file->writer);
+    rms_file->stream = rms_file->writer->front;
+}
+
 void rms_file_fclose(rms_file_type *rms_file) {
+    if (rms_file->writer != NULL) {
+        rms_file_writer *writer = rms_file->writer;
+        rms_file_writer_swap(writer);
+        rms_file_writer_wait(writer);
+        fclose(writer->front);
+        free(writer->front_data);
+
+        if (writer->failed)
+            util_abort("%s: failed to write to file:%s \n", __func__,
+                       rms_file->filename);
+        /* Drop whatever the preallocation added beyond the payload. */
+        if (ftruncate(writer->fd, writer->written) != 0)
+            util_abort("%s: failed to truncate file:%s \n", __func__,
+                       rms_file->filename);
+        fclose(writer->target);
+        delete writer;
+        rms_file->writer = NULL;
+        rms_file->stream = NULL;
+        return;
+    }
     fclose(rms_file->stream);
     rms_file->stream = NULL;
 }
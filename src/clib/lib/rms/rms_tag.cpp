@@ -130,6 +130,10 @@ void rms_tag_add_tagkey(rms_tag_type *tag, const rms_tagkey_type *tagkey,
     }
 }
 
+void rms_tag_add_tagkey_owned(rms_tag_type *tag, rms_tagkey_type *tagkey) {
+    rms_tag_add_tagkey(tag, tagkey, OWNED_REF);
+}
+
 static bool rms_tag_at_endtag(FILE *stream) {
     const int init_pos = util_ftell(stream);
     bool at_endtag = false;
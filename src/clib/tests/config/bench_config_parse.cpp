@@ -0,0 +1,237 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+#include "catch2/catch.hpp"
+#include <fmt/format.h>
+
+#include "../tmpdir.hpp"
+
+#include <ert/config/conf.hpp>
+#include <ert/config/config_content.hpp>
+#include <ert/config/config_parser.hpp>
+#include <ert/enkf/enkf_obs.hpp>
+
+namespace fs = std::filesystem;
+using clock_type = std::chrono::steady_clock;
+
+/*
+  Process-wide allocation counters. The replacement operator new/delete
+  only count and forward to malloc/free, so linking this translation
+  unit into the test binary does not change behaviour - but the
+  benchmarks below can report how many heap allocations a parse issued,
+  which is the metric the parser-performance work moves.
+*/
+static std::atomic<long long> g_alloc_calls{0};
+static std::atomic<long long> g_alloc_bytes{0};
+
+void *operator new(std::size_t size) {
+    g_alloc_calls.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *ptr = malloc(size))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { free(ptr); }
+
+namespace {
+
+struct alloc_snapshot {
+    long long calls;
+    long long bytes;
+};
+
+alloc_snapshot take_alloc_snapshot() {
+    return {g_alloc_calls.load(), g_alloc_bytes.load()};
+}
+
+/**
+   Parse throughput report shared by the benchmarks: wall time, input
+   volume and the allocation traffic between the two snapshots.
+*/
+void report(const char *corpus, double seconds, size_t input_bytes,
+            long lines, const alloc_snapshot &before,
+            const alloc_snapshot &after) {
+    fmt::print("corpus:          {}\n", corpus);
+    fmt::print("input:           {:.1f} MB, {} lines\n",
+               input_bytes / 1048576.0, lines);
+    fmt::print("wall time:       {:.3f} s\n", seconds);
+    fmt::print("throughput:      {:.1f} MB/s, {:.0f} lines/s\n",
+               input_bytes / 1048576.0 / seconds, lines / seconds);
+    fmt::print("allocations:     {} calls, {:.1f} MB\n",
+               after.calls - before.calls,
+               (after.bytes - before.bytes) / 1048576.0);
+    fmt::print("\n");
+}
+
+size_t file_size(const char *filename) { return fs::file_size(filename); }
+
+/**
+   A master-config-sized corpus: a schema of 200 keywords with mixed
+   argument types and a file drawing 50k keyword lines from it, plus
+   DEFINE substitutions on every tenth line. The shape (many distinct
+   keywords, few arguments each, heavy substitution) mirrors the large
+   field configs the parser sees in production.
+*/
+long write_master_config(const char *filename) {
+    std::ofstream stream{filename};
+    long lines = 0;
+    stream << "DEFINE <BASE> /some/path/on/a/share\n";
+    lines++;
+    for (int line = 0; line < 50000; line++) {
+        int kw = line % 200;
+        if (line % 10 == 0)
+            stream << fmt::format("KW_{:03d} <BASE>/real_{}/file_{}.txt {}\n",
+                                  kw, line, kw, line);
+        else
+            stream << fmt::format("KW_{:03d} value_{} {} {:.3f}\n", kw, line,
+                                  line % 7, line * 0.5);
+        lines++;
+    }
+    return lines;
+}
+
+config_parser_type *alloc_master_schema() {
+    config_parser_type *parser = config_alloc();
+    for (int kw = 0; kw < 200; kw++) {
+        config_schema_item_type *item = config_add_schema_item(
+            parser, fmt::format("KW_{:03d}", kw).c_str(), false);
+        config_schema_item_set_argc_minmax(item, 1, 3);
+    }
+    return parser;
+}
+
+/**
+   An INCLUDE chain of depth 64 with 500 keyword lines per file - the
+   deep include trees produced by generated per-realization configs.
+   Returns the total line count.
+*/
+long write_include_tree(const char *top_filename) {
+    const int depth = 64;
+    const int lines_per_file = 500;
+    long lines = 0;
+    for (int level = 0; level < depth; level++) {
+        std::string filename =
+            level == 0 ? top_filename : fmt::format("include_{}.txt", level);
+        std::ofstream stream{filename};
+        for (int line = 0; line < lines_per_file; line++) {
+            stream << fmt::format("KW_{:03d} level_{} {}\n",
+                                  (level * lines_per_file + line) % 200, level,
+                                  line);
+            lines++;
+        }
+        if (level + 1 < depth) {
+            stream << fmt::format("INCLUDE include_{}.txt\n", level + 1);
+            lines++;
+        }
+    }
+    return lines;
+}
+
+/**
+   A 100k-entry observation file for the conf.cpp parser - the corpus
+   size where observation parsing historically dominated startup.
+*/
+long write_observations(const char *filename) {
+    std::ofstream stream{filename};
+    long lines = 0;
+    for (int obs = 0; obs < 100000; obs++) {
+        stream << fmt::format("SUMMARY_OBSERVATION OBS_{}\n"
+                              "{{\n"
+                              "   VALUE   = {:.2f};\n"
+                              "   ERROR   = 0.05;\n"
+                              "   RESTART = {};\n"
+                              "   KEY     = WOPR:OP_{};\n"
+                              "}};\n",
+                              obs, obs * 0.01, obs % 200 + 1, obs % 50);
+        lines += 7;
+    }
+    return lines;
+}
+
+} // namespace
+
+/**
+  Hidden benchmarks (run explicitly with the [.benchmark] tag)
+  replaying generated corpora shaped like the recorded production
+  inputs through the two startup parsers, reporting parse throughput
+  and allocation counts. The corpora are synthesized on the fly - they
+  compress to nothing in the repository and their shape, not their
+  content, is what exercises the parser.
+*/
+TEST_CASE("config parser corpus replay", "[.benchmark]") {
+    WITH_TMPDIR;
+
+    {
+        long lines = write_master_config("master.ert");
+        config_parser_type *parser = alloc_master_schema();
+
+        auto before = take_alloc_snapshot();
+        auto start = clock_type::now();
+        config_content_type *content =
+            config_parse(parser, "master.ert", "--", "INCLUDE", "DEFINE",
+                         nullptr, CONFIG_UNRECOGNIZED_ERROR, true);
+        double seconds =
+            std::chrono::duration<double>(clock_type::now() - start).count();
+        auto after = take_alloc_snapshot();
+
+        REQUIRE(content != nullptr);
+        REQUIRE(config_content_is_valid(content));
+        report("master config", seconds, file_size("master.ert"), lines,
+               before, after);
+        config_content_free(content);
+        config_free(parser);
+    }
+
+    {
+        long lines = write_include_tree("top.ert");
+        size_t bytes = 0;
+        for (const auto &entry : fs::directory_iterator("."))
+            if (entry.path().extension() == ".txt" ||
+                entry.path().filename() == "top.ert")
+                bytes += entry.file_size();
+        config_parser_type *parser = alloc_master_schema();
+
+        auto before = take_alloc_snapshot();
+        auto start = clock_type::now();
+        config_content_type *content =
+            config_parse(parser, "top.ert", "--", "INCLUDE", "DEFINE", nullptr,
+                         CONFIG_UNRECOGNIZED_ERROR, true);
+        double seconds =
+            std::chrono::duration<double>(clock_type::now() - start).count();
+        auto after = take_alloc_snapshot();
+
+        REQUIRE(content != nullptr);
+        REQUIRE(config_content_is_valid(content));
+        report("deep include tree", seconds, bytes, lines, before, after);
+        config_content_free(content);
+        config_free(parser);
+    }
+}
+
+TEST_CASE("observation parser corpus replay", "[.benchmark]") {
+    WITH_TMPDIR;
+
+    long lines = write_observations("observations.txt");
+    conf_class_type *obs_class = enkf_obs_get_obs_conf_class();
+
+    auto before = take_alloc_snapshot();
+    auto start = clock_type::now();
+    conf_instance_type *instance = conf_instance_alloc_from_file(
+        obs_class, "enkf_conf", "observations.txt");
+    double seconds =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+    auto after = take_alloc_snapshot();
+
+    REQUIRE(instance != nullptr);
+    REQUIRE(conf_instance_validate(instance));
+    report("100k observations", seconds, file_size("observations.txt"), lines,
+           before, after);
+    conf_instance_free(instance);
+    conf_class_free(obs_class);
+}
@@ -0,0 +1,88 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include <ert/enkf/case_archive.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void write_file(const fs::path &filename, const std::string &content) {
+    fs::create_directories(filename.parent_path());
+    std::ofstream stream{filename, std::ios::binary};
+    stream << content;
+}
+
+std::string read_file(const fs::path &filename) {
+    std::ifstream stream{filename, std::ios::binary};
+    return {std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
+TEST_CASE("case archive round trip", "[case_archive]") {
+    WITH_TMPDIR;
+
+    /* A compressible file large enough for several values, an
+       incompressible-looking small file and a nested empty file -
+       the shapes a case directory contains. */
+    std::string big(512 * 1024, 'x');
+    for (size_t i = 0; i < big.size(); i += 7)
+        big[i] = 'a' + (i % 23);
+    write_file("case/Ensemble/mod_0/FORECAST.data_0", big);
+    write_file("case/files/state-map", std::string("\x01\x02\x03\x04", 4));
+    write_file("case/files/deep/nested/empty", "");
+
+    enkf_fs_export_archive("case", "case.eca");
+    REQUIRE(fs::file_size("case.eca") < big.size());
+
+    enkf_fs_import_archive("case.eca", "copy");
+    REQUIRE(read_file("copy/Ensemble/mod_0/FORECAST.data_0") == big);
+    REQUIRE(read_file("copy/files/state-map") ==
+            std::string("\x01\x02\x03\x04", 4));
+    REQUIRE(fs::is_regular_file("copy/files/deep/nested/empty"));
+    REQUIRE(fs::file_size("copy/files/deep/nested/empty") == 0);
+}
+
+TEST_CASE("case archive rejects foreign files", "[case_archive]") {
+    WITH_TMPDIR;
+    write_file("not_an_archive", "some random content");
+    REQUIRE_THROWS(enkf_fs_import_archive("not_an_archive", "copy"));
+}
+
+TEST_CASE("case archive rejects unsafe entry paths", "[case_archive]") {
+    WITH_TMPDIR;
+
+    /* Export a valid archive and then tamper with the index: the
+       entry path is replaced by an equally long hostile one, as a
+       corrupt or malicious .eca transferred from another machine
+       could carry. */
+    write_file("case/abcdefg", "payload");
+    enkf_fs_export_archive("case", "case.eca");
+    std::string archive = read_file("case.eca");
+    REQUIRE(archive.find("abcdefg") != std::string::npos);
+
+    SECTION("a .. component must not escape the case directory") {
+        std::string tampered = archive;
+        tampered.replace(tampered.find("abcdefg"), 7, "../evil");
+        write_file("slip.eca", tampered);
+
+        REQUIRE_THROWS(enkf_fs_import_archive("slip.eca", "copy"));
+        REQUIRE(!fs::exists(fs::current_path().parent_path() / "evil"));
+    }
+
+    SECTION("an absolute path must not replace the case directory") {
+        std::string tampered = archive;
+        tampered.replace(tampered.find("abcdefg"), 7, "/abcdef");
+        write_file("abs.eca", tampered);
+
+        REQUIRE_THROWS(enkf_fs_import_archive("abs.eca", "copy"));
+        REQUIRE(!fs::exists("/abcdef"));
+    }
+}
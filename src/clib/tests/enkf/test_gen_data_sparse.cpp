@@ -0,0 +1,106 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/gen_data_config.hpp>
+#include <ert/util/buffer.h>
+
+#include "../tmpdir.hpp"
+
+enkf_fs_type *enkf_fs_alloc_empty(const char *mount_point,
+                                  unsigned ensemble_size, bool read_only);
+void enkf_fs_init_path_fmt(enkf_fs_type *fs);
+void enkf_fs_set_read_only(enkf_fs_type *fs, bool read_only);
+void enkf_fs_umount(enkf_fs_type *fs);
+gen_data_type *gen_data_alloc(const gen_data_config_type *config);
+bool gen_data_write_to_buffer(const gen_data_type *gen_data,
+                              buffer_type *buffer, int report_step);
+void gen_data_read_from_buffer(gen_data_type *gen_data, buffer_type *buffer,
+                               enkf_fs_type *fs, int report_step);
+
+namespace {
+void write_response(const std::string &filename, int size,
+                    const std::vector<int> &active) {
+    std::ofstream data(filename);
+    for (int i = 0; i < size; i++)
+        data << (i + 1) * 0.5 << "\n";
+
+    if (!active.empty()) {
+        std::ofstream mask(filename + "_active");
+        for (int i = 0; i < size; i++)
+            mask << active[i] << "\n";
+    }
+}
+} // namespace
+
+TEST_CASE("gen_data sparse storage round trip", "[gen_data]") {
+    WITH_TMPDIR;
+    const int size = 100;
+    const int report_step = 1;
+    auto fs = enkf_fs_alloc_empty(std::filesystem::current_path().c_str(), 1,
+                                  false);
+    enkf_fs_init_path_fmt(fs);
+
+    auto config = gen_data_config_alloc_GEN_DATA_result("SPARSE_QC", ASCII);
+
+    SECTION("sparse vector stores only the active elements") {
+        // Two active runs - 10% of the elements are active.
+        std::vector<int> active(size, 0);
+        for (int i = 20; i < 25; i++)
+            active[i] = 1;
+        for (int i = 70; i < 75; i++)
+            active[i] = 1;
+        write_response("RESPONSE", size, active);
+
+        auto node = gen_data_alloc(config);
+        REQUIRE(gen_data_forward_load(node, "RESPONSE", report_step, fs));
+
+        buffer_type *buffer = buffer_alloc(1024);
+        REQUIRE(gen_data_write_to_buffer(node, buffer, report_step));
+        // The slot holding the (unused) report step is negative in the
+        // sparse encoding.
+        REQUIRE(((const int *)buffer_get_data(buffer))[2] < 0);
+
+        auto loaded = gen_data_alloc(config);
+        buffer_rewind(buffer);
+        gen_data_read_from_buffer(loaded, buffer, fs, report_step);
+        for (int i = 0; i < size; i++) {
+            if (active[i])
+                REQUIRE(gen_data_iget_double(loaded, i) ==
+                        gen_data_iget_double(node, i));
+            else
+                REQUIRE(gen_data_iget_double(loaded, i) == 0.0);
+        }
+        buffer_free(buffer);
+        gen_data_free(loaded);
+        gen_data_free(node);
+    }
+
+    SECTION("fully active vector keeps the dense layout") {
+        write_response("RESPONSE", size, {});
+
+        auto node = gen_data_alloc(config);
+        REQUIRE(gen_data_forward_load(node, "RESPONSE", report_step, fs));
+
+        buffer_type *buffer = buffer_alloc(1024);
+        REQUIRE(gen_data_write_to_buffer(node, buffer, report_step));
+        REQUIRE(((const int *)buffer_get_data(buffer))[2] == report_step);
+
+        auto loaded = gen_data_alloc(config);
+        buffer_rewind(buffer);
+        gen_data_read_from_buffer(loaded, buffer, fs, report_step);
+        for (int i = 0; i < size; i++)
+            REQUIRE(gen_data_iget_double(loaded, i) ==
+                    gen_data_iget_double(node, i));
+        buffer_free(buffer);
+        gen_data_free(loaded);
+        gen_data_free(node);
+    }
+
+    gen_data_config_free(config);
+    enkf_fs_set_read_only(fs, true);
+    enkf_fs_umount(fs);
+}
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include <fmt/format.h>
+
+#include "../tmpdir.hpp"
+
+#include <ert/job_queue/job_node.hpp>
+#include <ert/job_queue/queue_driver.hpp>
+
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+
+/**
+  Synthetic in-process driver used to benchmark the queue machinery
+  without a real queue system. Submit latency, run duration and failure
+  rate are configurable, so the node submit/refresh path - the part the
+  Python run loop drives - can be measured in isolation.
+*/
+struct mock_job {
+    clock_type::time_point done_time;
+    bool done_reported = false;
+};
+
+struct mock_driver_state {
+    std::chrono::microseconds submit_latency{20};
+    std::chrono::microseconds min_duration{0};
+    std::chrono::microseconds max_duration{2000};
+    /** Fraction of submits which fail (driver returns NULL). */
+    double failure_rate = 0.01;
+
+    std::mutex table_lock;
+    std::mt19937 rng{42};
+    /** Microseconds from a job completing in the driver until a status
+     * poll observed the completion; one entry per job. */
+    std::vector<double> transition_latencies;
+    std::atomic<long> submit_calls{0};
+    std::atomic<long> failed_submits{0};
+    std::atomic<long> status_calls{0};
+    /** Number of times a caller found table_lock already held. */
+    std::atomic<long> lock_collisions{0};
+};
+
+void mock_lock(mock_driver_state *state, std::unique_lock<std::mutex> &guard) {
+    guard = std::unique_lock{state->table_lock, std::try_to_lock};
+    if (!guard.owns_lock()) {
+        state->lock_collisions++;
+        guard.lock();
+    }
+}
+
+void *mock_submit(void *data, const char *cmd, int num_cpu,
+                  const char *run_path, const char *job_name, int argc,
+                  const char **argv) {
+    auto state = static_cast<mock_driver_state *>(data);
+    state->submit_calls++;
+    if (state->submit_latency.count() > 0)
+        std::this_thread::sleep_for(state->submit_latency);
+
+    std::unique_lock<std::mutex> guard;
+    mock_lock(state, guard);
+    if (std::uniform_real_distribution<>{0, 1}(state->rng) <
+        state->failure_rate) {
+        state->failed_submits++;
+        return nullptr;
+    }
+    std::uniform_int_distribution<long> duration{state->min_duration.count(),
+                                                 state->max_duration.count()};
+    auto job = new mock_job;
+    job->done_time =
+        clock_type::now() + std::chrono::microseconds{duration(state->rng)};
+    return job;
+}
+
+job_status_type mock_get_status(void *data, void *__job) {
+    auto state = static_cast<mock_driver_state *>(data);
+    auto job = static_cast<mock_job *>(__job);
+    state->status_calls++;
+
+    std::unique_lock<std::mutex> guard;
+    mock_lock(state, guard);
+    auto now = clock_type::now();
+    if (now < job->done_time)
+        return JOB_QUEUE_RUNNING;
+
+    if (!job->done_reported) {
+        job->done_reported = true;
+        state->transition_latencies.push_back(
+            std::chrono::duration<double, std::micro>(now - job->done_time)
+                .count());
+    }
+    return JOB_QUEUE_DONE;
+}
+
+void mock_kill(void *data, void *__job) {
+    auto job = static_cast<mock_job *>(__job);
+    job->done_time = clock_type::now();
+}
+
+void mock_free_job(void *__job) { delete static_cast<mock_job *>(__job); }
+
+double percentile_us(std::vector<double> &samples, double fraction) {
+    if (samples.empty())
+        return 0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1,
+                            (size_t)(fraction * (double)samples.size()));
+    return samples[index];
+}
+
+} // namespace
+
+/**
+  Hidden benchmark (run explicitly with the [.benchmark] tag): pushes
+  10k jobs through job_queue_node_submit_simple() / refresh_status()
+  from a pool of poller threads, mimicking the per-node monitor threads
+  on the Python side, and reports dispatch throughput, the latency from
+  a job completing in the driver until a poll observes it, and
+  contention on the driver table lock.
+*/
+TEST_CASE("queue scalability with mock driver", "[.benchmark]") {
+    WITH_TMPDIR;
+    const int num_jobs = 10000;
+    const int num_pollers = 32;
+
+    mock_driver_state state;
+    queue_driver_type *driver = queue_driver_alloc_mock(
+        mock_submit, mock_get_status, mock_kill, mock_free_job, &state);
+
+    const char *argv[] = {"arg"};
+    std::vector<job_queue_node_type *> nodes;
+    for (int i = 0; i < num_jobs; i++) {
+        auto name = fmt::format("bench_job_{}", i);
+        nodes.push_back(
+            job_queue_node_alloc_simple(name.c_str(), ".", "cmd", 1, argv));
+        REQUIRE(nodes.back() != nullptr);
+    }
+
+    auto submit_start = clock_type::now();
+    std::atomic<long> resubmits{0};
+    std::atomic<long> dispatched{0};
+    std::atomic<double> dispatch_seconds{0};
+
+    // Each poller owns a shard of the nodes: submit them all, then
+    // poll until every job in the shard has been observed DONE.
+    std::vector<std::thread> pollers;
+    for (int it = 0; it < num_pollers; it++)
+        pollers.emplace_back([&, it] {
+            std::vector<int> shard;
+            for (int i = it; i < num_jobs; i += num_pollers)
+                shard.push_back(i);
+
+            for (int i : shard) {
+                while (job_queue_node_submit_simple(nodes[i], driver) !=
+                       SUBMIT_OK)
+                    resubmits++;
+            }
+            if (dispatched.fetch_add(shard.size()) + (long)shard.size() ==
+                num_jobs)
+                dispatch_seconds = std::chrono::duration<double>(
+                                       clock_type::now() - submit_start)
+                                       .count();
+
+            std::vector<bool> done(shard.size(), false);
+            size_t remaining = shard.size();
+            while (remaining > 0) {
+                for (size_t j = 0; j < shard.size(); j++) {
+                    if (done[j])
+                        continue;
+                    if (job_queue_node_refresh_status(nodes[shard[j]],
+                                                      driver) ==
+                        JOB_QUEUE_DONE) {
+                        done[j] = true;
+                        remaining--;
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+            }
+        });
+    for (auto &poller : pollers)
+        poller.join();
+
+    auto total_seconds =
+        std::chrono::duration<double>(clock_type::now() - submit_start)
+            .count();
+
+    fmt::print("jobs:               {}\n", num_jobs);
+    fmt::print("dispatch:           {:.0f} jobs/s\n",
+               num_jobs / std::max(dispatch_seconds.load(), 1e-9));
+    fmt::print("total wall time:    {:.2f} s\n", total_seconds);
+    fmt::print("transition p50:     {:.0f} us\n",
+               percentile_us(state.transition_latencies, 0.50));
+    fmt::print("transition p90:     {:.0f} us\n",
+               percentile_us(state.transition_latencies, 0.90));
+    fmt::print("transition p99:     {:.0f} us\n",
+               percentile_us(state.transition_latencies, 0.99));
+    fmt::print("failed submits:     {} (resubmitted {})\n",
+               state.failed_submits.load(), resubmits.load());
+    fmt::print("status calls:       {}\n", state.status_calls.load());
+    fmt::print("lock collisions:    {}\n", state.lock_collisions.load());
+
+    REQUIRE((long)state.transition_latencies.size() == num_jobs);
+    REQUIRE(state.submit_calls.load() == num_jobs + resubmits.load());
+
+    for (auto node : nodes) {
+        job_queue_node_free_driver_data(node, driver);
+        job_queue_node_free(node);
+    }
+    queue_driver_free(driver);
+}
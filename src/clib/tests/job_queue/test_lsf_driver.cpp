@@ -6,6 +6,8 @@
 
 #include "catch2/catch.hpp"
 
+#include <ert/job_queue/lsf_driver.hpp>
+
 #include "../tmpdir.hpp"
 
 namespace fs = std::filesystem;
@@ -39,3 +41,63 @@ TEST_CASE("parse hostnames lsf", "[lsf]") {
                                          "hname4", "hname5"});
     }
 }
+
+TEST_CASE("submit job array", "[lsf]") {
+    WITH_TMPDIR;
+    auto cwd = fs::current_path();
+
+    // A stub bsub which records its argument list and answers like LSF.
+    fs::path bsub = cwd / "mock_bsub";
+    {
+        std::ofstream stream{bsub};
+        stream << "#!/bin/sh\n"
+               << "echo \"$@\" >> " << (cwd / "bsub_args.log").string() << "\n"
+               << "echo \"Job <7001> is submitted to default queue "
+                  "<normal>.\"\n";
+    }
+    fs::permissions(bsub, fs::perms::owner_all);
+
+    std::vector<std::string> run_paths;
+    for (int i = 0; i < 3; i++) {
+        run_paths.push_back((cwd / ("run_" + std::to_string(i))).string());
+        fs::create_directory(run_paths.back());
+    }
+    std::vector<const char *> run_path_ptrs;
+    for (const auto &path : run_paths)
+        run_path_ptrs.push_back(path.c_str());
+
+    void *driver = lsf_driver_alloc();
+    lsf_driver_set_option(driver, LSF_SERVER, LOCAL_LSF_SERVER);
+    lsf_driver_set_option(driver, LSF_BSUB_CMD, bsub.c_str());
+
+    void *jobs[3] = {nullptr, nullptr, nullptr};
+    int submitted = lsf_driver_submit_job_array(
+        driver, "script.sh", 1, "TESTJOB", 3, run_path_ptrs.data(), jobs);
+
+    REQUIRE(submitted == 3);
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(jobs[i] != nullptr);
+        REQUIRE(lsf_job_get_jobnr((lsf_job_type *)jobs[i]) == 7001);
+        // Each member gets its own lsf_info.json so the forward model
+        // can find its job id, exactly as for one-by-one submission.
+        REQUIRE(fs::exists(fs::path(run_paths[i]) / "lsf_info.json"));
+        lsf_driver_free_job(jobs[i]);
+    }
+
+    // A single bsub invocation carrying the array job name, plus the
+    // member list file the elements select their run path from.
+    std::ifstream log{cwd / "bsub_args.log"};
+    std::string line;
+    std::string first_line;
+    int invocations = 0;
+    while (std::getline(log, line)) {
+        if (invocations == 0)
+            first_line = line;
+        invocations++;
+    }
+    REQUIRE(invocations == 1);
+    REQUIRE(first_line.find("TESTJOB[1-3]") != std::string::npos);
+    REQUIRE(fs::exists(fs::path(run_paths[0]) / "TESTJOB.LSF-array"));
+
+    lsf_driver_free__(driver);
+}
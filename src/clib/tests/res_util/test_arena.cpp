@@ -0,0 +1,55 @@
+#include "catch2/catch.hpp"
+#include <cstdint>
+#include <cstring>
+
+#include <ert/res_util/arena.hpp>
+
+using ert::utils::Arena;
+using ert::utils::ArenaScope;
+
+TEST_CASE("Arena scoped reset reuses memory", "[res_util]") {
+    Arena arena(1024);
+
+    void *first;
+    {
+        ArenaScope scope(arena);
+        first = arena.allocate(100);
+        memset(first, 0xab, 100);
+    }
+    {
+        ArenaScope scope(arena);
+        /* The scope above was rewound, so the same bytes come back. */
+        void *second = arena.allocate(100);
+        REQUIRE(second == first);
+    }
+    REQUIRE(arena.capacity() == 1024);
+}
+
+TEST_CASE("Arena grows past the chunk size", "[res_util]") {
+    Arena arena(64);
+
+    ArenaScope outer(arena);
+    char *small = arena.allocate_array<char>(16);
+    /* Larger than the chunk - lands in a dedicated chunk without
+       touching earlier allocations. */
+    char *large = arena.allocate_array<char>(1000);
+    memset(small, 1, 16);
+    memset(large, 2, 1000);
+    REQUIRE(small[15] == 1);
+    REQUIRE(large[999] == 2);
+    REQUIRE(arena.capacity() >= 1000 + 16);
+
+    {
+        ArenaScope inner(arena);
+        arena.allocate(32);
+    }
+    /* The inner scope rewound to just after 'large'. */
+    REQUIRE(arena.allocate(32) != nullptr);
+}
+
+TEST_CASE("Arena allocations are aligned", "[res_util]") {
+    Arena arena;
+    arena.allocate(1);
+    auto address = reinterpret_cast<uintptr_t>(arena.allocate_array<double>(4));
+    REQUIRE(address % alignof(double) == 0);
+}
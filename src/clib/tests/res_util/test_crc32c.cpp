@@ -0,0 +1,40 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <ert/res_util/crc32c.hpp>
+
+using ert::utils::crc32c;
+
+TEST_CASE("crc32c matches the published check values", "[crc32c]") {
+    /* The standard CRC32C check value from the Rocksoft model. */
+    REQUIRE(crc32c("123456789", 9) == 0xE3069283);
+    REQUIRE(crc32c("", 0) == 0);
+}
+
+TEST_CASE("crc32c detects single bit flips", "[crc32c]") {
+    std::string data = "The quick brown fox jumps over the lazy dog";
+    uint32_t reference = crc32c(data.data(), data.size());
+    REQUIRE(reference == 0x22620404);
+
+    for (size_t index = 0; index < data.size(); index++) {
+        std::string corrupt = data;
+        corrupt[index] ^= 1;
+        REQUIRE(crc32c(corrupt.data(), corrupt.size()) != reference);
+    }
+}
+
+TEST_CASE("crc32c is independent of buffer alignment", "[crc32c]") {
+    std::vector<char> payload(4099);
+    for (size_t index = 0; index < payload.size(); index++)
+        payload[index] = static_cast<char>(index * 31 + 7);
+    uint32_t reference = crc32c(payload.data(), payload.size());
+
+    std::vector<char> shifted(payload.size() + 8);
+    for (size_t offset = 1; offset < 8; offset++) {
+        std::memcpy(shifted.data() + offset, payload.data(), payload.size());
+        REQUIRE(crc32c(shifted.data() + offset, payload.size()) == reference);
+    }
+}
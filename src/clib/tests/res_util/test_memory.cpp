@@ -89,3 +89,22 @@ TEST_CASE("simple memory logger test", "[res_util]") {
     REQUIRE(logger->calls[1].find("(-100)") != std::string::npos);
     REQUIRE(logger->calls[1].find("(+100)") != std::string::npos);
 }
+
+TEST_CASE("Tagged memory accounting", "[res_util]") {
+    auto &account = ert::utils::memory_account("test.account");
+    REQUIRE(&ert::utils::memory_account("test.account") == &account);
+
+    account.allocate(10 << 20);
+    REQUIRE(account.current() == 10 << 20);
+    {
+        ert::utils::MemoryScope charge(account, 5 << 20);
+        REQUIRE(account.current() == 15 << 20);
+        REQUIRE(account.peak() >= 15 << 20);
+    }
+    REQUIRE(account.current() == 10 << 20);
+    account.release(10 << 20);
+    REQUIRE(account.current() == 0);
+
+    REQUIRE(ert::utils::memory_report().find("test.account") !=
+            std::string::npos);
+}
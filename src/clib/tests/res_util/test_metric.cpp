@@ -22,3 +22,41 @@ TEST_CASE("simple time benchmark test", "[res_util]") {
     REQUIRE(std::regex_search(logger->calls[0], std::regex("2\\.\\d{4}")));
     REQUIRE(logger->calls[0].find("some_function's") != std::string::npos);
 }
+
+TEST_CASE("Metrics registry", "[res_util]") {
+    auto &registry = ert::metrics::registry();
+
+    auto &counter = registry.counter("test.counter");
+    counter.add();
+    counter.add(41);
+    REQUIRE(counter.value() == 42);
+    // Same name resolves to the same counter
+    REQUIRE(&registry.counter("test.counter") == &counter);
+
+    auto &histogram = registry.histogram("test.latency");
+    {
+        ert::metrics::ScopedTimer timer(histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(histogram.count() == 1);
+    // At least the slept millisecond, in nanoseconds
+    REQUIRE(histogram.sum() >= 1000000);
+
+    auto json = registry.dump_json();
+    REQUIRE(json.find("\"test.counter\": 42") != std::string::npos);
+    REQUIRE(json.find("\"test.latency\"") != std::string::npos);
+}
+
+TEST_CASE("Histogram buckets", "[res_util]") {
+    ert::metrics::Histogram histogram;
+    histogram.record(0);
+    histogram.record(1);
+    histogram.record(7);
+    histogram.record(8);
+    REQUIRE(histogram.count() == 4);
+    REQUIRE(histogram.sum() == 16);
+    REQUIRE(histogram.bucket(0) == 2); // 0 and 1
+    REQUIRE(histogram.bucket(2) == 1); // [4, 8)
+    REQUIRE(histogram.bucket(3) == 1); // [8, 16)
+    REQUIRE(ert::metrics::Histogram::bucket_bound(2) == 7);
+}
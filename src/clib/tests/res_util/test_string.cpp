@@ -121,6 +121,28 @@ TEST_CASE("Back element", "[res_util]") {
     }
 }
 
+TEST_CASE("String interning", "[res_util]") {
+    GIVEN("Two separate strings with equal content") {
+        std::string first{"WOPR:OP_1"};
+        std::string second{"WOPR:OP_1"};
+        REQUIRE(first.data() != second.data());
+
+        THEN("Interning both returns the same pointer") {
+            REQUIRE(ert::intern(first) == ert::intern(second));
+        }
+
+        THEN("The interned string compares equal to the original") {
+            REQUIRE(ert::intern(first) == std::string_view{first});
+        }
+    }
+
+    GIVEN("Strings with different content") {
+        THEN("Interning returns distinct pointers") {
+            REQUIRE(ert::intern("foo") != ert::intern("bar"));
+        }
+    }
+}
+
 TEST_CASE("Join string", "[res_util]") {
     GIVEN("An empty std::array") {
         std::array<std::string, 0> strs;
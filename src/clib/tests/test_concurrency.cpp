@@ -0,0 +1,44 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/concurrency.hpp>
+
+TEST_CASE("ThreadPool parallel_for covers the range once", "[concurrency]") {
+    ert::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallel_for(visits.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            visits[i]++;
+    });
+    for (const auto &count : visits)
+        REQUIRE(count == 1);
+}
+
+TEST_CASE("ThreadPool nested parallel_for does not deadlock",
+          "[concurrency]") {
+    ert::ThreadPool pool(2);
+    std::atomic<int> total{0};
+    auto future = pool.submit([&] {
+        pool.parallel_for(100, 10,
+                          [&](size_t begin, size_t end) {
+                              total += (int)(end - begin);
+                          });
+    });
+    future.get();
+    REQUIRE(total == 100);
+}
+
+TEST_CASE("ThreadPool parallel_for propagates exceptions", "[concurrency]") {
+    ert::ThreadPool pool(2);
+    REQUIRE_THROWS_AS(pool.parallel_for(
+                          100, 1,
+                          [](size_t begin, size_t) {
+                              if (begin == 42)
+                                  throw std::runtime_error("boom");
+                          }),
+                      std::runtime_error);
+}
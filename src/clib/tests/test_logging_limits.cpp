@@ -0,0 +1,49 @@
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "logger_mock.hpp"
+
+namespace {
+class DisabledLogger : public MockLogger {
+public:
+    bool enabled(Level level) override { return false; }
+};
+} // namespace
+
+TEST_CASE("Disabled levels short-circuit before formatting",
+          "[logging]") {
+    DisabledLogger logger;
+    logger.debug("never formatted {}", 1);
+    logger.info("never formatted {}", 2);
+    REQUIRE(logger.calls.empty());
+}
+
+TEST_CASE("Rate limited logging reports a suppression count",
+          "[logging]") {
+    MockLogger logger;
+    ert::LogSite site;
+
+    for (int i = 0; i < 5; i++)
+        logger.debug_limited(site, 2, "message {}", i);
+    REQUIRE(logger.calls.size() == 2);
+    REQUIRE(logger.calls[0] == "message 0");
+    REQUIRE(logger.calls[1] == "message 1");
+
+    /* Force a new rate window instead of sleeping out the second. */
+    site.window_start = 0;
+    logger.debug_limited(site, 2, "message {}", 5);
+    REQUIRE(logger.calls.size() == 3);
+    REQUIRE(logger.calls[2] == "message 5 [3 similar messages suppressed]");
+}
+
+TEST_CASE("Sampled logging emits every n'th call", "[logging]") {
+    MockLogger logger;
+    ert::LogSite site;
+
+    for (int i = 0; i < 7; i++)
+        logger.debug_sampled(site, 3, "message {}", i);
+    REQUIRE(logger.calls ==
+            std::vector<std::string>{"message 0", "message 3", "message 6"});
+}
@@ -95,6 +95,7 @@ class AnalysisModule:
         self.name = name
         self.iterable = iterable
         self._variables = variables
+        self._explicit_inversion = False
 
     @classmethod
     def ens_smoother_module(cls, name: str = "STD_ENKF"):
@@ -170,6 +171,8 @@ class AnalysisModule:
                     )
                 else:
                     var["value"] = new_value
+                if var_name == "IES_INVERSION":
+                    self._explicit_inversion = True
 
             except ValueError:
                 raise ValueError(
@@ -179,6 +182,14 @@ class AnalysisModule:
         else:
             raise KeyError(f"Variable {var_name} not found in module")
 
+    @property
+    def explicit_inversion(self) -> bool:
+        """Whether an inversion algorithm was configured explicitly, as
+        opposed to the module running with the default. The update can
+        pick a better suited algorithm for the problem dimensions when
+        the user did not ask for a specific one."""
+        return self._explicit_inversion
+
     @property
     def inversion(self):
         return self.get_variable_value("IES_INVERSION")
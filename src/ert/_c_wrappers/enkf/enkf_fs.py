@@ -31,11 +31,16 @@ class EnkfFs(BaseCClass):
         "void*   enkf_fs_create_fs(char* , enkf_fs_type_enum ,int, bool)",
         bind=False,
     )
+    _create_cow = ResPrototype(
+        "void*   enkf_fs_create_cow_fs(char* , char* , enkf_fs_type_enum ,int, bool)",
+        bind=False,
+    )
     _get_time_map = ResPrototype("time_map_ref  enkf_fs_get_time_map(enkf_fs)")
     _summary_key_set = ResPrototype(
         "summary_key_set_ref enkf_fs_get_summary_key_set(enkf_fs)"
     )
     _umount = ResPrototype("void enkf_fs_umount(enkf_fs)")
+    _umount_async = ResPrototype("void enkf_fs_umount_async(enkf_fs)")
 
     def __init__(
         self,
@@ -82,11 +87,38 @@ class EnkfFs(BaseCClass):
         cls._create(path.as_posix(), fs_type, ensemble_size, False)
         return cls(path, ensemble_config, ensemble_size, read_only=read_only)
 
+    @classmethod
+    def createCopyOnWriteFileSystem(
+        cls,
+        path: Union[str, Path],
+        parent_path: Union[str, Path],
+        ensemble_config: "EnsembleConfig",
+        ensemble_size: int,
+        read_only: bool = False,
+    ) -> "EnkfFs":
+        """Create a case which branches off the case at parent_path:
+        nodes not written here are read from the parent, so only the
+        deltas (e.g. updated parameters) are stored."""
+        path = Path(path).absolute()
+        parent_path = Path(parent_path).absolute()
+        fs_type = EnKFFSType.BLOCK_FS_DRIVER_ID
+        cls._create_cow(
+            path.as_posix(), parent_path.as_posix(), fs_type, ensemble_size, False
+        )
+        return cls(path, ensemble_config, ensemble_size, read_only=read_only)
+
     def sync(self):
         self._sync()
 
     def free(self):
-        self._umount()
+        # The flush happens on a background thread; a re-mount of the
+        # same case or EnkfFs.umount_barrier() waits for it.
+        self._umount_async()
+
+    @staticmethod
+    def umount_barrier(mount_point=None):
+        """Wait until background umounts have flushed to disk."""
+        _clib.enkf_fs.umount_barrier(mount_point)
 
     def __repr__(self):
         return f"EnkfFs(case_name = {self.getCaseName()}) {self._ad_str()}"
@@ -110,17 +142,42 @@ class EnkfFs(BaseCClass):
         iens_active_index: List[int],
         parameter: update.Parameter,
         values: npt.ArrayLike,
+        use_float32: bool = False,
+        columnar: bool = False,
     ) -> None:
-        update.save_parameter(
-            self, ensemble_config, iens_active_index, parameter, values
-        )
+        if use_float32:
+            update.save_parameter_fp32(
+                self,
+                ensemble_config,
+                iens_active_index,
+                parameter,
+                np.asarray(values, dtype=np.float32),
+            )
+        elif columnar:
+            update.save_parameter_columnar(
+                self, ensemble_config, iens_active_index, parameter, values
+            )
+        else:
+            update.save_parameter(
+                self, ensemble_config, iens_active_index, parameter, values
+            )
 
     def load_parameter(
         self,
         ensemble_config: EnsembleConfig,
         iens_active_index: List[int],
         parameter: update.Parameter,
+        use_float32: bool = False,
+        columnar: bool = False,
     ) -> np.ndarray:
+        if use_float32:
+            return update.load_parameter_fp32(
+                self, ensemble_config, iens_active_index, parameter
+            )
+        if columnar:
+            return update.load_parameter_columnar(
+                self, ensemble_config, iens_active_index, parameter
+            )
         return update.load_parameter(
             self, ensemble_config, iens_active_index, parameter
         )
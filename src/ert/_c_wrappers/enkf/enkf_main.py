@@ -5,7 +5,7 @@ import os
 import struct
 from datetime import datetime
 from pathlib import Path
-from typing import TYPE_CHECKING, Any, List, Mapping, Sequence, Union
+from typing import TYPE_CHECKING, Any, Dict, List, Mapping, Sequence, Union
 
 import numpy as np
 import pandas as pd
@@ -98,6 +98,7 @@ def _generate_parameter_files(
     run_path: str,
     iens: int,
     fs: "EnkfFs",
+    skip_fields: bool = False,
 ) -> None:
     """
     Generate parameter files that are placed in each runtime directory for
@@ -111,12 +112,16 @@ def _generate_parameter_files(
         run_path: Path to the runtime directory
         iens: Realisation index
         fs: EnkfFs from which to load parameter data
+        skip_fields: Skip FIELD nodes; used when those are exported for all
+            realizations at once by :func:`_generate_field_parameter_files`
     """
     exports = {}
     for key in ens_config.getKeylistFromVarType(
         EnkfVarType.PARAMETER + EnkfVarType.EXT_PARAMETER
     ):
         node = ens_config[key]
+        if skip_fields and node.getImplementationType() == ErtImplType.FIELD:
+            continue
         enkf_node = EnkfNode(node)
         node_id = NodeId(report_step=0, iens=iens)
 
@@ -144,6 +149,37 @@ def _generate_parameter_files(
     _value_export_json(run_path, export_base_name, exports)
 
 
+def _generate_field_parameter_files(
+    ens_config: "EnsembleConfig", run_context: RunContext
+) -> None:
+    """
+    Export the FIELD parameter files for all active realizations in one go.
+
+    The per-realization exports are independent of each other, so they are
+    handed to the clib layer which writes them on a thread pool - one private
+    field buffer and one output file per worker.
+    """
+    run_paths = []
+    iens_list = []
+    for iens, run_arg in enumerate(run_context):
+        if run_context.is_active(iens):
+            run_paths.append(run_arg.runpath)
+            iens_list.append(run_arg.iens)
+    if not run_paths:
+        return
+
+    for key in ens_config.getKeylistFromVarType(EnkfVarType.PARAMETER):
+        node = ens_config[key]
+        if node.getImplementationType() == ErtImplType.FIELD:
+            _clib.field.generate_parameter_files(
+                node,
+                run_context.sim_fs,
+                run_paths,
+                iens_list,
+                node.get_enkf_outfile(),
+            )
+
+
 class EnKFMain:
     def __init__(self, config: "ResConfig", read_only: bool = False):
         self.res_config = config
@@ -414,6 +450,10 @@ class EnKFMain:
         if parameters is None:
             parameters = self._parameter_keys
         state_map = storage.getStateMap()
+        # Parameters initialized from per-realization files are
+        # collected here and handed to the C layer in one batch per
+        # parameter, which runs the members on the thread pool.
+        batch_initialization: Dict[str, List[int]] = {}
         for realization_nr in active_realizations:
             current_status = state_map[realization_nr]
             for parameter in parameters:
@@ -465,12 +505,18 @@ class EnKFMain:
                             )
 
                     else:
-                        _clib.enkf_state.state_initialize(
-                            enkf_node,
-                            storage,
-                            realization_nr,
+                        batch_initialization.setdefault(parameter, []).append(
+                            realization_nr
                         )
 
+        for parameter, realizations in batch_initialization.items():
+            _clib.enkf_state.state_initialize_ensemble(
+                self.ensembleConfig().getNode(parameter),
+                storage,
+                realizations,
+            )
+
+        for realization_nr in active_realizations:
             if state_map[realization_nr] in [STATE_UNDEFINED, STATE_LOAD_FAILURE]:
                 state_map[realization_nr] = RealizationStateEnum.STATE_INITIALIZED
         storage.sync()
@@ -508,6 +554,16 @@ class EnKFMain:
         )
 
     def createRunPath(self, run_context: RunContext) -> None:
+        # Create the whole runpath tree up front: the common prefix is
+        # created once and the per-realization subtrees in parallel,
+        # instead of a serial makedirs per realization.
+        _clib.file_utils.create_runpath_directories(
+            [
+                run_context[iens].runpath
+                for iens in range(len(run_context))
+                if run_context.is_active(iens)
+            ]
+        )
         for iens, run_arg in enumerate(run_context):
             if run_context.is_active(iens):
                 substitutions = self.substituter.get_substitutions(
@@ -516,10 +572,6 @@ class EnKFMain:
                 subst_list = SubstitutionList()
                 for subst in substitutions.items():
                     subst_list.addItem(*subst)
-                os.makedirs(
-                    run_arg.runpath,
-                    exist_ok=True,
-                )
 
                 for source_file, target_file in self.res_config.ert_templates:
                     target_file = self.substituter.substitute(
@@ -546,6 +598,7 @@ class EnKFMain:
                     run_arg.runpath,
                     run_arg.iens,
                     run_arg.sim_fs,
+                    skip_fields=True,
                 )
                 res_config.forward_model.formatted_fprintf(
                     run_arg.get_run_id(),
@@ -557,6 +610,12 @@ class EnKFMain:
                     res_config.site_config.env_vars,
                 )
 
+        # The (potentially large) FIELD parameters are exported for all
+        # active realizations in parallel once the runpaths exist.
+        _generate_field_parameter_files(
+            self.resConfig().ensemble_config, run_context
+        )
+
         active_list = [
             run_context[i] for i in range(len(run_context)) if run_context.is_active(i)
         ]
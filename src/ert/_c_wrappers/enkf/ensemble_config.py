@@ -195,10 +195,13 @@ class EnsembleConfig(BaseCClass):
             name = gen_data[0]
             res_file = options.get(ConfigKeys.RESULT_FILE)
             input_format_str = options.get(ConfigKeys.INPUT_FORMAT)
-            if input_format_str != "ASCII":
-                logger.error("The only supported INPUT_FORMAT is ASCII")
+            if input_format_str == "BINARY":
+                input_format = GenDataFileType.GEN_DATA_BINARY
+            elif input_format_str == "ASCII":
+                input_format = GenDataFileType.from_string(input_format_str)
+            else:
+                logger.error("The only supported INPUT_FORMATs are ASCII and BINARY")
                 return None
-            input_format = GenDataFileType.from_string(input_format_str)
             report_steps_str = options.get(ConfigKeys.REPORT_STEPS, "")
             report_steps = rangestring_to_list(report_steps_str)
 
@@ -6,8 +6,10 @@ class GenDataFileType(BaseCEnum):
     GEN_DATA_UNDEFINED = None
     ASCII = None  # The file is ASCII file with a vector of numbers formatted with "%g"
     ASCII_TEMPLATE = None  # The data is inserted into a user defined template file.
+    GEN_DATA_BINARY = None  # Binary file: magic + dtype + count + raw array.
 
 
 GenDataFileType.addEnum("GEN_DATA_UNDEFINED", 0)
 GenDataFileType.addEnum("ASCII", 1)
 GenDataFileType.addEnum("ASCII_TEMPLATE", 2)
+GenDataFileType.addEnum("GEN_DATA_BINARY", 3)
@@ -1,3 +1,5 @@
+import hashlib
+import json
 import logging
 import os
 from typing import Iterator, List
@@ -9,6 +11,8 @@ from ert._c_wrappers.job_queue import Workflow, WorkflowJob, WorkflowJoblist
 
 logger = logging.getLogger(__name__)
 
+_JOB_DIR_CACHE_VERSION = 1
+
 
 class ErtWorkflowList:
     def __init__(
@@ -190,24 +194,98 @@ class ErtWorkflowList:
                 parser=self._parser,
             )
             if new_job is not None:
-                self._workflow_jobs[new_job.name()] = self._workflow_joblist.addJob(
-                    new_job
-                )
-                new_job.convertToCReference(None)
-                logger.info(f"Adding workflow job:{new_job.name()}")
+                self._register_job(new_job)
+                return new_job
 
         except OSError:
             print(f"WARNING: Unable to create job from {workflow_job[0]}")
+        return None
+
+    def _register_job(self, new_job):
+        self._workflow_jobs[new_job.name()] = self._workflow_joblist.addJob(new_job)
+        new_job.convertToCReference(None)
+        logger.info(f"Adding workflow job:{new_job.name()}")
+
+    @staticmethod
+    def _job_dir_fingerprint(job_path):
+        """One (name, size, mtime) entry per file, so validating a
+        cached directory is a stat pass instead of reparsing every
+        definition file."""
+        entries = []
+        for file_name in sorted(os.listdir(job_path)):
+            try:
+                stat = os.stat(os.path.join(job_path, file_name))
+            except OSError:
+                continue
+            entries.append([file_name, stat.st_size, stat.st_mtime_ns])
+        return entries
+
+    @staticmethod
+    def _job_dir_cache_file(job_path):
+        cache_dir = os.path.join(
+            os.environ.get("XDG_CACHE_HOME", os.path.expanduser("~/.cache")),
+            "ert",
+            "workflow_job_dirs",
+        )
+        digest = hashlib.sha256(os.path.abspath(job_path).encode("utf-8")).hexdigest()
+        return os.path.join(cache_dir, f"{digest}.json")
+
+    @staticmethod
+    def _load_job_dir_cache(cache_file, fingerprint):
+        try:
+            with open(cache_file, encoding="utf-8") as handle:
+                cache = json.load(handle)
+        except (OSError, ValueError):
+            return None
+        if cache.get("version") != _JOB_DIR_CACHE_VERSION:
+            return None
+        if cache.get("fingerprint") != fingerprint:
+            return None
+        return cache.get("jobs", [])
+
+    @staticmethod
+    def _save_job_dir_cache(cache_file, fingerprint, jobs):
+        try:
+            os.makedirs(os.path.dirname(cache_file), exist_ok=True)
+            tmp_file = f"{cache_file}.{os.getpid()}.tmp"
+            with open(tmp_file, "w", encoding="utf-8") as handle:
+                json.dump(
+                    {
+                        "version": _JOB_DIR_CACHE_VERSION,
+                        "fingerprint": fingerprint,
+                        "jobs": jobs,
+                    },
+                    handle,
+                )
+            os.replace(tmp_file, cache_file)
+        except OSError:
+            pass
 
     def _add_workflow_job_dir(self, job_path):
         if not os.path.isdir(job_path):
             print(f"WARNING: Unable to open job directory {job_path}")
             return
 
-        files = os.listdir(job_path)
-        for file_name in files:
+        # The cache is purely advisory: a miss (or an unwritable cache
+        # directory) falls back to parsing every definition file, as
+        # before.
+        fingerprint = self._job_dir_fingerprint(job_path)
+        cache_file = self._job_dir_cache_file(job_path)
+        cached_jobs = self._load_job_dir_cache(cache_file, fingerprint)
+        if cached_jobs is not None:
+            for fields in cached_jobs:
+                new_job = WorkflowJob.fromCachedFields(fields)
+                if new_job is not None:
+                    self._register_job(new_job)
+            return
+
+        jobs = []
+        for file_name in sorted(os.listdir(job_path)):
             full_path = os.path.join(job_path, file_name)
-            self._add_workflow_job([full_path])
+            new_job = self._add_workflow_job([full_path])
+            if new_job is not None:
+                jobs.append(new_job.cacheFields())
+        self._save_job_dir_cache(cache_file, fingerprint, jobs)
 
     def _add_workflow(self, work):
         filename = os.path.basename(work[0]) if len(work) == 1 else work[1]
@@ -71,6 +71,31 @@ class Substituter:
         result["<ITER>"] = str(iteration)
         return result
 
+    def get_global_substitutions(self) -> Dict[str, str]:
+        """
+        :return: The substitutions which are applied in the same way
+            regardless of realization and iteration.
+        """
+        return self._global_substitutions.copy()
+
+    def get_member_substitutions(
+        self, realization: int, iteration: int
+    ) -> Dict[str, str]:
+        """
+        Example:
+
+            >>> substituter = Substituter({"<GLOBAL>": "global"})
+            >>> substituter.get_member_substitutions(0, 1)
+            {'<IENS>': '0', '<ITER>': '1'}
+
+        :return: Only the substitutions specific to the given realization
+            and iteration, ie. get_substitutions without the global part.
+        """
+        result = dict(self._local_substitutions[(realization, iteration)])
+        result["<IENS>"] = str(realization)
+        result["<ITER>"] = str(iteration)
+        return result
+
     def substitute(self, to_substitute: str, realization: int, iteration: int) -> str:
         for key, value in self.get_substitutions(realization, iteration).items():
             to_substitute = to_substitute.replace(key, value)
@@ -27,6 +27,11 @@ class EnvironmentVarlist(BaseCClass):
             paths = {}
         c_ptr = self._alloc()
         super().__init__(c_ptr)
+        # The variable list is fully resolved at configuration time, so
+        # the dict conversions are frozen after the first access instead
+        # of crossing into C for every realization's jobs.json dump.
+        self._frozen_varlist: Optional[Dict[str, str]] = None
+        self._frozen_updatelist: Optional[Dict[str, str]] = None
 
         for key, value in env_vars.items():
             self.setenv(key, value)
@@ -34,18 +39,24 @@ class EnvironmentVarlist(BaseCClass):
             self.update_path(key, value)
 
     def setenv(self, key, value):
+        self._frozen_varlist = None
         self._setenv(key, value)
 
     def update_path(self, key, value):
+        self._frozen_updatelist = None
         self._update_path(key, value)
 
     @property
     def varlist(self):
-        return _get_varlist(self)
+        if self._frozen_varlist is None:
+            self._frozen_varlist = _get_varlist(self)
+        return self._frozen_varlist
 
     @property
     def updatelist(self):
-        return _get_updatelist(self)
+        if self._frozen_updatelist is None:
+            self._frozen_updatelist = _get_updatelist(self)
+        return self._frozen_updatelist
 
     def __repr__(self) -> str:
         return (
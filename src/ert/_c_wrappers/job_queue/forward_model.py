@@ -1,9 +1,9 @@
 import json
 import logging
 import os
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from pathlib import Path
-from typing import TYPE_CHECKING, List, Optional
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple
 
 from ert._c_wrappers.job_queue import EnvironmentVarlist, ExtJob
 from ert._clib import job_kw
@@ -14,13 +14,74 @@ if TYPE_CHECKING:
 logger = logging.getLogger(__name__)
 
 
+def _positive_or_null_int(integer: int) -> Optional[int]:
+    return integer if integer > 0 else None
+
+
 @dataclass
 class ForwardModel:
     jobs: List[ExtJob]
+    _prerendered: Optional[Tuple[Dict[str, str], List[Dict[str, Any]]]] = field(
+        default=None, init=False, repr=False, compare=False
+    )
 
     def job_name_list(self) -> List[str]:
         return [j.name() for j in self.jobs]
 
+    def _prerendered_job_list(self, substituter: "Substituter") -> List[Dict[str, Any]]:
+        """Render the jobList entries with the private arguments and the
+        global substitutions resolved. Only the member specific keys
+        (<IENS>, <ITER> and the per realization substitutions) remain as
+        placeholders, so the result can be rendered once and cheaply
+        patched for every realization instead of re-running the full
+        substitution a thousand times. The result is cached for as long
+        as the global substitutions are unchanged.
+        """
+        global_subs = substituter.get_global_substitutions()
+        if self._prerendered is not None and self._prerendered[0] == global_subs:
+            return self._prerendered[1]
+
+        def prerender(job, string):
+            if string is None:
+                return None
+            string = job.get_private_args().substitute(string)
+            for key, value in global_subs.items():
+                string = string.replace(key, value)
+            return string
+
+        job_list = [
+            {
+                "name": prerender(job, job.name()),
+                "executable": prerender(job, job.get_executable()),
+                "target_file": prerender(job, job.get_target_file()),
+                "error_file": prerender(job, job.get_error_file()),
+                "start_file": prerender(job, job.get_start_file()),
+                "stdout": prerender(job, job.get_stdout_file()) + f".{idx}",
+                "stderr": prerender(job, job.get_stderr_file()) + f".{idx}",
+                "stdin": prerender(job, job.get_stdin_file()),
+                "argList": [prerender(job, arg) for arg in job.get_arglist()],
+                "environment": {
+                    prerender(job, key): prerender(job, value)
+                    for key, value in job.get_environment().items()
+                },
+                "exec_env": {
+                    prerender(job, key): prerender(job, value)
+                    for key, value in job.get_exec_env().items()
+                },
+                "max_running_minutes": _positive_or_null_int(
+                    job.get_max_running_minutes()
+                ),
+                "max_running": _positive_or_null_int(job.get_max_running()),
+                "min_arg": _positive_or_null_int(job.min_arg),
+                "arg_types": [job_kw.kw_from_type(typ) for typ in job.arg_types],
+                "max_arg": _positive_or_null_int(job.max_arg),
+                "default_mapping": dict(job.get_default_mapping()),
+            }
+            for idx, job in enumerate(self.jobs)
+        ]
+        self._prerendered = (global_subs, job_list)
+        return job_list
+
     def formatted_fprintf(
         self,
         run_id,
@@ -32,25 +93,20 @@ class ForwardModel:
         env_varlist: EnvironmentVarlist,
         filename: str = "jobs.json",
     ):
-        def substitute(job, string):
-            if string is not None:
-                return substituter.substitute(
-                    job.get_private_args().substitute(string), iens, itr
-                )
-            else:
-                return string
+        member_subs = substituter.get_member_substitutions(iens, itr)
 
-        def positive_or_null_int(integer: int) -> Optional[int]:
-            return integer if integer > 0 else None
-
-        def handle_default(job: ExtJob, arg: str) -> str:
-            return job.get_default_mapping().get(arg, arg)
+        def patch(string):
+            if string is None or "<" not in string:
+                return string
+            for key, value in member_subs.items():
+                string = string.replace(key, value)
+            return string
 
-        def filter_env_dict(job, d):
+        def filter_env_dict(d):
             result = {}
             for key, value in d.items():
-                new_key = substitute(job, key)
-                new_value = substitute(job, value)
+                new_key = patch(key)
+                new_value = patch(value)
                 if new_value is None:
                     result[new_key] = None
                 elif not (new_value[0] == "<" and new_value[-1] == ">"):
@@ -69,6 +125,32 @@ class ForwardModel:
                 return None
             return result
 
+        def patch_job(template):
+            job = {
+                key: value
+                for key, value in template.items()
+                if key != "default_mapping"
+            }
+            default_mapping = template["default_mapping"]
+            for key in (
+                "name",
+                "executable",
+                "target_file",
+                "error_file",
+                "start_file",
+                "stdout",
+                "stderr",
+                "stdin",
+            ):
+                job[key] = patch(job[key])
+            job["argList"] = [
+                default_mapping.get(patched_arg, patched_arg)
+                for patched_arg in (patch(arg) for arg in template["argList"])
+            ]
+            job["environment"] = filter_env_dict(template["environment"])
+            job["exec_env"] = filter_env_dict(template["exec_env"])
+            return job
+
         with open(Path(path) / filename, mode="w", encoding="utf-8") as fptr:
             json.dump(
                 {
@@ -76,34 +158,8 @@ class ForwardModel:
                     "global_environment": env_varlist.varlist,
                     "global_update_path": env_varlist.updatelist,
                     "jobList": [
-                        {
-                            "name": substitute(job, job.name()),
-                            "executable": substitute(job, job.get_executable()),
-                            "target_file": substitute(job, job.get_target_file()),
-                            "error_file": substitute(job, job.get_error_file()),
-                            "start_file": substitute(job, job.get_start_file()),
-                            "stdout": substitute(job, job.get_stdout_file())
-                            + f".{idx}",
-                            "stderr": substitute(job, job.get_stderr_file())
-                            + f".{idx}",
-                            "stdin": substitute(job, job.get_stdin_file()),
-                            "argList": [
-                                handle_default(job, substitute(job, arg))
-                                for arg in job.get_arglist()
-                            ],
-                            "environment": filter_env_dict(job, job.get_environment()),
-                            "exec_env": filter_env_dict(job, job.get_exec_env()),
-                            "max_running_minutes": positive_or_null_int(
-                                job.get_max_running_minutes()
-                            ),
-                            "max_running": positive_or_null_int(job.get_max_running()),
-                            "min_arg": positive_or_null_int(job.min_arg),
-                            "arg_types": [
-                                job_kw.kw_from_type(typ) for typ in job.arg_types
-                            ],
-                            "max_arg": positive_or_null_int(job.max_arg),
-                        }
-                        for idx, job in enumerate(self.jobs)
+                        patch_job(template)
+                        for template in self._prerendered_job_list(substituter)
                     ],
                     "run_id": run_id,
                     "ert_pid": str(os.getpid()),
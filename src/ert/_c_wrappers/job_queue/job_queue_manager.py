@@ -2,6 +2,7 @@
 Module implementing a queue for managing external jobs.
 
 """
+import os
 from threading import BoundedSemaphore
 from typing import TYPE_CHECKING, Any
 
@@ -11,7 +12,22 @@ if TYPE_CHECKING:
     from ert._c_wrappers.job_queue import JobQueue
 
 
-CONCURRENT_INTERNALIZATION = 1
+# The internalize_results binding releases the GIL, so the callback
+# threads load results in parallel; results are internalized the
+# moment each realization reaches DONE, overlapping the tail of the
+# cluster execution with the storage writes.
+CONCURRENT_INTERNALIZATION = 10
+
+
+def concurrent_internalization() -> int:
+    """The number of realizations internalized in parallel as they
+    complete. The default of 10 keeps memory in check for huge
+    ensembles; ERT_CONCURRENT_INTERNALIZATION overrides it when the
+    loading rather than the cluster is the bottleneck."""
+    value = os.environ.get("ERT_CONCURRENT_INTERNALIZATION")
+    if value is not None and value.isdigit() and int(value) > 0:
+        return int(value)
+    return CONCURRENT_INTERNALIZATION
 
 
 # TODO: there's no need for this class, all the behavior belongs in the queue
@@ -20,7 +36,7 @@ class JobQueueManager:
     def __init__(self, queue: "JobQueue", queue_evaluators: Any = None):
         self._queue = queue
         self._queue_evaluators = queue_evaluators
-        self._pool_sema = BoundedSemaphore(value=CONCURRENT_INTERNALIZATION)
+        self._pool_sema = BoundedSemaphore(value=concurrent_internalization())
 
     @property
     def queue(self) -> "JobQueue":
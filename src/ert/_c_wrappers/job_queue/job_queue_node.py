@@ -77,6 +77,8 @@ class JobQueueNode(BaseCClass):
         self._thread = None
         self._mutex = Lock()
         self._tried_killing = 0
+        self._status_event = None
+        self._poll_schedule = None
 
         self.run_path = run_path
         self._max_runtime = max_runtime
@@ -156,6 +158,10 @@ class JobQueueNode(BaseCClass):
             JobStatusType.JOB_QUEUE_UNKNOWN,
         )  # dont stop monitoring if LSF commands are unavailable
 
+    @property
+    def start_time(self):
+        return self._start_time
+
     @property
     def runtime(self):
         if self._start_time is None:
@@ -171,6 +177,19 @@ class JobQueueNode(BaseCClass):
             self._max_runtime is not None and self.runtime >= self._max_runtime
         )
 
+    def _sleep_poll_interval(self):
+        """Sleep out the adaptive poll interval in one second slices, so
+        kill requests and MAX_RUNTIME are still acted on within a second
+        even when the interval has backed off."""
+        if self._poll_schedule is None:
+            time.sleep(1)
+            return
+        deadline = time.time() + self._poll_schedule.interval()
+        while True:
+            time.sleep(1)
+            if time.time() >= deadline or self._should_be_killed():
+                return
+
     def _job_monitor(self, driver, pool_sema, max_submit):
 
         submit_status = self.submit(driver)
@@ -179,32 +198,47 @@ class JobQueueNode(BaseCClass):
 
         current_status = self.refresh_status(driver)
 
-        while self.is_running(current_status):
-            if (
-                self._start_time is None
-                and current_status == JobStatusType.JOB_QUEUE_RUNNING
-            ):
-                self._start_time = time.time()
-            time.sleep(1)
-            if self._should_be_killed():
-                self._kill(driver)
-                if self._max_runtime and self.runtime >= self._max_runtime:
-                    # We sometimes end up in a state where we are not able to kill it,
-                    # so we end up flooding the logs with identical statements, so we
-                    # check before we log.
-                    if self._tried_killing == 1:
-                        logger.info(f"MAX_RUNTIME reached in run path {self.run_path}")
-                    elif self._tried_killing % 100 == 0:
-                        logger.warning(
-                            f"Tried killing with MAX_RUNTIME {self._tried_killing} "
-                            f"times without success in {self.run_path}"
-                        )
-                    if self.callback_timeout:
-                        self.callback_timeout(self.callback_arguments)
-                    with self._mutex:
-                        self._timed_out = True
-
-            current_status = self.refresh_status(driver)
+        if self._poll_schedule is not None:
+            self._poll_schedule.register()
+        try:
+            while self.is_running(current_status):
+                if (
+                    self._start_time is None
+                    and current_status == JobStatusType.JOB_QUEUE_RUNNING
+                ):
+                    self._start_time = time.time()
+                self._sleep_poll_interval()
+                if self._should_be_killed():
+                    self._kill(driver)
+                    if self._max_runtime and self.runtime >= self._max_runtime:
+                        # We sometimes end up in a state where we are not able to
+                        # kill it, so we end up flooding the logs with identical
+                        # statements, so we check before we log.
+                        if self._tried_killing == 1:
+                            logger.info(
+                                f"MAX_RUNTIME reached in run path {self.run_path}"
+                            )
+                        elif self._tried_killing % 100 == 0:
+                            logger.warning(
+                                f"Tried killing with MAX_RUNTIME "
+                                f"{self._tried_killing} "
+                                f"times without success in {self.run_path}"
+                            )
+                        if self.callback_timeout:
+                            self.callback_timeout(self.callback_arguments)
+                        with self._mutex:
+                            self._timed_out = True
+
+                last_status = current_status
+                current_status = self.refresh_status(driver)
+                if (
+                    current_status != last_status
+                    and self._poll_schedule is not None
+                ):
+                    self._poll_schedule.note_transition()
+        finally:
+            if self._poll_schedule is not None:
+                self._poll_schedule.unregister()
 
         self._end_time = time.time()
 
@@ -257,9 +291,10 @@ class JobQueueNode(BaseCClass):
         self._run_kill(driver)
         self._tried_killing += 1
 
-    def run(self, driver, pool_sema, max_submit=2):
+    def run(self, driver, pool_sema, max_submit=2, poll_schedule=None):
         # Prevent multiple threads working on the same object
         self.wait_for()
+        self._poll_schedule = poll_schedule
         # Do not start if already kill signal is sent
         if self.thread_status == ThreadStatus.STOPPING:
             self._set_thread_status(ThreadStatus.DONE)
@@ -291,5 +326,13 @@ class JobQueueNode(BaseCClass):
         if self._thread is not None and self._thread.is_alive():
             self._thread.join()
 
+    def set_status_event(self, event):
+        """Event which is set on every thread status transition, so the
+        queue loop can react to completions and resubmits without
+        waiting out a full poll interval."""
+        self._status_event = event
+
     def _set_thread_status(self, new_status):
         self._thread_status = new_status
+        if self._status_event is not None:
+            self._status_event.set()
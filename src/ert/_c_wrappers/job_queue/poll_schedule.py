@@ -0,0 +1,75 @@
+import threading
+import time
+
+
+class PollSchedule:
+    """Adaptive poll interval shared by the job monitor threads.
+
+    Each running job has its own monitor thread asking the driver for
+    a status update once per interval, so with a fixed one second
+    cadence the scheduler command volume grows linearly with the
+    number of active jobs. This object scales the interval with the
+    number of registered monitors (keeping the aggregate query rate
+    roughly constant) and with how recently any job changed status:
+    during ramp-up and ramp-down transitions arrive continuously and
+    everybody polls at the driver floor, while in the steady middle of
+    long simulations the interval backs off towards the ceiling. The
+    floor is driver specific - querying the local driver is an
+    in-process operation while every LSF/TORQUE/SLURM poll is a
+    scheduler round trip.
+    """
+
+    _DRIVER_FLOORS = {
+        "local": 1.0,
+        "LSF": 2.0,
+        "TORQUE": 5.0,
+        "SLURM": 2.0,
+    }
+    _DEFAULT_FLOOR = 1.0
+    _CEILING = 15.0
+    # Aggregate driver queries per second the monitors aim for when
+    # the load term dominates.
+    _TARGET_POLL_RATE = 20.0
+    # How long after the last observed transition polling stays at the
+    # floor, and how fast the idle backoff doubles after that.
+    _RECENT_WINDOW = 10.0
+    _IDLE_DOUBLING_TIME = 30.0
+
+    def __init__(self, floor: float = _DEFAULT_FLOOR) -> None:
+        self._floor = floor
+        self._lock = threading.Lock()
+        self._active = 0
+        self._last_transition = time.time()
+
+    @classmethod
+    def for_driver(cls, driver_name: str) -> "PollSchedule":
+        return cls(floor=cls._DRIVER_FLOORS.get(driver_name, cls._DEFAULT_FLOOR))
+
+    def register(self) -> None:
+        """A monitor thread entered its polling loop."""
+        with self._lock:
+            self._active += 1
+            # A new active job is itself a transition - poll fast
+            # while the queue is ramping up.
+            self._last_transition = time.time()
+
+    def unregister(self) -> None:
+        with self._lock:
+            self._active -= 1
+
+    def note_transition(self) -> None:
+        """A monitor thread observed a status change."""
+        with self._lock:
+            self._last_transition = time.time()
+
+    def interval(self) -> float:
+        with self._lock:
+            active = self._active
+            idle = time.time() - self._last_transition
+
+        if idle < self._RECENT_WINDOW:
+            return self._floor
+
+        load = active / self._TARGET_POLL_RATE
+        backoff = self._floor * 2 ** min(idle / self._IDLE_DOUBLING_TIME, 6)
+        return min(self._CEILING, max(self._floor, load, backoff))
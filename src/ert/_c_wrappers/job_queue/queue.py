@@ -4,13 +4,25 @@ Module implementing a queue for managing external jobs.
 """
 
 import asyncio
+import heapq
 import json
 import logging
 import ssl
 import threading
 import time
 from collections import deque
-from typing import TYPE_CHECKING, Any, Callable, Dict, List, Mapping, Optional, Union
+from pathlib import Path
+from typing import (
+    TYPE_CHECKING,
+    Any,
+    Callable,
+    Dict,
+    List,
+    Mapping,
+    Optional,
+    Tuple,
+    Union,
+)
 
 from cloudevents.conversion import to_json
 from cloudevents.http import CloudEvent
@@ -23,6 +35,7 @@ import _ert_com_protocol
 from ert._c_wrappers import ResPrototype
 from ert._c_wrappers.job_queue.job_queue_node import JobQueueNode
 from ert._c_wrappers.job_queue.job_status_type_enum import JobStatusType
+from ert._c_wrappers.job_queue.poll_schedule import PollSchedule
 from ert._c_wrappers.job_queue.queue_differ import QueueDiffer
 from ert._c_wrappers.job_queue.thread_status_type_enum import ThreadStatus
 from ert.constant_filenames import (
@@ -41,6 +54,7 @@ if TYPE_CHECKING:
 logger = logging.getLogger(__name__)
 
 LONG_RUNNING_FACTOR = 1.25
+RUNTIME_HISTORY_FILE = "runtime_history.json"
 
 
 _FM_STEP_FAILURE = "com.equinor.ert.forward_model_step.failure"
@@ -95,6 +109,7 @@ class JobQueue(BaseCClass):
     )
     _set_driver = ResPrototype("void job_queue_set_driver( job_queue , void* )")
     _kill_job = ResPrototype("bool job_queue_kill_job( job_queue , int )")
+    _kill_all_jobs = ResPrototype("int job_queue_kill_all_jobs( job_queue )")
     _iget_driver_data = ResPrototype(
         "void* job_queue_iget_driver_data( job_queue , int)"
     )
@@ -150,12 +165,33 @@ class JobQueue(BaseCClass):
 
         self.job_list = []
         self._stopped = False
+        self._statechanges = threading.Event()
+        # State for stop_long_running_jobs(): jobs wait in _not_started
+        # until they have a start time, then move to the deadline heap.
+        self._long_running_heap: List[Tuple[float, int]] = []
+        self._long_running_not_started: List[int] = []
+        self._long_running_finished_count = 0
+        self._long_running_average = 0.0
+        # Where fetch_next_waiting() resumes its scan for READY jobs.
+        self._fetch_next_cursor = 0
+        # Runtime-informed submission order: realizations expected to
+        # run the longest are started first, so the longest simulation
+        # no longer dominates the tail of the batch just because it has
+        # a high realization index. Expected runtimes come either from
+        # set_runtime_estimates() or from the runtimes recorded with
+        # the case in a previous run; with neither present the queue
+        # keeps the plain list-order submission.
+        self._iens_by_index: Dict[int, int] = {}
+        self._runtime_estimates: Dict[int, float] = {}
+        self._runtime_history: Dict[int, float] = {}
+        self._runtime_history_file: Optional[Path] = None
         c_ptr = self._alloc(max_submit, OK_file, STATUS_file, ERROR_file)
         super().__init__(c_ptr)
         self.size = size
 
         self.driver = driver
         self._set_driver(driver.from_param(driver))
+        self._poll_schedule = PollSchedule.for_driver(driver.name)
         self._differ = QueueDiffer()
 
     def kill_job(self, queue_index):
@@ -238,9 +274,50 @@ class JobQueue(BaseCClass):
                 return True
         return False
 
+    def set_runtime_estimates(self, estimates: Mapping[int, float]) -> None:
+        """Supply expected runtimes in seconds, keyed by realization
+        index, from an external source such as a proxy model. The
+        estimates take precedence over the history recorded with the
+        case when ordering the submission of waiting jobs."""
+        self._runtime_estimates.update(estimates)
+
+    def _expected_runtime(self, index: int) -> Optional[float]:
+        iens = self._iens_by_index.get(index)
+        if iens is None:
+            return None
+        if iens in self._runtime_estimates:
+            return self._runtime_estimates[iens]
+        return self._runtime_history.get(iens)
+
     def fetch_next_waiting(self):
-        for job in self.job_list:
+        num_jobs = len(self.job_list)
+        if self._runtime_estimates or self._runtime_history:
+            # Longest-first: pick the READY job with the largest
+            # expected runtime. Jobs without an estimate keep their
+            # list position and are taken after the estimated ones.
+            best_index = None
+            best_key = None
+            for index in range(num_jobs):
+                if self.job_list[index].thread_status != ThreadStatus.READY:
+                    continue
+                expected = self._expected_runtime(index)
+                key = (0, -expected) if expected is not None else (1, index)
+                if best_key is None or key < best_key:
+                    best_key = key
+                    best_index = index
+            if best_index is None:
+                return None
+            return self.job_list[best_index]
+
+        # Jobs are started roughly in list order, so the scan resumes
+        # from the previous hit instead of walking the whole list from
+        # the front on every launch; the wrap-around covers jobs which
+        # have been reset to READY for a resubmission.
+        for offset in range(num_jobs):
+            index = (self._fetch_next_cursor + offset) % num_jobs
+            job = self.job_list[index]
             if job.thread_status == ThreadStatus.READY:
+                self._fetch_next_cursor = (index + 1) % num_jobs
                 return job
         return None
 
@@ -272,11 +349,48 @@ class JobQueue(BaseCClass):
 
     def add_job(self, job, iens):
         job.convertToCReference(None)
+        job.set_status_event(self._statechanges)
         queue_index = self._add_job(job)
         self.job_list.append(job)
+        self._long_running_not_started.append(len(self.job_list) - 1)
+        self._iens_by_index[len(self.job_list) - 1] = iens
         self._differ.add_state(queue_index, iens, job.status.value)
         return queue_index
 
+    def _load_runtime_history(self, history_file: Path) -> None:
+        """Load the per-realization runtimes recorded with the case by
+        a previous run. Called with the case of the first job added;
+        a missing or unreadable file simply means no history."""
+        if self._runtime_history_file is not None:
+            return
+        self._runtime_history_file = history_file
+        try:
+            with open(history_file) as fileH:
+                self._runtime_history = {
+                    int(iens): float(runtime)
+                    for iens, runtime in json.load(fileH).items()
+                }
+        except (OSError, ValueError):
+            self._runtime_history = {}
+
+    def _record_runtimes(self) -> None:
+        """Record the runtime of every completed realization with the
+        case, for the longest-first submission order of later runs."""
+        for index, job in enumerate(self.job_list):
+            if job.status == JobStatusType.JOB_QUEUE_DONE:
+                iens = self._iens_by_index.get(index)
+                if iens is not None:
+                    self._runtime_history[iens] = job.runtime
+        if self._runtime_history_file is None or not self._runtime_history:
+            return
+        try:
+            with open(self._runtime_history_file, "w") as fileH:
+                json.dump(self._runtime_history, fileH)
+        except OSError:
+            logger.exception(
+                "Failed to store runtime history in %s", self._runtime_history_file
+            )
+
     def count_running(self):
         return sum(job.thread_status == ThreadStatus.RUNNING for job in self.job_list)
 
@@ -290,12 +404,18 @@ class JobQueue(BaseCClass):
         return not self.stopped and self.count_running() < self.max_running()
 
     def stop_jobs(self):
+        # Cancel all the submitted jobs with a single batched scheduler
+        # command before the per-job monitor threads are told to stop;
+        # the monitors then observe IS_KILLED instead of each spawning
+        # their own bkill/scancel process.
+        self._kill_all_jobs()
         for job in self.job_list:
             job.stop()
         while self.is_active():
             time.sleep(1)
 
     async def stop_jobs_async(self):
+        self._kill_all_jobs()
         for job in self.job_list:
             job.stop()
         while self.is_active():
@@ -320,13 +440,22 @@ class JobQueue(BaseCClass):
                 driver=self.driver,
                 pool_sema=pool_sema,
                 max_submit=self.max_submit,
+                poll_schedule=self._poll_schedule,
             )
 
+    def _wait_for_statechanges(self, timeout=1):
+        """Block until a job thread signals a status transition. The
+        timeout keeps a low-frequency poll as fallback for the time
+        based checks (evaluators, MAX_RUNTIME) which do not generate
+        events of their own."""
+        self._statechanges.wait(timeout)
+        self._statechanges.clear()
+
     def execute_queue(self, pool_sema, evaluators):
         while self.is_active() and not self.stopped:
             self.launch_jobs(pool_sema)
 
-            time.sleep(1)
+            self._wait_for_statechanges()
 
             if evaluators is not None:
                 for func in evaluators:
@@ -336,6 +465,7 @@ class JobQueue(BaseCClass):
             self.stop_jobs()
 
         self.assert_complete()
+        self._record_runtimes()
 
     @staticmethod
     def _translate_change_to_cloudevent(
@@ -454,7 +584,9 @@ class JobQueue(BaseCClass):
             while True:
                 self.launch_jobs(pool_sema)
 
-                await asyncio.sleep(1)
+                await asyncio.get_running_loop().run_in_executor(
+                    None, self._wait_for_statechanges
+                )
 
                 for func in evaluators:
                     func()
@@ -489,6 +621,7 @@ class JobQueue(BaseCClass):
             raise
 
         self.assert_complete()
+        self._record_runtimes()
         self._differ.transition(self.job_list)
         await JobQueue._publish_changes(
             ens_id, self._differ.snapshot(), ws_uri, ssl_context, headers
@@ -511,7 +644,9 @@ class JobQueue(BaseCClass):
             while True:
                 self.launch_jobs(pool_sema)
 
-                await asyncio.sleep(1)
+                await asyncio.get_running_loop().run_in_executor(
+                    None, self._wait_for_statechanges
+                )
 
                 for func in evaluators:
                     func()
@@ -543,6 +678,7 @@ class JobQueue(BaseCClass):
             raise
 
         self.assert_complete()
+        self._record_runtimes()
         self._differ.transition(self.job_list)
         await JobQueue._queue_changes(
             experiment_id, ens_id, self._differ.snapshot(), output_bus
@@ -578,6 +714,10 @@ class JobQueue(BaseCClass):
 
         if job is None:
             return
+        if run_arg.sim_fs is not None:
+            self._load_runtime_history(
+                Path(run_arg.sim_fs.mount_point) / RUNTIME_HISTORY_FILE
+            )
         run_arg.set_queue_index(self.add_job(job, run_arg.iens))
 
     def add_ee_stage(self, stage, callback_timeout=None):
@@ -599,6 +739,10 @@ class JobQueue(BaseCClass):
             raise ValueError("JobQueueNode constructor created None job")
 
         iens = stage.run_arg.iens
+        if stage.run_arg.sim_fs is not None:
+            self._load_runtime_history(
+                Path(stage.run_arg.sim_fs.mount_point) / RUNTIME_HISTORY_FILE
+            )
         stage.run_arg.set_queue_index(self.add_job(job, iens))
 
     def stop_long_running_jobs(self, minimum_required_realizations: int) -> None:
@@ -606,16 +750,80 @@ class JobQueue(BaseCClass):
         if finished_realizations < minimum_required_realizations:
             return
 
-        completed_jobs = [
-            job for job in self.job_list if job.status == JobStatusType.JOB_QUEUE_DONE
-        ]
-        average_runtime = sum(job.runtime for job in completed_jobs) / len(
-            completed_jobs
-        )
-
-        for job in self.job_list:
-            if job.runtime > LONG_RUNNING_FACTOR * average_runtime:
+        # The average runtime only changes when another realization
+        # finishes, so it is cached between calls instead of rescanning
+        # every completed job on each queue iteration.
+        if finished_realizations != self._long_running_finished_count:
+            completed_runtimes = [
+                job.runtime
+                for job in self.job_list
+                if job.status == JobStatusType.JOB_QUEUE_DONE
+            ]
+            self._long_running_average = sum(completed_runtimes) / len(
+                completed_runtimes
+            )
+            self._long_running_finished_count = finished_realizations
+
+        # Jobs move from the not-started list to the deadline heap once
+        # they have a start time. All jobs share the same runtime limit,
+        # so the earliest started job always expires first and each call
+        # only pops the expired heap heads instead of scanning every
+        # node in the queue.
+        still_not_started = []
+        for index in self._long_running_not_started:
+            start_time = self.job_list[index].start_time
+            if start_time is None:
+                still_not_started.append(index)
+            else:
+                heapq.heappush(self._long_running_heap, (start_time, index))
+        self._long_running_not_started = still_not_started
+
+        limit = LONG_RUNNING_FACTOR * self._long_running_average
+        now = time.time()
+        while self._long_running_heap and now - self._long_running_heap[0][0] > limit:
+            start_key, index = heapq.heappop(self._long_running_heap)
+            job = self.job_list[index]
+            if job.runtime > limit:
                 job.stop()
+                continue
+            # A resubmitted job has a fresh start time, so the popped
+            # heap key is stale; re-register the job so it stays
+            # covered by future checks. A job whose start time still
+            # matches the key has finished within the limit and is
+            # dropped for good.
+            start_time = job.start_time
+            if start_time is None:
+                self._long_running_not_started.append(index)
+            elif start_time != start_key:
+                heapq.heappush(self._long_running_heap, (start_time, index))
+
+    def timeline_statistics(self) -> Dict[str, Any]:
+        """Aggregate queue statistics for the end-of-run performance
+        report: job counts per final status plus runtime statistics
+        over the completed realizations."""
+        status_counts: Dict[str, int] = {}
+        for job in self.job_list:
+            name = str(job.status)
+            status_counts[name] = status_counts.get(name, 0) + 1
+
+        statistics: Dict[str, Any] = {
+            "jobs": len(self.job_list),
+            "max_running": self.max_running(),
+            "status_counts": status_counts,
+        }
+        runtimes = [
+            job.runtime
+            for job in self.job_list
+            if job.status == JobStatusType.JOB_QUEUE_DONE
+        ]
+        if runtimes:
+            statistics["runtime"] = {
+                "min": min(runtimes),
+                "max": max(runtimes),
+                "mean": sum(runtimes) / len(runtimes),
+                "total": sum(runtimes),
+            }
+        return statistics
 
     def snapshot(self) -> Optional[Dict[int, str]]:
         """Return the whole state, or None if there was no snapshot."""
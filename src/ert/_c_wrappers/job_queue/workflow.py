@@ -2,7 +2,8 @@ import logging
 import os
 import sys
 import time
-from typing import TYPE_CHECKING, Any, Dict, Optional, Tuple
+from concurrent.futures import ThreadPoolExecutor
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple
 
 from cwrap import BaseCClass  # pylint: disable=import-error
 
@@ -25,6 +26,9 @@ class Workflow(BaseCClass):
     _iget_args = ResPrototype("stringlist_ref   workflow_iget_arguments(workflow, int)")
 
     _try_compile = ResPrototype("bool workflow_try_compile(workflow, subst_list)")
+    _iget_parallel_group = ResPrototype(
+        "int workflow_iget_parallel_group(workflow, int)"
+    )
     _get_last_error = ResPrototype("config_error_ref workflow_get_last_error(workflow)")
     _get_src_file = ResPrototype("char* worflow_get_src_file(workflow)")
 
@@ -35,6 +39,7 @@ class Workflow(BaseCClass):
         self.__running = False
         self.__cancelled = False
         self.__current_job = None
+        self.__current_group: List[Any] = []
         self.__status: Dict[str, Any] = {}
 
     def __len__(self):
@@ -75,37 +80,64 @@ class Workflow(BaseCClass):
             self.__running = False
             return False
 
-        for job, args in self:
-            self.__current_job = job
-            if not self.__cancelled:
-                return_value = job.run(ert, args, verbose)
-                self.__status[job.name()] = {
-                    "stdout": job.stdoutdata(),
-                    "stderr": job.stderrdata(),
-                    "completed": not job.hasFailed(),
-                    "return": return_value,
-                }
-
-                info = {
-                    "class": "WORKFLOW_JOB",
-                    "job_name": job.name(),
-                    "arguments": " ".join(args),
-                    "stdout": job.stdoutdata(),
-                    "stderr": job.stderrdata(),
-                    "execution_type": job.execution_type,
-                }
-
-                if job.hasFailed():
-                    logger.error(f"Workflow job {job.name()} failed", extra=info)
-                else:
-                    logger.info(
-                        f"Workflow job {job.name()} completed successfully", extra=info
-                    )
+        index = 0
+        while index < len(self) and not self.__cancelled:
+            # Consecutive jobs sharing a PARALLEL group are mutually
+            # independent by declaration and run concurrently; the
+            # default group -1 means one job at a time, as before.
+            group = self._iget_parallel_group(index)
+            group_end = index + 1
+            while (
+                group >= 0
+                and group_end < len(self)
+                and self._iget_parallel_group(group_end) == group
+            ):
+                group_end += 1
+
+            jobs = [self[i] for i in range(index, group_end)]
+            if len(jobs) == 1:
+                job, args = jobs[0]
+                self.__current_job = job
+                self._run_job(job, args, ert, verbose, logger)
+                self.__current_job = None
+            else:
+                self.__current_group = [job for job, _ in jobs]
+                with ThreadPoolExecutor(max_workers=len(jobs)) as pool:
+                    futures = [
+                        pool.submit(self._run_job, job, args, ert, verbose, logger)
+                        for job, args in jobs
+                    ]
+                    for future in futures:
+                        future.result()
+                self.__current_group = []
+            index = group_end
 
-        self.__current_job = None
         self.__running = False
         return success
 
+    def _run_job(self, job, args, ert, verbose, logger):
+        return_value = job.run(ert, args, verbose)
+        self.__status[job.name()] = {
+            "stdout": job.stdoutdata(),
+            "stderr": job.stderrdata(),
+            "completed": not job.hasFailed(),
+            "return": return_value,
+        }
+
+        info = {
+            "class": "WORKFLOW_JOB",
+            "job_name": job.name(),
+            "arguments": " ".join(args),
+            "stdout": job.stdoutdata(),
+            "stderr": job.stderrdata(),
+            "execution_type": job.execution_type,
+        }
+
+        if job.hasFailed():
+            logger.error(f"Workflow job {job.name()} failed", extra=info)
+        else:
+            logger.info(f"Workflow job {job.name()} completed successfully", extra=info)
+
     def free(self):
         self._free()
 
@@ -115,6 +147,8 @@ class Workflow(BaseCClass):
     def cancel(self):
         if self.__current_job is not None:
             self.__current_job.cancel()
+        for job in self.__current_group:
+            job.cancel()
 
         self.__cancelled = True
 
@@ -137,6 +171,7 @@ class Workflow(BaseCClass):
         workflow.__running = False
         workflow.__cancelled = False
         workflow.__current_job = None
+        workflow.__current_group = []
         return workflow
 
     def __ne__(self, other):
@@ -28,6 +28,11 @@ class WorkflowJob(BaseCClass):
         "workflow_job_obj workflow_job_config_alloc( char* , config_parser , char*)",
         bind=False,
     )
+    _alloc_cached = ResPrototype(
+        "workflow_job_obj workflow_job_alloc_cached("
+        "char*, bool, int, int, char*, char*, char*, char*)",
+        bind=False,
+    )
     _free = ResPrototype("void     workflow_job_free(workflow_job)")
     _name = ResPrototype("char*    workflow_job_get_name(workflow_job)")
     _internal = ResPrototype("bool     workflow_job_internal(workflow_job)")
@@ -63,6 +68,39 @@ class WorkflowJob(BaseCClass):
         else:
             raise IOError(f"Could not open config_file:{config_file}")
 
+    def cacheFields(self) -> dict:
+        """The parsed fields of this definition, as stored in the
+        on-disk workflow-job directory cache."""
+        return {
+            "name": self.name(),
+            "internal": self.isInternal(),
+            "min_arg": self._min_arg(),
+            "max_arg": self._max_arg(),
+            "arg_types": [
+                int(self._arg_type(index))
+                for index in range(max(0, self._max_arg()))
+            ],
+            "executable": self._get_executable(),
+            "internal_script": self._get_internal_script(),
+            "function": self._get_function(),
+        }
+
+    @classmethod
+    def fromCachedFields(cls, fields) -> Optional["WorkflowJob"]:
+        """Reconstruct a definition from cacheFields() output without
+        parsing the definition file; returns None when the job no
+        longer validates (e.g. its executable disappeared)."""
+        return cls._alloc_cached(
+            fields["name"],
+            fields["internal"],
+            fields["min_arg"],
+            fields["max_arg"],
+            " ".join(str(arg_type) for arg_type in fields["arg_types"]) or None,
+            fields["executable"],
+            fields["internal_script"],
+            fields["function"],
+        )
+
     def __init__(self, name, internal=True):
         c_ptr = self._alloc(name, internal)
         super().__init__(c_ptr)
@@ -1,7 +1,10 @@
 import logging
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Set, Tuple
 
 import iterative_ensemble_smoother as ies
 import numpy as np
@@ -33,6 +36,21 @@ class ErtAnalysisError(Exception):
     pass
 
 
+# (stage name, wall seconds, cpu seconds) - matches UpdateSnapshot.add_timing
+_StageTimings = List[Tuple[str, float, float]]
+
+
+class _StageTimer:
+    """Measures wall and process CPU time of one update stage."""
+
+    def __init__(self) -> None:
+        self._wall = time.perf_counter()
+        self._cpu = time.process_time()
+
+    def elapsed(self) -> Tuple[float, float]:
+        return time.perf_counter() - self._wall, time.process_time() - self._cpu
+
+
 @dataclass
 class SmootherSnapshot:
     source_case: str
@@ -44,6 +62,41 @@ class SmootherSnapshot:
     update_step_snapshots: Dict[str, "UpdateSnapshot"] = field(default_factory=dict)
 
 
+def _draw_noise_key(rng: np.random.Generator) -> "npt.NDArray[np.uint64]":
+    """Draw the 128-bit Philox key seeding one update step's noise.
+    Drawn from the shared update rng in update-step order, so the
+    result is deterministic even when the steps themselves run
+    concurrently."""
+    return rng.integers(np.iinfo(np.uint64).max, size=2, dtype=np.uint64)
+
+
+def _generate_noise(
+    key: "npt.NDArray[np.uint64]", num_obs: int, ens_size: int
+) -> "npt.NDArray[np.double]":
+    """Generate the observation perturbation matrix E with counter-based
+    (Philox) per-member streams instead of one serial draw.
+
+    Member ``i`` uses the jumped stream ``Philox(key).jumped(i)`` - the
+    counter covers the observation axis within each stream. The result
+    is deterministic for a given RANDOM_SEED and independent of how many
+    threads fill it, and the members can be generated in parallel since
+    the fills release the GIL.
+    """
+    bit_generator = np.random.Philox(key=key)
+    # Filled member-major so every stream writes a contiguous row,
+    # which the out= fill path requires; transposed on return.
+    noise = np.empty((ens_size, num_obs))
+
+    def fill_member(iens: int) -> None:
+        member_rng = np.random.Generator(bit_generator.jumped(iens))
+        member_rng.standard_normal(out=noise[iens])
+
+    with ThreadPoolExecutor() as executor:
+        list(executor.map(fill_member, range(ens_size)))
+
+    return noise.T
+
+
 def _get_A_matrix(
     temporary_storage: Dict[str, "npt.NDArray[np.double]"],
     parameters: List[update.Parameter],
@@ -100,35 +153,148 @@ def _save_to_temporary_storage(
             offset += len(row_indices)
 
 
+def _checkpoint_path(target_fs: "EnkfFs") -> Path:
+    return Path(target_fs.mount_point) / "update_checkpoint"
+
+
+def _read_update_checkpoint(target_fs: "EnkfFs") -> Set[str]:
+    """The parameter groups whose posterior was already written to the
+    target case by an interrupted update, recorded by
+    _record_update_checkpoint()."""
+    try:
+        return set(
+            _checkpoint_path(target_fs).read_text(encoding="utf-8").splitlines()
+        )
+    except FileNotFoundError:
+        return set()
+
+
+def _record_update_checkpoint(target_fs: "EnkfFs", key: str) -> None:
+    with open(_checkpoint_path(target_fs), "a", encoding="utf-8") as f:
+        f.write(f"{key}\n")
+        f.flush()
+        os.fsync(f.fileno())
+
+
+def _clear_update_checkpoint(target_fs: "EnkfFs") -> None:
+    try:
+        _checkpoint_path(target_fs).unlink()
+    except FileNotFoundError:
+        pass
+
+
 def _save_temporary_storage_to_disk(
     target_fs: "EnkfFs",
     ensemble_config: "EnsembleConfig",
     temporary_storage: Dict[str, "npt.NDArray[np.double]"],
     iens_active_index: List[int],
-) -> None:
+) -> _StageTimings:
+    # Each parameter group is checkpointed in the target case once its
+    # posterior is durable, so an update restarted after a failure
+    # mid write-back redoes the solve but skips the groups which were
+    # already written. The checkpoint is cleared when the write-back
+    # completes.
+    completed = _read_update_checkpoint(target_fs)
+    if completed:
+        logger.info(
+            f"Resuming interrupted update; skipping already "
+            f"written parameter groups: {sorted(completed)}"
+        )
+    timings: _StageTimings = []
     for key, matrix in temporary_storage.items():
+        if key in completed:
+            continue
+        timer = _StageTimer()
         target_fs.save_parameters(
             ensemble_config=ensemble_config,
             iens_active_index=iens_active_index,
             parameter=update.Parameter(key),
             values=matrix,
         )
+        target_fs.fsync()
+        _record_update_checkpoint(target_fs, key)
+        timings.append((f"write-back ({key})", *timer.elapsed()))
+    _clear_update_checkpoint(target_fs)
+    return timings
 
 
 def _create_temporary_parameter_storage(
     source_fs: "EnkfFs",
     ensemble_config: "EnsembleConfig",
     iens_active_index: List[int],
-) -> Dict[str, "npt.NDArray[np.double]"]:
+) -> Tuple[Dict[str, "npt.NDArray[np.double]"], _StageTimings]:
     temporary_storage = {}
+    timings: _StageTimings = []
     for key in ensemble_config.parameters:
+        timer = _StageTimer()
         matrix = source_fs.load_parameter(
             ensemble_config=ensemble_config,
             iens_active_index=iens_active_index,
             parameter=update.Parameter(key),
         )
         temporary_storage[key] = matrix
-    return temporary_storage
+        timings.append((f"parameter load ({key})", *timer.elapsed()))
+    return temporary_storage, timings
+
+
+def _disjoint_update_step_waves(updatestep: "UpdateConfiguration") -> List[List[Any]]:
+    """Partition the update steps into waves which can run concurrently.
+
+    Steps are kept in configuration order; a step joins the current wave
+    only if its parameter set is disjoint from every step already in the
+    wave, otherwise a new wave starts. Steps touching the same parameter
+    therefore still execute in their configured order, while localized
+    configurations with disjoint ministeps collapse into a single
+    concurrent wave.
+    """
+    waves: List[List[Any]] = []
+    wave_parameters: Set[str] = set()
+    for update_step in updatestep:
+        names = {p.name for p in update_step.parameters} | {
+            p.name for p in update_step.row_scaling_parameters
+        }
+        if not waves or wave_parameters & names:
+            waves.append([update_step])
+            wave_parameters = set(names)
+        else:
+            waves[-1].append(update_step)
+            wave_parameters |= names
+    return waves
+
+
+# When the active observations outnumber the ensemble members by this
+# factor the exact observation-space inversion is dominated by the
+# observation dimension, and the ensemble-subspace inversion is used
+# instead unless the user asked for a specific algorithm.
+_SUBSPACE_INVERSION_OBS_RATIO = 10
+
+
+def _effective_inversion(
+    module: "AnalysisModule", active_obs_size: int, ens_size: int
+) -> "ies.InversionType":
+    """The inversion type to use for a solve with the given dimensions.
+
+    With the default (exact) inversion and far more active observations
+    than members - typical for seismic observations - the solve is
+    switched to the subspace inversion, which decomposes the
+    ens x ens problem formed from the scaled response matrix instead of
+    an observation-space factorization. An explicitly configured
+    INVERSION is always respected.
+    """
+    inversion = ies.InversionType(module.inversion)
+    if (
+        not module.explicit_inversion
+        and inversion == ies.InversionType(0)
+        and active_obs_size >= _SUBSPACE_INVERSION_OBS_RATIO * ens_size
+    ):
+        logger.info(
+            f"{active_obs_size} active observations for {ens_size} "
+            f"realizations: using ensemble-subspace inversion"
+        )
+        # SUBSPACE_EXACT_R, see the INVERSION keyword mapping in
+        # AnalysisModule.handle_special_key_set().
+        return ies.InversionType(1)
+    return inversion
 
 
 def analysis_ES(
@@ -148,12 +314,11 @@ def analysis_ES(
 
     iens_active_index = [i for i in range(len(ens_mask)) if ens_mask[i]]
 
-    temp_storage = _create_temporary_parameter_storage(
+    temp_storage, load_timings = _create_temporary_parameter_storage(
         source_fs, ensemble_config, iens_active_index
     )
-    # Looping over local analysis update_step
-    for update_step in updatestep:
 
+    def run_update_step(update_step: Any, noise_key: Any) -> "UpdateSnapshot":
         S, observation_handle = update.load_observations_and_responses(
             source_fs,
             obs,
@@ -163,10 +328,7 @@ def analysis_ES(
             ens_mask,
             update_step.observation_config(),
         )
-        # pylint: disable=unsupported-assignment-operation
-        smoother_snapshot.update_step_snapshots[
-            update_step.name
-        ] = observation_handle.update_snapshot
+        snapshot = observation_handle.update_snapshot
         observation_values = observation_handle.observation_values
         observation_errors = observation_handle.observation_errors
         if len(observation_values) == 0:
@@ -178,8 +340,12 @@ def analysis_ES(
         A_with_rowscaling = _get_row_scaling_A_matrices(
             temp_storage, update_step.row_scaling_parameters
         )
-        noise = rng.standard_normal(size=(len(observation_values), S.shape[1]))
+        timer = _StageTimer()
+        noise = _generate_noise(noise_key, len(observation_values), S.shape[1])
+        snapshot.add_timing("noise generation", *timer.elapsed())
+        inversion = _effective_inversion(module, len(observation_values), S.shape[1])
         if A is not None:
+            timer = _StageTimer()
             A = ies.ensemble_smoother_update_step(
                 S,
                 A,
@@ -187,10 +353,12 @@ def analysis_ES(
                 observation_values,
                 noise,
                 module.get_truncation(),
-                ies.InversionType(module.inversion),
+                inversion,
             )
+            snapshot.add_timing("solve", *timer.elapsed())
             _save_to_temporary_storage(temp_storage, update_step.parameters, A)
         if A_with_rowscaling:
+            timer = _StageTimer()
             A_with_rowscaling = ensemble_smoother_update_step_row_scaling(
                 S,
                 A_with_rowscaling,
@@ -198,16 +366,47 @@ def analysis_ES(
                 observation_values,
                 noise,
                 module.get_truncation(),
-                ies.InversionType(module.inversion),
+                inversion,
             )
+            snapshot.add_timing("solve (row scaling)", *timer.elapsed())
             for parameter, (A, _) in zip(
                 update_step.row_scaling_parameters, A_with_rowscaling
             ):
                 _save_to_temporary_storage(temp_storage, [parameter], A)
-
-    _save_temporary_storage_to_disk(
+        return snapshot
+
+    # Update steps touching disjoint parameter sets are independent -
+    # each has its own observation selection, its own solve and its own
+    # entries of temp_storage - so every wave runs concurrently. The
+    # noise keys are drawn from the shared rng in step order up front to
+    # keep the result independent of scheduling.
+    snapshot = None
+    first_step = True
+    for wave in _disjoint_update_step_waves(updatestep):
+        noise_keys = [_draw_noise_key(rng) for _ in wave]
+        if len(wave) == 1:
+            wave_snapshots = [run_update_step(wave[0], noise_keys[0])]
+        else:
+            with ThreadPoolExecutor() as executor:
+                wave_snapshots = list(executor.map(run_update_step, wave, noise_keys))
+        for update_step, snapshot in zip(wave, wave_snapshots):
+            # The parameters are loaded once for all update steps, so
+            # the load timings are reported with the first step only.
+            if first_step:
+                for stage, wall, cpu in load_timings:
+                    snapshot.add_timing(stage, wall, cpu)
+                first_step = False
+            # pylint: disable=unsupported-assignment-operation
+            smoother_snapshot.update_step_snapshots[update_step.name] = snapshot
+
+    write_timings = _save_temporary_storage_to_disk(
         target_fs, ensemble_config, temp_storage, iens_active_index
     )
+    # The write-back happens once after all update steps; report it
+    # with the last step.
+    if snapshot is not None:
+        for stage, wall, cpu in write_timings:
+            snapshot.add_timing(stage, wall, cpu)
 
 
 def analysis_IES(
@@ -228,12 +427,13 @@ def analysis_IES(
 
     iens_active_index = [i for i in range(len(ens_mask)) if ens_mask[i]]
 
-    temp_storage = _create_temporary_parameter_storage(
+    temp_storage, load_timings = _create_temporary_parameter_storage(
         source_fs, ensemble_config, iens_active_index
     )
 
+    snapshot = None
     # Looping over local analysis update_step
-    for update_step in updatestep:
+    for step_nr, update_step in enumerate(updatestep):
 
         S, observation_handle = update.load_observations_and_responses(
             source_fs,
@@ -244,10 +444,14 @@ def analysis_IES(
             ens_mask,
             update_step.observation_config(),
         )
+        snapshot = observation_handle.update_snapshot
+        # The parameters are loaded once for all update steps, so the
+        # load timings are reported with the first step only.
+        if step_nr == 0:
+            for stage, wall, cpu in load_timings:
+                snapshot.add_timing(stage, wall, cpu)
         # pylint: disable=unsupported-assignment-operation
-        smoother_snapshot.update_step_snapshots[
-            update_step.name
-        ] = observation_handle.update_snapshot
+        smoother_snapshot.update_step_snapshots[update_step.name] = snapshot
         observation_values = observation_handle.observation_values
         observation_errors = observation_handle.observation_errors
         observation_mask = observation_handle.obs_mask
@@ -258,7 +462,12 @@ def analysis_IES(
 
         A = _get_A_matrix(temp_storage, update_step.parameters)
 
-        noise = rng.standard_normal(size=(len(observation_values), S.shape[1]))
+        timer = _StageTimer()
+        noise = _generate_noise(
+            _draw_noise_key(rng), len(observation_values), S.shape[1]
+        )
+        snapshot.add_timing("noise generation", *timer.elapsed())
+        timer = _StageTimer()
         A = iterative_ensemble_smoother.update_step(
             S,
             A,
@@ -267,14 +476,22 @@ def analysis_IES(
             noise,
             ensemble_mask=np.array(ens_mask),
             observation_mask=observation_mask,
-            inversion=ies.InversionType(module.inversion),
+            inversion=_effective_inversion(
+                module, len(observation_values), S.shape[1]
+            ),
             truncation=module.get_truncation(),
         )
+        snapshot.add_timing("solve", *timer.elapsed())
         _save_to_temporary_storage(temp_storage, update_step.parameters, A)
 
-    _save_temporary_storage_to_disk(
+    write_timings = _save_temporary_storage_to_disk(
         target_fs, ensemble_config, temp_storage, iens_active_index
     )
+    # The write-back happens once after all update steps; report it
+    # with the last step.
+    if snapshot is not None:
+        for stage, wall, cpu in write_timings:
+            snapshot.add_timing(stage, wall, cpu)
 
 
 def _write_update_report(fname: Path, snapshot: SmootherSnapshot) -> None:
@@ -311,6 +528,15 @@ def _write_update_report(fname: Path, snapshot: SmootherSnapshot) -> None:
                     f"\n"
                 )
             fout.write("=" * 127 + "\n")
+            if update_step.timings:
+                fout.write("Update timing:\n")
+                fout.write("-" * 127 + "\n")
+                for timing in update_step.timings:
+                    fout.write(
+                        f"  {timing.stage:<50} wall: {timing.wall_seconds:>10.3f} s"
+                        f"   cpu: {timing.cpu_seconds:>10.3f} s\n"
+                    )
+                fout.write("=" * 127 + "\n")
 
 
 def _assert_has_enough_realizations(
@@ -1,5 +1,6 @@
 import asyncio
 import logging
+import os
 import threading
 import uuid
 from functools import partial, partialmethod
@@ -22,8 +23,10 @@ import _ert_com_protocol
 from ert._c_wrappers.enkf import RunArg
 from ert._c_wrappers.enkf.analysis_config import AnalysisConfig
 from ert._c_wrappers.enkf.queue_config import QueueConfig
+from ert._c_wrappers.job_queue.job_queue_manager import concurrent_internalization
 from ert.async_utils import get_event_loop
 from ert.ensemble_evaluator import identifiers
+from ert.shared.performance_report import write_performance_report
 
 from .._wait_for_evaluator import wait_for_evaluator
 from ._ensemble import Ensemble
@@ -33,8 +36,6 @@ if TYPE_CHECKING:
     from .config import EvaluatorServerConfig
 
 
-CONCURRENT_INTERNALIZATION = 10
-
 logger = logging.getLogger(__name__)
 event_logger = logging.getLogger("ert.event_log")
 experiment_logger = logging.getLogger("ert.experiment_server")
@@ -270,7 +271,7 @@ class LegacyEnsemble(Ensemble):
 
             # Tell queue to pass info to the jobs-file
             # NOTE: This touches files on disk...
-            sema = threading.BoundedSemaphore(value=CONCURRENT_INTERNALIZATION)
+            sema = threading.BoundedSemaphore(value=concurrent_internalization())
             if (
                 output_bus and experiment_id is not None
             ):  # when running experiment server
@@ -319,6 +320,12 @@ class LegacyEnsemble(Ensemble):
 
         else:
             logger.debug("ensemble finished normally")
+            run_paths = [str(real.steps[0].run_path) for real in self.active_reals]
+            if run_paths:
+                report_dir = os.path.commonpath(run_paths)
+                if len(run_paths) == 1:
+                    report_dir = os.path.dirname(report_dir)
+                write_performance_report(report_dir, self._job_queue)
 
         finally:
             await timeout_queue.put(None)  # signal to exit timer
@@ -1,6 +1,6 @@
 import logging
 import re
-from typing import TYPE_CHECKING, Any, Callable, Dict, List, Optional, Union
+from typing import TYPE_CHECKING, Any, Callable, Dict, List, Optional, Sequence, Union
 
 import numpy as np
 from ecl.grid import EclGrid
@@ -426,6 +426,52 @@ class LibresFacade:  # pylint: disable=too-many-public-methods
 
         return DataFrame(data=summary_data, index=multi_index, columns=summary_keys)
 
+    def load_summary_statistics(
+        self,
+        case_name: str,
+        keys: Optional[List[str]] = None,
+        fractiles: Sequence[float] = (0.1, 0.33, 0.5, 0.67, 0.9),
+    ) -> DataFrame:
+        """Ensemble statistics per time step, computed in C++ during the
+        batched read - only the envelopes cross the pybind11 boundary,
+        not the full ensemble."""
+        fs = self._enkf_main.getFileSystem(case_name)
+
+        time_map = fs.getTimeMap()
+        dates = [time_map[index].datetime() for index in range(1, len(time_map))]
+
+        realizations = self.get_active_realizations(case_name)
+
+        summary_keys = self.get_summary_keys()
+        if keys is not None:
+            summary_keys = [
+                key for key in keys if key in summary_keys
+            ]  # ignore keys that doesn't exist
+
+        statistics = _clib.enkf_fs_summary_statistics.get_summary_statistics(
+            self._enkf_main.ensembleConfig(),
+            fs,
+            summary_keys,
+            realizations,
+            len(dates),
+            list(fractiles),
+        )
+
+        if np.isnan(statistics).all():
+            return DataFrame()
+
+        columns = ["Minimum", "Maximum", "Mean"] + [
+            f"p{round(fractile * 100)}" for fractile in fractiles
+        ]
+        multi_index = MultiIndex.from_product(
+            [summary_keys, dates], names=["Key", "Date"]
+        )
+        return DataFrame(
+            data=statistics.transpose(0, 2, 1).reshape(-1, len(columns)),
+            index=multi_index,
+            columns=columns,
+        )
+
     def gather_summary_data(
         self,
         case: str,
@@ -0,0 +1,133 @@
+"""
+Consolidated end-of-run performance report.
+
+The performance instrumentation is spread across the internals: the
+job queue keeps a timeline of every realization, block_fs counts the
+storage I/O per mount, the update stage records per-phase latency
+histograms and the memory accounting tracks where the peak footprint
+sat. This module aggregates all of it per experiment run into a
+single JSON + HTML artifact written next to the realization run
+directories, so finding the next bottleneck starts in one place.
+"""
+import json
+import logging
+import time
+from pathlib import Path
+from typing import TYPE_CHECKING, Any, Dict, Optional, Union
+
+from ert import _clib
+
+if TYPE_CHECKING:
+    from ert._c_wrappers.job_queue.queue import JobQueue
+
+logger = logging.getLogger(__name__)
+
+PERFORMANCE_REPORT_NAME = "performance_report"
+
+
+def collect_performance_report(
+    job_queue: Optional["JobQueue"] = None,
+) -> Dict[str, Any]:
+    """The aggregated report as a plain dict: queue timeline
+    statistics, all registered counters and latency histograms
+    (storage I/O, update stages) and the process memory peaks."""
+    report: Dict[str, Any] = {
+        "generated_at": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "metrics": json.loads(_clib.metrics.dump_json()),
+        "memory": json.loads(_clib.metrics.memory_report_json()),
+    }
+    if job_queue is not None:
+        report["queue"] = job_queue.timeline_statistics()
+    return report
+
+
+def write_performance_report(
+    output_dir: Union[str, Path], job_queue: Optional["JobQueue"] = None
+) -> None:
+    """Write performance_report.json and performance_report.html into
+    @output_dir. Best effort - reporting must never fail a run."""
+    try:
+        report = collect_performance_report(job_queue)
+        output_dir = Path(output_dir)
+        json_file = output_dir / f"{PERFORMANCE_REPORT_NAME}.json"
+        json_file.write_text(json.dumps(report, indent=2))
+        html_file = output_dir / f"{PERFORMANCE_REPORT_NAME}.html"
+        html_file.write_text(_render_html(report))
+        logger.info("Performance report written to %s", json_file)
+    except Exception:  # pylint: disable=broad-except
+        logger.exception("Failed to write performance report")
+
+
+def _table(title: str, headers: Any, rows: Any) -> str:
+    html = [f"<h2>{title}</h2>", "<table>", "<tr>"]
+    html.extend(f"<th>{header}</th>" for header in headers)
+    html.append("</tr>")
+    for row in rows:
+        html.append("<tr>")
+        html.extend(f"<td>{cell}</td>" for cell in row)
+        html.append("</tr>")
+    html.append("</table>")
+    return "\n".join(html)
+
+
+def _render_html(report: Dict[str, Any]) -> str:
+    sections = []
+
+    queue = report.get("queue")
+    if queue:
+        rows = [("jobs", queue["jobs"]), ("max running", queue["max_running"])]
+        rows.extend(sorted(queue["status_counts"].items()))
+        runtime = queue.get("runtime")
+        if runtime:
+            rows.extend(
+                (f"runtime {key} [s]", f"{value:.1f}")
+                for key, value in runtime.items()
+            )
+        sections.append(_table("Queue", ["Statistic", "Value"], rows))
+
+    memory = report["memory"]
+    rows = [
+        ("max RSS [Mb]", memory["max_rss_mb"]),
+        ("VmPeak [Mb]", memory["max_memory_mb"]),
+    ]
+    rows.extend(
+        (f"account {tag} peak [Mb]", account["peak"] // 2**20)
+        for tag, account in sorted(memory["accounts"].items())
+    )
+    sections.append(_table("Memory", ["Statistic", "Value"], rows))
+
+    counters = report["metrics"]["counters"]
+    sections.append(
+        _table("Counters", ["Counter", "Value"], sorted(counters.items()))
+    )
+
+    histogram_rows = []
+    for name, histogram in sorted(report["metrics"]["histograms"].items()):
+        count = histogram["count"]
+        mean_ms = histogram["sum"] / count / 1e6 if count else 0.0
+        total_s = histogram["sum"] / 1e9
+        histogram_rows.append((name, count, f"{mean_ms:.3f}", f"{total_s:.2f}"))
+    sections.append(
+        _table(
+            "Latency histograms",
+            ["Histogram", "Count", "Mean [ms]", "Total [s]"],
+            histogram_rows,
+        )
+    )
+
+    body = "\n".join(sections)
+    return (
+        "<!DOCTYPE html>\n<html>\n<head>\n"
+        "<title>ert performance report</title>\n"
+        "<style>\n"
+        "body { font-family: sans-serif; margin: 2em; }\n"
+        "table { border-collapse: collapse; margin-bottom: 2em; }\n"
+        "th, td { border: 1px solid #999; padding: 0.3em 0.8em; "
+        "text-align: left; }\n"
+        "th { background: #eee; }\n"
+        "</style>\n</head>\n<body>\n"
+        "<h1>ert performance report</h1>\n"
+        f"<p>Generated at {report['generated_at']}</p>\n"
+        f"{body}\n"
+        "</body>\n</html>\n"
+    )
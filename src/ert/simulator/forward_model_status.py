@@ -2,10 +2,19 @@ import datetime
 import json
 import os.path
 import time
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 from ert.constant_filenames import JOBS_FILE, STATUS_json
 
+# The jobs.json file is written once when the runpath is created and never
+# changes, so it is parsed at most once per runpath. The status.json file is
+# rewritten by the job runner as the forward model progresses; the parsed
+# status is cached keyed on the (mtime, size) of the file so that polling
+# more frequently than the file changes does not re-read it - with many
+# runpaths on NFS the stat() call is far cheaper than open + read + parse.
+_jobs_data_cache: Dict[str, Any] = {}
+_status_cache: Dict[str, Tuple[Tuple[float, int], "ForwardModelStatus"]] = {}
+
 
 def _serialize_date(dt: Optional[datetime.datetime]) -> Optional[float]:
     if dt is None:
@@ -109,11 +118,20 @@ class ForwardModelStatus:
         status_file = os.path.join(path, STATUS_json)
         jobs_file = os.path.join(path, JOBS_FILE)
 
+        stat = os.stat(status_file)
+        fingerprint = (stat.st_mtime, stat.st_size)
+        cached = _status_cache.get(path)
+        if cached is not None and cached[0] == fingerprint:
+            return cached[1]
+
         with open(status_file) as status_fp:  # pylint: disable=unspecified-encoding
             status_data = json.load(status_fp)
 
-        with open(jobs_file) as jobs_fp:  # pylint: disable=unspecified-encoding
-            job_data = json.load(jobs_fp)
+        job_data = _jobs_data_cache.get(path)
+        if job_data is None:
+            with open(jobs_file) as jobs_fp:  # pylint: disable=unspecified-encoding
+                job_data = json.load(jobs_fp)
+            _jobs_data_cache[path] = job_data
 
         start_time = _deserialize_date(status_data["start_time"])
         end_time = _deserialize_date(status_data["end_time"])
@@ -122,6 +140,7 @@ class ForwardModelStatus:
         for job, state in zip(job_data["jobList"], status_data["jobs"]):
             status.add_job(ForwardModelJobStatus.load(job, state, path))
 
+        _status_cache[path] = (fingerprint, status)
         return status
 
     @classmethod
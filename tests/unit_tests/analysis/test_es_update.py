@@ -345,10 +345,10 @@ def test_update_multiple_param(copy_case):
     )
     es_update.smootherUpdate(run_context)
 
-    prior = _create_temporary_parameter_storage(
+    prior, _ = _create_temporary_parameter_storage(
         sim_fs, ert.ensembleConfig(), list(range(10))
     )
-    posterior = _create_temporary_parameter_storage(
+    posterior, _ = _create_temporary_parameter_storage(
         target_fs, ert.ensembleConfig(), list(range(10))
     )
 
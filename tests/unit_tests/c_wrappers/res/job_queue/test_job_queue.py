@@ -18,6 +18,7 @@ from ert._c_wrappers.job_queue import (
     JobStatusType,
     QueueDriverEnum,
 )
+from ert._c_wrappers.job_queue.thread_status_type_enum import ThreadStatus
 from ert._clib.model_callbacks import LoadStatus
 
 
@@ -332,6 +333,7 @@ async def test_retry_on_closed_connection(tmpdir, monkeypatch):
 class MockedJob:
     def __init__(self, status):
         self.status = status
+        self.thread_status = ThreadStatus.READY
         self._start_time = 0
         self._current_time = 0
         self._end_time = None
@@ -340,12 +342,19 @@ class MockedJob:
     def runtime(self):
         return self._end_time - self._start_time
 
+    @property
+    def start_time(self):
+        return self._start_time
+
     def stop(self):
         self.status = JobStatusType.JOB_QUEUE_FAILED
 
     def convertToCReference(self, _):
         pass
 
+    def set_status_event(self, _):
+        pass
+
 
 def test_stop_long_running():
     """
@@ -396,3 +405,81 @@ def test_stop_long_running():
     for i in range(8, 10):
         assert job_list[i].status == JobStatusType.JOB_QUEUE_RUNNING
         assert queue.snapshot()[i] == str(JobStatusType.JOB_QUEUE_RUNNING)
+
+
+def test_stop_long_running_rechecks_resubmitted_jobs():
+    """
+    A resubmitted job gets a fresh start time, so its heap entry holds
+    a stale key. When that entry expires the job must be re-registered
+    with the new start time instead of escaping all future checks.
+    """
+    job_list = [MockedJob(JobStatusType.JOB_QUEUE_DONE) for _ in range(5)]
+    for job in job_list:
+        job._start_time = 0
+        job._end_time = 10
+
+    now = time.time()
+    resubmitted = MockedJob(JobStatusType.JOB_QUEUE_RUNNING)
+    resubmitted._start_time = now
+    resubmitted._end_time = now + 5
+    job_list.append(resubmitted)
+
+    queue = _mocked_queue(job_list)
+    # The first submit of job 5 started long ago and failed; the heap
+    # still holds that stale start time.
+    queue._long_running_not_started.remove(5)
+    queue._long_running_heap = [(now - 100, 5)]
+
+    queue.stop_long_running_jobs(5)
+
+    assert resubmitted.status == JobStatusType.JOB_QUEUE_RUNNING
+    assert (now, 5) in queue._long_running_heap
+
+
+def _mocked_queue(job_list):
+    with patch("ert._c_wrappers.job_queue.JobQueue._set_driver"):
+        queue = JobQueue(MagicMock())
+        with patch("ert._c_wrappers.job_queue.JobQueue._add_job") as _add_job:
+            for idx, job in enumerate(job_list):
+                _add_job.return_value = idx
+                queue.add_job(job, idx)
+    return queue
+
+
+def test_runtime_informed_submission_order():
+    job_list = [MockedJob(JobStatusType.JOB_QUEUE_WAITING) for _ in range(4)]
+    queue = _mocked_queue(job_list)
+
+    # Without estimates the queue keeps the plain list order
+    assert queue.fetch_next_waiting() is job_list[0]
+
+    queue.set_runtime_estimates({1: 100.0, 3: 500.0})
+    assert queue.fetch_next_waiting() is job_list[3]
+    job_list[3].thread_status = ThreadStatus.RUNNING
+    assert queue.fetch_next_waiting() is job_list[1]
+    job_list[1].thread_status = ThreadStatus.RUNNING
+
+    # Jobs without an estimate follow in list order
+    assert queue.fetch_next_waiting() is job_list[0]
+    job_list[0].thread_status = ThreadStatus.RUNNING
+    assert queue.fetch_next_waiting() is job_list[2]
+    job_list[2].thread_status = ThreadStatus.RUNNING
+    assert queue.fetch_next_waiting() is None
+
+
+def test_runtime_history_persisted_with_case(tmp_path):
+    history_file = tmp_path / "runtime_history.json"
+    job_list = [MockedJob(JobStatusType.JOB_QUEUE_DONE) for _ in range(3)]
+    for iens, job in enumerate(job_list):
+        job._end_time = 10 * (iens + 1)
+
+    queue = _mocked_queue(job_list)
+    queue._load_runtime_history(history_file)
+    queue._record_runtimes()
+    assert json.loads(history_file.read_text()) == {"0": 10, "1": 20, "2": 30}
+
+    # A later run against the same case starts the slowest realization first
+    job_list = [MockedJob(JobStatusType.JOB_QUEUE_WAITING) for _ in range(3)]
+    queue = _mocked_queue(job_list)
+    queue._load_runtime_history(history_file)
+    assert queue.fetch_next_waiting() is job_list[2]
@@ -0,0 +1,56 @@
+import json
+from unittest.mock import MagicMock, patch
+
+from ert.shared import performance_report
+
+
+def test_write_performance_report(tmp_path):
+    clib = MagicMock()
+    clib.metrics.dump_json.return_value = json.dumps(
+        {
+            "counters": {"block_fs.reads": 4},
+            "histograms": {
+                "update.load_parameter_ns": {
+                    "count": 2,
+                    "sum": 3_000_000_000,
+                    "buckets": [],
+                }
+            },
+        }
+    )
+    clib.metrics.memory_report_json.return_value = json.dumps(
+        {
+            "max_rss_mb": 100,
+            "max_memory_mb": 120,
+            "accounts": {"update.matrices": {"current": 0, "peak": 2**30}},
+        }
+    )
+    queue = MagicMock()
+    queue.timeline_statistics.return_value = {
+        "jobs": 2,
+        "max_running": 2,
+        "status_counts": {"JOB_QUEUE_SUCCESS": 2},
+        "runtime": {"min": 1.0, "max": 2.0, "mean": 1.5, "total": 3.0},
+    }
+
+    with patch.object(performance_report, "_clib", clib):
+        performance_report.write_performance_report(tmp_path, queue)
+
+    report = json.loads((tmp_path / "performance_report.json").read_text())
+    assert report["queue"]["jobs"] == 2
+    assert report["metrics"]["counters"]["block_fs.reads"] == 4
+    assert report["memory"]["max_rss_mb"] == 100
+
+    html = (tmp_path / "performance_report.html").read_text()
+    assert "block_fs.reads" in html
+    assert "update.load_parameter_ns" in html
+    assert "update.matrices" in html
+
+
+def test_write_performance_report_never_raises(tmp_path):
+    # Reporting is best effort; a broken metrics source must not fail
+    # the run.
+    clib = MagicMock()
+    clib.metrics.dump_json.return_value = "not json"
+    with patch.object(performance_report, "_clib", clib):
+        performance_report.write_performance_report(tmp_path / "missing", None)